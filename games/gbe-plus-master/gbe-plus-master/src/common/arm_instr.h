@@ -1,30 +1,36 @@
-// GB Enhanced+ Copyright Daniel Baxter 2015
+// GB Enhanced+ Copyright Daniel Baxter 2014
 // Licensed under the GPLv2
 // See LICENSE.txt for full license text
 
-// File : arm9_arm_instr.cpp
-// Date : November 05, 2015
-// Description : ARM9 THUMB instructions
+// File : arm_instr.h
+// Date : May 23, 2014
+// Description : ARM7 and ARM9 ARM instructions
 //
-// Emulates an ARM9 ARM instructions with equivalent C++
+// Emulates ARM7 and ARM9 ARM instructions with equivalent C++
+// Shared by the GBA ARM7, NDS7, and NDS9 through arm_interpreter
+// Only included by arm_interpreter.h
 
-#include "arm9.h"
+#ifndef GBE_ARM_INSTR
+#define GBE_ARM_INSTR
 
 /****** ARM.3 - Branch and Exchange ******/
-void NTR_ARM9::branch_exchange(u32 current_arm_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::branch_exchange(u32 current_arm_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab source register - Bits 0-2
 	u8 src_reg = (current_arm_instruction & 0xF);
 
-	if(src_reg == 15) { std::cout<<"CPU::ARM9::Warning - ARM.3 Branch and Exchange - R15 used as operand\n"; } 
+	if(src_reg == 15) { std::cout<<cpu_traits::log_name<<"::Warning - ARM.3 Branch and Exchange - R15 used as operand\n"; }
 
-	u32 result = get_reg(src_reg);
+	u32 result = derived().get_reg(src_reg);
 	u8 op = (current_arm_instruction >> 4) & 0xF;
 
 	//Switch to THUMB mode if necessary
 	if(result & 0x1) 
 	{ 
-		arm_mode = THUMB;
+		derived().arm_mode = cpu_type::THUMB;
 		reg.cpsr |= 0x20;
 		result &= ~0x1;
 	}
@@ -34,49 +40,59 @@ void NTR_ARM9::branch_exchange(u32 current_arm_instruction)
 		//Branch
 		case 0x1:
 			//Clock CPU and controllers - 1N
-			clock(reg.r15, CODE_N32);
+			derived().clock(reg.r15, CODE_N32);
 
 			reg.r15 = result;
-			needs_flush = true;
+			derived().needs_flush = true;
 
 			//Clock CPU and controllers - 2S
-			clock(reg.r15, CODE_S32);
-			clock((reg.r15 + 4), CODE_S32);
+			derived().clock(reg.r15, CODE_S32);
+			derived().clock((reg.r15 + 4), CODE_S32);
 
 			break;
 
-		//Branch and Link
+		//Branch with Link and Exchange - ARMv5 only
 		case 0x3:
-			//Clock CPU and controllers - 1N
-			clock(reg.r15, CODE_N32);
+			if(cpu_traits::armv5te)
+			{
+				//Clock CPU and controllers - 1N
+				derived().clock(reg.r15, CODE_N32);
 
-			set_reg(14, (reg.r15 - 4));
-			reg.r15 = result;
-			needs_flush = true;
+				derived().set_reg(14, (reg.r15 - 4));
+				reg.r15 = result;
+				derived().needs_flush = true;
 
-			//Clock CPU and controllers - 2S
-			clock(reg.r15, CODE_S32);
-			clock((reg.r15 + 4), CODE_S32);
+				//Clock CPU and controllers - 2S
+				derived().clock(reg.r15, CODE_S32);
+				derived().clock((reg.r15 + 4), CODE_S32);
 
-			break;
+				break;
+			}
+
+			[[fallthrough]];
 
 		default:
-			std::cout<<"CPU::ARM9::Error - ARM.3 invalid Branch and Exchange opcode : 0x" << std::hex << op << "\n";
-			running = false;
+			std::cout<<cpu_traits::log_name<<"::Error - ARM.3 invalid Branch and Exchange opcode : 0x" << std::hex << (int)op << "\n";
+			derived().running = false;
 			break;
 	}
 }  
 
 /****** ARM.4 - Branch, Branch with Link, and Branch with Link and Exchange ******/
-void NTR_ARM9::branch_link(u32 current_arm_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::branch_link(u32 current_arm_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab offset
 	u32 offset = (current_arm_instruction & 0xFFFFFF);
 	offset <<= 2;
 
 	//Grab opcode
 	u8 op = (current_arm_instruction >> 24) & 0x1;
-	if((current_arm_instruction >> 28) == 0xF) { op = 2; }
+
+	//ARMv5 - BLX with an immediate uses the NV condition code
+	if((cpu_traits::armv5te) && ((current_arm_instruction >> 28) == 0xF)) { op = 2; }
 
 	u32 final_addr = reg.r15;
 
@@ -90,48 +106,57 @@ void NTR_ARM9::branch_link(u32 current_arm_instruction)
 		//Branch
 		case 0x0:
 			//Clock CPU and controllers - 1N
-			clock(reg.r15, CODE_N32);
+			derived().clock(reg.r15, CODE_N32);
 
 			reg.r15 = final_addr;
-			needs_flush = true;
+			derived().needs_flush = true;
 
 			//Clock CPU and controllers - 2S
-			clock(reg.r15, CODE_S32);
-			clock((reg.r15 + 4), CODE_S32);
+			derived().clock(reg.r15, CODE_S32);
+			derived().clock((reg.r15 + 4), CODE_S32);
+
+			//Watch for polling loops
+			if constexpr(cpu_traits::idle_loop_branches)
+			{
+				if(idle_loop_skip) { idle_loop_branch(final_addr - offset - 8); }
+			}
 
 			break;
 
 		//Branch and Link
 		case 0x1:
 			//Clock CPU and controllers - 1N
-			clock(reg.r15, CODE_N32);
+			derived().clock(reg.r15, CODE_N32);
 
-			set_reg(14, (reg.r15 - 4));
+			derived().set_reg(14, (reg.r15 - 4));
 			reg.r15 = final_addr;
-			needs_flush = true;
+			derived().needs_flush = true;
 
 			//Clock CPU and controllers - 2S
-			clock(reg.r15, CODE_S32);
-			clock((reg.r15 + 4), CODE_S32);
+			derived().clock(reg.r15, CODE_S32);
+			derived().clock((reg.r15 + 4), CODE_S32);
 
 			break;
 
-		//Branch and Link and Exchange
+		//Branch with Link and Exchange
 		case 0x2:
 			//Clock CPU and controllers - 1N
-			clock(reg.r15, CODE_N32);
+			derived().clock(reg.r15, CODE_N32);
 
-			set_reg(14, (reg.r15 - 4));
+			derived().set_reg(14, (reg.r15 - 4));
 			reg.r15 = final_addr;
+
+			//Bit 24 selects the halfword in THUMB mode
 			if(current_arm_instruction & 0x1000000) { reg.r15 += 2; }
-			needs_flush = true;
+
+			derived().needs_flush = true;
 
 			//Clock CPU and controllers - 2S
-			clock(reg.r15, CODE_S32);
-			clock((reg.r15 + 4), CODE_S32);
+			derived().clock(reg.r15, CODE_S32);
+			derived().clock((reg.r15 + 4), CODE_S32);
 
 			//Switch to THUMB mode
-			arm_mode = THUMB;
+			derived().arm_mode = cpu_type::THUMB;
 			reg.cpsr |= 0x20;
 
 			break;
@@ -139,15 +164,14 @@ void NTR_ARM9::branch_link(u32 current_arm_instruction)
 }
 
 /****** ARM.5 Data Processing ******/
-void NTR_ARM9::data_processing(u32 current_arm_instruction)
+template<typename cpu_type, typename cpu_traits>
+template<u8 op, bool set_cc, bool use_immediate>
+void arm_interpreter<cpu_type, cpu_traits>::data_processing(u32 current_arm_instruction)
 {
-	//Determine if an immediate value or a register should be used as the operand
-	bool use_immediate = (current_arm_instruction & 0x2000000) ? true : false;
+	auto& reg = derived().reg;
 
-	//Determine if condition codes should be updated
-	bool set_condition = (current_arm_instruction & 0x100000) ? true : false;
-	
-	u8 op = (current_arm_instruction >> 21) & 0xF;
+	//Determine if condition codes should be updated - Writing to R15 can turn this off
+	bool set_condition = set_cc;
 
 	//Grab source register
 	u8 src_reg = (current_arm_instruction >> 16) & 0xF;
@@ -159,9 +183,10 @@ void NTR_ARM9::data_processing(u32 current_arm_instruction)
 	bool shift_immediate = (current_arm_instruction & 0x10) ? false : true;
 
 	u32 result = 0;
-	u32 input = get_reg(src_reg);
+	u32 input = derived().get_reg(src_reg);
 	u32 operand = 0;
 	u8 shift_out = 2;
+	u8 carry = 0;
 
 	//Use immediate as operand
 	if(use_immediate)
@@ -169,14 +194,14 @@ void NTR_ARM9::data_processing(u32 current_arm_instruction)
 		operand = (current_arm_instruction & 0xFF);
 		u8 offset = (current_arm_instruction >> 8) & 0xF;
 		
-		//Shift immediate - ROR special case - Carry flag not affected
+		//Shift immediate - ROR special case - ROR #0 not translated to RRX #1
 		shift_out = rotate_right_special(operand, offset);
 	}
 
 	//Use register as operand
 	else
 	{
-		operand = get_reg(current_arm_instruction & 0xF);
+		operand = derived().get_reg(current_arm_instruction & 0xF);
 		u8 shift_type = (current_arm_instruction >> 5) & 0x3;
 		u8 offset = 0;
 
@@ -189,13 +214,13 @@ void NTR_ARM9::data_processing(u32 current_arm_instruction)
 		//Shift the register-operand by another register
 		else
 		{
-			offset = get_reg((current_arm_instruction >> 8) & 0xF);
+			offset = derived().get_reg((current_arm_instruction >> 8) & 0xF);
 
 			if(src_reg == 15) { input += 4; }
 			if((current_arm_instruction & 0xF) == 15) { operand += 4; }
 			
 			//Valid registers to shift by are R0-R14
-			if(((current_arm_instruction >> 8) & 0xF) == 0xF) { std::cout<< "CPU::ARM9::Error - ARM.5 Data Processing - Shifting Register-Operand by PC \n"; running = false; }
+			if(((current_arm_instruction >> 8) & 0xF) == 0xF) { std::cout<<cpu_traits::log_name<<"::Error - ARM.5 Data Processing - Shifting Register-Operand by PC \n"; derived().running = false; }
 		}
 
 		//Shift the register
@@ -227,7 +252,7 @@ void NTR_ARM9::data_processing(u32 current_arm_instruction)
 		}
 		
 		//Clock CPU and controllers - 1I
-		clock();
+		derived().clock();
 	}		
 
 	//TODO - When op is 0x8 through 0xB, make sure Bit 20 is 1 (rather force it? Unsure)
@@ -237,29 +262,30 @@ void NTR_ARM9::data_processing(u32 current_arm_instruction)
 	//Clock CPU and controllers - 1N
 	if(dest_reg == 15)
 	{
-		clock(reg.r15, CODE_N32);
+		derived().clock(reg.r15, CODE_N32);
 		
 		//When the set condition parameter is 1 and destination register is R15, change CPSR to SPSR
 		if(set_condition)
 		{
-			reg.cpsr = get_spsr();
+			update_flags();
+			reg.cpsr = derived().get_spsr();
 			set_condition = false;
 
 			//Set the CPU mode accordingly
 			switch((reg.cpsr & 0x1F))
 			{
-				case 0x10: current_cpu_mode = USR; break;
-				case 0x11: current_cpu_mode = FIQ; break;
-				case 0x12: current_cpu_mode = IRQ; break;
-				case 0x13: current_cpu_mode = SVC; break;
-				case 0x17: current_cpu_mode = ABT; break;
-				case 0x1B: current_cpu_mode = UND; break;
-				case 0x1F: current_cpu_mode = SYS; break;
-				default: std::cout<<"CPU::ARM9::Warning - ARM.5 CPSR setting unknown CPU mode -> 0x" << std::hex << (reg.cpsr & 0x1F) << "\n";
+				case 0x10: derived().current_cpu_mode = cpu_type::USR; break;
+				case 0x11: derived().current_cpu_mode = cpu_type::FIQ; break;
+				case 0x12: derived().current_cpu_mode = cpu_type::IRQ; break;
+				case 0x13: derived().current_cpu_mode = cpu_type::SVC; break;
+				case 0x17: derived().current_cpu_mode = cpu_type::ABT; break;
+				case 0x1B: derived().current_cpu_mode = cpu_type::UND; break;
+				case 0x1F: derived().current_cpu_mode = cpu_type::SYS; break;
+				default: std::cout<<cpu_traits::log_name<<"::Warning - ARM.5 CPSR setting unknown CPU mode -> 0x" << std::hex << (reg.cpsr & 0x1F) << "\n";
 			}
 
 			//Switch to ARM or THUMB mode if necessary
-			arm_mode = (reg.cpsr & 0x20) ? THUMB : ARM;
+			derived().arm_mode = (reg.cpsr & 0x20) ? cpu_type::THUMB : cpu_type::ARM;
 		}
 	}
 
@@ -268,7 +294,7 @@ void NTR_ARM9::data_processing(u32 current_arm_instruction)
 		//AND
 		case 0x0:
 			result = (input & operand);
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Update condition codes
 			if(set_condition) { update_condition_logical(result, shift_out); }
@@ -277,7 +303,7 @@ void NTR_ARM9::data_processing(u32 current_arm_instruction)
 		//XOR
 		case 0x1:
 			result = (input ^ operand);
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Update condition codes
 			if(set_condition) { update_condition_logical(result, shift_out); }
@@ -286,7 +312,7 @@ void NTR_ARM9::data_processing(u32 current_arm_instruction)
 		//SUB
 		case 0x2:
 			result = (input - operand);
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Update condtion codes
 			if(set_condition) { update_condition_arithmetic(input, operand, result, false); }
@@ -295,7 +321,7 @@ void NTR_ARM9::data_processing(u32 current_arm_instruction)
 		//RSB
 		case 0x3:
 			result = (operand - input);
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Update condtion codes
 			if(set_condition) { update_condition_arithmetic(operand, input, result, false); }
@@ -304,7 +330,7 @@ void NTR_ARM9::data_processing(u32 current_arm_instruction)
 		//ADD
 		case 0x4:
 			result = (input + operand);
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Update condtion codes
 			if(set_condition) { update_condition_arithmetic(input, operand, result, true); }
@@ -312,43 +338,41 @@ void NTR_ARM9::data_processing(u32 current_arm_instruction)
 
 		//ADC
 		case 0x5:
-			//use the current Carry Flag for this math op
-			shift_out = (reg.cpsr & CPSR_C_FLAG) ? 1 : 0;
+			//Carry in always comes from the CPSR, never the barrel shifter
+			update_flags();
+			carry = (reg.cpsr & CPSR_C_FLAG) ? 1 : 0;
 
-			result = (input + operand + shift_out);
-			set_reg(dest_reg, result);
+			result = (input + operand + carry);
+			derived().set_reg(dest_reg, result);
 
 			//Update condtion codes
-			if(set_condition)
-			{
-				update_condition_arithmetic(input, (operand + shift_out), result, true);
-				if(shift_out && ((input == 0xFFFFFFFF) || (operand == 0xFFFFFFFF))) { reg.cpsr |= CPSR_C_FLAG; }
-			}
-
+			if(set_condition) { update_condition_arithmetic(input, (u64(operand) + carry), result, true); }
 			break;
 
 		//SBC
 		case 0x6:
-			//Use the current Carry Flag for this math op
-			shift_out = (reg.cpsr & CPSR_C_FLAG) ? 1 : 0;
+			//Carry in always comes from the CPSR, never the barrel shifter
+			update_flags();
+			carry = (reg.cpsr & CPSR_C_FLAG) ? 1 : 0;
 
-			result = (input - operand + shift_out - 1);
-			set_reg(dest_reg, result);
+			result = (input - operand + carry - 1);
+			derived().set_reg(dest_reg, result);
 
-			//Update condtion codes
-			if(set_condition) { update_condition_arithmetic(input, (operand + shift_out - 1), result, false); }
+			//Update condtion codes - Borrow is the inverse of carry
+			if(set_condition) { update_condition_arithmetic(input, (u64(operand) + (carry ^ 1)), result, false); }
 			break;
 
 		//RSC
 		case 0x7:
-			//use the current Carry Flag for this math op
-			shift_out = (reg.cpsr & CPSR_C_FLAG) ? 1 : 0;
+			//Carry in always comes from the CPSR, never the barrel shifter
+			update_flags();
+			carry = (reg.cpsr & CPSR_C_FLAG) ? 1 : 0;
 
-			result = (operand - input + shift_out - 1);
-			set_reg(dest_reg, result);
+			result = (operand - input + carry - 1);
+			derived().set_reg(dest_reg, result);
 
-			//Update condtion codes
-			if(set_condition) { update_condition_arithmetic((operand + shift_out - 1), input, result, false); }
+			//Update condtion codes - Borrow is the inverse of carry
+			if(set_condition) { update_condition_arithmetic(operand, (u64(input) + (carry ^ 1)), result, false); }
 			break;
 
 		//TST
@@ -386,7 +410,7 @@ void NTR_ARM9::data_processing(u32 current_arm_instruction)
 		//ORR
 		case 0xC:
 			result = (input | operand);
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Update condtion codes
 			if(set_condition) { update_condition_logical(result, shift_out); }
@@ -395,7 +419,7 @@ void NTR_ARM9::data_processing(u32 current_arm_instruction)
 		//MOV
 		case 0xD:
 			result = operand;
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Update condtion codes
 			if(set_condition) { update_condition_logical(result, shift_out); }
@@ -404,7 +428,7 @@ void NTR_ARM9::data_processing(u32 current_arm_instruction)
 		//BIC
 		case 0xE:
 			result = (input & (~operand));
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Update condtion codes
 			if(set_condition) { update_condition_logical(result, shift_out); }
@@ -413,7 +437,7 @@ void NTR_ARM9::data_processing(u32 current_arm_instruction)
 		//MVN
 		case 0xF:
 			result = ~operand;
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Update condtion codes
 			if(set_condition) { update_condition_logical(result, shift_out); }
@@ -423,27 +447,30 @@ void NTR_ARM9::data_processing(u32 current_arm_instruction)
 	//Timings for PC as destination register
 	if(dest_reg == 15) 
 	{
+		//Clock CPU and controllers - 2S
+		derived().needs_flush = true; 
+		derived().clock(reg.r15, CODE_S32);
+		derived().clock((reg.r15 + 4), CODE_S32);
+
 		//Align PC if necessary
-		if(arm_mode == THUMB) { reg.r15 &= ~0x1; }
+		if((reg.r15 & 0x1) || (derived().arm_mode == cpu_type::THUMB)) { reg.r15 &= ~0x1; }
 		else { reg.r15 &= ~0x3; }
-
-		//Clock CPU and controllers - 2S
-		needs_flush = true; 
-		clock(reg.r15, CODE_S32);
-		clock((reg.r15 + 4), CODE_S32);
 	}
 
 	//Timings for regular registers
 	else 
 	{
 		//Clock CPU and controllers - 1S
-		clock((reg.r15 + 4), CODE_S32);
+		derived().clock((reg.r15 + 4), CODE_S32);
 	}
 }
 
 /****** ARM.6 PSR Transfer ******/
-void NTR_ARM9::psr_transfer(u32 current_arm_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::psr_transfer(u32 current_arm_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Determine if an immediate or a register will be used as input (MSR only) - Bit 25
 	bool use_immediate = (current_arm_instruction & 0x2000000) ? true : false;
 
@@ -453,6 +480,9 @@ void NTR_ARM9::psr_transfer(u32 current_arm_instruction)
 	//Grab opcode
 	u8 op = (current_arm_instruction & 0x200000) ? 1 : 0;
 
+	//MRS and MSR work on the whole PSR, so the condition codes must be current
+	update_flags();
+
 	switch(op)
 	{
 		//MRS
@@ -461,13 +491,13 @@ void NTR_ARM9::psr_transfer(u32 current_arm_instruction)
 				//Grab destination register - Bits 12-15
 				u8 dest_reg = ((current_arm_instruction >> 12) & 0xF);
 
-				if(dest_reg == 15) { std::cout<<"CPU::ARM9::Warning - ARM.6 R15 used as Destination Register \n"; }
+				if(dest_reg == 15) { std::cout<<cpu_traits::log_name<<"::Warning - ARM.6 R15 used as Destination Register \n"; }
 
 				//Store CPSR into destination register
-				if(psr == 0) { set_reg(dest_reg, reg.cpsr); }
+				if(psr == 0) { derived().set_reg(dest_reg, reg.cpsr); }
 		
 				//Store SPSR into destination register
-				else { set_reg(dest_reg, get_spsr()); }
+				else { derived().set_reg(dest_reg, derived().get_spsr()); }
 			}
 			break;
 
@@ -486,14 +516,14 @@ void NTR_ARM9::psr_transfer(u32 current_arm_instruction)
 				if(current_arm_instruction & 0x40000) 
 				{ 
 					op_field_mask |= 0x00FF0000;
-					//std::cout<<"CPU::ARM9::Warning - ARM.6 MSR enabled access to Status Field \n";
+					//std::cout<<cpu_traits::log_name<<"::Warning - ARM.6 MSR enabled access to Status Field \n";
 				}
 
 				//Extension field - Bit 17
 				if(current_arm_instruction & 0x20000) 
 				{ 
 					op_field_mask |= 0x0000FF00;
-					//std::cout<<"CPU::ARM9::Warning - ARM.6 MSR enabled access to Extension Field \n";
+					//std::cout<<cpu_traits::log_name<<"::Warning - ARM.6 MSR enabled access to Extension Field \n";
 				}
 
 				//Control field - Bit 15
@@ -517,9 +547,9 @@ void NTR_ARM9::psr_transfer(u32 current_arm_instruction)
 					//Grab source register - Bits 0-3
 					u8 src_reg = (current_arm_instruction & 0xF);
 
-					if(src_reg == 15) { std::cout<<"CPU::ARM9::Warning - ARM.6 R15 used as Source Register \n"; }
+					if(src_reg == 15) { std::cout<<cpu_traits::log_name<<"::Warning - ARM.6 R15 used as Source Register \n"; }
 
-					input = get_reg(src_reg);
+					input = derived().get_reg(src_reg);
 					input &= op_field_mask;
 				}
 
@@ -532,38 +562,47 @@ void NTR_ARM9::psr_transfer(u32 current_arm_instruction)
 					//Set the CPU mode accordingly
 					switch((reg.cpsr & 0x1F))
 					{
-						case 0x10: current_cpu_mode = USR; break;
-						case 0x11: current_cpu_mode = FIQ; break;
-						case 0x12: current_cpu_mode = IRQ; break;
-						case 0x13: current_cpu_mode = SVC; break;
-						case 0x17: current_cpu_mode = ABT; break;
-						case 0x1B: current_cpu_mode = UND; break;
-						case 0x1F: current_cpu_mode = SYS; break;
-						default: std::cout<<"CPU::ARM9::Warning - ARM.6 CPSR setting unknown CPU mode -> 0x" << std::hex << (reg.cpsr & 0x1F) << "\n";
+						case 0x10: derived().current_cpu_mode = cpu_type::USR; break;
+						case 0x11: derived().current_cpu_mode = cpu_type::FIQ; break;
+						case 0x12: derived().current_cpu_mode = cpu_type::IRQ; break;
+						case 0x13: derived().current_cpu_mode = cpu_type::SVC; break;
+						case 0x17: derived().current_cpu_mode = cpu_type::ABT; break;
+						case 0x1B: derived().current_cpu_mode = cpu_type::UND; break;
+						case 0x1F: derived().current_cpu_mode = cpu_type::SYS; break;
+						default: std::cout<<cpu_traits::log_name<<"::Warning - ARM.6 CPSR setting unknown CPU mode -> 0x" << std::hex << (reg.cpsr & 0x1F) << "\n";
+					}
+
+					if(reg.cpsr & 0x20)
+					{
+						std::cout<<cpu_traits::log_name<<"::Warning - ARM.6 Setting THUMB mode\n";
+						derived().arm_mode = cpu_type::THUMB;
+						reg.r15 &= ~0x1;
+						derived().needs_flush = true;
 					}
 				}
 	
 				//Write into SPSR
 				else
 				{
-					u32 temp_spsr = get_spsr();
+					u32 temp_spsr = derived().get_spsr();
 					temp_spsr &= ~op_field_mask;
 					temp_spsr |= input;
-					set_spsr(temp_spsr);
+					derived().set_spsr(temp_spsr);
 				} 
 			}
 			break;
 	}
 
 	//Clock CPU and controllers - 1S
-	clock((reg.r15 + 4), CODE_S32);
-} 
+	derived().clock((reg.r15 + 4), CODE_S32);
+}
 
 /****** ARM.7 Multiply and Multiply-Accumulate ******/
-void NTR_ARM9::multiply(u32 current_arm_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::multiply(u32 current_arm_instruction)
 {
-	//TODO - Timings
-	//TODO - The rest of the opcodes
+	auto& reg = derived().reg;
+
 	//TODO - Find out what GBATEK means when it says the carry flag is 'destroyed'.
 	//TODO - Set conditions
 
@@ -582,19 +621,34 @@ void NTR_ARM9::multiply(u32 current_arm_instruction)
 	//Determine if condition codes should be updated - Bit 20
 	bool set_condition = (current_arm_instruction & 0x100000) ? true : false;
 
+	//N and Z are written directly below, so apply any flag-setting operation still waiting first
+	if(set_condition) { update_flags(); }
+
 	//Grab opcode - Bits 21-24
 	u8 op_code = ((current_arm_instruction >> 21) & 0xF);
 
 	//Make sure no operand or destination register is R15
-	if(op_rm_reg == 15) { std::cout<<"CPU::ARM9::Warning - ARM.7 R15 used as Rm\n"; }
-	if(op_rs_reg == 15) { std::cout<<"CPU::ARM9::Warning - ARM.7 R15 used as Rs\n"; }
-	if(accu_reg == 15) { std::cout<<"CPU::ARM9::Warning - ARM.7 R15 used as Rn\n"; }
-	if(dest_reg == 15) { std::cout<<"CPU::ARM9::Warning - ARM.7 R15 used as Rd\n"; }
+	if(op_rm_reg == 15) { std::cout<<cpu_traits::log_name<<"::Warning - ARM.7 R15 used as Rm\n"; }
+	if(op_rs_reg == 15) { std::cout<<cpu_traits::log_name<<"::Warning - ARM.7 R15 used as Rs\n"; }
+	if(accu_reg == 15) { std::cout<<cpu_traits::log_name<<"::Warning - ARM.7 R15 used as Rn\n"; }
+	if(dest_reg == 15) { std::cout<<cpu_traits::log_name<<"::Warning - ARM.7 R15 used as Rd\n"; }
 
-	u32 Rm = get_reg(op_rm_reg);
-	u32 Rs = get_reg(op_rs_reg);
-	u32 Rn = get_reg(accu_reg);
-	u32 Rd = get_reg(dest_reg);
+	u32 Rm = derived().get_reg(op_rm_reg);
+	u32 Rs = derived().get_reg(op_rs_reg);
+	u32 Rn = derived().get_reg(accu_reg);
+	u32 Rd = derived().get_reg(dest_reg);
+
+	//Multiplier cycles depend on the significant bytes of Rs, plus 1 for accumulating and 1 for 64-bit results
+	u8 internal_cycles = 1;
+
+	if(op_code < 0x8)
+	{
+		internal_cycles = multiply_cycles(Rs, ((op_code & 0x6) != 0x4));
+		if(op_code & 0x1) { internal_cycles++; }
+		if(op_code & 0x4) { internal_cycles++; }
+	}
+
+	else if(op_code == 0xA) { internal_cycles = 2; }
 
 	u64 value_64 = 1;
 	u64 hi_lo = 0;
@@ -607,7 +661,7 @@ void NTR_ARM9::multiply(u32 current_arm_instruction)
 		//MUL
 		case 0x0:
 			value_32 = (Rm * Rs);
-			set_reg(dest_reg, value_32);
+			derived().set_reg(dest_reg, value_32);
 
 			if(set_condition)
 			{
@@ -625,7 +679,7 @@ void NTR_ARM9::multiply(u32 current_arm_instruction)
 		//MLA
 		case 0x1:
 			value_32 = (Rm * Rs) + Rn;
-			set_reg(dest_reg, value_32);
+			derived().set_reg(dest_reg, value_32);
 
 			if(set_condition)
 			{
@@ -648,8 +702,8 @@ void NTR_ARM9::multiply(u32 current_arm_instruction)
 			Rn = (value_64 & 0xFFFFFFFF);
 			Rd = (value_64 >> 32);
 
-			set_reg(accu_reg, Rn);
-			set_reg(dest_reg, Rd);
+			derived().set_reg(accu_reg, Rn);
+			derived().set_reg(dest_reg, Rd);
 
 			if(set_condition)
 			{
@@ -678,8 +732,8 @@ void NTR_ARM9::multiply(u32 current_arm_instruction)
 			Rn = (value_64 & 0xFFFFFFFF);
 			Rd = (value_64 >> 32);
 
-			set_reg(accu_reg, Rn);
-			set_reg(dest_reg, Rd);
+			derived().set_reg(accu_reg, Rn);
+			derived().set_reg(dest_reg, Rd);
 
 			if(set_condition)
 			{
@@ -705,8 +759,8 @@ void NTR_ARM9::multiply(u32 current_arm_instruction)
 			Rn = (value_s64 & 0xFFFFFFFF);
 			Rd = (value_s64 >> 32);
 
-			set_reg(accu_reg, Rn);
-			set_reg(dest_reg, Rd);
+			derived().set_reg(accu_reg, Rn);
+			derived().set_reg(dest_reg, Rd);
 
 			if(set_condition)
 			{
@@ -737,8 +791,8 @@ void NTR_ARM9::multiply(u32 current_arm_instruction)
 			Rn = (value_s64 & 0xFFFFFFFF);
 			Rd = (value_s64 >> 32);
 
-			set_reg(accu_reg, Rn);
-			set_reg(dest_reg, Rd);
+			derived().set_reg(accu_reg, Rn);
+			derived().set_reg(dest_reg, Rd);
 
 			if(set_condition)
 			{
@@ -763,7 +817,7 @@ void NTR_ARM9::multiply(u32 current_arm_instruction)
 
 			value_32 = ((s16)Rm * (s16)Rs);
 			value_32 += Rn;
-			set_reg(dest_reg, value_32);
+			derived().set_reg(dest_reg, value_32);
 
 			update_sticky_overflow(((s16)Rm * (s16)Rs), Rn, value_32, true);
 
@@ -779,14 +833,14 @@ void NTR_ARM9::multiply(u32 current_arm_instruction)
 
 			if(current_arm_instruction & 0x20)
 			{
-				set_reg(dest_reg, value_32);
+				derived().set_reg(dest_reg, value_32);
 			}
 
 			else
 			{
 				update_sticky_overflow(value_32, Rn, (value_32 + Rn), true);
 				value_32 += Rn;
-				set_reg(dest_reg, value_32);
+				derived().set_reg(dest_reg, value_32);
 			}
 
 			break;
@@ -813,8 +867,8 @@ void NTR_ARM9::multiply(u32 current_arm_instruction)
 			Rn = (value_s64 & 0xFFFFFFFF);
 			Rd = (value_s64 >> 32);
 
-			set_reg(accu_reg, Rn);
-			set_reg(dest_reg, Rd);
+			derived().set_reg(accu_reg, Rn);
+			derived().set_reg(dest_reg, Rd);
 
 			break;
 
@@ -827,35 +881,27 @@ void NTR_ARM9::multiply(u32 current_arm_instruction)
 			else { Rm &= 0xFFFF; }
 
 			value_32 = ((s16)Rm * (s16)Rs);
-			set_reg(dest_reg, value_32);
+			derived().set_reg(dest_reg, value_32);
 
 			break;
 			
-		default: std::cout<<"CPU::ARM9::Warning:: - ARM.7 Invalid or unimplemented opcode : " << std::hex << (int)op_code << "\n"; std::cout<<"OP -> 0x" << current_arm_instruction << "\n";
+		default: std::cout<<cpu_traits::log_name<<"::Warning:: - ARM.7 Invalid or unimplemented opcode : " << std::hex << (int)op_code << "\n"; std::cout<<"OP -> 0x" << current_arm_instruction << "\n";
 			 std::cout<<"PC -> 0x" << std::hex << reg.r15 << "\n";
 	}
+
+	//Clock CPU and controllers - (m)I
+	for(u8 x = 0; x < internal_cycles; x++) { derived().clock(); }
+
+	//Clock CPU and controllers - 1S
+	derived().clock((reg.r15 + 4), CODE_S32);
 }
 			
 /****** ARM.9 Single Data Transfer ******/
-void NTR_ARM9::single_data_transfer(u32 current_arm_instruction)
+template<typename cpu_type, typename cpu_traits>
+template<u8 offset_is_register, u8 pre_post, u8 up_down, u8 byte_word, u8 write_back, u8 load_store>
+void arm_interpreter<cpu_type, cpu_traits>::single_data_transfer(u32 current_arm_instruction)
 {
-	//Grab Immediate-Offset flag - Bit 25
-	u8 offset_is_register = (current_arm_instruction & 0x2000000) ? 1 : 0;
-
-	//Grab Pre-Post bit - Bit 24
-	u8 pre_post = (current_arm_instruction & 0x1000000) ? 1 : 0;
-
-	//Grab Up-Down bit - Bit 23
-	u8 up_down = (current_arm_instruction & 0x800000) ? 1 : 0;
-
-	//Grab Byte-Word bit - Bit 22
-	u8 byte_word = (current_arm_instruction & 0x400000) ? 1 : 0;
-
-	//Grab Write-Back bit - Bit 21
-	u8 write_back = (current_arm_instruction & 0x200000) ? 1 : 0;
-
-	//Grab Load-Store bit - Bit 20
-	u8 load_store = (current_arm_instruction & 0x100000) ? 1 : 0;
+	auto& reg = derived().reg;
 
 	//Grab the Base Register - Bits 16-19
 	u8 base_reg = ((current_arm_instruction >> 16) & 0xF);
@@ -864,7 +910,7 @@ void NTR_ARM9::single_data_transfer(u32 current_arm_instruction)
 	u8 dest_reg = ((current_arm_instruction >> 12) & 0xF);
 
 	u32 base_offset = 0;
-	u32 base_addr = get_reg(base_reg);
+	u32 base_addr = derived().get_reg(base_reg);
 	u32 value = 0;
 
 	//Determine Offset - 12-bit immediate
@@ -875,7 +921,7 @@ void NTR_ARM9::single_data_transfer(u32 current_arm_instruction)
 	{
 		//Grab register to use as offset - Bits 0-3
 		u8 offset_register = (current_arm_instruction & 0xF);
-		base_offset = get_reg(offset_register);
+		base_offset = derived().get_reg(offset_register);
 
 		//Grab the shift type - Bits 5-6
 		u8 shift_type = ((current_arm_instruction >> 5) & 0x3);
@@ -908,73 +954,69 @@ void NTR_ARM9::single_data_transfer(u32 current_arm_instruction)
 		}
 	}
 
-
 	//Increment or decrement before transfer if pre-indexing
 	if(pre_post == 1) 
-	{
+	{ 
 		if(up_down == 1) { base_addr += base_offset; }
 		else { base_addr -= base_offset; } 
 	}
 
 	//Clock CPU and controllers - 1N
-	clock(reg.r15, CODE_N32);
+	derived().clock(reg.r15, CODE_N32);
 
 	//Store Byte or Word
 	if(load_store == 0) 
 	{
 		if(byte_word == 1)
 		{
-			value = get_reg(dest_reg);
+			value = derived().get_reg(dest_reg);
 			if(dest_reg == 15) { value += 4; }
 			value &= 0xFF;
-			mem->write_u8(base_addr, value);
-
-			//Clock CPU and controllers - 1N
-			clock(base_addr, DATA_N16);
+			derived().mem_check_8(base_addr, value, false);
 		}
 
 		else
 		{
-			value = get_reg(dest_reg);
+			value = derived().get_reg(dest_reg);
 			if(dest_reg == 15) { value += 4; }
-			mem->write_u32(base_addr, value);
-
-			//Clock CPU and controllers - 1N
-			clock(base_addr, DATA_N32);
+			derived().mem->write_u32(base_addr, value);
 		}
+
+		//Clock CPU and controllers - 1N
+		derived().clock(base_addr, (byte_word == 1) ? DATA_N16 : DATA_N32);
 	}
 
 	//Load Byte or Word
 	else
 	{
+		//ARMv5 - PLD uses the NV condition code and is treated as a NOP
+		if constexpr(cpu_traits::armv5te)
+		{
+			if((dest_reg == 15) && (pre_post == 1) && ((current_arm_instruction >> 28) == 0xF)) { return; }
+		}
+
 		if(byte_word == 1)
 		{
 			//Clock CPU and controllers - 1I
-			value = mem->read_u8(base_addr);
-			clock();
+			derived().mem_check_8(base_addr, value, true);
+			derived().clock();
 
 			//Clock CPU and controllers - 1N
-			if(dest_reg == 15)
-			{
-				//Check for PLD. Treat as NOP.
-				if(((current_arm_instruction >> 28) == 0xF) && (pre_post)) { return; }
-
-				clock((reg.r15 + 4), DATA_N16);
-			} 
+			if(dest_reg == 15) { derived().clock((reg.r15 + 4), CODE_N32); } 
 
-			set_reg(dest_reg, value);
+			derived().set_reg(dest_reg, value);
 		}
 
 		else
 		{
 			//Clock CPU and controllers - 1I
-			value = mem->read_u32(base_addr);
-			clock();
+			derived().mem_check_32(base_addr, value, true);
+			derived().clock();
 
 			//Clock CPU and controllers - 1N
-			if(dest_reg == 15) { clock((reg.r15 + 4), DATA_N32); } 
+			if(dest_reg == 15) { derived().clock((reg.r15 + 4), CODE_N32); } 
 
-			set_reg(dest_reg, value);
+			derived().set_reg(dest_reg, value);
 		}
 	}
 
@@ -987,38 +1029,39 @@ void NTR_ARM9::single_data_transfer(u32 current_arm_instruction)
 
 	//Write back into base register
 	//Post-indexing ALWAYS does this. Pre-Indexing does this optionally
-	if((pre_post == 0) && (base_reg != dest_reg)) { set_reg(base_reg, base_addr); }
-	else if((pre_post == 1) && (write_back == 1) && (base_reg != dest_reg)) { set_reg(base_reg, base_addr); }
+	if((pre_post == 0) && (base_reg != dest_reg)) { derived().set_reg(base_reg, base_addr); }
+	else if((pre_post == 1) && (write_back == 1) && (base_reg != dest_reg)) { derived().set_reg(base_reg, base_addr); }
 
 	//Timings for LDR - PC
 	if((dest_reg == 15) && (load_store == 1)) 
 	{
-		//Switch to THUMB mode if necessary
-		if(reg.r15 & 0x1) 
+		//ARMv5 - Switch to THUMB mode if necessary
+		if((cpu_traits::armv5te) && (reg.r15 & 0x1))
 		{ 
-			arm_mode = THUMB;
+			derived().arm_mode = cpu_type::THUMB;
 			reg.cpsr |= 0x20;
 			reg.r15 &= ~0x1;
 		}
 
 		//Clock CPU and controllser - 2S
-		clock(reg.r15, CODE_S32);
-		clock((reg.r15 + 4), CODE_S32);
-		needs_flush = true;
+		derived().clock(reg.r15, CODE_S32);
+		derived().clock((reg.r15 + 4), CODE_S32);
+		derived().needs_flush = true;
 	}
 
 	//Timings for LDR - No PC
 	else if((dest_reg != 15) && (load_store == 1))
 	{
 		//Clock CPU and controllers - 1S
-		clock(reg.r15, CODE_S32);
+		derived().clock(reg.r15, CODE_S32);
 	}
 }
 
 /****** ARM.10 Halfword-Signed Transfer ******/
-void NTR_ARM9::halfword_signed_transfer(u32 current_arm_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::halfword_signed_transfer(u32 current_arm_instruction)
 {
-	//TODO - Timings
+	auto& reg = derived().reg;
 
 	//Grab Pre-Post bit - Bit 24
 	u8 pre_post = (current_arm_instruction & 0x1000000) ? 1 : 0;
@@ -1048,16 +1091,16 @@ void NTR_ARM9::halfword_signed_transfer(u32 current_arm_instruction)
 	if(pre_post == 0) { write_back = 1; }
 
 	u32 base_offset = 0;
-	u32 base_addr = get_reg(base_reg);
+	u32 base_addr = derived().get_reg(base_reg);
 	u32 value = 0;
 
 	//Determine offset if offset is a register
 	if(offset_is_register == 0)
 	{
 		//Register is Bits 0-3
-		base_offset = get_reg((current_arm_instruction & 0xF));
+		base_offset = derived().get_reg((current_arm_instruction & 0xF));
 
-		if((current_arm_instruction & 0xF) == 15) { std::cout<<"CPU::ARM9::Warning - ARM.10 Offset Register is PC\n"; }
+		if((current_arm_instruction & 0xF) == 15) { std::cout<<cpu_traits::log_name<<"::Warning - ARM.10 Offset Register is PC\n"; }
 	}
 
 	//Determine offset if offset is immediate
@@ -1078,6 +1121,11 @@ void NTR_ARM9::halfword_signed_transfer(u32 current_arm_instruction)
 		else { base_addr -= base_offset; } 
 	}
 
+	//Clock CPU and controllers - 1N
+	derived().clock(reg.r15, CODE_N32);
+
+	bool is_load = (load_store == 1);
+
 	//Perform Load or Store ops
 	switch(op)
 	{
@@ -1086,72 +1134,85 @@ void NTR_ARM9::halfword_signed_transfer(u32 current_arm_instruction)
 			//Store halfword
 			if(load_store == 0)
 			{
-				value = get_reg(dest_reg);
+				value = derived().get_reg(dest_reg);
 	
 				//If PC is the Destination Register, add 4
 				if(dest_reg == 15) { value += 4; }
 
 				value &= 0xFFFF;
-				mem->write_u16(base_addr, value);
+				derived().mem->write_u16(base_addr, value);
+
+				//Clock CPU and controllers - 1N
+				derived().clock(base_addr, DATA_N16);
 			}
 
 			//Load halfword
 			else
 			{
-				value = mem->read_u16(base_addr);
-				set_reg(dest_reg, value);
+				value = derived().mem->read_u16(base_addr);
+				derived().set_reg(dest_reg, value);
 			}
 
 			break;
 
 		//Load signed byte (sign extended) or Load Double Word
 		case 0x2:
-			//Load Double Word
-			if(load_store == 0)
+			//ARMv5 - Load Double Word
+			if((cpu_traits::armv5te) && (load_store == 0))
 			{
 				//Source register should be even, and not R14
-				if((dest_reg & 0x1) || (dest_reg == 14)) { std::cout<<"CPU::ARM9::Warning - ARM.10 LDRD uses bad source register\n"; }
+				if((dest_reg & 0x1) || (dest_reg == 14)) { std::cout<<cpu_traits::log_name<<"::Warning - ARM.10 LDRD uses bad source register\n"; }
 
-				value = mem->read_u32(base_addr);
-				set_reg(dest_reg, value);
+				value = derived().mem->read_u32(base_addr);
+				derived().set_reg(dest_reg, value);
 
-				value = mem->read_u32(base_addr + 4);
-				set_reg(dest_reg + 1, value);
+				value = derived().mem->read_u32(base_addr + 4);
+				derived().set_reg(dest_reg + 1, value);
+
+				is_load = true;
 			}
 			
 			//Load signed byte
 			else
 			{
-				value = mem->read_u8(base_addr);
+				value = derived().mem->read_u8(base_addr);
 
 				if(value & 0x80) { value |= 0xFFFFFF00; }
-				set_reg(dest_reg, value);
+				derived().set_reg(dest_reg, value);
+
+				is_load = true;
 			}
 
 			break;
 
 		//Load signed halfword (sign extended) or Store Double Word
 		case 0x3:
-			//Store Double Word
-			if(load_store == 0)
+			//ARMv5 - Store Double Word
+			if((cpu_traits::armv5te) && (load_store == 0))
 			{
 				//Source register should be even, and not R14
-				if((dest_reg & 0x1) || (dest_reg == 14)) { std::cout<<"CPU::ARM9::Warning - ARM.10 STRD uses bad source register\n"; }
+				if((dest_reg & 0x1) || (dest_reg == 14)) { std::cout<<cpu_traits::log_name<<"::Warning - ARM.10 STRD uses bad source register\n"; }
 
-				value = get_reg(dest_reg);
-				mem->write_u32(base_addr, value);
+				value = derived().get_reg(dest_reg);
+				derived().mem->write_u32(base_addr, value);
 
-				value = get_reg(dest_reg + 1);
-				mem->write_u32(base_addr + 4, value);
+				value = derived().get_reg(dest_reg + 1);
+				derived().mem->write_u32(base_addr + 4, value);
+
+				//Clock CPU and controllers - 1N + 1S
+				derived().clock(base_addr, DATA_N32);
+				derived().clock((base_addr + 4), DATA_S32);
 			}
 
 			//Load signed halfword
 			else
 			{	
-				value = mem->read_u16(base_addr);
+				value = derived().mem->read_u16(base_addr);
 
 				if(value & 0x8000) { value |= 0xFFFF0000; }
-				set_reg(dest_reg, value);
+				derived().set_reg(dest_reg, value);
+
+				is_load = true;
 			}
 
 			break;
@@ -1170,14 +1231,22 @@ void NTR_ARM9::halfword_signed_transfer(u32 current_arm_instruction)
 	}
 
 	//Write-back into base register
-	if((write_back == 1) && (base_reg != dest_reg)) { set_reg(base_reg, base_addr); }
+	if((write_back == 1) && (base_reg != dest_reg)) { derived().set_reg(base_reg, base_addr); }
+
+	//Timings for loads
+	if(is_load)
+	{
+		//Clock CPU and controllers - 1I + 1S
+		derived().clock();
+		derived().clock((reg.r15 + 4), CODE_S32);
+	}
 }
 
 /****** ARM.11 Block Data Transfer ******/
-void NTR_ARM9::block_data_transfer(u32 current_arm_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::block_data_transfer(u32 current_arm_instruction)
 {
-	//TODO - Clock cycles
-	//TODO - Handle empty RList
+	auto& reg = derived().reg;
 
 	//Grab Pre-Post bit - Bit 24
 	u8 pre_post = (current_arm_instruction & 0x1000000) ? 1 : 0;
@@ -1201,41 +1270,38 @@ void NTR_ARM9::block_data_transfer(u32 current_arm_instruction)
 	u16 r_list = (current_arm_instruction & 0xFFFF);
 
 	//Warnings
-	if(base_reg == 15) { std::cout<<"CPU::ARM9::Warning - ARM.11 R15 used as Base Register \n"; }
+	if(base_reg == 15) { std::cout<<cpu_traits::log_name<<"::Warning - ARM.11 R15 used as Base Register \n"; }
 
-	u32 base_addr = get_reg(base_reg);
+	u32 base_addr = derived().get_reg(base_reg);
 	u32 old_base = base_addr;
 
 	//Force USR mode if PSR bit is set
-	cpu_modes temp_mode = current_cpu_mode;
-	if(psr) { current_cpu_mode = USR; }
+	auto temp_mode = derived().current_cpu_mode;
+	if(psr) { derived().current_cpu_mode = cpu_type::USR; }
 
-	bool diff_bank = (temp_mode != current_cpu_mode);
+	bool diff_bank = (temp_mode != derived().current_cpu_mode);
 
 	u8 transfer_reg = 0xFF;
 	u8 last_reg = 0xFF;
-	u8 list_size = 0xFF;
+	u8 list_size = 0;
 
-	//Find out the first register in the Register List
-	for(int x = 0; x < 16; x++)
-	{
-		if(r_list & (1 << x))
-		{
-			transfer_reg = x;
-			x = 0xFF;
-			break;
-		}
-	}
-
-	//Find out last register in Register List + Register List size
+	//Find out the first and last registers in the Register List + Register List size
 	for(int x = 0; x < 16; x++)
 	{
 		if(r_list & (1 << x))
 		{
+			if(transfer_reg == 0xFF) { transfer_reg = x; }
 			last_reg = x;
+			list_size++;
 		}
 	}
-	
+
+	//Clock CPU and controllers - 1N
+	if(load_store == 0) { derived().clock(reg.r15, CODE_N32); }
+
+	//First transfer is non-sequential, the rest are sequential
+	bool sequential = false;
+
 	//Load-Store with an ascending stack order, Up-Down = 1
 	if((up_down == 1) && (r_list != 0))
 	{
@@ -1250,32 +1316,30 @@ void NTR_ARM9::block_data_transfer(u32 current_arm_instruction)
 				if(load_store == 0) 
 				{
 					//If Base Register is included in the Register List, store the old base address
-					if((x == base_reg) && (write_back == 1) && (!diff_bank)) { mem->write_u32((base_addr & ~0x3), old_base); }
+					if(block_store_old_base(x, base_reg, transfer_reg, diff_bank)) { derived().mem->write_u32((base_addr & ~0x3), old_base); }
 
 					//Otherwise store the register normally
-					else { mem->write_u32((base_addr & ~0x3), get_reg(x)); }
+					else { derived().mem->write_u32((base_addr & ~0x3), derived().get_reg(x)); }
 				}
 			
 				//Load registers
 				else 
 				{
-					//If Base Register is included in the Register List, writeback only if it's the only item OR not the last item
-					if((x == base_reg) && (write_back == 1))
-					{
-						if((list_size != 1) && (x == last_reg)) { write_back = 0; }
-					}
-
-					set_reg(x, mem->read_u32(base_addr & ~0x3));
-
-					if(x == 15) { needs_flush = true; } 
+					if(block_load_skips_writeback(x, base_reg, last_reg, list_size)) { write_back = 0; }
+					derived().set_reg(x, derived().mem->read_u32(base_addr & ~0x3));
+					if(x == 15) { derived().needs_flush = true; } 
 				}
 
+				//Clock CPU and controllers - 1N or 1S
+				derived().clock((base_addr & ~0x3), (sequential) ? DATA_S32 : DATA_N32);
+				sequential = true;
+
 				//Increment after transfer if post-indexing
 				if(pre_post == 0) { base_addr += 4; }
 			}
 
 			//Write back the into base register
-			if(write_back == 1) { set_reg(base_reg, base_addr); }
+			if(write_back == 1) { derived().set_reg(base_reg, base_addr); }
 		}
 	}
 
@@ -1291,78 +1355,145 @@ void NTR_ARM9::block_data_transfer(u32 current_arm_instruction)
 
 				//Store registers
 				if(load_store == 0) 
-				{
+				{ 
 					//If Base Register is included in the Register List, store the old base address
-					if((x == base_reg) && (write_back == 1) && (!diff_bank)) { mem->write_u32((base_addr & ~0x3), old_base); }
+					if(block_store_old_base(x, base_reg, transfer_reg, diff_bank)) { derived().mem->write_u32((base_addr & ~0x3), old_base); }
 
 					//Otherwise store the register normally
-					else { mem->write_u32((base_addr & ~0x3), get_reg(x)); }
+					else { derived().mem->write_u32((base_addr & ~0x3), derived().get_reg(x)); }
 				}
 			
 				//Load registers
 				else 
 				{
-					//If Base Register is included in the Register List, writeback only if it's the only item OR not the last item
-					if((x == base_reg) && (write_back == 1))
-					{
-						if((list_size != 1) && (x == last_reg)) { write_back = 0; }
-					}
-					
-					set_reg(x, mem->read_u32(base_addr & ~0x3));
-					if(x == 15) { needs_flush = true; } 
+					if(block_load_skips_writeback(x, base_reg, last_reg, list_size)) { write_back = 0; }
+					derived().set_reg(x, derived().mem->read_u32(base_addr & ~0x3));
+					if(x == 15) { derived().needs_flush = true; } 
 				}
 
+				//Clock CPU and controllers - 1N or 1S
+				derived().clock((base_addr & ~0x3), (sequential) ? DATA_S32 : DATA_N32);
+				sequential = true;
+
 				//Decrement after transfer if post-indexing
 				if(pre_post == 0) { base_addr -= 4; }
 			}
 
 			//Write back the into base register
-			if(write_back == 1) { set_reg(base_reg, base_addr); }
+			if(write_back == 1) { derived().set_reg(base_reg, base_addr); }
 		}
 	}
 
 	//Special case, empty RList
-	//Store PC, add or sub 0x40 to base address
-	else { std::cout<<"Empty RList not implemented, too lazy atm :p\n"; }
+	else
+	{
+		//ARMv4 transfers R15, ARMv5 only adjusts the base address
+		if constexpr(!cpu_traits::armv5te)
+		{
+			//Store R15
+			if(load_store == 0) { derived().mem->write_u32((base_addr & ~0x3), reg.r15); }
+		
+			//Load R15
+			else
+			{
+				reg.r15 = derived().mem->read_u32(base_addr & ~0x3);
+				derived().needs_flush = true;
+			}
+		}
+
+		//Add 0x40 to base address if ascending stack, writeback into base register
+		if(up_down == 1) { derived().set_reg(base_reg, (base_addr + 0x40)); }
+
+		//Subtract 0x40 from base address if descending stack, writeback into base register
+		else { derived().set_reg(base_reg, (base_addr - 0x40)); }
+
+		std::cout<<cpu_traits::log_name<<"::Warning - ARM.11 Instruction uses empty register list \n";
+	}
 
 	//Restore CPU mode if PSR bit is set
 	if(psr)
 	{
-		current_cpu_mode = temp_mode;
+		derived().current_cpu_mode = temp_mode;
 
 		//Also set CPSR to current SPSR if loading R15
-		if(needs_flush)
+		if(derived().needs_flush)
 		{
-			reg.cpsr = get_spsr();
+			update_flags();
+			reg.cpsr = derived().get_spsr();
 
 			//Set the CPU mode accordingly
 			switch((reg.cpsr & 0x1F))
 			{
-				case 0x10: current_cpu_mode = USR; break;
-				case 0x11: current_cpu_mode = FIQ; break;
-				case 0x12: current_cpu_mode = IRQ; break;
-				case 0x13: current_cpu_mode = SVC; break;
-				case 0x17: current_cpu_mode = ABT; break;
-				case 0x1B: current_cpu_mode = UND; break;
-				case 0x1F: current_cpu_mode = SYS; break;
-				default: std::cout<<"CPU::ARM9::Warning - ARM.11 CPSR setting unknown CPU mode -> 0x" << std::hex << (reg.cpsr & 0x1F) << "\n";
+				case 0x10: derived().current_cpu_mode = cpu_type::USR; break;
+				case 0x11: derived().current_cpu_mode = cpu_type::FIQ; break;
+				case 0x12: derived().current_cpu_mode = cpu_type::IRQ; break;
+				case 0x13: derived().current_cpu_mode = cpu_type::SVC; break;
+				case 0x17: derived().current_cpu_mode = cpu_type::ABT; break;
+				case 0x1B: derived().current_cpu_mode = cpu_type::UND; break;
+				case 0x1F: derived().current_cpu_mode = cpu_type::SYS; break;
+				default: std::cout<<cpu_traits::log_name<<"::Warning - ARM.11 CPSR setting unknown CPU mode -> 0x" << std::hex << (reg.cpsr & 0x1F) << "\n";
 			}
+
+			//Switch to ARM or THUMB mode if necessary
+			derived().arm_mode = (reg.cpsr & 0x20) ? cpu_type::THUMB : cpu_type::ARM;
 		}
 	}
 
-	//Switch to THUMB mode if necessary
-	if((needs_flush) && (reg.r15 & 0x1)) 
+	//ARMv5 - Switch to THUMB mode if necessary
+	else if((cpu_traits::armv5te) && (derived().needs_flush) && (reg.r15 & 0x1))
 	{
-		arm_mode = THUMB;
+		derived().arm_mode = cpu_type::THUMB;
 		reg.cpsr |= 0x20;
 		reg.r15 &= ~0x1;
 	}
+
+	//Timings for LDM
+	if(load_store == 1)
+	{
+		//Clock CPU and controllers - 1I
+		derived().clock();
+
+		//Timings for LDM - PC
+		if(derived().needs_flush)
+		{
+			//Clock CPU and controllers - 1N + 2S
+			derived().clock(reg.r15, CODE_N32);
+			derived().clock(reg.r15, CODE_S32);
+			derived().clock((reg.r15 + 4), CODE_S32);
+		}
+
+		//Clock CPU and controllers - 1S
+		else { derived().clock((reg.r15 + 4), CODE_S32); }
+	}
+}
+
+/****** ARM.11 - Checks whether STM stores the unmodified base address for a register ******/
+template<typename cpu_type, typename cpu_traits>
+bool arm_interpreter<cpu_type, cpu_traits>::block_store_old_base(u8 current_reg, u8 base_reg, u8 first_reg, bool diff_bank)
+{
+	if((current_reg != base_reg) || (diff_bank)) { return false; }
+
+	//ARMv5 always stores the old base, ARMv4 only does so when the base is first in the list
+	if(cpu_traits::armv5te) { return true; }
+	return (current_reg == first_reg);
+}
+
+/****** ARM.11 - Checks whether LDM loading a register cancels writeback ******/
+template<typename cpu_type, typename cpu_traits>
+bool arm_interpreter<cpu_type, cpu_traits>::block_load_skips_writeback(u8 current_reg, u8 base_reg, u8 last_reg, u8 list_size)
+{
+	if(current_reg != base_reg) { return false; }
+
+	//ARMv5 writes back if the base is the only register or not the last one, ARMv4 never writes back
+	if(cpu_traits::armv5te) { return ((list_size != 1) && (current_reg == last_reg)); }
+	return true;
 }
 		
 /****** ARM.12 - Single Data Swap ******/
-void NTR_ARM9::single_data_swap(u32 current_arm_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::single_data_swap(u32 current_arm_instruction)
 {
-	//TODO - Timings
+	auto& reg = derived().reg;
 
 	//Grab source register - Bits 0-3
 	u8 src_reg = (current_arm_instruction & 0xF);
@@ -1376,7 +1507,7 @@ void NTR_ARM9::single_data_swap(u32 current_arm_instruction)
 	//Determine if a byte or word is being swapped - Bit 22
 	u8 byte_word = (current_arm_instruction & 0x400000) ? 1 : 0;
 
-	u32 base_addr = get_reg(base_reg);
+	u32 base_addr = derived().get_reg(base_reg);
 	u32 dest_value = 0;
 	u32 swap_value = 0;
 
@@ -1384,29 +1515,42 @@ void NTR_ARM9::single_data_swap(u32 current_arm_instruction)
 	if(byte_word == 1)
 	{
 		//Grab values before swapping
-		dest_value = mem->read_u8(base_addr);
-		swap_value = (get_reg(src_reg) & 0xFF);
+		dest_value = derived().mem->read_u8(base_addr);
+		swap_value = (derived().get_reg(src_reg) & 0xFF);
 
 		//Swap the values
-		mem->write_u8(base_addr, swap_value);
-		set_reg(dest_reg, dest_value);
+		derived().mem->write_u8(base_addr, swap_value);
+		derived().set_reg(dest_reg, dest_value);
+
+		//Clock CPU and controllers - 2N
+		derived().clock(base_addr, DATA_N16);
+		derived().clock(base_addr, DATA_N16);
 	}
 
 	//Swap a single word
 	else
 	{
 		//Grab values before swapping
-		dest_value = mem->read_u32(base_addr);
-		swap_value = get_reg(src_reg);
+		dest_value = derived().mem->read_u32(base_addr);
+		swap_value = derived().get_reg(src_reg);
 
 		//Swap the values
-		mem->write_u32(base_addr, swap_value);
-		set_reg(dest_reg, dest_value);
+		derived().mem->write_u32(base_addr, swap_value);
+		derived().set_reg(dest_reg, dest_value);
+
+		//Clock CPU and controllers - 2N
+		derived().clock(base_addr, DATA_N32);
+		derived().clock(base_addr, DATA_N32);
 	}
+
+	//Clock CPU and controllers - 1I + 1S
+	derived().clock();
+	derived().clock((reg.r15 + 4), CODE_S32);
 }
 
 /****** ARM.13 - Software Interrupt ******/
-void NTR_ARM9::software_interrupt_breakpoint(u32 current_arm_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::software_interrupt_breakpoint(u32 current_arm_instruction)
 {
 	//TODO - Timings
 	//TODO - LLE version of SWIs
@@ -1415,311 +1559,15 @@ void NTR_ARM9::software_interrupt_breakpoint(u32 current_arm_instruction)
 	u32 comment = (current_arm_instruction & 0xFFFFFF);
 	comment >>= 16;
 
-	process_swi(comment);
+	derived().process_swi(comment);
 }
 
-/****** Coprocessor Register Transfer ******/
-void NTR_ARM9::coprocessor_register_transfer(u32 current_instruction)
+/****** ARMv5 - Count Leading Zeroes ******/
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::count_leading_zeroes(u32 current_arm_instruction)
 {
-	//Grab opcode
-	u8 cop_opcode_1 = (current_instruction >> 21) & 0x7;
-
-	//Make sure opcode is zero to access CP15
-	if(cop_opcode_1 != 0)
-	{
-		std::cout<<"COP::Warning - Unknown Coprocessor Opcode 1 in Register Transfer : 0x" << std::hex << (int)cop_opcode_1 << "\n";
-		return;
-	}
-
-	//Grab ARM opcode
-	u8 arm_opcode = (current_instruction & 0x100000) ? 1 : 0;
-
-	//Grab coprocessor/ARM source/destination registers
-	u8 cop_reg = (current_instruction >> 16) & 0xF;
-	u8 arm_reg = (current_instruction >> 12) & 0xF;
-
-	//Grab coprocessor operand
-	u8 cop_opr = current_instruction & 0xF;
-
-	//Grab coprocessor info
-	u8 cop_info = (current_instruction >> 5) & 0x7;
-
-	//Execute MRC - Read from CP15 registers
-	if(arm_opcode)
-	{
-		//std::cout<<"MRC -> C" << (int)cop_reg << ",C" << (int)cop_opr << "," << (int)cop_info << "\n";
-
-		//Move from C0,C0,0 - 2 to ARM register
-		if((cop_reg == 0) && (cop_opr == 0))
-		{
-			switch(cop_info)
-			{
-				case 0x0: set_reg(arm_reg, co_proc.regs[CP15::C0_C0_0]); break;
-				case 0x1: set_reg(arm_reg, co_proc.regs[CP15::C0_C0_1]); break;
-				case 0x2: set_reg(arm_reg, co_proc.regs[CP15::C0_C0_2]); break;
-			}
-		}
-
-		//Move from C1,C0,0 to ARM register
-		else if((cop_reg == 1) && (cop_opr == 0) && (cop_info == 0)) { set_reg(arm_reg, co_proc.regs[CP15::C1_C0_0]); }
-
-		//Move from C2,C0,0 - 1 to ARM register
-		else if((cop_reg == 2) && (cop_opr == 0))
-		{
-			switch(cop_info)
-			{
-				case 0x0: set_reg(arm_reg, co_proc.regs[CP15::C2_C0_0]); break;
-				case 0x1: set_reg(arm_reg, co_proc.regs[CP15::C2_C0_1]); break;
-			}
-		}
-
-		//Move from C3,C0,0 to ARM register
-		else if((cop_reg == 3) && (cop_opr == 0) && (cop_info == 0)) { set_reg(arm_reg, co_proc.regs[CP15::C3_C0_0]); }
-
-		//Move from C5,C0,0 - 3 to ARM register
-		else if((cop_reg == 5) && (cop_opr == 0))
-		{
-			switch(cop_info)
-			{
-				case 0x0: set_reg(arm_reg, co_proc.regs[CP15::C5_C0_0]); break;
-				case 0x1: set_reg(arm_reg, co_proc.regs[CP15::C5_C0_1]); break;
-				case 0x2: set_reg(arm_reg, co_proc.regs[CP15::C5_C0_2]); break;
-				case 0x3: set_reg(arm_reg, co_proc.regs[CP15::C5_C0_3]); break;
-			}
-		}
-
-		//Move from C6,C0-C7,0 to ARM register
-		else if((cop_reg == 0) && (cop_info == 0))
-		{
-			switch(cop_opr)
-			{
-				case 0x0: set_reg(arm_reg, co_proc.regs[CP15::C6_C0_0]); break;
-				case 0x1: set_reg(arm_reg, co_proc.regs[CP15::C6_C1_0]); break;
-				case 0x2: set_reg(arm_reg, co_proc.regs[CP15::C6_C2_0]); break;
-				case 0x3: set_reg(arm_reg, co_proc.regs[CP15::C6_C3_0]); break;
-				case 0x4: set_reg(arm_reg, co_proc.regs[CP15::C6_C4_0]); break;
-				case 0x5: set_reg(arm_reg, co_proc.regs[CP15::C6_C5_0]); break;
-				case 0x6: set_reg(arm_reg, co_proc.regs[CP15::C6_C6_0]); break;
-				case 0x7: set_reg(arm_reg, co_proc.regs[CP15::C6_C7_0]); break;
+	auto& reg = derived().reg;
 
-			}
-		}
-
-		//Move from C6,C0-C7,1 to ARM register
-		else if((cop_reg == 0) && (cop_info == 1))
-		{
-			switch(cop_opr)
-			{
-				case 0x0: set_reg(arm_reg, co_proc.regs[CP15::C6_C0_1]); break;
-				case 0x1: set_reg(arm_reg, co_proc.regs[CP15::C6_C1_1]); break;
-				case 0x2: set_reg(arm_reg, co_proc.regs[CP15::C6_C2_1]); break;
-				case 0x3: set_reg(arm_reg, co_proc.regs[CP15::C6_C3_1]); break;
-				case 0x4: set_reg(arm_reg, co_proc.regs[CP15::C6_C4_1]); break;
-				case 0x5: set_reg(arm_reg, co_proc.regs[CP15::C6_C5_1]); break;
-				case 0x6: set_reg(arm_reg, co_proc.regs[CP15::C6_C6_1]); break;
-				case 0x7: set_reg(arm_reg, co_proc.regs[CP15::C6_C7_1]); break;
-
-			}
-		}
-
-		//C7,Cm,OP are write-only
-
-		//Move from C9,C0,0-1 to ARM register
-		else if((cop_reg == 9) && (cop_opr == 0))
-		{
-			switch(cop_info)
-			{
-				case 0x0: set_reg(arm_reg, co_proc.regs[CP15::C9_C0_0]); break;
-				case 0x1: set_reg(arm_reg, co_proc.regs[CP15::C9_C0_1]); break;
-			}
-		}
-
-		//Move from C9,C1,0-1 to ARM register
-		else if((cop_reg == 9) && (cop_opr == 1))
-		{
-			switch(cop_info)
-			{
-				case 0x0: set_reg(arm_reg, co_proc.regs[CP15::C9_C1_0]); break;
-				case 0x1: set_reg(arm_reg, co_proc.regs[CP15::C9_C1_1]); break;
-			}
-		}
-
-		else
-		{
-			std::cout<<"COP::Warning - MRC accessed unknown C15 register : C" << (int)cop_reg << ",C" << (int)cop_opr << "," << (int)cop_info << "\n";
-		} 
-	}
-
-	//Execute MCR - Write to CP15 registers
-	else
-	{
-		//std::cout<<"MCR -> C" << std::dec << (int)cop_reg << ",C" << (int)cop_opr << "," << (int)cop_info << " --> 0x" << std::hex << get_reg(arm_reg) <<"\n";
-
-		//C0,C0,0 - 2 are read-only
-
-		//Move ARM register to C1,C0,0
-		if((cop_reg == 1) && (cop_opr == 0) && (cop_info == 0))
-		{
-			//Mask C1,C0,0
-			//Bits 0, 2, 7, and 12-19 are RW
-			//Bits 3-6 are always set
-			co_proc.regs[CP15::C1_C0_0] = (get_reg(arm_reg) & 0xFF0FD);
-			co_proc.regs[CP15::C1_C0_0] |= 0x78;
-
-			co_proc.pu_enable = (co_proc.regs[CP15::C1_C0_0] & 0x1) ? true : false;
-			co_proc.unified_cache = (co_proc.regs[CP15::C1_C0_0] & 0x4) ? true : false;
-			co_proc.instr_cache = ((co_proc.regs[CP15::C1_C0_0] & 0x1000) && (!co_proc.unified_cache)) ? true : false;
-			co_proc.exception_vector = (co_proc.regs[CP15::C1_C0_0] & 0x2000) ? 0xFFFF0000 : 0x0;
-			co_proc.cache_replacement = (co_proc.regs[CP15::C1_C0_0] & 0x4000) ? true : false;
-			co_proc.pre_armv5 = (co_proc.regs[CP15::C1_C0_0] & 0x8000) ? true : false;
-			co_proc.dtcm_enable = (co_proc.regs[CP15::C1_C0_0] & 0x10000) ? true : false;
-			co_proc.itcm_enable = (co_proc.regs[CP15::C1_C0_0] & 0x40000) ? true : false;
-			
-			mem->dtcm_load_mode = (co_proc.regs[CP15::C1_C0_0] & 0x20000) ? true : false;
-			mem->itcm_load_mode = (co_proc.regs[CP15::C1_C0_0] & 0x80000) ? true : false;
-		}
-
-		//Move ARM register to C2,C0,0
-		else if((cop_reg == 2) && (cop_opr == 0))
-		{
-			switch(cop_info)
-			{
-				case 0x0: co_proc.regs[CP15::C2_C0_0] = get_reg(arm_reg); break;
-				case 0x1: co_proc.regs[CP15::C2_C0_1] = get_reg(arm_reg); break;
-			}
-		}
-
-		//Move ARM register to C3,C0,0
-		else if((cop_reg == 3) && (cop_opr == 0) && (cop_info == 0)) { co_proc.regs[CP15::C3_C0_0] = get_reg(arm_reg); }
-
-		//Move ARM register to C5,C0,0 - 3
-		else if((cop_reg == 5) && (cop_opr == 0))
-		{
-			switch(cop_info)
-			{
-				case 0x0: co_proc.regs[CP15::C5_C0_0] = get_reg(arm_reg); break;
-				case 0x1: co_proc.regs[CP15::C5_C0_1] = get_reg(arm_reg); break;
-				case 0x2: co_proc.regs[CP15::C5_C0_2] = get_reg(arm_reg); break;
-				case 0x3: co_proc.regs[CP15::C5_C0_3] = get_reg(arm_reg); break;
-			}
-		}
-
-		//Move ARM register to C6,C0-C7,0
-		else if((cop_reg == 6) && (cop_info == 0))
-		{
-			switch(cop_opr)
-			{
-				case 0x0: co_proc.regs[CP15::C6_C0_0] = get_reg(arm_reg); break;
-				case 0x1: co_proc.regs[CP15::C6_C1_0] = get_reg(arm_reg); break;
-				case 0x2: co_proc.regs[CP15::C6_C2_0] = get_reg(arm_reg); break;
-				case 0x3: co_proc.regs[CP15::C6_C3_0] = get_reg(arm_reg); break;
-				case 0x4: co_proc.regs[CP15::C6_C4_0] = get_reg(arm_reg); break;
-				case 0x5: co_proc.regs[CP15::C6_C5_0] = get_reg(arm_reg); break;
-				case 0x6: co_proc.regs[CP15::C6_C6_0] = get_reg(arm_reg); break;
-				case 0x7: co_proc.regs[CP15::C6_C7_0] = get_reg(arm_reg); break;
-
-			}
-		}
-
-		//Move ARM register to C6,C0-C7,1
-		else if((cop_reg == 6) && (cop_info == 1))
-		{
-			switch(cop_opr)
-			{
-				case 0x0: co_proc.regs[CP15::C6_C0_1] = get_reg(arm_reg); break;
-				case 0x1: co_proc.regs[CP15::C6_C1_1] = get_reg(arm_reg); break;
-				case 0x2: co_proc.regs[CP15::C6_C2_1] = get_reg(arm_reg); break;
-				case 0x3: co_proc.regs[CP15::C6_C3_1] = get_reg(arm_reg); break;
-				case 0x4: co_proc.regs[CP15::C6_C4_1] = get_reg(arm_reg); break;
-				case 0x5: co_proc.regs[CP15::C6_C5_1] = get_reg(arm_reg); break;
-				case 0x6: co_proc.regs[CP15::C6_C6_1] = get_reg(arm_reg); break;
-				case 0x7: co_proc.regs[CP15::C6_C7_1] = get_reg(arm_reg); break;
-
-			}
-		}
-
-		//Move ARM register to C7,Cm,OP
-		else if(cop_reg == 7)
-		{
-			co_proc.regs[CP15::C7_CM_XX] = get_reg(arm_reg);
-
-			//C7, C0, 4
-			if((cop_opr == 0) && (cop_info == 4))
-			{
-				idle_state = 1;
-				last_idle_state = 1;
-				mem->nds9_temp_if = mem->nds9_if;
-				mem->nds9_if = 0;
-				//std::cout<<"ARM9 HALT\n";
-			}
-
-			//C7,C5,0
-			if((cop_opr == 5) && (cop_info == 0)) { co_proc.invalidate_instr_cache(); }
-
-			//C7,C5,1
-			else if((cop_opr == 5) && (cop_info == 1)) { co_proc.invalidate_instr_cache_line(co_proc.regs[CP15::C7_CM_XX]); }
-
-			//C7,C6,0
-			else if((cop_opr == 6) && (cop_info == 0)) { co_proc.invalidate_data_cache(); }
-
-			//C7,C6,1
-			else if((cop_opr == 6) && (cop_info == 1)) { co_proc.invalidate_data_cache_line(co_proc.regs[CP15::C7_CM_XX]); }
-
-			//C7,C8,2
-			else if((cop_opr == 8) && (cop_info == 2)) { idle_state = 1; }
-
-			//C7,C10,4
-			else if((cop_opr == 10) && (cop_info == 4)) { co_proc.drain_write_buffer(); }
-
-		}
-
-		//Move ARM register to C9,C0,0-1
-		else if((cop_reg == 9) && (cop_opr == 0))
-		{
-			switch(cop_info)
-			{
-				case 0x0:
-					co_proc.regs[CP15::C9_C0_0] = get_reg(arm_reg);
-					co_proc.data_cache_lockdown();
-					break;
-
-				case 0x1:
-					co_proc.regs[CP15::C9_C0_1] = get_reg(arm_reg);
-					co_proc.instr_cache_lockdown();
-					break;
-			}
-		}
-
-		//Move ARM register to C9,C1,0-1
-		else if((cop_reg == 9) && (cop_opr == 1))
-		{
-			switch(cop_info)
-			{
-				case 0x0:
-					co_proc.regs[CP15::C9_C1_0] = get_reg(arm_reg);
-					co_proc.set_dtcm_size_base();
-					mem->nds9_irq_handler = co_proc.regs[CP15::CP15_TEMP] + 0x3FFC;
-					mem->dtcm_addr = co_proc.regs[CP15::CP15_TEMP];
-					mem->dtcm_end = mem->dtcm_addr + (512 << ((co_proc.regs[CP15::C9_C1_0] >> 1) & 0x1F));
-					break;
-
-				case 0x1:
-					co_proc.regs[CP15::C9_C1_1] = get_reg(arm_reg);
-					co_proc.set_itcm_size_base();
-					break;
-			}
-		}
-
-		else
-		{
-			std::cout<<"COP::Warning - MCR accessed unknown C15 register : C" << (int)cop_reg << ",C" << (int)cop_opr << "," << (int)cop_info << "\n";
-		}
-	}
-}
-
-/****** Count Leading Zeroes ******/
-void NTR_ARM9::count_leading_zeroes(u32 current_arm_instruction)
-{
 	//Grab source register - Bits 0-3
 	u8 src_reg = (current_arm_instruction & 0xF);
 
@@ -1727,7 +1575,7 @@ void NTR_ARM9::count_leading_zeroes(u32 current_arm_instruction)
 	u8 dest_reg = ((current_arm_instruction >> 12) & 0xF);
 	
 	u32 zeroes = 0;
-	u32 counting_reg = get_reg(src_reg);
+	u32 counting_reg = derived().get_reg(src_reg);
 
 	//If source register is zero, CLZ returns 32
 	if(!counting_reg) { zeroes = 32; }
@@ -1746,15 +1594,18 @@ void NTR_ARM9::count_leading_zeroes(u32 current_arm_instruction)
 	}
 
 	//Set destination register to result of CLZ
-	set_reg(dest_reg, zeroes);
+	derived().set_reg(dest_reg, zeroes);
 		
 	//Clock CPU and controllers - 1S
-	clock((reg.r15 + 4), CODE_S32);
+	derived().clock((reg.r15 + 4), CODE_S32);
 }
 
-/****** QADD and QSUB ******/
-void NTR_ARM9::sticky_math(u32 current_arm_instruction)
+/****** ARMv5 - QADD and QSUB ******/
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::sticky_math(u32 current_arm_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab 1st source register - Bits 0-3
 	u8 src1_reg = (current_arm_instruction & 0xF);
 
@@ -1777,8 +1628,8 @@ void NTR_ARM9::sticky_math(u32 current_arm_instruction)
 	{
 		//QADD
 		case 0x0:
-			input_1 = get_reg(src1_reg);
-			input_2 = get_reg(src2_reg);
+			input_1 = derived().get_reg(src1_reg);
+			input_2 = derived().get_reg(src2_reg);
 			result = input_1 + input_2;
 			
 			//Saturate result if necessary
@@ -1786,14 +1637,14 @@ void NTR_ARM9::sticky_math(u32 current_arm_instruction)
 			if(sat_code == 1) { result = 0x7FFFFFFF; }
 			else if(sat_code == 2) { result = 0x80000000; }
 
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			break;
 
 		//QSUB
 		case 0x2:
-			input_1 = get_reg(src1_reg);
-			input_2 = get_reg(src2_reg);
+			input_1 = derived().get_reg(src1_reg);
+			input_2 = derived().get_reg(src2_reg);
 			result = input_1 - input_2;
 			
 			//Saturate result if necessary
@@ -1801,14 +1652,14 @@ void NTR_ARM9::sticky_math(u32 current_arm_instruction)
 			if(sat_code == 1) { result = 0x7FFFFFFF; }
 			else if(sat_code == 2) { result = 0x80000000; }
 
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			break;
 
 		//QDADD
 		case 0x4:
-			input_1 = get_reg(src1_reg);
-			input_2 = get_reg(src2_reg);
+			input_1 = derived().get_reg(src1_reg);
+			input_2 = derived().get_reg(src2_reg);
 
 			//Clamp results of Rn * 2 if necessary to max positive 32-bit signed int
 			//Set Q flag as well
@@ -1835,14 +1686,14 @@ void NTR_ARM9::sticky_math(u32 current_arm_instruction)
 			sat_code = update_sticky_overflow(input_1, input_2n, result, true);
 			if(sat_code == 1) { result = 0x7FFFFFFF; }
 			else if(sat_code == 2) { result = 0x80000000; }
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			break;
 
 		//QDSUB
 		case 0x6:
-			input_1 = get_reg(src1_reg);
-			input_2 = get_reg(src2_reg);
+			input_1 = derived().get_reg(src1_reg);
+			input_2 = derived().get_reg(src2_reg);
 
 			//Clamp results of Rn * 2 if necessary to max positive 32-bit signed int
 			//Set Q flag as well
@@ -1870,15 +1721,59 @@ void NTR_ARM9::sticky_math(u32 current_arm_instruction)
 			if(sat_code == 1) { result = 0x7FFFFFFF; }
 			else if(sat_code == 2) { result = 0x80000000; }
 
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			break;
 
 		//Unknown opcode
 		default:
-			std::cout<<"CPU::ARM9::Warning - Unknown QADD-QSUB opcode 0x" << std::hex << (u16)op << "\n";
+			std::cout<<cpu_traits::log_name<<"::Warning - Unknown QADD-QSUB opcode 0x" << std::hex << (u16)op << "\n";
 	}
 
 	//Clock CPU and controllers - 1S
-	clock((reg.r15 + 4), CODE_S32);
+	derived().clock((reg.r15 + 4), CODE_S32);
 }
+
+/****** Updates the condition code in CPSR for Sticky Overflow after ARMv5 saturating and signed multiply operations ******/
+template<typename cpu_type, typename cpu_traits>
+u8 arm_interpreter<cpu_type, cpu_traits>::update_sticky_overflow(u32 input, u32 operand, u32 result, bool addition)
+{
+	auto& reg = derived().reg;
+
+	u8 input_msb = (input & 0x80000000) ? 1 : 0;
+	u8 operand_msb = (operand & 0x80000000) ? 1 : 0;
+	u8 result_msb = (result & 0x80000000) ? 1 : 0;
+	u8 saturation_code = 0;
+
+	if(addition)
+	{
+		if(!input_msb && !operand_msb && result_msb) { reg.cpsr |= CPSR_Q_FLAG; saturation_code = 1; }
+		else if(input_msb && operand_msb && !result_msb) { reg.cpsr |= CPSR_Q_FLAG; saturation_code = 2; }
+	}
+
+	else
+	{
+		if(!input_msb && operand_msb && result_msb) { reg.cpsr |= CPSR_Q_FLAG; saturation_code = 1; }
+		else if(input_msb && !operand_msb && !result_msb) { reg.cpsr |= CPSR_Q_FLAG; saturation_code = 2; }
+	} 
+
+	return saturation_code;
+}
+
+/****** Returns the internal cycles a multiply takes, based on how many upper bytes of the multiplier are significant ******/
+template<typename cpu_type, typename cpu_traits>
+u8 arm_interpreter<cpu_type, cpu_traits>::multiply_cycles(u32 multiplier, bool is_signed)
+{
+	u8 cycles = 1;
+
+	//Signed multiplies stop early when the upper bytes are all 1s, too
+	for(u32 mask = 0xFFFFFF00; cycles < 4; mask <<= 8, cycles++)
+	{
+		u32 upper_bytes = (multiplier & mask);
+		if((upper_bytes == 0) || ((is_signed) && (upper_bytes == mask))) { break; }
+	}
+
+	return cycles;
+}
+
+#endif // GBE_ARM_INSTR
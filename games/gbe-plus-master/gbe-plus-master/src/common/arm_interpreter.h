@@ -0,0 +1,1378 @@
+// GB Enhanced+ Copyright Daniel Baxter 2014
+// Licensed under the GPLv2
+// See LICENSE.txt for full license text
+
+// File : arm_interpreter.h
+// Date : October 16, 2026
+// Description : Shared ARM interpreter core
+//
+// Decoding, condition checks, flag updates, the barrel shifter, and every ARM and THUMB instruction handler
+// shared by the GBA ARM7, NDS7, and NDS9
+// Each CPU inherits from arm_interpreter with itself and a set of CPU traits (CRTP)
+// Differences between CPUs are resolved at compile time through the traits
+// Memory, timing, and register banking are reached through the CPU (reg, mem, clock, get_reg, set_reg, etc)
+
+#ifndef GBE_ARM_INTERPRETER
+#define GBE_ARM_INTERPRETER
+
+#include <array>
+#include <utility>
+#include <algorithm>
+#include <iostream>
+
+#include "common.h"
+
+//Longest polling loop, in instructions, that can be skipped as an idle loop
+const u32 IDLE_LOOP_MAX_OPS = 8;
+
+//Kinds of flag-setting operations waiting to be applied to the CPSR
+const u8 LAZY_FLAGS_NONE = 0;
+const u8 LAZY_FLAGS_LOGICAL = 1;
+const u8 LAZY_FLAGS_ARITHMETIC = 2;
+
+//ARM7TDMI - GBA CPU and NDS7
+//Each CPU derives its own traits from these and adds :
+//log_name - Prefix for warnings and errors
+//idle_loop_branches - Branches report backwards jumps to the idle loop detector
+//long_branch_holds_irq - Interrupts wait for both halves of THUMB.19
+struct armv4t_traits
+{
+	static const bool armv5te = false;
+	static const bool has_cp15 = false;
+};
+
+//ARM946E-S - NDS9
+struct armv5te_traits
+{
+	static const bool armv5te = true;
+	static const bool has_cp15 = true;
+};
+
+template<typename cpu_type, typename cpu_traits>
+class arm_interpreter
+{
+	public:
+
+	//Memory access types for timing - Code or Data, Non-Sequential or Sequential, 16-bit or 32-bit
+	enum mem_modes
+	{
+		CODE_N16,
+		CODE_N32,
+		CODE_S16,
+		CODE_S32,
+		DATA_N16,
+		DATA_N32,
+		DATA_S16,
+		DATA_S32,
+	};
+
+	//Instruction decoding
+	static auto decode_arm(u32 current_instruction);
+	static auto decode_thumb(u16 current_instruction);
+
+	//Instruction lookup table construction
+	static constexpr auto classify_arm(u32 current_instruction);
+	static constexpr auto classify_thumb(u16 current_instruction);
+	static constexpr auto make_arm_decode_table();
+	static constexpr auto make_thumb_decode_table();
+	template<u32 index> static constexpr auto make_arm_handler();
+	template<u32 index> static constexpr auto make_thumb_handler();
+	template<std::size_t... index> static constexpr auto make_arm_handler_table(std::index_sequence<index...>);
+	template<std::size_t... index> static constexpr auto make_thumb_handler_table(std::index_sequence<index...>);
+
+	//Misc CPU helpers
+	void update_condition_logical(u32 result, u8 shift_out);
+	void update_condition_arithmetic(u32 input, u64 operand, u32 result, bool addition);
+	void update_flags();
+	u32 get_cpsr() const;
+
+	#ifdef GBE_LAZY_FLAGS_VERIFY
+	void verify_lazy_flags();
+	#endif
+	bool check_condition(u32 current_arm_instruction);
+	u8 logical_shift_left(u32& input, u8 offset);
+	u8 logical_shift_right(u32& input, u8 offset);
+	u8 arithmetic_shift_right(u32& input, u8 offset);
+	u8 rotate_right(u32& input, u8 offset);
+	u8 rotate_right_special(u32& input, u8 offset);
+	u8 multiply_cycles(u32 multiplier, bool is_signed);
+	bool block_store_old_base(u8 current_reg, u8 base_reg, u8 first_reg, bool diff_bank);
+	bool block_load_skips_writeback(u8 current_reg, u8 base_reg, u8 last_reg, u8 list_size);
+	u8 update_sticky_overflow(u32 input, u32 operand, u32 result, bool addition);
+
+	//ARM instructions
+	void branch_exchange(u32 current_arm_instruction);
+	void branch_link(u32 current_arm_instruction);
+	template<u8 op, bool set_cc, bool use_immediate> void data_processing(u32 current_arm_instruction);
+	void psr_transfer(u32 current_arm_instruction);
+	void multiply(u32 current_arm_instruction);
+	template<u8 offset_is_register, u8 pre_post, u8 up_down, u8 byte_word, u8 write_back, u8 load_store> void single_data_transfer(u32 current_arm_instruction);
+	void halfword_signed_transfer(u32 current_arm_instruction);
+	void block_data_transfer(u32 current_arm_instruction);
+	void single_data_swap(u32 current_arm_instruction);
+	void software_interrupt_breakpoint(u32 current_arm_instruction);
+
+	//ARMv5 instructions
+	void count_leading_zeroes(u32 current_arm_instruction);
+	void sticky_math(u32 current_arm_instruction);
+
+	//THUMB instructions
+	void move_shifted_register(u16 current_thumb_instruction);
+	void add_sub_immediate(u16 current_thumb_instruction);
+	void mcas_immediate(u16 current_thumb_instruction);
+	template<u8 op> void alu_ops(u16 current_thumb_instruction);
+	void hireg_bx(u16 current_thumb_instruction);
+	void load_pc_relative(u16 current_thumb_instruction);
+	void load_store_reg_offset(u16 current_thumb_instruction);
+	void load_store_sign_ex(u16 current_thumb_instruction);
+	void load_store_imm_offset(u16 current_thumb_instruction);
+	void load_store_halfword(u16 current_thumb_instruction);
+	void load_store_sp_relative(u16 current_thumb_instruction);
+	void get_relative_address(u16 current_thumb_instruction);
+	void add_offset_sp(u16 current_thumb_instruction);
+	void push_pop(u16 current_thumb_instruction);
+	void multiple_load_store(u16 current_thumb_instruction);
+	void conditional_branch(u16 current_thumb_instruction);
+	void unconditional_branch(u16 current_thumb_instruction);
+	void long_branch_link(u16 current_thumb_instruction);
+
+	//Idle loop detection
+	u8 scan_idle_loop(u32 loop_start);
+	bool poll_idle_loop(u32 loop_start, u8 loop_length, u32* poll_values);
+	bool update_idle_loop(u32 loop_addr, u8 loop_length);
+	bool idle_loop_changed();
+	void idle_loop_branch(u32 branch_addr);
+
+	//Polling loop currently being watched, keyed by PC with Bit 0 set for THUMB
+	//Registers and polled values are from the last pass through the loop
+	bool idle_loop_skip;
+	u32 idle_loop_addr;
+	u8 idle_loop_length;
+	u32 idle_regs[16];
+	u32 idle_poll_values[IDLE_LOOP_MAX_OPS];
+
+	//Last flag-setting operation - N, Z, C, and V in the CPSR are stale until update_flags() applies it
+	u8 flag_op;
+	u32 flag_input;
+	u64 flag_operand;
+	u32 flag_result;
+	u8 flag_shift_out;
+	bool flag_addition;
+
+	#ifdef GBE_LAZY_FLAGS_VERIFY
+	//N, Z, C, and V worked out eagerly when the last flag-setting operation was recorded
+	u32 verify_flags;
+	#endif
+
+	private:
+
+	cpu_type& derived() { return static_cast<cpu_type&>(*this); }
+	const cpu_type& derived() const { return static_cast<const cpu_type&>(*this); }
+};
+
+/****** Decodes ARM instructions ******/
+template<typename cpu_type, typename cpu_traits>
+auto arm_interpreter<cpu_type, cpu_traits>::decode_arm(u32 current_instruction)
+{
+	//ARM.3 depends on more bits than the table covers
+	if(((current_instruction >> 8) & 0xFFFFF) == 0x12FFF) { return cpu_type::ARM_3; }
+
+	//CLZ and QADD-QSUB depend on more bits than the table covers
+	if constexpr(cpu_traits::armv5te)
+	{
+		if((((current_instruction >> 16) & 0xFFF) == 0x16F) && (((current_instruction >> 4) & 0xFF) == 0xF1)) { return cpu_type::ARM_CLZ; }
+		if(((current_instruction & 0xD900000) == 0x1000000) && (((current_instruction >> 24) & 0xF) == 0x1) && (((current_instruction >> 4) & 0xFF) == 0x5)) { return cpu_type::ARM_QADD_QSUB; }
+	}
+
+	return cpu_type::arm_decode_table[((current_instruction >> 16) & 0xFF0) | ((current_instruction >> 4) & 0xF)];
+}
+
+/****** Decodes THUMB instructions ******/
+template<typename cpu_type, typename cpu_traits>
+auto arm_interpreter<cpu_type, cpu_traits>::decode_thumb(u16 current_instruction)
+{
+	return cpu_type::thumb_decode_table[(current_instruction >> 6) & 0x3FF];
+}
+
+/****** Classifies ARM instructions using only Bits 20-27 and 4-7 - ARM.3 is checked separately ******/
+template<typename cpu_type, typename cpu_traits>
+constexpr auto arm_interpreter<cpu_type, cpu_traits>::classify_arm(u32 current_instruction)
+{
+	if(((current_instruction >> 25) & 0x7) == 0x5)
+	{
+		//ARM_4
+		return cpu_type::ARM_4;
+	}
+
+	//TODO - Move ARM_6 decoding to final stage of ARM_5 decoding
+	//TODO - Move ARM_12 deconding to final stage of ARM_10 decoding
+
+	else if((current_instruction & 0xD900000) == 0x1000000)
+	{
+		if((current_instruction & 0x80) && (current_instruction & 0x10) && ((current_instruction & 0x2000000) == 0))
+		{
+			if(((current_instruction >> 5) & 0x3) == 0)
+			{
+				return cpu_type::ARM_12;
+			}
+
+			else
+			{
+				return cpu_type::ARM_10;
+			}
+		}
+
+		//ARMv5TE signed halfword multiplies
+		else if((cpu_traits::armv5te) && (current_instruction & 0x80) && ((current_instruction & 0x2000000) == 0))
+		{
+			return cpu_type::ARM_7;
+		}
+
+		//ARM_6
+		else
+		{
+			return cpu_type::ARM_6;
+		}
+	}
+
+	else if(((current_instruction >> 26) & 0x3) == 0x0)
+	{
+		if((current_instruction & 0x80) && ((current_instruction & 0x10) == 0))
+		{
+			//ARM.5
+			if(current_instruction & 0x2000000)
+			{
+				return cpu_type::ARM_5;
+			}
+
+			//ARM.5
+			else if((current_instruction & 0x100000) && (((current_instruction >> 23) & 0x3) == 0x2))
+			{
+				return cpu_type::ARM_5;
+			}
+
+			//ARM.5
+			else if(((current_instruction >> 23) & 0x3) != 0x2)
+			{
+				return cpu_type::ARM_5;
+			}
+
+			//ARM.7
+			else
+			{
+				return cpu_type::ARM_7;
+			}
+		}
+
+		else if((current_instruction & 0x80) && (current_instruction & 0x10))
+		{
+			if(((current_instruction >> 4) & 0xF) == 0x9)
+			{
+				//ARM.5
+				if(current_instruction & 0x2000000)
+				{
+					return cpu_type::ARM_5;
+				}
+
+				//ARM.12
+				else if(((current_instruction >> 23) & 0x3) == 0x2)
+				{
+					return cpu_type::ARM_12;
+				}
+
+				//ARM.7
+				else
+				{
+					return cpu_type::ARM_7;
+				}
+			}
+
+			//ARM.5
+			else if(current_instruction & 0x2000000)
+			{
+				return cpu_type::ARM_5;
+			}
+
+			//ARM.10
+			else
+			{
+				return cpu_type::ARM_10;
+			}
+		}
+
+		//ARM.5
+		else
+		{
+			return cpu_type::ARM_5;
+		}
+	}
+
+	else if(((current_instruction >> 26) & 0x3) == 0x1)
+	{
+		//ARM_9
+		return cpu_type::ARM_9;
+	}
+
+	else if(((current_instruction >> 25) & 0x7) == 0x4)
+	{
+		//ARM_11
+		return cpu_type::ARM_11;
+	}
+
+	else if(((current_instruction >> 24) & 0xF) == 0xF)
+	{
+		//ARM_13
+		return cpu_type::ARM_13;
+	}
+
+	//Coprocessor instructions
+	if constexpr(cpu_traits::has_cp15)
+	{
+		if(((current_instruction >> 24) & 0xF) == 0xE)
+		{
+			//ARM Coprocessor Register Transfer
+			if(current_instruction & 0x10) { return cpu_type::ARM_COP_REG_TRANSFER; }
+
+			//ARM Coprocessor Data Operation
+			else { return cpu_type::ARM_COP_DATA_OP; }
+		}
+
+		else if(((current_instruction >> 25) & 0x7) == 6)
+		{
+			//ARM Coprocessor Data Transfer
+			return cpu_type::ARM_COP_DATA_TRANSFER;
+		}
+	}
+
+	return cpu_type::UNDEFINED;
+}
+
+/****** Classifies THUMB instructions using Bits 6-15 ******/
+template<typename cpu_type, typename cpu_traits>
+constexpr auto arm_interpreter<cpu_type, cpu_traits>::classify_thumb(u16 current_instruction)
+{
+
+	if(((current_instruction >> 13) == 0) && (((current_instruction >> 11) & 0x7) != 0x3))
+	{
+		//THUMB_1
+		return cpu_type::THUMB_1;
+	}
+
+	else if(((current_instruction >> 11) & 0x1F) == 0x3)
+	{
+		//THUMB_2
+		return cpu_type::THUMB_2;
+	}
+
+	else if((current_instruction >> 13) == 0x1)
+	{
+		//THUMB_3
+		return cpu_type::THUMB_3;
+	}
+
+	else if(((current_instruction >> 10) & 0x3F) == 0x10)
+	{
+		//THUMB_4
+		return cpu_type::THUMB_4;
+	}
+
+	else if(((current_instruction >> 10) & 0x3F) == 0x11)
+	{
+		//THUMB_5
+		return cpu_type::THUMB_5;
+	}
+
+	else if((current_instruction >> 11) == 0x9)
+	{
+		//THUMB_6
+		return cpu_type::THUMB_6;
+	}
+
+	else if((current_instruction >> 12) == 0x5)
+	{
+		if(current_instruction & 0x200)
+		{
+			//THUMB_8
+			return cpu_type::THUMB_8;
+		}
+
+		else
+		{
+			//THUMB_7
+			return cpu_type::THUMB_7;
+		}
+	}
+
+	else if(((current_instruction >> 13) & 0x7) == 0x3)
+	{
+		//THUMB_9
+		return cpu_type::THUMB_9;
+	}
+
+	else if((current_instruction >> 12) == 0x8)
+	{
+		//THUMB_10
+		return cpu_type::THUMB_10;
+	}
+
+	else if((current_instruction >> 12) == 0x9)
+	{
+		//THUMB_11
+		return cpu_type::THUMB_11;
+	}
+
+	else if((current_instruction >> 12) == 0xA)
+	{
+		//THUMB_12
+		return cpu_type::THUMB_12;
+	}
+
+	else if((current_instruction >> 8) == 0xB0)
+	{
+		//THUMB_13
+		return cpu_type::THUMB_13;
+	}
+
+	else if((current_instruction >> 12) == 0xB)
+	{
+		//THUMB_14
+		return cpu_type::THUMB_14;
+	}
+
+	else if((current_instruction >> 12) == 0xC)
+	{
+		//THUMB_15
+		return cpu_type::THUMB_15;
+	}
+
+	else if((current_instruction >> 12) == 13)
+	{
+		//THUMB_16
+		return cpu_type::THUMB_16;
+	}
+
+	else if((current_instruction >> 11) == 0x1C)
+	{
+		//THUMB_18
+		return cpu_type::THUMB_18;
+	}
+
+	else if((current_instruction >> 11) >= 0x1E)
+	{
+		//THUMB_19
+		return cpu_type::THUMB_19;
+	}
+
+	//THUMB_19 BLX
+	if constexpr(cpu_traits::armv5te)
+	{
+		if((current_instruction & 0xF800) == 0xE800) { return cpu_type::THUMB_19; }
+	}
+
+	return cpu_type::UNDEFINED;
+}
+
+/****** Builds the ARM decode table ******/
+template<typename cpu_type, typename cpu_traits>
+constexpr auto arm_interpreter<cpu_type, cpu_traits>::make_arm_decode_table()
+{
+	std::array<typename cpu_type::arm_instructions, 4096> table = {};
+
+	for(u32 x = 0; x < 4096; x++) { table[x] = classify_arm(((x & 0xFF0) << 16) | ((x & 0xF) << 4)); }
+
+	return table;
+}
+
+/****** Builds the THUMB decode table ******/
+template<typename cpu_type, typename cpu_traits>
+constexpr auto arm_interpreter<cpu_type, cpu_traits>::make_thumb_decode_table()
+{
+	std::array<typename cpu_type::arm_instructions, 1024> table = {};
+
+	for(u32 x = 0; x < 1024; x++) { table[x] = classify_thumb(x << 6); }
+
+	return table;
+}
+
+/****** Picks the handler for one entry of the ARM handler table ******/
+template<typename cpu_type, typename cpu_traits>
+template<u32 index>
+constexpr auto arm_interpreter<cpu_type, cpu_traits>::make_arm_handler()
+{
+	typedef typename cpu_type::arm_handler_func handler_func;
+
+	constexpr u32 opcode = ((index & 0xFF0) << 16) | ((index & 0xF) << 4);
+	constexpr auto type = classify_arm(opcode);
+
+	if constexpr(type == cpu_type::ARM_5)
+	{
+		return handler_func(&cpu_type::template data_processing<((opcode >> 21) & 0xF), ((opcode >> 20) & 0x1), ((opcode >> 25) & 0x1)>);
+	}
+
+	else if constexpr(type == cpu_type::ARM_9)
+	{
+		return handler_func(&cpu_type::template single_data_transfer<((opcode >> 25) & 0x1), ((opcode >> 24) & 0x1), ((opcode >> 23) & 0x1),
+		((opcode >> 22) & 0x1), ((opcode >> 21) & 0x1), ((opcode >> 20) & 0x1)>);
+	}
+
+	else
+	{
+		//Coprocessor Register Transfers only exist on CPUs with CP15
+		if constexpr(cpu_traits::has_cp15)
+		{
+			if(type == cpu_type::ARM_COP_REG_TRANSFER) { return handler_func(&cpu_type::coprocessor_register_transfer); }
+		}
+
+		switch(type)
+		{
+			case cpu_type::ARM_4: return handler_func(&cpu_type::branch_link);
+			case cpu_type::ARM_6: return handler_func(&cpu_type::psr_transfer);
+			case cpu_type::ARM_7: return handler_func(&cpu_type::multiply);
+			case cpu_type::ARM_10: return handler_func(&cpu_type::halfword_signed_transfer);
+			case cpu_type::ARM_11: return handler_func(&cpu_type::block_data_transfer);
+			case cpu_type::ARM_12: return handler_func(&cpu_type::single_data_swap);
+			case cpu_type::ARM_13: return handler_func(&cpu_type::software_interrupt_breakpoint);
+			default: return handler_func(NULL);
+		}
+	}
+}
+
+/****** Picks the handler for one entry of the THUMB handler table ******/
+template<typename cpu_type, typename cpu_traits>
+template<u32 index>
+constexpr auto arm_interpreter<cpu_type, cpu_traits>::make_thumb_handler()
+{
+	typedef typename cpu_type::thumb_handler_func handler_func;
+
+	constexpr auto type = classify_thumb(index << 6);
+
+	switch(type)
+	{
+		case cpu_type::THUMB_1: return handler_func(&cpu_type::move_shifted_register);
+		case cpu_type::THUMB_2: return handler_func(&cpu_type::add_sub_immediate);
+		case cpu_type::THUMB_3: return handler_func(&cpu_type::mcas_immediate);
+		case cpu_type::THUMB_4: return handler_func(&cpu_type::template alu_ops<(index & 0xF)>);
+		case cpu_type::THUMB_5: return handler_func(&cpu_type::hireg_bx);
+		case cpu_type::THUMB_6: return handler_func(&cpu_type::load_pc_relative);
+		case cpu_type::THUMB_7: return handler_func(&cpu_type::load_store_reg_offset);
+		case cpu_type::THUMB_8: return handler_func(&cpu_type::load_store_sign_ex);
+		case cpu_type::THUMB_9: return handler_func(&cpu_type::load_store_imm_offset);
+		case cpu_type::THUMB_10: return handler_func(&cpu_type::load_store_halfword);
+		case cpu_type::THUMB_11: return handler_func(&cpu_type::load_store_sp_relative);
+		case cpu_type::THUMB_12: return handler_func(&cpu_type::get_relative_address);
+		case cpu_type::THUMB_13: return handler_func(&cpu_type::add_offset_sp);
+		case cpu_type::THUMB_14: return handler_func(&cpu_type::push_pop);
+		case cpu_type::THUMB_15: return handler_func(&cpu_type::multiple_load_store);
+		case cpu_type::THUMB_16: return handler_func(&cpu_type::conditional_branch);
+		case cpu_type::THUMB_18: return handler_func(&cpu_type::unconditional_branch);
+		case cpu_type::THUMB_19: return handler_func(&cpu_type::long_branch_link);
+		default: return handler_func(NULL);
+	}
+}
+
+/****** Builds the ARM handler table ******/
+template<typename cpu_type, typename cpu_traits>
+template<std::size_t... index>
+constexpr auto arm_interpreter<cpu_type, cpu_traits>::make_arm_handler_table(std::index_sequence<index...>)
+{
+	return std::array<typename cpu_type::arm_handler_func, sizeof...(index)> {{ make_arm_handler<index>()... }};
+}
+
+/****** Builds the THUMB handler table ******/
+template<typename cpu_type, typename cpu_traits>
+template<std::size_t... index>
+constexpr auto arm_interpreter<cpu_type, cpu_traits>::make_thumb_handler_table(std::index_sequence<index...>)
+{
+	return std::array<typename cpu_type::thumb_handler_func, sizeof...(index)> {{ make_thumb_handler<index>()... }};
+}
+
+/****** Check conditional code ******/
+template<typename cpu_type, typename cpu_traits>
+bool arm_interpreter<cpu_type, cpu_traits>::check_condition(u32 current_arm_instruction)
+{
+	const auto& reg = derived().reg;
+
+	//AL and NV never look at the condition codes
+	if((current_arm_instruction >> 28) < 0xE) { update_flags(); }
+
+	switch(current_arm_instruction >> 28)
+	{
+		//EQ
+		case 0x0:
+			if(reg.cpsr & CPSR_Z_FLAG) { return true; }
+			else { return false; }
+			break;
+
+		//NE
+		case 0x1:
+			if(reg.cpsr & CPSR_Z_FLAG) { return false; }
+			else { return true; }
+			break;
+
+		//CS
+		case 0x2:
+			if(reg.cpsr & CPSR_C_FLAG) { return true; }
+			else { return false; }
+			break;
+
+		//CC
+		case 0x3:
+			if(reg.cpsr & CPSR_C_FLAG) { return false; }
+			else { return true; }
+			break;
+
+		//MI
+		case 0x4:
+			if(reg.cpsr & CPSR_N_FLAG) { return true; }
+			else { return false; }
+			break;
+
+		//PL
+		case 0x5:
+			if(reg.cpsr & CPSR_N_FLAG) { return false; }
+			else { return true; }
+			break;
+
+		//VS
+		case 0x6:
+			if(reg.cpsr & CPSR_V_FLAG) { return true; }
+			else { return false; }
+			break;
+
+		//VC
+		case 0x7:
+			if(reg.cpsr & CPSR_V_FLAG) { return false; }
+			else { return true; }
+			break;
+
+		//HI
+		case 0x8:
+			if((reg.cpsr & CPSR_C_FLAG) && ((reg.cpsr & CPSR_Z_FLAG) == 0)) { return true; }
+			else { return false; }
+			break;
+
+		//LS
+		case 0x9:
+			if((reg.cpsr & CPSR_Z_FLAG) || ((reg.cpsr & CPSR_C_FLAG) == 0)) { return true; }
+			else { return false; }
+			break;
+
+		//GE
+		case 0xA:
+			{
+				u8 n = (reg.cpsr & CPSR_N_FLAG) ? 1 : 0;
+				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
+
+				if(n == v) { return true; }
+				else { return false; }
+			}
+			break;
+
+		//LT
+		case 0xB:
+			{
+				u8 n = (reg.cpsr & CPSR_N_FLAG) ? 1 : 0;
+				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
+
+				if(n != v) { return true; }
+				else { return false; }
+			}
+			break;
+
+		//GT
+		case 0xC:
+			{
+				u8 n = (reg.cpsr & CPSR_N_FLAG) ? 1 : 0;
+				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
+				u8 z = (reg.cpsr & CPSR_Z_FLAG) ? 1 : 0;
+
+				if((z == 0) && (n == v)) { return true; }
+				else { return false; }
+			}
+			break;
+
+		//LE
+		case 0xD:
+			{
+				u8 n = (reg.cpsr & CPSR_N_FLAG) ? 1 : 0;
+				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
+				u8 z = (reg.cpsr & CPSR_Z_FLAG) ? 1 : 0;
+
+				if((z == 1) || (n != v)) { return true; }
+				else { return false; }
+			}
+			break;
+
+		//AL
+		case 0xE: return true; break;
+
+		//NV
+		//NV - ARMv5 reuses this for unconditional instructions like BLX
+		default:
+			if constexpr(!cpu_traits::armv5te) { std::cout<<"CPU::Warning: ARM instruction uses reserved conditional code NV \n"; }
+			return true;
+	}
+}
+
+/****** Records a logical operation for the condition codes - N and Z come from the result, C from the shifter ******/
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::update_condition_logical(u32 result, u8 shift_out)
+{
+	//Overflow is always left alone, and carry when nothing was shifted out, so they have to come from the last operation
+	if((shift_out > 1) || (flag_op == LAZY_FLAGS_ARITHMETIC)) { update_flags(); }
+
+	#ifdef GBE_LAZY_FLAGS_VERIFY
+
+	if(flag_op != LAZY_FLAGS_NONE) { verify_lazy_flags(); }
+
+	//V and possibly C carry over from whatever came before
+	verify_flags = (get_cpsr() & (CPSR_C_FLAG | CPSR_V_FLAG)) | (result & CPSR_N_FLAG);
+	if(result == 0) { verify_flags |= CPSR_Z_FLAG; }
+	if(shift_out == 1) { verify_flags |= CPSR_C_FLAG; }
+	else if(shift_out == 0) { verify_flags &= ~CPSR_C_FLAG; }
+
+	#endif
+
+	flag_op = LAZY_FLAGS_LOGICAL;
+	flag_result = result;
+	flag_shift_out = shift_out;
+}
+
+/****** Records an arithmetic operation for the condition codes - Replaces any operation still waiting ******/
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::update_condition_arithmetic(u32 input, u64 operand, u32 result, bool addition)
+{
+	if(operand == 0x100000001)
+	{
+		addition = true;
+		operand = 1;
+	}
+
+	#ifdef GBE_LAZY_FLAGS_VERIFY
+
+	if(flag_op != LAZY_FLAGS_NONE) { verify_lazy_flags(); }
+
+	u32 operand_lo = (operand & 0xFFFFFFFF);
+	verify_flags = (result & CPSR_N_FLAG);
+	if(result == 0) { verify_flags |= CPSR_Z_FLAG; }
+
+	if(addition)
+	{
+		if((input + operand) >> 32) { verify_flags |= CPSR_C_FLAG; }
+		if((~(input ^ operand_lo) & (input ^ result)) & 0x80000000) { verify_flags |= CPSR_V_FLAG; }
+	}
+
+	else
+	{
+		if(input >= operand) { verify_flags |= CPSR_C_FLAG; }
+		if(((input ^ operand_lo) & (input ^ result)) & 0x80000000) { verify_flags |= CPSR_V_FLAG; }
+	}
+
+	#endif
+
+	flag_op = LAZY_FLAGS_ARITHMETIC;
+	flag_input = input;
+	flag_operand = operand;
+	flag_result = result;
+	flag_addition = addition;
+}
+
+/****** Returns the CPSR with the last flag-setting operation applied ******/
+template<typename cpu_type, typename cpu_traits>
+u32 arm_interpreter<cpu_type, cpu_traits>::get_cpsr() const
+{
+	u32 cpsr = derived().reg.cpsr;
+
+	//Logical operations
+	if(flag_op == LAZY_FLAGS_LOGICAL)
+	{
+		//Negative flag
+		if(flag_result & 0x80000000) { cpsr |= CPSR_N_FLAG; }
+		else { cpsr &= ~CPSR_N_FLAG; }
+
+		//Zero flag
+		if(flag_result == 0) { cpsr |= CPSR_Z_FLAG; }
+		else { cpsr &= ~CPSR_Z_FLAG; }
+
+		//Carry flag
+		if(flag_shift_out == 1) { cpsr |= CPSR_C_FLAG; }
+		else if(flag_shift_out == 0) { cpsr &= ~CPSR_C_FLAG; }
+	}
+
+	//Arithmetic operations
+	else if(flag_op == LAZY_FLAGS_ARITHMETIC)
+	{
+		//Negative flag
+		if(flag_result & 0x80000000) { cpsr |= CPSR_N_FLAG; }
+		else { cpsr &= ~CPSR_N_FLAG; }
+
+		//Zero flag
+		if(flag_result == 0) { cpsr |= CPSR_Z_FLAG; }
+		else { cpsr &= ~CPSR_Z_FLAG; }
+
+		//Carry flag - Addition
+		if(flag_addition)
+		{
+			if(flag_operand > (0xFFFFFFFF - flag_input)) { cpsr |= CPSR_C_FLAG; }
+			else { cpsr &= ~CPSR_C_FLAG; }
+		}
+
+		//Carry flag - Subtraction
+		else if(!flag_addition)
+		{
+			if(flag_operand > flag_input) { cpsr &= ~CPSR_C_FLAG; }
+			else { cpsr |= CPSR_C_FLAG; }
+		}
+
+		//Overflow flag
+		u8 flag_input_msb = (flag_input & 0x80000000) ? 1 : 0;
+		u8 flag_operand_msb = (flag_operand & 0x80000000) ? 1 : 0;
+		u8 flag_result_msb = (flag_result & 0x80000000) ? 1 : 0;
+
+		if(flag_addition)
+		{
+			if(flag_input_msb != flag_operand_msb) { cpsr &= ~CPSR_V_FLAG; }
+
+			else
+			{
+				if((flag_result_msb == flag_input_msb) && (flag_result_msb == flag_operand_msb)) { cpsr &= ~CPSR_V_FLAG; }
+				else { cpsr |= CPSR_V_FLAG; }
+			}
+		}
+
+		else
+		{
+			if(flag_input_msb == flag_operand_msb) { cpsr &= ~CPSR_V_FLAG; }
+
+			else
+			{
+				if(flag_result_msb == flag_operand_msb) { cpsr |= CPSR_V_FLAG; }
+				else { cpsr &= ~CPSR_V_FLAG; }
+			}
+		}
+	}
+
+	return cpsr;
+}
+
+/****** Updates the condition codes in the CPSR register from the last flag-setting operation ******/
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::update_flags()
+{
+	if(flag_op == LAZY_FLAGS_NONE) { return; }
+
+	#ifdef GBE_LAZY_FLAGS_VERIFY
+	verify_lazy_flags();
+	#endif
+
+	derived().reg.cpsr = get_cpsr();
+	flag_op = LAZY_FLAGS_NONE;
+}
+
+#ifdef GBE_LAZY_FLAGS_VERIFY
+
+/****** Compares the lazy condition codes against the ones worked out when the operation was recorded ******/
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::verify_lazy_flags()
+{
+	u32 lazy_flags = (get_cpsr() & (CPSR_N_FLAG | CPSR_Z_FLAG | CPSR_C_FLAG | CPSR_V_FLAG));
+
+	if(lazy_flags != verify_flags)
+	{
+		std::cout<<cpu_traits::log_name<<"::Error - Lazy flags mismatch for " << ((flag_op == LAZY_FLAGS_LOGICAL) ? "logical" : "arithmetic") << " operation";
+		std::cout<<" @ 0x" << std::hex << derived().reg.r15 << " : lazy 0x" << (lazy_flags >> 28) << " eager 0x" << (verify_flags >> 28) << std::dec << "\n";
+	}
+}
+
+#endif
+
+/****** Performs 32-bit logical shift left - Returns Carry Out ******/
+template<typename cpu_type, typename cpu_traits>
+u8 arm_interpreter<cpu_type, cpu_traits>::logical_shift_left(u32& input, u8 offset)
+{
+	u8 carry_out = 0;
+
+	if(offset > 0)
+	{
+		//Test for carry
+		//Perform LSL #(n-1), if Bit 31 is 1, we know it will carry out
+		u32 carry_test = input << (offset - 1);
+		carry_out = (carry_test & 0x80000000) ? 1 : 0;
+
+		if(offset >= 32)
+		{
+			input = 0;
+			carry_out = (offset == 32) ? carry_out : 0;
+		}
+
+		else { input <<= offset; }
+	}
+
+	//LSL #0
+	//No shift performed, carry flag not affected, set it to something not 0 or 1 to check!
+	else { carry_out = 2; }
+
+	return carry_out;
+}
+
+/****** Performs 32-bit logical shift right - Returns Carry Out ******/
+template<typename cpu_type, typename cpu_traits>
+u8 arm_interpreter<cpu_type, cpu_traits>::logical_shift_right(u32& input, u8 offset)
+{
+	u8 carry_out = 0;
+
+	if(offset > 0)
+	{
+		//Test for carry
+		//Perform LSR #(n-1), if Bit 0 is 1, we know it will carry out
+		u32 carry_test = input >> (offset - 1);
+		carry_out = (carry_test & 0x1) ? 1 : 0;
+
+		if(offset >= 32)
+		{
+			input = 0;
+			carry_out = (offset == 32) ? carry_out : 0;
+		}
+
+		else { input >>= offset; }
+	}
+
+	//LSR #0
+	//Same as LSR #32, input becomes zero, carry flag is Bit 31 of input
+	else
+	{
+		carry_out = (input & 0x80000000) ? 1 : 0;
+		input = 0;
+	}
+
+	return carry_out;
+}
+
+/****** Performs 32-bit arithmetic shift right - Returns Carry Out ******/
+template<typename cpu_type, typename cpu_traits>
+u8 arm_interpreter<cpu_type, cpu_traits>::arithmetic_shift_right(u32& input, u8 offset)
+{
+	u8 carry_out = 0;
+
+	if(offset > 0)
+	{
+		u8 high_bit = (input & 0x80000000) ? 1 : 0;
+
+		//Basically LSR, but bits become Bit 31
+		for(int x = 0; x < offset; x++)
+		{
+			carry_out = (input & 0x1) ? 1 : 0;
+			input >>= 1;
+			if(high_bit == 1) { input |= 0x80000000; }
+		}	
+	}
+
+	//ASR #0
+	//Same as ASR #32, input becomes 0xFFFFFFFF or 0x0 depending on Bit 31 of input
+	//Carry flag set to 0 or 1 depending on Bit 31 of input
+	else
+	{
+		if(input & 0x80000000) { input = 0xFFFFFFFF; carry_out = 1; }
+		else { input = 0; carry_out = 0; }
+	}
+
+	return carry_out;
+}
+
+/****** Performs 32-bit rotate right ******/
+template<typename cpu_type, typename cpu_traits>
+u8 arm_interpreter<cpu_type, cpu_traits>::rotate_right(u32& input, u8 offset)
+{
+	auto& reg = derived().reg;
+
+	u8 carry_out = 0;
+
+	if(offset > 0)
+	{
+		//Perform ROR shift on immediate
+		for(int x = 0; x < offset; x++)
+		{
+			carry_out = input & 0x1;
+			input >>= 1;
+
+			if(carry_out) { input |= 0x80000000; }
+		}
+	}
+
+	//ROR #0
+	//Same as RRX #1, which is similar to ROR #1, except Bit 31 now becomes the old carry flag
+	else
+	{
+		update_flags();
+
+		u8 old_carry = (reg.cpsr & CPSR_C_FLAG) ? 1 : 0;
+		carry_out = input & 0x1;
+		input >>= 1;
+
+		if(old_carry) { input |= 0x80000000; }
+	}
+
+	return carry_out;
+}
+
+/****** Performs 32-bit rotate right - For ARM.5 Data Processing when Bit 25 is 1 ******/
+/****** Returns 2 when the immediate is not rotated, since Carry is not affected ******/
+template<typename cpu_type, typename cpu_traits>
+u8 arm_interpreter<cpu_type, cpu_traits>::rotate_right_special(u32& input, u8 offset)
+{
+	u8 carry_out = 2;
+
+	if(offset > 0)
+	{
+		//Perform ROR shift on immediate
+		for(int x = 0; x < (offset * 2); x++)
+		{
+			carry_out = input & 0x1;
+			input >>= 1;
+
+			if(carry_out) { input |= 0x80000000; }
+		}
+	}
+
+	return carry_out;
+}
+
+/****** Checks for a short loop at the given address that only loads, compares, and branches back to the start ******/
+/****** Returns the length of the loop in instructions, or 0 if it cannot be an idle loop ******/
+template<typename cpu_type, typename cpu_traits>
+u8 arm_interpreter<cpu_type, cpu_traits>::scan_idle_loop(u32 loop_start)
+{
+	bool is_thumb = (derived().arm_mode == cpu_type::THUMB);
+	u8 op_size = (is_thumb) ? 2 : 4;
+	bool has_load = false;
+
+	for(u32 x = 0; x < IDLE_LOOP_MAX_OPS; x++)
+	{
+		u32 op_addr = loop_start + (x * op_size);
+		u32 opcode = derived().read_opcode(op_addr);
+		u32 target = 0xFFFFFFFF;
+
+		switch((is_thumb) ? decode_thumb(opcode) : decode_arm(opcode))
+		{
+			//Loads
+			case cpu_type::THUMB_6: has_load = true; break;
+			case cpu_type::THUMB_7: if((opcode & 0x800) == 0) { return 0; } has_load = true; break;
+			case cpu_type::THUMB_8: if(((opcode >> 10) & 0x3) == 0) { return 0; } has_load = true; break;
+			case cpu_type::THUMB_9: if((opcode & 0x800) == 0) { return 0; } has_load = true; break;
+			case cpu_type::THUMB_10: if((opcode & 0x800) == 0) { return 0; } has_load = true; break;
+
+			case cpu_type::ARM_9:
+			case cpu_type::ARM_10:
+				if(((opcode & 0x100000) == 0) || (((opcode >> 12) & 0xF) == 15)) { return 0; }
+				has_load = true;
+				break;
+
+			//Register-only operations
+			case cpu_type::THUMB_1:
+			case cpu_type::THUMB_2:
+			case cpu_type::THUMB_3:
+			case cpu_type::THUMB_4:
+			case cpu_type::THUMB_12:
+				break;
+
+			//Hi register ADD, CMP, and MOV, as long as the PC is not changed
+			case cpu_type::THUMB_5:
+				if(((opcode >> 8) & 0x3) == 0x3) { return 0; }
+				if((((opcode >> 8) & 0x3) != 0x1) && (((opcode & 0x7) | ((opcode >> 4) & 0x8)) == 15)) { return 0; }
+				break;
+
+			case cpu_type::ARM_5:
+				if((((opcode >> 12) & 0xF) == 15) && ((((opcode >> 21) & 0xF) < 0x8) || (((opcode >> 21) & 0xF) > 0xB))) { return 0; }
+				break;
+
+			//Branches
+			case cpu_type::THUMB_16:
+				if(((opcode >> 8) & 0xF) >= 0xE) { return 0; }
+				target = op_addr + 4 + (s8(opcode & 0xFF) << 1);
+				break;
+
+			case cpu_type::THUMB_18:
+				target = op_addr + 4 + (((opcode & 0x400) ? (opcode | 0xFFFFF800) : (opcode & 0x7FF)) << 1);
+				break;
+
+			case cpu_type::ARM_4:
+				if(opcode & 0x1000000) { return 0; }
+				target = op_addr + 8 + (((opcode & 0x800000) ? (opcode | 0xFF000000) : (opcode & 0xFFFFFF)) << 2);
+				break;
+
+			default: return 0;
+		}
+
+		//Loop has to branch back to its start
+		if(target != 0xFFFFFFFF)
+		{
+			if((target == loop_start) && (has_load)) { return (x + 1); }
+			return 0;
+		}
+	}
+
+	return 0;
+}
+
+/****** Verifies that every load in an idle loop only reads from literal pools or event-driven I/O registers ******/
+/****** Fills poll_values with whatever each I/O load would currently read ******/
+template<typename cpu_type, typename cpu_traits>
+bool arm_interpreter<cpu_type, cpu_traits>::poll_idle_loop(u32 loop_start, u8 loop_length, u32* poll_values)
+{
+	auto& mem = derived().mem;
+	bool is_thumb = (derived().arm_mode == cpu_type::THUMB);
+	u8 op_size = (is_thumb) ? 2 : 4;
+	u8 poll_count = 0;
+
+	//Track register values through one pass of the loop
+	//Any register written by the loop is unknown afterwards, unless it is a literal pool load
+	u32 value[16];
+	bool known[16];
+
+	for(u32 x = 0; x < 15; x++)
+	{
+		value[x] = derived().get_reg(x);
+		known[x] = true;
+	}
+
+	known[15] = false;
+
+	for(u32 x = 0; x < (loop_length - 1U); x++)
+	{
+		u32 op_addr = loop_start + (x * op_size);
+		u32 opcode = derived().read_opcode(op_addr);
+		u32 pc = op_addr + (op_size << 1);
+		auto op_type = (is_thumb) ? decode_thumb(opcode) : decode_arm(opcode);
+
+		bool is_load = false;
+		u8 base_reg = 0;
+		u32 offset = 0;
+		u8 load_size = 4;
+		u8 dest_reg = 0;
+		bool write_back = false;
+
+		switch(op_type)
+		{
+			case cpu_type::THUMB_1:
+			case cpu_type::THUMB_2:
+			case cpu_type::THUMB_4:
+				dest_reg = opcode & 0x7;
+				break;
+
+			case cpu_type::THUMB_3:
+			case cpu_type::THUMB_12:
+				dest_reg = (opcode >> 8) & 0x7;
+				break;
+
+			case cpu_type::THUMB_5:
+				dest_reg = (opcode & 0x7) | ((opcode >> 4) & 0x8);
+				break;
+
+			case cpu_type::THUMB_6:
+				is_load = true;
+				base_reg = 15;
+				pc &= ~0x2;
+				offset = (opcode & 0xFF) << 2;
+				dest_reg = (opcode >> 8) & 0x7;
+				break;
+
+			case cpu_type::THUMB_7:
+			case cpu_type::THUMB_8:
+				if(!known[(opcode >> 6) & 0x7]) { return false; }
+
+				is_load = true;
+				base_reg = (opcode >> 3) & 0x7;
+				offset = value[(opcode >> 6) & 0x7];
+				dest_reg = opcode & 0x7;
+
+				if(op_type == cpu_type::THUMB_7) { load_size = (opcode & 0x400) ? 1 : 4; }
+				else { load_size = (((opcode >> 10) & 0x3) == 0x1) ? 1 : 2; }
+
+				break;
+
+			case cpu_type::THUMB_9:
+				is_load = true;
+				base_reg = (opcode >> 3) & 0x7;
+				load_size = (opcode & 0x1000) ? 1 : 4;
+				offset = ((opcode >> 6) & 0x1F) * load_size;
+				dest_reg = opcode & 0x7;
+				break;
+
+			case cpu_type::THUMB_10:
+				is_load = true;
+				base_reg = (opcode >> 3) & 0x7;
+				load_size = 2;
+				offset = ((opcode >> 6) & 0x1F) << 1;
+				dest_reg = opcode & 0x7;
+				break;
+
+			case cpu_type::ARM_5:
+				dest_reg = (opcode >> 12) & 0xF;
+				break;
+
+			//Only immediate offsets are tracked for ARM loads
+			case cpu_type::ARM_9:
+				if(opcode & 0x2000000) { return false; }
+
+				is_load = true;
+				load_size = (opcode & 0x400000) ? 1 : 4;
+				offset = opcode & 0xFFF;
+				break;
+
+			case cpu_type::ARM_10:
+				if((opcode & 0x400000) == 0) { return false; }
+
+				is_load = true;
+				load_size = (((opcode >> 5) & 0x3) == 0x2) ? 1 : 2;
+				offset = ((opcode >> 4) & 0xF0) | (opcode & 0xF);
+				break;
+
+			default: return false;
+		}
+
+		//Shared ARM addressing modes
+		if((is_load) && (!is_thumb))
+		{
+			base_reg = (opcode >> 16) & 0xF;
+			dest_reg = (opcode >> 12) & 0xF;
+
+			if((opcode & 0x800000) == 0) { offset = -offset; }
+
+			//Post-indexing always writes back and loads from the unmodified base
+			if((opcode & 0x1000000) == 0)
+			{
+				offset = 0;
+				write_back = true;
+			}
+
+			else if(opcode & 0x200000) { write_back = true; }
+		}
+
+		if(is_load)
+		{
+			if((base_reg != 15) && (!known[base_reg])) { return false; }
+
+			u32 load_addr = ((base_reg == 15) ? pc : value[base_reg]) + offset;
+
+			//Literal pools have to sit next to the loop's code
+			if(base_reg == 15)
+			{
+				if(((load_addr >> 24) != (loop_start >> 24)) || (load_addr & (load_size - 1))) { return false; }
+
+				value[dest_reg] = (load_size == 4) ? mem->read_u32(load_addr) : mem->read_u8(load_addr);
+				known[dest_reg] = true;
+				continue;
+			}
+
+			poll_values[poll_count] = 0;
+
+			for(u32 y = 0; y < load_size; y++)
+			{
+				if(!mem->is_idle_poll_address(load_addr + y)) { return false; }
+				poll_values[poll_count] |= (mem->read_u8(load_addr + y) << (y << 3));
+			}
+
+			poll_count++;
+
+			if(write_back) { known[base_reg] = false; }
+		}
+
+		known[dest_reg] = false;
+	}
+
+	return (poll_count != 0);
+}
+
+/****** Records one pass through a polling loop ******/
+/****** Returns true if the pass left every register and polled value as it was on the last pass ******/
+template<typename cpu_type, typename cpu_traits>
+bool arm_interpreter<cpu_type, cpu_traits>::update_idle_loop(u32 loop_addr, u8 loop_length)
+{
+	const auto& reg = derived().reg;
+	bool unchanged = (idle_loop_addr == loop_addr);
+
+	//Compare the materialized condition codes, not whatever operation happens to be waiting
+	update_flags();
+
+	idle_loop_addr = loop_addr;
+	idle_loop_length = loop_length;
+
+	for(u32 x = 0; x < 15; x++)
+	{
+		u32 value = derived().get_reg(x);
+
+		if(idle_regs[x] != value)
+		{
+			idle_regs[x] = value;
+			unchanged = false;
+		}
+	}
+
+	if(idle_regs[15] != reg.cpsr)
+	{
+		idle_regs[15] = reg.cpsr;
+		unchanged = false;
+	}
+
+	//Values are compared with what the last pass saw, since they may have changed while that pass ran
+	u32 poll_values[IDLE_LOOP_MAX_OPS] = {};
+
+	if(!poll_idle_loop((loop_addr & ~0x1), loop_length, poll_values))
+	{
+		idle_loop_length = 0;
+		return false;
+	}
+
+	if(!std::equal(poll_values, poll_values + IDLE_LOOP_MAX_OPS, idle_poll_values))
+	{
+		std::copy(poll_values, poll_values + IDLE_LOOP_MAX_OPS, idle_poll_values);
+		unchanged = false;
+	}
+
+	return unchanged;
+}
+
+/****** Checks whether anything read by the current polling loop has changed since its last pass ******/
+template<typename cpu_type, typename cpu_traits>
+bool arm_interpreter<cpu_type, cpu_traits>::idle_loop_changed()
+{
+	u32 poll_values[IDLE_LOOP_MAX_OPS] = {};
+
+	poll_idle_loop((idle_loop_addr & ~0x1), idle_loop_length, poll_values);
+	return !std::equal(poll_values, poll_values + IDLE_LOOP_MAX_OPS, idle_poll_values);
+}
+
+/****** Watches taken branches for polling loops - Parks the CPU once a loop keeps reading the same values ******/
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::idle_loop_branch(u32 branch_addr)
+{
+	const auto& reg = derived().reg;
+	bool is_thumb = (derived().arm_mode == cpu_type::THUMB);
+	u32 loop_start = reg.r15;
+	u32 loop_addr = loop_start | ((is_thumb) ? 1 : 0);
+	u32 loop_length = ((branch_addr - loop_start) / ((is_thumb) ? 2 : 4)) + 1;
+
+	//Only short backwards branches can close a polling loop
+	if((loop_start > branch_addr) || (loop_length > IDLE_LOOP_MAX_OPS)) { return; }
+
+	//Passes only count if nothing else flushed the pipeline in between (other branches, interrupts, etc)
+	bool consecutive = (derived().idle_flush_count == (derived().idle_loop_flush_count + 1));
+	derived().idle_loop_flush_count = derived().idle_flush_count;
+
+	//Look at new loops once, then only track the ones that qualify
+	if(loop_addr != idle_loop_addr)
+	{
+		idle_loop_addr = loop_addr;
+		idle_loop_length = (scan_idle_loop(loop_start) == loop_length) ? loop_length : 0;
+		consecutive = false;
+	}
+
+	if(!idle_loop_length) { return; }
+
+	if((update_idle_loop(loop_addr, idle_loop_length)) && (consecutive)) { derived().idle_state = 4; }
+}
+
+#include "arm_instr.h"
+#include "thumb_instr.h"
+
+#endif // GBE_ARM_INTERPRETER
@@ -75,9 +75,22 @@ namespace config
 	int touch_zone_y[10] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
 	int touch_zone_pad[10] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
 
+	//Default GBA idle loop skipping and list of game codes where it is disabled
+	bool agb_idle_loop_skip = true;
+	std::string agb_idle_loop_overrides = "";
+
 	//Default NDS touch mode (light pressure)
 	u8 touch_mode = 0;
 
+	//Default NDS CPU sync quantum (cycles each CPU may run ahead, 0 = lockstep)
+	u32 nds_sync_quantum = 64;
+
+	//Default NDS idle loop skipping
+	bool nds_idle_loop_skip = true;
+
+	//Default NDS 2D engine rendering on separate threads
+	bool nds_threaded_2d = true;
+
 	//Hotkey bindings
 	//Turbo = TAB
 	u32 hotkey_turbo = SDLK_TAB;
@@ -2354,6 +2367,41 @@ bool parse_ini_file()
 			}
 		}
 
+		//GBA idle loop skipping
+		else if(ini_item == "#agb_idle_loop_skip")
+		{
+			if((x + 1) < size)
+			{
+				util::from_str(ini_opts[++x], output);
+
+				if(output == 1) { config::agb_idle_loop_skip = true; }
+				else { config::agb_idle_loop_skip = false; }
+			}
+
+			else
+			{
+				std::cout<<"GBE::Error - Could not parse gbe.ini (#agb_idle_loop_skip) \n";
+				return false;
+			}
+		}
+
+		//GBA idle loop skipping overrides
+		else if(ini_item == "#agb_idle_loop_overrides")
+		{
+			if((x + 1) < size)
+			{
+				ini_item = ini_opts[++x];
+				std::string first_char = "";
+				first_char = ini_item[0];
+
+				//When left blank, don't parse the next line item
+				if(first_char != "#") { config::agb_idle_loop_overrides = ini_item; }
+				else { config::agb_idle_loop_overrides = ""; x--; }
+			}
+
+			else { config::agb_idle_loop_overrides = ""; }
+		}
+
 		//NDS touch mode
 		else if(ini_item == "#nds_touch_mode")
 		{
@@ -2371,6 +2419,59 @@ bool parse_ini_file()
 			}
 		}
 
+		//NDS CPU sync quantum
+		else if(ini_item == "#nds_sync_quantum")
+		{
+			if((x + 1) < size)
+			{
+				util::from_str(ini_opts[++x], output);
+
+				if((output >= 0) && (output <= 256)) { config::nds_sync_quantum = output; }
+			}
+
+			else
+			{
+				std::cout<<"GBE::Error - Could not parse gbe.ini (#nds_sync_quantum) \n";
+				return false;
+			}
+		}
+
+		//NDS idle loop skipping
+		else if(ini_item == "#nds_idle_loop_skip")
+		{
+			if((x + 1) < size)
+			{
+				util::from_str(ini_opts[++x], output);
+
+				if(output == 1) { config::nds_idle_loop_skip = true; }
+				else { config::nds_idle_loop_skip = false; }
+			}
+
+			else
+			{
+				std::cout<<"GBE::Error - Could not parse gbe.ini (#nds_idle_loop_skip) \n";
+				return false;
+			}
+		}
+
+		//NDS threaded 2D rendering
+		else if(ini_item == "#nds_threaded_2d")
+		{
+			if((x + 1) < size)
+			{
+				util::from_str(ini_opts[++x], output);
+
+				if(output == 1) { config::nds_threaded_2d = true; }
+				else { config::nds_threaded_2d = false; }
+			}
+
+			else
+			{
+				std::cout<<"GBE::Error - Could not parse gbe.ini (#nds_threaded_2d) \n";
+				return false;
+			}
+		}
+
 		//NDS virtual cursor enable
 		else if(ini_item == "#virtual_cursor_enable")
 		{
@@ -3563,6 +3664,24 @@ bool save_ini_file()
 			output_lines[line_pos] = "[#ir_db_index:" + val + "]";
 		}
 
+		//GBA idle loop skipping
+		else if(ini_item == "#agb_idle_loop_skip")
+		{
+			line_pos = output_count[x];
+			std::string val = (config::agb_idle_loop_skip) ? "1" : "0";
+
+			output_lines[line_pos] = "[#agb_idle_loop_skip:" + val + "]";
+		}
+
+		//GBA idle loop skipping overrides
+		else if(ini_item == "#agb_idle_loop_overrides")
+		{
+			line_pos = output_count[x];
+			std::string val = (config::agb_idle_loop_overrides == "") ? "" : (":'" + config::agb_idle_loop_overrides + "'");
+
+			output_lines[line_pos] = "[#agb_idle_loop_overrides" + val + "]";
+		}
+
 		//NDS touch mode
 		else if(ini_item == "#nds_touch_mode")
 		{
@@ -3572,6 +3691,33 @@ bool save_ini_file()
 			output_lines[line_pos] = "[#nds_touch_mode:" + val + "]";
 		}
 
+		//NDS CPU sync quantum
+		else if(ini_item == "#nds_sync_quantum")
+		{
+			line_pos = output_count[x];
+			std::string val = util::to_str(config::nds_sync_quantum);
+
+			output_lines[line_pos] = "[#nds_sync_quantum:" + val + "]";
+		}
+
+		//NDS idle loop skipping
+		else if(ini_item == "#nds_idle_loop_skip")
+		{
+			line_pos = output_count[x];
+			std::string val = (config::nds_idle_loop_skip) ? "1" : "0";
+
+			output_lines[line_pos] = "[#nds_idle_loop_skip:" + val + "]";
+		}
+
+		//NDS threaded 2D rendering
+		else if(ini_item == "#nds_threaded_2d")
+		{
+			line_pos = output_count[x];
+			std::string val = (config::nds_threaded_2d) ? "1" : "0";
+
+			output_lines[line_pos] = "[#nds_threaded_2d:" + val + "]";
+		}
+
 		//NDS virtual cursor enable
 		else if(ini_item == "#virtual_cursor_enable")
 		{
@@ -3939,7 +4085,12 @@ bool generate_ini_file()
 	ini_contents += "[#gbma_server_ip]\n\n";
 	ini_contents += "[#netplay_id]\n\n";
 	ini_contents += "[#ir_db_index]\n\n";
+	ini_contents += "[#agb_idle_loop_skip]\n\n";
+	ini_contents += "[#agb_idle_loop_overrides]\n\n";
 	ini_contents += "[#nds_touch_mode]\n\n";
+	ini_contents += "[#nds_sync_quantum]\n\n";
+	ini_contents += "[#nds_idle_loop_skip]\n\n";
+	ini_contents += "[#nds_threaded_2d]\n\n";
 	ini_contents += "[#virtual_cursor_enable]\n\n";
 	ini_contents += "[#virtual_cursor_file]\n\n";
 	ini_contents += "[#virtual_cursor_opacity]\n\n";
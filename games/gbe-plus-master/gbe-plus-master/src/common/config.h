@@ -112,7 +112,12 @@ namespace config
 	extern int touch_zone_x[10];
 	extern int touch_zone_y[10];
 	extern int touch_zone_pad[10];
+	extern bool agb_idle_loop_skip;
+	extern std::string agb_idle_loop_overrides;
 	extern u8 touch_mode;
+	extern u32 nds_sync_quantum;
+	extern bool nds_idle_loop_skip;
+	extern bool nds_threaded_2d;
 
 	extern u32 hotkey_turbo;
 	extern u32 hotkey_mute;
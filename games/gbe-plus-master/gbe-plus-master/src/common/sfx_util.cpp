@@ -0,0 +1,371 @@
+// GB Enhanced+ Copyright Daniel Baxter 2014
+// Licensed under the GPLv2
+// See LICENSE.txt for full license text
+
+// File : sfx_util.cpp
+// Date : October 17, 2026
+// Description : Color special effects for whole scanlines
+//
+// Alpha blending, brightness up/down and master brightness for the GBA and NDS LCDs
+// Each effect works on a full line at once, using SSE2 or AVX2 when the host supports it
+
+#include "sfx_util.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define GBE_SFX_X86
+#include <immintrin.h>
+#endif
+
+namespace sfx_util
+{
+
+typedef void (*apply_line_func)(const u8*, const u16*, const u16*, u32*, u32, u8, u8, u8);
+typedef void (*master_brightness_func)(u32*, u32, bool, u8);
+
+/****** Applies SFX to one RGB15 color channel ******/
+static inline u32 sfx_channel(u8 op, u32 value_1, u32 value_2, u8 eva, u8 evb, u8 evy)
+{
+	u32 result = 0;
+
+	switch(op)
+	{
+		case SFX_BLEND:
+			result = ((value_1 * eva) + (value_2 * evb)) >> 4;
+			break;
+
+		case SFX_BRIGHTEN:
+			result = value_1 + (((0x1F - value_1) * evy) >> 4);
+			break;
+
+		//EVY is capped at 16 (full black) when darkening
+		case SFX_DARKEN:
+			result = (value_1 * (16 - ((evy > 16) ? 16 : evy))) >> 4;
+			break;
+	}
+
+	return (result > 0x1F) ? 0x1F : result;
+}
+
+/****** Applies SFX to a line of pixels - Plain C++ version ******/
+void apply_line_scalar(const u8* ops, const u16* color_1, const u16* color_2, u32* out, u32 count, u8 eva, u8 evb, u8 evy)
+{
+	for(u32 x = 0; x < count; x++)
+	{
+		u8 op = ops[x];
+		if(op == SFX_NONE) { continue; }
+
+		u16 c1 = color_1[x];
+		u16 c2 = color_2[x];
+
+		u32 red = sfx_channel(op, (c1 & 0x1F), (c2 & 0x1F), eva, evb, evy);
+		u32 green = sfx_channel(op, ((c1 >> 5) & 0x1F), ((c2 >> 5) & 0x1F), eva, evb, evy);
+		u32 blue = sfx_channel(op, ((c1 >> 10) & 0x1F), ((c2 >> 10) & 0x1F), eva, evb, evy);
+
+		out[x] = 0xFF000000 | (red << 19) | (green << 11) | (blue << 3);
+	}
+}
+
+/****** Adjusts master brightness for a line of pixels - Plain C++ version ******/
+void master_brightness_line_scalar(u32* line, u32 count, bool increase, u8 factor)
+{
+	u32 darken = 16 - ((factor > 16) ? 16 : factor);
+
+	for(u32 x = 0; x < count; x++)
+	{
+		u32 color = line[x];
+		u32 rgb[3] = { ((color >> 18) & 0x3F), ((color >> 10) & 0x3F), ((color >> 2) & 0x3F) };
+
+		for(u32 y = 0; y < 3; y++)
+		{
+			if(increase) { rgb[y] += (((63 - rgb[y]) * factor) >> 4); }
+			else { rgb[y] = (rgb[y] * darken) >> 4; }
+
+			if(rgb[y] > 63) { rgb[y] = 63; }
+		}
+
+		line[x] = 0xFF000000 | (rgb[0] << 18) | (rgb[1] << 10) | (rgb[2] << 2);
+	}
+}
+
+#ifdef GBE_SFX_X86
+
+/****** Applies SFX to one RGB15 color channel for 8 pixels - SSE2 ******/
+static inline __m128i sfx_channel_sse2(__m128i value_1, __m128i value_2, __m128i blend_mask, __m128i up_mask, __m128i down_mask, __m128i eva, __m128i evb, __m128i evy, __m128i darken)
+{
+	const __m128i max = _mm_set1_epi16(0x1F);
+
+	__m128i blend = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(value_1, eva), _mm_mullo_epi16(value_2, evb)), 4);
+	__m128i up = _mm_add_epi16(value_1, _mm_srli_epi16(_mm_mullo_epi16(_mm_sub_epi16(max, value_1), evy), 4));
+	__m128i down = _mm_srli_epi16(_mm_mullo_epi16(value_1, darken), 4);
+
+	__m128i result = _mm_and_si128(blend_mask, blend);
+	result = _mm_or_si128(result, _mm_and_si128(up_mask, up));
+	result = _mm_or_si128(result, _mm_and_si128(down_mask, down));
+
+	return _mm_min_epi16(result, max);
+}
+
+/****** Applies SFX to a line of pixels - SSE2 ******/
+static void apply_line_sse2(const u8* ops, const u16* color_1, const u16* color_2, u32* out, u32 count, u8 eva, u8 evb, u8 evy)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i channel_mask = _mm_set1_epi16(0x1F);
+	const __m128i alpha = _mm_set1_epi16(0xFF00);
+	const __m128i eva_v = _mm_set1_epi16(eva);
+	const __m128i evb_v = _mm_set1_epi16(evb);
+	const __m128i evy_v = _mm_set1_epi16(evy);
+	const __m128i darken_v = _mm_set1_epi16(16 - ((evy > 16) ? 16 : evy));
+
+	u32 x = 0;
+
+	for(; (x + 8) <= count; x += 8)
+	{
+		__m128i op = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(ops + x)), zero);
+		__m128i keep = _mm_cmpeq_epi16(op, zero);
+
+		//Skip runs of pixels without any SFX
+		if(_mm_movemask_epi8(keep) == 0xFFFF) { continue; }
+
+		__m128i blend_mask = _mm_cmpeq_epi16(op, _mm_set1_epi16(SFX_BLEND));
+		__m128i up_mask = _mm_cmpeq_epi16(op, _mm_set1_epi16(SFX_BRIGHTEN));
+		__m128i down_mask = _mm_cmpeq_epi16(op, _mm_set1_epi16(SFX_DARKEN));
+
+		__m128i c1 = _mm_loadu_si128((const __m128i*)(color_1 + x));
+		__m128i c2 = _mm_loadu_si128((const __m128i*)(color_2 + x));
+
+		__m128i red = sfx_channel_sse2(_mm_and_si128(c1, channel_mask), _mm_and_si128(c2, channel_mask),
+			blend_mask, up_mask, down_mask, eva_v, evb_v, evy_v, darken_v);
+
+		__m128i green = sfx_channel_sse2(_mm_and_si128(_mm_srli_epi16(c1, 5), channel_mask), _mm_and_si128(_mm_srli_epi16(c2, 5), channel_mask),
+			blend_mask, up_mask, down_mask, eva_v, evb_v, evy_v, darken_v);
+
+		__m128i blue = sfx_channel_sse2(_mm_and_si128(_mm_srli_epi16(c1, 10), channel_mask), _mm_and_si128(_mm_srli_epi16(c2, 10), channel_mask),
+			blend_mask, up_mask, down_mask, eva_v, evb_v, evy_v, darken_v);
+
+		//Build 32-bit ARGB from 16-bit halves - Low = Green + Blue, High = Alpha + Red
+		__m128i low = _mm_or_si128(_mm_slli_epi16(green, 11), _mm_slli_epi16(blue, 3));
+		__m128i high = _mm_or_si128(alpha, _mm_slli_epi16(red, 3));
+
+		__m128i* dest = (__m128i*)(out + x);
+		__m128i keep_0 = _mm_unpacklo_epi16(keep, keep);
+		__m128i keep_1 = _mm_unpackhi_epi16(keep, keep);
+
+		__m128i result_0 = _mm_unpacklo_epi16(low, high);
+		__m128i result_1 = _mm_unpackhi_epi16(low, high);
+
+		_mm_storeu_si128(dest, _mm_or_si128(_mm_and_si128(keep_0, _mm_loadu_si128(dest)), _mm_andnot_si128(keep_0, result_0)));
+		_mm_storeu_si128(dest + 1, _mm_or_si128(_mm_and_si128(keep_1, _mm_loadu_si128(dest + 1)), _mm_andnot_si128(keep_1, result_1)));
+	}
+
+	if(x < count) { apply_line_scalar(ops + x, color_1 + x, color_2 + x, out + x, count - x, eva, evb, evy); }
+}
+
+/****** Adjusts master brightness for a line of pixels - SSE2 ******/
+static void master_brightness_line_sse2(u32* line, u32 count, bool increase, u8 factor)
+{
+	const __m128i channel_mask = _mm_set1_epi32(0x3F);
+	const __m128i alpha = _mm_set1_epi32(0xFF000000);
+	const __m128i factor_v = _mm_set1_epi32(increase ? factor : (16 - ((factor > 16) ? 16 : factor)));
+
+	u32 x = 0;
+
+	for(; (x + 4) <= count; x += 4)
+	{
+		__m128i color = _mm_loadu_si128((const __m128i*)(line + x));
+		__m128i result = alpha;
+
+		for(u32 shift = 2; shift <= 18; shift += 8)
+		{
+			//Channels only use the low 16 bits of each lane, so 16-bit math is safe here
+			__m128i value = _mm_and_si128(_mm_srl_epi32(color, _mm_cvtsi32_si128(shift)), channel_mask);
+
+			if(increase) { value = _mm_min_epi16(_mm_add_epi32(value, _mm_srli_epi32(_mm_mullo_epi16(_mm_sub_epi32(channel_mask, value), factor_v), 4)), channel_mask); }
+			else { value = _mm_srli_epi32(_mm_mullo_epi16(value, factor_v), 4); }
+
+			result = _mm_or_si128(result, _mm_sll_epi32(value, _mm_cvtsi32_si128(shift)));
+		}
+
+		_mm_storeu_si128((__m128i*)(line + x), result);
+	}
+
+	if(x < count) { master_brightness_line_scalar(line + x, count - x, increase, factor); }
+}
+
+/****** Applies SFX to one RGB15 color channel for 16 pixels - AVX2 ******/
+__attribute__((target("avx2")))
+static inline __m256i sfx_channel_avx2(__m256i value_1, __m256i value_2, __m256i blend_mask, __m256i up_mask, __m256i down_mask, __m256i eva, __m256i evb, __m256i evy, __m256i darken)
+{
+	const __m256i max = _mm256_set1_epi16(0x1F);
+
+	__m256i blend = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(value_1, eva), _mm256_mullo_epi16(value_2, evb)), 4);
+	__m256i up = _mm256_add_epi16(value_1, _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(max, value_1), evy), 4));
+	__m256i down = _mm256_srli_epi16(_mm256_mullo_epi16(value_1, darken), 4);
+
+	__m256i result = _mm256_and_si256(blend_mask, blend);
+	result = _mm256_or_si256(result, _mm256_and_si256(up_mask, up));
+	result = _mm256_or_si256(result, _mm256_and_si256(down_mask, down));
+
+	return _mm256_min_epi16(result, max);
+}
+
+/****** Applies SFX to a line of pixels - AVX2 ******/
+__attribute__((target("avx2")))
+static void apply_line_avx2(const u8* ops, const u16* color_1, const u16* color_2, u32* out, u32 count, u8 eva, u8 evb, u8 evy)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i channel_mask = _mm256_set1_epi16(0x1F);
+	const __m256i alpha = _mm256_set1_epi16(0xFF00);
+	const __m256i eva_v = _mm256_set1_epi16(eva);
+	const __m256i evb_v = _mm256_set1_epi16(evb);
+	const __m256i evy_v = _mm256_set1_epi16(evy);
+	const __m256i darken_v = _mm256_set1_epi16(16 - ((evy > 16) ? 16 : evy));
+
+	u32 x = 0;
+
+	for(; (x + 16) <= count; x += 16)
+	{
+		__m256i op = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(ops + x)));
+		__m256i keep = _mm256_cmpeq_epi16(op, zero);
+
+		//Skip runs of pixels without any SFX
+		if(_mm256_movemask_epi8(keep) == -1) { continue; }
+
+		__m256i blend_mask = _mm256_cmpeq_epi16(op, _mm256_set1_epi16(SFX_BLEND));
+		__m256i up_mask = _mm256_cmpeq_epi16(op, _mm256_set1_epi16(SFX_BRIGHTEN));
+		__m256i down_mask = _mm256_cmpeq_epi16(op, _mm256_set1_epi16(SFX_DARKEN));
+
+		__m256i c1 = _mm256_loadu_si256((const __m256i*)(color_1 + x));
+		__m256i c2 = _mm256_loadu_si256((const __m256i*)(color_2 + x));
+
+		__m256i red = sfx_channel_avx2(_mm256_and_si256(c1, channel_mask), _mm256_and_si256(c2, channel_mask),
+			blend_mask, up_mask, down_mask, eva_v, evb_v, evy_v, darken_v);
+
+		__m256i green = sfx_channel_avx2(_mm256_and_si256(_mm256_srli_epi16(c1, 5), channel_mask), _mm256_and_si256(_mm256_srli_epi16(c2, 5), channel_mask),
+			blend_mask, up_mask, down_mask, eva_v, evb_v, evy_v, darken_v);
+
+		__m256i blue = sfx_channel_avx2(_mm256_and_si256(_mm256_srli_epi16(c1, 10), channel_mask), _mm256_and_si256(_mm256_srli_epi16(c2, 10), channel_mask),
+			blend_mask, up_mask, down_mask, eva_v, evb_v, evy_v, darken_v);
+
+		//Build 32-bit ARGB from 16-bit halves - Low = Green + Blue, High = Alpha + Red
+		__m256i low = _mm256_or_si256(_mm256_slli_epi16(green, 11), _mm256_slli_epi16(blue, 3));
+		__m256i high = _mm256_or_si256(alpha, _mm256_slli_epi16(red, 3));
+
+		//Unpacking works within each 128-bit lane, so put pixels 0-7 and 8-15 back in order afterwards
+		__m256i result_lo = _mm256_unpacklo_epi16(low, high);
+		__m256i result_hi = _mm256_unpackhi_epi16(low, high);
+		__m256i keep_lo = _mm256_unpacklo_epi16(keep, keep);
+		__m256i keep_hi = _mm256_unpackhi_epi16(keep, keep);
+
+		__m256i result_0 = _mm256_permute2x128_si256(result_lo, result_hi, 0x20);
+		__m256i result_1 = _mm256_permute2x128_si256(result_lo, result_hi, 0x31);
+		__m256i keep_0 = _mm256_permute2x128_si256(keep_lo, keep_hi, 0x20);
+		__m256i keep_1 = _mm256_permute2x128_si256(keep_lo, keep_hi, 0x31);
+
+		__m256i* dest = (__m256i*)(out + x);
+
+		_mm256_storeu_si256(dest, _mm256_blendv_epi8(result_0, _mm256_loadu_si256(dest), keep_0));
+		_mm256_storeu_si256(dest + 1, _mm256_blendv_epi8(result_1, _mm256_loadu_si256(dest + 1), keep_1));
+	}
+
+	if(x < count) { apply_line_sse2(ops + x, color_1 + x, color_2 + x, out + x, count - x, eva, evb, evy); }
+}
+
+/****** Adjusts master brightness for a line of pixels - AVX2 ******/
+__attribute__((target("avx2")))
+static void master_brightness_line_avx2(u32* line, u32 count, bool increase, u8 factor)
+{
+	const __m256i channel_mask = _mm256_set1_epi32(0x3F);
+	const __m256i alpha = _mm256_set1_epi32(0xFF000000);
+	const __m256i factor_v = _mm256_set1_epi32(increase ? factor : (16 - ((factor > 16) ? 16 : factor)));
+
+	u32 x = 0;
+
+	for(; (x + 8) <= count; x += 8)
+	{
+		__m256i color = _mm256_loadu_si256((const __m256i*)(line + x));
+		__m256i result = alpha;
+
+		for(u32 shift = 2; shift <= 18; shift += 8)
+		{
+			__m256i value = _mm256_and_si256(_mm256_srl_epi32(color, _mm_cvtsi32_si128(shift)), channel_mask);
+
+			if(increase) { value = _mm256_min_epi32(_mm256_add_epi32(value, _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(channel_mask, value), factor_v), 4)), channel_mask); }
+			else { value = _mm256_srli_epi32(_mm256_mullo_epi32(value, factor_v), 4); }
+
+			result = _mm256_or_si256(result, _mm256_sll_epi32(value, _mm_cvtsi32_si128(shift)));
+		}
+
+		_mm256_storeu_si256((__m256i*)(line + x), result);
+	}
+
+	if(x < count) { master_brightness_line_sse2(line + x, count - x, increase, factor); }
+}
+
+#endif
+
+struct sfx_kernels
+{
+	apply_line_func apply_line;
+	master_brightness_func master_brightness_line;
+	const char* name;
+};
+
+/****** Looks up a set of kernels - Returns false if this host can't run them ******/
+static bool get_kernels(kernel_type type, sfx_kernels &kernels)
+{
+	switch(type)
+	{
+		case SFX_KERNEL_SCALAR:
+			kernels = { apply_line_scalar, master_brightness_line_scalar, "Scalar" };
+			return true;
+
+		#ifdef GBE_SFX_X86
+
+		case SFX_KERNEL_SSE2:
+			kernels = { apply_line_sse2, master_brightness_line_sse2, "SSE2" };
+			return true;
+
+		case SFX_KERNEL_AVX2:
+			__builtin_cpu_init();
+			if(!__builtin_cpu_supports("avx2")) { return false; }
+
+			kernels = { apply_line_avx2, master_brightness_line_avx2, "AVX2" };
+			return true;
+
+		#endif
+
+		default: return false;
+	}
+}
+
+/****** Picks the fastest kernels this host can run ******/
+static sfx_kernels select_kernels()
+{
+	sfx_kernels kernels;
+
+	if(!get_kernels(SFX_KERNEL_AVX2, kernels) && !get_kernels(SFX_KERNEL_SSE2, kernels)) { get_kernels(SFX_KERNEL_SCALAR, kernels); }
+
+	return kernels;
+}
+
+static sfx_kernels current_kernels = select_kernels();
+
+/****** Applies SFX to a line of pixels ******/
+void apply_line(const u8* ops, const u16* color_1, const u16* color_2, u32* out, u32 count, u8 eva, u8 evb, u8 evy)
+{
+	current_kernels.apply_line(ops, color_1, color_2, out, count, eva, evb, evy);
+}
+
+/****** Adjusts master brightness for a line of pixels ******/
+void master_brightness_line(u32* line, u32 count, bool increase, u8 factor)
+{
+	current_kernels.master_brightness_line(line, count, increase, factor);
+}
+
+/****** Switches to a specific set of kernels ******/
+bool force_kernel(kernel_type type) { return get_kernels(type, current_kernels); }
+
+/****** Returns the name of the kernels currently in use ******/
+const char* kernel_name() { return current_kernels.name; }
+
+} //Namespace
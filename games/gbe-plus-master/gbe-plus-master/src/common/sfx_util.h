@@ -0,0 +1,54 @@
+// GB Enhanced+ Copyright Daniel Baxter 2014
+// Licensed under the GPLv2
+// See LICENSE.txt for full license text
+
+// File : sfx_util.h
+// Date : October 17, 2026
+// Description : Color special effects for whole scanlines
+//
+// Alpha blending, brightness up/down and master brightness for the GBA and NDS LCDs
+// Each effect works on a full line at once, using SSE2 or AVX2 when the host supports it
+
+#ifndef GBE_SFX_UTIL
+#define GBE_SFX_UTIL
+
+#include "common.h"
+
+namespace sfx_util
+{
+	//Effect applied to each pixel of a line
+	enum line_op
+	{
+		SFX_NONE,
+		SFX_BLEND,
+		SFX_BRIGHTEN,
+		SFX_DARKEN,
+	};
+
+	//Applies ops[x] to RGB15 color_1[x] (and color_2[x] when blending), writing 32-bit ARGB to out[x]
+	//Pixels with SFX_NONE are left alone. EVA, EVB and EVY are the raw 5-bit coefficients (x/16)
+	void apply_line(const u8* ops, const u16* color_1, const u16* color_2, u32* out, u32 count, u8 eva, u8 evb, u8 evy);
+
+	//Fades 6-bit per channel 32-bit ARGB pixels towards white or black, in place
+	void master_brightness_line(u32* line, u32 count, bool increase, u8 factor);
+
+	//Plain C++ versions. The SIMD versions always produce the same results as these
+	void apply_line_scalar(const u8* ops, const u16* color_1, const u16* color_2, u32* out, u32 count, u8 eva, u8 evb, u8 evy);
+	void master_brightness_line_scalar(u32* line, u32 count, bool increase, u8 factor);
+
+	//Kernel sets that can be forced in place of the ones picked for this host
+	enum kernel_type
+	{
+		SFX_KERNEL_SCALAR,
+		SFX_KERNEL_SSE2,
+		SFX_KERNEL_AVX2,
+	};
+
+	//Makes apply_line() and master_brightness_line() use the given kernels. Returns false if this host can't run them
+	bool force_kernel(kernel_type type);
+
+	//Name of the kernels currently in use
+	const char* kernel_name();
+}
+
+#endif // GBE_SFX_UTIL
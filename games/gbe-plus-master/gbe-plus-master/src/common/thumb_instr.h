@@ -2,17 +2,23 @@
 // Licensed under the GPLv2
 // See LICENSE.txt for full license text
 
-// File : thumb_instr.cpp
+// File : thumb_instr.h
 // Date : May 23, 2014
-// Description : ARM7 THUMB instructions
+// Description : ARM7 and ARM9 THUMB instructions
 //
-// Emulates an ARM7 THUMB instructions with equivalent C++
+// Emulates ARM7 and ARM9 THUMB instructions with equivalent C++
+// Shared by the GBA ARM7, NDS7, and NDS9 through arm_interpreter
+// Only included by arm_interpreter.h
 
-#include "arm7.h"
+#ifndef GBE_THUMB_INSTR
+#define GBE_THUMB_INSTR
 
 /****** THUMB.1 - Move Shifted Register ******/
-void ARM7::move_shifted_register(u16 current_thumb_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::move_shifted_register(u16 current_thumb_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab destination register - Bits 0-2
 	u8 dest_reg = (current_thumb_instruction & 0x7);
 
@@ -25,7 +31,7 @@ void ARM7::move_shifted_register(u16 current_thumb_instruction)
 	//Grab shift opcode - Bits 11-12
 	u8 op = ((current_thumb_instruction >> 11) & 0x3);
 
-	u32 result = get_reg(src_reg);
+	u32 result = derived().get_reg(src_reg);
 	u8 shift_out = 0;
 
 	//Shift the register
@@ -46,30 +52,24 @@ void ARM7::move_shifted_register(u16 current_thumb_instruction)
 			shift_out = arithmetic_shift_right(result, offset);
 			break;
 
-		default: std::cout<<"CPU::Warning: This should not happen in THUMB.1 ... \n"; break;
+		default: std::cout<<cpu_traits::log_name<<"::Warning: This should not happen in THUMB.1 ... \n"; break;
 	}
 
-	set_reg(dest_reg, result);
-
-	//Zero flag
-	if(result == 0) { reg.cpsr |= CPSR_Z_FLAG; }
-	else { reg.cpsr &= ~CPSR_Z_FLAG; }
+	derived().set_reg(dest_reg, result);
 
-	//Negative flag
-	if(result & 0x80000000) { reg.cpsr |= CPSR_N_FLAG; }
-	else { reg.cpsr &= ~CPSR_N_FLAG; }
-
-	//Carry flag
-	if(shift_out == 1) { reg.cpsr |= CPSR_C_FLAG; }
-	else if(shift_out == 0) { reg.cpsr &= ~CPSR_C_FLAG; }
+	//Update condition codes
+	update_condition_logical(result, shift_out);
 
 	//Clock CPU and controllers - 1S
-	clock(reg.r15, false);
+	derived().clock(reg.r15, CODE_S16);
 } 
 
 /****** THUMB.2 - Add-Sub Immediate ******/
-void ARM7::add_sub_immediate(u16 current_thumb_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::add_sub_immediate(u16 current_thumb_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab destination register - Bits 0-2
 	u8 dest_reg = (current_thumb_instruction & 0x7);
 
@@ -79,7 +79,7 @@ void ARM7::add_sub_immediate(u16 current_thumb_instruction)
 	//Grab the opcode - Bits 9-10
 	u8 op = ((current_thumb_instruction >> 9) & 0x3);
 
-	u32 input = get_reg(src_reg);
+	u32 input = derived().get_reg(src_reg);
 	u32 result = 0;
 	u32 operand = 0;
 	u8 imm_reg = ((current_thumb_instruction >> 6) & 0x7);
@@ -89,13 +89,13 @@ void ARM7::add_sub_immediate(u16 current_thumb_instruction)
 	{
 		//Add with register as operand
 		case 0x0:
-			operand = get_reg(imm_reg);
+			operand = derived().get_reg(imm_reg);
 			result = input + operand;
 			break;
 
 		//Subtract with register as operand
 		case 0x1:
-			operand = get_reg(imm_reg);
+			operand = derived().get_reg(imm_reg);
 			result = input - operand;
 			break;
 
@@ -112,26 +112,29 @@ void ARM7::add_sub_immediate(u16 current_thumb_instruction)
 			break;
 	}
 
-	set_reg(dest_reg, result);
+	derived().set_reg(dest_reg, result);
 
 	//Update condition codes
 	if(op & 0x1){ update_condition_arithmetic(input, operand, result, false); }
 	else { update_condition_arithmetic(input, operand, result, true); }
 
 	//Clock CPU and controllers - 1S
-	clock(reg.r15, false);
+	derived().clock(reg.r15, CODE_S16);
 }
 
 /****** THUMB.3 Move-Compare-Add-Subtract Immediate ******/
-void ARM7::mcas_immediate(u16 current_thumb_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::mcas_immediate(u16 current_thumb_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab destination register - Bits 8-10
 	u8 dest_reg = ((current_thumb_instruction >> 8) & 0x7);
 
 	//Grab opcode - Bits 11-12
 	u8 op = ((current_thumb_instruction >> 11) & 0x3);
 
-	u32 input = get_reg(dest_reg); //Looks weird but the source is also the destination in this instruction
+	u32 input = derived().get_reg(dest_reg); //Looks weird but the source is also the destination in this instruction
 	u32 result = 0;
 	
 	//Operand is 8-bit immediate
@@ -144,13 +147,8 @@ void ARM7::mcas_immediate(u16 current_thumb_instruction)
 		case 0x0:
 			result = operand;
 
-			//Zero flag
-			if(result == 0) { reg.cpsr |= CPSR_Z_FLAG; }
-			else { reg.cpsr &= ~CPSR_Z_FLAG; }
-
-			//Negative flag
-			if(result & 0x80000000) { reg.cpsr |= CPSR_N_FLAG; }
-			else { reg.cpsr &= ~CPSR_N_FLAG; }
+			//Update condition codes - Carry is not affected
+			update_condition_logical(result, 2);
 			
 			break;
 
@@ -169,29 +167,30 @@ void ARM7::mcas_immediate(u16 current_thumb_instruction)
 	}
 
 	//Do not update the destination register if CMP is the operation!
-	if(op != 1) { set_reg(dest_reg, result); }
+	if(op != 1) { derived().set_reg(dest_reg, result); }
 
 	//Clock CPU and controllers - 1S
-	clock(reg.r15, false);
+	derived().clock(reg.r15, CODE_S16);
 }
 			
 /****** THUMB.4 ALU Operations ******/
-void ARM7::alu_ops(u16 current_thumb_instruction)
+template<typename cpu_type, typename cpu_traits>
+template<u8 op>
+void arm_interpreter<cpu_type, cpu_traits>::alu_ops(u16 current_thumb_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab destination register - Bits 0-2
 	u8 dest_reg = (current_thumb_instruction & 0x7);
 
 	//Grab source register - Bits 3-5
 	u8 src_reg = ((current_thumb_instruction >> 3) & 0x7);
 
-	//Grab opcode - Bits 6-9
-	u8 op = ((current_thumb_instruction >> 6) & 0xF);
-
-	u32 input = get_reg(dest_reg); //Still looks weird, but same as in THUMB.3
+	u32 input = derived().get_reg(dest_reg); //Still looks weird, but same as in THUMB.3
 	u32 result = 0;
-	u32 operand = get_reg(src_reg);
-	u8 shift_out = 0;
-	u8 carry_out = (reg.cpsr & CPSR_C_FLAG) ? 1 : 0;
+	u32 operand = derived().get_reg(src_reg);
+	u8 shift_out = 2;
+	u8 carry_out = 0;
 
 	//Perform ALU operations
 	switch(op)
@@ -200,18 +199,13 @@ void ARM7::alu_ops(u16 current_thumb_instruction)
 		case 0x0:
 			result = (input & operand);
 			
-			//Zero flag
-			if(result == 0) { reg.cpsr |= CPSR_Z_FLAG; }
-			else { reg.cpsr &= ~CPSR_Z_FLAG; }
+			//Update condition codes - Carry is not affected
+			update_condition_logical(result, 2);
 
-			//Negative flag
-			if(result & 0x80000000) { reg.cpsr |= CPSR_N_FLAG; }
-			else { reg.cpsr &= ~CPSR_N_FLAG; }
-
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Clock CPU and controllers - 1S
-			clock(reg.r15, false);
+			derived().clock(reg.r15, CODE_S16);
 
 			break;
 
@@ -219,18 +213,13 @@ void ARM7::alu_ops(u16 current_thumb_instruction)
 		case 0x1:
 			result = (input ^ operand);
 		
-			//Zero flag
-			if(result == 0) { reg.cpsr |= CPSR_Z_FLAG; }
-			else { reg.cpsr &= ~CPSR_Z_FLAG; }
-
-			//Negative flag
-			if(result & 0x80000000) { reg.cpsr |= CPSR_N_FLAG; }
-			else { reg.cpsr &= ~CPSR_N_FLAG; }
+			//Update condition codes - Carry is not affected
+			update_condition_logical(result, 2);
 
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Clock CPU and controllers - 1S
-			clock(reg.r15, false);
+			derived().clock(reg.r15, CODE_S16);
 
 			break;
 
@@ -240,28 +229,16 @@ void ARM7::alu_ops(u16 current_thumb_instruction)
 			if(operand != 0) { shift_out = logical_shift_left(input, operand); }
 			result = input;
 
-			//Zero flag
-			if(result == 0) { reg.cpsr |= CPSR_Z_FLAG; }
-			else { reg.cpsr &= ~CPSR_Z_FLAG; }
-
-			//Negative flag
-			if(result & 0x80000000) { reg.cpsr |= CPSR_N_FLAG; }
-			else { reg.cpsr &= ~CPSR_N_FLAG; }		
-
-			//Carry flag
-			if(operand != 0)
-			{
-				if(shift_out == 1) { reg.cpsr |= CPSR_C_FLAG; }
-				else if(shift_out == 0) { reg.cpsr &= ~CPSR_C_FLAG; }
-			}
+			//Update condition codes - Carry is not affected when shifting by 0
+			update_condition_logical(result, shift_out);
 
 			//Clock CPU and controllers - 1I
-			clock();
+			derived().clock();
 
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Clock CPU and controllers - 1S
-			clock((reg.r15 + 2), false);
+			derived().clock((reg.r15 + 2), CODE_S16);
 
 			break;
 
@@ -271,28 +248,16 @@ void ARM7::alu_ops(u16 current_thumb_instruction)
 			if(operand != 0) { shift_out = logical_shift_right(input, operand); }
 			result = input;
 
-			//Zero flag
-			if(result == 0) { reg.cpsr |= CPSR_Z_FLAG; }
-			else { reg.cpsr &= ~CPSR_Z_FLAG; }
-
-			//Negative flag
-			if(result & 0x80000000) { reg.cpsr |= CPSR_N_FLAG; }
-			else { reg.cpsr &= ~CPSR_N_FLAG; }		
-
-			//Carry flag
-			if(operand != 0)
-			{
-				if(shift_out == 1) { reg.cpsr |= CPSR_C_FLAG; }
-				else if(shift_out == 0) { reg.cpsr &= ~CPSR_C_FLAG; }
-			}
+			//Update condition codes - Carry is not affected when shifting by 0
+			update_condition_logical(result, shift_out);
 
 			//Clock CPU and controllers - 1I
-			clock();
+			derived().clock();
 
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Clock CPU and controllers - 1S
-			clock((reg.r15 + 2), false);
+			derived().clock((reg.r15 + 2), CODE_S16);
 
 			break;
 
@@ -302,45 +267,41 @@ void ARM7::alu_ops(u16 current_thumb_instruction)
 			if(operand != 0) { shift_out = arithmetic_shift_right(input, operand); }
 			result = input;
 
-			//Zero flag
-			if(result == 0) { reg.cpsr |= CPSR_Z_FLAG; }
-			else { reg.cpsr &= ~CPSR_Z_FLAG; }
-
-			//Negative flag
-			if(result & 0x80000000) { reg.cpsr |= CPSR_N_FLAG; }
-			else { reg.cpsr &= ~CPSR_N_FLAG; }		
-
-			//Carry flag
-			if(operand != 0)
-			{
-				if(shift_out == 1) { reg.cpsr |= CPSR_C_FLAG; }
-				else if(shift_out == 0) { reg.cpsr &= ~CPSR_C_FLAG; }
-			}
+			//Update condition codes - Carry is not affected when shifting by 0
+			update_condition_logical(result, shift_out);
 
 			//Clock CPU and controllers - 1I
-			clock();
+			derived().clock();
 
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Clock CPU and controllers - 1S
-			clock((reg.r15 + 2), false);
+			derived().clock((reg.r15 + 2), CODE_S16);
 
 			break;
 
 		//ADC
 		case 0x5:
+			//Materialize the carry flag from the last flag-setting operation
+			update_flags();
+			carry_out = (reg.cpsr & CPSR_C_FLAG) ? 1 : 0;
+
 			result = (input + operand + carry_out);
 			update_condition_arithmetic(input, (u64(operand) + carry_out), result, true);
 
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Clock CPU and controllers - 1S
-			clock(reg.r15, false);
+			derived().clock(reg.r15, CODE_S16);
 
 			break;
 
 		//SBC
 		case 0x6:
+			//Materialize the carry flag from the last flag-setting operation
+			update_flags();
+			carry_out = (reg.cpsr & CPSR_C_FLAG) ? 1 : 0;
+
 			//Invert (NOT) carry
 			if(carry_out) { carry_out = 0; }
 			else { carry_out = 1; }
@@ -348,10 +309,10 @@ void ARM7::alu_ops(u16 current_thumb_instruction)
 			result = (input - operand - carry_out);
 			update_condition_arithmetic(input, (u64(operand) + carry_out), result, false);
 
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Clock CPU and controllers - 1S
-			clock(reg.r15, false);
+			derived().clock(reg.r15, CODE_S16);
 
 			break;
 
@@ -361,28 +322,16 @@ void ARM7::alu_ops(u16 current_thumb_instruction)
 			if(operand != 0) { shift_out = rotate_right(input, operand); }
 			result = input;
 
-			//Zero flag
-			if(result == 0) { reg.cpsr |= CPSR_Z_FLAG; }
-			else { reg.cpsr &= ~CPSR_Z_FLAG; }
-
-			//Negative flag
-			if(result & 0x80000000) { reg.cpsr |= CPSR_N_FLAG; }
-			else { reg.cpsr &= ~CPSR_N_FLAG; }		
-
-			//Carry flag
-			if(operand != 0)
-			{
-				if(shift_out == 1) { reg.cpsr |= CPSR_C_FLAG; }
-				else if(shift_out == 0) { reg.cpsr &= ~CPSR_C_FLAG; }
-			}
+			//Update condition codes - Carry is not affected when shifting by 0
+			update_condition_logical(result, shift_out);
 
 			//Clock CPU and controllers - 1I
-			clock();
+			derived().clock();
 
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Clock CPU and controllers - 1S
-			clock(reg.r15, false);
+			derived().clock(reg.r15, CODE_S16);
 
 			break;
 
@@ -390,16 +339,11 @@ void ARM7::alu_ops(u16 current_thumb_instruction)
 		case 0x8:
 			result = (input & operand);
 
-			//Zero flag
-			if(result == 0) { reg.cpsr |= CPSR_Z_FLAG; }
-			else { reg.cpsr &= ~CPSR_Z_FLAG; }
-
-			//Negative flag
-			if(result & 0x80000000) { reg.cpsr |= CPSR_N_FLAG; }
-			else { reg.cpsr &= ~CPSR_N_FLAG; }
+			//Update condition codes - Carry is not affected
+			update_condition_logical(result, 2);
 
 			//Clock CPU and controllers - 1S
-			clock(reg.r15, false);
+			derived().clock(reg.r15, CODE_S16);
 
 			break;
 
@@ -409,10 +353,10 @@ void ARM7::alu_ops(u16 current_thumb_instruction)
 			result = (input - operand);
 			update_condition_arithmetic(input, operand, result, false);
 
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Clock CPU and controllers - 1S
-			clock(reg.r15, false);
+			derived().clock(reg.r15, CODE_S16);
 
 			break;
 
@@ -422,7 +366,7 @@ void ARM7::alu_ops(u16 current_thumb_instruction)
 			update_condition_arithmetic(input, operand, result, false);
 
 			//Clock CPU and controllers - 1S
-			clock(reg.r15, false);
+			derived().clock(reg.r15, CODE_S16);
 
 			break;
 
@@ -432,7 +376,7 @@ void ARM7::alu_ops(u16 current_thumb_instruction)
 			update_condition_arithmetic(input, operand, result, true);
 
 			//Clock CPU and controllers - 1S
-			clock(reg.r15, false);
+			derived().clock(reg.r15, CODE_S16);
 
 			break;
 
@@ -440,18 +384,13 @@ void ARM7::alu_ops(u16 current_thumb_instruction)
 		case 0xC:
 			result = (input | operand);
 			
-			//Zero flag
-			if(result == 0) { reg.cpsr |= CPSR_Z_FLAG; }
-			else { reg.cpsr &= ~CPSR_Z_FLAG; }
+			//Update condition codes - Carry is not affected
+			update_condition_logical(result, 2);
 
-			//Negative flag
-			if(result & 0x80000000) { reg.cpsr |= CPSR_N_FLAG; }
-			else { reg.cpsr &= ~CPSR_N_FLAG; }
-
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Clock CPU and controllers - 1S
-			clock(reg.r15, false);
+			derived().clock(reg.r15, CODE_S16);
 
 			break;
 
@@ -459,36 +398,32 @@ void ARM7::alu_ops(u16 current_thumb_instruction)
 		case 0xD:
 			result = (input * operand);
 
-			//Zero flag
-			if(result == 0) { reg.cpsr |= CPSR_Z_FLAG; }
-			else { reg.cpsr &= ~CPSR_Z_FLAG; }
-
-			//Negative flag
-			if(result & 0x80000000) { reg.cpsr |= CPSR_N_FLAG; }
-			else { reg.cpsr &= ~CPSR_N_FLAG; }
+			//Update condition codes - Carry is not affected
+			update_condition_logical(result, 2);
 
 			//TODO - Figure out what the carry flag should be for this opcode.
-			//TODO - Figure out the timing for this opcode
 
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
+
+			//Clock CPU and controllers - (m)I - Rd is the multiplier
+			for(u8 x = multiply_cycles(input, true); x > 0; x--) { derived().clock(); }
+
+			//Clock CPU and controllers - 1S
+			derived().clock(reg.r15, CODE_S16);
+
 			break;
 
 		//BIC
 		case 0xE:
 			result = (input & ~operand);
 
-			//Zero flag
-			if(result == 0) { reg.cpsr |= CPSR_Z_FLAG; }
-			else { reg.cpsr &= ~CPSR_Z_FLAG; }
+			//Update condition codes - Carry is not affected
+			update_condition_logical(result, 2);
 
-			//Negative flag
-			if(result & 0x80000000) { reg.cpsr |= CPSR_N_FLAG; }
-			else { reg.cpsr &= ~CPSR_N_FLAG; }
-
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Clock CPU and controllers - 1S
-			clock(reg.r15, false);
+			derived().clock(reg.r15, CODE_S16);
 
 			break;
 
@@ -496,26 +431,24 @@ void ARM7::alu_ops(u16 current_thumb_instruction)
 		case 0xF:
 			result = ~operand;
 
-			//Zero flag
-			if(result == 0) { reg.cpsr |= CPSR_Z_FLAG; }
-			else { reg.cpsr &= ~CPSR_Z_FLAG; }
-
-			//Negative flag
-			if(result & 0x80000000) { reg.cpsr |= CPSR_N_FLAG; }
-			else { reg.cpsr &= ~CPSR_N_FLAG; }
+			//Update condition codes - Carry is not affected
+			update_condition_logical(result, 2);
 
-			set_reg(dest_reg, result);
+			derived().set_reg(dest_reg, result);
 
 			//Clock CPU and controllers - 1S
-			clock(reg.r15, false);
+			derived().clock(reg.r15, CODE_S16);
 
 			break;
 	}
 }
 
 /****** THUMB.5 High Register Operations + Branch Exchange ******/
-void ARM7::hireg_bx(u16 current_thumb_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::hireg_bx(u16 current_thumb_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab destination register - Bits 0-2
 	u8 dest_reg = (current_thumb_instruction & 0x7);
 
@@ -535,15 +468,31 @@ void ARM7::hireg_bx(u16 current_thumb_instruction)
 	//Grab the opcode
 	u8 op = ((current_thumb_instruction >> 8) & 0x3);
 
-	u32 input = get_reg(dest_reg); //Still looks weird, but same as in THUMB.3
+	u32 input = derived().get_reg(dest_reg); //Still looks weird, but same as in THUMB.3
 	u32 result = 0;
-	u32 operand = get_reg(src_reg);
+	u32 operand = derived().get_reg(src_reg);
 
 	if((op == 3) && (dr_msb != 0)) 
 	{ 
-		std::cout<<"CPU::Error - THUMB.5 Using BX but MSBd is set \n";
-		running = false;
-		return;
+		//ARMv5 - BLX
+		if constexpr(cpu_traits::armv5te)
+		{
+			op = 4;
+
+			if(src_reg == 15)
+			{
+				std::cout<<cpu_traits::log_name<<"::Error - THUMB.5 BLX using R15 as operand \n";
+				derived().running = false;
+				return;
+			}
+		}
+
+		else
+		{
+			std::cout<<cpu_traits::log_name<<"::Error - THUMB.5 Using BX but MSBd is set \n";
+			derived().running = false;
+			return;
+		}
 	}
 
 	//Perform ops or branch - Only CMP affects flags!
@@ -558,25 +507,25 @@ void ARM7::hireg_bx(u16 current_thumb_instruction)
 			if(dest_reg != 15)
 			{
 				result = (input + operand);
-				set_reg(dest_reg, result);
+				derived().set_reg(dest_reg, result);
 
 				//Clock CPU and controllers - 1S
-				clock(reg.r15, false);
+				derived().clock(reg.r15, CODE_S16);
 			}
 
 			//Destination is PC
 			else
 			{
 				//Clock CPU and controllers - 1N
-				clock(reg.r15, true);
+				derived().clock(reg.r15, CODE_N16);
 
 				result = (input + operand);
-				set_reg(dest_reg, result);
-				needs_flush = true;
+				derived().set_reg(dest_reg, result);
+				derived().needs_flush = true;
 
 				//Clock CPU and controllers - 2S
-				clock(reg.r15, false);
-				clock((reg.r15 + 2), false);
+				derived().clock(reg.r15, CODE_S16);
+				derived().clock((reg.r15 + 2), CODE_S16);
 			}
 
 			break;
@@ -587,7 +536,7 @@ void ARM7::hireg_bx(u16 current_thumb_instruction)
 			update_condition_arithmetic(input, operand, result, false);
 
 			//Clock CPU and controllers - 1S
-			clock(reg.r15, false);
+			derived().clock(reg.r15, CODE_S16);
 
 			break;
 
@@ -600,25 +549,25 @@ void ARM7::hireg_bx(u16 current_thumb_instruction)
 			if(dest_reg != 15)
 			{
 				result = operand;
-				set_reg(dest_reg, result);
+				derived().set_reg(dest_reg, result);
 
 				//Clock CPU and controllers - 1S
-				clock(reg.r15, false);
+				derived().clock(reg.r15, CODE_S16);
 			}
 
 			//Operand is PC
 			else
 			{
 				//Clock CPU and controllers - 1N
-				clock(reg.r15, true);
+				derived().clock(reg.r15, CODE_N16);
 
 				result = operand;
-				set_reg(dest_reg, result);
-				needs_flush = true;
+				derived().set_reg(dest_reg, result);
+				derived().needs_flush = true;
 
 				//Clock CPU and controllers - 2S
-				clock(reg.r15, false);
-				clock((reg.r15 + 2), false);
+				derived().clock(reg.r15, CODE_S16);
+				derived().clock((reg.r15 + 2), CODE_S16);
 			}
 
 			break;
@@ -628,7 +577,7 @@ void ARM7::hireg_bx(u16 current_thumb_instruction)
 			//Switch to ARM mode if necessary
 			if((operand & 0x1) == 0)
 			{
-				arm_mode = ARM;
+				derived().arm_mode = cpu_type::ARM;
 				reg.cpsr &= ~0x20;
 				operand &= ~0x3;
 			}
@@ -637,7 +586,7 @@ void ARM7::hireg_bx(u16 current_thumb_instruction)
 			else { operand &= ~0x1; }
 
 			//Clock CPU and controllers - 1N
-			clock(reg.r15, true);
+			derived().clock(reg.r15, CODE_N16);
 
 			//Auto-align PC when using R15 as an operand
 			if(src_reg == 15)
@@ -648,17 +597,46 @@ void ARM7::hireg_bx(u16 current_thumb_instruction)
 			else { reg.r15 = operand; }
 
 			//Clock CPU and controllers - 2S
-			clock(reg.r15, false);
-			clock((reg.r15 + 2), false);
+			derived().clock(reg.r15, CODE_S16);
+			derived().clock((reg.r15 + 2), CODE_S16);
 
-			needs_flush = true;
+			derived().needs_flush = true;
+			break;
+
+		//BLX
+		case 0x4:
+			//Switch to ARM mode if necessary
+			if((operand & 0x1) == 0)
+			{
+				derived().arm_mode = cpu_type::ARM;
+				reg.cpsr &= ~0x20;
+			}
+
+			//Align operand to half-word
+			else { operand &= ~0x1; }
+
+			//Clock CPU and controllers - 1N
+			derived().clock(reg.r15, CODE_N16);
+
+			//LR is PC+3, but GBE+'s PC is always 4 ahead in THUMB mode anyway, so set to PC - 1.
+			derived().set_reg(14, (reg.r15 - 1));
+			reg.r15 = operand;
+
+			//Clock CPU and controllers - 2S
+			derived().clock(reg.r15, CODE_S16);
+			derived().clock((reg.r15 + 2), CODE_S16);
+
+			derived().needs_flush = true;
 			break;
 	}
 }
 
 /****** THUMB.6 Load PC Relative ******/
-void ARM7::load_pc_relative(u16 current_thumb_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::load_pc_relative(u16 current_thumb_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab 8-bit offset - Bits 0-7
 	u16 offset = (current_thumb_instruction & 0xFF);
 	
@@ -670,20 +648,23 @@ void ARM7::load_pc_relative(u16 current_thumb_instruction)
 	u32 load_addr = (reg.r15 & ~0x2) + offset;
 
 	//Clock CPU and controllers - 1N
-	clock(reg.r15, true);
+	derived().clock(load_addr, DATA_N32);
 
 	//Clock CPU and controllers - 1I
-	mem_check_32(load_addr, value, true);
-	clock();
+	derived().mem_check_32(load_addr, value, true);
+	derived().clock();
 
 	//Clock CPU and controllers - 1S
-	set_reg(dest_reg, value);
-	clock((reg.r15 + 2), false);
+	derived().set_reg(dest_reg, value);
+	derived().clock((reg.r15 + 2), CODE_S16);
 }
 
 /****** THUMB.7 Load-Store with Register Offset ******/
-void ARM7::load_store_reg_offset(u16 current_thumb_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::load_store_reg_offset(u16 current_thumb_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab source-destination register - Bits 0-2
 	u8 src_dest_reg = (current_thumb_instruction & 0x7);
 
@@ -697,7 +678,7 @@ void ARM7::load_store_reg_offset(u16 current_thumb_instruction)
 	u8 op = ((current_thumb_instruction >> 10) & 0x3);
 
 	u32 value = 0;
-	u32 op_addr = get_reg(base_reg) + get_reg(offset_reg);
+	u32 op_addr = derived().get_reg(base_reg) + derived().get_reg(offset_reg);
 
 	//Perform Load-Store ops
 	switch(op)
@@ -705,63 +686,66 @@ void ARM7::load_store_reg_offset(u16 current_thumb_instruction)
 		//STR
 		case 0x0:
 			//Clock CPU and controllers - 1N
-			clock(reg.r15, true);
+			derived().clock(reg.r15, CODE_N16);
 
 			//Clock CPU and controllers - 1N
-			value = get_reg(src_dest_reg);
-			mem->write_u32(op_addr, value);
-			clock(op_addr, true);
+			value = derived().get_reg(src_dest_reg);
+			derived().mem->write_u32(op_addr, value);
+			derived().clock(op_addr, DATA_N32);
 
 			break;
 
 		//STRB
 		case 0x1:
 			//Clock CPU and controllers - 1N
-			clock(reg.r15, true);
+			derived().clock(reg.r15, CODE_N16);
 
 			//Clock CPU and controllers - 1N
-			value = get_reg(src_dest_reg);
+			value = derived().get_reg(src_dest_reg);
 			value &= 0xFF;
-			mem_check_8(op_addr, value, false);
-			clock(op_addr, true);
+			derived().mem_check_8(op_addr, value, false);
+			derived().clock(op_addr, DATA_N16);
 
 			break;
 
 		//LDR
 		case 0x2:
 			//Clock CPU and controllers - 1N
-			clock(reg.r15, true);
+			derived().clock(op_addr, DATA_N32);
 
 			//Clock CPU and controllers - 1I
-			mem_check_32(op_addr, value, true);
-			clock();
+			derived().mem_check_32(op_addr, value, true);
+			derived().clock();
 
 			//Clock CPU and controllers - 1S
-			set_reg(src_dest_reg, value);
-			clock((reg.r15 + 2), false);
+			derived().set_reg(src_dest_reg, value);
+			derived().clock((reg.r15 + 2), CODE_S16);
 
 			break;
 
 		//LDRB
 		case 0x3:
 			//Clock CPU and controllers - 1N
-			clock(reg.r15, true);
+			derived().clock(op_addr, DATA_N16);
 
 			//Clock CPU and controllers - 1I
-			mem_check_8(op_addr, value, true);
-			clock();
+			derived().mem_check_8(op_addr, value, true);
+			derived().clock();
 
 			//Clock CPU and controllers - 1S
-			set_reg(src_dest_reg, value);
-			clock((reg.r15 + 2), false);
+			derived().set_reg(src_dest_reg, value);
+			derived().clock((reg.r15 + 2), CODE_S16);
 
 			break;
 	}
 }
 
 /****** THUMB.8 Load-Store Sign-Extended ******/
-void ARM7::load_store_sign_ex(u16 current_thumb_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::load_store_sign_ex(u16 current_thumb_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab source-destination register - Bits 0-2
 	u8 src_dest_reg = (current_thumb_instruction & 0x7);
 
@@ -775,7 +759,7 @@ void ARM7::load_store_sign_ex(u16 current_thumb_instruction)
 	u8 op = ((current_thumb_instruction >> 10) & 0x3);
 
 	u32 value = 0;
-	u32 op_addr = get_reg(base_reg) + get_reg(offset_reg);
+	u32 op_addr = derived().get_reg(base_reg) + derived().get_reg(offset_reg);
 
 	//Perform Load-Store ops
 	switch(op)
@@ -783,31 +767,31 @@ void ARM7::load_store_sign_ex(u16 current_thumb_instruction)
 		//STRH
 		case 0x0:
 			//Clock CPU and controllers - 1N
-			clock(reg.r15, true);
+			derived().clock(reg.r15, CODE_N16);
 
 			//Clock CPU and controllers - 1N
-			value = get_reg(src_dest_reg);
+			value = derived().get_reg(src_dest_reg);
 			value &= 0xFFFF;
-			mem_check_16(op_addr, value, false);
-			clock(reg.r15, true);
+			derived().mem_check_16(op_addr, value, false);
+			derived().clock(op_addr, DATA_N16);
 
 			break;
 
 		//LDSB
 		case 0x1:
 			//Clock CPU and controllers - 1N
-			clock(reg.r15, true);
+			derived().clock(op_addr, DATA_N16);
 
 			//Clock CPU and controllers - 1I
-			value = mem->read_u8(op_addr);
-			clock();
+			value = derived().mem->read_u8(op_addr);
+			derived().clock();
 
 			//Sign extend from Bit 7
 			if(value & 0x80) { value |= 0xFFFFFF00; }
 
 			//Clock CPU and controllers - 1S
-			set_reg(src_dest_reg, value);
-			clock((reg.r15 + 2), false);
+			derived().set_reg(src_dest_reg, value);
+			derived().clock((reg.r15 + 2), CODE_S16);
 
 			break;
 
@@ -816,41 +800,44 @@ void ARM7::load_store_sign_ex(u16 current_thumb_instruction)
 			//Since value is u32 and 0, it is already zero-extended :)
 			
 			//Clock CPU and controllers - 1N
-			clock(reg.r15, true);
+			derived().clock(op_addr, DATA_N16);
 
 			//Clock CPU and controllers - 1I
-			mem_check_16(op_addr, value, true);
-			clock();
+			derived().mem_check_16(op_addr, value, true);
+			derived().clock();
 
 			//Clock CPU and controllers - 1S
-			set_reg(src_dest_reg, value);
-			clock((reg.r15 + 2), false);
+			derived().set_reg(src_dest_reg, value);
+			derived().clock((reg.r15 + 2), CODE_S16);
 
 			break;
 
 		//LDSH
 		case 0x3:
 			//Clock CPU and controllers - 1N
-			clock(reg.r15, true);
+			derived().clock(op_addr, DATA_N16);
 
 			//Clock CPU and controllers - 1I
-			mem_check_16(op_addr, value, true);
-			clock();
+			derived().mem_check_16(op_addr, value, true);
+			derived().clock();
 
 			//Sign extend from Bit 15
 			if(value & 0x8000) { value |= 0xFFFF0000; }
 
 			//Clock CPU and controllers - 1S
-			set_reg(src_dest_reg, value);
-			clock((reg.r15 + 2), false);
+			derived().set_reg(src_dest_reg, value);
+			derived().clock((reg.r15 + 2), CODE_S16);
 
 			break;
 	}		
 }
 
 /****** THUMB.9 Load-Store with Immediate Offset ******/
-void ARM7::load_store_imm_offset(u16 current_thumb_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::load_store_imm_offset(u16 current_thumb_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab source-destination register - Bits 0-2
 	u8 src_dest_reg = (current_thumb_instruction & 0x7);
 
@@ -864,7 +851,7 @@ void ARM7::load_store_imm_offset(u16 current_thumb_instruction)
 	u8 op = ((current_thumb_instruction >> 11) & 0x3);
 
 	u32 value = 0;
-	u32 op_addr = get_reg(base_reg);
+	u32 op_addr = derived().get_reg(base_reg);
 
 	//Perform Load-Store ops
 	switch(op)
@@ -872,14 +859,14 @@ void ARM7::load_store_imm_offset(u16 current_thumb_instruction)
 		//STR
 		case 0x0:
 			//Clock CPU and controllers - 1N
-			value = get_reg(src_dest_reg);
+			value = derived().get_reg(src_dest_reg);
 			offset <<= 2;
 			op_addr += offset;
-			clock(reg.r15, true);
+			derived().clock(reg.r15, CODE_N16);
 			
 			//Clock CPU and controllers - 1N
-			mem_check_32(op_addr, value, false);
-			clock(op_addr, true);
+			derived().mem_check_32(op_addr, value, false);
+			derived().clock(op_addr, DATA_N32);
 			
 			break;
 
@@ -888,28 +875,28 @@ void ARM7::load_store_imm_offset(u16 current_thumb_instruction)
 			//Clock CPU and controllers - 1N
 			offset <<= 2;
 			op_addr += offset;
-			clock(reg.r15, true);
+			derived().clock(op_addr, DATA_N32);
 
 			//Clock CPU and controllers - 1I
-			mem_check_32(op_addr, value, true);
-			clock();
+			derived().mem_check_32(op_addr, value, true);
+			derived().clock();
 
 			//Clock CPU and controllers - 1S
-			set_reg(src_dest_reg, value);
-			clock((reg.r15 + 2), false);
+			derived().set_reg(src_dest_reg, value);
+			derived().clock((reg.r15 + 2), CODE_S16);
 
 			break;
 
 		//STRB
 		case 0x2:
 			//Clock CPU and controllers - 1N
-			value = get_reg(src_dest_reg);
+			value = derived().get_reg(src_dest_reg);
 			op_addr += offset;
-			clock(reg.r15, true);
+			derived().clock(reg.r15, CODE_N16);
 
 			//Clock CPU and controllers - 1N
-			mem_check_8(op_addr, value, false);
-			clock(op_addr, true);
+			derived().mem_check_8(op_addr, value, false);
+			derived().clock(op_addr, DATA_N16);
 
 			break;
 
@@ -917,23 +904,26 @@ void ARM7::load_store_imm_offset(u16 current_thumb_instruction)
 		case 0x3:
 			//Clock CPU and controllers - 1N
 			op_addr += offset;
-			clock(reg.r15, true);
+			derived().clock(op_addr, DATA_N16);
 
 			//Clock CPU and controllers - 1I
-			mem_check_8(op_addr, value, true);
-			clock();
+			derived().mem_check_8(op_addr, value, true);
+			derived().clock();
 
 			//Clock CPU and controllers - 1S
-			set_reg(src_dest_reg, value);
-			clock((reg.r15 + 2), false);
+			derived().set_reg(src_dest_reg, value);
+			derived().clock((reg.r15 + 2), CODE_S16);
 
 			break;
 	}
 }
 			
 /****** THUMB.10 Load-Store Halfword ******/
-void ARM7::load_store_halfword(u16 current_thumb_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::load_store_halfword(u16 current_thumb_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab source-destination register - Bits 0-2
 	u8 src_dest_reg = (current_thumb_instruction & 0x7);
 
@@ -947,7 +937,7 @@ void ARM7::load_store_halfword(u16 current_thumb_instruction)
 	u8 op = (current_thumb_instruction & 0x800) ? 1 : 0;
 
 	u32 value = 0;
-	u32 op_addr = get_reg(base_reg);
+	u32 op_addr = derived().get_reg(base_reg);
 
 	offset <<= 1;
 	op_addr += offset;
@@ -958,35 +948,38 @@ void ARM7::load_store_halfword(u16 current_thumb_instruction)
 		//STRH
 		case 0x0:
 			//Clock CPU and controllers - 1N
-			clock(reg.r15, true);
+			derived().clock(reg.r15, CODE_N16);
 
 			//Clock CPU and controllers - 1N
-			value = get_reg(src_dest_reg);
-			mem_check_16(op_addr, value, false);
-			clock(op_addr, true);
+			value = derived().get_reg(src_dest_reg);
+			derived().mem_check_16(op_addr, value, false);
+			derived().clock(op_addr, DATA_N16);
 
 			break;
 
 		//LDRH
 		case 0x1:
 			//Clock CPU and controllers - 1N
-			clock(reg.r15, true);
+			derived().clock(op_addr, DATA_N16);
 
 			//Clock CPU and controllers - 1I
-			mem_check_16(op_addr, value, true);
-			clock();
+			derived().mem_check_16(op_addr, value, true);
+			derived().clock();
 
 			//Clock CPU and controllers - 1S
-			set_reg(src_dest_reg, value);
-			clock((reg.r15 + 2), false);
+			derived().set_reg(src_dest_reg, value);
+			derived().clock((reg.r15 + 2), CODE_S16);
 
 			break;
 	}
 }
 
 /****** THUMB.11 Load-Store SP-Relative ******/
-void ARM7::load_store_sp_relative(u16 current_thumb_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::load_store_sp_relative(u16 current_thumb_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab 8-bit offset - Bits 0-7
 	u16 offset = (current_thumb_instruction & 0xFF);
 
@@ -997,7 +990,7 @@ void ARM7::load_store_sp_relative(u16 current_thumb_instruction)
 	u8 op = (current_thumb_instruction & 0x800) ? 1 : 0;
 
 	u32 value = 0;
-	u32 op_addr = get_reg(13);
+	u32 op_addr = derived().get_reg(13);
 
 	offset <<= 2;
 	op_addr += offset;
@@ -1008,35 +1001,38 @@ void ARM7::load_store_sp_relative(u16 current_thumb_instruction)
 		//STR
 		case 0x0:
 			//Clock CPU and controllers - 1N
-			clock(reg.r15, true);
+			derived().clock(reg.r15, CODE_N16);
 
 			//Clock CPU and controllers - 1N
-			value = get_reg(src_dest_reg);
-			mem_check_32(op_addr, value, false);
-			clock(op_addr, true);
+			value = derived().get_reg(src_dest_reg);
+			derived().mem_check_32(op_addr, value, false);
+			derived().clock(op_addr, DATA_N32);
 
 			break;
 
 		//LDR
 		case 0x1:
 			//Clock CPU and controllers - 1N
-			clock(reg.r15, true);
+			derived().clock(op_addr, DATA_N32);
 
 			//Clock CPU and controllers - 1I
-			mem_check_32(op_addr, value, true);
-			clock();
+			derived().mem_check_32(op_addr, value, true);
+			derived().clock();
 
 			//Clock CPU and controllers - 1S
-			set_reg(src_dest_reg, value);
-			clock((reg.r15 + 2), false);
+			derived().set_reg(src_dest_reg, value);
+			derived().clock((reg.r15 + 2), CODE_S16);
 
 			break;
 	}
 }
 
 /****** THUMB.12 Get Relative Address ******/
-void ARM7::get_relative_address(u16 current_thumb_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::get_relative_address(u16 current_thumb_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab 8-bit offset - Bits 0-7
 	u16 offset = (current_thumb_instruction & 0xFF);
 
@@ -1055,23 +1051,26 @@ void ARM7::get_relative_address(u16 current_thumb_instruction)
 		//Rd = PC + nn
 		case 0x0:
 			value = (reg.r15 & ~0x2) + offset;
-			set_reg(dest_reg, value);
+			derived().set_reg(dest_reg, value);
 			break;
 
 		//Rd = SP + nn
 		case 0x1:
-			value = get_reg(13) + offset;
-			set_reg(dest_reg, value);
+			value = derived().get_reg(13) + offset;
+			derived().set_reg(dest_reg, value);
 			break;
 	}
 
 	//Clock CPU and controllers - 1S
-	clock(reg.r15, false);
+	derived().clock(reg.r15, CODE_S16);
 }
 
 /****** THUMB.13 Add Offset to Stack Pointer ******/
-void ARM7::add_offset_sp(u16 current_thumb_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::add_offset_sp(u16 current_thumb_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab 7-bit offset - Bits 0-6
 	u16 offset = (current_thumb_instruction & 0x7F);
 
@@ -1081,7 +1080,7 @@ void ARM7::add_offset_sp(u16 current_thumb_instruction)
 	offset <<= 2;
 
 	//Grab stack pointer from current CPU mode
-	u32 r13 = get_reg(13);
+	u32 r13 = derived().get_reg(13);
 
 	//Perform add offset ops
 	switch(op)
@@ -1098,20 +1097,23 @@ void ARM7::add_offset_sp(u16 current_thumb_instruction)
 	}
 
 	//Update stack pointer for current CPU mode
-	set_reg(13, r13);
+	derived().set_reg(13, r13);
 
 	//Clock CPU and controllers - 1S
-	clock(reg.r15, false);
+	derived().clock(reg.r15, CODE_S16);
 }
 		
 /****** THUMB.14 Push-Pop Registers ******/
-void ARM7::push_pop(u16 current_thumb_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::push_pop(u16 current_thumb_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab stack pointer from current CPU mode
-	u32 r13 = get_reg(13);
+	u32 r13 = derived().get_reg(13);
 
 	//Grab link register from current CPU mode
-	u32 lr = get_reg(14);
+	u32 lr = derived().get_reg(14);
 
 	//Grab register list - Bits 0-7
 	u8 r_list = (current_thumb_instruction & 0xFF);
@@ -1136,17 +1138,17 @@ void ARM7::push_pop(u16 current_thumb_instruction)
 		//PUSH
 		case 0x0:
 			//Clock CPU and controllers - 1N
-			clock(reg.r15, true);
+			derived().clock(reg.r15, CODE_N16);
 
 			//Optionally store LR onto the stack
 			if(pc_lr_bit) 
 			{
 				r13 -= 4;
-				mem_check_32(r13, lr, false);
-				set_reg(14, lr);  
+				derived().mem_check_32(r13, lr, false);
+				derived().set_reg(14, lr);  
 
 				//Clock CPU and controllers - 1S
-				clock(r13, false);
+				derived().clock(r13, DATA_S32);
 			}
 
 			//Cycle through the register list
@@ -1155,14 +1157,14 @@ void ARM7::push_pop(u16 current_thumb_instruction)
 				if(r_list & (1 << x))
 				{
 					r13 -= 4;
-					u32 push_value = get_reg(x);
-					mem_check_32(r13, push_value, false);
+					u32 push_value = derived().get_reg(x);
+					derived().mem_check_32(r13, push_value, false);
 
 					//Clock CPU and controllers - (n)S
-					if((n_count - 1) != 0) { clock(r13, false); n_count--; }
+					if((n_count - 1) != 0) { derived().clock(r13, DATA_S32); n_count--; }
 
 					//Clock CPU and controllers - 1N
-					else { clock(r13, true); x = 10; break; }
+					else { derived().clock(r13, DATA_N32); x = 10; break; }
 				}
 			}
 
@@ -1171,7 +1173,7 @@ void ARM7::push_pop(u16 current_thumb_instruction)
 		//POP
 		case 0x1:
 			//Clock CPU and controllers - 1N
-			clock(reg.r15, true);
+			derived().clock(reg.r15, CODE_N16);
 			
 			//Cycle through the register list
 			for(int x = 0; x < 8; x++)
@@ -1179,12 +1181,12 @@ void ARM7::push_pop(u16 current_thumb_instruction)
 				if(r_list & 0x1)
 				{
 					u32 pop_value = 0;
-					mem_check_32(r13, pop_value, true);
-					set_reg(x, pop_value);
+					derived().mem_check_32(r13, pop_value, true);
+					derived().set_reg(x, pop_value);
 					r13 += 4;
 
 					//Clock CPU and controllers - (n)S
-					if(n_count > 1) { clock(r13, false); }
+					if(n_count > 1) { derived().clock(r13, DATA_S32); }
 				}
 
 				r_list >>= 1;
@@ -1194,41 +1196,52 @@ void ARM7::push_pop(u16 current_thumb_instruction)
 			if(pc_lr_bit) 
 			{
 				//Clock CPU and controllers - 1I
-				clock();
+				derived().clock();
 
 				//Clock CPU and controllers - 1N
-				clock(reg.r15, true);
+				derived().clock(r13, DATA_N32);
 
 				//Clock CPU and controllers - 2S
-				mem_check_32(r13, reg.r15, true);
+				derived().mem_check_32(r13, reg.r15, true);
+
+				//ARMv5 - Switch to ARM when Bit 0 of the new PC is unset
+				if((cpu_traits::armv5te) && ((reg.r15 & 0x1) == 0))
+				{
+					derived().arm_mode = cpu_type::ARM;
+					reg.cpsr &= ~0x20;
+				}
+
 				reg.r15 &= ~0x1;
 				r13 += 4;
-				needs_flush = true;
+				derived().needs_flush = true;
 
-				clock(reg.r15, false);
-				clock((reg.r15 + 2), false); 
+				derived().clock(reg.r15, CODE_S16);
+				derived().clock((reg.r15 + 2), CODE_S16); 
 			}
 
 			//If PC not loaded, last cycles are Internal then Sequential
 			else
 			{
 				//Clock CPU and controllers - 1I
-				clock();
+				derived().clock();
 
 				//Clock CPU and controllers - 1S
-				clock((reg.r15 + 2), false);
+				derived().clock((reg.r15 + 2), CODE_S16);
 			}
 
 			break;
 	}
 
 	//Update stack pointer for current CPU mode
-	set_reg(13, r13);
+	derived().set_reg(13, r13);
 }
 
 /****** THUMB.15 Multiple Load-Store ******/
-void ARM7::multiple_load_store(u16 current_thumb_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::multiple_load_store(u16 current_thumb_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab register list - Bits 0-7
 	u8 r_list = (current_thumb_instruction & 0xFF);
 
@@ -1238,7 +1251,7 @@ void ARM7::multiple_load_store(u16 current_thumb_instruction)
 	//Grab opcode - Bit 11
 	u8 op = (current_thumb_instruction & 0x800) ? 1 : 0;
 
-	u32 base_addr = get_reg(base_reg) & ~0x3;
+	u32 base_addr = derived().get_reg(base_reg) & ~0x3;
 	u32 reg_value = 0;
 	u8 n_count = 0;
 
@@ -1273,27 +1286,27 @@ void ARM7::multiple_load_store(u16 current_thumb_instruction)
 			if(r_list != 0)
 			{
 				//Clock CPU and controllers - 1N
-				clock(reg.r15, true);
+				derived().clock(reg.r15, CODE_N16);
 
 				//Cycle through the register list
 				for(int x = 0; x < 8; x++)
 				{
 					if(r_list & 0x1)
 					{
-						reg_value = get_reg(x);
+						reg_value = derived().get_reg(x);
 
-						if((x == transfer_reg) && (base_reg == transfer_reg)) { mem_check_32(base_addr, old_base, false); }
-						else { mem_check_32(base_addr, reg_value, false); }
+						if((x == transfer_reg) && (base_reg == transfer_reg)) { derived().mem_check_32(base_addr, old_base, false); }
+						else { derived().mem_check_32(base_addr, reg_value, false); }
 
 						//Update base register
 						base_addr += 4;
-						set_reg(base_reg, base_addr);
+						derived().set_reg(base_reg, base_addr);
 
 						//Clock CPU and controllers - (n)S
-						if((n_count - 1) != 0) { clock(base_addr, false); n_count--; }
+						if((n_count - 1) != 0) { derived().clock(base_addr, DATA_S32); n_count--; }
 
 						//Clock CPU and controllers - 1N
-						else { clock(base_addr, true); x = 10; break; }
+						else { derived().clock(base_addr, DATA_N32); x = 10; break; }
 					}
 
 					r_list >>= 1;
@@ -1304,9 +1317,9 @@ void ARM7::multiple_load_store(u16 current_thumb_instruction)
 			else
 			{
 				//Store PC, then add 0x40 to base register
-				mem_check_32(base_addr, reg.r15, false);
+				derived().mem_check_32(base_addr, reg.r15, false);
 				base_addr += 0x40;
-				set_reg(base_reg, base_addr);
+				derived().set_reg(base_reg, base_addr);
 
 				//Clock CPU and controllers - ???
 				//TODO - find out what to do here...
@@ -1320,7 +1333,7 @@ void ARM7::multiple_load_store(u16 current_thumb_instruction)
 			if(r_list != 0)
 			{
 				//Clock CPU and controllers - 1N
-				clock(reg.r15, true);
+				derived().clock(reg.r15, CODE_N16);
 
 				//Cycle through the register list
 				for(int x = 0; x < 8; x++)
@@ -1329,34 +1342,34 @@ void ARM7::multiple_load_store(u16 current_thumb_instruction)
 					{
 						if((x == transfer_reg) && (base_reg == transfer_reg)) { write_back = false; }
 
-						mem_check_32(base_addr, reg_value, true);
-						set_reg(x, reg_value);
+						derived().mem_check_32(base_addr, reg_value, true);
+						derived().set_reg(x, reg_value);
 
 						//Update base register
 						base_addr += 4;
-						if(write_back) { set_reg(base_reg, base_addr); }
+						if(write_back) { derived().set_reg(base_reg, base_addr); }
 
 						//Clock CPU and controllers - (n)S
-						if(n_count > 1) { clock(base_addr, false); }
+						if(n_count > 1) { derived().clock(base_addr, DATA_S32); }
 					}
 
 					r_list >>= 1;
 				}
 
 				//Clock CPU and controllers - 1I
-				clock();
+				derived().clock();
 
 				//Clock CPU and controllers - 1S
-				clock((reg.r15 + 2), false);
+				derived().clock((reg.r15 + 2), CODE_S16);
 			}
 
 			//Special case with empty list
 			else
 			{
 				//Load PC, then add 0x40 to base register
-				mem_check_32(base_addr, reg.r15, true);
+				derived().mem_check_32(base_addr, reg.r15, true);
 				base_addr += 0x40;
-				set_reg(base_reg, base_addr);
+				derived().set_reg(base_reg, base_addr);
 
 				//Clock CPU and controllers - ???
 				//TODO - find out what to do here...
@@ -1367,8 +1380,11 @@ void ARM7::multiple_load_store(u16 current_thumb_instruction)
 }
 						
 /****** THUMB.16 Conditional Branch ******/
-void ARM7::conditional_branch(u16 current_thumb_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::conditional_branch(u16 current_thumb_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab 8-bit offset - Bits 0-7
 	u8 offset = (current_thumb_instruction & 0xFF);
 
@@ -1389,57 +1405,60 @@ void ARM7::conditional_branch(u16 current_thumb_instruction)
 
 	else { jump_addr = (offset * 2); }
 
+	//Bring the condition codes up to date before checking them
+	update_flags();
+
 	//Jump based on condition codes
 	switch(op)
 	{
 		//BEQ
 		case 0x0:
-			if(reg.cpsr & CPSR_Z_FLAG) { needs_flush = true; }
+			if(reg.cpsr & CPSR_Z_FLAG) { derived().needs_flush = true; }
 			break;
 
 		//BNE
 		case 0x1:
-			if((reg.cpsr & CPSR_Z_FLAG) == 0) { needs_flush = true; }
+			if((reg.cpsr & CPSR_Z_FLAG) == 0) { derived().needs_flush = true; }
 			break;
 
 		//BCS
 		case 0x2:
-			if(reg.cpsr & CPSR_C_FLAG) { needs_flush = true; }
+			if(reg.cpsr & CPSR_C_FLAG) { derived().needs_flush = true; }
 			break;
 
 		//BCC
 		case 0x3:
-			if((reg.cpsr & CPSR_C_FLAG) == 0) { needs_flush = true; }
+			if((reg.cpsr & CPSR_C_FLAG) == 0) { derived().needs_flush = true; }
 			break;
 
 		//BMI
 		case 0x4:
-			if(reg.cpsr & CPSR_N_FLAG) { needs_flush = true; }
+			if(reg.cpsr & CPSR_N_FLAG) { derived().needs_flush = true; }
 			break;
 
 		//BPL
 		case 0x5:
-			if((reg.cpsr & CPSR_N_FLAG) == 0) { needs_flush = true; }
+			if((reg.cpsr & CPSR_N_FLAG) == 0) { derived().needs_flush = true; }
 			break;
 
 		//BVS
 		case 0x6:
-			if(reg.cpsr & CPSR_V_FLAG) { needs_flush = true; }
+			if(reg.cpsr & CPSR_V_FLAG) { derived().needs_flush = true; }
 			break;
 
 		//BVC
 		case 0x7:
-			if((reg.cpsr & CPSR_V_FLAG) == 0) { needs_flush = true; }
+			if((reg.cpsr & CPSR_V_FLAG) == 0) { derived().needs_flush = true; }
 			break;
 
 		//BHI
 		case 0x8:
-			if((reg.cpsr & CPSR_C_FLAG) && ((reg.cpsr & CPSR_Z_FLAG) == 0)) { needs_flush = true; }
+			if((reg.cpsr & CPSR_C_FLAG) && ((reg.cpsr & CPSR_Z_FLAG) == 0)) { derived().needs_flush = true; }
 			break;
 
 		//BLS
 		case 0x9:
-			if((reg.cpsr & CPSR_Z_FLAG) || ((reg.cpsr & CPSR_C_FLAG) == 0)) { needs_flush = true; }
+			if((reg.cpsr & CPSR_Z_FLAG) || ((reg.cpsr & CPSR_C_FLAG) == 0)) { derived().needs_flush = true; }
 			break;
 
 		//BGE
@@ -1448,7 +1467,7 @@ void ARM7::conditional_branch(u16 current_thumb_instruction)
 				u8 n = (reg.cpsr & CPSR_N_FLAG) ? 1 : 0;
 				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
 
-				if(n == v) { needs_flush = true; }
+				if(n == v) { derived().needs_flush = true; }
 			}
 			
 			break;
@@ -1459,7 +1478,7 @@ void ARM7::conditional_branch(u16 current_thumb_instruction)
 				u8 n = (reg.cpsr & CPSR_N_FLAG) ? 1 : 0;
 				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
 
-				if(n != v) { needs_flush = true; }
+				if(n != v) { derived().needs_flush = true; }
 			}
 	
 			break;
@@ -1471,7 +1490,7 @@ void ARM7::conditional_branch(u16 current_thumb_instruction)
 				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
 				u8 z = (reg.cpsr & CPSR_Z_FLAG) ? 1 : 0;
 
-				if((z == 0) && (n == v)) { needs_flush = true; }
+				if((z == 0) && (n == v)) { derived().needs_flush = true; }
 			}
 
 			break;
@@ -1483,47 +1502,58 @@ void ARM7::conditional_branch(u16 current_thumb_instruction)
 				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
 				u8 z = (reg.cpsr & CPSR_Z_FLAG) ? 1 : 0;
 
-				if((z == 1) || (n != v)) { needs_flush = true; }
+				if((z == 1) || (n != v)) { derived().needs_flush = true; }
 			}
 
 			break;
 
 		//Undefined
 		case 0xE:
-			std::cout<<"CPU::Error - THUMB.16 Undefined opcode 0xE \n";
-			running = false;
+			std::cout<<cpu_traits::log_name<<"::Error - THUMB.16 Undefined opcode 0xE \n";
+			derived().running = false;
 			break;
 
 		//SWI
 		case 0xF:
 			//Process SWIs via HLE
 			//TODO: Make and LLE version
-			process_swi((current_thumb_instruction & 0xFF));
-			if(config::use_bios) { return; }
+			derived().process_swi((current_thumb_instruction & 0xFF));
+
+			//SWIs that jump elsewhere (BIOS SWIs, SoftReset, etc) are not branches
+			if(derived().needs_flush) { return; }
 			break;
 	}
 
-	if(needs_flush)
+	if(derived().needs_flush)
 	{
 		//Clock CPU and controllers - 1N
-		clock(reg.r15, true);
+		derived().clock(reg.r15, CODE_N16);
 
 		//Clock CPU and controllers - 2S 
 		reg.r15 += jump_addr;  
-		clock(reg.r15, false);
-		clock((reg.r15 + 2), false);
+		derived().clock(reg.r15, CODE_S16);
+		derived().clock((reg.r15 + 2), CODE_S16);
+
+		//Watch for polling loops
+		if constexpr(cpu_traits::idle_loop_branches)
+		{
+			if((idle_loop_skip) && (op < 0xE)) { idle_loop_branch(reg.r15 - jump_addr - 4); }
+		}
 	}
 
 	else 
 	{
 		//Clock CPU and controllers - 1S
-		clock(reg.r15, false);
+		derived().clock(reg.r15, CODE_S16);
 	} 
 }
 
 /****** THUMB.18 Unconditional Branch ******/
-void ARM7::unconditional_branch(u16 current_thumb_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::unconditional_branch(u16 current_thumb_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Grab 11-bit offset - Bits 0-10
 	u16 offset = (current_thumb_instruction & 0x7FF);
 
@@ -1542,22 +1572,31 @@ void ARM7::unconditional_branch(u16 current_thumb_instruction)
 
 	else { jump_addr = (offset * 2); }
 
-	needs_flush = true;
+	derived().needs_flush = true;
 
 	//Clock CPU and controllers - 1N
-	clock(reg.r15, true);
+	derived().clock(reg.r15, CODE_N16);
 
 	//Clock CPU and controllers - 2S 
 	reg.r15 += jump_addr;  
-	clock(reg.r15, false);
-	clock((reg.r15 + 2), false);
+	derived().clock(reg.r15, CODE_S16);
+	derived().clock((reg.r15 + 2), CODE_S16);
+
+	//Watch for polling loops
+	if constexpr(cpu_traits::idle_loop_branches)
+	{
+		if(idle_loop_skip) { idle_loop_branch(reg.r15 - jump_addr - 4); }
+	}
 }
 
 /****** THUMB.19 Long Branch with Link ******/
-void ARM7::long_branch_link(u16 current_thumb_instruction)
+template<typename cpu_type, typename cpu_traits>
+void arm_interpreter<cpu_type, cpu_traits>::long_branch_link(u16 current_thumb_instruction)
 {
+	auto& reg = derived().reg;
+
 	//Determine if this is the first or second instruction executed
-	bool first_op = (((current_thumb_instruction >> 11) & 0x1F) == 0x1F) ? false : true;
+	bool first_op = (((current_thumb_instruction >> 11) & 0x1F) == 0x1E) ? true : false;
 
 	u32 lbl_addr = 0;
 
@@ -1574,10 +1613,10 @@ void ARM7::long_branch_link(u16 current_thumb_instruction)
 		lbl_addr += reg.r15;
 
 		//Save label to LR
-		set_reg(14, lbl_addr);
+		derived().set_reg(14, lbl_addr);
 
 		//Clock CPU and controllers - 1S
-		clock(reg.r15, false);
+		derived().clock(reg.r15, CODE_S16);
 	}
 
 	//Perform 2nd 16-bit operation
@@ -1588,20 +1627,35 @@ void ARM7::long_branch_link(u16 current_thumb_instruction)
 		next_instr_addr |= 1;
 
 		//Grab lower 11-bits of destination address
-		lbl_addr = get_reg(14);
+		lbl_addr = derived().get_reg(14);
 		lbl_addr += ((current_thumb_instruction & 0x7FF) << 1);
 
 		//Clock CPU and controllers - 1N
-		clock(reg.r15, true);
+		derived().clock(reg.r15, CODE_N16);
 
 		reg.r15 = lbl_addr;
 		reg.r15 &= ~0x1;
 
-		needs_flush = true;
-		set_reg(14, next_instr_addr);
+		derived().needs_flush = true;
+		derived().set_reg(14, next_instr_addr);
 
 		//Clock CPU and controllers - 2S
-		clock(reg.r15, false);
-		clock((reg.r15 + 2), false);
+		derived().clock(reg.r15, CODE_S16);
+		derived().clock((reg.r15 + 2), CODE_S16);
+
+		//ARMv5 - BLX
+		if((cpu_traits::armv5te) && (((current_thumb_instruction >> 11) & 0x1F) == 0x1D))
+		{
+			derived().arm_mode = cpu_type::ARM;
+			reg.cpsr &= ~0x20;
+
+			//Auto-align destination to word
+			reg.r15 &= ~0x2;
+		}
 	}
+
+	//Interrupts wait until both halves have executed
+	if constexpr(cpu_traits::long_branch_holds_irq) { derived().thumb_long_branch = true; }
 }
+
+#endif // GBE_THUMB_INSTR
@@ -316,7 +316,7 @@ void DMG_core::run_core()
 					core_cpu.skip_instruction = false;
 
 					//Execute next opcode, but do not increment PC
-					core_cpu.opcode = core_mmu.read_u8(core_cpu.reg.pc);
+					core_cpu.opcode = core_mmu.fetch_u8(core_cpu.reg.pc);
 					core_cpu.exec_op(core_cpu.opcode);
 				}
 			}
@@ -324,7 +324,7 @@ void DMG_core::run_core()
 			//Process Opcodes
 			else 
 			{
-				core_cpu.opcode = core_mmu.read_u8(core_cpu.reg.pc++);
+				core_cpu.opcode = core_mmu.fetch_u8(core_cpu.reg.pc++);
 				core_cpu.exec_op(core_cpu.opcode);
 			}
 
@@ -597,7 +597,7 @@ void DMG_core::step()
 				core_cpu.skip_instruction = false;
 
 				//Execute next opcode, but do not increment PC
-				core_cpu.opcode = core_mmu.read_u8(core_cpu.reg.pc);
+				core_cpu.opcode = core_mmu.fetch_u8(core_cpu.reg.pc);
 				core_cpu.exec_op(core_cpu.opcode);
 			}
 		}
@@ -605,7 +605,7 @@ void DMG_core::step()
 		//Process Opcodes
 		else 
 		{
-			core_cpu.opcode = core_mmu.read_u8(core_cpu.reg.pc++);
+			core_cpu.opcode = core_mmu.fetch_u8(core_cpu.reg.pc++);
 			core_cpu.exec_op(core_cpu.opcode);
 		}
 
@@ -1182,7 +1182,7 @@ u32 DMG_core::ex_get_reg(u8 reg_index)
 		case 0x4: return core_cpu.reg.e;
 		case 0x5: return core_cpu.reg.h;
 		case 0x6: return core_cpu.reg.l;
-		case 0x7: return core_cpu.reg.f;
+		case 0x7: return core_cpu.get_flags();
 		case 0x8: return core_cpu.reg.sp;
 		case 0x9: return core_cpu.reg.pc;
 		default: return 0;
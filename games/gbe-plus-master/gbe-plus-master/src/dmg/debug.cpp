@@ -199,23 +199,25 @@ void DMG_core::debug_display() const
 
 	std::string flag_stats = "(";
 
-	if(core_cpu.reg.f & 0x80) { flag_stats += "Z"; }
+	u8 flags = core_cpu.get_flags();
+
+	if(flags & 0x80) { flag_stats += "Z"; }
 	else { flag_stats += "."; }
 
-	if(core_cpu.reg.f & 0x40) { flag_stats += "N"; }
+	if(flags & 0x40) { flag_stats += "N"; }
 	else { flag_stats += "."; }
 
-	if(core_cpu.reg.f & 0x20) { flag_stats += "H"; }
+	if(flags & 0x20) { flag_stats += "H"; }
 	else { flag_stats += "."; }
 
-	if(core_cpu.reg.f & 0x10) { flag_stats += "C"; }
+	if(flags & 0x10) { flag_stats += "C"; }
 	else { flag_stats += "."; }
 
 	flag_stats += ")";
 
 	std::string ime_status = (core_cpu.interrupt) ? "IME = ON" : "IME = OFF";
 
-	std::cout<< std::hex <<"FLAGS : 0x" << std::setw(2) << std::setfill('0') << (u32)core_cpu.reg.f << "\t" << flag_stats  << "\t" << ime_status << "\n";
+	std::cout<< std::hex <<"FLAGS : 0x" << std::setw(2) << std::setfill('0') << (u32)flags << "\t" << flag_stats  << "\t" << ime_status << "\n";
 
 	if(db_unit.display_cycles) { std::cout<<"CYCLES : " << std::dec << core_cpu.debug_cycles << "\n"; }
 
@@ -602,6 +604,7 @@ void DMG_core::debug_process_command()
 					case 0x7:
 						std::cout<<"\nSetting Register F to 0x" << std::hex << reg_value << "\n";
 						core_cpu.reg.f = reg_value;
+						core_cpu.flag_op = Z80_FLAGS_NONE;
 						break;
 
 					case 0x8:
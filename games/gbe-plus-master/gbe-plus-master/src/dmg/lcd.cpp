@@ -623,18 +623,15 @@ void DMG_LCD::render_gbc_bg_scanline()
 	for(int x = tile_lower_range; x < tile_upper_range; x++)
 	{
 		//Always read CHR data from Bank 0
-		u8 old_vram_bank = mem->vram_bank;
-		mem->vram_bank = 0;
-
-		u8 map_entry = mem->read_u8(lcd_stat.bg_map_addr + x);
+		u16 map_addr = lcd_stat.bg_map_addr + x - 0x8000;
+		u8 map_entry = mem->video_ram[0][map_addr];
 		u8 tile_pixel = 0;
 
 		//Read BG Map attributes from Bank 1
-		mem->vram_bank = 1;
-		u8 bg_map_attribute = mem->read_u8(lcd_stat.bg_map_addr + x);
+		u8 bg_map_attribute = mem->video_ram[1][map_addr];
 		u8 bg_palette = bg_map_attribute & 0x7;
 		u8 bg_priority = (bg_map_attribute & 0x80) ? 1 : 0;
-		mem->vram_bank = (bg_map_attribute & 0x8) ? 1 : 0;
+		u8 tile_bank = (bg_map_attribute & 0x8) ? 1 : 0;
 
 		//Determine which line of the tiles to generate pixels for this scanline
 		u8 tile_line = rendered_scanline % 8;
@@ -647,8 +644,7 @@ void DMG_LCD::render_gbc_bg_scanline()
 		u16 tile_addr = (lcd_stat.bg_tile_addr + (map_entry << 4) + (tile_line << 1));
 
 		//Grab bytes from VRAM representing 8x1 pixel data
-		u16 tile_data = mem->read_u16(tile_addr);
-		mem->vram_bank = old_vram_bank;
+		u16 tile_data = (mem->video_ram[tile_bank][tile_addr - 0x8000 + 1] << 8) | mem->video_ram[tile_bank][tile_addr - 0x8000];
 
 		for(int y = 7; y >= 0; y--)
 		{
@@ -769,18 +765,15 @@ void DMG_LCD::render_gbc_win_scanline()
 	for(int x = tile_lower_range; x < tile_upper_range; x++)
 	{
 		//Always read CHR data from Bank 0
-		u8 old_vram_bank = mem->vram_bank;
-		mem->vram_bank = 0;
-
-		u8 map_entry = mem->read_u8(lcd_stat.window_map_addr + x);
+		u16 map_addr = lcd_stat.window_map_addr + x - 0x8000;
+		u8 map_entry = mem->video_ram[0][map_addr];
 		u8 tile_pixel = 0;
 
 		//Read BG Map attributes from Bank 1
-		mem->vram_bank = 1;
-		u8 bg_map_attribute = mem->read_u8(lcd_stat.window_map_addr + x);
+		u8 bg_map_attribute = mem->video_ram[1][map_addr];
 		u8 bg_palette = bg_map_attribute & 0x7;
 		u8 bg_priority = (bg_map_attribute & 0x80) ? 1 : 0;
-		mem->vram_bank = (bg_map_attribute & 0x8) ? 1 : 0;
+		u8 tile_bank = (bg_map_attribute & 0x8) ? 1 : 0;
 
 		//Determine which line of the tiles to generate pixels for this scanline
 		u8 tile_line = rendered_scanline % 8;
@@ -793,8 +786,7 @@ void DMG_LCD::render_gbc_win_scanline()
 		u16 tile_addr = (lcd_stat.bg_tile_addr + (map_entry << 4) + (tile_line << 1));
 
 		//Grab bytes from VRAM representing 8x1 pixel data
-		u16 tile_data = mem->read_u16(tile_addr);
-		mem->vram_bank = old_vram_bank;
+		u16 tile_data = (mem->video_ram[tile_bank][tile_addr - 0x8000 + 1] << 8) | mem->video_ram[tile_bank][tile_addr - 0x8000];
 
 		for(int y = 7; y >= 0; y--)
 		{
@@ -932,10 +924,8 @@ void DMG_LCD::render_gbc_obj_scanline()
 		u16 tile_addr = (0x8000 + (obj[sprite_id].tile_number << 4) + (tile_line << 1));
 
 		//Grab bytes from VRAM representing 8x1 pixel data
-		u8 old_vram_bank = mem->vram_bank;
-		mem->vram_bank = obj[sprite_id].vram_bank;
-		u16 tile_data = mem->read_u16(tile_addr);
-		mem->vram_bank = old_vram_bank;
+		u8 tile_bank = obj[sprite_id].vram_bank;
+		u16 tile_data = (mem->video_ram[tile_bank][tile_addr - 0x8000 + 1] << 8) | mem->video_ram[tile_bank][tile_addr - 0x8000];
 
 		for(int y = 7; y >= 0; y--)
 		{
@@ -59,6 +59,9 @@ void DMG_MMU::reset()
 	bank_mode = 0;
 	ram_banking_enabled = false;
 
+	for(u32 x = 0; x < 16; x++) { read_page[x] = NULL; }
+	read_page_valid = false;
+
 	in_bios = config::use_bios;
 	bios_type = 1;
 	bios_size = 0x100;
@@ -198,6 +201,8 @@ bool DMG_MMU::mmu_read(u32 offset, std::string filename)
 	file.read((char*)&in_bios, sizeof(in_bios));
 	file.read((char*)&bios_type, sizeof(bios_type));
 	file.read((char*)&bios_size, sizeof(bios_size));
+
+	read_page_valid = false;
 	file.read((char*)&cart, sizeof(cart));
 	file.read((char*)&previous_value, sizeof(previous_value));
 
@@ -278,6 +283,12 @@ u8 DMG_MMU::read_u8(u16 address)
 	debug_addr = address;
 	#endif
 
+	//Read straight from the current banks when possible
+	if(!read_page_valid) { update_read_pages(); }
+
+	u8* page = read_page[address >> 12];
+	if(page != NULL) { return page[address & 0xFFF]; }
+
 	//Read from BIOS
 	if(in_bios)
 	{
@@ -289,6 +300,7 @@ u8 DMG_MMU::read_u8(u16 address)
 		else if(address == 0x100) 
 		{ 
 			in_bios = false; 
+			read_page_valid = false;
 			std::cout<<"MMU::Exiting BIOS \n";
 
 			//For DMG on GBC games, we switch back to DMG Mode (we just take the colors the BIOS gives us)
@@ -413,6 +425,220 @@ u16 DMG_MMU::read_u16(u16 address)
 	return (read_u8(address+1) << 8) | read_u8(address);
 }
 
+/****** Read opcode or operand byte from memory ******/
+u8 DMG_MMU::fetch_u8(u16 address)
+{
+	//Read straight from the current banks when possible
+	if(!read_page_valid) { update_read_pages(); }
+
+	u8* page = read_page[address >> 12];
+		
+	if(page != NULL)
+	{
+		//Advanced debugging
+		#ifdef GBE_DEBUG
+		debug_read = true;
+		debug_addr = address;
+		#endif
+
+		return page[address & 0xFFF];
+	}
+
+	return read_u8(address);
+}
+
+/****** Read opcode or operand word from memory ******/
+u16 DMG_MMU::fetch_u16(u16 address)
+{
+	return (fetch_u8(address+1) << 8) | fetch_u8(address);
+}
+
+/****** Updates direct pointers to each 4KB page of memory for the current banks ******/
+void DMG_MMU::update_read_pages()
+{
+	read_page_valid = true;
+
+	//ROM, cartridge RAM, and MBC RAM banks, NULL for anything that has to go through the MBC
+	//Negative bank IDs mean the bank is not in read_only_bank or random_access_bank
+	u8* rom_lo = NULL;
+	u8* rom_hi = NULL;
+	u8* ram = NULL;
+
+	s32 rom_lo_id = -1;
+	s32 rom_hi_id = -1;
+	s32 ram_id = -1;
+
+	//Bank 0 is only remapped by multicarts
+	if(!cart.multicart) { rom_lo = &memory_map[0]; }
+
+	//Without cartridge RAM, 0xA000 - 0xBFFF reads the memory map
+	if(((!cart.ram) && (cart.mbc_type != MBC7)) || (cart.mbc_type == ROM_ONLY)) { ram = &memory_map[0xA000]; }
+
+	switch(cart.mbc_type)
+	{
+		case ROM_ONLY:
+			rom_hi = &memory_map[0x4000];
+			break;
+
+		//Mirrors ROM and RAM banking in mbc1_read() and mbc1_multicart_read()
+		case MBC1:
+			if(cart.sonar) { break; }
+
+			else if(cart.multicart)
+			{
+				u8 bank = (bank_bits << 4);
+				if((bank_mode == 0) || (bank < 2)) { rom_lo = &memory_map[0]; }
+				else { rom_lo_id = bank - 2; }
+
+				bank = ((bank_bits << 4) | rom_bank);
+				if(bank == 0x20 || bank == 0x40 || bank == 0x60) { bank++; }
+				if(bank >= 2) { rom_hi_id = bank - 2; }
+				else { rom_hi = &memory_map[0x4000]; }
+
+				//MBC1M only accesses RAM Bank 0
+				if(ram_banking_enabled) { ram_id = 0; }
+				break;
+			}
+
+			else
+			{
+				u8 bank = ((bank_bits << 5) | rom_bank);
+				if(bank == 0x20 || bank == 0x40 || bank == 0x60) { bank++; }
+				if(bank_mode == 1) { bank &= 0x1F; }
+				if(memory_map[ROM_ROMSIZE] < 0x5) { bank &= 0x1F; }
+				if(bank >= 2) { rom_hi_id = bank - 2; }
+				else { rom_hi = &memory_map[0x4000]; }
+			}
+
+			if(ram_banking_enabled) { ram_id = (bank_mode == 0) ? 0 : bank_bits; }
+			break;
+
+		//MBC2 RAM is only 4-bit and stays with mbc2_read()
+		case MBC2:
+		case MBC7:
+		case HUC1:
+		case HUC3:
+		case TAMA5:
+			if(rom_bank >= 2) { rom_hi_id = rom_bank - 2; }
+			else { rom_hi = &memory_map[0x4000]; }
+			break;
+
+		case MBC3:
+			if(rom_bank >= 2) { rom_hi_id = rom_bank - 2; }
+			else { rom_hi = &memory_map[0x4000]; }
+
+			if((ram_banking_enabled) && (bank_bits <= 3) && (config::cart_type != DMG_MBC30)) { ram_id = bank_bits; }
+			else if((ram_banking_enabled) && (bank_bits < 8) && (config::cart_type == DMG_MBC30)) { ram_id = bank_bits; }
+			break;
+
+		case MBC5:
+			if(rom_bank >= 2) { rom_hi_id = rom_bank - 2; }
+			else { rom_hi = &memory_map[0x4000]; }
+			if(ram_banking_enabled) { ram_id = bank_bits; }
+			break;
+
+		case MMM01:
+			if(bank_mode == 0)
+			{
+				rom_lo = &memory_map[0];
+				rom_hi = &memory_map[0x4000];
+			}
+
+			else
+			{
+				u8 base_bank = (rom_bank >> 8) & 0xFF;
+				u8 ext_bank = rom_bank & 0xFF;
+
+				rom_lo_id = base_bank;
+				rom_hi_id = base_bank + ext_bank;
+			}
+
+			if(ram_banking_enabled) { ram_id = bank_bits; }
+			break;
+
+		//Bank 1 can map any of the 64 banks, including Bank 0
+		case GB_CAMERA:
+			if(rom_bank == 0) { rom_hi = &memory_map[0]; }
+			else if(rom_bank == 1) { rom_hi = &memory_map[0x4000]; }
+			else { rom_hi_id = rom_bank - 2; }
+
+			if(bank_bits != 0x10) { ram_id = bank_bits; }
+			break;
+
+		//MBC6 switches ROM and RAM in 8KB and 4KB halves, mirrors mbc6_read()
+		case MBC6:
+			for(u32 x = 0; x < 2; x++)
+			{
+				//FLASH reads go through mbc6_read()
+				if(cart.flash_cnt & (0x4 << x)) { continue; }
+
+				u8 bank = (x == 0) ? (rom_bank & 0x7F) : ((rom_bank >> 8) & 0x7F);
+				u8 real_bank = (bank >> 1);
+				u8* half = NULL;
+
+				if(bank < 4) { half = &memory_map[bank * 0x2000]; }
+				else if((u32)(real_bank - 2) < read_only_bank.size()) { half = &read_only_bank[real_bank - 2][(bank & 0x1) ? 0x2000 : 0]; }
+
+				read_page[0x4 + (x * 2)] = half;
+				read_page[0x5 + (x * 2)] = (half == NULL) ? NULL : half + 0x1000;
+			}
+
+			if((cart.ram) && (ram_banking_enabled))
+			{
+				u8 bank_0 = (bank_bits & 0x7);
+				u8 bank_1 = ((bank_bits >> 4) & 0x7);
+
+				if(bank_0 < random_access_bank.size()) { read_page[0xA] = &random_access_bank[bank_0][0]; }
+				if(bank_1 < random_access_bank.size()) { read_page[0xB] = &random_access_bank[bank_1][0]; }
+			}
+
+			break;
+
+		default:
+			break;
+	}
+
+	if((rom_lo_id >= 0) && (rom_lo_id < (s32)read_only_bank.size())) { rom_lo = &read_only_bank[rom_lo_id][0]; }
+	if((rom_hi_id >= 0) && (rom_hi_id < (s32)read_only_bank.size())) { rom_hi = &read_only_bank[rom_hi_id][0]; }
+	if((cart.ram) && (ram_id >= 0) && (ram_id < (s32)random_access_bank.size())) { ram = &random_access_bank[ram_id][0]; }
+
+	//BIOS overlays the start of Bank 0 and unmaps itself at 0x100
+	read_page[0x0] = ((in_bios) || (rom_lo == NULL)) ? NULL : rom_lo;
+	read_page[0x1] = (rom_lo == NULL) ? NULL : rom_lo + 0x1000;
+	read_page[0x2] = (rom_lo == NULL) ? NULL : rom_lo + 0x2000;
+	read_page[0x3] = (rom_lo == NULL) ? NULL : rom_lo + 0x3000;
+
+	if(cart.mbc_type != MBC6)
+	{
+		read_page[0x4] = (rom_hi == NULL) ? NULL : rom_hi;
+		read_page[0x5] = (rom_hi == NULL) ? NULL : rom_hi + 0x1000;
+		read_page[0x6] = (rom_hi == NULL) ? NULL : rom_hi + 0x2000;
+		read_page[0x7] = (rom_hi == NULL) ? NULL : rom_hi + 0x3000;
+
+		read_page[0xA] = (ram == NULL) ? NULL : ram;
+		read_page[0xB] = (ram == NULL) ? NULL : ram + 0x1000;
+	}
+
+	else if(ram != NULL)
+	{
+		read_page[0xA] = ram;
+		read_page[0xB] = ram + 0x1000;
+	}
+
+	//VRAM and WRAM, GBC uses banking
+	u8 vram_id = ((vram_bank == 1) && (config::gb_type == 2)) ? 1 : 0;
+
+	read_page[0x8] = &video_ram[vram_id][0];
+	read_page[0x9] = &video_ram[vram_id][0x1000];
+
+	read_page[0xC] = (config::gb_type == 2) ? &working_ram_bank[0][0] : &memory_map[0xC000];
+	read_page[0xD] = (config::gb_type == 2) ? &working_ram_bank[wram_bank][0] : &memory_map[0xD000];
+	read_page[0xE] = &memory_map[0xE000];
+
+	//OAM and I/O always go through read_u8()
+	read_page[0xF] = NULL;
+}
+
 /****** Write Byte To Memory ******/
 void DMG_MMU::write_u8(u16 address, u8 value) 
 {
@@ -422,6 +648,10 @@ void DMG_MMU::write_u8(u16 address, u8 value)
 	debug_addr = address;
 	#endif
 
+	//Any write to the MBC registers may remap the ROM and RAM banks, TAMA5 selects ROM banks through 0xA000 - 0xA001
+	if(address <= 0x7FFF) { read_page_valid = false; }
+	else if((cart.mbc_type == TAMA5) && (address >= 0xA000) && (address <= 0xBFFF)) { read_page_valid = false; }
+
 	if(cart.mbc_type != ROM_ONLY) 
 	{
 		mbc_write(address, value);
@@ -1268,6 +1498,7 @@ void DMG_MMU::write_u8(u16 address, u8 value)
 	else if(address == REG_VBK) 
 	{ 
 		vram_bank = value & 0x1; 
+		read_page_valid = false;
 		memory_map[address] = (config::gb_type < 2) ? 0xFF : (value & 0x1); 
 	}
 
@@ -1298,6 +1529,7 @@ void DMG_MMU::write_u8(u16 address, u8 value)
 	{
 		wram_bank = (value & 0x7);
 		if(wram_bank == 0) { wram_bank = 1; }
+		read_page_valid = false;
 		memory_map[address] = (config::gb_type < 2) ? 0xFF : (value & 0x7);
 	}
 
@@ -2099,6 +2331,9 @@ bool DMG_MMU::read_file(std::string filename)
 		memory_map[REG_RP] = 0x3E;
 	}
 
+	//Cartridge type is now known, rebuild direct reads on next access
+	read_page_valid = false;
+
 	//Load backup save data if applicable
         load_backup(config::save_file);
 
@@ -2602,6 +2837,7 @@ void DMG_MMU::gb_mem_format_save(std::string filename)
 	random_access_bank.clear();
 	random_access_bank.resize(0x10);
 	for(int x = 0; x < 0x10; x++) { random_access_bank[x].resize(0x2000, 0); }
+	read_page_valid = false;
 
 	if(temp_file.is_open())
 	{
@@ -67,6 +67,10 @@ class DMG_MMU
 	u8 bank_mode;
 	bool ram_banking_enabled;
 
+	//Direct pointers to each 4KB page of memory for the current banks, NULL if reads need the full handler
+	u8* read_page[16];
+	bool read_page_valid;
+
 	//BIOS controls
 	bool in_bios;
 	u8 bios_type;
@@ -163,6 +167,10 @@ class DMG_MMU
 	u16 read_u16(u16 address);
 	s8 read_s8(u16 address);
 
+	u8 fetch_u8(u16 address);
+	u16 fetch_u16(u16 address);
+	void update_read_pages();
+
 	void write_u8(u16 address, u8 value);
 	void write_u16(u16 address, u16 value);
 
@@ -39,6 +39,7 @@ void Z80::reset()
 	reg.sp = 0xFFFE;
 	temp_byte = 0;
 	temp_word = 0;
+	flag_op = Z80_FLAGS_NONE;
 	cpu_clock_m = 0;
 	cpu_clock_t = 0;
 	div_counter = 0;
@@ -74,6 +75,7 @@ void Z80::reset_bios()
 	reg.sp = 0x0000;
 	temp_byte = 0;
 	temp_word = 0;
+	flag_op = Z80_FLAGS_NONE;
 	cpu_clock_m = 0;
 	cpu_clock_t = 0;
 	div_counter = 0;
@@ -113,6 +115,7 @@ bool Z80::cpu_read(u32 offset, std::string filename)
 	file.read((char*)&reg.h, sizeof(reg.h));
 	file.read((char*)&reg.l, sizeof(reg.l));
 	file.read((char*)&reg.f, sizeof(reg.f));
+	flag_op = Z80_FLAGS_NONE;
 	file.read((char*)&reg.pc, sizeof(reg.pc));
 	file.read((char*)&reg.sp, sizeof(reg.sp));
 
@@ -144,6 +147,9 @@ bool Z80::cpu_write(std::string filename)
 	
 	if(!file.is_open()) { return false; }
 
+	//Flags are saved as part of F
+	update_flags();
+
 	//Serialize CPU registers data to file stream
 	file.write((char*)&reg.a, sizeof(reg.a));
 	file.write((char*)&reg.b, sizeof(reg.b));
@@ -311,9 +317,95 @@ void Z80::jr(u8 reg_one)
 	else { reg.pc += reg_one; }
 }
 
+/****** Returns the F register with the last ALU operation applied ******/
+u8 Z80::get_flags() const
+{
+	u8 flags = reg.f;
+
+	switch(flag_op)
+	{
+		case Z80_FLAGS_ADD:
+			flags = 0;
+
+			//Carry
+			if(flag_input + flag_operand > 0xFF) { flags |= 0x10; }
+
+			//Half-Carry
+			if((flag_input & 0xF) + (flag_operand & 0xF) > 0xF) { flags |= 0x20; }
+
+			//Zero
+			if(flag_result == 0) { flags |= 0x80; }
+			break;
+
+		case Z80_FLAGS_SUB:
+			flags = 0x40;
+
+			//Carry
+			if(flag_input < flag_operand) { flags |= 0x10; }
+
+			//Half Carry
+			if((flag_input & 0xF) < (flag_operand & 0xF)) { flags |= 0x20; }
+
+			//Zero
+			if(flag_result == 0) { flags |= 0x80; }
+			break;
+
+		case Z80_FLAGS_AND:
+			flags = 0x20;
+
+			//Zero
+			if(flag_result == 0) { flags |= 0x80; }
+			break;
+
+		case Z80_FLAGS_OR:
+			flags = 0;
+
+			//Zero
+			if(flag_result == 0) { flags |= 0x80; }
+			break;
+
+		//INC and DEC leave Carry alone
+		case Z80_FLAGS_INC:
+			flags &= 0x10;
+
+			//Half Carry
+			if((flag_result & 0xF) == 0) { flags |= 0x20; }
+
+			//Zero
+			if(flag_result == 0) { flags |= 0x80; }
+			break;
+
+		case Z80_FLAGS_DEC:
+			flags &= 0x10;
+
+			//Subtract
+			flags |= 0x40;
+
+			//Half Carry
+			if((flag_result & 0xF) == 0xF) { flags |= 0x20; }
+
+			//Zero
+			if(flag_result == 0) { flags |= 0x80; }
+			break;
+	}
+
+	return flags;
+}
+
+/****** Updates the F register from the last ALU operation ******/
+void Z80::update_flags()
+{
+	if(flag_op == Z80_FLAGS_NONE) { return; }
+
+	reg.f = get_flags();
+	flag_op = Z80_FLAGS_NONE;
+}
+
 /****** Swaps nibbles ******/
 u8 Z80::swap(u8 reg_one)
 {
+	update_flags();
+
 	reg.f = 0;
 	u8 temp_one = (reg_one & 0xF) << 4;
 	u8 temp_two = (reg_one >> 4) & 0xF;
@@ -328,23 +420,19 @@ u8 Z80::swap(u8 reg_one)
 /****** 8-bit addition ******/
 u8 Z80::add_byte(u8 reg_one, u8 reg_two)
 {
-	reg.f = 0;
-
-	//Carry
-	if(reg_one + reg_two > 0xFF) { reg.f |= 0x10; }
+	flag_op = Z80_FLAGS_ADD;
+	flag_input = reg_one;
+	flag_operand = reg_two;
+	flag_result = reg_one + reg_two;
 
-	//Half-Carry
-	if((reg_one & 0xF) + (reg_two & 0xF) > 0xF) { reg.f |= 0x20; }
-
-	//Zero
-	if(u8(reg_one + reg_two) == 0) { reg.f |= 0x80; }
-
-	return reg_one + reg_two;
+	return flag_result;
 }
 
 /****** 8-bit addition - Carry ******/
 u8 Z80::add_carry(u8 reg_one, u8 reg_two)
 {
+	update_flags();
+
 	u8 carry_flag = (reg.f & 0x10) ? 1 : 0;
 	u8 carry_set = 0;
 	u8 half_carry_set = 0;
@@ -378,6 +466,8 @@ u8 Z80::add_carry(u8 reg_one, u8 reg_two)
 /****** 16-bit addition ******/
 u16 Z80::add_word(u16 reg_one, u16 reg_two)
 {
+	update_flags();
+
 	u8 zero_flag = (reg.f & 0x80) ? 1 : 0;
 	reg.f = 0;
 
@@ -396,6 +486,8 @@ u16 Z80::add_word(u16 reg_one, u16 reg_two)
 /****** 16-bit addition with signed byte ******/
 u16 Z80::add_signed_byte(u16 reg_one, u8 reg_two)
 {
+	update_flags();
+
 	s16 reg_two_bsx = (s16)((s8)reg_two);
 	u16 result = reg_one + reg_two_bsx;
 
@@ -413,26 +505,19 @@ u16 Z80::add_signed_byte(u16 reg_one, u8 reg_two)
 /****** 8-bit subtraction ******/
 u8 Z80::sub_byte(u8 reg_one, u8 reg_two)
 {
-	reg.f = 0;
-
-	//Carry
-	if(reg_one < reg_two) { reg.f |= 0x10; }
-
-	//Half Carry
-	if((reg_one & 0xF) < (reg_two & 0xF)) { reg.f |= 0x20; }
-
-	//Subtract
-	reg.f |= 0x40;
+	flag_op = Z80_FLAGS_SUB;
+	flag_input = reg_one;
+	flag_operand = reg_two;
+	flag_result = reg_one - reg_two;
 
-	//Zero
-	if(u8(reg_one - reg_two) == 0) { reg.f |= 0x80; }
-
-	return reg_one - reg_two;
+	return flag_result;
 }
 
 /****** 8-bit subtraction - Carry ******/
 u8 Z80::sub_carry(u8 reg_one, u8 reg_two)
 {
+	update_flags();
+
 	u8 carry_flag = (reg.f & 0x10) ? 1 : 0;
 	u8 carry_set = 0;
 	u8 half_carry_set = 0;
@@ -469,85 +554,59 @@ u8 Z80::sub_carry(u8 reg_one, u8 reg_two)
 /****** 8-bit AND ******/
 u8 Z80::and_byte(u8 reg_one, u8 reg_two)
 {
-	reg.f = 0;
-
-	//Half Carry
-	reg.f |= 0x20;
+	flag_op = Z80_FLAGS_AND;
+	flag_result = reg_one & reg_two;
 
-	//Zero
-	if((reg_one & reg_two) == 0) { reg.f |= 0x80; }
-
-	return reg_one & reg_two;
+	return flag_result;
 }
 
 /****** 8-bit OR ******/
 u8 Z80::or_byte(u8 reg_one, u8 reg_two)
 {
-	reg.f = 0;
+	flag_op = Z80_FLAGS_OR;
+	flag_result = reg_one | reg_two;
 
-	//Zero
-	if((reg_one | reg_two) == 0) { reg.f |= 0x80; }
-
-	return reg_one | reg_two;
+	return flag_result;
 }
 
 /****** 8-bit XOR ******/
 u8 Z80::xor_byte(u8 reg_one, u8 reg_two)
 {
-	reg.f = 0;
-	
-	//Zero
-	if((reg_one ^ reg_two) == 0) { reg.f |= 0x80; }
+	flag_op = Z80_FLAGS_OR;
+	flag_result = reg_one ^ reg_two;
 
-	return reg_one ^ reg_two;
+	return flag_result;
 }
 
 /****** 8-bit increment ******/
 u8 Z80::inc_byte(u8 reg_one)
 {
-	u8 carry_flag = (reg.f & 0x10) ? 1 : 0;
-	reg_one++;
+	//Carry is left alone, so it has to come from the last operation
+	update_flags();
 
-	reg.f = 0;
+	flag_op = Z80_FLAGS_INC;
+	flag_result = reg_one + 1;
 
-	//Carry
-	if(carry_flag == 1) { reg.f |= 0x10; }
-
-	//Half Carry
-	if((reg_one & 0xF) == 0) { reg.f |= 0x20; }
-
-	//Zero
-	if(reg_one == 0) { reg.f |= 0x80; }
-
-	return reg_one;
+	return flag_result;
 }
 
 /****** 8-bit decrement ******/
 u8 Z80::dec_byte(u8 reg_one)
 {
-	u8 carry_flag = (reg.f & 0x10) ? 1 : 0;
-	reg_one--;
-
-	reg.f = 0;
-
-	//Subtract
-	reg.f |= 0x40;
-
-	//Carry
-	if(carry_flag == 1) { reg.f |= 0x10; }
-
-	//Half Carry
-	if((reg_one & 0xF) == 0xF) { reg.f |= 0x20; }
+	//Carry is left alone, so it has to come from the last operation
+	update_flags();
 
-	//Zero
-	if(reg_one == 0) { reg.f |= 0x80; }
+	flag_op = Z80_FLAGS_DEC;
+	flag_result = reg_one - 1;
 
-	return reg_one;
+	return flag_result;
 }
 
 /****** Check bit ******/
 void Z80::bit(u8 reg_one, u8 check_bit)
 {
+	update_flags();
+
 	u8 carry_flag = (reg.f & 0x10) ? 1 : 0;
 	reg.f = 0;
 
@@ -578,6 +637,8 @@ u8 Z80::set(u8 reg_one, u8 set_bit)
 /****** Rotate byte left *****/
 u8 Z80::rotate_left(u8 reg_one)
 {
+	update_flags();
+
 	u8 old_carry = (reg.f & 0x10) ? 1 : 0;
 	reg.f = 0;
 	
@@ -596,6 +657,8 @@ u8 Z80::rotate_left(u8 reg_one)
 /****** Rotate byte left through carry *****/
 u8 Z80::rotate_left_carry(u8 reg_one)
 {
+	update_flags();
+
 	reg.f = 0;	
 
 	u8 carry_flag = (reg_one & 0x80) >> 7;
@@ -613,6 +676,8 @@ u8 Z80::rotate_left_carry(u8 reg_one)
 /****** Rotate byte right  ******/
 u8 Z80::rotate_right(u8 reg_one)
 {
+	update_flags();
+
 	u8 old_carry = (reg.f & 0x10) ? 1 : 0;
 	reg.f = 0;
 
@@ -631,6 +696,8 @@ u8 Z80::rotate_right(u8 reg_one)
 /****** Rotate byte right through carry ******/
 u8 Z80::rotate_right_carry(u8 reg_one)
 {
+	update_flags();
+
 	reg.f = 0;
 
 	//Store 1st bit in Carry Flag
@@ -649,6 +716,8 @@ u8 Z80::rotate_right_carry(u8 reg_one)
 /****** Shift byte left into carry - Preserve sign ******/
 u8 Z80::sla(u8 reg_one)
 {
+	update_flags();
+
 	reg.f = 0;
 	u8 carry_flag = (reg_one & 0x80) ? 1 : 0;
 	reg_one <<= 1;
@@ -665,6 +734,8 @@ u8 Z80::sla(u8 reg_one)
 /****** Shift byte right into carry - Preserve sign ******/
 u8 Z80::sra(u8 reg_one)
 {
+	update_flags();
+
 	reg.f = 0;
 	u8 carry_flag = (reg_one & 0x01) ? 1 : 0;
 	reg_one >>= 1;
@@ -682,6 +753,8 @@ u8 Z80::sra(u8 reg_one)
 /****** Shift byte right into carry ******/
 u8 Z80::srl(u8 reg_one)
 {
+	update_flags();
+
 	reg.f = 0;
 	u8 carry_flag = (reg_one & 0x01) ? 1 : 0;
 	reg_one >>= 1;
@@ -698,6 +771,8 @@ u8 Z80::srl(u8 reg_one)
 /****** Decimal adjust accumulator ******/
 u8 Z80::daa()
 {
+	update_flags();
+
 	u32 reg_one = reg.a;
 	
 	//Add or subtract correction values based on Subtract Flag
@@ -739,7 +814,7 @@ void Z80::exec_op(u8 opcode)
 
 		//LD BC, nn
 		case 0x01 :
-			reg.bc = mem->read_u16(reg.pc);
+			reg.bc = mem->fetch_u16(reg.pc);
 			reg.pc += 2;
 			cycles += 12;
 			break;
@@ -770,7 +845,7 @@ void Z80::exec_op(u8 opcode)
 
 		//LD B, n
 		case 0x06 :
-			reg.b = mem->read_u8(reg.pc++);
+			reg.b = mem->fetch_u8(reg.pc++);
 			cycles += 8;
 			break;
 
@@ -783,7 +858,7 @@ void Z80::exec_op(u8 opcode)
 
 		//LD nn, SP
 		case 0x08 :
-			mem->write_u16(mem->read_u16(reg.pc), reg.sp);
+			mem->write_u16(mem->fetch_u16(reg.pc), reg.sp);
 			reg.pc += 2;
 			cycles += 20;
 			break;
@@ -820,7 +895,7 @@ void Z80::exec_op(u8 opcode)
 
 		//LD C, n
 		case 0x0E :
-			reg.c = mem->read_u8(reg.pc++);
+			reg.c = mem->fetch_u8(reg.pc++);
 			cycles += 8;
 			break;
 
@@ -862,7 +937,7 @@ void Z80::exec_op(u8 opcode)
 
 		//LD DE, nn
 		case 0x11 :
-			reg.de = mem->read_u16(reg.pc);
+			reg.de = mem->fetch_u16(reg.pc);
 			reg.pc += 2;
 			cycles += 12;
 			break;
@@ -893,7 +968,7 @@ void Z80::exec_op(u8 opcode)
 
 		//LD D, n
 		case 0x16 :
-			reg.d = mem->read_u8(reg.pc++);
+			reg.d = mem->fetch_u8(reg.pc++);
 			cycles += 8;
 			break;
 
@@ -906,7 +981,7 @@ void Z80::exec_op(u8 opcode)
 
 		//JR, n
 		case 0x18 :
-			jr(mem->read_u8(reg.pc++));
+			jr(mem->fetch_u8(reg.pc++));
 			cycles += 12;
 			break;
 
@@ -942,7 +1017,7 @@ void Z80::exec_op(u8 opcode)
 
 		//LD E, n
 		case 0x1E :
-			reg.e = mem->read_u8(reg.pc++);
+			reg.e = mem->fetch_u8(reg.pc++);
 			cycles += 8;
 			break;
 
@@ -956,8 +1031,9 @@ void Z80::exec_op(u8 opcode)
 		//JR NZ, n
 		case 0x20 :	
 			{
+				update_flags();
 				u8 zero_flag = (reg.f & 0x80) ? 1 : 0;
-				if(zero_flag == 0) { jr(mem->read_u8(reg.pc)); cycles += 12; }
+				if(zero_flag == 0) { jr(mem->fetch_u8(reg.pc)); cycles += 12; }
 				else { cycles += 8; }
 				reg.pc++;
 			}
@@ -965,7 +1041,7 @@ void Z80::exec_op(u8 opcode)
 
 		//LD HL, nn
 		case 0x21 :
-			reg.hl = mem->read_u16(reg.pc);
+			reg.hl = mem->fetch_u16(reg.pc);
 			reg.pc+=2;
 			cycles += 12;
 			break;
@@ -997,7 +1073,7 @@ void Z80::exec_op(u8 opcode)
 
 		//LD H, n
 		case 0x26 : 
-			reg.h = mem->read_u8(reg.pc++);
+			reg.h = mem->fetch_u8(reg.pc++);
 			cycles += 8;
 			break;
 
@@ -1010,8 +1086,9 @@ void Z80::exec_op(u8 opcode)
 		//JR Z, n
 		case 0x28 :
 			{
+				update_flags();
 				u8 zero_flag = (reg.f & 0x80) ? 1 : 0;
-				if(zero_flag == 1) { jr(mem->read_u8(reg.pc)); cycles += 12; }
+				if(zero_flag == 1) { jr(mem->fetch_u8(reg.pc)); cycles += 12; }
 				else { cycles += 8; }
 				reg.pc++;
 			}
@@ -1050,13 +1127,14 @@ void Z80::exec_op(u8 opcode)
 
 		//LD L, n
 		case 0x2E :
-			reg.l = mem->read_u8(reg.pc++);
+			reg.l = mem->fetch_u8(reg.pc++);
 			cycles += 8;
 			break;
 
 		//CPL
 		case 0x2F :
 			reg.a = ~reg.a;
+			update_flags();
 			reg.f |= 0x60;
 			cycles += 4;
 			break;
@@ -1064,8 +1142,9 @@ void Z80::exec_op(u8 opcode)
 		//JR NC, n
 		case 0x30 :	
 			{
+				update_flags();
 				u8 carry_flag = (reg.f & 0x10) ? 1 : 0;
-				if(carry_flag == 0) { jr(mem->read_u8(reg.pc)); cycles += 12; }
+				if(carry_flag == 0) { jr(mem->fetch_u8(reg.pc)); cycles += 12; }
 				else { cycles += 8; }
 				reg.pc++;
 			}
@@ -1073,7 +1152,7 @@ void Z80::exec_op(u8 opcode)
 
 		//LD SP, nn
 		case 0x31 : 
-			reg.sp = mem->read_u16(reg.pc);
+			reg.sp = mem->fetch_u16(reg.pc);
 			reg.pc += 2;
 			cycles += 12;
 			break;
@@ -1108,13 +1187,14 @@ void Z80::exec_op(u8 opcode)
 
 		//LD HL, n
 		case 0x36 :
-			mem->write_u8(reg.hl, mem->read_u8(reg.pc++));
+			mem->write_u8(reg.hl, mem->fetch_u8(reg.pc++));
 			cycles += 12;
 			break;
 
 		//SCF
 		case 0x37 :
 			{
+				update_flags();
 				u8 zero_flag = (reg.f & 0x80) ? 1 : 0;
 				reg.f = 0;
 				if(zero_flag == 1) { reg.f |= 0x80; }
@@ -1126,8 +1206,9 @@ void Z80::exec_op(u8 opcode)
 		//JR C, n
 		case 0x38 :
 			{
+				update_flags();
 				u8 carry_flag = (reg.f & 0x10) ? 1 : 0;
-				if(carry_flag == 1) { jr(mem->read_u8(reg.pc)); cycles += 12; }
+				if(carry_flag == 1) { jr(mem->fetch_u8(reg.pc)); cycles += 12; }
 				else { cycles += 8; }
 				reg.pc++;
 			}
@@ -1166,13 +1247,14 @@ void Z80::exec_op(u8 opcode)
 
 		//LD A, n
 		case 0x3E :
-			reg.a = mem->read_u8(reg.pc++);
+			reg.a = mem->fetch_u8(reg.pc++);
 			cycles += 8;
 			break;
 
 		//CCF
 		case 0x3F :
 			{
+				update_flags();
 				u8 zero_flag = (reg.f & 0x80) ? 1 : 0;
 				u8 carry_flag = (reg.f & 0x10) ? 1 : 0;
 				reg.f = 0;
@@ -1958,6 +2040,7 @@ void Z80::exec_op(u8 opcode)
 		//RET NZ
 		case 0xC0 :
 			{
+				update_flags();
 				u8 zero_flag = (reg.f & 0x80) ? 1 : 0;
 				if(zero_flag == 0) { reg.pc = mem->read_u16(reg.sp); reg.sp += 2; cycles += 20; }
 				else { cycles += 8; }
@@ -1974,28 +2057,30 @@ void Z80::exec_op(u8 opcode)
 		//JP NZ nn
 		case 0xC2 :
 			{
+				update_flags();
 				u8 zero_flag = (reg.f & 0x80) ? 1 : 0;
-				if(zero_flag == 0) { reg.pc = mem->read_u16(reg.pc); cycles += 16; }
+				if(zero_flag == 0) { reg.pc = mem->fetch_u16(reg.pc); cycles += 16; }
 				else { reg.pc += 2; cycles += 12; }
 			}
 			break;
 
 		//JP nn
 		case 0xC3 :
-			reg.pc = mem->read_u16(reg.pc);
+			reg.pc = mem->fetch_u16(reg.pc);
 			cycles += 16;
 			break;
 
 		//CALL NZ, nn
 		case 0xC4 :
 			{
+				update_flags();
 				u8 zero_flag = (reg.f & 0x80) ? 1 : 0;
 				
 				if(zero_flag == 0) 
 				{
 					reg.sp -= 2;
 					mem->write_u16(reg.sp, reg.pc+2);
-					reg.pc = mem->read_u16(reg.pc);
+					reg.pc = mem->fetch_u16(reg.pc);
 					cycles += 24;
 				}
 				
@@ -2012,7 +2097,7 @@ void Z80::exec_op(u8 opcode)
 
 		//ADD A, n
 		case 0xC6 :
-			reg.a = add_byte(reg.a, mem->read_u8(reg.pc++));
+			reg.a = add_byte(reg.a, mem->fetch_u8(reg.pc++));
 			cycles += 8;
 			break;
 
@@ -2027,6 +2112,7 @@ void Z80::exec_op(u8 opcode)
 		//RET Z
 		case 0xC8 :
 			{
+				update_flags();
 				u8 zero_flag = (reg.f & 0x80) ? 1 : 0;
 				if(zero_flag == 1) { reg.pc = mem->read_u16(reg.sp); reg.sp += 2; cycles += 20; } 
 				else { cycles += 8; }
@@ -2043,8 +2129,9 @@ void Z80::exec_op(u8 opcode)
 		//JP Z nn
 		case 0xCA :
 			{
+				update_flags();
 				u8 zero_flag = (reg.f & 0x80) ? 1 : 0;
-				if(zero_flag == 1) { reg.pc = mem->read_u16(reg.pc); cycles += 16; }
+				if(zero_flag == 1) { reg.pc = mem->fetch_u16(reg.pc); cycles += 16; }
 				else { reg.pc += 2; cycles += 12; }
 			}
 			break;
@@ -2052,20 +2139,21 @@ void Z80::exec_op(u8 opcode)
 		//EXT OPS
 		case 0xCB :
 			temp_word = 0xCB00;
-			temp_word |= mem->read_u8(reg.pc++);
+			temp_word |= mem->fetch_u8(reg.pc++);
 			exec_op(temp_word);
 			break;
 
 		//CALL Z, nn
 		case 0xCC :
 			{
+				update_flags();
 				u8 zero_flag = (reg.f & 0x80) ? 1 : 0;
 				
 				if(zero_flag == 1) 
 				{
 					reg.sp -= 2;
 					mem->write_u16(reg.sp, reg.pc+2);
-					reg.pc = mem->read_u16(reg.pc);
+					reg.pc = mem->fetch_u16(reg.pc);
 					cycles += 24;
 				}
 				
@@ -2077,13 +2165,13 @@ void Z80::exec_op(u8 opcode)
 		case 0xCD :
 			reg.sp -= 2;
 			mem->write_u16(reg.sp, reg.pc+2);
-			reg.pc = mem->read_u16(reg.pc);
+			reg.pc = mem->fetch_u16(reg.pc);
 			cycles += 24;
 			break;
 
 		//ADC A, n
 		case 0xCE :
-			reg.a = add_carry(reg.a, mem->read_u8(reg.pc++));
+			reg.a = add_carry(reg.a, mem->fetch_u8(reg.pc++));
 			cycles += 8;
 			break;
 
@@ -2098,6 +2186,7 @@ void Z80::exec_op(u8 opcode)
 		//RET NC
 		case 0xD0 :
 			{
+				update_flags();
 				u8 carry_flag = (reg.f & 0x10) ? 1 : 0;
 				if(carry_flag == 0) { reg.pc = mem->read_u16(reg.sp); reg.sp += 2; cycles += 20; }
 				else { cycles += 8; }
@@ -2114,8 +2203,9 @@ void Z80::exec_op(u8 opcode)
 		//JP NC nn
 		case 0xD2 :
 			{
+				update_flags();
 				u8 carry_flag = (reg.f & 0x10) ? 1 : 0;
-				if(carry_flag == 0) { reg.pc = mem->read_u16(reg.pc); cycles += 16; }
+				if(carry_flag == 0) { reg.pc = mem->fetch_u16(reg.pc); cycles += 16; }
 				else { reg.pc += 2; cycles += 12; }
 			}
 			break;
@@ -2123,13 +2213,14 @@ void Z80::exec_op(u8 opcode)
 		//CALL NC nn
 		case 0xD4 :
 			{
+				update_flags();
 				u8 carry_flag = (reg.f & 0x10) ? 1 : 0;
 				
 				if(carry_flag == 0) 
 				{
 					reg.sp -= 2;
 					mem->write_u16(reg.sp, reg.pc+2);
-					reg.pc = mem->read_u16(reg.pc);
+					reg.pc = mem->fetch_u16(reg.pc);
 					cycles += 24;
 				}
 				
@@ -2146,7 +2237,7 @@ void Z80::exec_op(u8 opcode)
 
 		//SUB A, n
 		case 0xD6 :
-			reg.a = sub_byte(reg.a, mem->read_u8(reg.pc++));
+			reg.a = sub_byte(reg.a, mem->fetch_u8(reg.pc++));
 			cycles += 8;
 			break;
 
@@ -2161,6 +2252,7 @@ void Z80::exec_op(u8 opcode)
 		//RET C
 		case 0xD8 :
 			{
+				update_flags();
 				u8 carry_flag = (reg.f & 0x10) ? 1 : 0;
 				if(carry_flag == 1) { reg.pc = mem->read_u16(reg.sp); reg.sp += 2; cycles += 20; } 
 				else { cycles += 8; }
@@ -2178,8 +2270,9 @@ void Z80::exec_op(u8 opcode)
 		//JP C nn
 		case 0xDA :
 			{
+				update_flags();
 				u8 carry_flag = (reg.f & 0x10) ? 1 : 0;
-				if(carry_flag == 1) { reg.pc = mem->read_u16(reg.pc); cycles += 16; }
+				if(carry_flag == 1) { reg.pc = mem->fetch_u16(reg.pc); cycles += 16; }
 				else { reg.pc += 2; cycles += 12; }
 			}
 			break;
@@ -2187,13 +2280,14 @@ void Z80::exec_op(u8 opcode)
 		//CALL C, nn
 		case 0xDC :
 			{
+				update_flags();
 				u8 carry_flag = (reg.f & 0x10) ? 1 : 0;
 				
 				if(carry_flag == 1) 
 				{
 					reg.sp -= 2;
 					mem->write_u16(reg.sp, reg.pc+2);
-					reg.pc = mem->read_u16(reg.pc);
+					reg.pc = mem->fetch_u16(reg.pc);
 					cycles += 24;
 				}
 				
@@ -2203,7 +2297,7 @@ void Z80::exec_op(u8 opcode)
 
 		//SBC A, n
 		case 0xDE :
-			reg.a = sub_carry(reg.a, mem->read_u8(reg.pc++));
+			reg.a = sub_carry(reg.a, mem->fetch_u8(reg.pc++));
 			cycles += 8;
 			break;
 
@@ -2217,7 +2311,7 @@ void Z80::exec_op(u8 opcode)
 
 		//LDH n, A
 		case 0xE0 :
-			temp_word = (mem->read_u8(reg.pc++) | 0xFF00);
+			temp_word = (mem->fetch_u8(reg.pc++) | 0xFF00);
 			mem->write_u8(temp_word, reg.a);
 			cycles += 12;
 			break;
@@ -2245,7 +2339,7 @@ void Z80::exec_op(u8 opcode)
 
 		//AND n
 		case 0xE6 :
-			reg.a = and_byte(reg.a, mem->read_u8(reg.pc++));
+			reg.a = and_byte(reg.a, mem->fetch_u8(reg.pc++));
 			cycles += 8;
 			break;
 
@@ -2259,7 +2353,7 @@ void Z80::exec_op(u8 opcode)
 
 		//ADD SP, n
 		case 0xE8 :
-			reg.sp = add_signed_byte(reg.sp, mem->read_s8(reg.pc++));
+			reg.sp = add_signed_byte(reg.sp, mem->fetch_u8(reg.pc++));
 			cycles += 16;
 			break;
 
@@ -2271,14 +2365,14 @@ void Z80::exec_op(u8 opcode)
 
 		//LD nn, A
 		case 0xEA :
-			mem->write_u8(mem->read_u16(reg.pc), reg.a);
+			mem->write_u8(mem->fetch_u16(reg.pc), reg.a);
 			reg.pc += 2;
 			cycles += 16;
 			break;
 
 		//XOR n
 		case 0xEE :
-			reg.a = xor_byte(reg.a, mem->read_u8(reg.pc++));
+			reg.a = xor_byte(reg.a, mem->fetch_u8(reg.pc++));
 			cycles += 8;
 			break;
 
@@ -2292,7 +2386,7 @@ void Z80::exec_op(u8 opcode)
 
 		//LDH A, n
 		case 0xF0 :
-			temp_word = (mem->read_u8(reg.pc++) | 0xFF00);
+			temp_word = (mem->fetch_u8(reg.pc++) | 0xFF00);
 			reg.a = mem->read_u8(temp_word);
 			cycles += 12;
 			break;
@@ -2300,6 +2394,7 @@ void Z80::exec_op(u8 opcode)
 		//POP AF
 		case 0xF1 :
 			reg.f = mem->read_u8(reg.sp++) & 0xF0;
+			flag_op = Z80_FLAGS_NONE;
 			reg.a = mem->read_u8(reg.sp++);
 			cycles += 12;
 			break;
@@ -2318,6 +2413,7 @@ void Z80::exec_op(u8 opcode)
 
 		//PUSH AF
 		case 0xF5 :
+			update_flags();
 			mem->write_u8(--reg.sp, reg.a);
 			mem->write_u8(--reg.sp, reg.f);
 			cycles += 16;
@@ -2325,7 +2421,7 @@ void Z80::exec_op(u8 opcode)
 
 		//OR n
 		case 0xF6 :
-			reg.a = or_byte(reg.a, mem->read_u8(reg.pc++));
+			reg.a = or_byte(reg.a, mem->fetch_u8(reg.pc++));
 			cycles += 8;
 			break;
 
@@ -2339,7 +2435,7 @@ void Z80::exec_op(u8 opcode)
 
 		//LDHL SP, n
 		case 0xF8 :
-			reg.hl = add_signed_byte(reg.sp, mem->read_s8(reg.pc++)); 
+			reg.hl = add_signed_byte(reg.sp, mem->fetch_u8(reg.pc++)); 
 			cycles += 12;
 			break;
 
@@ -2351,7 +2447,7 @@ void Z80::exec_op(u8 opcode)
 
 		//LD A, nn
 		case 0xFA :
-			reg.a = mem->read_u8(mem->read_u16(reg.pc));
+			reg.a = mem->read_u8(mem->fetch_u16(reg.pc));
 			reg.pc+=2;
 			cycles += 16;
 			break;
@@ -2364,7 +2460,7 @@ void Z80::exec_op(u8 opcode)
 
 		//CP n
 		case 0xFE : 
-			sub_byte(reg.a, mem->read_u8(reg.pc++));
+			sub_byte(reg.a, mem->fetch_u8(reg.pc++));
 			cycles += 8;
 			break;
 
@@ -20,6 +20,15 @@
 #include "apu.h"
 #include "sio.h"
 
+//Kinds of ALU operations waiting to be applied to the F register
+const u8 Z80_FLAGS_NONE = 0;
+const u8 Z80_FLAGS_ADD = 1;
+const u8 Z80_FLAGS_SUB = 2;
+const u8 Z80_FLAGS_AND = 3;
+const u8 Z80_FLAGS_OR = 4;
+const u8 Z80_FLAGS_INC = 5;
+const u8 Z80_FLAGS_DEC = 6;
+
 class Z80
 {
 	public:
@@ -78,6 +87,12 @@ class Z80
 	u16 temp_word;
 	u8 opcode;
 
+	//Last flag-setting ALU operation - F is stale until update_flags() applies it
+	u8 flag_op;
+	u8 flag_input;
+	u8 flag_operand;
+	u8 flag_result;
+
 	//Internal CPU clock
 	u32 cpu_clock_m, cpu_clock_t;
 	u32 cycles;
@@ -128,6 +143,10 @@ class Z80
 
 	inline void jr(u8 reg_one);
 
+	//Flag functions
+	inline void update_flags();
+	u8 get_flags() const;
+
 	//Math functions
 	inline u8 add_byte(u8 reg_one, u8 reg_two);
 	inline u16 add_word(u16 reg_one, u16 reg_two);
@@ -11,15 +11,30 @@
 
 #include "arm7.h"
 
+//Instruction lookup tables
+const std::array<ARM7::arm_instructions, 4096> ARM7::arm_decode_table = make_arm_decode_table();
+const std::array<ARM7::arm_handler_func, 4096> ARM7::arm_handler_table = make_arm_handler_table(std::make_index_sequence<4096>());
+const std::array<ARM7::arm_instructions, 1024> ARM7::thumb_decode_table = make_thumb_decode_table();
+const std::array<ARM7::thumb_handler_func, 1024> ARM7::thumb_handler_table = make_thumb_handler_table(std::make_index_sequence<1024>());
+
 /****** CPU Constructor ******/
 ARM7::ARM7()
 {
+	#ifdef GBE_JIT
+	jit_buffer = NULL;
+	jit_buffer_pos = 0;
+	#endif
+
 	reset();
 }
 
 /****** CPU Destructor ******/
 ARM7::~ARM7()
 {
+	#ifdef GBE_JIT
+	free_jit_buffer();
+	#endif
+
 	std::cout<<"CPU::Shutdown\n";
 }
 
@@ -80,6 +95,17 @@ void ARM7::reset()
 	}
 
 	system_cycles = 0;
+	reset_scheduler();
+	clear_block_cache();
+
+	idle_loop_skip = config::agb_idle_loop_skip;
+	idle_loop_addr = 0xFFFFFFFF;
+	idle_loop_length = 0;
+	idle_skip_cycles = 0;
+	flag_op = LAZY_FLAGS_NONE;
+
+	for(u32 x = 0; x < 16; x++) { idle_regs[x] = 0; }
+	for(u32 x = 0; x < IDLE_LOOP_MAX_OPS; x++) { idle_poll_values[x] = 0; }
 
 	debug_message = 0xFF;
 	debug_code = 0;
@@ -356,6 +382,16 @@ void ARM7::fetch()
 	#endif
 }
 
+/****** Reads an ARM or THUMB opcode from memory without touching the pipeline ******/
+u32 ARM7::read_opcode(u32 addr)
+{
+	#ifdef GBE_FAST_FETCH
+	return (arm_mode == THUMB) ? mem->read_u16_fast(addr) : mem->read_u32_fast(addr);
+	#else
+	return (arm_mode == THUMB) ? mem->read_u16(addr) : mem->read_u32(addr);
+	#endif
+}
+
 /****** Decode ARM instruction ******/
 void ARM7::decode()
 {
@@ -363,256 +399,17 @@ void ARM7::decode()
 
 	if(instruction_operation[pipeline_id] == PIPELINE_FILL) { return; }
 
-	//Decode THUMB instructions
-	if(arm_mode == THUMB)
-	{
-		u16 current_instruction = instruction_pipeline[pipeline_id];
-		
-		if(((current_instruction >> 13) == 0) && (((current_instruction >> 11) & 0x7) != 0x3))
-		{
-			//THUMB_1
-			instruction_operation[pipeline_id] = THUMB_1;
-		}
-
-		else if(((current_instruction >> 11) & 0x1F) == 0x3)
-		{
-			//THUMB_2
-			instruction_operation[pipeline_id] = THUMB_2;
-		}
-
-		else if((current_instruction >> 13) == 0x1)
-		{
-			//THUMB_3
-			instruction_operation[pipeline_id] = THUMB_3;
-		}
-
-		else if(((current_instruction >> 10) & 0x3F) == 0x10)
-		{
-			//THUMB_4
-			instruction_operation[pipeline_id] = THUMB_4;
-		}
-
-		else if(((current_instruction >> 10) & 0x3F) == 0x11)
-		{
-			//THUMB_5
-			instruction_operation[pipeline_id] = THUMB_5;
-		}
-
-		else if((current_instruction >> 11) == 0x9)
-		{
-			//THUMB_6
-			instruction_operation[pipeline_id] = THUMB_6;
-		}
-
-		else if((current_instruction >> 12) == 0x5)
-		{
-			if(current_instruction & 0x200)
-			{
-				//THUMB_8
-				instruction_operation[pipeline_id] = THUMB_8;
-			}
-
-			else
-			{
-				//THUMB_7
-				instruction_operation[pipeline_id] = THUMB_7;
-			}
-		}
-
-		else if(((current_instruction >> 13) & 0x7) == 0x3)
-		{
-			//THUMB_9
-			instruction_operation[pipeline_id] = THUMB_9;
-		}
-
-		else if((current_instruction >> 12) == 0x8)
-		{
-			//THUMB_10
-			instruction_operation[pipeline_id] = THUMB_10;
-		}
-
-		else if((current_instruction >> 12) == 0x9)
-		{
-			//THUMB_11
-			instruction_operation[pipeline_id] = THUMB_11;
-		}
-
-		else if((current_instruction >> 12) == 0xA)
-		{
-			//THUMB_12
-			instruction_operation[pipeline_id] = THUMB_12;
-		}
-
-		else if((current_instruction >> 8) == 0xB0)
-		{
-			//THUMB_13
-			instruction_operation[pipeline_id] = THUMB_13;
-		}
-
-		else if((current_instruction >> 12) == 0xB)
-		{
-			//THUMB_14
-			instruction_operation[pipeline_id] = THUMB_14;
-		}
-
-		else if((current_instruction >> 12) == 0xC)
-		{
-			//THUMB_15
-			instruction_operation[pipeline_id] = THUMB_15;
-		}
-
-		else if((current_instruction >> 12) == 13)
-		{
-			//THUMB_16
-			instruction_operation[pipeline_id] = THUMB_16;
-		}
-
-		else if((current_instruction >> 11) == 0x1C)
-		{
-			//THUMB_18
-			instruction_operation[pipeline_id] = THUMB_18;
-		}
+	instruction_operation[pipeline_id] = decode_instruction(instruction_pipeline[pipeline_id]);
+}
 
-		else if((current_instruction >> 11) >= 0x1E)
-		{
-			//THUMB_19
-			instruction_operation[pipeline_id] = THUMB_19;
-		}
-	}
+/****** Determines which operation an ARM or THUMB instruction performs ******/
+ARM7::arm_instructions ARM7::decode_instruction(u32 opcode) const
+{
+	//Decode THUMB instructions
+	if(arm_mode == THUMB) { return decode_thumb(opcode); }
 
 	//Decode ARM instructions
-	if(arm_mode == ARM)
-	{
-		u32 current_instruction = instruction_pipeline[pipeline_id];
-
-		if(((current_instruction >> 8) & 0xFFFFF) == 0x12FFF)
-		{
-			//ARM_3
-			instruction_operation[pipeline_id] = ARM_3;
-		}
-
-		else if(((current_instruction >> 25) & 0x7) == 0x5)
-		{
-			//ARM_4
-			instruction_operation[pipeline_id] = ARM_4;
-		}
-
-		//TODO - Move ARM_6 decoding to final stage of ARM_5 decoding
-		//TODO - Move ARM_12 deconding to final stage of ARM_10 decoding		
-
-		else if((current_instruction & 0xD900000) == 0x1000000) 
-		{
-
-			if((current_instruction & 0x80) && (current_instruction & 0x10) && ((current_instruction & 0x2000000) == 0))
-			{
-				if(((current_instruction >> 5) & 0x3) == 0) 
-				{ 
-					instruction_operation[pipeline_id] = ARM_12;
-				}
-
-				else 
-				{
-					instruction_operation[pipeline_id] = ARM_10;
-				}
-			}
-
-			else 
-			{
-				//ARM_6
-				instruction_operation[pipeline_id] = ARM_6;
-			}
-		}
-
-		else if(((current_instruction >> 26) & 0x3) == 0x0)
-		{
-			if((current_instruction & 0x80) && ((current_instruction & 0x10) == 0))
-			{
-				//ARM.5
-				if(current_instruction & 0x2000000)
-				{
-					instruction_operation[pipeline_id] = ARM_5;
-				}
-
-				//ARM.5
-				else if((current_instruction & 0x100000) && (((current_instruction >> 23) & 0x3) == 0x2))
-				{
-					instruction_operation[pipeline_id] = ARM_5;
-				}
-
-				//ARM.5
-				else if(((current_instruction >> 23) & 0x3) != 0x2)
-				{
-					instruction_operation[pipeline_id] = ARM_5;
-				}
-
-				//ARM.7
-				else
-				{
-					instruction_operation[pipeline_id] = ARM_7;
-				}
-			}
-
-			else if((current_instruction & 0x80) && (current_instruction & 0x10))
-			{
-				if(((current_instruction >> 4) & 0xF) == 0x9)
-				{
-					//ARM.5
-					if(current_instruction & 0x2000000)
-					{
-						instruction_operation[pipeline_id] = ARM_5;
-					}
-
-					//ARM.12
-					else if(((current_instruction >> 23) & 0x3) == 0x2)
-					{
-						instruction_operation[pipeline_id] = ARM_12;
-					}
-
-					//ARM.7
-					else
-					{
-						instruction_operation[pipeline_id] = ARM_7;
-					}
-				}
-
-				//ARM.5
-				else if(current_instruction & 0x2000000)
-				{
-					instruction_operation[pipeline_id] = ARM_5;
-				}
-
-				//ARM.10
-				else
-				{
-					instruction_operation[pipeline_id] = ARM_10;
-				}
-			}
-
-			//ARM.5
-			else
-			{
-				instruction_operation[pipeline_id] = ARM_5;
-			}
-		}
-
-		else if(((current_instruction >> 26) & 0x3) == 0x1)
-		{
-			//ARM_9
-			instruction_operation[pipeline_id] = ARM_9;
-		}
-
-		else if(((current_instruction >> 25) & 0x7) == 0x4)
-		{
-			//ARM_11
-			instruction_operation[pipeline_id] = ARM_11;
-		}
-
-		else if(((current_instruction >> 24) & 0xF) == 0xF)
-		{
-			//ARM_13
-			instruction_operation[pipeline_id] = ARM_13;
-		}
-	}
+	return decode_arm(opcode);
 }
 
 /****** Execute ARM instruction ******/
@@ -647,7 +444,7 @@ void ARM7::execute()
 				break;
 
 			case THUMB_4:
-				alu_ops(instruction_pipeline[pipeline_id]);
+				(this->*thumb_handler_table[(instruction_pipeline[pipeline_id] >> 6) & 0x3FF])(instruction_pipeline[pipeline_id]);
 				debug_message = 0x3; debug_code = instruction_pipeline[pipeline_id];
 				break;
 
@@ -748,7 +545,7 @@ void ARM7::execute()
 					break;
 
 				case ARM_5:
-					data_processing(instruction_pipeline[pipeline_id]);
+					(this->*arm_handler_table[((instruction_pipeline[pipeline_id] >> 16) & 0xFF0) | ((instruction_pipeline[pipeline_id] >> 4) & 0xF)])(instruction_pipeline[pipeline_id]);
 					debug_message = 0x16; debug_code = instruction_pipeline[pipeline_id];
 					break;
 
@@ -763,7 +560,7 @@ void ARM7::execute()
 					break;
 
 				case ARM_9:
-					single_data_transfer(instruction_pipeline[pipeline_id]);
+					(this->*arm_handler_table[((instruction_pipeline[pipeline_id] >> 16) & 0xFF0) | ((instruction_pipeline[pipeline_id] >> 4) & 0xF)])(instruction_pipeline[pipeline_id]);
 					debug_message = 0x19; debug_code = instruction_pipeline[pipeline_id];
 					break;
 
@@ -801,7 +598,7 @@ void ARM7::execute()
 			debug_code = instruction_pipeline[pipeline_id];
 
 			//Clock CPU and controllers - 1S
-			clock(reg.r15, false); 
+			clock(reg.r15, CODE_S32); 
 		}
 	}
 
@@ -822,341 +619,6 @@ void ARM7::update_pc()
 	reg.r15 += (arm_mode == ARM) ? 4 : 2;
 }
 
-/****** Check conditional code ******/
-bool ARM7::check_condition(u32 current_arm_instruction) const
-{
-	switch(current_arm_instruction >> 28)
-	{
-		//EQ
-		case 0x0:
-			if(reg.cpsr & CPSR_Z_FLAG) { return true; }
-			else { return false; }
-			break;
-
-		//NE
-		case 0x1:
-			if(reg.cpsr & CPSR_Z_FLAG) { return false; }
-			else { return true; }
-			break;
-
-		//CS
-		case 0x2:
-			if(reg.cpsr & CPSR_C_FLAG) { return true; }
-			else { return false; }
-			break;
-
-		//CC
-		case 0x3:
-			if(reg.cpsr & CPSR_C_FLAG) { return false; }
-			else { return true; }
-			break;
-
-		//MI
-		case 0x4:
-			if(reg.cpsr & CPSR_N_FLAG) { return true; }
-			else { return false; }
-			break;
-
-		//PL
-		case 0x5:
-			if(reg.cpsr & CPSR_N_FLAG) { return false; }
-			else { return true; }
-			break;
-
-		//VS
-		case 0x6:
-			if(reg.cpsr & CPSR_V_FLAG) { return true; }
-			else { return false; }
-			break;
-
-		//VC
-		case 0x7:
-			if(reg.cpsr & CPSR_V_FLAG) { return false; }
-			else { return true; }
-			break;
-
-		//HI
-		case 0x8:
-			if((reg.cpsr & CPSR_C_FLAG) && ((reg.cpsr & CPSR_Z_FLAG) == 0)) { return true; }
-			else { return false; }
-			break;
-
-		//LS
-		case 0x9:
-			if((reg.cpsr & CPSR_Z_FLAG) || ((reg.cpsr & CPSR_C_FLAG) == 0)) { return true; }
-			else { return false; }
-			break;
-
-		//GE
-		case 0xA:
-			{
-				u8 n = (reg.cpsr & CPSR_N_FLAG) ? 1 : 0;
-				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
-
-				if(n == v) { return true; }
-				else { return false; }
-			}
-			break;
-
-		//LT
-		case 0xB:
-			{
-				u8 n = (reg.cpsr & CPSR_N_FLAG) ? 1 : 0;
-				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
-
-				if(n != v) { return true; }
-				else { return false; }
-			}
-			break;
-
-		//GT
-		case 0xC:
-			{
-				u8 n = (reg.cpsr & CPSR_N_FLAG) ? 1 : 0;
-				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
-				u8 z = (reg.cpsr & CPSR_Z_FLAG) ? 1 : 0;
-
-				if((z == 0) && (n == v)) { return true; }
-				else { return false; }
-			}
-			break;
-
-		//LE
-		case 0xD:
-			{
-				u8 n = (reg.cpsr & CPSR_N_FLAG) ? 1 : 0;
-				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
-				u8 z = (reg.cpsr & CPSR_Z_FLAG) ? 1 : 0;
-
-				if((z == 1) || (n != v)) { return true; }
-				else { return false; }
-			}
-			break;
-
-		//AL
-		case 0xE: return true; break;
-
-		//NV
-		default: std::cout<<"CPU::Warning: ARM instruction uses reserved conditional code NV \n"; return true;
-	}
-}
-
-/****** Updates the condition codes in the CPSR register after logical operations ******/
-void ARM7::update_condition_logical(u32 result, u8 shift_out)
-{
-	//Negative flag
-	if(result & 0x80000000) { reg.cpsr |= CPSR_N_FLAG; }
-	else { reg.cpsr &= ~CPSR_N_FLAG; }
-
-	//Zero flag
-	if(result == 0) { reg.cpsr |= CPSR_Z_FLAG; }
-	else { reg.cpsr &= ~CPSR_Z_FLAG; }
-
-	//Carry flag
-	if(shift_out == 1) { reg.cpsr |= CPSR_C_FLAG; }
-	else if(shift_out == 0) { reg.cpsr &= ~CPSR_C_FLAG; }
-}
-
-/****** Updates the condition codes in the CPSR register after arithmetic operations ******/
-void ARM7::update_condition_arithmetic(u32 input, u64 operand, u32 result, bool addition)
-{
-	if(operand == 0x100000001)
-	{
-		addition = true;
-		operand = 1;
-	}
-
-	//Negative flag
-	if(result & 0x80000000) { reg.cpsr |= CPSR_N_FLAG; }
-	else { reg.cpsr &= ~CPSR_N_FLAG; }
-
-	//Zero flag
-	if(result == 0) { reg.cpsr |= CPSR_Z_FLAG; }
-	else { reg.cpsr &= ~CPSR_Z_FLAG; }
-
-	//Carry flag - Addition
-	if(addition)
-	{
-		if(operand > (0xFFFFFFFF - input)) { reg.cpsr |= CPSR_C_FLAG; }
-		else { reg.cpsr &= ~CPSR_C_FLAG; }
-	}
-
-	//Carry flag - Subtraction
-	else if(!addition)
-	{
-		if(operand > input) { reg.cpsr &= ~CPSR_C_FLAG; }
-		else { reg.cpsr |= CPSR_C_FLAG; }
-	}
-
-	//Overflow flag
-	u8 input_msb = (input & 0x80000000) ? 1 : 0;
-	u8 operand_msb = (operand & 0x80000000) ? 1 : 0;
-	u8 result_msb = (result & 0x80000000) ? 1 : 0;
-
-	if(addition)
-	{
-		if(input_msb != operand_msb) { reg.cpsr &= ~CPSR_V_FLAG; }
-		
-		else
-		{
-			if((result_msb == input_msb) && (result_msb == operand_msb)) { reg.cpsr &= ~CPSR_V_FLAG; }
-			else { reg.cpsr |= CPSR_V_FLAG; }
-		}
-	}
-
-	else
-	{
-		if(input_msb == operand_msb) { reg.cpsr &= ~CPSR_V_FLAG; }
-		
-		else
-		{
-			if(result_msb == operand_msb) { reg.cpsr |= CPSR_V_FLAG; }
-			else { reg.cpsr &= ~CPSR_V_FLAG; }
-		}
-	}
-}
-
-/****** Performs 32-bit logical shift left - Returns Carry Out ******/
-u8 ARM7::logical_shift_left(u32& input, u8 offset)
-{
-	u8 carry_out = 0;
-
-	if(offset > 0)
-	{
-		//Test for carry
-		//Perform LSL #(n-1), if Bit 31 is 1, we know it will carry out
-		u32 carry_test = input << (offset - 1);
-		carry_out = (carry_test & 0x80000000) ? 1 : 0;
-
-		if(offset >= 32)
-		{
-			input = 0;
-			carry_out = (offset == 32) ? carry_out : 0;
-		}
-
-		else { input <<= offset; }
-	}
-
-	//LSL #0
-	//No shift performed, carry flag not affected, set it to something not 0 or 1 to check!
-	else { carry_out = 2; }
-
-	return carry_out;
-}
-
-/****** Performs 32-bit logical shift right - Returns Carry Out ******/
-u8 ARM7::logical_shift_right(u32& input, u8 offset)
-{
-	u8 carry_out = 0;
-
-	if(offset > 0)
-	{
-		//Test for carry
-		//Perform LSR #(n-1), if Bit 0 is 1, we know it will carry out
-		u32 carry_test = input >> (offset - 1);
-		carry_out = (carry_test & 0x1) ? 1 : 0;
-
-		if(offset >= 32)
-		{
-			input = 0;
-			carry_out = (offset == 32) ? carry_out : 0;
-		}
-
-		else { input >>= offset; }
-	}
-
-	//LSR #0
-	//Same as LSR #32, input becomes zero, carry flag is Bit 31 of input
-	else
-	{
-		carry_out = (input & 0x80000000) ? 1 : 0;
-		input = 0;
-	}
-
-	return carry_out;
-}
-
-/****** Performs 32-bit arithmetic shift right - Returns Carry Out ******/
-u8 ARM7::arithmetic_shift_right(u32& input, u8 offset)
-{
-	u8 carry_out = 0;
-
-	if(offset > 0)
-	{
-		u8 high_bit = (input & 0x80000000) ? 1 : 0;		
-
-		//Basically LSR, but bits become Bit 31
-		for(int x = 0; x < offset; x++)
-		{
-			carry_out = (input & 0x1) ? 1 : 0;
-			input >>= 1;
-			if(high_bit == 1) { input |= 0x80000000; }
-		}	
-	}
-
-	//ASR #0
-	//Same as ASR #32, input becomes 0xFFFFFFFF or 0x0 depending on Bit 31 of input
-	//Carry flag set to 0 or 1 depending on Bit 31 of input
-	else
-	{
-		if(input & 0x80000000) { input = 0xFFFFFFFF; carry_out = 1; }
-		else { input = 0; carry_out = 0; }
-	}
-
-	return carry_out;
-}
-
-/****** Performs 32-bit rotate right ******/
-u8 ARM7::rotate_right(u32& input, u8 offset)
-{
-	u8 carry_out = 0;
-
-	if(offset > 0)
-	{
-		//Perform ROR shift on immediate
-		for(int x = 0; x < offset; x++)
-		{
-			carry_out = input & 0x1;
-			input >>= 1;
-
-			if(carry_out) { input |= 0x80000000; }
-		}
-	}
-
-	//ROR #0
-	//Same as RRX #1, which is similar to ROR #1, except Bit 31 now becomes the old carry flag
-	else
-	{
-		u8 old_carry = (reg.cpsr & CPSR_C_FLAG) ? 1 : 0;
-		carry_out = input & 0x1;
-		input >>= 1;
-		
-		if(old_carry) { input |= 0x80000000; }
-	}
-
-	return carry_out;
-}
-
-/****** Performs 32-bit rotate right - For ARM.5 Data Processing when Bit 25 is 1 ******/
-u8 ARM7::rotate_right_special(u32& input, u8 offset)
-{
-	u8 carry_out = (reg.cpsr & CPSR_C_FLAG) ? 1 : 0;
-
-	if(offset > 0)
-	{
-		//Perform ROR shift on immediate
-		for(int x = 0; x < (offset * 2); x++)
-		{
-			carry_out = input & 0x1;
-			input >>= 1;
-
-			if(carry_out) { input |= 0x80000000; }
-		}
-	}
-
-	return carry_out;
-}			
-
 /****** Checks address before 32-bit reading/writing for special case scenarios ******/
 void ARM7::mem_check_32(u32 addr, u32& value, bool load_store)
 {
@@ -1464,8 +926,8 @@ void ARM7::mem_check_8(u32 addr, u32& value, bool load_store)
 }
 
 
-/****** Runs audio and video controllers every clock cycle ******/
-void ARM7::clock(u32 access_addr, bool first_access)
+/****** Advances the system clock for a single memory access ******/
+void ARM7::clock(u32 access_addr, mem_modes current_mode)
 {
 	//Determine cycles with Wait States + access timing
 	u8 access_cycles = 1;
@@ -1482,62 +944,53 @@ void ARM7::clock(u32 access_addr, bool first_access)
 	else if((access_addr >= 0x8000000) && (access_addr <= 0x9FFFFFF))
 	{
 		//Determine first access cycles (Non-Sequential)
-		if(first_access) { access_cycles += mem->n_clock;  }
+		if((current_mode == CODE_N16) || (current_mode == CODE_N32) || (current_mode == DATA_N16) || (current_mode == DATA_N32)) { access_cycles += mem->n_clock; }
 
 		//Determine second access cycles (Sequential)
 		else { access_cycles += mem->s_clock; }
 	}
 
 	system_cycles += access_cycles;
+	debug_cycles += access_cycles;
 
-	//Run controllers for each cycle		 
-	for(int x = 0; x < access_cycles; x++)
-	{
-		controllers.video.step();
-		clock_timers();
-		clock_dma();
-		debug_cycles++;
-
-		//Generate audio buffers for PSG channels on VBlank
-		if(controllers.video.lcd_clock == 0)
-		{
-			if(controllers.audio.apu_stat.psg_needs_fill) { controllers.audio.buffer_channels(); }
-			controllers.audio.apu_stat.psg_needs_fill = true;
-		}
-	}
+	//Only run controllers once something is actually due
+	scheduler.current_cycle += access_cycles;
+	if(scheduler.current_cycle >= scheduler.next_event) { process_events(); }
 }
 
-/****** Runs audio and video controllers every clock cycle ******/
+/****** Advances the system clock by 1 cycle ******/
 void ARM7::clock()
 {
-	controllers.video.step();
-	clock_timers();
-	clock_dma();
+	system_cycles++;
 
-	//Generate audio buffers for PSG channels on VBlank
-	if(controllers.video.lcd_clock == 0)
-	{
-		if(controllers.audio.apu_stat.psg_needs_fill) { controllers.audio.buffer_channels(); }
-		controllers.audio.apu_stat.psg_needs_fill = true;
-	}
+	scheduler.current_cycle++;
+	if(scheduler.current_cycle >= scheduler.next_event) { process_events(); }
+}
 
-	system_cycles++;
+/****** Advances the system clock straight to the next event - Used when the CPU is halted ******/
+void ARM7::clock_idle()
+{
+	u32 idle_cycles = (scheduler.next_event > scheduler.current_cycle) ? (scheduler.next_event - scheduler.current_cycle) : 1;
+	system_cycles += idle_cycles;
+
+	scheduler.current_cycle += idle_cycles;
+	process_events();
 }
 
 /****** Runs DMA controllers every clock cycle ******/
 void ARM7::clock_dma()
 {
 	//DMA0
-	if(mem->dma[0].enable) { dma0(); }
+	if(mem->dma[0].enable) { dma(0); }
 
 	//DMA1
-	if(mem->dma[1].enable) { dma1(); }
+	if(mem->dma[1].enable) { dma(1); }
 
 	//DMA2
-	if(mem->dma[2].enable) { dma2(); }
+	if(mem->dma[2].enable) { dma(2); }
 
 	//DMA3
-	if(mem->dma[3].enable) { dma3(); }
+	if(mem->dma[3].enable) { dma(3); }
 }
 
 /****** Runs Serial IO for some cycles ******/
@@ -1753,77 +1206,58 @@ void ARM7::clock_emulated_sio_device()
 	}
 }
 
-/****** Runs Timer controllers every clock cycle ******/
-void ARM7::clock_timers()
+/****** Handles timer overflows ******/
+void ARM7::timer_overflow(u8 timer_id)
 {
-	for(int x = 0; x < 4; x++)
+	//Bring counter up to the point of overflow, then reload
+	mem->sync_timer(timer_id);
+	controllers.timer[timer_id].counter = controllers.timer[timer_id].reload_value;
+
+	//Increment next timer if in count-up mode
+	if((timer_id < 3) && (controllers.timer[timer_id+1].count_up)) { controllers.timer[timer_id+1].counter++; }
+
+	//Interrupt
+	if(controllers.timer[timer_id].interrupt)
 	{
-		//See if this timer is enabled first
-		if(controllers.timer[x].enable)
-		{
-			controllers.timer[x].cycles++;
+		mem->memory_map[REG_IF] |= (8 << timer_id);
+	}
 
-			//If the amount of cycles matches the prescalar, increment counter
-			if(controllers.timer[x].cycles == controllers.timer[x].prescalar)
-			{
-				controllers.timer[x].cycles = 0;
-				if(!controllers.timer[x].count_up)
-				{
-					controllers.timer[x].counter++;
-
-					//If counter overflows, reload value, trigger interrupt if necessary
-					if(controllers.timer[x].counter == 0) 
-					{
-						controllers.timer[x].counter = controllers.timer[x].reload_value;
-
-						//Increment next timer if in count-up mode
-						if((x < 4) && (controllers.timer[x+1].count_up)) { controllers.timer[x+1].counter++; }
-
-						//Interrupt
-						if(controllers.timer[x].interrupt)
-						{
-							mem->memory_map[REG_IF] |= (8 << x);
-						}
-
-						//Timer 0 Audio FIFO A, DMA 1-2
-						if((x == 0) && (controllers.audio.apu_stat.dma[0].timer == 0) && (mem->dma[1].destination_address == FIFO_A) && (mem->dma[1].started)) 
-						{
-							controllers.audio.apu_stat.dma[0].buffer[controllers.audio.apu_stat.dma[0].counter++] = mem->memory_map[mem->dma[1].start_address++];
-							controllers.audio.apu_stat.dma[0].length++;
-
-							//Trigger DMA IRQ after 16th bit is transferred
-							if((mem->memory_map[REG_IE+1] & 0x2) && ((controllers.audio.apu_stat.dma[0].counter % 16) == 0)) { mem->memory_map[REG_IF+1] |= 0x2; }
-						}
-
-						if((x == 0) && (controllers.audio.apu_stat.dma[1].timer == 0) && (mem->dma[2].destination_address == FIFO_B) && (mem->dma[2].started)) 
-						{ 
-							controllers.audio.apu_stat.dma[1].buffer[controllers.audio.apu_stat.dma[1].counter++] = mem->memory_map[mem->dma[2].start_address++];
-							controllers.audio.apu_stat.dma[1].length++;
-
-							//Trigger DMA IRQ after 16th bit is transferred
-							if((mem->memory_map[REG_IE+1] & 0x4) && ((controllers.audio.apu_stat.dma[1].counter % 16) == 0)) { mem->memory_map[REG_IF+1] |= 0x4; }
-						}
-					
-						/*
-						else if((x == 0) && (controllers.audio.apu_stat.dma[0].timer == 0) && (mem->dma[2].destination_address == FIFO_A)) { }
-
-						//Timer 0 Audio FIFO B, DMA 1-2
-						else if((x == 0) && (controllers.audio.apu_stat.dma[1].timer == 0) && (mem->dma[1].destination_address == FIFO_B)) { }
-						else if((x == 0) && (controllers.audio.apu_stat.dma[1].timer == 0) && (mem->dma[2].destination_address == FIFO_B)) { }
-
-						//Timer 1 Audio FIFO A, DMA 1-2
-						else if((x == 1) && (controllers.audio.apu_stat.dma[0].timer == 1) && (mem->dma[1].destination_address == FIFO_A)) { }
-						else if((x == 1) && (controllers.audio.apu_stat.dma[0].timer == 1) && (mem->dma[2].destination_address == FIFO_A)) { }
-
-						//Timer 1 Audio FIFO B, DMA 1-2
-						else if((x == 1) && (controllers.audio.apu_stat.dma[1].timer == 1) && (mem->dma[1].destination_address == FIFO_B)) { }
-						else if((x == 1) && (controllers.audio.apu_stat.dma[1].timer == 1) && (mem->dma[2].destination_address == FIFO_B)) { }
-						*/
-					}
-				}
-			}
-		}
+	//Timer 0 Audio FIFO A, DMA 1-2
+	if((timer_id == 0) && (controllers.audio.apu_stat.dma[0].timer == 0) && (mem->dma[1].destination_address == FIFO_A) && (mem->dma[1].started)) 
+	{
+		controllers.audio.apu_stat.dma[0].buffer[controllers.audio.apu_stat.dma[0].counter++] = mem->memory_map[mem->dma[1].start_address++];
+		controllers.audio.apu_stat.dma[0].length++;
+
+		//Trigger DMA IRQ after 16th bit is transferred
+		if((mem->memory_map[REG_IE+1] & 0x2) && ((controllers.audio.apu_stat.dma[0].counter % 16) == 0)) { mem->memory_map[REG_IF+1] |= 0x2; }
 	}
+
+	if((timer_id == 0) && (controllers.audio.apu_stat.dma[1].timer == 0) && (mem->dma[2].destination_address == FIFO_B) && (mem->dma[2].started)) 
+	{ 
+		controllers.audio.apu_stat.dma[1].buffer[controllers.audio.apu_stat.dma[1].counter++] = mem->memory_map[mem->dma[2].start_address++];
+		controllers.audio.apu_stat.dma[1].length++;
+
+		//Trigger DMA IRQ after 16th bit is transferred
+		if((mem->memory_map[REG_IE+1] & 0x4) && ((controllers.audio.apu_stat.dma[1].counter % 16) == 0)) { mem->memory_map[REG_IF+1] |= 0x4; }
+	}
+
+	/*
+	else if((timer_id == 0) && (controllers.audio.apu_stat.dma[0].timer == 0) && (mem->dma[2].destination_address == FIFO_A)) { }
+
+	//Timer 0 Audio FIFO B, DMA 1-2
+	else if((timer_id == 0) && (controllers.audio.apu_stat.dma[1].timer == 0) && (mem->dma[1].destination_address == FIFO_B)) { }
+	else if((timer_id == 0) && (controllers.audio.apu_stat.dma[1].timer == 0) && (mem->dma[2].destination_address == FIFO_B)) { }
+
+	//Timer 1 Audio FIFO A, DMA 1-2
+	else if((timer_id == 1) && (controllers.audio.apu_stat.dma[0].timer == 1) && (mem->dma[1].destination_address == FIFO_A)) { }
+	else if((timer_id == 1) && (controllers.audio.apu_stat.dma[0].timer == 1) && (mem->dma[2].destination_address == FIFO_A)) { }
+
+	//Timer 1 Audio FIFO B, DMA 1-2
+	else if((timer_id == 1) && (controllers.audio.apu_stat.dma[1].timer == 1) && (mem->dma[1].destination_address == FIFO_B)) { }
+	else if((timer_id == 1) && (controllers.audio.apu_stat.dma[1].timer == 1) && (mem->dma[2].destination_address == FIFO_B)) { }
+	*/
+
+	mem->schedule_timer(timer_id);
 }
 
 /****** Jumps to or exits an interrupt ******/
@@ -1846,6 +1280,7 @@ void ARM7::handle_interrupt()
 		reg.r15 = get_reg(14) - 4;
 
 		//Set CPSR from SPSR, turn on IRQ flag
+		update_flags();
 		reg.cpsr = get_spsr();
 		reg.cpsr &= ~CPSR_IRQ;
 		reg.cpsr &= ~0x1F;
@@ -1894,6 +1329,7 @@ void ARM7::handle_interrupt()
 				else if((!needs_flush) && (arm_mode == ARM)) { set_reg(14, reg.r15); }
 
 				//Set SPSR
+				update_flags();
 				set_spsr(reg.cpsr);
 
 				//Alter CPSR bits, turn off THUMB and IRQ flags, set mode bits
@@ -1943,8 +1379,12 @@ bool ARM7::cpu_read(u32 offset, std::string filename)
 	//Go to offset
 	file.seekg(offset);
 
+	//Cached code may not match what gets loaded into memory
+	clear_block_cache();
+
 	//Serialize CPU registers data from file stream
 	file.read((char*)&reg, sizeof(reg));
+	flag_op = LAZY_FLAGS_NONE;
 
 	//Serialize misc CPU data from file stream
 	file.read((char*)&current_cpu_mode, sizeof(current_cpu_mode));
@@ -1984,6 +1424,9 @@ bool ARM7::cpu_write(std::string filename)
 	
 	if(!file.is_open()) { return false; }
 
+	//Condition codes are saved as part of the CPSR
+	update_flags();
+
 	//Serialize CPU registers data to save state
 	file.write((char*)&reg, sizeof(reg));
 
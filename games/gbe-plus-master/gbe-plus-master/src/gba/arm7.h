@@ -15,16 +15,31 @@
 #include <string>
 #include <iostream>
 #include <vector>
+#include <array>
+#include <unordered_map>
 
 #include "common.h"
+#include "common/arm_interpreter.h"
 #include "timer.h"
 #include "mmu.h"
 #include "lcd.h"
 #include "apu.h"
 #include "sio.h"
 
+#ifdef GBE_JIT
+//Number of times a cached block runs before it is translated to host code
+const u32 JIT_THRESHOLD = 16;
+#endif
 
-class ARM7
+//GBA CPU traits
+struct agb_cpu_traits : armv4t_traits
+{
+	static constexpr const char* log_name = "CPU";
+	static const bool idle_loop_branches = false;
+	static const bool long_branch_holds_irq = false;
+};
+
+class ARM7 : public arm_interpreter<ARM7, agb_cpu_traits>
 {
 	public:
 
@@ -96,6 +111,53 @@ class ARM7
 		BIOS_SWI_FINISH
 	};
 
+	typedef void (ARM7::*arm_handler_func)(u32);
+	typedef void (ARM7::*thumb_handler_func)(u16);
+
+	//Instruction lookup tables - ARM is indexed by Bits 20-27 and 4-7, THUMB is indexed by Bits 6-15
+	//Handlers for ARM.5, ARM.9, and THUMB.4 are specialized for each combination of those bits
+	static const std::array<arm_instructions, 4096> arm_decode_table;
+	static const std::array<arm_instructions, 1024> thumb_decode_table;
+	static const std::array<arm_handler_func, 4096> arm_handler_table;
+	static const std::array<thumb_handler_func, 1024> thumb_handler_table;
+
+	//Pre-decoded instruction used by the block cache
+	struct decoded_op
+	{
+		u32 opcode;
+		void (ARM7::*arm_handler)(u32);
+		void (ARM7::*thumb_handler)(u16);
+		u8 debug_message;
+	};
+
+	//Run of pre-decoded instructions starting at a given PC, never crossing a 256 byte page
+	//Blocks in WRAM are tagged with their page's write generation and rebuilt once that changes
+	struct code_block
+	{
+		std::vector<decoded_op> ops;
+		u32 address;
+		instr_modes mode;
+		s32 code_page;
+		u32 generation;
+
+		//Length of the loop if this block starts with a side-effect free polling loop, 0 otherwise
+		u8 idle_loop_length;
+
+		#ifdef GBE_JIT
+		//Host code for this block, only generated once the block has run JIT_THRESHOLD times
+		u8 (*native_code)(ARM7*);
+		u32 exec_count;
+		#endif
+	};
+
+	//Results after running an instruction from a cached block
+	enum block_status
+	{
+		BLOCK_CONTINUE,
+		BLOCK_FLUSHED,
+		BLOCK_EXIT
+	};
+
 	cpu_modes current_cpu_mode;
 	instr_modes arm_mode;
 	bios_state bios_read_state;
@@ -181,6 +243,25 @@ class ARM7
 
 	AGB_MMU* mem;
 
+	agb_scheduler scheduler;
+
+	//Cached blocks, keyed by PC with Bit 0 set for THUMB
+	std::unordered_map<u32, code_block> block_cache;
+
+	//Idle loop detection - Last cached block to run, and the total number of cycles skipped
+	code_block* last_block;
+	u64 idle_skip_cycles;
+
+	#ifdef GBE_JIT
+	//Executable memory for translated blocks
+	u8* jit_buffer;
+	u32 jit_buffer_pos;
+
+	#ifdef GBE_JIT_VERIFY
+	registers jit_verify_regs;
+	#endif
+	#endif
+
 	//Audio-Video and other controllers
 	struct io_controllers
 	{
@@ -199,6 +280,26 @@ class ARM7
 	void execute();
 	void update_pc();
 	void flush_pipeline();
+	arm_instructions decode_instruction(u32 opcode) const;
+	u32 read_opcode(u32 addr);
+
+	//Block cache functions
+	void run_block();
+	code_block* get_block(u32 addr);
+	void compile_block(u32 addr, code_block& block);
+	u8 run_cached_op(code_block* block, u32 index);
+	u8 finish_cached_op(code_block* block, u32 index);
+	void reload_pipeline();
+	void clear_block_cache();
+	void find_idle_loop(code_block& block);
+	bool skip_idle_loop(code_block* block);
+
+	#ifdef GBE_JIT
+	//JIT functions
+	void compile_native(code_block& block);
+	void clear_native_code();
+	void free_jit_buffer();
+	#endif
 
 	void reset();
 
@@ -208,62 +309,27 @@ class ARM7
 	u32 get_spsr() const;
 	void set_spsr(u32 value);
 
-	//ARM instructions
-	void branch_exchange(u32 current_arm_instruction);
-	void branch_link(u32 current_arm_instruction);
-	void data_processing(u32 current_arm_instruction);
-	void psr_transfer(u32 current_arm_instruction);
-	void multiply(u32 current_arm_instruction);
-	void single_data_transfer(u32 current_arm_instruction);
-	void halfword_signed_transfer(u32 current_arm_instruction);
-	void block_data_transfer(u32 current_arm_instruction);
-	void single_data_swap(u32 current_arm_instruction);
-	void software_interrupt_breakpoint(u32 current_arm_instruction);
-
-	//THUMB instructions
-	void move_shifted_register(u16 current_thumb_instruction);
-	void add_sub_immediate(u16 current_thumb_instruction);
-	void mcas_immediate(u16 current_thumb_instruction);
-	void alu_ops(u16 current_thumb_instruction);
-	void hireg_bx(u16 current_thumb_instruction);
-	void load_pc_relative(u16 current_thumb_instruction);
-	void load_store_reg_offset(u16 current_thumb_instruction);
-	void load_store_sign_ex(u16 current_thumb_instruction);
-	void load_store_imm_offset(u16 current_thumb_instruction);
-	void load_store_halfword(u16 current_thumb_instruction);
-	void load_store_sp_relative(u16 current_thumb_instruction);
-	void get_relative_address(u16 current_thumb_instruction);
-	void add_offset_sp(u16 current_thumb_instruction);
-	void push_pop(u16 current_thumb_instruction);
-	void multiple_load_store(u16 current_thumb_instruction);
-	void conditional_branch(u16 current_thumb_instruction);
-	void unconditional_branch(u16 current_thumb_instruction);
-	void long_branch_link(u16 current_thumb_instruction);
-
 	//System functions
-	void clock(u32 access_address, bool first_access);
+	void clock(u32 access_address, mem_modes current_mode);
 	void clock();
-	void clock_timers();
+	void clock_idle();
+	void timer_overflow(u8 timer_id);
 	void clock_dma();
 	void clock_sio();
 	void clock_emulated_sio_device();
 	void handle_interrupt();
 
+	//Scheduler functions
+	void reset_scheduler();
+	void process_events();
+	void sync_scheduler();
+	void reschedule_events();
+
 	//DMA functions
-	void dma0();
-	void dma1();
-	void dma2();
-	void dma3();
+	void dma(u8 dma_id);
+	void dma_transfer(u8 dma_id);
 
 	//Misc CPU helpers
-	void update_condition_logical(u32 result, u8 shift_out);
-	void update_condition_arithmetic(u32 input, u64 operand, u32 result, bool addition);
-	bool check_condition(u32 current_arm_instruction) const;
-	u8 logical_shift_left(u32& input, u8 offset);
-	u8 logical_shift_right(u32& input, u8 offset);
-	u8 arithmetic_shift_right(u32& input, u8 offset);
-	u8 rotate_right(u32& input, u8 offset);
-	u8 rotate_right_special(u32& input, u8 offset);
 	void mem_check_32(u32 addr, u32& value, bool load_store);
 	void mem_check_16(u32 addr, u32& value, bool load_store);
 	void mem_check_8(u32 addr, u32& value, bool load_store);
@@ -283,8 +349,8 @@ class ARM7
 	void swi_sleep();
 	void swi_intrwait();
 	void swi_vblankintrwait();
-	void swi_lz77uncompvram();
-	void swi_rluncompvram();
+	void swi_lz77uncompvram(bool vram);
+	void swi_rluncompvram(bool vram);
 	void swi_huffuncomp();
 	void swi_getbioschecksum();
 	void swi_bgaffineset();
@@ -0,0 +1,416 @@
+// GB Enhanced+ Copyright Daniel Baxter 2014
+// Licensed under the GPLv2
+// See LICENSE.txt for full license text
+
+// File : block_cache.cpp
+// Date : October 16, 2026
+// Description : ARM7TDMI block cache
+//
+// Decodes runs of ARM or THUMB instructions once and keeps them around
+// Cached blocks are executed directly instead of going through fetch, decode, and execute for every instruction
+// Blocks in WRAM are rebuilt when their memory is written to
+// Short polling loops on I/O registers are skipped ahead to the next event
+
+#include "arm7.h"
+
+/****** Runs instructions from a cached block until the block ends, a branch happens, or an interrupt is taken ******/
+void ARM7::run_block()
+{
+	u8 op_size = (arm_mode == ARM) ? 4 : 2;
+	u8 fill_steps = 0;
+
+	//Determine how many pipeline stages still need to be filled after a flush
+	if(instruction_operation[(pipeline_pointer + 1) % 3] == PIPELINE_FILL)
+	{
+		fill_steps = (instruction_operation[(pipeline_pointer + 2) % 3] == PIPELINE_FILL) ? 2 : 1;
+	}
+
+	u32 addr = reg.r15 + (fill_steps * op_size) - (op_size << 1);
+	code_block* block = get_block(addr);
+
+	//Code outside of cacheable memory goes through the regular pipeline
+	if(block == NULL)
+	{
+		last_block = NULL;
+
+		fetch();
+		decode();
+		execute();
+
+		handle_interrupt();
+
+		if(needs_flush) { flush_pipeline(); }
+
+		else
+		{
+			pipeline_pointer = (pipeline_pointer + 1) % 3;
+			update_pc();
+		}
+
+		return;
+	}
+
+	//Finish filling the pipeline, interrupts can still happen here
+	while(fill_steps)
+	{
+		debug_message = 0xFF;
+		handle_interrupt();
+
+		if(needs_flush)
+		{
+			flush_pipeline();
+			return;
+		}
+
+		reg.r15 += op_size;
+		fill_steps--;
+	}
+
+	//Jump ahead to the next event if the CPU is spinning in a polling loop
+	if((block->idle_loop_length) && (idle_loop_skip) && (skip_idle_loop(block))) { return; }
+	last_block = block;
+
+	#ifdef GBE_JIT
+
+	//Translate blocks to host code once they are hot
+	if((block->native_code == NULL) && (block->exec_count < JIT_THRESHOLD))
+	{
+		block->exec_count++;
+		if(block->exec_count == JIT_THRESHOLD) { compile_native(*block); }
+	}
+
+	if(block->native_code != NULL)
+	{
+		//Translated code writes the condition codes straight into the CPSR
+		update_flags();
+
+		if(block->native_code(this) == BLOCK_EXIT) { reload_pipeline(); }
+		return;
+	}
+
+	#endif
+
+	for(u32 x = 0; x < block->ops.size(); x++)
+	{
+		u8 status = run_cached_op(block, x);
+
+		if(status == BLOCK_FLUSHED) { return; }
+		else if(status == BLOCK_EXIT) { break; }
+	}
+
+	reload_pipeline();
+}
+
+/****** Executes a single instruction from a cached block ******/
+u8 ARM7::run_cached_op(code_block* block, u32 index)
+{
+	decoded_op& op = block->ops[index];
+
+	//Execute THUMB instruction
+	if(block->mode == THUMB)
+	{
+		if(op.thumb_handler != NULL)
+		{
+			(this->*op.thumb_handler)(op.opcode);
+			debug_message = op.debug_message; debug_code = op.opcode;
+		}
+
+		else
+		{
+			debug_message = 0x13; debug_code = op.opcode;
+			if(!config::ignore_illegal_opcodes) { running = false; }
+		}
+	}
+
+	//Conditionally execute ARM instruction
+	else if(check_condition(op.opcode))
+	{
+		if(op.arm_handler != NULL)
+		{
+			(this->*op.arm_handler)(op.opcode);
+			debug_message = op.debug_message; debug_code = op.opcode;
+		}
+
+		else
+		{
+			debug_message = 0x1E; debug_code = op.opcode;
+			if(!config::ignore_illegal_opcodes) { running = false; }
+		}
+	}
+
+	//Skip ARM instruction
+	else
+	{
+		debug_message = 0x1F;
+		debug_code = op.opcode;
+
+		//Clock CPU and controllers - 1S
+		clock(reg.r15, CODE_S32);
+	}
+
+	return finish_cached_op(block, index);
+}
+
+/****** Handles interrupts and advances the PC after an instruction from a cached block ******/
+u8 ARM7::finish_cached_op(code_block* block, u32 index)
+{
+	u8 op_size = (block->mode == ARM) ? 4 : 2;
+
+	handle_interrupt();
+
+	if(needs_flush)
+	{
+		flush_pipeline();
+		return BLOCK_FLUSHED;
+	}
+
+	reg.r15 += op_size;
+
+	//Leave the block early if the PC or CPU mode changed without a branch, or if this code was overwritten
+	if((reg.r15 != (block->address + ((index + 3) * op_size))) || (arm_mode != block->mode) || (!running)) { return BLOCK_EXIT; }
+	if((block->code_page >= 0) && (block->generation != mem->code_gen[block->code_page])) { return BLOCK_EXIT; }
+
+	return BLOCK_CONTINUE;
+}
+
+/****** Returns the cached block starting at the given address, building it if necessary ******/
+ARM7::code_block* ARM7::get_block(u32 addr)
+{
+	u32 key = (arm_mode == THUMB) ? (addr | 0x1) : addr;
+	std::unordered_map<u32, code_block>::iterator block_entry = block_cache.find(key);
+
+	//Rebuild existing blocks if their memory was written to
+	if(block_entry != block_cache.end())
+	{
+		code_block* block = &block_entry->second;
+
+		if((block->code_page >= 0) && (block->generation != mem->code_gen[block->code_page]))
+		{
+			compile_block(addr, *block);
+		}
+
+		return block;
+	}
+
+	//Only cache code from BIOS, WRAM, and ROM
+	switch(addr >> 24)
+	{
+		case 0x0:
+			if(addr > 0x3FFF) { return NULL; }
+			break;
+
+		case 0x2:
+		case 0x3:
+			break;
+
+		//Some carts map their own registers into ROM, so their code can't be cached
+		case 0x8:
+		case 0x9:
+		case 0xA:
+		case 0xB:
+		case 0xC:
+			if((config::cart_type == AGB_AM3) || (config::cart_type == AGB_JUKEBOX)
+			|| (config::cart_type == AGB_PLAY_YAN) || (config::cart_type == AGB_CAMPHO)) { return NULL; }
+
+			break;
+
+		default:
+			return NULL;
+	}
+
+	code_block* block = &block_cache[key];
+	compile_block(addr, *block);
+
+	return block;
+}
+
+/****** Decodes instructions starting at the given address into a block ******/
+void ARM7::compile_block(u32 addr, code_block& block)
+{
+	u8 op_size = (arm_mode == ARM) ? 4 : 2;
+
+	//Tag WRAM blocks with the current write generation of their page
+	switch(addr >> 24)
+	{
+		case 0x2: block.code_page = (addr >> 8) & 0x3FF; break;
+		case 0x3: block.code_page = 0x400 | ((addr >> 8) & 0x7F); break;
+		default: block.code_page = -1;
+	}
+
+	block.generation = (block.code_page >= 0) ? mem->code_gen[block.code_page] : 0;
+	block.address = addr;
+	block.mode = arm_mode;
+	block.ops.clear();
+
+	#ifdef GBE_JIT
+	block.native_code = NULL;
+	block.exec_count = 0;
+	#endif
+
+	bool block_end = false;
+
+	while(!block_end)
+	{
+		decoded_op op;
+		op.arm_handler = NULL;
+		op.thumb_handler = NULL;
+		op.debug_message = 0;
+
+		#ifdef GBE_FAST_FETCH
+		op.opcode = (arm_mode == THUMB) ? mem->read_u16_fast(addr) : mem->read_u32_fast(addr);
+		#else
+		op.opcode = (arm_mode == THUMB) ? mem->read_u16(addr) : mem->read_u32(addr);
+		#endif
+
+		switch(decode_instruction(op.opcode))
+		{
+			case THUMB_1: op.thumb_handler = &ARM7::move_shifted_register; op.debug_message = 0x0; break;
+			case THUMB_2: op.thumb_handler = &ARM7::add_sub_immediate; op.debug_message = 0x1; break;
+			case THUMB_3: op.thumb_handler = &ARM7::mcas_immediate; op.debug_message = 0x2; break;
+			case THUMB_4: op.thumb_handler = thumb_handler_table[(op.opcode >> 6) & 0x3FF]; op.debug_message = 0x3; break;
+			case THUMB_6: op.thumb_handler = &ARM7::load_pc_relative; op.debug_message = 0x5; break;
+			case THUMB_7: op.thumb_handler = &ARM7::load_store_reg_offset; op.debug_message = 0x6; break;
+			case THUMB_8: op.thumb_handler = &ARM7::load_store_sign_ex; op.debug_message = 0x7; break;
+			case THUMB_9: op.thumb_handler = &ARM7::load_store_imm_offset; op.debug_message = 0x8; break;
+			case THUMB_10: op.thumb_handler = &ARM7::load_store_halfword; op.debug_message = 0x9; break;
+			case THUMB_11: op.thumb_handler = &ARM7::load_store_sp_relative; op.debug_message = 0xA; break;
+			case THUMB_12: op.thumb_handler = &ARM7::get_relative_address; op.debug_message = 0xB; break;
+			case THUMB_13: op.thumb_handler = &ARM7::add_offset_sp; op.debug_message = 0xC; break;
+			case THUMB_14: op.thumb_handler = &ARM7::push_pop; op.debug_message = 0xD; break;
+			case THUMB_15: op.thumb_handler = &ARM7::multiple_load_store; op.debug_message = 0xE; break;
+
+			//BX
+			case THUMB_5:
+				op.thumb_handler = &ARM7::hireg_bx; op.debug_message = 0x4;
+				if(((op.opcode >> 8) & 0x3) == 0x3) { block_end = true; }
+				break;
+
+			//SWI
+			case THUMB_16:
+				op.thumb_handler = &ARM7::conditional_branch; op.debug_message = 0xF;
+				if(((op.opcode >> 8) & 0xF) == 0xF) { block_end = true; }
+				break;
+
+			case THUMB_18:
+				op.thumb_handler = &ARM7::unconditional_branch; op.debug_message = 0x11;
+				block_end = true;
+				break;
+
+			//End on the 2nd half of BL
+			case THUMB_19:
+				op.thumb_handler = &ARM7::long_branch_link; op.debug_message = 0x12;
+				if(op.opcode & 0x800) { block_end = true; }
+				break;
+
+			case ARM_5: op.arm_handler = arm_handler_table[((op.opcode >> 16) & 0xFF0) | ((op.opcode >> 4) & 0xF)]; op.debug_message = 0x16; break;
+			case ARM_6: op.arm_handler = &ARM7::psr_transfer; op.debug_message = 0x17; break;
+			case ARM_7: op.arm_handler = &ARM7::multiply; op.debug_message = 0x18; break;
+			case ARM_9: op.arm_handler = arm_handler_table[((op.opcode >> 16) & 0xFF0) | ((op.opcode >> 4) & 0xF)]; op.debug_message = 0x19; break;
+			case ARM_10: op.arm_handler = &ARM7::halfword_signed_transfer; op.debug_message = 0x1A; break;
+			case ARM_11: op.arm_handler = &ARM7::block_data_transfer; op.debug_message = 0x1B; break;
+			case ARM_12: op.arm_handler = &ARM7::single_data_swap; op.debug_message = 0x1C; break;
+
+			//End on unconditional branches and SWIs
+			case ARM_3:
+				op.arm_handler = &ARM7::branch_exchange; op.debug_message = 0x14;
+				if((op.opcode >> 28) == 0xE) { block_end = true; }
+				break;
+
+			case ARM_4:
+				op.arm_handler = &ARM7::branch_link; op.debug_message = 0x15;
+				if((op.opcode >> 28) == 0xE) { block_end = true; }
+				break;
+
+			case ARM_13:
+				op.arm_handler = &ARM7::software_interrupt_breakpoint; op.debug_message = 0x1D;
+				if((op.opcode >> 28) == 0xE) { block_end = true; }
+				break;
+
+			//Illegal opcodes stop the CPU, so nothing after them needs to be decoded
+			default:
+				block_end = true;
+		}
+
+		block.ops.push_back(op);
+		addr += op_size;
+
+		//Blocks never cross 256 byte pages, so each one only depends on a single WRAM generation
+		if((addr & 0xFF) == 0) { block_end = true; }
+	}
+
+	find_idle_loop(block);
+}
+
+/****** Rebuilds the pipeline from memory so the regular fetch, decode, execute cycle can pick up after a block ******/
+void ARM7::reload_pipeline()
+{
+	u8 op_size = (arm_mode == ARM) ? 4 : 2;
+
+	pipeline_pointer = 0;
+	instruction_pipeline[0] = 0;
+	instruction_operation[0] = UNDEFINED;
+
+	#ifdef GBE_FAST_FETCH
+	instruction_pipeline[1] = (arm_mode == THUMB) ? mem->read_u16_fast(reg.r15 - (op_size << 1)) : mem->read_u32_fast(reg.r15 - (op_size << 1));
+	instruction_pipeline[2] = (arm_mode == THUMB) ? mem->read_u16_fast(reg.r15 - op_size) : mem->read_u32_fast(reg.r15 - op_size);
+	#else
+	instruction_pipeline[1] = (arm_mode == THUMB) ? mem->read_u16(reg.r15 - (op_size << 1)) : mem->read_u32(reg.r15 - (op_size << 1));
+	instruction_pipeline[2] = (arm_mode == THUMB) ? mem->read_u16(reg.r15 - op_size) : mem->read_u32(reg.r15 - op_size);
+	#endif
+
+	instruction_operation[1] = decode_instruction(instruction_pipeline[1]);
+	instruction_operation[2] = UNDEFINED;
+}
+
+/****** Drops all cached blocks ******/
+void ARM7::clear_block_cache()
+{
+	block_cache.clear();
+	last_block = NULL;
+
+	#ifdef GBE_JIT
+	jit_buffer_pos = 0;
+	#endif
+}
+
+/****** Marks blocks that start with a short loop that only loads, compares, and branches back to the start ******/
+void ARM7::find_idle_loop(code_block& block)
+{
+	block.idle_loop_length = scan_idle_loop(block.address);
+
+	//The whole loop has to be part of this block
+	if(block.idle_loop_length > block.ops.size()) { block.idle_loop_length = 0; }
+}
+
+/****** Jumps ahead to the next event when a polling loop comes around again without changing anything ******/
+bool ARM7::skip_idle_loop(code_block* block)
+{
+	//If every register and polled value is the same as the last pass, the loop will keep doing the same thing until an event fires
+	bool consecutive = (last_block == block);
+	if((!update_idle_loop((block->address | block->mode), block->idle_loop_length)) || (!consecutive)) { return false; }
+
+	u64 start_cycle = scheduler.current_cycle;
+	u8 start_line = controllers.video.current_scanline;
+
+	//Keep jumping between events until something the loop reads changes or an interrupt fires
+	//Always stop at the next scanline so the frontend can handle input and frame updates
+	while(true)
+	{
+		clock_idle();
+
+		//Events can raise interrupts
+		handle_interrupt();
+
+		if((needs_flush) || (controllers.video.current_scanline != start_line) || (idle_loop_changed())) { break; }
+	}
+
+	idle_skip_cycles += (scheduler.current_cycle - start_cycle);
+
+	if(needs_flush)
+	{
+		flush_pipeline();
+		return true;
+	}
+
+	return false;
+}
@@ -45,6 +45,12 @@ AGB_core::AGB_core()
 	//Link MMU and CPU's timers
 	core_mmu.timer = &core_cpu.controllers.timer;
 
+	//Link MMU and CPU's scheduler
+	core_mmu.scheduler = &core_cpu.scheduler;
+
+	//Link MMU and LCD
+	core_mmu.lcd = &core_cpu.controllers.video;
+
 	db_unit.debug_mode = false;
 	db_unit.display_cycles = false;
 	db_unit.print_all = false;
@@ -95,6 +101,18 @@ void AGB_core::start()
 	//Initialize the GamePad
 	core_pad.init();
 	if(core_mmu.gpio.type == AGB_MMU::GPIO_RUMBLE) { core_pad.is_gb_player = false; }
+
+	//Disable idle loop skipping for games listed in the overrides
+	std::string game_code = "";
+	for(u32 x = 0; x < 4; x++) { game_code += core_mmu.memory_map[0x80000AC + x]; }
+
+	core_cpu.idle_loop_skip = config::agb_idle_loop_skip;
+
+	if((core_cpu.idle_loop_skip) && (config::agb_idle_loop_overrides.find(game_code) != std::string::npos))
+	{
+		std::cout<<"CPU::Idle loop skipping disabled for " << util::make_ascii_printable(game_code) << "\n";
+		core_cpu.idle_loop_skip = false;
+	}
 }
 
 /****** Stop the core ******/
@@ -193,6 +211,12 @@ void AGB_core::reset()
 	//Link MMU and CPU's timers
 	core_mmu.timer = &core_cpu.controllers.timer;
 
+	//Link MMU and CPU's scheduler
+	core_mmu.scheduler = &core_cpu.scheduler;
+
+	//Link MMU and LCD
+	core_mmu.lcd = &core_cpu.controllers.video;
+
 	//Re-read specified ROM file
 	if(!core_mmu.read_file(config::rom_file)) { can_reset = false; }
 
@@ -235,6 +259,9 @@ void AGB_core::load_state(u8 slot)
 
 	if(!core_cpu.controllers.video.lcd_read(offset, state_file)) { return; }
 
+	//Rebuild events from the loaded state
+	core_cpu.reschedule_events();
+
 	std::cout<<"GBE::Loaded state " << state_file << "\n";
 
 	//OSD
@@ -250,6 +277,9 @@ void AGB_core::save_state(u8 slot)
 	std::string state_file = config::rom_file + ".ss";
 	state_file += id;
 
+	//Bring the LCD and timers up to date before saving
+	core_cpu.sync_scheduler();
+
 	if(!core_cpu.cpu_write(state_file)) { return; }
 	if(!core_mmu.mmu_write(state_file)) { return; }
 	if(!core_cpu.controllers.audio.apu_write(state_file)) { return; }
@@ -332,20 +362,33 @@ void AGB_core::run_core()
 
 			if(db_unit.debug_mode) { debug_step(); }
 
-			core_cpu.fetch();
-			core_cpu.decode();
-			core_cpu.execute();
+			//Run cached blocks unless something needs to be checked after every instruction
+			#ifdef GBE_BLOCK_CACHE
+			bool use_block_cache = (!db_unit.debug_mode) && (!core_cpu.controllers.serial_io.sio_stat.connected)
+			&& (!core_cpu.controllers.serial_io.sio_stat.emu_device_ready) && (!core_mmu.am3.transfer_delay);
+			#else
+			bool use_block_cache = false;
+			#endif
+
+			if(use_block_cache) { core_cpu.run_block(); }
 
-			core_cpu.handle_interrupt();
+			else
+			{
+				core_cpu.fetch();
+				core_cpu.decode();
+				core_cpu.execute();
+
+				core_cpu.handle_interrupt();
 		
-			//Flush pipeline if necessary
-			if(core_cpu.needs_flush) { core_cpu.flush_pipeline(); }
-
-			//Else update the pipeline and PC
-			else 
-			{ 
-				core_cpu.pipeline_pointer = (core_cpu.pipeline_pointer + 1) % 3;
-				core_cpu.update_pc(); 
+				//Flush pipeline if necessary
+				if(core_cpu.needs_flush) { core_cpu.flush_pipeline(); }
+
+				//Else update the pipeline and PC
+				else 
+				{ 
+					core_cpu.pipeline_pointer = (core_cpu.pipeline_pointer + 1) % 3;
+					core_cpu.update_pc(); 
+				}
 			}
 		}
 
@@ -665,7 +708,7 @@ u32 AGB_core::ex_get_reg(u8 reg_index)
 		case 0xD: return core_cpu.reg.r13;
 		case 0xE: return core_cpu.reg.r14;
 		case 0xF: return core_cpu.reg.r15;
-		case 0x10: return core_cpu.reg.cpsr;
+		case 0x10: return core_cpu.get_cpsr();
 		case 0x11: return core_cpu.reg.r8_fiq;
 		case 0x12: return core_cpu.reg.r9_fiq;
 		case 0x13: return core_cpu.reg.r10_fiq;
@@ -292,33 +292,39 @@ void AGB_core::debug_display() const
 	//Grab CPSR Flags and status
 	std::string cpsr_stats = "(";
 
-	if(core_cpu.reg.cpsr & CPSR_N_FLAG) { cpsr_stats += "N"; }
+	u32 cpsr = core_cpu.get_cpsr();
+
+	if(cpsr & CPSR_N_FLAG) { cpsr_stats += "N"; }
 	else { cpsr_stats += "."; }
 
-	if(core_cpu.reg.cpsr & CPSR_Z_FLAG) { cpsr_stats += "Z"; }
+	if(cpsr & CPSR_Z_FLAG) { cpsr_stats += "Z"; }
 	else { cpsr_stats += "."; }
 
-	if(core_cpu.reg.cpsr & CPSR_C_FLAG) { cpsr_stats += "C"; }
+	if(cpsr & CPSR_C_FLAG) { cpsr_stats += "C"; }
 	else { cpsr_stats += "."; }
 
-	if(core_cpu.reg.cpsr & CPSR_V_FLAG) { cpsr_stats += "V"; }
+	if(cpsr & CPSR_V_FLAG) { cpsr_stats += "V"; }
 	else { cpsr_stats += "."; }
 
 	cpsr_stats += "  ";
 
-	if(core_cpu.reg.cpsr & CPSR_IRQ) { cpsr_stats += "I"; }
+	if(cpsr & CPSR_IRQ) { cpsr_stats += "I"; }
 	else { cpsr_stats += "."; }
 
-	if(core_cpu.reg.cpsr & CPSR_FIQ) { cpsr_stats += "F"; }
+	if(cpsr & CPSR_FIQ) { cpsr_stats += "F"; }
 	else { cpsr_stats += "."; }
 
-	if(core_cpu.reg.cpsr & CPSR_STATE) { cpsr_stats += "T)"; }
+	if(cpsr & CPSR_STATE) { cpsr_stats += "T)"; }
 	else { cpsr_stats += ".)"; }
 
-	std::cout<< std::hex <<"CPSR : 0x" << std::setw(8) << std::setfill('0') << core_cpu.reg.cpsr << "\t" << cpsr_stats << "\n";
+	std::cout<< std::hex <<"CPSR : 0x" << std::setw(8) << std::setfill('0') << cpsr << "\t" << cpsr_stats << "\n";
 
 	//Display current CPU cycles
-	if(db_unit.display_cycles) { std::cout<<"Current CPU cycles : " << std::dec << core_cpu.debug_cycles << "\n"; }
+	if(db_unit.display_cycles)
+	{
+		std::cout<<"Current CPU cycles : " << std::dec << core_cpu.debug_cycles << "\n";
+		std::cout<<"Idle loop cycles skipped : " << std::dec << core_cpu.idle_skip_cycles << "\n";
+	}
 }
 
 /****** Debugger - Wait for user input, process it to decide what next to do ******/
@@ -766,6 +772,7 @@ void AGB_core::debug_process_command()
 					case 0x10:
 						std::cout<<"\nSetting Register CPSR to 0x" << std::hex << reg_value << "\n";
 						core_cpu.reg.cpsr = reg_value;
+						core_cpu.flag_op = LAZY_FLAGS_NONE;
 						break;
 
 					case 0x11:
@@ -1154,10 +1161,11 @@ void AGB_core::debug_process_command()
 		//Reset CPU cycles counter
 		else if(command == "cr")
 		{
-			std::cout<<"\nCPU cycle counter reset to 0\n";
+			std::cout<<"\nCPU cycle counters reset to 0\n";
 
 			valid_command = true;
 			core_cpu.debug_cycles = 0;
+			core_cpu.idle_skip_cycles = 0;
 			debug_process_command();
 		}
 
@@ -1275,7 +1283,7 @@ void AGB_core::debug_process_command()
 			std::cout<<"reg \t\t Change register value (0-36) \n";
 			std::cout<<"dq \t\t Quit the debugger\n";
 			std::cout<<"dc \t\t Toggle CPU cycle display\n";
-			std::cout<<"cr \t\t Reset CPU cycle counter\n";
+			std::cout<<"cr \t\t Reset CPU cycle and idle loop counters\n";
 			std::cout<<"rs \t\t Reset emulation\n";
 			std::cout<<"pa \t\t Toggles printing all instructions to screen\n";
 			std::cout<<"pc \t\t Toggles printing all Program Counter values to screen\n";
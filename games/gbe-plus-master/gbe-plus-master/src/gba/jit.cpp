@@ -0,0 +1,956 @@
+// GB Enhanced+ Copyright Daniel Baxter 2014
+// Licensed under the GPLv2
+// See LICENSE.txt for full license text
+
+// File : jit.cpp
+// Date : October 16, 2026
+// Description : ARM7TDMI x86-64 dynamic recompiler
+//
+// Translates hot blocks from the block cache into x86-64 host code
+// ARM data processing and THUMB register, immediate, and ALU arithmetic are emitted as native code
+// Everything else (memory access, branches, multiplies, PC writes) calls the interpreter's handlers directly
+// Native ops that touch banked registers or have a condition fall back to the interpreter when the check fails
+// Blocks with SWIs are never translated so HLE BIOS calls always go through the interpreter
+// Translated code is written while its pages are RW, then they are switched to RX (never RWX)
+
+#ifdef GBE_JIT
+
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "arm7.h"
+
+namespace
+{
+	const u32 JIT_BUFFER_SIZE = 0x800000;
+
+	//Translated code is written with its pages RW, then switched to RX before it runs
+	const u32 JIT_PAGE_SIZE = 0x1000;
+
+	//x86 register encodings
+	enum x86_regs
+	{
+		X86_EAX = 0,
+		X86_ECX = 1,
+		X86_EDX = 2,
+		X86_EBX = 3,
+		X86_ESI = 6,
+		X86_EDI = 7
+	};
+
+	//Where a logical operation gets its carry flag from
+	enum jit_carry
+	{
+		CARRY_CLEAR = 0,
+		CARRY_SET = 1,
+		CARRY_KEEP = 2,
+		CARRY_SHIFTER = 3
+	};
+
+	//Offsets of CPU registers from the ARM7 object, which is held in RBX by translated code
+	//R8-R14 are the User mode copies, so they're only used when the CPU mode doesn't bank them
+	struct jit_offsets
+	{
+		s32 r[15];
+		s32 cpsr;
+		s32 cpu_mode;
+	};
+
+	//Mode checks compare current_cpu_mode as a 32-bit value
+	static_assert(sizeof(ARM7::cpu_modes) == 4, "JIT expects 32-bit CPU mode enums");
+
+	/****** Emits a single byte ******/
+	void emit_u8(std::vector<u8>& code, u8 value)
+	{
+		code.push_back(value);
+	}
+
+	/****** Emits a 32-bit value ******/
+	void emit_u32(std::vector<u8>& code, u32 value)
+	{
+		for(u32 x = 0; x < 4; x++) { code.push_back((value >> (x * 8)) & 0xFF); }
+	}
+
+	/****** Emits a 64-bit value ******/
+	void emit_u64(std::vector<u8>& code, u64 value)
+	{
+		for(u32 x = 0; x < 8; x++) { code.push_back((value >> (x * 8)) & 0xFF); }
+	}
+
+	/****** Emits MOV r32, [RBX + offset] ******/
+	void emit_load(std::vector<u8>& code, u8 host_reg, s32 offset)
+	{
+		emit_u8(code, 0x8B);
+		emit_u8(code, 0x80 | (host_reg << 3) | X86_EBX);
+		emit_u32(code, offset);
+	}
+
+	/****** Emits MOV [RBX + offset], r32 ******/
+	void emit_store(std::vector<u8>& code, s32 offset, u8 host_reg)
+	{
+		emit_u8(code, 0x89);
+		emit_u8(code, 0x80 | (host_reg << 3) | X86_EBX);
+		emit_u32(code, offset);
+	}
+
+	/****** Emits a 32-bit conditional jump with an empty target - Records where the target goes ******/
+	void emit_jump(std::vector<u8>& code, u8 condition, std::vector<u32>& jumps)
+	{
+		emit_u8(code, 0x0F); emit_u8(code, condition);
+		jumps.push_back(code.size());
+		emit_u32(code, 0);
+	}
+
+	/****** Points a jump emitted earlier at the current end of the code ******/
+	void patch_jump(std::vector<u8>& code, u32 jump_pos)
+	{
+		u32 rel = code.size() - (jump_pos + 4);
+		for(u32 y = 0; y < 4; y++) { code[jump_pos + y] = (rel >> (y * 8)) & 0xFF; }
+	}
+
+	/****** Emits a call to a helper taking the CPU, a block, and an instruction index ******/
+	void emit_call(std::vector<u8>& code, void* func, ARM7::code_block* block, u32 index)
+	{
+		#ifdef _WIN32
+		//MOV RCX, RBX - MOV RDX, imm64 - MOV R8D, imm32
+		emit_u8(code, 0x48); emit_u8(code, 0x89); emit_u8(code, 0xD9);
+		emit_u8(code, 0x48); emit_u8(code, 0xBA); emit_u64(code, (u64)block);
+		emit_u8(code, 0x41); emit_u8(code, 0xB8); emit_u32(code, index);
+		#else
+		//MOV RDI, RBX - MOV RSI, imm64 - MOV EDX, imm32
+		emit_u8(code, 0x48); emit_u8(code, 0x89); emit_u8(code, 0xDF);
+		emit_u8(code, 0x48); emit_u8(code, 0xBE); emit_u64(code, (u64)block);
+		emit_u8(code, 0xBA); emit_u32(code, index);
+		#endif
+
+		//MOV RAX, imm64 - CALL RAX
+		emit_u8(code, 0x48); emit_u8(code, 0xB8); emit_u64(code, (u64)func);
+		emit_u8(code, 0xFF); emit_u8(code, 0xD0);
+	}
+
+	/****** Emits code to copy x86 flags into the CPSR ******/
+	void emit_flags(std::vector<u8>& code, const jit_offsets& offs, bool update_carry, bool update_overflow, bool subtraction)
+	{
+		u32 flag_mask = CPSR_N_FLAG | CPSR_Z_FLAG;
+
+		//SETS AH - SETZ DL
+		emit_u8(code, 0x0F); emit_u8(code, 0x98); emit_u8(code, 0xC4);
+		emit_u8(code, 0x0F); emit_u8(code, 0x94); emit_u8(code, 0xC2);
+
+		//SETC CL or SETNC CL - ARM sets carry when subtraction does NOT borrow
+		if(update_carry)
+		{
+			emit_u8(code, 0x0F); emit_u8(code, subtraction ? 0x93 : 0x92); emit_u8(code, 0xC1);
+			flag_mask |= CPSR_C_FLAG;
+		}
+
+		//SETO AL
+		if(update_overflow)
+		{
+			emit_u8(code, 0x0F); emit_u8(code, 0x90); emit_u8(code, 0xC0);
+			flag_mask |= CPSR_V_FLAG;
+		}
+
+		//MOVZX ESI, AH - SHL ESI, 31
+		emit_u8(code, 0x0F); emit_u8(code, 0xB6); emit_u8(code, 0xF4);
+		emit_u8(code, 0xC1); emit_u8(code, 0xE6); emit_u8(code, 31);
+
+		//MOVZX EDI, DL - SHL EDI, 30 - OR ESI, EDI
+		emit_u8(code, 0x0F); emit_u8(code, 0xB6); emit_u8(code, 0xFA);
+		emit_u8(code, 0xC1); emit_u8(code, 0xE7); emit_u8(code, 30);
+		emit_u8(code, 0x09); emit_u8(code, 0xFE);
+
+		//MOVZX EDI, CL - SHL EDI, 29 - OR ESI, EDI
+		if(update_carry)
+		{
+			emit_u8(code, 0x0F); emit_u8(code, 0xB6); emit_u8(code, 0xF9);
+			emit_u8(code, 0xC1); emit_u8(code, 0xE7); emit_u8(code, 29);
+			emit_u8(code, 0x09); emit_u8(code, 0xFE);
+		}
+
+		//MOVZX EDI, AL - SHL EDI, 28 - OR ESI, EDI
+		if(update_overflow)
+		{
+			emit_u8(code, 0x0F); emit_u8(code, 0xB6); emit_u8(code, 0xF8);
+			emit_u8(code, 0xC1); emit_u8(code, 0xE7); emit_u8(code, 28);
+			emit_u8(code, 0x09); emit_u8(code, 0xFE);
+		}
+
+		//MOV EDI, CPSR - AND EDI, ~mask - OR EDI, ESI - MOV CPSR, EDI
+		emit_load(code, X86_EDI, offs.cpsr);
+		emit_u8(code, 0x81); emit_u8(code, 0xE7); emit_u32(code, ~flag_mask);
+		emit_u8(code, 0x09); emit_u8(code, 0xF7);
+		emit_store(code, offs.cpsr, X86_EDI);
+	}
+
+	/****** Emits code to copy the barrel shifter's carry out into the CPSR ******/
+	void emit_shifter_carry(std::vector<u8>& code, const jit_offsets& offs, u8 carry)
+	{
+		switch(carry)
+		{
+			//AND DWORD CPSR, ~C
+			case CARRY_CLEAR:
+				emit_u8(code, 0x81); emit_u8(code, 0xA3); emit_u32(code, offs.cpsr); emit_u32(code, ~CPSR_C_FLAG);
+				break;
+
+			//OR DWORD CPSR, C
+			case CARRY_SET:
+				emit_u8(code, 0x81); emit_u8(code, 0x8B); emit_u32(code, offs.cpsr); emit_u32(code, CPSR_C_FLAG);
+				break;
+
+			//Carry was saved in DH after the shift - MOVZX EDI, DH - SHL EDI, 29
+			//MOV ESI, CPSR - AND ESI, ~C - OR ESI, EDI - MOV CPSR, ESI
+			case CARRY_SHIFTER:
+				emit_u8(code, 0x0F); emit_u8(code, 0xB6); emit_u8(code, 0xFE);
+				emit_u8(code, 0xC1); emit_u8(code, 0xE7); emit_u8(code, 29);
+				emit_load(code, X86_ESI, offs.cpsr);
+				emit_u8(code, 0x81); emit_u8(code, 0xE6); emit_u32(code, ~CPSR_C_FLAG);
+				emit_u8(code, 0x09); emit_u8(code, 0xFE);
+				emit_store(code, offs.cpsr, X86_ESI);
+				break;
+		}
+	}
+
+	/****** Emits code to load the CPSR's carry flag into the x86 carry flag, inverted for subtraction ******/
+	void emit_carry_in(std::vector<u8>& code, const jit_offsets& offs, bool subtraction)
+	{
+		//BT DWORD CPSR, 29
+		emit_u8(code, 0x0F); emit_u8(code, 0xBA); emit_u8(code, 0xA3); emit_u32(code, offs.cpsr); emit_u8(code, 29);
+
+		//CMC - x86 borrows when carry is set, ARM borrows when it is clear
+		if(subtraction) { emit_u8(code, 0xF5); }
+	}
+
+	/****** Emits a jump to the interpreter whenever the CPU mode banks one of the given registers ******/
+	void emit_mode_guard(std::vector<u8>& code, const jit_offsets& offs, u16 reg_list, std::vector<u32>& fallback_jumps)
+	{
+		//R13 and R14 are only the User mode copies in USR and SYS - CMP DWORD MODE, SYS - JA fallback
+		if(reg_list & 0x6000)
+		{
+			emit_u8(code, 0x83); emit_u8(code, 0xBB); emit_u32(code, offs.cpu_mode); emit_u8(code, ARM7::SYS);
+			emit_jump(code, 0x87, fallback_jumps);
+		}
+
+		//R8-R12 are only banked in FIQ - CMP DWORD MODE, FIQ - JE fallback
+		else if(reg_list & 0x1F00)
+		{
+			emit_u8(code, 0x83); emit_u8(code, 0xBB); emit_u32(code, offs.cpu_mode); emit_u8(code, ARM7::FIQ);
+			emit_jump(code, 0x84, fallback_jumps);
+		}
+	}
+
+	/****** Emits a jump to the interpreter when an ARM instruction's condition fails ******/
+	void emit_condition(std::vector<u8>& code, const jit_offsets& offs, u8 condition, std::vector<u32>& fallback_jumps)
+	{
+		if(condition == 0xE) { return; }
+
+		//Work out which of the 16 NZCV combinations pass
+		u16 pass_mask = 0;
+
+		for(u32 flags = 0; flags < 16; flags++)
+		{
+			bool n = (flags & 0x8);
+			bool z = (flags & 0x4);
+			bool c = (flags & 0x2);
+			bool v = (flags & 0x1);
+			bool pass = false;
+
+			switch(condition)
+			{
+				case 0x0: pass = z; break;
+				case 0x1: pass = !z; break;
+				case 0x2: pass = c; break;
+				case 0x3: pass = !c; break;
+				case 0x4: pass = n; break;
+				case 0x5: pass = !n; break;
+				case 0x6: pass = v; break;
+				case 0x7: pass = !v; break;
+				case 0x8: pass = (c && !z); break;
+				case 0x9: pass = (!c || z); break;
+				case 0xA: pass = (n == v); break;
+				case 0xB: pass = (n != v); break;
+				case 0xC: pass = (!z && (n == v)); break;
+				case 0xD: pass = (z || (n != v)); break;
+			}
+
+			if(pass) { pass_mask |= (1 << flags); }
+		}
+
+		//MOV EAX, CPSR - SHR EAX, 28 - MOV ECX, mask - BT ECX, EAX - JNC fallback
+		emit_load(code, X86_EAX, offs.cpsr);
+		emit_u8(code, 0xC1); emit_u8(code, 0xE8); emit_u8(code, 28);
+		emit_u8(code, 0xB9); emit_u32(code, pass_mask);
+		emit_u8(code, 0x0F); emit_u8(code, 0xA3); emit_u8(code, 0xC1);
+		emit_jump(code, 0x83, fallback_jumps);
+	}
+
+	/****** Emits native code for an ARM instruction - Returns false if the interpreter must handle it ******/
+	bool emit_arm_op(std::vector<u8>& code, const jit_offsets& offs, const ARM7::decoded_op& op, std::vector<u32>& fallback_jumps)
+	{
+		u32 opcode = op.opcode;
+
+		if((op.arm_handler == NULL) || (ARM7::decode_arm(opcode) != ARM7::ARM_5)) { return false; }
+
+		//ARM.5 - Immediates and registers shifted by immediates, as long as the PC is not involved
+		u8 condition = (opcode >> 28);
+		u8 alu_op = ((opcode >> 21) & 0xF);
+		bool set_cc = (opcode & 0x100000);
+		bool use_immediate = (opcode & 0x2000000);
+		u8 src_reg = ((opcode >> 16) & 0xF);
+		u8 dest_reg = ((opcode >> 12) & 0xF);
+		u8 op_reg = (opcode & 0xF);
+		u8 shift_type = ((opcode >> 5) & 0x3);
+		u8 shift = ((opcode >> 7) & 0x1F);
+
+		bool uses_input = ((alu_op != 0xD) && (alu_op != 0xF));
+		bool writes_result = ((alu_op < 0x8) || (alu_op > 0xB));
+		bool is_logical = ((alu_op < 0x2) || (alu_op == 0x8) || (alu_op == 0x9) || (alu_op > 0xB));
+		bool subtraction = ((alu_op == 0x2) || (alu_op == 0x3) || (alu_op == 0xA));
+
+		//NV is left to the interpreter, which warns about it
+		if(condition == 0xF) { return false; }
+
+		//ADC, SBC, and RSC only compute their flags the same way as the interpreter when nothing overflows into Bit 32
+		if((alu_op >= 0x5) && (alu_op <= 0x7) && (set_cc)) { return false; }
+
+		if((writes_result) && (dest_reg == 15)) { return false; }
+		if((uses_input) && (src_reg == 15)) { return false; }
+
+		u16 reg_list = 0;
+		if(uses_input) { reg_list |= (1 << src_reg); }
+		if(writes_result) { reg_list |= (1 << dest_reg); }
+
+		u32 operand = 0;
+		u8 carry = CARRY_KEEP;
+
+		//Rotated immediates are worked out now, including the carry
+		if(use_immediate)
+		{
+			u8 rotation = ((opcode >> 8) & 0xF) * 2;
+			operand = (opcode & 0xFF);
+
+			if(rotation)
+			{
+				operand = (operand >> rotation) | (operand << (32 - rotation));
+				carry = (operand & 0x80000000) ? CARRY_SET : CARRY_CLEAR;
+			}
+		}
+
+		//Shifts by a register, RRX, and LSR/ASR #32 are left to the interpreter
+		else
+		{
+			if((opcode & 0x10) || (op_reg == 15)) { return false; }
+			if((shift_type != 0) && (shift == 0)) { return false; }
+
+			reg_list |= (1 << op_reg);
+			if(shift) { carry = CARRY_SHIFTER; }
+		}
+
+		emit_mode_guard(code, offs, reg_list, fallback_jumps);
+		emit_condition(code, offs, condition, fallback_jumps);
+
+		//Operand goes in ECX, input goes in EAX
+		if(use_immediate)
+		{
+			//MOV ECX, imm32
+			emit_u8(code, 0xB9); emit_u32(code, operand);
+		}
+
+		else
+		{
+			emit_load(code, X86_ECX, offs.r[op_reg]);
+
+			//SHL, SHR, SAR, or ROR ECX, imm8 - x86 leaves the last bit shifted out in its carry, same as ARM
+			if(shift)
+			{
+				const u8 shift_ops[4] = { 0xE1, 0xE9, 0xF9, 0xC9 };
+				emit_u8(code, 0xC1); emit_u8(code, shift_ops[shift_type]); emit_u8(code, shift);
+
+				//SETC DH - Hold onto the carry until the result's flags are written
+				if((is_logical) && (set_cc)) { emit_u8(code, 0x0F); emit_u8(code, 0x92); emit_u8(code, 0xC6); }
+			}
+		}
+
+		if(uses_input) { emit_load(code, X86_EAX, offs.r[src_reg]); }
+
+		switch(alu_op)
+		{
+			//AND, TST - AND EAX, ECX
+			case 0x0:
+			case 0x8:
+				emit_u8(code, 0x21); emit_u8(code, 0xC8);
+				break;
+
+			//EOR, TEQ - XOR EAX, ECX
+			case 0x1:
+			case 0x9:
+				emit_u8(code, 0x31); emit_u8(code, 0xC8);
+				break;
+
+			//SUB, CMP - SUB EAX, ECX
+			case 0x2:
+			case 0xA:
+				emit_u8(code, 0x29); emit_u8(code, 0xC8);
+				break;
+
+			//RSB - SUB ECX, EAX - MOV EAX, ECX
+			case 0x3:
+				emit_u8(code, 0x29); emit_u8(code, 0xC1);
+				emit_u8(code, 0x89); emit_u8(code, 0xC8);
+				break;
+
+			//ADD, CMN - ADD EAX, ECX
+			case 0x4:
+			case 0xB:
+				emit_u8(code, 0x01); emit_u8(code, 0xC8);
+				break;
+
+			//ADC - ADC EAX, ECX
+			case 0x5:
+				emit_carry_in(code, offs, false);
+				emit_u8(code, 0x11); emit_u8(code, 0xC8);
+				break;
+
+			//SBC - SBB EAX, ECX
+			case 0x6:
+				emit_carry_in(code, offs, true);
+				emit_u8(code, 0x19); emit_u8(code, 0xC8);
+				break;
+
+			//RSC - SBB ECX, EAX - MOV EAX, ECX
+			case 0x7:
+				emit_carry_in(code, offs, true);
+				emit_u8(code, 0x19); emit_u8(code, 0xC1);
+				emit_u8(code, 0x89); emit_u8(code, 0xC8);
+				break;
+
+			//ORR - OR EAX, ECX
+			case 0xC:
+				emit_u8(code, 0x09); emit_u8(code, 0xC8);
+				break;
+
+			//MOV - MOV EAX, ECX - TEST EAX, EAX
+			case 0xD:
+				emit_u8(code, 0x89); emit_u8(code, 0xC8);
+				emit_u8(code, 0x85); emit_u8(code, 0xC0);
+				break;
+
+			//BIC - NOT ECX - AND EAX, ECX
+			case 0xE:
+				emit_u8(code, 0xF7); emit_u8(code, 0xD1);
+				emit_u8(code, 0x21); emit_u8(code, 0xC8);
+				break;
+
+			//MVN - MOV EAX, ECX - NOT EAX - TEST EAX, EAX
+			case 0xF:
+				emit_u8(code, 0x89); emit_u8(code, 0xC8);
+				emit_u8(code, 0xF7); emit_u8(code, 0xD0);
+				emit_u8(code, 0x85); emit_u8(code, 0xC0);
+				break;
+		}
+
+		if(writes_result) { emit_store(code, offs.r[dest_reg], X86_EAX); }
+
+		//Logical operations leave V alone and take C from the shifter
+		if((set_cc) && (is_logical))
+		{
+			emit_flags(code, offs, false, false, false);
+			emit_shifter_carry(code, offs, carry);
+		}
+
+		else if(set_cc) { emit_flags(code, offs, true, true, subtraction); }
+
+		return true;
+	}
+
+	/****** Emits native code for a THUMB instruction - Returns false if the interpreter must handle it ******/
+	bool emit_thumb_op(std::vector<u8>& code, const jit_offsets& offs, const ARM7::decoded_op& op, std::vector<u32>& fallback_jumps)
+	{
+		u16 opcode = op.opcode;
+
+		if(op.thumb_handler == NULL) { return false; }
+
+		switch(ARM7::decode_thumb(opcode))
+		{
+			//THUMB.1 - Only LSL is emitted, LSR and ASR have special cases for a shift of 0
+			case ARM7::THUMB_1:
+			{
+				if(((opcode >> 11) & 0x3) != 0) { return false; }
+
+				u8 dest_reg = (opcode & 0x7);
+				u8 src_reg = ((opcode >> 3) & 0x7);
+				u8 offset = ((opcode >> 6) & 0x1F);
+
+				emit_load(code, X86_EAX, offs.r[src_reg]);
+
+				//SHL EAX, imm8
+				if(offset)
+				{
+					emit_u8(code, 0xC1); emit_u8(code, 0xE0); emit_u8(code, offset);
+					emit_store(code, offs.r[dest_reg], X86_EAX);
+					emit_flags(code, offs, true, false, false);
+				}
+
+				//LSL #0 leaves the carry flag alone - TEST EAX, EAX
+				else
+				{
+					emit_u8(code, 0x85); emit_u8(code, 0xC0);
+					emit_store(code, offs.r[dest_reg], X86_EAX);
+					emit_flags(code, offs, false, false, false);
+				}
+
+				return true;
+			}
+
+			//THUMB.2 - ADD and SUB with a register or 3-bit immediate
+			case ARM7::THUMB_2:
+			{
+				u8 dest_reg = (opcode & 0x7);
+				u8 src_reg = ((opcode >> 3) & 0x7);
+				u8 imm_reg = ((opcode >> 6) & 0x7);
+				u8 alu_op = ((opcode >> 9) & 0x3);
+
+				emit_load(code, X86_EAX, offs.r[src_reg]);
+
+				switch(alu_op)
+				{
+					//ADD EAX, ECX
+					case 0x0:
+						emit_load(code, X86_ECX, offs.r[imm_reg]);
+						emit_u8(code, 0x01); emit_u8(code, 0xC8);
+						break;
+
+					//SUB EAX, ECX
+					case 0x1:
+						emit_load(code, X86_ECX, offs.r[imm_reg]);
+						emit_u8(code, 0x29); emit_u8(code, 0xC8);
+						break;
+
+					//ADD EAX, imm32
+					case 0x2:
+						emit_u8(code, 0x05); emit_u32(code, imm_reg);
+						break;
+
+					//SUB EAX, imm32
+					case 0x3:
+						emit_u8(code, 0x2D); emit_u32(code, imm_reg);
+						break;
+				}
+
+				emit_store(code, offs.r[dest_reg], X86_EAX);
+				emit_flags(code, offs, true, true, (alu_op & 0x1));
+
+				return true;
+			}
+
+			//THUMB.3 - MOV, CMP, ADD, SUB with an 8-bit immediate
+			case ARM7::THUMB_3:
+			{
+				u8 dest_reg = ((opcode >> 8) & 0x7);
+				u8 alu_op = ((opcode >> 11) & 0x3);
+				u32 operand = (opcode & 0xFF);
+
+				switch(alu_op)
+				{
+					//MOV - Flags are known ahead of time
+					case 0x0:
+						//MOV DWORD [RBX + offset], imm32
+						emit_u8(code, 0xC7); emit_u8(code, 0x83); emit_u32(code, offs.r[dest_reg]); emit_u32(code, operand);
+
+						//AND DWORD CPSR, ~(N | Z)
+						emit_u8(code, 0x81); emit_u8(code, 0xA3); emit_u32(code, offs.cpsr); emit_u32(code, ~(CPSR_N_FLAG | CPSR_Z_FLAG));
+
+						//OR DWORD CPSR, Z
+						if(operand == 0) { emit_u8(code, 0x81); emit_u8(code, 0x8B); emit_u32(code, offs.cpsr); emit_u32(code, CPSR_Z_FLAG); }
+
+						break;
+
+					//CMP - SUB EAX, imm32 without storing the result
+					case 0x1:
+						emit_load(code, X86_EAX, offs.r[dest_reg]);
+						emit_u8(code, 0x2D); emit_u32(code, operand);
+						emit_flags(code, offs, true, true, true);
+						break;
+
+					//ADD EAX, imm32
+					case 0x2:
+						emit_load(code, X86_EAX, offs.r[dest_reg]);
+						emit_u8(code, 0x05); emit_u32(code, operand);
+						emit_store(code, offs.r[dest_reg], X86_EAX);
+						emit_flags(code, offs, true, true, false);
+						break;
+
+					//SUB EAX, imm32
+					case 0x3:
+						emit_load(code, X86_EAX, offs.r[dest_reg]);
+						emit_u8(code, 0x2D); emit_u32(code, operand);
+						emit_store(code, offs.r[dest_reg], X86_EAX);
+						emit_flags(code, offs, true, true, true);
+						break;
+				}
+
+				return true;
+			}
+
+			//THUMB.4 - Logical operations, NEG, CMP, and CMN - Shifts, ADC, SBC, and MUL are left to the interpreter
+			case ARM7::THUMB_4:
+			{
+				u8 dest_reg = (opcode & 0x7);
+				u8 src_reg = ((opcode >> 3) & 0x7);
+				u8 alu_op = ((opcode >> 6) & 0xF);
+
+				emit_load(code, X86_EAX, offs.r[dest_reg]);
+				emit_load(code, X86_ECX, offs.r[src_reg]);
+
+				switch(alu_op)
+				{
+					//AND, TST - AND EAX, ECX
+					case 0x0:
+					case 0x8:
+						emit_u8(code, 0x21); emit_u8(code, 0xC8);
+						break;
+
+					//EOR - XOR EAX, ECX
+					case 0x1:
+						emit_u8(code, 0x31); emit_u8(code, 0xC8);
+						break;
+
+					//NEG - XOR EAX, EAX - SUB EAX, ECX
+					case 0x9:
+						emit_u8(code, 0x31); emit_u8(code, 0xC0);
+						emit_u8(code, 0x29); emit_u8(code, 0xC8);
+						break;
+
+					//CMP - CMP EAX, ECX
+					case 0xA:
+						emit_u8(code, 0x39); emit_u8(code, 0xC8);
+						break;
+
+					//CMN - ADD EAX, ECX without storing the result
+					case 0xB:
+						emit_u8(code, 0x01); emit_u8(code, 0xC8);
+						break;
+
+					//ORR - OR EAX, ECX
+					case 0xC:
+						emit_u8(code, 0x09); emit_u8(code, 0xC8);
+						break;
+
+					//BIC - NOT ECX - AND EAX, ECX
+					case 0xE:
+						emit_u8(code, 0xF7); emit_u8(code, 0xD1);
+						emit_u8(code, 0x21); emit_u8(code, 0xC8);
+						break;
+
+					//MVN - MOV EAX, ECX - NOT EAX - TEST EAX, EAX
+					case 0xF:
+						emit_u8(code, 0x89); emit_u8(code, 0xC8);
+						emit_u8(code, 0xF7); emit_u8(code, 0xD0);
+						emit_u8(code, 0x85); emit_u8(code, 0xC0);
+						break;
+
+					default: return false;
+				}
+
+				if((alu_op != 0x8) && (alu_op != 0xA) && (alu_op != 0xB)) { emit_store(code, offs.r[dest_reg], X86_EAX); }
+
+				//Logical operations leave C and V alone
+				bool is_arithmetic = ((alu_op >= 0x9) && (alu_op <= 0xB));
+				emit_flags(code, offs, is_arithmetic, is_arithmetic, (alu_op != 0xB));
+
+				return true;
+			}
+
+			//THUMB.5 - Hi register ADD, CMP, and MOV, as long as the PC is not involved - BX is left to the interpreter
+			case ARM7::THUMB_5:
+			{
+				u8 dest_reg = ((opcode & 0x7) | ((opcode >> 4) & 0x8));
+				u8 src_reg = ((opcode >> 3) & 0xF);
+				u8 alu_op = ((opcode >> 8) & 0x3);
+
+				if((alu_op == 0x3) || (dest_reg == 15) || (src_reg == 15)) { return false; }
+
+				emit_mode_guard(code, offs, ((1 << dest_reg) | (1 << src_reg)), fallback_jumps);
+				emit_load(code, X86_ECX, offs.r[src_reg]);
+
+				switch(alu_op)
+				{
+					//ADD - ADD EAX, ECX
+					case 0x0:
+						emit_load(code, X86_EAX, offs.r[dest_reg]);
+						emit_u8(code, 0x01); emit_u8(code, 0xC8);
+						emit_store(code, offs.r[dest_reg], X86_EAX);
+						break;
+
+					//CMP - CMP EAX, ECX
+					case 0x1:
+						emit_load(code, X86_EAX, offs.r[dest_reg]);
+						emit_u8(code, 0x39); emit_u8(code, 0xC8);
+						emit_flags(code, offs, true, true, true);
+						break;
+
+					//MOV
+					case 0x2:
+						emit_store(code, offs.r[dest_reg], X86_ECX);
+						break;
+				}
+
+				return true;
+			}
+
+			default: return false;
+		}
+	}
+
+	/****** Switches part of the JIT buffer between writable and executable - Never both at once ******/
+	bool protect_jit_buffer(u8* buffer, u32 offset, u32 size, bool writable)
+	{
+		u32 start = offset & ~(JIT_PAGE_SIZE - 1);
+		u32 end = (offset + size + JIT_PAGE_SIZE - 1) & ~(JIT_PAGE_SIZE - 1);
+
+		#ifdef _WIN32
+		DWORD old_protect;
+		if(!VirtualProtect(buffer + start, end - start, (writable) ? PAGE_READWRITE : PAGE_EXECUTE_READ, &old_protect)) { return false; }
+		if(!writable) { FlushInstructionCache(GetCurrentProcess(), buffer + start, end - start); }
+		return true;
+		#else
+		return (mprotect(buffer + start, end - start, (writable) ? (PROT_READ | PROT_WRITE) : (PROT_READ | PROT_EXEC)) == 0);
+		#endif
+	}
+
+	/****** Runs an instruction through the interpreter - Called from translated code ******/
+	u8 jit_run_op(ARM7* cpu, ARM7::code_block* block, u32 index)
+	{
+		u8 status = cpu->run_cached_op(block, index);
+
+		//Translated code writes the condition codes straight into the CPSR
+		cpu->update_flags();
+
+		return status;
+	}
+
+	/****** Finishes an instruction emitted as native code - Called from translated code ******/
+	u8 jit_finish_native_op(ARM7* cpu, ARM7::code_block* block, u32 index)
+	{
+		ARM7::decoded_op& op = block->ops[index];
+
+		#ifdef GBE_JIT_VERIFY
+
+		//Run the same instruction through the interpreter from the saved state and compare results
+		//The interpreter's results are kept, and its handler takes care of clocking the CPU
+		//Native ARM code only gets here when the condition passed, so the handler can be called directly
+		ARM7::registers native_regs = cpu->reg;
+		cpu->reg = cpu->jit_verify_regs;
+
+		if(block->mode == ARM7::ARM) { (cpu->*op.arm_handler)(op.opcode); }
+		else { (cpu->*op.thumb_handler)(op.opcode); }
+
+		cpu->update_flags();
+
+		if(memcmp(&native_regs, &cpu->reg, sizeof(native_regs)) != 0)
+		{
+			std::cout<<"JIT::Error - Mismatch for " << ((block->mode == ARM7::ARM) ? "ARM" : "THUMB") << " instruction 0x" << std::hex << op.opcode;
+			std::cout<<" @ 0x" << (cpu->reg.r15 - ((block->mode == ARM7::ARM) ? 8 : 4)) << std::dec << "\n";
+		}
+
+		#else
+
+		//Clock CPU and controllers - 1I for ARM.5 register operands, then 1S
+		if(block->mode == ARM7::ARM)
+		{
+			if((op.opcode & 0x2000000) == 0) { cpu->clock(); }
+			cpu->clock((cpu->reg.r15 + 4), ARM7::CODE_S32);
+		}
+
+		else { cpu->clock(cpu->reg.r15, ARM7::CODE_S16); }
+
+		#endif
+
+		cpu->debug_message = op.debug_message;
+		cpu->debug_code = op.opcode;
+
+		return cpu->finish_cached_op(block, index);
+	}
+
+	#ifdef GBE_JIT_VERIFY
+
+	/****** Saves registers before an instruction emitted as native code - Called from translated code ******/
+	u8 jit_save_regs(ARM7* cpu, ARM7::code_block* block, u32 index)
+	{
+		cpu->jit_verify_regs = cpu->reg;
+		return 0;
+	}
+
+	#endif
+}
+
+/****** Translates a cached block into host code ******/
+void ARM7::compile_native(code_block& block)
+{
+	//Leave SWIs to the interpreter
+	for(u32 x = 0; x < block.ops.size(); x++)
+	{
+		if((block.mode == ARM) && (block.ops[x].arm_handler == &ARM7::software_interrupt_breakpoint)) { return; }
+		if((block.mode == THUMB) && (block.ops[x].thumb_handler == &ARM7::conditional_branch) && (((block.ops[x].opcode >> 8) & 0xF) == 0xF)) { return; }
+	}
+
+	//Grab memory for translated code on first use - It only becomes executable once code is written to it
+	if(jit_buffer == NULL)
+	{
+		#ifdef _WIN32
+		jit_buffer = (u8*)VirtualAlloc(NULL, JIT_BUFFER_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+		#else
+		void* buffer = mmap(NULL, JIT_BUFFER_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		jit_buffer = (buffer == MAP_FAILED) ? NULL : (u8*)buffer;
+		#endif
+
+		if(jit_buffer == NULL)
+		{
+			std::cout<<"CPU::Warning - Could not allocate memory for the JIT\n";
+			return;
+		}
+
+		jit_buffer_pos = 0;
+	}
+
+	jit_offsets offs;
+	u32* gpr[15] = { &reg.r0, &reg.r1, &reg.r2, &reg.r3, &reg.r4, &reg.r5, &reg.r6, &reg.r7,
+			&reg.r8, &reg.r9, &reg.r10, &reg.r11, &reg.r12, &reg.r13, &reg.r14 };
+
+	for(u32 x = 0; x < 15; x++) { offs.r[x] = (u8*)gpr[x] - (u8*)this; }
+	offs.cpsr = (u8*)&reg.cpsr - (u8*)this;
+	offs.cpu_mode = (u8*)&current_cpu_mode - (u8*)this;
+
+	std::vector<u8> code;
+	std::vector<u32> exit_jumps;
+
+	//PUSH RBX - SUB RSP, 32
+	emit_u8(code, 0x53);
+	emit_u8(code, 0x48); emit_u8(code, 0x83); emit_u8(code, 0xEC); emit_u8(code, 0x20);
+
+	//MOV RBX, CPU
+	#ifdef _WIN32
+	emit_u8(code, 0x48); emit_u8(code, 0x89); emit_u8(code, 0xCB);
+	#else
+	emit_u8(code, 0x48); emit_u8(code, 0x89); emit_u8(code, 0xFB);
+	#endif
+
+	for(u32 x = 0; x < block.ops.size(); x++)
+	{
+		u32 op_start = code.size();
+		std::vector<u32> fallback_jumps;
+		std::vector<u32> skip_jumps;
+
+		#ifdef GBE_JIT_VERIFY
+		emit_call(code, (void*)&jit_save_regs, &block, x);
+		#endif
+
+		bool native = (block.mode == THUMB) ? emit_thumb_op(code, offs, block.ops[x], fallback_jumps) : emit_arm_op(code, offs, block.ops[x], fallback_jumps);
+
+		//Drop anything emitted ahead of the instruction if the interpreter has to run it
+		if(!native)
+		{
+			code.resize(op_start);
+			fallback_jumps.clear();
+		}
+
+		if(native)
+		{
+			//TEST AL, AL - JNZ exit
+			emit_call(code, (void*)&jit_finish_native_op, &block, x);
+			emit_u8(code, 0x84); emit_u8(code, 0xC0);
+			emit_jump(code, 0x85, exit_jumps);
+
+			//JMP over the interpreter call below - Only needed when a mode or condition check can fall back to it
+			if(!fallback_jumps.empty())
+			{
+				emit_u8(code, 0xE9);
+				skip_jumps.push_back(code.size());
+				emit_u32(code, 0);
+			}
+		}
+
+		//Failed mode and condition checks land here
+		for(u32 y = 0; y < fallback_jumps.size(); y++) { patch_jump(code, fallback_jumps[y]); }
+
+		if((!native) || (!fallback_jumps.empty()))
+		{
+			//TEST AL, AL - JNZ exit
+			emit_call(code, (void*)&jit_run_op, &block, x);
+			emit_u8(code, 0x84); emit_u8(code, 0xC0);
+			emit_jump(code, 0x85, exit_jumps);
+		}
+
+		for(u32 y = 0; y < skip_jumps.size(); y++) { patch_jump(code, skip_jumps[y]); }
+	}
+
+	//Reached the end of the block - MOV EAX, BLOCK_EXIT
+	emit_u8(code, 0xB8); emit_u32(code, BLOCK_EXIT);
+
+	//Point early exits here
+	for(u32 x = 0; x < exit_jumps.size(); x++) { patch_jump(code, exit_jumps[x]); }
+
+	//ADD RSP, 32 - POP RBX - RET
+	emit_u8(code, 0x48); emit_u8(code, 0x83); emit_u8(code, 0xC4); emit_u8(code, 0x20);
+	emit_u8(code, 0x5B);
+	emit_u8(code, 0xC3);
+
+	//Start over once the buffer fills up
+	if((jit_buffer_pos + code.size()) > JIT_BUFFER_SIZE) { clear_native_code(); }
+
+	//Write the code while its pages are RW, then flip them back to RX before anything runs them
+	if(!protect_jit_buffer(jit_buffer, jit_buffer_pos, code.size(), true))
+	{
+		std::cout<<"CPU::Warning - Could not make JIT memory writable\n";
+		return;
+	}
+
+	memcpy(jit_buffer + jit_buffer_pos, &code[0], code.size());
+
+	if(!protect_jit_buffer(jit_buffer, jit_buffer_pos, code.size(), false))
+	{
+		std::cout<<"CPU::Warning - Could not make JIT memory executable\n";
+		return;
+	}
+
+	block.native_code = (u8 (*)(ARM7*))(jit_buffer + jit_buffer_pos);
+
+	//Keep blocks 16-byte aligned
+	jit_buffer_pos += (code.size() + 0xF) & ~0xF;
+}
+
+/****** Throws away all translated code - Blocks are translated again once they get hot ******/
+void ARM7::clear_native_code()
+{
+	for(std::unordered_map<u32, code_block>::iterator block_entry = block_cache.begin(); block_entry != block_cache.end(); block_entry++)
+	{
+		block_entry->second.native_code = NULL;
+		block_entry->second.exec_count = 0;
+	}
+
+	jit_buffer_pos = 0;
+}
+
+/****** Releases executable memory used by the JIT ******/
+void ARM7::free_jit_buffer()
+{
+	if(jit_buffer == NULL) { return; }
+
+	#ifdef _WIN32
+	VirtualFree(jit_buffer, 0, MEM_RELEASE);
+	#else
+	munmap(jit_buffer, JIT_BUFFER_SIZE);
+	#endif
+
+	jit_buffer = NULL;
+	jit_buffer_pos = 0;
+}
+
+#endif // GBE_JIT
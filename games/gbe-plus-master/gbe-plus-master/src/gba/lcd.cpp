@@ -10,9 +10,11 @@
 // Responsible for blitting pixel data and limiting frame rate
 
 #include <cmath>
+#include <cstring>
 
 #include "lcd.h"
 #include "common/util.h"
+#include "common/sfx_util.h"
 
 /****** LCD Constructor ******/
 AGB_LCD::AGB_LCD()
@@ -78,6 +80,8 @@ void AGB_LCD::reset()
 		lcd_stat.obj_pal_update_list[x] = true;
 	}
 
+	for(int x = 0; x < 0x1000; x++) { lcd_stat.vram_tile_update_list[x] = true; }
+
 	lcd_stat.frame_base = 0x6000000;
 	lcd_stat.bg_mode = 0;
 	lcd_stat.hblank_interval_free = false;
@@ -506,14 +510,20 @@ void AGB_LCD::update_palettes()
 	}
 }
 
-/****** Determines if a sprite pixel should be rendered, and if so draws it to the current scanline pixel ******/
-bool AGB_LCD::render_sprite_pixel()
+/****** Draws the OBJ layer for a run of pixels on the current scanline ******/
+void AGB_LCD::render_obj_line(u32 first_pixel, u32 last_pixel)
 {
+	for(u32 x = first_pixel; x < last_pixel; x++)
+	{
+		obj_line.opaque[x] = false;
+		obj_line.obj_win[x] = false;
+	}
+
 	//If sprites are disabled, quit now
-	if((lcd_stat.display_control & 0x1000) == 0) { return false; }
+	if((lcd_stat.display_control & 0x1000) == 0) { return; }
 
 	//If no sprites are rendered on this line, quit now
-	if(obj_render_length == 0) { return false; }
+	if(obj_render_length == 0) { return; }
 
 	u8 sprite_id = 0;
 	u32 sprite_tile_addr = 0;
@@ -524,80 +534,83 @@ bool AGB_LCD::render_sprite_pixel()
 	u16 sprite_tile_pixel_y = 0;
 
 	bool render_obj;
-	bool final_render = false;
 
-	//Cycle through all sprites that are rendering on this pixel, draw them according to their priority
-	for(int x = 0; x < obj_render_length; x++)
+	//Cycle through all sprites that are rendering on this line, draw them according to their priority
+	//The first sprite drawn on a pixel wins. OBJ Window sprites only mark the pixels they pass over
+	for(int y = 0; y < obj_render_length; y++)
 	{
-		sprite_id = obj_render_list[x];
-		render_obj = true;
-
-		if((final_render) && (obj[sprite_id].mode != 2)) { continue; }
-
-		//Check to see if current_scanline_pixel is within sprite
-		if((!obj[sprite_id].x_wrap) && ((scanline_pixel_counter < obj[sprite_id].left) || (scanline_pixel_counter > obj[sprite_id].right))) { continue; }
-		else if((obj[sprite_id].x_wrap) && ((scanline_pixel_counter > obj[sprite_id].right) && (scanline_pixel_counter < obj[sprite_id].left))) { continue; }
+		sprite_id = obj_render_list[y];
 
 		//For bitmap BG Modes 3-5, skip rendering tile numbers lower than 512
-		else if((lcd_stat.bg_mode >= 0x3) && (obj[sprite_id].tile_number < 512)) { continue; }
+		if((lcd_stat.bg_mode >= 0x3) && (obj[sprite_id].tile_number < 512)) { continue; }
 
-		//Normal sprite rendering
-		if(!obj[sprite_id].affine_enable)
+		for(u32 x = first_pixel; x < last_pixel; x++)
 		{
-			//Determine the internal X-Y coordinates of the sprite's pixel
-			sprite_tile_pixel_x = obj[sprite_id].x_wrap ? (scanline_pixel_counter + obj[sprite_id].x_wrap_val) : (scanline_pixel_counter - obj[sprite_id].x);
-			sprite_tile_pixel_y = obj[sprite_id].y_wrap ? (current_scanline + obj[sprite_id].y_wrap_val) : (current_scanline - obj[sprite_id].y);
+			render_obj = true;
+
+			if((obj_line.opaque[x]) && (obj[sprite_id].mode != 2)) { continue; }
 
-			//Horizontal flip the internal X coordinate
-			if(obj[sprite_id].h_flip)
+			//Check to see if the current pixel is within sprite
+			if((!obj[sprite_id].x_wrap) && ((x < obj[sprite_id].left) || (x > obj[sprite_id].right))) { continue; }
+			else if((obj[sprite_id].x_wrap) && ((x > obj[sprite_id].right) && (x < obj[sprite_id].left))) { continue; }
+
+			//Normal sprite rendering
+			if(!obj[sprite_id].affine_enable)
 			{
-				s16 h_flip = sprite_tile_pixel_x;
-				h_flip -= (obj[sprite_id].width - 1);
+				//Determine the internal X-Y coordinates of the sprite's pixel
+				sprite_tile_pixel_x = obj[sprite_id].x_wrap ? (x + obj[sprite_id].x_wrap_val) : (x - obj[sprite_id].x);
+				sprite_tile_pixel_y = obj[sprite_id].y_wrap ? (current_scanline + obj[sprite_id].y_wrap_val) : (current_scanline - obj[sprite_id].y);
 
-				if(h_flip < 0) { h_flip *= -1; }
+				//Horizontal flip the internal X coordinate
+				if(obj[sprite_id].h_flip)
+				{
+					s16 h_flip = sprite_tile_pixel_x;
+					h_flip -= (obj[sprite_id].width - 1);
 
-				sprite_tile_pixel_x = h_flip;
-			}
+					if(h_flip < 0) { h_flip *= -1; }
 
-			//Vertical flip the internal Y coordinate
-			if(obj[sprite_id].v_flip)
-			{
-				s16 v_flip = sprite_tile_pixel_y;
-				v_flip -= (obj[sprite_id].height - 1);
+					sprite_tile_pixel_x = h_flip;
+				}
 
-				if(v_flip < 0) { v_flip *= -1; }
+				//Vertical flip the internal Y coordinate
+				if(obj[sprite_id].v_flip)
+				{
+					s16 v_flip = sprite_tile_pixel_y;
+					v_flip -= (obj[sprite_id].height - 1);
+
+					if(v_flip < 0) { v_flip *= -1; }
 
-				sprite_tile_pixel_y = v_flip;
+					sprite_tile_pixel_y = v_flip;
+				}
 			}
-		}
 
-		//Affine transformation sprite rendering
-		else
-		{
-			u8 index = (obj[sprite_id].affine_group << 2);
-			s16 current_x, current_y;
+			//Affine transformation sprite rendering
+			else
+			{
+				u8 index = (obj[sprite_id].affine_group << 2);
+				s16 current_x, current_y;
 
-			//Determine current X position relative to the OBJ center X, account for screen wrapping
-			if((obj[sprite_id].x_wrap) && (scanline_pixel_counter < obj[sprite_id].right)) { current_x = scanline_pixel_counter - (obj[sprite_id].cx - obj[sprite_id].x_wrap); }
-			else { current_x = scanline_pixel_counter - obj[sprite_id].cx; }
+				//Determine current X position relative to the OBJ center X, account for screen wrapping
+				if((obj[sprite_id].x_wrap) && (x < obj[sprite_id].right)) { current_x = x - (obj[sprite_id].cx - obj[sprite_id].x_wrap); }
+				else { current_x = x - obj[sprite_id].cx; }
 
-			//Determine current Y position relative to the OBJ center Y, account for screen wrapping
-			if((obj[sprite_id].y_wrap) && (current_scanline < obj[sprite_id].bottom)) { current_y = current_scanline - (obj[sprite_id].cy - obj[sprite_id].y_wrap); }
-			else { current_y = current_scanline - obj[sprite_id].cy; }
+				//Determine current Y position relative to the OBJ center Y, account for screen wrapping
+				if((obj[sprite_id].y_wrap) && (current_scanline < obj[sprite_id].bottom)) { current_y = current_scanline - (obj[sprite_id].cy - obj[sprite_id].y_wrap); }
+				else { current_y = current_scanline - obj[sprite_id].cy; }
 
-			s16 new_x = obj[sprite_id].cw + (lcd_stat.obj_affine[index] * current_x) + (lcd_stat.obj_affine[index+1] * current_y);
-			s16 new_y = obj[sprite_id].ch + (lcd_stat.obj_affine[index+2] * current_x) + (lcd_stat.obj_affine[index+3] * current_y);
+				s16 new_x = obj[sprite_id].cw + (lcd_stat.obj_affine[index] * current_x) + (lcd_stat.obj_affine[index+1] * current_y);
+				s16 new_y = obj[sprite_id].ch + (lcd_stat.obj_affine[index+2] * current_x) + (lcd_stat.obj_affine[index+3] * current_y);
 
-			//If out of bounds for the transformed sprite, abort rendering
-			if((new_x < 0) || (new_y < 0) || (new_x >= obj[sprite_id].width) || (new_y >= obj[sprite_id].height)) { render_obj = false; }
+				//If out of bounds for the transformed sprite, abort rendering
+				if((new_x < 0) || (new_y < 0) || (new_x >= obj[sprite_id].width) || (new_y >= obj[sprite_id].height)) { render_obj = false; }
 		
-			sprite_tile_pixel_x = new_x;
-			sprite_tile_pixel_y = new_y;
-		}
+				sprite_tile_pixel_x = new_x;
+				sprite_tile_pixel_y = new_y;
+			}
+
+			//This check is mainly for affine OBJs
+			if(!render_obj) { continue; }
 
-		//This check is mainly for affine OBJs
-		if(render_obj)
-		{
 			//Handle the mosiac function
 			if(obj[sprite_id].mosiac && lcd_stat.obj_mos_hsize) { sprite_tile_pixel_x = ((sprite_tile_pixel_x / lcd_stat.obj_mos_hsize) * lcd_stat.obj_mos_hsize); }
 			if(obj[sprite_id].mosiac && lcd_stat.obj_mos_vsize) { sprite_tile_pixel_y = ((sprite_tile_pixel_y / lcd_stat.obj_mos_vsize) * lcd_stat.obj_mos_vsize); }
@@ -625,477 +638,505 @@ bool AGB_LCD::render_sprite_pixel()
 			meta_y = (sprite_tile_pixel_y % 8);
 
 			u8 sprite_tile_pixel = (meta_y * 8) + meta_x;
+			u16 pal_entry = 0;
 
-			//Grab the byte corresponding to (sprite_tile_pixel), render it as ARGB - 4-bit version
+			//Grab the palette index for (sprite_tile_pixel) from the decoded tile - 4-bit version
 			if(obj[sprite_id].bit_depth == 4)
 			{
-				sprite_tile_addr += (sprite_tile_pixel >> 1);
-				raw_color = mem->memory_map[sprite_tile_addr];
-
-				if((sprite_tile_pixel % 2) == 0) { raw_color &= 0xF; }
-				else { raw_color >>= 4; }
-
-				if(raw_color != 0) 
-				{
-					//If this sprite is in OBJ Window mode, do not render it, but set a flag indicating the LCD passed over its pixel
-					if(obj[sprite_id].mode == 2) { obj_win_pixel = true; }
-
-					else 
-					{
-						scanline_buffer[scanline_pixel_counter] = pal[((obj[sprite_id].palette_number * 32) + (raw_color * 2)) >> 1][1];
-						last_raw_color = raw_pal[((obj[sprite_id].palette_number * 32) + (raw_color * 2)) >> 1][1];
-						last_obj_priority = obj[sprite_id].bg_priority;
-						last_obj_mode = obj[sprite_id].mode;
-						final_render = true;
-					}
-				}
+				raw_color = get_decoded_tile(sprite_tile_addr)[sprite_tile_pixel];
+				pal_entry = (obj[sprite_id].palette_number << 4) + raw_color;
 			}
 
-			//Grab the byte corresponding to (sprite_tile_pixel), render it as ARGB - 8-bit version
+			//Grab the byte corresponding to (sprite_tile_pixel) - 8-bit version
 			else
 			{
 				sprite_tile_addr += sprite_tile_pixel;
-				raw_color = mem->memory_map[sprite_tile_addr];
+				raw_color = mem->memory_map.read(sprite_tile_addr);
+				pal_entry = raw_color;
+			}
 
-				if(raw_color != 0) 
-				{
-					//If this sprite is in OBJ Window mode, do not render it, but set a flag indicating the LCD passed over its pixel
-					if(obj[sprite_id].mode == 2) { obj_win_pixel = true; }
+			if(raw_color == 0) { continue; }
 
-					else
-					{
-						scanline_buffer[scanline_pixel_counter] = pal[raw_color][1];
-						last_raw_color = raw_pal[raw_color][1];
-						last_obj_priority = obj[sprite_id].bg_priority;
-						last_obj_mode = obj[sprite_id].mode;
-						final_render = true;
-					}
-				}
+			//If this sprite is in OBJ Window mode, do not render it, but set a flag indicating the LCD passed over its pixel
+			if(obj[sprite_id].mode == 2) { obj_line.obj_win[x] = true; }
+
+			else
+			{
+				obj_line.color[x] = pal[pal_entry][1];
+				obj_line.raw_color[x] = raw_pal[pal_entry][1];
+				obj_line.priority[x] = obj[sprite_id].bg_priority;
+				obj_line.mode[x] = obj[sprite_id].mode;
+				obj_line.opaque[x] = true;
 			}
 		}
 	}
-
-	//Return false if nothing was drawn
-	return final_render;
 }
 
-/****** Determines if a background pixel should be rendered, and if so draws it to the current scanline pixel ******/
-bool AGB_LCD::render_bg_pixel(u32 bg_control)
+/****** Draws a BG layer for a run of pixels on the current scanline ******/
+void AGB_LCD::render_bg_line(u32 bg_control, u32 first_pixel, u32 last_pixel)
 {
-	if(!lcd_stat.bg_enable[(bg_control - 0x4000008) >> 1]) { return false; }
+	u8 bg_id = (bg_control - 0x4000008) >> 1;
+
+	for(u32 x = first_pixel; x < last_pixel; x++) { bg_line[bg_id].opaque[x] = false; }
+
+	if(!lcd_stat.bg_enable[bg_id]) { return; }
 
-	//Render BG pixel according to current BG Mode
+	//Render BG pixels according to current BG Mode
 	switch(lcd_stat.bg_mode)
 	{
 		//BG Mode 0
 		case 0:
-			return render_bg_mode_0(bg_control); break;
+			render_bg_mode_0(bg_control, first_pixel, last_pixel); break;
 
 		//BG Mode 1
 		case 1:
 			//Render BG2 as Scaled+Rotation
-			if(bg_control == BG2CNT) { return render_bg_mode_1(bg_control); }
+			if(bg_control == BG2CNT) { render_bg_mode_1(bg_control, first_pixel, last_pixel); }
 
 			//BG3 is never drawn in Mode 1
-			else if(bg_control == BG3CNT) { return false; }
+			else if(bg_control == BG3CNT) { return; }
 
 			//Render BG0 and BG1 as Text (same as Mode 0)
-			else { return render_bg_mode_0(bg_control); } 
+			else { render_bg_mode_0(bg_control, first_pixel, last_pixel); } 
 
 			break;
 
 		//BG Mode 2
 		case 0x2:
 			//Render BG2 and BG3 as Scaled+Rotation
-			if((bg_control == BG2CNT) || (bg_control == BG3CNT)) { return render_bg_mode_1(bg_control); }
-			else { return false; }
+			if((bg_control == BG2CNT) || (bg_control == BG3CNT)) { render_bg_mode_1(bg_control, first_pixel, last_pixel); }
 
 			break;
 
 		//BG Mode 3
 		case 3:
-			return render_bg_mode_3(); break;
+			render_bg_mode_3(bg_control, first_pixel, last_pixel); break;
 
 		//BG Mode 4
 		case 4:
-			return render_bg_mode_4(); break;
+			render_bg_mode_4(bg_control, first_pixel, last_pixel); break;
 
 		//BG Mode 5
 		case 5:
-			return render_bg_mode_5(); break;
+			render_bg_mode_5(bg_control, first_pixel, last_pixel); break;
 
 		default:
 			//std::cout<<"LCD::invalid or unsupported BG Mode : " << std::dec << (lcd_stat.display_control & 0x7);
-			return false;
+			return;
 	}
 }
 
-/****** Render BG Mode 0 ******/
-bool AGB_LCD::render_bg_mode_0(u32 bg_control)
+/****** Determines the window status of a run of pixels on the current scanline ******/
+void AGB_LCD::render_window_line(u32 first_pixel, u32 last_pixel)
 {
-	//Set BG ID to determine which BG is being rendered.
-	u8 bg_id = (bg_control - 0x4000008) >> 1;
-	
-	//BG offset
-	u16 screen_offset = 0;
+	bool check_y[2] = { false, false };
 
-	//Determine meta x-coordinate of rendered BG pixel
-	u16 meta_x = ((scanline_pixel_counter + lcd_stat.bg_offset_x[bg_id]) % lcd_stat.mode_0_width[bg_id]);
+	//Vertical window status is the same for the whole line
+	for(int w = 0; w < 2; w++)
+	{
+		if(!lcd_stat.window_enable[w]) { continue; }
 
-	//Determine meta Y-coordinate of rendered BG pixel
-	u16 meta_y = ((current_scanline + lcd_stat.bg_offset_y[bg_id]) % lcd_stat.mode_0_height[bg_id]);
-	
-	//Determine the address offset for the screen
-	switch(lcd_stat.bg_size[bg_id])
+		if((lcd_stat.window_y1[w] <= lcd_stat.window_y2[w]) && (current_scanline >= lcd_stat.window_y1[w]) && (current_scanline < lcd_stat.window_y2[w]))
+		{
+			check_y[w] = true;
+		}
+
+		else if((lcd_stat.window_y1[w] > lcd_stat.window_y2[w]) && ((current_scanline >= lcd_stat.window_y1[w]) || (current_scanline < lcd_stat.window_y2[w])))
+		{
+			check_y[w] = true;
+		}
+	}
+
+	for(u32 x = first_pixel; x < last_pixel; x++)
 	{
-		//Size 0 - 256x256
-		case 0x0: break;
+		win_in[x] = false;
+		win_id[x] = 0;
 
-		//Size 1 - 512x256
-		case 0x1: 
-			screen_offset = lcd_stat.screen_offset_lut[meta_x];
-			break;
+		//Window 0 takes priority over Window 1
+		for(int w = 0; w < 2; w++)
+		{
+			if(!check_y[w]) { continue; }
 
-		//Size 2 - 256x512
-		case 0x2:
-			screen_offset = lcd_stat.screen_offset_lut[meta_y];
-			break;
+			bool check_x = false;
 
-		//Size 3 - 512x512
-		case 0x3:
-			screen_offset = (meta_y > 255) ? (lcd_stat.screen_offset_lut[meta_x] | 0x1000) : lcd_stat.screen_offset_lut[meta_x];
-			break;
+			if((lcd_stat.window_x1[w] <= lcd_stat.window_x2[w]) && (x >= lcd_stat.window_x1[w]) && (x <= lcd_stat.window_x2[w]))
+			{
+				check_x = true;
+			}
+
+			else if((lcd_stat.window_x1[w] > lcd_stat.window_x2[w]) && ((x >= lcd_stat.window_x1[w]) || (x <= lcd_stat.window_x2[w])))
+			{
+				check_x = true;
+			}
+
+			if(check_x)
+			{
+				win_in[x] = true;
+				win_id[x] = w;
+				break;
+			}
+		}
 	}
+}
+
+/****** Determines if a sprite pixel should be rendered, and if so draws it to the current scanline pixel ******/
+bool AGB_LCD::render_sprite_pixel()
+{
+	u32 x = scanline_pixel_counter;
+
+	//Set a flag if the LCD passed over an OBJ Window sprite's pixel
+	if(obj_line.obj_win[x]) { obj_win_pixel = true; }
+
+	if(!obj_line.opaque[x]) { return false; }
+
+	scanline_buffer[x] = obj_line.color[x];
+	last_raw_color = obj_line.raw_color[x];
+	last_obj_priority = obj_line.priority[x];
+	last_obj_mode = obj_line.mode[x];
+
+	return true;
+}
 
-	//Add screen offset to current BG map base address
-	u32 map_base_addr = lcd_stat.bg_base_map_addr[bg_id] + screen_offset;
+/****** Determines if a background pixel should be rendered, and if so draws it to the current scanline pixel ******/
+bool AGB_LCD::render_bg_pixel(u32 bg_control)
+{
+	u8 bg_id = (bg_control - 0x4000008) >> 1;
+	u32 x = scanline_pixel_counter;
+
+	if(!bg_line[bg_id].opaque[x]) { return false; }
 
-	//Determine the X-Y coordinates of the BG's tile on the tile map
-	u16 current_tile_pixel_x = ((scanline_pixel_counter + lcd_stat.bg_offset_x[bg_id]) % 256);
+	scanline_buffer[x] = bg_line[bg_id].color[x];
+	last_raw_color = bg_line[bg_id].raw_color[x];
+
+	return true;
+}
+
+/****** Render BG Mode 0 ******/
+void AGB_LCD::render_bg_mode_0(u32 bg_control, u32 first_pixel, u32 last_pixel)
+{
+	//Set BG ID to determine which BG is being rendered.
+	u8 bg_id = (bg_control - 0x4000008) >> 1;
+
+	//Determine meta Y-coordinate of rendered BG pixels - Same for the whole line
+	u16 meta_y = ((current_scanline + lcd_stat.bg_offset_y[bg_id]) % lcd_stat.mode_0_height[bg_id]);
 	u16 current_tile_pixel_y = ((current_scanline + lcd_stat.bg_offset_y[bg_id]) % 256);
 
 	//Handle mosiac tiles
-	if(lcd_stat.bg_mosiac[bg_id] && lcd_stat.bg_mos_hsize) { current_tile_pixel_x = ((current_tile_pixel_x / lcd_stat.bg_mos_hsize) * lcd_stat.bg_mos_hsize); }
 	if(lcd_stat.bg_mosiac[bg_id] && lcd_stat.bg_mos_vsize) { current_tile_pixel_y = ((current_tile_pixel_y / lcd_stat.bg_mos_vsize) * lcd_stat.bg_mos_vsize); }
 
-	//Get current map entry for rendered pixel
-	u16 tile_number = lcd_stat.bg_num_lut[current_tile_pixel_x][current_tile_pixel_y];
+	bool mosiac_x = (lcd_stat.bg_mosiac[bg_id] && lcd_stat.bg_mos_hsize);
 
-	//Grab the map's data
-	u16 map_data = mem->read_u16_fast(map_base_addr + (tile_number * 2));
+	//Draw one tile at a time
+	for(u32 x = first_pixel; x < last_pixel;)
+	{
+		//BG offset
+		u16 screen_offset = 0;
 
-	//Look at the Tile Map #(tile_number), see what Tile # it points to
-	u16 map_entry = map_data & 0x3FF;
+		//Determine meta x-coordinate of rendered BG pixel
+		u16 meta_x = ((x + lcd_stat.bg_offset_x[bg_id]) % lcd_stat.mode_0_width[bg_id]);
+	
+		//Determine the address offset for the screen
+		switch(lcd_stat.bg_size[bg_id])
+		{
+			//Size 0 - 256x256
+			case 0x0: break;
+
+			//Size 1 - 512x256
+			case 0x1: 
+				screen_offset = lcd_stat.screen_offset_lut[meta_x];
+				break;
+
+			//Size 2 - 256x512
+			case 0x2:
+				screen_offset = lcd_stat.screen_offset_lut[meta_y];
+				break;
+
+			//Size 3 - 512x512
+			case 0x3:
+				screen_offset = (meta_y > 255) ? (lcd_stat.screen_offset_lut[meta_x] | 0x1000) : lcd_stat.screen_offset_lut[meta_x];
+				break;
+		}
 
-	//Grab horizontal and vertical flipping options
-	u8 flip_options = (map_data >> 10) & 0x3;
+		//Add screen offset to current BG map base address
+		u32 map_base_addr = lcd_stat.bg_base_map_addr[bg_id] + screen_offset;
 
-	//Grab the Palette number of the tiles
-	u8 palette_number = (map_data >> 12);
+		//Determine the X coordinate of the BG's tile on the tile map
+		u16 current_tile_pixel_x = ((x + lcd_stat.bg_offset_x[bg_id]) % 256);
 
-	//Get address of Tile #(map_entry)
-	u32 tile_addr = lcd_stat.bg_base_tile_addr[bg_id] + (map_entry * (lcd_stat.bg_depth[bg_id] << 3));
+		//Every pixel up to the end of this tile uses the same map entry
+		//Mosiac tiles are drawn one pixel at a time
+		u32 run = 8 - (current_tile_pixel_x & 0x7);
+		if(mosiac_x) { current_tile_pixel_x = ((current_tile_pixel_x / lcd_stat.bg_mos_hsize) * lcd_stat.bg_mos_hsize); run = 1; }
+		if(run > (last_pixel - x)) { run = last_pixel - x; }
 
-	switch(flip_options)
-	{
-		case 0x0: break;
+		//Get current map entry for rendered pixel
+		u16 tile_number = lcd_stat.bg_num_lut[current_tile_pixel_x][current_tile_pixel_y];
 
-		//Horizontal flip
-		case 0x1: 
-			current_tile_pixel_x = lcd_stat.bg_flip_lut[current_tile_pixel_x];
-			break;
+		//Grab the map's data
+		u16 map_data = mem->read_u16_fast(map_base_addr + (tile_number * 2));
 
-		//Vertical flip
-		case 0x2:
-			current_tile_pixel_y = lcd_stat.bg_flip_lut[current_tile_pixel_y];
-			break;
+		//Look at the Tile Map #(tile_number), see what Tile # it points to
+		u16 map_entry = map_data & 0x3FF;
 
-		//Horizontal + vertical flip
-		case 0x3:
-			current_tile_pixel_x = lcd_stat.bg_flip_lut[current_tile_pixel_x];
-			current_tile_pixel_y = lcd_stat.bg_flip_lut[current_tile_pixel_y];
-			break;
-	}
+		//Grab horizontal and vertical flipping options
+		u8 flip_options = (map_data >> 10) & 0x3;
 
-	u8 current_tile_pixel = lcd_stat.bg_tile_lut[current_tile_pixel_x][current_tile_pixel_y];
+		//Grab the Palette number of the tiles
+		u8 palette_number = (map_data >> 12);
 
-	//Grab the byte corresponding to (current_tile_pixel), render it as ARGB - 4-bit version
-	if(lcd_stat.bg_depth[bg_id] == 4)
-	{
-		tile_addr += (current_tile_pixel >> 1);
-		u8 raw_color = mem->memory_map[tile_addr];
+		//Get address of Tile #(map_entry)
+		u32 tile_addr = lcd_stat.bg_base_tile_addr[bg_id] + (map_entry * (lcd_stat.bg_depth[bg_id] << 3));
 
-		if((current_tile_pixel % 2) == 0) { raw_color &= 0xF; }
-		else { raw_color >>= 4; }
+		//Vertical flip picks the row, horizontal flip reads it backwards
+		u8 tile_x = (current_tile_pixel_x & 0x7);
+		u8 tile_y = (flip_options & 0x2) ? (7 - (current_tile_pixel_y & 0x7)) : (current_tile_pixel_y & 0x7);
 
-		//If the bg color is transparent, abort drawing
-		if(raw_color == 0) { return false; }
+		//Grab palette indices for this row - 4-bit tiles come from the decoded tile cache, 8-bit tiles already hold one index per byte
+		const u8* tile_row;
+		u16 pal_base;
 
-		scanline_buffer[scanline_pixel_counter] = pal[((palette_number * 32) + (raw_color * 2)) >> 1][0];
-		last_raw_color = raw_pal[((palette_number * 32) + (raw_color * 2)) >> 1][0];
-	}
+		if(lcd_stat.bg_depth[bg_id] == 4)
+		{
+			tile_row = get_decoded_tile(tile_addr) + (tile_y * 8);
+			pal_base = (palette_number << 4);
+		}
 
-	//Grab the byte corresponding to (current_tile_pixel), render it as ARGB - 8-bit version
-	else
-	{
-		tile_addr += current_tile_pixel;
-		u8 raw_color = mem->memory_map[tile_addr];
+		else
+		{
+			tile_row = mem->memory_map.read_ptr(tile_addr + (tile_y * 8));
+			pal_base = 0;
+		}
 
-		//If the bg color is transparent, abort drawing
-		if(raw_color == 0) { return false; }
+		for(u32 end = x + run; x < end; x++, tile_x++)
+		{
+			u8 raw_color = tile_row[(flip_options & 0x1) ? (7 - tile_x) : tile_x];
 
-		scanline_buffer[scanline_pixel_counter] = pal[raw_color][0];
-		last_raw_color = raw_pal[raw_color][0];
-	}
+			//If the bg color is transparent, skip drawing
+			if(raw_color == 0) { continue; }
 
-	return true;
+			bg_line[bg_id].color[x] = pal[pal_base + raw_color][0];
+			bg_line[bg_id].raw_color[x] = raw_pal[pal_base + raw_color][0];
+			bg_line[bg_id].opaque[x] = true;
+		}
+	}
 }
 
 /****** Render BG Mode 1 ******/
-bool AGB_LCD::render_bg_mode_1(u32 bg_control)
+void AGB_LCD::render_bg_mode_1(u32 bg_control, u32 first_pixel, u32 last_pixel)
 {
 	//Set BG ID to determine which BG is being rendered.
 	u8 bg_id = (bg_control - 0x4000008) >> 1;
 	u8 scale_rot_id = (bg_id == 2) ? 0 : 1;
 
-	//If rendering pixels along a given line, add DX and DY
-	lcd_stat.bg_affine[scale_rot_id].x_pos = lcd_stat.bg_affine[scale_rot_id].x_ref + (lcd_stat.bg_affine[scale_rot_id].dx * scanline_pixel_counter);
-	lcd_stat.bg_affine[scale_rot_id].y_pos = lcd_stat.bg_affine[scale_rot_id].y_ref + (lcd_stat.bg_affine[scale_rot_id].dy * scanline_pixel_counter);
-
 	//Get BG size in tiles, pixels
 	//0 - 128x128, 1 - 256x256, 2 - 512x512, 3 - 1024x1024
 	u16 bg_tile_size = (16 << (lcd_stat.bg_control[bg_id] >> 14));
 	u16 bg_pixel_size = bg_tile_size << 3;
 
-	//Calculate new X-Y coordinates from scaling+rotation
-	double new_x = lcd_stat.bg_affine[scale_rot_id].x_pos;
-	double new_y = lcd_stat.bg_affine[scale_rot_id].y_pos;
-
-	//Clip BG if coordinates overflow and overflow flag is not set
-	if(!lcd_stat.bg_affine[scale_rot_id].overflow)
+	for(u32 x = first_pixel; x < last_pixel; x++)
 	{
-		if((new_x >= bg_pixel_size) || (new_x < 0)) { return false; }
-		if((new_y >= bg_pixel_size) || (new_y < 0)) { return false; }
-	}
+		//If rendering pixels along a given line, add DX and DY
+		lcd_stat.bg_affine[scale_rot_id].x_pos = lcd_stat.bg_affine[scale_rot_id].x_ref + (lcd_stat.bg_affine[scale_rot_id].dx * x);
+		lcd_stat.bg_affine[scale_rot_id].y_pos = lcd_stat.bg_affine[scale_rot_id].y_ref + (lcd_stat.bg_affine[scale_rot_id].dy * x);
 
-	//Wrap BG if coordinates overflow and overflow flag is set
-	else 
-	{
-		while(new_x >= bg_pixel_size) { new_x -= bg_pixel_size; }
-		while(new_y >= bg_pixel_size) { new_y -= bg_pixel_size; }
-		while(new_x < 0) { new_x += bg_pixel_size; }
-		while(new_y < 0) { new_y += bg_pixel_size; } 
-	}
+		//Calculate new X-Y coordinates from scaling+rotation
+		double new_x = lcd_stat.bg_affine[scale_rot_id].x_pos;
+		double new_y = lcd_stat.bg_affine[scale_rot_id].y_pos;
 
-	//Determine source pixel X-Y coordinates
-	u16 src_x = new_x; 
-	u16 src_y = new_y;
+		//Clip BG if coordinates overflow and overflow flag is not set
+		if(!lcd_stat.bg_affine[scale_rot_id].overflow)
+		{
+			if((new_x >= bg_pixel_size) || (new_x < 0)) { continue; }
+			if((new_y >= bg_pixel_size) || (new_y < 0)) { continue; }
+		}
 
-	//Handle mosiac tiles
-	if(lcd_stat.bg_mosiac[bg_id] && lcd_stat.bg_mos_hsize) { src_x = ((src_x / lcd_stat.bg_mos_hsize) * lcd_stat.bg_mos_hsize); }
-	if(lcd_stat.bg_mosiac[bg_id] && lcd_stat.bg_mos_vsize) { src_y = ((src_y / lcd_stat.bg_mos_vsize) * lcd_stat.bg_mos_vsize); }
+		//Wrap BG if coordinates overflow and overflow flag is set
+		else 
+		{
+			while(new_x >= bg_pixel_size) { new_x -= bg_pixel_size; }
+			while(new_y >= bg_pixel_size) { new_y -= bg_pixel_size; }
+			while(new_x < 0) { new_x += bg_pixel_size; }
+			while(new_y < 0) { new_y += bg_pixel_size; } 
+		}
 
-	//Get current map entry for rendered pixel
-	u16 tile_number = ((src_y / 8) * bg_tile_size) + (src_x / 8);
+		//Determine source pixel X-Y coordinates
+		u16 src_x = new_x; 
+		u16 src_y = new_y;
 
-	//Look at the Tile Map #(tile_number), see what Tile # it points to
-	u8 map_entry = mem->memory_map[lcd_stat.bg_base_map_addr[bg_id] + tile_number];
+		//Handle mosiac tiles
+		if(lcd_stat.bg_mosiac[bg_id] && lcd_stat.bg_mos_hsize) { src_x = ((src_x / lcd_stat.bg_mos_hsize) * lcd_stat.bg_mos_hsize); }
+		if(lcd_stat.bg_mosiac[bg_id] && lcd_stat.bg_mos_vsize) { src_y = ((src_y / lcd_stat.bg_mos_vsize) * lcd_stat.bg_mos_vsize); }
 
-	//Get address of Tile #(map_entry)
-	u32 tile_addr = lcd_stat.bg_base_tile_addr[bg_id] + (map_entry * 64);
+		//Get current map entry for rendered pixel
+		u16 tile_number = ((src_y / 8) * bg_tile_size) + (src_x / 8);
 
-	u8 current_tile_pixel = ((src_y % 8) * 8) + (src_x % 8);
+		//Look at the Tile Map #(tile_number), see what Tile # it points to
+		u8 map_entry = mem->memory_map.read(lcd_stat.bg_base_map_addr[bg_id] + tile_number);
 
-	//Grab the byte corresponding to (current_tile_pixel), render it as ARGB - 8-bit version
-	tile_addr += current_tile_pixel;
-	u8 raw_color = mem->memory_map[tile_addr];
+		//Get address of Tile #(map_entry)
+		u32 tile_addr = lcd_stat.bg_base_tile_addr[bg_id] + (map_entry * 64);
 
-	//If the bg color is transparent, abort drawing
-	if(raw_color == 0) { return false; }
+		u8 current_tile_pixel = ((src_y % 8) * 8) + (src_x % 8);
 
-	scanline_buffer[scanline_pixel_counter] = pal[raw_color][0];
-	last_raw_color = raw_pal[raw_color][0];
+		//Grab the byte corresponding to (current_tile_pixel), render it as ARGB - 8-bit version
+		tile_addr += current_tile_pixel;
+		u8 raw_color = mem->memory_map.read(tile_addr);
 
-	return true;
+		//If the bg color is transparent, skip drawing
+		if(raw_color == 0) { continue; }
+
+		bg_line[bg_id].color[x] = pal[raw_color][0];
+		bg_line[bg_id].raw_color[x] = raw_pal[raw_color][0];
+		bg_line[bg_id].opaque[x] = true;
+	}
 }
 
 /****** Render BG Mode 3 ******/
-bool AGB_LCD::render_bg_mode_3()
+void AGB_LCD::render_bg_mode_3(u32 bg_control, u32 first_pixel, u32 last_pixel)
 {
-	//If rendering pixels along a given line, add DX and DY
-	lcd_stat.bg_affine[0].x_pos = lcd_stat.bg_affine[0].x_ref + (lcd_stat.bg_affine[0].dx * scanline_pixel_counter);
-	lcd_stat.bg_affine[0].y_pos = lcd_stat.bg_affine[0].y_ref + (lcd_stat.bg_affine[0].dy * scanline_pixel_counter);
+	u8 bg_id = (bg_control - 0x4000008) >> 1;
 
-	//Clip affine coordinates if out-of-bounds
-	if((lcd_stat.bg_affine[0].x_pos >= 240) || (lcd_stat.bg_affine[0].x_pos < 0)) { return false; }
-	if((lcd_stat.bg_affine[0].y_pos >= 160) || (lcd_stat.bg_affine[0].y_pos < 0)) { return false; }
+	for(u32 x = first_pixel; x < last_pixel; x++)
+	{
+		//If rendering pixels along a given line, add DX and DY
+		lcd_stat.bg_affine[0].x_pos = lcd_stat.bg_affine[0].x_ref + (lcd_stat.bg_affine[0].dx * x);
+		lcd_stat.bg_affine[0].y_pos = lcd_stat.bg_affine[0].y_ref + (lcd_stat.bg_affine[0].dy * x);
 
-	u16 src_x = lcd_stat.bg_affine[0].x_pos; 
-	u16 src_y = lcd_stat.bg_affine[0].y_pos;
+		//Clip affine coordinates if out-of-bounds
+		if((lcd_stat.bg_affine[0].x_pos >= 240) || (lcd_stat.bg_affine[0].x_pos < 0)) { continue; }
+		if((lcd_stat.bg_affine[0].y_pos >= 160) || (lcd_stat.bg_affine[0].y_pos < 0)) { continue; }
 
-	//Determine which byte in VRAM to read for color data
-	u16 color_bytes = mem->read_u16_fast(0x6000000 + (src_y * 480) + (src_x * 2));
-	last_raw_color = color_bytes;
+		u16 src_x = lcd_stat.bg_affine[0].x_pos; 
+		u16 src_y = lcd_stat.bg_affine[0].y_pos;
 
-	//ARGB conversion
-	u8 red = ((color_bytes & 0x1F) * 8);
-	color_bytes >>= 5;
+		//Determine which byte in VRAM to read for color data
+		u16 color_bytes = mem->read_u16_fast(0x6000000 + (src_y * 480) + (src_x * 2));
+		bg_line[bg_id].raw_color[x] = color_bytes;
 
-	u8 green = ((color_bytes & 0x1F) * 8);
-	color_bytes >>= 5;
+		//ARGB conversion
+		u8 red = ((color_bytes & 0x1F) * 8);
+		color_bytes >>= 5;
 
-	u8 blue = ((color_bytes & 0x1F) * 8);
+		u8 green = ((color_bytes & 0x1F) * 8);
+		color_bytes >>= 5;
 
-	scanline_buffer[scanline_pixel_counter] = 0xFF000000 | (red << 16) | (green << 8) | (blue);
+		u8 blue = ((color_bytes & 0x1F) * 8);
 
-	return true;
+		bg_line[bg_id].color[x] = 0xFF000000 | (red << 16) | (green << 8) | (blue);
+		bg_line[bg_id].opaque[x] = true;
+	}
 }
 
 /****** Render BG Mode 4 ******/
-bool AGB_LCD::render_bg_mode_4()
+void AGB_LCD::render_bg_mode_4(u32 bg_control, u32 first_pixel, u32 last_pixel)
 {
-	//If rendering pixels along a given line, add DX and DY
-	lcd_stat.bg_affine[0].x_pos = lcd_stat.bg_affine[0].x_ref + (lcd_stat.bg_affine[0].dx * scanline_pixel_counter);
-	lcd_stat.bg_affine[0].y_pos = lcd_stat.bg_affine[0].y_ref + (lcd_stat.bg_affine[0].dy * scanline_pixel_counter);
+	u8 bg_id = (bg_control - 0x4000008) >> 1;
 
-	//Clip affine coordinates if out-of-bounds
-	if((lcd_stat.bg_affine[0].x_pos >= 240) || (lcd_stat.bg_affine[0].x_pos < 0)) { return false; }
-	if((lcd_stat.bg_affine[0].y_pos >= 160) || (lcd_stat.bg_affine[0].y_pos < 0)) { return false; }
+	for(u32 x = first_pixel; x < last_pixel; x++)
+	{
+		//If rendering pixels along a given line, add DX and DY
+		lcd_stat.bg_affine[0].x_pos = lcd_stat.bg_affine[0].x_ref + (lcd_stat.bg_affine[0].dx * x);
+		lcd_stat.bg_affine[0].y_pos = lcd_stat.bg_affine[0].y_ref + (lcd_stat.bg_affine[0].dy * x);
 
-	u16 src_x = lcd_stat.bg_affine[0].x_pos; 
-	u16 src_y = lcd_stat.bg_affine[0].y_pos;
+		//Clip affine coordinates if out-of-bounds
+		if((lcd_stat.bg_affine[0].x_pos >= 240) || (lcd_stat.bg_affine[0].x_pos < 0)) { continue; }
+		if((lcd_stat.bg_affine[0].y_pos >= 160) || (lcd_stat.bg_affine[0].y_pos < 0)) { continue; }
 
-	//Determine which byte in VRAM to read for color data
-	u32 bitmap_entry = (lcd_stat.frame_base + (src_y * 240) + src_x);
+		u16 src_x = lcd_stat.bg_affine[0].x_pos; 
+		u16 src_y = lcd_stat.bg_affine[0].y_pos;
 
-	u8 raw_color = mem->memory_map[bitmap_entry];
-	if(raw_color == 0) { return false; }
+		//Determine which byte in VRAM to read for color data
+		u32 bitmap_entry = (lcd_stat.frame_base + (src_y * 240) + src_x);
 
-	scanline_buffer[scanline_pixel_counter] = pal[raw_color][0];
-	last_raw_color = raw_pal[raw_color][0];
+		u8 raw_color = mem->memory_map.read(bitmap_entry);
+		if(raw_color == 0) { continue; }
 
-	return true;
+		bg_line[bg_id].color[x] = pal[raw_color][0];
+		bg_line[bg_id].raw_color[x] = raw_pal[raw_color][0];
+		bg_line[bg_id].opaque[x] = true;
+	}
 }
 
 /****** Render BG Mode 5 ******/
-bool AGB_LCD::render_bg_mode_5()
+void AGB_LCD::render_bg_mode_5(u32 bg_control, u32 first_pixel, u32 last_pixel)
 {
-	//If rendering pixels along a given line, add DX and DY
-	lcd_stat.bg_affine[0].x_pos = lcd_stat.bg_affine[0].x_ref + (lcd_stat.bg_affine[0].dx * scanline_pixel_counter);
-	lcd_stat.bg_affine[0].y_pos = lcd_stat.bg_affine[0].y_ref + (lcd_stat.bg_affine[0].dy * scanline_pixel_counter);
+	u8 bg_id = (bg_control - 0x4000008) >> 1;
 
-	//Clip affine coordinates if out-of-bounds
-	if((lcd_stat.bg_affine[0].x_pos >= 160) || (lcd_stat.bg_affine[0].x_pos < 0)) { return false; }
-	if((lcd_stat.bg_affine[0].y_pos >= 128) || (lcd_stat.bg_affine[0].y_pos < 0)) { return false; }
+	for(u32 x = first_pixel; x < last_pixel; x++)
+	{
+		//If rendering pixels along a given line, add DX and DY
+		lcd_stat.bg_affine[0].x_pos = lcd_stat.bg_affine[0].x_ref + (lcd_stat.bg_affine[0].dx * x);
+		lcd_stat.bg_affine[0].y_pos = lcd_stat.bg_affine[0].y_ref + (lcd_stat.bg_affine[0].dy * x);
 
-	u16 src_x = lcd_stat.bg_affine[0].x_pos; 
-	u16 src_y = lcd_stat.bg_affine[0].y_pos;
+		//Clip affine coordinates if out-of-bounds
+		if((lcd_stat.bg_affine[0].x_pos >= 160) || (lcd_stat.bg_affine[0].x_pos < 0)) { continue; }
+		if((lcd_stat.bg_affine[0].y_pos >= 128) || (lcd_stat.bg_affine[0].y_pos < 0)) { continue; }
 
-	//Determine which byte in VRAM to read for color data
-	u16 color_bytes = mem->read_u16_fast(lcd_stat.frame_base + (src_y * 320) + (src_x * 2));
-	last_raw_color = color_bytes;
+		u16 src_x = lcd_stat.bg_affine[0].x_pos; 
+		u16 src_y = lcd_stat.bg_affine[0].y_pos;
 
-	//ARGB conversion
-	u8 red = ((color_bytes & 0x1F) * 8);
-	color_bytes >>= 5;
+		//Determine which byte in VRAM to read for color data
+		u16 color_bytes = mem->read_u16_fast(lcd_stat.frame_base + (src_y * 320) + (src_x * 2));
+		bg_line[bg_id].raw_color[x] = color_bytes;
 
-	u8 green = ((color_bytes & 0x1F) * 8);
-	color_bytes >>= 5;
+		//ARGB conversion
+		u8 red = ((color_bytes & 0x1F) * 8);
+		color_bytes >>= 5;
 
-	u8 blue = ((color_bytes & 0x1F) * 8);
+		u8 green = ((color_bytes & 0x1F) * 8);
+		color_bytes >>= 5;
 
-	scanline_buffer[scanline_pixel_counter] = 0xFF000000 | (red << 16) | (green << 8) | (blue);
+		u8 blue = ((color_bytes & 0x1F) * 8);
 
-	return true;
+		bg_line[bg_id].color[x] = 0xFF000000 | (red << 16) | (green << 8) | (blue);
+		bg_line[bg_id].opaque[x] = true;
+	}
 }
 
-/****** Render pixels for a given scanline (per-pixel) ******/
-void AGB_LCD::render_scanline()
+/****** Returns the palette indices of a 4bpp tile, decoding it again only if VRAM changed since last time ******/
+u8* AGB_LCD::get_decoded_tile(u32 tile_addr)
 {
-	bool obj_render = false;
-	bool winout = false;
-	lcd_stat.in_window = false;
-	lcd_stat.current_window = 0;
-	last_obj_priority = 0xFF;
-	last_bg_priority = 0x5;
-	last_obj_mode = 0;
-	last_raw_color = raw_pal[0][0];
-	obj_win_pixel = false;
-	u8 bg_render_list[4];
-	u8 bg_id;
+	tile_addr &= ~0x1F;
 
-	//Render sprites
-	obj_render = render_sprite_pixel();
-
-	bool check_x = false;
-	bool check_y = false;
+	//Tiles outside of VRAM are never cached
+	u8* tile = tile_scratch;
+	u16 tile_id = (tile_addr >> 5) & 0xFFF;
 
-	//Determine window status of this pixel
-	if(lcd_stat.window_enable[0])
+	if((tile_addr >= 0x6000000) && (tile_addr <= 0x601FFFF))
 	{
-		if((lcd_stat.window_x1[0] <= lcd_stat.window_x2[0]) && (scanline_pixel_counter >= lcd_stat.window_x1[0]) && (scanline_pixel_counter <= lcd_stat.window_x2[0]))
-		{
-			check_x = true;
-		}
-
-		else if((lcd_stat.window_x1[0] > lcd_stat.window_x2[0]) && ((scanline_pixel_counter >= lcd_stat.window_x1[0]) || (scanline_pixel_counter <= lcd_stat.window_x2[0])))
-		{
-			check_x = true;
-		}
-
-		if((lcd_stat.window_y1[0] <= lcd_stat.window_y2[0]) && (current_scanline >= lcd_stat.window_y1[0]) && (current_scanline < lcd_stat.window_y2[0]))
-		{
-			check_y = true;
-		}
-
-		else if((lcd_stat.window_y1[0] > lcd_stat.window_y2[0]) && ((current_scanline >= lcd_stat.window_y1[0]) || (current_scanline < lcd_stat.window_y2[0])))
-		{
-			check_y = true;
-		}
-		
-		if(check_x && check_y) { lcd_stat.in_window = true; lcd_stat.current_window = 0; }
+		tile = tile_cache[tile_id];
+		if(!lcd_stat.vram_tile_update_list[tile_id]) { return tile; }
+		lcd_stat.vram_tile_update_list[tile_id] = false;
 	}
 
-	
-	if((lcd_stat.window_enable[1]) && (!lcd_stat.in_window))
+	//Each byte holds 2 pixels, low nibble first
+	for(u32 x = 0; x < 32; x++)
 	{
-		check_x = false;
-		check_y = false;
+		u8 data = mem->memory_map.read(tile_addr + x);
+		tile[x << 1] = (data & 0xF);
+		tile[(x << 1) + 1] = (data >> 4);
+	}
 
-		if((lcd_stat.window_x1[1] <= lcd_stat.window_x2[1]) && (scanline_pixel_counter >= lcd_stat.window_x1[1]) && (scanline_pixel_counter <= lcd_stat.window_x2[1]))
-		{
-			check_x = true;
-		}
+	return tile;
+}
 
-		else if((lcd_stat.window_x1[1] > lcd_stat.window_x2[1]) && ((scanline_pixel_counter >= lcd_stat.window_x1[1]) || (scanline_pixel_counter <= lcd_stat.window_x2[1])))
-		{
-			check_x = true;
-		}
+/****** Renders the current scanline up to (but not including) the given pixel ******/
+void AGB_LCD::render_scanline(u32 last_pixel)
+{
+	if(last_pixel > 240) { last_pixel = 240; }
+	if(scanline_pixel_counter >= last_pixel) { return; }
 
-		if((lcd_stat.window_y1[1] <= lcd_stat.window_y2[1]) && (current_scanline >= lcd_stat.window_y1[1]) && (current_scanline < lcd_stat.window_y2[1]))
-		{
-			check_y = true;
-		}
+	u32 first_pixel = scanline_pixel_counter;
 
-		else if((lcd_stat.window_y1[1] > lcd_stat.window_y2[1]) && ((current_scanline >= lcd_stat.window_y1[1]) || (current_scanline < lcd_stat.window_y2[1])))
-		{
-			check_y = true;
-		}
-		
-		if(check_x && check_y) { lcd_stat.in_window = true; lcd_stat.current_window = 1; }
-	}
-	
+	//Draw each layer for this run of pixels
+	render_obj_line(first_pixel, last_pixel);
 
-	//Turn off OBJ rendering if in/out of a window where OBJ rendering is disabled
-	if((lcd_stat.obj_win_enable) && (obj_win_pixel)) { }
-	else if((lcd_stat.window_enable[lcd_stat.current_window]) && (!lcd_stat.in_window) && (!lcd_stat.window_out_enable[4][0])) { obj_render = false; }
-	else if((lcd_stat.window_enable[lcd_stat.current_window]) && (lcd_stat.in_window) && (!lcd_stat.window_in_enable[4][lcd_stat.current_window])) { obj_render = false; }
+	for(u32 x = 0; x < 4; x++) { render_bg_line(BG0CNT + (x << 1), first_pixel, last_pixel); }
 
-	//Also turn off OBJ rendering if OBJ Window is enabled, but rendered pixel is outside any OBJ Window
-	else if((!lcd_stat.in_window) && (lcd_stat.obj_win_enable) && (!obj_win_pixel) && (!lcd_stat.window_out_enable[4][0])) { obj_render = false; }
+	render_window_line(first_pixel, last_pixel);
 
 	//Determine WINOUT status
-	winout = (lcd_stat.obj_win_enable || lcd_stat.window_enable[0] || lcd_stat.window_enable[1]);
+	winout_enable = (lcd_stat.obj_win_enable || lcd_stat.window_enable[0] || lcd_stat.window_enable[1]);
 
 	//Determine BG rendering priority
 	for(int x = 0, list_length = 0; x < 4; x++)
@@ -1106,6 +1147,66 @@ void AGB_LCD::render_scanline()
 		if(lcd_stat.bg_priority[3] == x) { bg_render_list[list_length++] = 3; }
 	}
 
+	//Composite the layers one pixel at a time
+	if(lcd_stat.current_sfx_type == NORMAL)
+	{
+		for(; scanline_pixel_counter < last_pixel; scanline_pixel_counter++) { render_pixel(); }
+		return;
+	}
+
+	//With SFX, pick out each pixel's targets first, then blend or fade the whole run at once
+	memset(sfx_op + first_pixel, sfx_util::SFX_NONE, last_pixel - first_pixel);
+
+	for(; scanline_pixel_counter < last_pixel; scanline_pixel_counter++)
+	{
+		render_pixel();
+		apply_sfx();
+	}
+
+	sfx_util::apply_line(sfx_op + first_pixel, sfx_color_1 + first_pixel, sfx_color_2 + first_pixel, &scanline_buffer[first_pixel], last_pixel - first_pixel,
+		lcd_stat.alpha_a_coef, lcd_stat.alpha_b_coef, lcd_stat.brightness_coef);
+}
+
+/****** Renders pixels the LCD has already passed on the current scanline - Used before anything the renderer reads changes mid-line ******/
+void AGB_LCD::render_partial_scanline()
+{
+	if(lcd_mode != 0) { return; }
+
+	//Work out how far into the scanline the LCD is on this cycle
+	u32 current_clock = lcd_clock + (mem->scheduler->current_cycle - mem->scheduler->lcd_sync);
+	u32 line_clock = current_clock % 1232;
+	if(line_clock > 960) { line_clock = 960; }
+
+	//Pixels are drawn every 4 cycles. Line 0 starts 1 cycle into the frame, so its first pixel is drawn on cycle 4 instead of 0
+	u32 last_pixel = (current_clock >= 1232) ? ((line_clock >> 2) + 1) : (line_clock >> 2);
+
+	render_scanline(last_pixel);
+}
+
+/****** Composites the layers for the current scanline pixel ******/
+void AGB_LCD::render_pixel()
+{
+	bool obj_render = false;
+	lcd_stat.in_window = win_in[scanline_pixel_counter];
+	lcd_stat.current_window = win_id[scanline_pixel_counter];
+	last_obj_priority = 0xFF;
+	last_bg_priority = 0x5;
+	last_obj_mode = 0;
+	last_raw_color = raw_pal[0][0];
+	obj_win_pixel = false;
+	u8 bg_id;
+
+	//Render sprites
+	obj_render = render_sprite_pixel();
+
+	//Turn off OBJ rendering if in/out of a window where OBJ rendering is disabled
+	if((lcd_stat.obj_win_enable) && (obj_win_pixel)) { }
+	else if((lcd_stat.window_enable[lcd_stat.current_window]) && (!lcd_stat.in_window) && (!lcd_stat.window_out_enable[4][0])) { obj_render = false; }
+	else if((lcd_stat.window_enable[lcd_stat.current_window]) && (lcd_stat.in_window) && (!lcd_stat.window_in_enable[4][lcd_stat.current_window])) { obj_render = false; }
+
+	//Also turn off OBJ rendering if OBJ Window is enabled, but rendered pixel is outside any OBJ Window
+	else if((!lcd_stat.in_window) && (lcd_stat.obj_win_enable) && (!obj_win_pixel) && (!lcd_stat.window_out_enable[4][0])) { obj_render = false; }
+
 	//Render BGs based on priority (3 is the 'lowest', 0 is the 'highest')
 	for(int x = 0; x < 4; x++)
 	{
@@ -1115,7 +1216,7 @@ void AGB_LCD::render_scanline()
 		if((obj_render) && (last_obj_priority <= lcd_stat.bg_priority[bg_id])) { last_bg_priority = 4; return; }
 
 		//If the last BG pixel is outside the current window, and WINOUT disables this BG layer, skip rendering
-		else if((winout) && (!lcd_stat.in_window) && (!lcd_stat.window_out_enable[bg_id][0]) && (!obj_win_pixel)) { continue; }
+		else if((winout_enable) && (!lcd_stat.in_window) && (!lcd_stat.window_out_enable[bg_id][0]) && (!obj_win_pixel)) { continue; }
 
 		//If the last BG pixel is inside the current window, and WININ disables this BG layer, skip rendering
 		else if((lcd_stat.window_enable[lcd_stat.current_window]) && (lcd_stat.in_window) && (!lcd_stat.window_in_enable[bg_id][lcd_stat.current_window])) { continue; }
@@ -1131,7 +1232,7 @@ void AGB_LCD::render_scanline()
 	if(!obj_render) { scanline_buffer[scanline_pixel_counter] = pal[0][0]; }
 }
 
-/****** Applies the GBA's SFX to a pixel ******/
+/****** Determines which of the GBA's SFX apply to a pixel ******/
 void AGB_LCD::apply_sfx()
 {
 	lcd_stat.temp_sfx_type = lcd_stat.current_sfx_type;
@@ -1167,19 +1268,27 @@ void AGB_LCD::apply_sfx()
 
 	if(!do_sfx) { return; }
 
-	//Apply the specified SFX
+	//Queue the specified SFX
 	switch(lcd_stat.current_sfx_type)
 	{
 		case ALPHA_BLEND:
-			scanline_buffer[scanline_pixel_counter] = alpha_blend();
+			{
+				//Searching for targets draws over this pixel, so keep its current color in case no alpha blending occurs
+				u32 final_color = scanline_buffer[scanline_pixel_counter];
+				sfx_op[scanline_pixel_counter] = alpha_blend();
+				if(sfx_op[scanline_pixel_counter] == sfx_util::SFX_NONE) { scanline_buffer[scanline_pixel_counter] = final_color; }
+			}
+
 			break;
 
 		case BRIGHTNESS_UP: 
-			scanline_buffer[scanline_pixel_counter] = brightness_up(); 
+			sfx_op[scanline_pixel_counter] = sfx_util::SFX_BRIGHTEN;
+			sfx_color_1[scanline_pixel_counter] = last_raw_color;
 			break;
 
 		case BRIGHTNESS_DOWN:
-			scanline_buffer[scanline_pixel_counter] = brightness_down(); 
+			sfx_op[scanline_pixel_counter] = sfx_util::SFX_DARKEN;
+			sfx_color_1[scanline_pixel_counter] = last_raw_color;
 			break;
 	}
 
@@ -1187,61 +1296,10 @@ void AGB_LCD::apply_sfx()
 	lcd_stat.temp_sfx_type = NORMAL;
 }
 
-/****** SFX - Increase brightness ******/
-u32 AGB_LCD::brightness_up()
-{
-	u16 color_bytes = last_raw_color;
-	u16 result = 0;
-
-	//Increase RGB intensities
-	u8 red = (color_bytes & 0x1F);
-	result = red + ((0x1F - red) * lcd_stat.brightness_coef);
-	red = (result > 0x1F) ? 0x1F : result;
-	color_bytes >>= 5;
-
-	u8 green = (color_bytes & 0x1F);
-	result = green + ((0x1F - green) * lcd_stat.brightness_coef);
-	green = (result > 0x1F) ? 0x1F : result;
-	color_bytes >>= 5;
-
-	u8 blue = (color_bytes & 0x1F);
-	result = blue + ((0x1F - blue) * lcd_stat.brightness_coef);
-	blue = (result > 0x1F) ? 0x1F : result;
-
-	//Return 32-bit color
-	return 0xFF000000 | (red << 19) | (green << 11) | (blue << 3);
-}
-
-/****** SFX - Decrease brightness ******/
-u32 AGB_LCD::brightness_down()
+/****** SFX - Finds both alpha blending targets for a pixel ******/
+u8 AGB_LCD::alpha_blend()
 {
-	u16 color_bytes = last_raw_color;
-
-	//Decrease RGB intensities 
-	u8 red = (color_bytes & 0x1F);
-	red -= (red * lcd_stat.brightness_coef);
-	color_bytes >>= 5;
-
-	u8 green = (color_bytes & 0x1F);
-	green -= (green * lcd_stat.brightness_coef);
-	color_bytes >>= 5;
-
-	u8 blue = (color_bytes & 0x1F);
-	blue -= (blue * lcd_stat.brightness_coef);
-
-	//Return 32-bit color
-	return 0xFF000000 | (red << 19) | (green << 11) | (blue << 3);
-}
-
-/****** SFX - Alpha blending ******/
-u32 AGB_LCD::alpha_blend()
-{		
-	//Grab the current 32-bit color for this pixel, in case no alpha blending occurs
-	u32 final_color = scanline_buffer[scanline_pixel_counter];
-
 	u16 color_1 = last_raw_color;
-	u16 color_2 = 0x0;
-	u16 result = 0;
 	u8 next_bg_priority = 0;
 	bool do_blending = false;
 
@@ -1273,13 +1331,13 @@ u32 AGB_LCD::alpha_blend()
 	}
 
 	//If the BD is the 1st target, abort alpha blending (no pixel technically exists behind it for blending)
-	if(last_bg_priority == 5) { return final_color; }
+	if(last_bg_priority == 5) { return sfx_util::SFX_NONE; }
 
 	//If BG0-3 was drawn last but is not the 1st target, abort alpha blending
-	if((last_bg_priority < 4) && (!lcd_stat.sfx_target[last_bg_priority][0])) { return final_color; }
+	if((last_bg_priority < 4) && (!lcd_stat.sfx_target[last_bg_priority][0])) { return sfx_util::SFX_NONE; }
 
 	//If no 1st target is set, abort alpha blending unless semi-trasnparent OBJ
-	if(((mem->memory_map[BLDCNT] & 0x3F) == 0) && (last_obj_mode != 1)) { return final_color; }
+	if(((mem->memory_map[BLDCNT] & 0x3F) == 0) && (last_obj_mode != 1)) { return sfx_util::SFX_NONE; }
 
 	//Determine which priority to start looking at to grab the 2nd target
 	u8 current_bg_priority = (last_bg_priority == 4) ? last_obj_priority : lcd_stat.bg_priority[last_bg_priority];
@@ -1309,40 +1367,25 @@ u32 AGB_LCD::alpha_blend()
 	if((!do_blending) && (lcd_stat.sfx_target[5][1])) { last_raw_color = raw_pal[0][0]; do_blending = true; }
 
 	//If the 2nd target is rendered and not specified for blending, abort 
-	if((do_blending) && (!lcd_stat.sfx_target[next_bg_priority][1])) { return final_color; } 
+	if((do_blending) && (!lcd_stat.sfx_target[next_bg_priority][1])) { return sfx_util::SFX_NONE; } 
 
 	if(!do_blending) 
 	{
 		//If no alpha-blending occurs, see if Brightness Increase can be applied (for semi-transparent OBJ only)
-		if(lcd_stat.temp_sfx_type == BRIGHTNESS_UP) { return brightness_up(); }
+		if(lcd_stat.temp_sfx_type == BRIGHTNESS_UP) { sfx_color_1[scanline_pixel_counter] = last_raw_color; return sfx_util::SFX_BRIGHTEN; }
 
 		//If no alpha-blending occurs, see if Brightness Decrease can be applied (for semi-transparent OBJ only)
-		else if(lcd_stat.temp_sfx_type == BRIGHTNESS_DOWN) { return brightness_down(); }
+		else if(lcd_stat.temp_sfx_type == BRIGHTNESS_DOWN) { sfx_color_1[scanline_pixel_counter] = last_raw_color; return sfx_util::SFX_DARKEN; }
 
 		//If no alpha-blending occurs and no fringe cases occur, abort
-		else { return final_color; }
+		else { return sfx_util::SFX_NONE; }
 	}
 
-	color_2 = last_raw_color;
-
 	//Alpha-blending
-	result = ((color_1 & 0x1F) * lcd_stat.alpha_a_coef) + ((color_2 & 0x1F) * lcd_stat.alpha_b_coef);
-	u8 red = (result > 0x1F) ? 0x1F : result;
-	color_1 >>= 5;
-	color_2 >>= 5;
-
-	result = ((color_1 & 0x1F) * lcd_stat.alpha_a_coef) + ((color_2 & 0x1F) * lcd_stat.alpha_b_coef);
-	u8 green = (result > 0x1F) ? 0x1F : result;
-	color_1 >>= 5;
-	color_2 >>= 5;
-
-	result = ((color_1 & 0x1F) * lcd_stat.alpha_a_coef) + ((color_2 & 0x1F) * lcd_stat.alpha_b_coef);
-	u8 blue = (result > 0x1F) ? 0x1F : result;
-	color_1 >>= 5;
-	color_2 >>= 5;
-
-	//Return 32-bit color
-	return 0xFF000000 | (red << 19) | (green << 11) | (blue << 3);
+	sfx_color_1[scanline_pixel_counter] = color_1;
+	sfx_color_2[scanline_pixel_counter] = last_raw_color;
+
+	return sfx_util::SFX_BLEND;
 }
 
 /****** Immediately draw current buffer to the screen ******/
@@ -1480,13 +1523,8 @@ void AGB_LCD::step()
 			}
 		}
 
-		//Render scanline data (per-pixel every 4 cycles)
-		if((lcd_clock % 4) == 0) 
-		{
-			render_scanline();
-			if(lcd_stat.current_sfx_type != NORMAL) { apply_sfx(); }
-			scanline_pixel_counter++;
-		}
+		//Scanline data is rendered a whole line at a time when HBlank starts
+		//Mid-line writes to LCD registers or VRAM render any pixels already passed first (see render_partial_scanline)
 	}
 
 	//Mode 1 - H-Blank
@@ -1499,6 +1537,9 @@ void AGB_LCD::step()
 			mem->memory_map[DISPSTAT] |= 0x2;
 
 			lcd_mode = 1;
+
+			//Render the rest of the scanline
+			render_scanline(240);
 			scanline_pixel_counter = 0;
 
 			//Raise HBlank interrupt
@@ -1796,6 +1837,49 @@ void AGB_LCD::step()
 	}
 }
 
+/****** Returns the number of cycles until the LCD needs to step again ******/
+u32 AGB_LCD::cycles_to_next_event()
+{
+	u32 next_clock = lcd_clock + 1;
+	u32 line_clock = next_clock % 1232;
+
+	//Mode 0 - Scanline rendering
+	if((line_clock <= 960) && (next_clock < 197120))
+	{
+		//Mode change or scanline increment happens immediately
+		if((lcd_mode != 0) || (mem->memory_map[DISPSTAT] & 0x2)) { return 1; }
+
+		//Otherwise, wait for HBlank
+		return (next_clock - line_clock + 961) - lcd_clock;
+	}
+
+	//Mode 1 - H-Blank
+	else if(next_clock < 197120)
+	{
+		if(lcd_mode != 1) { return 1; }
+
+		//Cheats are applied every cycle on some lines
+		if((config::use_cheats) && ((current_scanline & 0x7) == 0)) { return 1; }
+
+		//Otherwise, wait for the next scanline
+		return (next_clock - line_clock + 1232) - lcd_clock;
+	}
+
+	//Mode 2 - VBlank
+	else
+	{
+		if((lcd_mode != 2) || (line_clock == 0)) { return 1; }
+
+		//VBlank flag needs to be toggled
+		bool vblank_flag = (mem->memory_map[DISPSTAT] & 0x1) ? true : false;
+		if(vblank_flag != (current_scanline < 227)) { return 1; }
+
+		//Otherwise, wait for HBlank or the next scanline
+		if(line_clock <= 960) { return (next_clock - line_clock + 960) - lcd_clock; }
+		else { return (next_clock - line_clock + 1232) - lcd_clock; }
+	}
+}
+
 /****** Compare VCOUNT to LYC ******/
 void AGB_LCD::scanline_compare()
 {
@@ -1893,6 +1977,9 @@ bool AGB_LCD::lcd_read(u32 offset, std::string filename)
 	//Serialize LCD data from save state
 	file.read((char*)&lcd_stat, sizeof(lcd_stat));
 
+	//VRAM was reloaded, so decode every tile again
+	for(int x = 0; x < 0x1000; x++) { lcd_stat.vram_tile_update_list[x] = true; }
+
 	//Serialize OBJ data from save state
 	for(int x = 0; x < 128; x++)
 	{
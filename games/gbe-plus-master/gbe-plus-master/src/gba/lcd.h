@@ -31,11 +31,13 @@ class AGB_LCD
 	~AGB_LCD();
 
 	void step();
+	u32 cycles_to_next_event();
 	void reset();
 	bool init();
 	bool opengl_init();
 	void update();
 	void clear_screen_buffer(u32 color);
+	void render_partial_scanline();
 
 	//Serialize data for save state loading/saving
 	bool lcd_read(u32 offset, std::string filename);
@@ -131,6 +133,10 @@ class AGB_LCD
 
 	u32 pal[256][2];
 	u16 raw_pal[256][2];
+
+	//4bpp tiles decoded into palette indices - One tile per 32 bytes of VRAM, redecoded when VRAM changes
+	u8 tile_cache[0x1000][64];
+	u8 tile_scratch[64];
 	u16 bg_offset_x[4];
 	u16 bg_offset_y[4];
 
@@ -138,8 +144,40 @@ class AGB_LCD
 	std::vector<u32> scanline_buffer;
 	std::vector<u32> screen_buffer;
 
+	//Next pixel to composite on the current scanline
 	u32 scanline_pixel_counter;
 
+	//Scanline buffers for each BG and the OBJ layer - Drawn for a run of pixels, then composited
+	struct bg_layer_line
+	{
+		u32 color[240];
+		u16 raw_color[240];
+		bool opaque[240];
+	} bg_line[4];
+
+	struct obj_layer_line
+	{
+		u32 color[240];
+		u16 raw_color[240];
+		u8 priority[240];
+		u8 mode[240];
+		bool opaque[240];
+		bool obj_win[240];
+	} obj_line;
+
+	//Window status of each pixel on the scanline
+	bool win_in[240];
+	u8 win_id[240];
+
+	//BG rendering order and WINOUT status for the current run of pixels
+	u8 bg_render_list[4];
+	bool winout_enable;
+
+	//SFX to apply to each pixel on the scanline and the RGB15 targets they use - Applied for a whole run of pixels at once
+	u8 sfx_op[240];
+	u16 sfx_color_1[240];
+	u16 sfx_color_2[240];
+
 	int frame_start_time;
 	int frame_current_time;
 	int fps_count;
@@ -148,21 +186,24 @@ class AGB_LCD
 
 	bool try_window_rebuild;
 
-	void render_scanline();
+	void render_scanline(u32 last_pixel);
+	void render_pixel();
+	void render_obj_line(u32 first_pixel, u32 last_pixel);
+	void render_bg_line(u32 bg_control, u32 first_pixel, u32 last_pixel);
+	void render_window_line(u32 first_pixel, u32 last_pixel);
 	bool render_sprite_pixel();
 	bool render_bg_pixel(u32 bg_control);
-	bool render_bg_mode_0(u32 bg_control);
-	bool render_bg_mode_1(u32 bg_control);
-	bool render_bg_mode_3();
-	bool render_bg_mode_4();
-	bool render_bg_mode_5();
+	void render_bg_mode_0(u32 bg_control, u32 first_pixel, u32 last_pixel);
+	void render_bg_mode_1(u32 bg_control, u32 first_pixel, u32 last_pixel);
+	void render_bg_mode_3(u32 bg_control, u32 first_pixel, u32 last_pixel);
+	void render_bg_mode_4(u32 bg_control, u32 first_pixel, u32 last_pixel);
+	void render_bg_mode_5(u32 bg_control, u32 first_pixel, u32 last_pixel);
+	u8* get_decoded_tile(u32 tile_addr);
 	void scanline_compare();
 	void reload_affine_references(u32 bg_control);
 
 	void apply_sfx();
-	u32 brightness_up();
-	u32 brightness_down();
-	u32 alpha_blend();
+	u8 alpha_blend();
 };
 
 #endif // GBA_LCD
\ No newline at end of file
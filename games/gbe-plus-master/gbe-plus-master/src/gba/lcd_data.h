@@ -60,9 +60,9 @@ struct agb_lcd_data
 	sfx_types current_sfx_type;
 	sfx_types temp_sfx_type;
 	bool sfx_target[6][2];
-	double brightness_coef;
-	double alpha_a_coef;
-	double alpha_b_coef;
+	u8 brightness_coef;
+	u8 alpha_a_coef;
+	u8 alpha_b_coef;
 
 	u8 bg_flip_lut[256];
 	u16 bg_tile_lut[256][256];
@@ -90,6 +90,8 @@ struct agb_lcd_data
 	bool obj_pal_update;
 	bool obj_pal_update_list[256];
 
+	bool vram_tile_update_list[0x1000];
+
 	u8 bg_mos_hsize;
 	u8 bg_mos_vsize;
 
@@ -9,10 +9,112 @@
 // Handles reading and writing bytes to memory locations
 
 #include <filesystem>
+#include <algorithm>
 
 #include "mmu.h"
+#include "lcd.h"
 #include "common/util.h"
 
+/****** Memory map constructor ******/
+agb_memory::agb_memory()
+{
+	for(u32 x = 0; x < 0x4000; x++) { pages[x] = NULL; }
+
+	//The zero page backs reads of unmapped memory, so it stays around for as long as the memory map does
+	zero_page.resize(0x4000, 0);
+}
+
+/****** Allocates and maps all memory regions, everything is zero-filled ******/
+void agb_memory::reset()
+{
+	clear();
+
+	bios.resize(0x4000, 0);
+	ewram.resize(0x40000, 0);
+	iwram.resize(0x8000, 0);
+	io.resize(0x4000, 0);
+	palette.resize(0x8000, 0);
+	vram.resize(0x18000, 0);
+	oam.resize(0x8000, 0);
+	sram.resize(0x10000, 0);
+
+	//WRAM, Palettes, and OAM mirror across their entire 16MB areas
+	map_region(0x0000000, 0x0003FFF, bios);
+	map_region(0x2000000, 0x2FFFFFF, ewram);
+	map_region(0x3000000, 0x3FFFFFF, iwram);
+	map_region(0x4000000, 0x4003FFF, io);
+	map_region(0x5000000, 0x5FFFFFF, palette);
+	map_region(0x6000000, 0x6017FFF, vram);
+	map_region(0x7000000, 0x7FFFFFF, oam);
+	map_region(0xE000000, 0xE00FFFF, sram);
+}
+
+/****** Frees all memory regions ******/
+void agb_memory::clear()
+{
+	for(u32 x = 0; x < 0x4000; x++) { pages[x] = NULL; }
+
+	bios.clear();
+	ewram.clear();
+	iwram.clear();
+	io.clear();
+	palette.clear();
+	vram.clear();
+	oam.clear();
+	rom.clear();
+	sram.clear();
+	unmapped_pages.clear();
+}
+
+/****** Resizes ROM to hold at least the given number of bytes (up to 32MB) and maps it ******/
+void agb_memory::map_rom(u32 size)
+{
+	if(size > 0x2000000) { size = 0x2000000; }
+	size = (size + 0x3FFF) & ~0x3FFF;
+
+	if(size > rom.size()) { rom.resize(size, 0); }
+	if(rom.empty()) { return; }
+
+	//ROM is mirrored for Waitstates 1 and 2
+	u32 end = 0x8000000 + rom.size() - 1;
+
+	map_region(0x8000000, end, rom);
+	map_region(0xA000000, end + 0x2000000, rom);
+	map_region(0xC000000, std::min(end + 0x4000000, (u32)0xCFFFFFF), rom);
+}
+
+/****** Returns the size of the ROM buffer ******/
+u32 agb_memory::rom_size() const
+{
+	return rom.size();
+}
+
+/****** Returns the page holding an address, or NULL if nothing has been mapped there ******/
+u8* agb_memory::get_page(u32 address) const
+{
+	return pages[(address >> 14) & 0x3FFF];
+}
+
+/****** Points pages between two addresses to a region, repeating the region if the range is larger ******/
+void agb_memory::map_region(u32 start, u32 end, std::vector<u8>& region)
+{
+	for(u32 x = start; x < end; x += 0x4000)
+	{
+		pages[x >> 14] = &region[(x - start) % region.size()];
+	}
+}
+
+/****** Allocates a zero-filled page for memory that doesn't belong to any region ******/
+u8* agb_memory::allocate_page(u32 address)
+{
+	unmapped_pages.push_back(std::vector<u8>(0x4000, 0));
+
+	u8* page = &unmapped_pages.back()[0];
+	pages[(address >> 14) & 0x3FFF] = page;
+
+	return page;
+}
+
 /****** MMU Constructor ******/
 AGB_MMU::AGB_MMU() 
 {
@@ -30,8 +132,7 @@ AGB_MMU::~AGB_MMU()
 /****** MMU Reset ******/
 void AGB_MMU::reset()
 {
-	memory_map.clear();
-	memory_map.resize(0x10000000, 0);
+	memory_map.reset();
 
 	eeprom.data.clear();
 	eeprom.data.resize(0x200, 0);
@@ -121,6 +222,8 @@ void AGB_MMU::reset()
 
 	bios_lock = true;
 
+	for(u32 x = 0; x < 0x480; x++) { code_gen[x] = 0; }
+
 	//Default memory access timings (4, 2)
 	n_clock = 4;
 	s_clock = 2;
@@ -154,6 +257,7 @@ void AGB_MMU::reset()
 
 	g_pad = NULL;
 	timer = NULL;
+	lcd = NULL;
 
 	//Advanced debugging
 	#ifdef GBE_DEBUG
@@ -180,30 +284,18 @@ u8 AGB_MMU::read_u8(u32 address)
 	//Check for unused memory and mirrors first
 	switch(address >> 24)
 	{
+		//BIOS, WRAM, Palettes, VRAM, and OAM have no registers, so read them straight from their pages
+		//WRAM, Palette, and OAM mirrors are handled by the memory map
 		case 0x0:
 		case 0x1:
-		case 0x4:
-		case 0x6:
-			break;
-
-		//Slow WRAM 256KB mirror
 		case 0x2:
-			address &= 0x203FFFF;
-			break;
-
-		//Fast WRAM 32KB mirror
 		case 0x3:
-			address &= 0x3007FFF;
-			break;
-
-		//Pallete RAM 32KB mirror
 		case 0x5:
-			address &= 0x5007FFF;
-			break;
-
-		//OAM 32KB mirror
+		case 0x6:
 		case 0x7:
-			address &= 0x7007FFF;
+			return memory_map.read(address);
+
+		case 0x4:
 			break;
 
 		//ROM Waitstate 0
@@ -275,13 +367,13 @@ u8 AGB_MMU::read_u8(u32 address)
 
 			//SRAM read
 			case SRAM:
-				return memory_map[address];
+				return memory_map.read(address);
 
 			//Disable this memory region if not using SRAM or FLASH RAM.
 			//Used in some game protection schemes (NES Classics and Top Gun: Combat Zones)
 			default:
 				//Make an exception for GBA Tilt Carts
-				if(config::cart_type == AGB_TILT_SENSOR) { return memory_map[address]; }
+				if(config::cart_type == AGB_TILT_SENSOR) { return memory_map.read(address); }
 				return 0;
 		}
 	}
@@ -289,34 +381,42 @@ u8 AGB_MMU::read_u8(u32 address)
 	switch(address)
 	{
 		case TM0CNT_L:
+			sync_timer(0);
 			return (timer->at(0).counter & 0xFF);
 			break;
 
 		case TM0CNT_L+1:
+			sync_timer(0);
 			return (timer->at(0).counter >> 8);
 			break;
 
 		case TM1CNT_L:
+			sync_timer(1);
 			return (timer->at(1).counter & 0xFF);
 			break;
 
 		case TM1CNT_L+1:
+			sync_timer(1);
 			return (timer->at(1).counter >> 8);
 			break;
 
 		case TM2CNT_L:
+			sync_timer(2);
 			return (timer->at(2).counter & 0xFF);
 			break;
 
 		case TM2CNT_L+1:
+			sync_timer(2);
 			return (timer->at(2).counter >> 8);
 			break;
 
 		case TM3CNT_L:
+			sync_timer(3);
 			return (timer->at(3).counter & 0xFF);
 			break;
 
 		case TM3CNT_L+1:
+			sync_timer(3);
 			return (timer->at(3).counter >> 8);
 			break;
 
@@ -386,35 +486,35 @@ u8 AGB_MMU::read_u8(u32 address)
 			break;
 
 		//AM3 Block Size
-		case AM_BLK_SIZE: return (config::cart_type == AGB_AM3) ? (am3.blk_size & 0xFF) : memory_map[address]; break;
-		case AM_BLK_SIZE+1: return (config::cart_type == AGB_AM3) ? ((am3.blk_size >> 8) & 0xFF) : memory_map[address]; break;
+		case AM_BLK_SIZE: return (config::cart_type == AGB_AM3) ? (am3.blk_size & 0xFF) : memory_map.read(address); break;
+		case AM_BLK_SIZE+1: return (config::cart_type == AGB_AM3) ? ((am3.blk_size >> 8) & 0xFF) : memory_map.read(address); break;
 
 		//AM3 Block Addr
-		case AM_BLK_ADDR: return (config::cart_type == AGB_AM3) ? (am3.blk_addr & 0xFF) : memory_map[address]; break;
-		case AM_BLK_ADDR+1: return (config::cart_type == AGB_AM3) ? ((am3.blk_addr >> 8) & 0xFF) : memory_map[address]; break;
-		case AM_BLK_ADDR+2: return (config::cart_type == AGB_AM3) ? ((am3.blk_addr >> 16) & 0xFF) : memory_map[address]; break;
-		case AM_BLK_ADDR+3: return (config::cart_type == AGB_AM3) ? ((am3.blk_addr >> 24) & 0xFF) : memory_map[address]; break;
+		case AM_BLK_ADDR: return (config::cart_type == AGB_AM3) ? (am3.blk_addr & 0xFF) : memory_map.read(address); break;
+		case AM_BLK_ADDR+1: return (config::cart_type == AGB_AM3) ? ((am3.blk_addr >> 8) & 0xFF) : memory_map.read(address); break;
+		case AM_BLK_ADDR+2: return (config::cart_type == AGB_AM3) ? ((am3.blk_addr >> 16) & 0xFF) : memory_map.read(address); break;
+		case AM_BLK_ADDR+3: return (config::cart_type == AGB_AM3) ? ((am3.blk_addr >> 24) & 0xFF) : memory_map.read(address); break;
 
 		//AM3 Remaining File Size Until EOF
-		case AM_SMC_EOF: return (config::cart_type == AGB_AM3) ? (am3.remaining_size & 0xFF) : memory_map[address]; break;
-		case AM_SMC_EOF+1: return (config::cart_type == AGB_AM3) ? ((am3.remaining_size >> 8) & 0xFF) : memory_map[address]; break;
+		case AM_SMC_EOF: return (config::cart_type == AGB_AM3) ? (am3.remaining_size & 0xFF) : memory_map.read(address); break;
+		case AM_SMC_EOF+1: return (config::cart_type == AGB_AM3) ? ((am3.remaining_size >> 8) & 0xFF) : memory_map.read(address); break;
 
 		//AM3 File Size / SmartMedia ID Bytes 0 - 3
 		case AM_FILE_SIZE:
 			if(config::cart_type == AGB_AM3) { return (am3.read_key) ? am3.smid[0] : (am3.file_size & 0xFF); }
-			return memory_map[address];
+			return memory_map.read(address);
 
 		case AM_FILE_SIZE+1:
 			if(config::cart_type == AGB_AM3) { return (am3.read_key) ? am3.smid[1] : ((am3.file_size >> 8) & 0xFF); }
-			return memory_map[address];
+			return memory_map.read(address);
 
 		case AM_FILE_SIZE+2:
 			if(config::cart_type == AGB_AM3) { return (am3.read_key) ? am3.smid[2] : ((am3.file_size >> 16) & 0xFF); }
-			return memory_map[address];
+			return memory_map.read(address);
 
 		case AM_FILE_SIZE+3:
 			if(config::cart_type == AGB_AM3) { return (am3.read_key) ? am3.smid[3] : ((am3.file_size >> 24) & 0xFF); }
-			return memory_map[address];
+			return memory_map.read(address);
 
 		//SmartMedia ID Bytes 4 - 15
 		case AM_FILE_SIZE+4:
@@ -430,21 +530,21 @@ u8 AGB_MMU::read_u8(u32 address)
 		case AM_FILE_SIZE+14:
 		case AM_FILE_SIZE+15:
 			if(config::cart_type == AGB_AM3) { return (am3.read_key) ? am3.smid[address - AM_FILE_SIZE] : 0; }
-			return memory_map[address];
+			return memory_map.read(address);
 
 		//AM3 SmartMedia Card Offset
-		case AM_SMC_OFFS: return (config::cart_type == AGB_AM3) ? (am3.smc_offset & 0xFF) : memory_map[address]; break;
-		case AM_SMC_OFFS+1: return (config::cart_type == AGB_AM3) ? ((am3.smc_offset >> 8) & 0xFF) : memory_map[address]; break;
-		case AM_SMC_OFFS+2: return (config::cart_type == AGB_AM3) ? ((am3.smc_offset >> 16) & 0xFF) : memory_map[address]; break;
-		case AM_SMC_OFFS+3: return (config::cart_type == AGB_AM3) ? ((am3.smc_offset >> 24) & 0xFF) : memory_map[address]; break;
+		case AM_SMC_OFFS: return (config::cart_type == AGB_AM3) ? (am3.smc_offset & 0xFF) : memory_map.read(address); break;
+		case AM_SMC_OFFS+1: return (config::cart_type == AGB_AM3) ? ((am3.smc_offset >> 8) & 0xFF) : memory_map.read(address); break;
+		case AM_SMC_OFFS+2: return (config::cart_type == AGB_AM3) ? ((am3.smc_offset >> 16) & 0xFF) : memory_map.read(address); break;
+		case AM_SMC_OFFS+3: return (config::cart_type == AGB_AM3) ? ((am3.smc_offset >> 24) & 0xFF) : memory_map.read(address); break;
 
 		//AM3 SmartMedia Card Block Size
-		case AM_SMC_SIZE: return (config::cart_type == AGB_AM3) ? (am3.smc_size & 0xFF) : memory_map[address]; break;
-		case AM_SMC_SIZE+1: return (config::cart_type == AGB_AM3) ? ((am3.smc_size >> 8) & 0xFF) : memory_map[address]; break;
+		case AM_SMC_SIZE: return (config::cart_type == AGB_AM3) ? (am3.smc_size & 0xFF) : memory_map.read(address); break;
+		case AM_SMC_SIZE+1: return (config::cart_type == AGB_AM3) ? ((am3.smc_size >> 8) & 0xFF) : memory_map.read(address); break;
 
 		//AM3 Block Status
 		case AM_BLK_STAT:
-			return (config::cart_type == AGB_AM3) ? (am3.blk_stat & 0xFF) : memory_map[address];
+			return (config::cart_type == AGB_AM3) ? (am3.blk_stat & 0xFF) : memory_map.read(address);
 			break;
 
 		//AM3 Block Status
@@ -540,32 +640,71 @@ u8 AGB_MMU::read_u8(u32 address)
 			break;
 
 		default:
-			return memory_map[address];
+			return memory_map.read(address);
 	}
 }
 
 /****** Read 2 bytes from memory ******/
 u16 AGB_MMU::read_u16(u32 address)
 {
-	return (read_u8(address) | (read_u8(address+1) << 8) ); 
+	return read<u16>(address);
 }
 
 /****** Read 4 bytes from memory ******/
 u32 AGB_MMU::read_u32(u32 address)
 {
-	return (read_u8(address) |  (read_u8(address+1) << 8) | (read_u8(address+2) << 16) | (read_u8(address+3) << 24));
+	return read<u32>(address);
+}
+
+/****** Reads 1, 2, or 4 bytes from memory - Plain memory is read with one load, everything else goes through read_u8() ******/
+template<typename T> T AGB_MMU::read(u32 address)
+{
+	u32 real_addr = address;
+
+	//Reads that cross a page go byte by byte
+	if(((address & 0x3FFF) <= (0x4000 - sizeof(T))) && (get_direct_read(real_addr)))
+	{
+		//Advanced debugging
+		#ifdef GBE_DEBUG
+		debug_read = true;
+		for(u32 x = 0; x < sizeof(T); x++) { debug_addr[(address + x) & 0x3] = address + x; }
+		#endif
+
+		const u8* data = memory_map.read_ptr(real_addr);
+
+		if(sizeof(T) == 1) { return data[0]; }
+		else if(sizeof(T) == 2) { return ((data[1] << 8) | data[0]); }
+		else { return (((u32)data[3] << 24) | (data[2] << 16) | (data[1] << 8) | data[0]); }
+	}
+
+	T value = 0;
+	for(u32 x = 0; x < sizeof(T); x++) { value |= ((T)read_u8(address + x) << (x * 8)); }
+
+	return value;
 }
 
+template u8 AGB_MMU::read<u8>(u32 address);
+template u16 AGB_MMU::read<u16>(u32 address);
+template u32 AGB_MMU::read<u32>(u32 address);
+
 /****** Reads 2 bytes from memory - No checks done on the read, used for known memory locations such as registers ******/
 u16 AGB_MMU::read_u16_fast(u32 address)
 {
-	return ((memory_map[address+1] << 8) | memory_map[address]);
+	//Look up the page only once unless the read crosses into the next page
+	if((address & 0x3FFF) == 0x3FFF) { return ((memory_map.read(address+1) << 8) | memory_map.read(address)); }
+
+	const u8* data = memory_map.read_ptr(address);
+	return ((data[1] << 8) | data[0]);
 }
 
 /****** Reads 4 bytes from memory - No checks done on the read, used for known memory locations such as registers ******/
 u32 AGB_MMU::read_u32_fast(u32 address)
 {
-	return ((memory_map[address+3] << 24) | (memory_map[address+2] << 16) | (memory_map[address+1] << 8) | memory_map[address]);
+	//Look up the page only once unless the read crosses into the next page
+	if((address & 0x3FFF) > 0x3FFC) { return ((memory_map.read(address+3) << 24) | (memory_map.read(address+2) << 16) | (memory_map.read(address+1) << 8) | memory_map.read(address)); }
+
+	const u8* data = memory_map.read_ptr(address);
+	return ((data[3] << 24) | (data[2] << 16) | (data[1] << 8) | data[0]);
 }
 
 /****** Write byte into memory ******/
@@ -590,11 +729,13 @@ void AGB_MMU::write_u8(u32 address, u8 value)
 		//Slow WRAM 256KB mirror
 		case 0x2:
 			address &= 0x203FFFF;
+			code_gen[(address >> 8) & 0x3FF]++;
 			break;
 
 		//Fast WRAM 32KB mirror
 		case 0x3:
 			address &= 0x3007FFF;
+			code_gen[0x400 | ((address >> 8) & 0x7F)]++;
 			break;
 
 		//Pallete RAM 32KB mirror
@@ -649,6 +790,220 @@ void AGB_MMU::write_u8(u32 address, u8 value)
 	//BIOS is read-only, prevent any attempted writes
 	if((address <= 0x3FFF) && (bios_lock)) { return; }
 
+	//WRAM and VRAM have no registers, so write them straight to their pages
+	if(((address >> 24) == 0x2 || (address >> 24) == 0x3 || (address >> 24) == 0x6) && (!flash_ram.write_single_byte))
+	{
+		//Finish any pixels the LCD has already drawn before VRAM changes, then flag the tile for decoding again
+		if((address >> 24) == 0x6)
+		{
+			lcd->render_partial_scanline();
+			if(address <= 0x601FFFF) { lcd_stat->vram_tile_update_list[(address >> 5) & 0xFFF] = true; }
+		}
+
+		memory_map[address] = value;
+		return;
+	}
+
+	//I/O registers are dispatched to the write handler for each register
+	if((address >= 0x4000000) && (address <= 0x40003FF))
+	{
+		(this->*io_write_table[address & 0x3FF])(address, value);
+	}
+
+	else
+	{
+		switch(address)
+		{
+			//General Purpose I/O Data
+			case GPIO_DATA:
+				if(gpio.type != GPIO_DISABLED)
+				{
+					gpio.data = (value & 0xF);
+
+					switch(gpio.type)
+					{
+						case GPIO_RTC:
+							process_rtc();
+							break;
+
+						case GPIO_SOLAR_SENSOR:
+							process_solar_sensor();
+							break;
+
+						case GPIO_RUMBLE:
+							process_rumble();
+							break;
+
+						case GPIO_GYRO_SENSOR:
+							process_gyro_sensor();
+							break;
+					}
+
+					gpio.prev_data = gpio.data;
+				}
+
+				break;
+
+			//General Purpose I/O Direction
+			case GPIO_DIRECTION:
+				if(gpio.type != GPIO_DISABLED) { gpio.direction = value & 0xF; }
+				break;
+
+			//General Purpose I/O Control
+			case GPIO_CNT:
+				if(gpio.type != GPIO_DISABLED) { gpio.control = value & 0x1; }
+				break;
+
+			case FLASH_RAM_CMD0:
+				memory_map[address] = value;
+
+				if((current_save_type == FLASH_64) || (current_save_type == FLASH_128))
+				{
+					//1st byte of the command
+					if((flash_ram.current_command == 0) && (value == 0xAA)) { flash_ram.current_command++; }
+
+					//3rd byte of the command, execute command
+					else if(flash_ram.current_command == 2)
+					{
+						switch(value)
+						{
+							//FLASH erase chip
+							case 0x10: 
+								flash_erase_chip();
+								flash_ram.current_command = 0;
+								break;
+
+							//FLASH erase command
+							case 0x80:
+								flash_ram.current_command = 0;
+								break;			
+
+							//FLASH ID start
+							case 0x90:
+								flash_ram.grab_ids = true;
+								flash_ram.current_command = 0;
+								break;
+
+							//Write byte
+							case 0xA0: 
+								flash_ram.write_single_byte = true;
+								flash_ram.current_command = 0;
+								break;
+
+							//Bank switch
+							case 0xB0:
+								flash_ram.switch_bank = true;
+								flash_ram.current_command = 0;
+								break;
+
+							//FLASH ID end
+							case 0xF0: 
+								flash_ram.grab_ids = false;
+								flash_ram.current_command = 0; 
+								break;
+
+							default: std::cout<<"MMU::Unknown FLASH RAM command 0x" << std::hex << (int)value << "\n"; break;
+						}
+					}
+				}
+
+				break;
+
+			case FLASH_RAM_CMD1:
+				memory_map[address] = value;
+
+				if(((current_save_type == FLASH_64) || (current_save_type == FLASH_128)) && (value == 0x55))
+				{
+					if(flash_ram.current_command == 1) { flash_ram.current_command++; }
+				}
+		
+				break;
+
+			case FLASH_RAM_SEC0:
+			case FLASH_RAM_SEC1:
+			case FLASH_RAM_SEC2:
+			case FLASH_RAM_SEC3:
+			case FLASH_RAM_SEC4:
+			case FLASH_RAM_SEC5:
+			case FLASH_RAM_SEC6:
+			case FLASH_RAM_SEC7:
+			case FLASH_RAM_SEC8:
+			case FLASH_RAM_SEC9:
+			case FLASH_RAM_SECA:
+			case FLASH_RAM_SECB:
+			case FLASH_RAM_SECC:
+			case FLASH_RAM_SECD:
+			case FLASH_RAM_SECE:
+			case FLASH_RAM_SECF:
+				memory_map[address] = value;
+
+				if(((current_save_type == FLASH_64) || (current_save_type == FLASH_128)) && (value == 0x30) && (flash_ram.current_command == 2))
+				{
+					flash_erase_sector(address);
+					flash_ram.current_command = 0;
+				}
+			
+				else if((current_save_type == FLASH_128) && (address == FLASH_RAM_SEC0) && (flash_ram.switch_bank) && (flash_ram.current_command == 0))
+				{
+					flash_ram.bank = value;
+					flash_ram.switch_bank = false;
+				}
+			
+				break;
+
+
+			default:
+				memory_map[address] = value;
+		}
+	}
+
+	//Trigger BG palette update in LCD
+	if((address >= 0x5000000) && (address <= 0x50001FF))
+	{
+		lcd_stat->bg_pal_update = true;
+		lcd_stat->bg_pal_update_list[(address & 0x1FF) >> 1] = true;
+	}
+
+	//Trigger OBJ palette update in LCD
+	else if((address >= 0x5000200) && (address <= 0x50003FF))
+	{
+		lcd_stat->obj_pal_update = true;
+		lcd_stat->obj_pal_update_list[(address & 0x1FF) >> 1] = true;
+	}
+
+	//Trigger OAM update in LCD
+	else if((address >= 0x7000000) && (address <= 0x70003FF))
+	{
+		lcd_stat->oam_update = true;
+		lcd_stat->oam_update_list[(address & 0x3FF) >> 3] = true;
+	}
+
+	//Trigger tile decoding in LCD
+	else if((address >= 0x6000000) && (address <= 0x601FFFF))
+	{
+		lcd_stat->vram_tile_update_list[(address >> 5) & 0xFFF] = true;
+	}
+
+	//Write to FLASH RAM
+	else if(((current_save_type == FLASH_64) || (current_save_type == FLASH_128)) && (flash_ram.next_write) && (address >= 0xE000000) && (address <= 0xE00FFFF))
+	{
+			flash_ram.data[flash_ram.bank][(address & 0xFFFF)] = value;
+			flash_ram.next_write = false;
+	}
+
+	if(flash_ram.write_single_byte) 
+	{ 
+		flash_ram.write_single_byte = false;
+		flash_ram.next_write = true;
+	}
+}
+
+/****** Writes to LCD I/O registers ******/
+void AGB_MMU::write_lcd_io(u32 address, u8 value)
+{
+	//Finish any pixels the LCD has already drawn before its registers change
+	lcd->render_partial_scanline();
+
 	switch(address)
 	{
 		//Display Control
@@ -1262,7 +1617,7 @@ void AGB_MMU::write_u8(u32 address, u8 value)
 			
 			memory_map[address] = (value & 0x1F);
 			if(value > 0xF) { value = 0x10; }
-			lcd_stat->alpha_a_coef = (value & 0x1F) / 16.0;
+			lcd_stat->alpha_a_coef = (value & 0x1F);
 			break;
 
 		case BLDALPHA+1:
@@ -1270,7 +1625,7 @@ void AGB_MMU::write_u8(u32 address, u8 value)
 			
 			memory_map[address] = (value & 0x1F);
 			if(value > 0xF) { value = 0x10; }
-			lcd_stat->alpha_b_coef = (value & 0x1F) / 16.0;
+			lcd_stat->alpha_b_coef = (value & 0x1F);
 			break;
 
 		//SFX Brightness Control
@@ -1279,9 +1634,19 @@ void AGB_MMU::write_u8(u32 address, u8 value)
 
 			memory_map[address] = value;
 			if(value > 0xF) { value = 0x10; }
-			lcd_stat->brightness_coef = (value & 0x1F) / 16.0;
+			lcd_stat->brightness_coef = (value & 0x1F);
 			break;
-		
+
+		default:
+			memory_map[address] = value;
+	}
+}
+
+/****** Writes to sound I/O registers ******/
+void AGB_MMU::write_apu_io(u32 address, u8 value)
+{
+	switch(address)
+	{
 		//Sound Channel 1 Control - Sweep Parameters
 		case SND1CNT_L:
 			memory_map[address] = value;
@@ -1633,20 +1998,16 @@ void AGB_MMU::write_u8(u32 address, u8 value)
 		case WAVERAM3_H: apu_stat->waveram_data[(apu_stat->waveram_bank_rw << 4) + 14] = value; break;
 		case WAVERAM3_H+1: apu_stat->waveram_data[(apu_stat->waveram_bank_rw << 4) + 15] = value; break;
 
-		case REG_IME:
-			memory_map[address] = (value & 0x1);
-			break;
-
-		case REG_IME+1:
-		case REG_IME+2:
-		case REG_IME+3:
-			break;
-
-		case REG_IF:
-		case REG_IF+1:
-			memory_map[address] &= ~value;
-			break;
+		default:
+			memory_map[address] = value;
+	}
+}
 
+/****** Writes to DMA I/O registers ******/
+void AGB_MMU::write_dma_io(u32 address, u8 value)
+{
+	switch(address)
+	{
 		//DMA0 Start Address
 		case DMA0SAD:
 		case DMA0SAD+1:
@@ -1676,6 +2037,7 @@ void AGB_MMU::write_u8(u32 address, u8 value)
 			dma[0].enable = true;
 			dma[0].started = false;
 			dma[0].delay = 2;
+			schedule_event(AGB_DMA_EVENT, scheduler->current_cycle + 1);
 			break;
 
 		//DMA1 Start Address
@@ -1710,6 +2072,7 @@ void AGB_MMU::write_u8(u32 address, u8 value)
 			dma[1].enable = true;
 			dma[1].started = false;
 			dma[1].delay = 2;
+			schedule_event(AGB_DMA_EVENT, scheduler->current_cycle + 1);
 			break;
 
 		//DMA2 Start Address
@@ -1744,6 +2107,7 @@ void AGB_MMU::write_u8(u32 address, u8 value)
 			dma[2].enable = true;
 			dma[2].started = false;
 			dma[2].delay = 2;
+			schedule_event(AGB_DMA_EVENT, scheduler->current_cycle + 1);
 			break;
 
 		//DMA3 Start Address
@@ -1775,19 +2139,19 @@ void AGB_MMU::write_u8(u32 address, u8 value)
 			dma[3].enable = true;
 			dma[3].started = false;
 			dma[3].delay = 2;
+			schedule_event(AGB_DMA_EVENT, scheduler->current_cycle + 1);
 			break;
 
-		case KEYINPUT:
-		case KEYINPUT+1:
-			break;
-
-		//Key Interrupt Control
-		case KEYCNT:
-		case KEYCNT+1:
+		default:
 			memory_map[address] = value;
-			g_pad->key_cnt = ((memory_map[KEYCNT+1] << 8) | memory_map[KEYCNT]);
-			break;
+	}
+}
 
+/****** Writes to timer I/O registers ******/
+void AGB_MMU::write_timer_io(u32 address, u8 value)
+{
+	switch(address)
+	{
 		//Timer 0 Reload Value
 		case TM0CNT_L:
 		case TM0CNT_L+1:
@@ -1823,6 +2187,8 @@ void AGB_MMU::write_u8(u32 address, u8 value)
 		//Timer 0 Control
 		case TM0CNT_H:
 		case TM0CNT_H+1:
+			sync_timer(0);
+
 			{
 				bool prev_enable = (memory_map[TM0CNT_H] & 0x80) ?  true : false;
 				memory_map[address] = value;
@@ -1840,11 +2206,14 @@ void AGB_MMU::write_u8(u32 address, u8 value)
 				case 0x3: timer->at(0).prescalar = 1024; break;
 			}
 
+			schedule_timer(0);
 			break;
 
 		//Timer 1 Control
 		case TM1CNT_H:
 		case TM1CNT_H+1:
+			sync_timer(1);
+
 			{
 				bool prev_enable = (memory_map[TM1CNT_H] & 0x80) ?  true : false;
 				memory_map[address] = value;
@@ -1865,11 +2234,14 @@ void AGB_MMU::write_u8(u32 address, u8 value)
 
 			if(timer->at(1).count_up) { timer->at(1).prescalar = 1; }
 
+			schedule_timer(1);
 			break;
 
 		//Timer 2 Control
 		case TM2CNT_H:
 		case TM2CNT_H+1:
+			sync_timer(2);
+
 			{
 				bool prev_enable = (memory_map[TM2CNT_H] & 0x80) ?  true : false;
 				memory_map[address] = value;
@@ -1890,11 +2262,14 @@ void AGB_MMU::write_u8(u32 address, u8 value)
 
 			if(timer->at(2).count_up) { timer->at(2).prescalar = 1; }
 
+			schedule_timer(2);
 			break;
 
 		//Timer 3 Control
 		case TM3CNT_H:
 		case TM3CNT_H+1:
+			sync_timer(3);
+
 			{
 				bool prev_enable = (memory_map[TM3CNT_H] & 0x80) ?  true : false;
 				memory_map[address] = value;
@@ -1915,6 +2290,28 @@ void AGB_MMU::write_u8(u32 address, u8 value)
 
 			if(timer->at(3).count_up) { timer->at(3).prescalar = 1; }
 
+			schedule_timer(3);
+			break;
+
+		default:
+			memory_map[address] = value;
+	}
+}
+
+/****** Writes to serial and keypad I/O registers ******/
+void AGB_MMU::write_sio_io(u32 address, u8 value)
+{
+	switch(address)
+	{
+		case KEYINPUT:
+		case KEYINPUT+1:
+			break;
+
+		//Key Interrupt Control
+		case KEYCNT:
+		case KEYCNT+1:
+			memory_map[address] = value;
+			g_pad->key_cnt = ((memory_map[KEYCNT+1] << 8) | memory_map[KEYCNT]);
 			break;
 
 		//RCNT Mode Selection
@@ -1956,7 +2353,31 @@ void AGB_MMU::write_u8(u32 address, u8 value)
 			process_sio();
 
 			break;
-			
+
+		default:
+			memory_map[address] = value;
+	}
+}
+
+/****** Writes to interrupt and system control I/O registers ******/
+void AGB_MMU::write_system_io(u32 address, u8 value)
+{
+	switch(address)
+	{
+		case REG_IME:
+			memory_map[address] = (value & 0x1);
+			break;
+
+		case REG_IME+1:
+		case REG_IME+2:
+		case REG_IME+3:
+			break;
+
+		case REG_IF:
+		case REG_IF+1:
+			memory_map[address] &= ~value;
+			break;
+
 		//Wait State Control
 		case WAITCNT:
 		case WAITCNT+1:
@@ -1987,197 +2408,308 @@ void AGB_MMU::write_u8(u32 address, u8 value)
 
 			break;
 
-		//General Purpose I/O Data
-		case GPIO_DATA:
-			if(gpio.type != GPIO_DISABLED)
-			{
-				gpio.data = (value & 0xF);
+		default:
+			memory_map[address] = value;
+	}
+}
 
-				switch(gpio.type)
-				{
-					case GPIO_RTC:
-						process_rtc();
-						break;
+/****** Writes to I/O registers that have no side-effects ******/
+void AGB_MMU::write_plain_io(u32 address, u8 value)
+{
+	memory_map[address] = value;
+}
 
-					case GPIO_SOLAR_SENSOR:
-						process_solar_sensor();
-						break;
+/****** Builds the table of write handlers for each I/O register ******/
+std::array<AGB_MMU::io_write_func, 0x400> AGB_MMU::make_io_write_table()
+{
+	std::array<io_write_func, 0x400> table;
+	table.fill(&AGB_MMU::write_plain_io);
+
+	for(u32 x = DISPCNT; x <= (BLDY + 1); x++) { table[x & 0x3FF] = &AGB_MMU::write_lcd_io; }
+	for(u32 x = SND1CNT_L; x <= (WAVERAM3_H + 1); x++) { table[x & 0x3FF] = &AGB_MMU::write_apu_io; }
+	for(u32 x = DMA0SAD; x <= (DMA3CNT_H + 1); x++) { table[x & 0x3FF] = &AGB_MMU::write_dma_io; }
+	for(u32 x = TM0CNT_L; x <= (TM3CNT_H + 1); x++) { table[x & 0x3FF] = &AGB_MMU::write_timer_io; }
+
+	table[SIO_CNT & 0x3FF] = &AGB_MMU::write_sio_io;
+	table[(SIO_CNT + 1) & 0x3FF] = &AGB_MMU::write_sio_io;
+	table[R_CNT & 0x3FF] = &AGB_MMU::write_sio_io;
+	table[(R_CNT + 1) & 0x3FF] = &AGB_MMU::write_sio_io;
+	for(u32 x = KEYINPUT; x <= (KEYCNT + 1); x++) { table[x & 0x3FF] = &AGB_MMU::write_sio_io; }
+
+	table[REG_IF & 0x3FF] = &AGB_MMU::write_system_io;
+	table[(REG_IF + 1) & 0x3FF] = &AGB_MMU::write_system_io;
+	table[WAITCNT & 0x3FF] = &AGB_MMU::write_system_io;
+	table[(WAITCNT + 1) & 0x3FF] = &AGB_MMU::write_system_io;
+	for(u32 x = REG_IME; x <= (REG_IME + 3); x++) { table[x & 0x3FF] = &AGB_MMU::write_system_io; }
+
+	return table;
+}
 
-					case GPIO_RUMBLE:
-						process_rumble();
-						break;
+const std::array<AGB_MMU::io_write_func, 0x400> AGB_MMU::io_write_table = make_io_write_table();
 
-					case GPIO_GYRO_SENSOR:
-						process_gyro_sensor();
-						break;
-				}
+/****** Write 2 bytes into memory ******/
+void AGB_MMU::write_u16(u32 address, u16 value)
+{
+	write<u16>(address, value);
+}
 
-				gpio.prev_data = gpio.data;
-			}
+/****** Write 4 bytes into memory ******/
+void AGB_MMU::write_u32(u32 address, u32 value)
+{
+	write<u32>(address, value);
+}
 
-			break;
+/****** Writes 1, 2, or 4 bytes into memory - Plain memory is written with one store, everything else goes through write_u8() ******/
+template<typename T> void AGB_MMU::write(u32 address, T value)
+{
+	u32 real_addr = address;
 
-		//General Purpose I/O Direction
-		case GPIO_DIRECTION:
-			if(gpio.type != GPIO_DISABLED) { gpio.direction = value & 0xF; }
-			break;
+	//Writes that cross a page go byte by byte
+	if(((address & 0x3FFF) <= (0x4000 - sizeof(T))) && (get_direct_write(real_addr)))
+	{
+		//Advanced debugging
+		#ifdef GBE_DEBUG
+		debug_write = true;
+		for(u32 x = 0; x < sizeof(T); x++) { debug_addr[(address + x) & 0x3] = address + x; }
+		#endif
 
-		//General Purpose I/O Control
-		case GPIO_CNT:
-			if(gpio.type != GPIO_DISABLED) { gpio.control = value & 0x1; }
-			break;
+		u8* data = &memory_map[real_addr];
 
-		case FLASH_RAM_CMD0:
-			memory_map[address] = value;
+		for(u32 x = 0; x < sizeof(T); x++) { data[x] = ((value >> (x * 8)) & 0xFF); }
+		mark_direct_write(real_addr, sizeof(T));
+		return;
+	}
 
-			if((current_save_type == FLASH_64) || (current_save_type == FLASH_128))
-			{
-				//1st byte of the command
-				if((flash_ram.current_command == 0) && (value == 0xAA)) { flash_ram.current_command++; }
+	for(u32 x = 0; x < sizeof(T); x++) { write_u8((address + x), ((value >> (x * 8)) & 0xFF)); }
+}
 
-				//3rd byte of the command, execute command
-				else if(flash_ram.current_command == 2)
-				{
-					switch(value)
-					{
-						//FLASH erase chip
-						case 0x10: 
-							flash_erase_chip();
-							flash_ram.current_command = 0;
-							break;
+template void AGB_MMU::write<u8>(u32 address, u8 value);
+template void AGB_MMU::write<u16>(u32 address, u16 value);
+template void AGB_MMU::write<u32>(u32 address, u32 value);
 
-						//FLASH erase command
-						case 0x80:
-							flash_ram.current_command = 0;
-							break;			
+/****** Checks if an address is plain memory that can be read directly - Updates the address to the one in the memory map ******/
+bool AGB_MMU::get_direct_read(u32 &address)
+{
+	switch(address >> 24)
+	{
+		//BIOS, WRAM, Palettes, VRAM, and OAM have no registers
+		case 0x0:
+		case 0x1:
+		case 0x2:
+		case 0x3:
+		case 0x5:
+		case 0x6:
+		case 0x7:
+			return true;
 
-						//FLASH ID start
-						case 0x90:
-							flash_ram.grab_ids = true;
-							flash_ram.current_command = 0;
-							break;
+		//ROM Waitstates 0, 1, and 2, unless the cartridge has registers or GPIO in this area
+		case 0x8:
+		case 0x9:
+		case 0xA:
+		case 0xB:
+		case 0xC:
+			if((config::cart_type == AGB_AM3) || (config::cart_type == AGB_CAMPHO) || (config::cart_type == AGB_JUKEBOX) || (config::cart_type == AGB_PLAY_YAN)) { return false; }
+			if((gpio.type != GPIO_DISABLED) && ((address & 0x1FFFFFF) <= GPIO_CNT + 1 - 0x8000000)) { return false; }
 
-						//Write byte
-						case 0xA0: 
-							flash_ram.write_single_byte = true;
-							flash_ram.current_command = 0;
-							break;
+			address = 0x8000000 | (address & 0x1FFFFFF);
+			return true;
 
-						//Bank switch
-						case 0xB0:
-							flash_ram.switch_bank = true;
-							flash_ram.current_command = 0;
-							break;
+		default:
+			return false;
+	}
+}
 
-						//FLASH ID end
-						case 0xF0: 
-							flash_ram.grab_ids = false;
-							flash_ram.current_command = 0; 
-							break;
+/****** Checks if an address is plain memory that can be written directly - Updates the address to the one in the memory map ******/
+bool AGB_MMU::get_direct_write(u32 &address)
+{
+	//The write after a FLASH byte command has to go through write_u8()
+	if(flash_ram.write_single_byte) { return false; }
 
-						default: std::cout<<"MMU::Unknown FLASH RAM command 0x" << std::hex << (int)value << "\n"; break;
-					}
-				}
-			}
+	switch(address >> 24)
+	{
+		//Slow WRAM 256KB mirror
+		case 0x2:
+			address &= 0x203FFFF;
+			return true;
+
+		//Fast WRAM 32KB mirror
+		case 0x3:
+			address &= 0x3007FFF;
+			return true;
+
+		//Pallete RAM 32KB mirror
+		case 0x5:
+			address &= 0x5007FFF;
+			return true;
 
+		//Finish any pixels the LCD has already drawn before VRAM changes
+		case 0x6:
+			lcd->render_partial_scanline();
+			return true;
+
+		//OAM 32KB mirror
+		case 0x7:
+			address &= 0x7007FFF;
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+/****** Updates cached code and LCD state after plain memory within one page is written directly ******/
+void AGB_MMU::mark_direct_write(u32 address, u32 length)
+{
+	u32 last_addr = address + length - 1;
+
+	switch(address >> 24)
+	{
+		//Bump WRAM code generations
+		case 0x2:
+			for(u32 x = (address >> 8); x <= (last_addr >> 8); x++) { code_gen[x & 0x3FF]++; }
 			break;
 
-		case FLASH_RAM_CMD1:
-			memory_map[address] = value;
+		case 0x3:
+			for(u32 x = (address >> 8); x <= (last_addr >> 8); x++) { code_gen[0x400 | (x & 0x7F)]++; }
+			break;
+
+		//Trigger BG and OBJ palette updates in LCD
+		case 0x5:
+			if(last_addr > 0x50003FF) { last_addr = 0x50003FF; }
 
-			if(((current_save_type == FLASH_64) || (current_save_type == FLASH_128)) && (value == 0x55))
+			for(u32 x = (address & ~0x1); x <= last_addr; x += 2)
 			{
-				if(flash_ram.current_command == 1) { flash_ram.current_command++; }
+				if(x <= 0x50001FF)
+				{
+					lcd_stat->bg_pal_update = true;
+					lcd_stat->bg_pal_update_list[(x & 0x1FF) >> 1] = true;
+				}
+
+				else
+				{
+					lcd_stat->obj_pal_update = true;
+					lcd_stat->obj_pal_update_list[(x & 0x1FF) >> 1] = true;
+				}
 			}
-		
+
 			break;
 
-		case FLASH_RAM_SEC0:
-		case FLASH_RAM_SEC1:
-		case FLASH_RAM_SEC2:
-		case FLASH_RAM_SEC3:
-		case FLASH_RAM_SEC4:
-		case FLASH_RAM_SEC5:
-		case FLASH_RAM_SEC6:
-		case FLASH_RAM_SEC7:
-		case FLASH_RAM_SEC8:
-		case FLASH_RAM_SEC9:
-		case FLASH_RAM_SECA:
-		case FLASH_RAM_SECB:
-		case FLASH_RAM_SECC:
-		case FLASH_RAM_SECD:
-		case FLASH_RAM_SECE:
-		case FLASH_RAM_SECF:
-			memory_map[address] = value;
-
-			if(((current_save_type == FLASH_64) || (current_save_type == FLASH_128)) && (value == 0x30) && (flash_ram.current_command == 2))
-			{
-				flash_erase_sector(address);
-				flash_ram.current_command = 0;
-			}
-			
-			else if((current_save_type == FLASH_128) && (address == FLASH_RAM_SEC0) && (flash_ram.switch_bank) && (flash_ram.current_command == 0))
+		//Trigger tile decoding in LCD
+		case 0x6:
+			if(last_addr > 0x601FFFF) { last_addr = 0x601FFFF; }
+
+			for(u32 x = (address & ~0x1F); x <= last_addr; x += 32) { lcd_stat->vram_tile_update_list[(x >> 5) & 0xFFF] = true; }
+			break;
+
+		//Trigger OAM update in LCD
+		case 0x7:
+			if(last_addr > 0x70003FF) { last_addr = 0x70003FF; }
+
+			for(u32 x = address; x <= last_addr; x += 8)
 			{
-				flash_ram.bank = value;
-				flash_ram.switch_bank = false;
+				lcd_stat->oam_update = true;
+				lcd_stat->oam_update_list[(x & 0x3FF) >> 3] = true;
 			}
-			
+
+			if(address <= last_addr) { lcd_stat->oam_update_list[(last_addr & 0x3FF) >> 3] = true; }
 			break;
+	}
+}
 
+/****** Copies or fills plain memory for DMA and BIOS copies, up to the end of the current 16KB pages - Returns the number of units moved ******/
+u32 AGB_MMU::dma_block(u32 dest_addr, u32 src_addr, u32 count, u8 unit, bool fixed_src)
+{
+	u32 real_src = src_addr;
+	u32 real_dest = dest_addr;
 
-		default:
-			memory_map[address] = value;
-	}
+	if((!get_direct_read(real_src)) || (!get_direct_write(real_dest))) { return 0; }
 
-	//Trigger BG palette update in LCD
-	if((address >= 0x5000000) && (address <= 0x50001FF))
-	{
-		lcd_stat->bg_pal_update = true;
-		lcd_stat->bg_pal_update_list[(address & 0x1FF) >> 1] = true;
-	}
+	//Stop at the end of the source or destination page
+	u32 dest_room = (0x4000 - (dest_addr & 0x3FFF)) / unit;
+	u32 src_room = (fixed_src) ? count : ((0x4000 - (src_addr & 0x3FFF)) / unit);
 
-	//Trigger OBJ palette update in LCD
-	else if((address >= 0x5000200) && (address <= 0x50003FF))
-	{
-		lcd_stat->obj_pal_update = true;
-		lcd_stat->obj_pal_update_list[(address & 0x1FF) >> 1] = true;
-	}
+	if(count > dest_room) { count = dest_room; }
+	if(count > src_room) { count = src_room; }
+	if(count == 0) { return 0; }
 
-	//Trigger OAM update in LCD
-	else if((address >= 0x7000000) && (address <= 0x70003FF))
-	{
-		lcd_stat->oam_update = true;
-		lcd_stat->oam_update_list[(address & 0x3FF) >> 3] = true;
-	}
+	u32 length = count * unit;
+	const u8* src = memory_map.read_ptr(real_src);
+	u8* dest = &memory_map[real_dest];
 
-	//Write to FLASH RAM
-	else if(((current_save_type == FLASH_64) || (current_save_type == FLASH_128)) && (flash_ram.next_write) && (address >= 0xE000000) && (address <= 0xE00FFFF))
+	//Fill with the same unit
+	if(fixed_src)
 	{
-			flash_ram.data[flash_ram.bank][(address & 0xFFFF)] = value;
-			flash_ram.next_write = false;
-	}
+		u8 fill[4] = { src[0], src[1], 0, 0 };
+		if(unit == 4) { fill[2] = src[2]; fill[3] = src[3]; }
 
-	if(flash_ram.write_single_byte) 
-	{ 
-		flash_ram.write_single_byte = false;
-		flash_ram.next_write = true;
+		for(u32 x = 0; x < length; x++) { dest[x] = fill[x & (unit - 1)]; }
 	}
+
+	//Copy blocks that don't overlap all at once
+	else if(((dest + length) <= src) || ((src + length) <= dest)) { std::copy(src, src + length, dest); }
+
+	//Overlapping blocks copy forward, the same as moving one unit at a time
+	else { for(u32 x = 0; x < length; x++) { dest[x] = src[x]; } }
+
+	mark_direct_write(real_dest, length);
+	return count;
 }
 
-/****** Write 2 bytes into memory ******/
-void AGB_MMU::write_u16(u32 address, u16 value)
+/****** Returns host memory for plain memory that can be read directly - Length is cut down to the bytes available in one run ******/
+u8* AGB_MMU::get_host_read(u32 address, u32 &length)
+{
+	if(!get_direct_read(address)) { length = 0; return NULL; }
+
+	length = get_host_run(address, length);
+	return (length) ? &memory_map[address] : NULL;
+}
+
+/****** Returns host memory for plain memory that can be written directly - Call mark_host_write() once done writing ******/
+u8* AGB_MMU::get_host_write(u32 address, u32 &length)
 {
-	write_u8(address, (value & 0xFF));
-	write_u8((address+1), ((value >> 8) & 0xFF));
+	if(!get_direct_write(address)) { length = 0; return NULL; }
+
+	length = get_host_run(address, length);
+	return (length) ? &memory_map[address] : NULL;
 }
 
-/****** Write 4 bytes into memory ******/
-void AGB_MMU::write_u32(u32 address, u32 value)
+/****** Updates cached code and LCD state after writing through get_host_write() ******/
+void AGB_MMU::mark_host_write(u32 address, u32 length)
+{
+	if(length == 0) { return; }
+
+	get_direct_write(address);
+
+	//Palette and OAM updates are flagged one page at a time
+	while(length)
+	{
+		u32 run = 0x4000 - (address & 0x3FFF);
+		if(run > length) { run = length; }
+
+		mark_direct_write(address, run);
+
+		address += run;
+		length -= run;
+	}
+}
+
+/****** Counts how many of the requested bytes follow one another in host memory, stopping where a region ends or mirrors ******/
+u32 AGB_MMU::get_host_run(u32 address, u32 length)
 {
-	write_u8(address, (value & 0xFF));
-	write_u8((address+1), ((value >> 8) & 0xFF));
-	write_u8((address+2), ((value >> 16) & 0xFF));
-	write_u8((address+3), ((value >> 24) & 0xFF));
+	u8* page = memory_map.get_page(address);
+	if(page == NULL) { return 0; }
+
+	u32 run = 0x4000 - (address & 0x3FFF);
+
+	while((run < length) && (((address + run) >> 14) < 0x4000))
+	{
+		page += 0x4000;
+		if(memory_map.get_page(address + run) != page) { break; }
+
+		run += 0x4000;
+	}
+
+	return (run < length) ? run : length;
 }
 
 /****** Writes 2 bytes into memory - No checks done on the read, used for known memory locations such as registers ******/
@@ -2196,6 +2728,37 @@ void AGB_MMU::write_u32_fast(u32 address, u32 value)
 	memory_map[address+3] = ((value >> 24) & 0xFF);
 }	
 
+/****** Checks whether a polling loop can read from this address without waiting on anything other than scheduled events ******/
+bool AGB_MMU::is_idle_poll_address(u32 address) const
+{
+	switch(address)
+	{
+		case DISPSTAT:
+		case DISPSTAT+1:
+		case VCOUNT:
+		case VCOUNT+1:
+		case DMA0CNT_H:
+		case DMA0CNT_H+1:
+		case DMA1CNT_H:
+		case DMA1CNT_H+1:
+		case DMA2CNT_H:
+		case DMA2CNT_H+1:
+		case DMA3CNT_H:
+		case DMA3CNT_H+1:
+		case KEYINPUT:
+		case KEYINPUT+1:
+		case REG_IE:
+		case REG_IE+1:
+		case REG_IF:
+		case REG_IF+1:
+		case REG_IME:
+		case REG_IME+1:
+			return true;
+
+		default: return false;
+	}
+}
+
 /****** Read binary file to memory ******/
 bool AGB_MMU::read_file(std::string filename)
 {
@@ -2226,6 +2789,8 @@ bool AGB_MMU::read_file(std::string filename)
 	u32 file_size = file.tellg();
 	file.seekg(0, file.beg);
 
+	//Only allocate as much ROM as the cart needs. AM3 carts only map 1KB of SmartMedia data at a time
+	memory_map.map_rom((config::cart_type == AGB_AM3) ? 0x400 : file_size);
 	u8* ex_mem = &memory_map[0x8000000];
 
 	//For AM3 SmartMedia card dumps, only read 1st 1KB
@@ -2294,27 +2859,33 @@ bool AGB_MMU::read_file(std::string filename)
 	}	
 
 	//Read data from the ROM file
-	else { file.read((char*)ex_mem, file_size); }
+	else
+	{
+		if(file_size > 0x2000000)
+		{
+			std::cout<<"MMU::Warning - ROM is larger than 32MB and will be truncated\n";
+			file_size = 0x2000000;
+		}
+
+		file.read((char*)ex_mem, file_size);
+	}
 
 	file.close();
 
 	//Check if ROM header specifies an NES Classic title, in which case, ROM mirrors need to be setup now
+	//Waitstate 1 and 2 mirrors are handled by the memory map
 	if(memory_map[0x80000AC] == 0x46)
 	{
 		std::cout<<"MMU::Classic NES Title Detected\n";
 
+		memory_map.map_rom(0x2000000);
+
 		for(u32 x = (0x8000000 + file_size), y = 0; x < 0xA000000; x++, y++)
 		{
 			memory_map[x] = memory_map[0x8000000 + (y % file_size)];
 		}
 	}
 
-	for(u32 x = 0; x < file_size; x++)
-	{
-		memory_map[0xA000000 + x] = memory_map[0x8000000 + x];
-		memory_map[0xC000000 + x] = memory_map[0x8000000 + x];
-	}
-
 	std::string title = "";
 	for(u32 x = 0; x < 12; x++) { title += memory_map[0x80000A0 + x]; }
 
@@ -2430,6 +3001,7 @@ bool AGB_MMU::read_file(std::string filename)
 					{
 						std::cout<<"MMU::8M DACS FLASH save type detected\n";
 						current_save_type = DACS;
+						memory_map.map_rom(0x2000000);
 						config::save_file = filename;
 						return true;
 					}
@@ -2502,6 +3074,7 @@ bool AGB_MMU::read_file(std::string filename)
 		case AGB_DACS_FLASH:
 			std::cout<<"MMU::Forcing 8M DACS FLASH save type\n";
 			current_save_type = DACS;
+			memory_map.map_rom(0x2000000);
 			config::save_file = filename;
 			return true;
 
@@ -2580,7 +3153,7 @@ bool AGB_MMU::read_bios(std::string filename)
 	u8* ex_mem = &memory_map[0];
 
 	//Read data from the ROM file
-	file.read((char*)ex_mem, file_size);
+	file.read((char*)ex_mem, 0x4000);
 
 	file.close();
 	std::cout<<"MMU::BIOS file " << filename << " loaded successfully. \n";
@@ -2991,6 +3564,54 @@ bool AGB_MMU::save_backup(std::string filename)
 	return true;
 }
 
+/****** Queues up an event to occur on a specific system cycle ******/
+void AGB_MMU::schedule_event(u8 event_type, u64 event_cycle)
+{
+	scheduler->event_time[event_type] = event_cycle;
+	if(event_cycle < scheduler->next_event) { scheduler->next_event = event_cycle; }
+}
+
+/****** Brings a timer's counter up to date with the current system cycle ******/
+void AGB_MMU::sync_timer(u8 timer_id)
+{
+	u64 elapsed = scheduler->current_cycle - scheduler->timer_sync[timer_id];
+	scheduler->timer_sync[timer_id] = scheduler->current_cycle;
+
+	if((!timer->at(timer_id).enable) || (elapsed == 0)) { return; }
+
+	//Cycles until the prescalar next ticks. Cycles wrap around if the prescalar was lowered mid-count
+	u32 first_tick = ((timer->at(timer_id).prescalar - timer->at(timer_id).cycles - 1) & 0xFFFF) + 1;
+
+	if(elapsed < first_tick)
+	{
+		timer->at(timer_id).cycles += elapsed;
+		return;
+	}
+
+	elapsed -= first_tick;
+	timer->at(timer_id).cycles = (elapsed % timer->at(timer_id).prescalar);
+
+	//Count-up timers are only incremented when the previous timer overflows
+	if(!timer->at(timer_id).count_up) { timer->at(timer_id).counter += (1 + (elapsed / timer->at(timer_id).prescalar)); }
+}
+
+/****** Calculates when a timer will overflow next ******/
+void AGB_MMU::schedule_timer(u8 timer_id)
+{
+	u8 event_type = AGB_TIMER0_EVENT + timer_id;
+
+	if((!timer->at(timer_id).enable) || (timer->at(timer_id).count_up))
+	{
+		scheduler->event_time[event_type] = AGB_NO_EVENT;
+		return;
+	}
+
+	u32 first_tick = ((timer->at(timer_id).prescalar - timer->at(timer_id).cycles - 1) & 0xFFFF) + 1;
+	u64 ticks = 0x10000 - timer->at(timer_id).counter;
+
+	schedule_event(event_type, scheduler->timer_sync[timer_id] + first_tick + ((ticks - 1) * timer->at(timer_id).prescalar));
+}
+
 /****** Start the DMA channels during blanking periods ******/
 void AGB_MMU::start_blank_dma()
 {
@@ -3168,7 +3789,7 @@ u8 AGB_MMU::read_dacs(u32 address)
 
 	//Read from DACS as ROM
 	address -= 0x4000000;
-	return memory_map[address];
+	return memory_map.read(address);
 }
 
 /****** Write 8-bit data to 8M DACS FLASH cartridge and send commands ******/
@@ -11,6 +11,7 @@
 #ifndef GBA_MMU
 #define GBA_MMU
 
+#include <array>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -19,10 +20,70 @@
 #include "common.h"
 #include "gamepad.h"
 #include "timer.h"
+#include "scheduler.h"
 #include "lcd_data.h"
 #include "apu_data.h"
 #include "sio_data.h"
 
+class AGB_LCD;
+
+//GBA memory map - Each memory region has its own buffer, accessed through a table of 16KB pages
+//Mirrored regions share pages. Any other page is only allocated once something touches it
+class agb_memory
+{
+	public:
+
+	agb_memory();
+
+	//Access any byte in the 28-bit address space
+	u8& operator[](u32 address)
+	{
+		u8* page = pages[(address >> 14) & 0x3FFF];
+		if(page == NULL) { page = allocate_page(address); }
+		return page[address & 0x3FFF];
+	}
+
+	//Read any byte without allocating a page - Unmapped addresses read as zero
+	u8 read(u32 address) const
+	{
+		u8* page = pages[(address >> 14) & 0x3FFF];
+		return (page == NULL) ? 0 : page[address & 0x3FFF];
+	}
+
+	//Point at any byte without allocating a page - Unmapped addresses point into a shared zero page that must never be written
+	const u8* read_ptr(u32 address) const
+	{
+		u8* page = pages[(address >> 14) & 0x3FFF];
+		return (page == NULL) ? &zero_page[address & 0x3FFF] : &page[address & 0x3FFF];
+	}
+
+	void reset();
+	void clear();
+	void map_rom(u32 size);
+	u32 rom_size() const;
+	u8* get_page(u32 address) const;
+
+	private:
+
+	u8* allocate_page(u32 address);
+	void map_region(u32 start, u32 end, std::vector<u8>& region);
+
+	u8* pages[0x4000];
+
+	std::vector<u8> bios;
+	std::vector<u8> ewram;
+	std::vector<u8> iwram;
+	std::vector<u8> io;
+	std::vector<u8> palette;
+	std::vector<u8> vram;
+	std::vector<u8> oam;
+	std::vector<u8> rom;
+	std::vector<u8> sram;
+	std::vector<u8> zero_page;
+
+	std::vector< std::vector<u8> > unmapped_pages;
+};
+
 class AGB_MMU
 {
 	public:
@@ -74,7 +135,7 @@ class AGB_MMU
 
 	backup_types current_save_type;
 
-	std::vector <u8> memory_map;
+	agb_memory memory_map;
 
 	//Memory access timings (Nonsequential and Sequential)
 	u8 n_clock;
@@ -82,6 +143,10 @@ class AGB_MMU
 
 	bool bios_lock;
 
+	//Write generation of each 256 byte page of WRAM - 0x000 to 0x3FF = 256KB WRAM, 0x400 to 0x47F = 32KB WRAM
+	//Bumped on every write so the CPU knows when cached code needs to be rebuilt
+	u32 code_gen[0x480];
+
 	//Structure to handle DMA transfers
 	struct dma_controllers
 	{
@@ -393,11 +458,23 @@ class AGB_MMU
 	void reset();
 
 	void start_blank_dma();
+	u32 dma_block(u32 dest_addr, u32 src_addr, u32 count, u8 unit, bool fixed_src);
+
+	u8* get_host_read(u32 address, u32 &length);
+	u8* get_host_write(u32 address, u32 &length);
+	void mark_host_write(u32 address, u32 length);
+
+	void schedule_event(u8 event_type, u64 event_cycle);
+	void sync_timer(u8 timer_id);
+	void schedule_timer(u8 timer_id);
 
 	u8 read_u8(u32 address);
 	u16 read_u16(u32 address);
 	u32 read_u32(u32 address);
 
+	template<typename T> T read(u32 address);
+	template<typename T> void write(u32 address, T value);
+
 	u16 read_u16_fast(u32 address);
 	u32 read_u32_fast(u32 address);
 
@@ -408,6 +485,8 @@ class AGB_MMU
 	void write_u16_fast(u32 address, u16 value);
 	void write_u32_fast(u32 address, u32 value);
 
+	bool is_idle_poll_address(u32 address) const;
+
 	bool read_file(std::string filename);
 	bool read_bios(std::string filename);
 	bool read_am3_firmware(std::string filename);
@@ -512,6 +591,8 @@ class AGB_MMU
 
 	AGB_GamePad* g_pad;
 	std::vector<gba_timer>* timer;
+	agb_scheduler* scheduler;
+	AGB_LCD* lcd;
 
 	//Serialize data for save state loading/saving
 	bool mmu_read(u32 offset, std::string filename);
@@ -531,6 +612,24 @@ class AGB_MMU
 
 	//Only the MMU and SIO should communicate through this structure
 	mag_watch* mw;
+
+	//I/O register write handlers - Indexed by Bits 0-9 of the address for 0x4000000 - 0x40003FF
+	typedef void (AGB_MMU::*io_write_func)(u32, u8);
+	static const std::array<io_write_func, 0x400> io_write_table;
+	static std::array<io_write_func, 0x400> make_io_write_table();
+
+	bool get_direct_read(u32 &address);
+	bool get_direct_write(u32 &address);
+	void mark_direct_write(u32 address, u32 length);
+	u32 get_host_run(u32 address, u32 length);
+
+	void write_lcd_io(u32 address, u8 value);
+	void write_apu_io(u32 address, u8 value);
+	void write_dma_io(u32 address, u8 value);
+	void write_timer_io(u32 address, u8 value);
+	void write_sio_io(u32 address, u8 value);
+	void write_system_io(u32 address, u8 value);
+	void write_plain_io(u32 address, u8 value);
 };
 
 #endif // GBA_MMU
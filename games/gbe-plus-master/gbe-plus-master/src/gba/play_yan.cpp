@@ -560,7 +560,7 @@ void AGB_MMU::write_nmp(u32 address, u8 value)
 /****** Reads from Play-Yan I/O ******/
 u8 AGB_MMU::read_play_yan(u32 address)
 {
-	u8 result = memory_map[address];
+	u8 result = memory_map.read(address);
 
 	//Handle Nintendo MP3 Player writes separately
 	if(play_yan.type == NINTENDO_MP3)
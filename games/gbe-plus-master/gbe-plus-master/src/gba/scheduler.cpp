@@ -0,0 +1,134 @@
+// GB Enhanced+ Copyright Daniel Baxter 2014
+// Licensed under the GPLv2
+// See LICENSE.txt for full license text
+
+// File : scheduler.cpp
+// Date : October 16, 2026
+// Description : GBA event scheduler
+//
+// Runs the LCD, timers, DMAs, and APU only on cycles where they have work to do
+// The CPU advances the system clock in bulk and events are processed as they come due
+
+#include "arm7.h"
+
+/****** Resets the scheduler and queues up initial events ******/
+void ARM7::reset_scheduler()
+{
+	scheduler.current_cycle = 0;
+	scheduler.lcd_sync = 0;
+
+	for(u32 x = 0; x < 4; x++) { scheduler.timer_sync[x] = 0; }
+	for(u32 x = 0; x < AGB_MAX_EVENT; x++) { scheduler.event_time[x] = AGB_NO_EVENT; }
+
+	//LCD state is unknown at this point, so let it step on the very next cycle
+	scheduler.event_time[AGB_LCD_EVENT] = 1;
+	scheduler.next_event = 1;
+}
+
+/****** Processes all events due on or before the current system cycle ******/
+void ARM7::process_events()
+{
+	u64 target_cycle = scheduler.current_cycle;
+
+	while(true)
+	{
+		//Find the earliest event. On ties, the lowest event type goes first
+		u8 event_type = 0;
+		u64 event_cycle = scheduler.event_time[0];
+
+		for(u32 x = 1; x < AGB_MAX_EVENT; x++)
+		{
+			if(scheduler.event_time[x] < event_cycle)
+			{
+				event_type = x;
+				event_cycle = scheduler.event_time[x];
+			}
+		}
+
+		scheduler.next_event = event_cycle;
+		if(event_cycle > target_cycle) { break; }
+
+		//Rewind the clock to the event so anything scheduled from here on is relative to it
+		scheduler.current_cycle = event_cycle;
+		scheduler.event_time[event_type] = AGB_NO_EVENT;
+
+		switch(event_type)
+		{
+			case AGB_LCD_EVENT:
+				//Catch up on cycles where the LCD was idle, then step
+				controllers.video.lcd_clock += (scheduler.current_cycle - scheduler.lcd_sync - 1);
+				controllers.video.step();
+				scheduler.lcd_sync = scheduler.current_cycle;
+
+				mem->schedule_event(AGB_LCD_EVENT, scheduler.current_cycle + controllers.video.cycles_to_next_event());
+
+				//Start HBlank DMAs on the same cycle
+				if((mem->dma[0].enable && mem->dma[0].started) || (mem->dma[3].enable && mem->dma[3].started))
+				{
+					mem->schedule_event(AGB_DMA_EVENT, scheduler.current_cycle);
+				}
+
+				//Generate audio buffers for PSG channels on VBlank
+				if(controllers.video.lcd_clock == 0) { mem->schedule_event(AGB_APU_EVENT, scheduler.current_cycle); }
+
+				break;
+
+			case AGB_TIMER0_EVENT:
+			case AGB_TIMER1_EVENT:
+			case AGB_TIMER2_EVENT:
+			case AGB_TIMER3_EVENT:
+				timer_overflow(event_type - AGB_TIMER0_EVENT);
+				break;
+
+			case AGB_DMA_EVENT:
+				clock_dma();
+
+				//DMAs count down their start delay every cycle
+				//DMAs waiting on HBlank are rescheduled by the LCD
+				for(u32 x = 0; x < 4; x++)
+				{
+					if((mem->dma[x].enable) && (mem->dma[x].delay != 0))
+					{
+						mem->schedule_event(AGB_DMA_EVENT, scheduler.current_cycle + 1);
+						break;
+					}
+				}
+
+				break;
+
+			case AGB_APU_EVENT:
+				if(controllers.audio.apu_stat.psg_needs_fill) { controllers.audio.buffer_channels(); }
+				controllers.audio.apu_stat.psg_needs_fill = true;
+				break;
+		}
+	}
+
+	scheduler.current_cycle = target_cycle;
+}
+
+/****** Brings lazily updated components up to date with the current system cycle ******/
+void ARM7::sync_scheduler()
+{
+	controllers.video.lcd_clock += (scheduler.current_cycle - scheduler.lcd_sync);
+	scheduler.lcd_sync = scheduler.current_cycle;
+
+	for(u32 x = 0; x < 4; x++) { mem->sync_timer(x); }
+}
+
+/****** Rebuilds all events from the current state of the system - Used after loading save states ******/
+void ARM7::reschedule_events()
+{
+	for(u32 x = 0; x < AGB_MAX_EVENT; x++) { scheduler.event_time[x] = AGB_NO_EVENT; }
+	scheduler.next_event = AGB_NO_EVENT;
+
+	scheduler.lcd_sync = scheduler.current_cycle;
+	mem->schedule_event(AGB_LCD_EVENT, scheduler.current_cycle + controllers.video.cycles_to_next_event());
+
+	for(u32 x = 0; x < 4; x++)
+	{
+		scheduler.timer_sync[x] = scheduler.current_cycle;
+		mem->schedule_timer(x);
+
+		if(mem->dma[x].enable) { mem->schedule_event(AGB_DMA_EVENT, scheduler.current_cycle + 1); }
+	}
+}
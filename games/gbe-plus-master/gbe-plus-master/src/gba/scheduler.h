@@ -0,0 +1,44 @@
+// GB Enhanced+ Copyright Daniel Baxter 2014
+// Licensed under the GPLv2
+// See LICENSE.txt for full license text
+
+// File : scheduler.h
+// Date : October 16, 2026
+// Description : GBA event scheduler
+//
+// Defines the data structure used to keep track of upcoming hardware events (LCD, timers, DMA, APU)
+// Each event is stamped with the absolute system cycle it is due on
+// Used as a header file here because multiple components (CPU, MMU) need access to it
+
+#ifndef GBA_SCHEDULER
+#define GBA_SCHEDULER
+
+#include "common.h"
+
+//Events are listed in the order they resolve when several fall on the same cycle
+enum agb_event_types
+{
+	AGB_LCD_EVENT,
+	AGB_TIMER0_EVENT,
+	AGB_TIMER1_EVENT,
+	AGB_TIMER2_EVENT,
+	AGB_TIMER3_EVENT,
+	AGB_DMA_EVENT,
+	AGB_APU_EVENT,
+	AGB_MAX_EVENT,
+};
+
+const u64 AGB_NO_EVENT = 0xFFFFFFFFFFFFFFFFULL;
+
+struct agb_scheduler
+{
+	u64 current_cycle;
+	u64 next_event;
+	u64 event_time[AGB_MAX_EVENT];
+
+	//Last cycle each lazily updated component was brought up to date
+	u64 lcd_sync;
+	u64 timer_sync[4];
+};
+
+#endif // GBA_SCHEDULER
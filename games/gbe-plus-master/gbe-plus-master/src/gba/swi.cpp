@@ -9,6 +9,7 @@
 // Emulates the GBA's Software Interrupts via High Level Emulation
 
 #include <cmath>
+#include <algorithm>
 
 #include "arm7.h"
 
@@ -60,6 +61,7 @@ void ARM7::process_swi(u32 comment)
 		else { set_reg(14, (reg.r15 - 4)); }
 
 		//Set SPSR
+		update_flags();
 		set_spsr(reg.cpsr);
 
 		//Alter CPSR bits, turn off THUMB and IRQ flags, set mode bits
@@ -186,13 +188,13 @@ void ARM7::process_swi(u32 comment)
 		//LZ77UnCompWram
 		case 0x11:
 			std::cout<<"SWI::LZ77 Uncompress Work RAM \n";
-			swi_lz77uncompvram();
+			swi_lz77uncompvram(false);
 			break;
 
 		//LZ77UnCompVram
 		case 0x12:
 			std::cout<<"SWI::LZ77 Uncompress Video RAM \n";
-			swi_lz77uncompvram();
+			swi_lz77uncompvram(true);
 			break;
 
 		//HuffUnComp
@@ -204,13 +206,13 @@ void ARM7::process_swi(u32 comment)
 		//RLUnCompWram
 		case 0x14:
 			std::cout<<"SWI::Run Length Uncompress Work RAM \n";
-			swi_rluncompvram();
+			swi_rluncompvram(false);
 			break;
 
 		//RLUnCompVram
 		case 0x15:
 			std::cout<<"SWI::Run Length Uncompress Video RAM \n";
-			swi_rluncompvram();
+			swi_rluncompvram(true);
 			break;
 
 		//Diff8bitUnFilterWram
@@ -361,6 +363,8 @@ void ARM7::swi_softreset()
 
 	//Clear top 0x200 bytes of the 32KB WRAM
 	for(int x = 0x3007E00; x < 0x3008000; x++) { mem->memory_map[x] = 0; }
+	mem->code_gen[0x47E]++;
+	mem->code_gen[0x47F]++;
 
 	arm_mode = ARM;
 	in_interrupt = false;
@@ -446,7 +450,7 @@ void ARM7::swi_halt()
 	//Run controllers until an interrupt happens
 	while(halt)
 	{
-		clock();
+		clock_idle();
 
 		if_check = mem->read_u16(REG_IF);
 		ie_check = mem->read_u16(REG_IE);
@@ -643,32 +647,23 @@ void ARM7::swi_cpufastset()
 	//Determine if the transfer operation is copy or fill - Bit 24 of R2
 	u8 copy_fill = (transfer_control & 0x1000000) ? 1 : 0;
 
-	u32 temp = 0;
-
 	while(transfer_size != 0)
 	{
-		//Copy from source to destination
-		if(copy_fill == 0)
-		{
-			temp = mem->read_u32(src_addr);
-			mem->write_u32(dest_addr, temp);
-			
-			src_addr += 4;
-			dest_addr += 4;
-
-			transfer_size--;
-		}
+		//Copy or fill runs of plain memory directly
+		u32 count = mem->dma_block(dest_addr, src_addr, transfer_size, 4, (copy_fill == 1));
 
-		//Fill first entry from source with destination
-		else
+		//Everything else moves one word at a time
+		if(count == 0)
 		{
-			temp = mem->read_u32(src_addr);
-			mem->write_u32(dest_addr, temp);
-			
-			dest_addr += 4;
-			
-			transfer_size--;
+			mem->write_u32(dest_addr, mem->read_u32(src_addr));
+			count = 1;
 		}
+
+		//Fills keep reading the first entry from source
+		if(copy_fill == 0) { src_addr += (count * 4); }
+
+		dest_addr += (count * 4);
+		transfer_size -= count;
 	}
 
 	//Write-back R0, R1
@@ -702,64 +697,30 @@ void ARM7::swi_cpuset()
 
 	//Determine if the transfer operation is 16 or 32-bit - Bit 26 of R2
 	u8 transfer_type = (transfer_control & 0x4000000) ? 1 : 0;
+	u8 unit = (transfer_type == 0) ? 2 : 4;
 
 	src_addr &= (transfer_type == 0) ? ~0x1 : ~0x3;
 	dest_addr &= (transfer_type == 0) ? ~0x1 : ~0x3; 
 
-	u32 temp_32 = 0;
-	u16 temp_16 = 0;
-
 	while(transfer_size != 0)
 	{
-		//Copy from source to destination
-		if(copy_fill == 0)
-		{
-			//16-bit transfer
-			if(transfer_type == 0)
-			{
-				temp_16 = mem->read_u16(src_addr);
-				mem->write_u16(dest_addr, temp_16);
-			
-				src_addr += 2;
-				dest_addr += 2;
-			}
+		//Copy or fill runs of plain memory directly
+		u32 count = mem->dma_block(dest_addr, src_addr, transfer_size, unit, (copy_fill == 1));
 
-			//32-bit transfer
-			else
-			{
-				temp_32 = mem->read_u32(src_addr);
-				mem->write_u32(dest_addr, temp_32);
-			
-				src_addr += 4;
-				dest_addr += 4;
-			}
+		//Everything else moves one unit at a time
+		if(count == 0)
+		{
+			if(transfer_type == 0) { mem->write_u16(dest_addr, mem->read_u16(src_addr)); }
+			else { mem->write_u32(dest_addr, mem->read_u32(src_addr)); }
 
-			transfer_size--;
+			count = 1;
 		}
 
-		//Fill first entry from source with destination
-		else
-		{
-			//16-bit transfer
-			if(transfer_type == 0)
-			{
-				temp_16 = mem->read_u16(src_addr);
-				mem->write_u16(dest_addr, temp_16);
-			
-				dest_addr += 2;
-			}
+		//Fills keep reading the first entry from source
+		if(copy_fill == 0) { src_addr += (count * unit); }
 
-			//32-bit transfer
-			else
-			{
-				temp_32 = mem->read_u32(src_addr);
-				mem->write_u32(dest_addr, temp_32);
-			
-				dest_addr += 4;
-			}
-			
-			transfer_size--;
-		}
+		dest_addr += (count * unit);
+		transfer_size -= count;
 	}
 
 	//Write-back R0, R1
@@ -790,7 +751,7 @@ void ARM7::swi_intrwait()
 	//Run controllers until an interrupt is generated
 	while(!fire_interrupt)
 	{
-		clock();
+		clock_idle();
 
 		current_if = mem->read_u16_fast(REG_IF);
 		ie_check = mem->read_u16_fast(REG_IE);
@@ -836,7 +797,7 @@ void ARM7::swi_vblankintrwait()
 	//Run controllers until an interrupt is generated
 	while(!fire_interrupt && !is_vblank)
 	{
-		clock();
+		clock_idle();
 
 		if_check = mem->read_u16_fast(REG_IF);
 		ie_check = mem->read_u16_fast(REG_IE);
@@ -908,6 +869,16 @@ void ARM7::swi_bitunpack()
 	u8 zero_flag = (data_offset & 0x80000000) ? 1 : 0;
 	data_offset &= ~0x80000000;
 
+	//Resolve source and destination to host memory once, anything past either goes through the MMU
+	//At worst, every bit of the source becomes a whole 32-bit value
+	u32 src_room = length;
+	u32 dest_room = (length * 32);
+	u8* src = mem->get_host_read(src_addr, src_room);
+	u8* dest = mem->get_host_write(dest_addr, dest_room);
+
+	u32 src_pos = 0;
+	u32 dest_pos = 0;
+
 	u8 src_byte = 0;
 	u8 src_count = 0;
 	u32 result = 0;
@@ -923,7 +894,8 @@ void ARM7::swi_bitunpack()
 			//Grab new source byte
 			if((src_count % 8) == 0) 
 			{
-				src_byte = mem->read_u8(src_addr++);
+				src_byte = (src_pos < src_room) ? src[src_pos] : mem->read_u8(src_addr + src_pos);
+				src_pos++;
 				length--;
 			}
 
@@ -940,13 +912,24 @@ void ARM7::swi_bitunpack()
 		}
 
 		//Write result to the destination address
-		mem->write_u32(dest_addr, result);
-		dest_addr += 4;
+		if((dest_pos + 4) <= dest_room)
+		{
+			dest[dest_pos] = (result & 0xFF);
+			dest[dest_pos + 1] = ((result >> 8) & 0xFF);
+			dest[dest_pos + 2] = ((result >> 16) & 0xFF);
+			dest[dest_pos + 3] = ((result >> 24) & 0xFF);
+		}
+
+		else { mem->write_u32(dest_addr + dest_pos, result); }
+
+		dest_pos += 4;
 	}
+
+	mem->mark_host_write(dest_addr, std::min(dest_pos, dest_room));
 }			
 
 /****** HLE implementation of LZ77UnCompVram ******/
-void ARM7::swi_lz77uncompvram()
+void ARM7::swi_lz77uncompvram(bool vram)
 {
 	bios_read_state = BIOS_SWI_FINISH;
 
@@ -962,58 +945,106 @@ void ARM7::swi_lz77uncompvram()
 	//Grab compressed data size in bytes
 	u32 data_size = (data_header >> 8);
 
-	//Pointer to current address of compressed data that needs to be processed
-	//When uncompression starts, move 5 bytes from source address (header + flag)
+	//Pointer to compressed data that needs to be processed, right after the header
 	u32 data_ptr = (src_addr + 4);
 
-	u8 temp = 0;
+	//Resolve source and destination to host memory once, anything past either goes through the MMU
+	//At worst, every block is one uncompressed byte, with a flag byte for every 8 blocks
+	u32 src_room = data_size + (data_size >> 3) + 2;
+	u32 dest_room = data_size;
+	u8* src = mem->get_host_read(data_ptr, src_room);
+	u8* dest = mem->get_host_write(dest_addr, dest_room);
+
+	u32 src_pos = 0;
+	u32 dest_pos = 0;
+	u16 half_data = 0;
 
 	//Uncompress data
-	while(data_size > 0)
+	while(dest_pos < data_size)
 	{
 		//Grab flag data
-		u8 flag_data = mem->read_u8(data_ptr++);
+		u8 flag_data = (src_pos < src_room) ? src[src_pos] : mem->read_u8(data_ptr + src_pos);
+		src_pos++;
 
 		//Process 8 blocks
-		for(int x = 7; x >= 0; x--)
+		for(int x = 7; (x >= 0) && (dest_pos < data_size); x--)
 		{
-			u8 block_type = (flag_data & (1 << x)) ? 1 : 0;
-
 			//Block Type 0 - Uncompressed
-			if(block_type == 0)
+			if((flag_data & (1 << x)) == 0)
 			{
-				temp = mem->read_u8(data_ptr++);
-				mem->write_u8(dest_addr++, temp);
-				
-				data_size--;
-				if(data_size == 0) { return; }
-			}
+				u8 temp = (src_pos < src_room) ? src[src_pos] : mem->read_u8(data_ptr + src_pos);
+				src_pos++;
 
+				if(!vram)
+				{
+					if(dest_pos < dest_room) { dest[dest_pos] = temp; }
+					else { mem->write_u8(dest_addr + dest_pos, temp); }
+				}
+
+				//VRAM only takes halfwords, hold even bytes until the odd byte completes one
+				else if((dest_pos & 1) == 0) { half_data = temp; }
+
+				else
+				{
+					half_data |= (temp << 8);
+
+					if(dest_pos < dest_room)
+					{
+						dest[dest_pos - 1] = (half_data & 0xFF);
+						dest[dest_pos] = (half_data >> 8);
+					}
+
+					else { mem->write_u16(dest_addr + dest_pos - 1, half_data); }
+				}
+
+				dest_pos++;
+			}
 
 			//Block Type 1 - Compressed
 			else
 			{
-				u16 compressed_block = mem->read_u16(data_ptr);
-				data_ptr += 2;
-
-				u16 distance = ((compressed_block & 0xF) << 8);
-				distance |= (compressed_block >> 8);
+				u8 block_hi = (src_pos < src_room) ? src[src_pos] : mem->read_u8(data_ptr + src_pos);
+				u8 block_lo = ((src_pos + 1) < src_room) ? src[src_pos + 1] : mem->read_u8(data_ptr + src_pos + 1);
+				src_pos += 2;
 
-				u8 length = ((compressed_block >> 4) & 0xF) + 3;
+				u32 distance = (((block_hi & 0xF) << 8) | block_lo) + 1;
+				u8 length = (block_hi >> 4) + 3;
 
-				//Copy length+3 Bytes from dest_addr-length-1 to dest_addr
-				for(int y = 0; y < length; y++)
+				//Copy length+3 Bytes from dest_addr-distance-1 to dest_addr
+				for(u32 y = 0; (y < length) && (dest_pos < data_size); y++)
 				{
-					temp = mem->read_u8(dest_addr - distance - 1);
-					mem->write_u8(dest_addr, temp);
-					
-					dest_addr++;
-					data_size--;
-					if(data_size == 0) { return; }
+					u32 back_pos = dest_pos - distance;
+					u8 temp = (back_pos < dest_room) ? dest[back_pos] : mem->read_u8(dest_addr + back_pos);
+
+					if(!vram)
+					{
+						if(dest_pos < dest_room) { dest[dest_pos] = temp; }
+						else { mem->write_u8(dest_addr + dest_pos, temp); }
+					}
+
+					else if((dest_pos & 1) == 0) { half_data = temp; }
+
+					else
+					{
+						half_data |= (temp << 8);
+
+						if(dest_pos < dest_room)
+						{
+							dest[dest_pos - 1] = (half_data & 0xFF);
+							dest[dest_pos] = (half_data >> 8);
+						}
+
+						else { mem->write_u16(dest_addr + dest_pos - 1, half_data); }
+					}
+
+					dest_pos++;
 				}
 			}
 		}
 	}
+
+	//A trailing odd byte never completes a halfword, so VRAM never sees it
+	mem->mark_host_write(dest_addr, std::min(dest_pos, dest_room));
 }
 
 /****** HLE implementation of HuffUnComp ******/
@@ -1061,13 +1092,22 @@ void ARM7::swi_huffuncomp()
 
 	bool is_data_node = false;
 
+	//Resolve the tree and destination to host memory once, anything past either goes through the MMU
+	u32 tree_room = tree_size;
+	u32 dest_room = data_size;
+	u8* tree = mem->get_host_read(root_node_addr, tree_room);
+	u8* dest = mem->get_host_write(dest_addr, dest_room);
+
+	u32 dest_pos = 0;
+
 	//Uncompress data
 	while(data_size > 0)
 	{
 		//Begin parsing the nodes, starting with root node
 		while(bitstream_mask != 0)
 		{
-			u8 node = mem->read_u8(data_ptr);
+			u32 node_pos = (data_ptr - root_node_addr);
+			u8 node = (node_pos < tree_room) ? tree[node_pos] : mem->read_u8(data_ptr);
 			u8 node_offset = (node & 0x3F);
 			u8 node_0_type = (node & 0x80) ? 1 : 0;
 			u8 node_1_type = (node & 0x40) ? 1 : 0;
@@ -1088,13 +1128,26 @@ void ARM7::swi_huffuncomp()
 				//Transfer completed 32-bit value to memory
 				if(data_shift >= 32) 
 				{
-					mem->write_u32(dest_addr, temp);
-					dest_addr += 4;
+					if((dest_pos + 4) <= dest_room)
+					{
+						dest[dest_pos] = (temp & 0xFF);
+						dest[dest_pos + 1] = ((temp >> 8) & 0xFF);
+						dest[dest_pos + 2] = ((temp >> 16) & 0xFF);
+						dest[dest_pos + 3] = ((temp >> 24) & 0xFF);
+					}
+
+					else { mem->write_u32(dest_addr + dest_pos, temp); }
+
+					dest_pos += 4;
 					data_size -= 4;
 					temp = 0;
 					data_shift = 0;
 
-					if(data_size == 0) { return; } 
+					if(data_size == 0)
+					{
+						mem->mark_host_write(dest_addr, std::min(dest_pos, dest_room));
+						return;
+					} 
 				}
 
 				//Return to root node
@@ -1137,10 +1190,12 @@ void ARM7::swi_huffuncomp()
 		bitstream = mem->read_u32(bitstream_addr);
 		bitstream_mask = 0x80000000;
 	}
+
+	mem->mark_host_write(dest_addr, std::min(dest_pos, dest_room));
 }
 
 /****** HLE implementation of RLUnCompVram ******/
-void ARM7::swi_rluncompvram()
+void ARM7::swi_rluncompvram(bool vram)
 {
 	bios_read_state = BIOS_SWI_FINISH;
 
@@ -1158,10 +1213,22 @@ void ARM7::swi_rluncompvram()
 	//Data pointer to compressed data. Points to first flag.
 	u32 data_ptr = (src_addr + 4);
 
+	//Resolve source and destination to host memory once, anything past either goes through the MMU
+	//At worst, every byte is a run of one uncompressed byte
+	u32 src_room = (data_size * 2);
+	u32 dest_room = data_size;
+	u8* src = mem->get_host_read(data_ptr, src_room);
+	u8* dest = mem->get_host_write(dest_addr, dest_room);
+
+	u32 src_pos = 0;
+	u32 dest_pos = 0;
+	u16 half_data = 0;
+
 	//Uncompress data
-	while(data_size > 0)
+	while(dest_pos < data_size)
 	{
-		u8 flag = mem->read_u8(data_ptr++);
+		u8 flag = (src_pos < src_room) ? src[src_pos] : mem->read_u8(data_ptr + src_pos);
+		src_pos++;
 
 		u8 data_length = (flag & 0x7F);
 
@@ -1170,27 +1237,46 @@ void ARM7::swi_rluncompvram()
 		else { data_length += 1; }
 
 		//Output the specified byte the amount of times in data_length
-		for(int x = 0; x < data_length; x++)
+		for(u32 x = 0; (x < data_length) && (dest_pos < data_size); x++)
 		{
-			u8 data_byte = 0;
+			u8 data_byte = (src_pos < src_room) ? src[src_pos] : mem->read_u8(data_ptr + src_pos);
 
-			//Compressed
-			if(flag & 0x80) { data_byte = mem->read_u8(data_ptr); }
+			//Uncompressed data moves on every byte
+			if((flag & 0x80) == 0) { src_pos++; }
 
-			//Uncompressed
-			else { data_byte = mem->read_u8(data_ptr++); }
-				
-			mem->write_u8(dest_addr++, data_byte);
-			data_size--;
+			if(!vram)
+			{
+				if(dest_pos < dest_room) { dest[dest_pos] = data_byte; }
+				else { mem->write_u8(dest_addr + dest_pos, data_byte); }
+			}
+
+			//VRAM only takes halfwords, hold even bytes until the odd byte completes one
+			else if((dest_pos & 1) == 0) { half_data = data_byte; }
 
-			if(data_size == 0) { return; }
+			else
+			{
+				half_data |= (data_byte << 8);
+
+				if(dest_pos < dest_room)
+				{
+					dest[dest_pos - 1] = (half_data & 0xFF);
+					dest[dest_pos] = (half_data >> 8);
+				}
+
+				else { mem->write_u16(dest_addr + dest_pos - 1, half_data); }
+			}
+
+			dest_pos++;
 		}
 
 		//Manually adjust data pointer for compressed data to point to next flag
-		if(flag & 0x80) { data_ptr++; }
+		if(flag & 0x80) { src_pos++; }
 	}
-}		
-	
+
+	//A trailing odd byte never completes a halfword, so VRAM never sees it
+	mem->mark_host_write(dest_addr, std::min(dest_pos, dest_room));
+}
+
 /****** HLE implementation of GetBIOSChecksum ******/
 void ARM7::swi_getbioschecksum()
 {
@@ -566,7 +566,7 @@ u32 MIN_core::ex_get_reg(u8 reg_index)
 		case 0x4: return core_cpu.reg.br;
 		case 0x5: return core_cpu.reg.sp;
 		case 0x6: return core_cpu.reg.pc;
-		case 0x7: return core_cpu.reg.sc;
+		case 0x7: return core_cpu.get_sc();
 		case 0x8: return core_cpu.reg.cc;
 		default: return 0;
 	}
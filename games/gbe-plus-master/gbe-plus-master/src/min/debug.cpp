@@ -828,29 +828,31 @@ void MIN_core::debug_display() const
 	std::cout<< std::hex <<"XP : 0x" << std::setw(2) << std::setfill('0') << (u32)core_cpu.reg.xp <<
 		" -- YP  : 0x" << std::setw(4) << std::setfill('0') << (u32)core_cpu.reg.yp << "\n";
 
+	u8 sc = core_cpu.get_sc();
+
 	std::string flag_stats = "(";
 
-	if(core_cpu.reg.sc & 0x20) { flag_stats += "U"; }
+	if(sc & 0x20) { flag_stats += "U"; }
 	else { flag_stats += "."; }
 
-	if(core_cpu.reg.sc & 0x10) { flag_stats += "D"; }
+	if(sc & 0x10) { flag_stats += "D"; }
 	else { flag_stats += "."; }
 
-	if(core_cpu.reg.sc & 0x08) { flag_stats += "N"; }
+	if(sc & 0x08) { flag_stats += "N"; }
 	else { flag_stats += "."; }
 
-	if(core_cpu.reg.sc & 0x04) { flag_stats += "O"; }
+	if(sc & 0x04) { flag_stats += "O"; }
 	else { flag_stats += "."; }
 
-	if(core_cpu.reg.sc & 0x02) { flag_stats += "C"; }
+	if(sc & 0x02) { flag_stats += "C"; }
 	else { flag_stats += "."; }
 
-	if(core_cpu.reg.sc & 0x01) { flag_stats += "Z"; }
+	if(sc & 0x01) { flag_stats += "Z"; }
 	else { flag_stats += "."; }
 
 	flag_stats += ")";
 
-	std::cout<< std::hex <<"FLAGS : 0x" << std::setw(2) << std::setfill('0') << (u32)core_cpu.reg.sc << "\t" << flag_stats << "\n";
+	std::cout<< std::hex <<"FLAGS : 0x" << std::setw(2) << std::setfill('0') << (u32)sc << "\t" << flag_stats << "\n";
 }
 
 /****** Debugger - Wait for user input, process it to decide what next to do ******/
@@ -1207,6 +1209,7 @@ void MIN_core::debug_process_command()
 					case 0x09:
 						std::cout<<"\nSetting Register SC to 0x" << std::hex << reg_value << "\n";
 						core_cpu.reg.sc = reg_value;
+						core_cpu.flag_op = S1C88_FLAGS_NONE;
 						break;
 
 					case 0x0A:
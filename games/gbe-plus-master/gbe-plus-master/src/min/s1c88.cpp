@@ -35,6 +35,7 @@ void S1C88::reset()
 	reg.iy = 0;
 	reg.br = 0;
 	reg.sc = 0;
+	flag_op = S1C88_FLAGS_NONE;
 	reg.cc = 0;
 	reg.ep = 0;
 	reg.xp = 0;
@@ -99,6 +100,95 @@ void S1C88::reset()
 	std::cout<<"CPU::Initialized\n";
 }
 
+/****** Records an ALU operation so its flags can be worked out when something reads SC ******/
+void S1C88::defer_flags(u8 op, u32 input, u32 operand, u32 result, u8 carry, u32 msb)
+{
+	flag_op = op;
+	flag_input = input;
+	flag_operand = operand;
+	flag_result = result;
+	flag_carry = carry;
+	flag_msb = msb;
+}
+
+/****** Returns the SC register with the last ALU operation applied ******/
+u8 S1C88::get_sc() const
+{
+	u8 sc = reg.sc;
+
+	switch(flag_op)
+	{
+		//Addition and subtraction set all four flags
+		case S1C88_FLAGS_ADD:
+		case S1C88_FLAGS_SUB:
+			{
+				u32 mask = (flag_msb << 1) - 1;
+				s32 input = (flag_input & flag_msb) ? s32(flag_input) - s32(mask + 1) : s32(flag_input);
+				s32 operand = (flag_operand & flag_msb) ? s32(flag_operand) - s32(mask + 1) : s32(flag_operand);
+				s32 o_flag = 0;
+				bool c_flag = false;
+
+				if(flag_op == S1C88_FLAGS_ADD)
+				{
+					o_flag = input + operand + flag_carry;
+					c_flag = ((flag_input + flag_operand + flag_carry) > mask);
+				}
+
+				else
+				{
+					o_flag = input - operand - flag_carry;
+					c_flag = ((flag_operand + flag_carry) > flag_input);
+				}
+
+				sc &= ~(ZERO_FLAG | CARRY_FLAG | OVERFLOW_FLAG | NEGATIVE_FLAG);
+
+				//Zero flag
+				if(!flag_result) { sc |= ZERO_FLAG; }
+
+				//Carry flag
+				if(c_flag) { sc |= CARRY_FLAG; }
+
+				//Overflow flag
+				if((o_flag > s32(flag_msb - 1)) || (o_flag < -s32(flag_msb))) { sc |= OVERFLOW_FLAG; }
+
+				//Negative flag
+				if(flag_result & flag_msb) { sc |= NEGATIVE_FLAG; }
+			}
+
+			break;
+
+		//Logical operations only set Zero and Negative
+		case S1C88_FLAGS_LOGICAL:
+			sc &= ~(ZERO_FLAG | NEGATIVE_FLAG);
+
+			//Zero flag
+			if(!flag_result) { sc |= ZERO_FLAG; }
+
+			//Negative flag
+			if(flag_result & 0x80) { sc |= NEGATIVE_FLAG; }
+
+			break;
+
+		//Increments and decrements only set Zero
+		case S1C88_FLAGS_ZERO:
+			if(!flag_result) { sc |= ZERO_FLAG; }
+			else { sc &= ~ZERO_FLAG; }
+
+			break;
+	}
+
+	return sc;
+}
+
+/****** Updates the SC register from the last ALU operation ******/
+void S1C88::update_flags()
+{
+	if(flag_op == S1C88_FLAGS_NONE) { return; }
+
+	reg.sc = get_sc();
+	flag_op = S1C88_FLAGS_NONE;
+}
+
 /****** Adds 2 8-bit registers ******/
 u8 S1C88::add_u8(u8 reg_one, u8 reg_two)
 {
@@ -113,6 +203,8 @@ u8 S1C88::add_u8(u8 reg_one, u8 reg_two)
 		//Unpacked operation
 		if(reg.sc & UNPACK_FLAG)
 		{
+			update_flags();
+
 			reg_one &= 0xF;
 			reg_two &= 0xF;
 
@@ -143,32 +235,15 @@ u8 S1C88::add_u8(u8 reg_one, u8 reg_two)
 		else
 		{
 			result = reg_one + reg_two;
-
-			c_flag = reg_one + reg_two;
-			o_flag = comp8(reg_one) + comp8(reg_two);
-
-			//Zero flag
-			if(!result) { reg.sc |= ZERO_FLAG; }
-			else { reg.sc &= ~ZERO_FLAG; }
-
-			//Carry flag
-			if(c_flag >= 0x100) { reg.sc |= CARRY_FLAG; }
-			else { reg.sc &= ~CARRY_FLAG; }
-
-			//Overflow flag
-			if(o_flag > MAX_8) { reg.sc |= OVERFLOW_FLAG; }
-			else if(o_flag < MIN_8) { reg.sc |= OVERFLOW_FLAG; }
-			else { reg.sc &= ~OVERFLOW_FLAG; }
-
-			//Negative flag
-			if(result & 0x80) { reg.sc |= NEGATIVE_FLAG; }
-			else { reg.sc &= ~NEGATIVE_FLAG; }
+			defer_flags(S1C88_FLAGS_ADD, reg_one, reg_two, result, 0, 0x80);
 		}
 	}
 
 	//Decimal Mode
 	else
 	{
+		update_flags();
+
 		//Convert registers into BCD format - Unpacked
 		if(reg.sc & UNPACK_FLAG)
 		{
@@ -211,32 +286,8 @@ u8 S1C88::add_u8(u8 reg_one, u8 reg_two)
 /****** Adds 2 16-bit registers ******/
 u16 S1C88::add_u16(u16 reg_one, u16 reg_two)
 {
-	u16 result;
-
-	u32 c_flag;
-	s32 o_flag;
-
-	result = reg_one + reg_two;
-
-	c_flag = reg_one + reg_two;
-	o_flag = comp16(reg_one) + comp16(reg_two);
-
-	//Zero flag
-	if(!result) { reg.sc |= ZERO_FLAG; }
-	else { reg.sc &= ~ZERO_FLAG; }
-
-	//Carry flag
-	if(c_flag >= 0x10000) { reg.sc |= CARRY_FLAG; }
-	else { reg.sc &= ~CARRY_FLAG; }
-
-	//Overflow flag
-	if(o_flag > MAX_16) { reg.sc |= OVERFLOW_FLAG; }
-	else if(o_flag < MIN_16) { reg.sc |= OVERFLOW_FLAG; }
-	else { reg.sc &= ~OVERFLOW_FLAG; }
-
-	//Negative flag
-	if(result & 0x8000) { reg.sc |= NEGATIVE_FLAG; }
-	else { reg.sc &= ~NEGATIVE_FLAG; }
+	u16 result = reg_one + reg_two;
+	defer_flags(S1C88_FLAGS_ADD, reg_one, reg_two, result, 0, 0x8000);
 
 	return result;
 }
@@ -244,6 +295,8 @@ u16 S1C88::add_u16(u16 reg_one, u16 reg_two)
 /****** Adds 2 8-bit registers + Carry ******/
 u8 S1C88::adc_u8(u8 reg_one, u8 reg_two)
 {
+	update_flags();
+
 	u8 carry = (reg.sc & 0x2) ? 1 : 0;
 	u8 result;
 
@@ -256,6 +309,8 @@ u8 S1C88::adc_u8(u8 reg_one, u8 reg_two)
 		//Unpacked operation
 		if(reg.sc & UNPACK_FLAG)
 		{
+			update_flags();
+
 			reg_one &= 0xF;
 			reg_two &= 0xF;
 
@@ -286,32 +341,15 @@ u8 S1C88::adc_u8(u8 reg_one, u8 reg_two)
 		else
 		{
 			result = reg_one + reg_two + carry;
-
-			c_flag = reg_one + reg_two + carry;
-			o_flag = comp8(reg_one) + comp8(reg_two) + carry;
-
-			//Zero flag
-			if(!result) { reg.sc |= ZERO_FLAG; }
-			else { reg.sc &= ~ZERO_FLAG; }
-
-			//Carry flag
-			if(c_flag >= 0x100) { reg.sc |= CARRY_FLAG; }
-			else { reg.sc &= ~CARRY_FLAG; }
-
-			//Overflow flag
-			if(o_flag > MAX_8) { reg.sc |= OVERFLOW_FLAG; }
-			else if(o_flag < MIN_8) { reg.sc |= OVERFLOW_FLAG; }
-			else { reg.sc &= ~OVERFLOW_FLAG; }
-
-			//Negative flag
-			if(result & 0x80) { reg.sc |= NEGATIVE_FLAG; }
-			else { reg.sc &= ~NEGATIVE_FLAG; }
+			defer_flags(S1C88_FLAGS_ADD, reg_one, reg_two, result, carry, 0x80);
 		}
 	}
 
 	//Decimal Mode
 	else
 	{
+		update_flags();
+
 		//Convert registers into BCD format - Unpacked
 		if(reg.sc & UNPACK_FLAG)
 		{
@@ -356,33 +394,11 @@ u8 S1C88::adc_u8(u8 reg_one, u8 reg_two)
 /****** Adds 2 16-bit registers + Carry ******/
 u16 S1C88::adc_u16(u16 reg_one, u16 reg_two)
 {
-	u8 carry = (reg.sc & 0x2) ? 1 : 0;
-	u16 result;
-
-	u32 c_flag;
-	s32 o_flag;
-
-	result = reg_one + reg_two + carry;
-
-	c_flag = reg_one + reg_two + carry;
-	o_flag = comp16(reg_one) + comp16(reg_two) + carry;
+	update_flags();
 
-	//Zero flag
-	if(!result) { reg.sc |= ZERO_FLAG; }
-	else { reg.sc &= ~ZERO_FLAG; }
-
-	//Carry flag
-	if(c_flag >= 0x10000) { reg.sc |= CARRY_FLAG; }
-	else { reg.sc &= ~CARRY_FLAG; }
-
-	//Overflow flag
-	if(o_flag > MAX_16) { reg.sc |= OVERFLOW_FLAG; }
-	else if(o_flag < MIN_16) { reg.sc |= OVERFLOW_FLAG; }
-	else { reg.sc &= ~OVERFLOW_FLAG; }
-
-	//Negative flag
-	if(result & 0x8000) { reg.sc |= NEGATIVE_FLAG; }
-	else { reg.sc &= ~NEGATIVE_FLAG; }
+	u8 carry = (reg.sc & 0x2) ? 1 : 0;
+	u16 result = reg_one + reg_two + carry;
+	defer_flags(S1C88_FLAGS_ADD, reg_one, reg_two, result, carry, 0x8000);
 
 	return result;
 }
@@ -400,6 +416,8 @@ u8 S1C88::sub_u8(u8 reg_one, u8 reg_two)
 		//Unpacked operation
 		if(reg.sc & UNPACK_FLAG)
 		{
+			update_flags();
+
 			reg_one &= 0xF;
 			reg_two &= 0xF;
 
@@ -428,30 +446,15 @@ u8 S1C88::sub_u8(u8 reg_one, u8 reg_two)
 		else
 		{
 			result = reg_one - reg_two;
-			o_flag = comp8(reg_one) - comp8(reg_two);
-
-			//Zero flag
-			if(!result) { reg.sc |= ZERO_FLAG; }
-			else { reg.sc &= ~ZERO_FLAG; }
-
-			//Carry flag
-			if(reg_two > reg_one) { reg.sc |= CARRY_FLAG; }
-			else { reg.sc &= ~CARRY_FLAG; }
-
-			//Overflow flag
-			if(o_flag > MAX_8) { reg.sc |= OVERFLOW_FLAG; }
-			else if(o_flag < MIN_8) { reg.sc |= OVERFLOW_FLAG; }
-			else { reg.sc &= ~OVERFLOW_FLAG; }
-
-			//Negative flag
-			if(result & 0x80) { reg.sc |= NEGATIVE_FLAG; }
-			else { reg.sc &= ~NEGATIVE_FLAG; }
+			defer_flags(S1C88_FLAGS_SUB, reg_one, reg_two, result, 0, 0x80);
 		}
 	}
 
 	//Decimal Mode
 	else
 	{
+		update_flags();
+
 		//Convert registers into BCD format - Unpacked
 		if(reg.sc & UNPACK_FLAG)
 		{
@@ -493,28 +496,8 @@ u8 S1C88::sub_u8(u8 reg_one, u8 reg_two)
 /****** Subtracts 2 16-bit registers ******/
 u16 S1C88::sub_u16(u16 reg_one, u16 reg_two)
 {
-	u16 result;
-	s32 o_flag;
-
-	result = reg_one - reg_two;
-	o_flag = comp16(reg_one) - comp16(reg_two);
-
-	//Zero flag
-	if(!result) { reg.sc |= ZERO_FLAG; }
-	else { reg.sc &= ~ZERO_FLAG; }
-
-	//Carry flag
-	if(reg_two > reg_one) { reg.sc |= CARRY_FLAG; }
-	else { reg.sc &= ~CARRY_FLAG; }
-
-	//Overflow flag
-	if(o_flag > MAX_16) { reg.sc |= OVERFLOW_FLAG; }
-	else if(o_flag < MIN_16) { reg.sc |= OVERFLOW_FLAG; }
-	else { reg.sc &= ~OVERFLOW_FLAG; }
-
-	//Negative flag
-	if(result & 0x8000) { reg.sc |= NEGATIVE_FLAG; }
-	else { reg.sc &= ~NEGATIVE_FLAG; }
+	u16 result = reg_one - reg_two;
+	defer_flags(S1C88_FLAGS_SUB, reg_one, reg_two, result, 0, 0x8000);
 
 	return result;
 }
@@ -522,6 +505,8 @@ u16 S1C88::sub_u16(u16 reg_one, u16 reg_two)
 /****** Subtracts 2 8-bit registers - Carry ******/
 u8 S1C88::sbc_u8(u8 reg_one, u8 reg_two)
 {
+	update_flags();
+
 	u8 carry = (reg.sc & 0x2) ? 1 : 0;
 	u8 result;
 
@@ -533,6 +518,8 @@ u8 S1C88::sbc_u8(u8 reg_one, u8 reg_two)
 		//Unpacked operation
 		if(reg.sc & UNPACK_FLAG)
 		{
+			update_flags();
+
 			reg_one &= 0xF;
 			reg_two &= 0xF;
 
@@ -561,30 +548,15 @@ u8 S1C88::sbc_u8(u8 reg_one, u8 reg_two)
 		else
 		{
 			result = reg_one - reg_two - carry;
-			o_flag = comp8(reg_one) - comp8(reg_two) - carry;
-
-			//Zero flag
-			if(!result) { reg.sc |= ZERO_FLAG; }
-			else { reg.sc &= ~ZERO_FLAG; }
-
-			//Carry flag
-			if((reg_two + carry) > reg_one) { reg.sc |= CARRY_FLAG; }
-			else { reg.sc &= ~CARRY_FLAG; }
-
-			//Overflow flag
-			if(o_flag > MAX_8) { reg.sc |= OVERFLOW_FLAG; }
-			else if(o_flag < MIN_8) { reg.sc |= OVERFLOW_FLAG; }
-			else { reg.sc &= ~OVERFLOW_FLAG; }
-
-			//Negative flag
-			if(result & 0x80) { reg.sc |= NEGATIVE_FLAG; }
-			else { reg.sc &= ~NEGATIVE_FLAG; }
+			defer_flags(S1C88_FLAGS_SUB, reg_one, reg_two, result, carry, 0x80);
 		}
 	}
 
 	//Decimal Mode
 	else
 	{
+		update_flags();
+
 		//Convert registers into BCD format - Unpacked
 		if(reg.sc & UNPACK_FLAG)
 		{
@@ -626,30 +598,11 @@ u8 S1C88::sbc_u8(u8 reg_one, u8 reg_two)
 /****** Subtracts 2 16-bit registers - Carry ******/
 u16 S1C88::sbc_u16(u16 reg_one, u16 reg_two)
 {
-	u8 carry = (reg.sc & 0x2) ? 1 : 0;
-	u16 result;
-
-	s32 o_flag;
-
-	result = reg_one - reg_two - carry;
-	o_flag = comp16(reg_one) - comp16(reg_two) - carry;
-
-	//Zero flag
-	if(!result) { reg.sc |= ZERO_FLAG; }
-	else { reg.sc &= ~ZERO_FLAG; }
-
-	//Carry flag
-	if((reg_two + carry) > reg_one) { reg.sc |= CARRY_FLAG; }
-	else { reg.sc &= ~CARRY_FLAG; }
+	update_flags();
 
-	//Overflow flag
-	if(o_flag > MAX_16) { reg.sc |= OVERFLOW_FLAG; }
-	else if(o_flag < MIN_16) { reg.sc |= OVERFLOW_FLAG; }
-	else { reg.sc &= ~OVERFLOW_FLAG; }
-
-	//Negative flag
-	if(result & 0x8000) { reg.sc |= NEGATIVE_FLAG; }
-	else { reg.sc &= ~NEGATIVE_FLAG; }
+	u8 carry = (reg.sc & 0x2) ? 1 : 0;
+	u16 result = reg_one - reg_two - carry;
+	defer_flags(S1C88_FLAGS_SUB, reg_one, reg_two, result, carry, 0x8000);
 
 	return result;
 }
@@ -657,66 +610,25 @@ u16 S1C88::sbc_u16(u16 reg_one, u16 reg_two)
 /****** Compares 2 8-bit registers ******/
 void S1C88::cp_u8(u8 reg_one, u8 reg_two)
 {
-	u8 result;
-
-	s16 o_flag;
-
-	result = reg_one - reg_two;
-	o_flag = comp8(reg_one) - comp8(reg_two);
-
-	//Zero flag
-	if(!result) { reg.sc |= ZERO_FLAG; }
-	else { reg.sc &= ~ZERO_FLAG; }
-
-	//Carry flag
-	if(reg_two > reg_one) { reg.sc |= CARRY_FLAG; }
-	else { reg.sc &= ~CARRY_FLAG; }
-
-	//Overflow flag
-	if(o_flag > MAX_8) { reg.sc |= OVERFLOW_FLAG; }
-	else if(o_flag < MIN_8) { reg.sc |= OVERFLOW_FLAG; }
-	else { reg.sc &= ~OVERFLOW_FLAG; }
-
-	//Negative flag
-	if(result & 0x80) { reg.sc |= NEGATIVE_FLAG; }
-	else { reg.sc &= ~NEGATIVE_FLAG; }
+	u8 result = reg_one - reg_two;
+	defer_flags(S1C88_FLAGS_SUB, reg_one, reg_two, result, 0, 0x80);
 }
 
 /****** Compares 2 16-bit registers ******/
 void S1C88::cp_u16(u16 reg_one, u16 reg_two)
 {
-	u16 result;
-	s32 o_flag;
-
-	result = reg_one - reg_two;
-	o_flag = comp16(reg_one) - comp16(reg_two);
-
-	//Zero flag
-	if(!result) { reg.sc |= ZERO_FLAG; }
-	else { reg.sc &= ~ZERO_FLAG; }
-
-	//Carry flag
-	if(reg_two > reg_one) { reg.sc |= CARRY_FLAG; }
-	else { reg.sc &= ~CARRY_FLAG; }
-
-	//Overflow flag
-	if(o_flag > MAX_16) { reg.sc |= OVERFLOW_FLAG; }
-	else if(o_flag < MIN_16) { reg.sc |= OVERFLOW_FLAG; }
-	else { reg.sc &= ~OVERFLOW_FLAG; }
-
-	//Negative flag
-	if(result & 0x8000) { reg.sc |= NEGATIVE_FLAG; }
-	else { reg.sc &= ~NEGATIVE_FLAG; }
+	u16 result = reg_one - reg_two;
+	defer_flags(S1C88_FLAGS_SUB, reg_one, reg_two, result, 0, 0x8000);
 }
 
 /****** Increments an 8-bit register ******/
 u8 S1C88::inc_u8(u8 reg_one)
 {
-	reg_one++;
+	//Only Zero is changed, so the other flags have to come from the last operation
+	update_flags();
 
-	//Zero flag
-	if(!reg_one) { reg.sc |= ZERO_FLAG; }
-	else { reg.sc &= ~ZERO_FLAG; }
+	reg_one++;
+	defer_flags(S1C88_FLAGS_ZERO, 0, 0, reg_one, 0, 0);
 
 	return reg_one;
 }
@@ -724,11 +636,11 @@ u8 S1C88::inc_u8(u8 reg_one)
 /****** Increments a 16-bit register ******/
 u16 S1C88::inc_u16(u16 reg_one)
 {
-	reg_one++;
+	//Only Zero is changed, so the other flags have to come from the last operation
+	update_flags();
 
-	//Zero flag
-	if(!reg_one) { reg.sc |= ZERO_FLAG; }
-	else { reg.sc &= ~ZERO_FLAG; }
+	reg_one++;
+	defer_flags(S1C88_FLAGS_ZERO, 0, 0, reg_one, 0, 0);
 
 	return reg_one;
 }
@@ -736,11 +648,11 @@ u16 S1C88::inc_u16(u16 reg_one)
 /****** Decrements an 8-bit register ******/
 u8 S1C88::dec_u8(u8 reg_one)
 {
-	reg_one--;
+	//Only Zero is changed, so the other flags have to come from the last operation
+	update_flags();
 
-	//Zero flag
-	if(!reg_one) { reg.sc |= ZERO_FLAG; }
-	else { reg.sc &= ~ZERO_FLAG; }
+	reg_one--;
+	defer_flags(S1C88_FLAGS_ZERO, 0, 0, reg_one, 0, 0);
 
 	return reg_one;
 }
@@ -748,11 +660,11 @@ u8 S1C88::dec_u8(u8 reg_one)
 /****** Decrements a 16-bit register ******/
 u16 S1C88::dec_u16(u16 reg_one)
 {
-	reg_one--;
+	//Only Zero is changed, so the other flags have to come from the last operation
+	update_flags();
 
-	//Zero flag
-	if(!reg_one) { reg.sc |= ZERO_FLAG; }
-	else { reg.sc &= ~ZERO_FLAG; }
+	reg_one--;
+	defer_flags(S1C88_FLAGS_ZERO, 0, 0, reg_one, 0, 0);
 
 	return reg_one;
 }
@@ -760,6 +672,8 @@ u16 S1C88::dec_u16(u16 reg_one)
 /****** Negates an 8-bit register ******/
 u8 S1C88::neg_u8(u8 reg_one)
 {
+	update_flags();
+
 	u8 result;
 
 	s16 o_flag;
@@ -860,6 +774,8 @@ u8 S1C88::neg_u8(u8 reg_one)
 /****** Multiplies 2 8-bit registers ******/
 u16 S1C88::mlt_u8(u8 reg_one, u8 reg_two)
 {
+	update_flags();
+
 	u16 result = reg_one * reg_two;
 
 	//Zero flag
@@ -880,6 +796,8 @@ u16 S1C88::mlt_u8(u8 reg_one, u8 reg_two)
 /****** Divides a 16-bit register by an 8-bit register ******/
 u16 S1C88::div_u16(u16 reg_one, u8 reg_two)
 {
+	update_flags();
+
 	u16 result = 0;
 
 	//When dividing by zero, throw exception - TODO
@@ -916,29 +834,21 @@ u16 S1C88::div_u16(u16 reg_one, u8 reg_two)
 /****** Performs a bit test on 2 8-bit registers ******/
 void S1C88::bit_u8(u8 reg_one, u8 reg_two)
 {
-	u8 result = reg_one & reg_two;
-
-	//Zero flag
-	if(!result) { reg.sc |= ZERO_FLAG; }
-	else { reg.sc &= ~ZERO_FLAG; }
+	//Carry and Overflow are left alone, so they have to come from the last operation
+	update_flags();
 
-	//Negative flag
-	if(result & 0x80) { reg.sc |= NEGATIVE_FLAG; }
-	else { reg.sc &= ~NEGATIVE_FLAG; }
+	u8 result = reg_one & reg_two;
+	defer_flags(S1C88_FLAGS_LOGICAL, 0, 0, result, 0, 0x80);
 }
 
 /****** Logical AND 2 8-bit registers ******/
 u8 S1C88::and_u8(u8 reg_one, u8 reg_two)
 {
-	u8 result = reg_one & reg_two;
-
-	//Zero flag
-	if(!result) { reg.sc |= ZERO_FLAG; }
-	else { reg.sc &= ~ZERO_FLAG; }
+	//Carry and Overflow are left alone, so they have to come from the last operation
+	update_flags();
 
-	//Negative flag
-	if(result & 0x80) { reg.sc |= NEGATIVE_FLAG; }
-	else { reg.sc &= ~NEGATIVE_FLAG; }
+	u8 result = reg_one & reg_two;
+	defer_flags(S1C88_FLAGS_LOGICAL, 0, 0, result, 0, 0x80);
 
 	return result;
 }
@@ -946,15 +856,11 @@ u8 S1C88::and_u8(u8 reg_one, u8 reg_two)
 /****** Logical OR 2 8-bit registers ******/
 u8 S1C88::or_u8(u8 reg_one, u8 reg_two)
 {
-	u8 result = reg_one | reg_two;
-
-	//Zero flag
-	if(!result) { reg.sc |= ZERO_FLAG; }
-	else { reg.sc &= ~ZERO_FLAG; }
+	//Carry and Overflow are left alone, so they have to come from the last operation
+	update_flags();
 
-	//Negative flag
-	if(result & 0x80) { reg.sc |= NEGATIVE_FLAG; }
-	else { reg.sc &= ~NEGATIVE_FLAG; }
+	u8 result = reg_one | reg_two;
+	defer_flags(S1C88_FLAGS_LOGICAL, 0, 0, result, 0, 0x80);
 
 	return result;
 }
@@ -962,15 +868,11 @@ u8 S1C88::or_u8(u8 reg_one, u8 reg_two)
 /****** Logical XOR 2 8-bit registers ******/
 u8 S1C88::xor_u8(u8 reg_one, u8 reg_two)
 {
-	u8 result = reg_one ^ reg_two;
-
-	//Zero flag
-	if(!result) { reg.sc |= ZERO_FLAG; }
-	else { reg.sc &= ~ZERO_FLAG; }
+	//Carry and Overflow are left alone, so they have to come from the last operation
+	update_flags();
 
-	//Negative flag
-	if(result & 0x80) { reg.sc |= NEGATIVE_FLAG; }
-	else { reg.sc &= ~NEGATIVE_FLAG; }
+	u8 result = reg_one ^ reg_two;
+	defer_flags(S1C88_FLAGS_LOGICAL, 0, 0, result, 0, 0x80);
 
 	return result;
 }
@@ -978,15 +880,11 @@ u8 S1C88::xor_u8(u8 reg_one, u8 reg_two)
 /****** Logical NOT an 8-bit registers ******/
 u8 S1C88::cpl_u8(u8 reg_one)
 {
-	u8 result = ~reg_one;
-
-	//Zero flag
-	if(!result) { reg.sc |= ZERO_FLAG; }
-	else { reg.sc &= ~ZERO_FLAG; }
+	//Carry and Overflow are left alone, so they have to come from the last operation
+	update_flags();
 
-	//Negative flag
-	if(result & 0x80) { reg.sc |= NEGATIVE_FLAG; }
-	else { reg.sc &= ~NEGATIVE_FLAG; }
+	u8 result = ~reg_one;
+	defer_flags(S1C88_FLAGS_LOGICAL, 0, 0, result, 0, 0x80);
 
 	return result;
 }
@@ -994,6 +892,8 @@ u8 S1C88::cpl_u8(u8 reg_one)
 /****** Shift Left Logical ******/
 u8 S1C88::sll_u8(u8 reg_one)
 {
+	update_flags();
+
 	u8 result = reg_one << 1;
 
 	//Zero flag
@@ -1014,6 +914,8 @@ u8 S1C88::sll_u8(u8 reg_one)
 /****** Shift Left Arithmetic ******/
 u8 S1C88::sla_u8(u8 reg_one)
 {
+	update_flags();
+
 	u8 result = reg_one << 1;
 	u16 o_flag = reg_one << 1;
 
@@ -1039,6 +941,8 @@ u8 S1C88::sla_u8(u8 reg_one)
 /****** Shift Right Logical ******/
 u8 S1C88::srl_u8(u8 reg_one)
 {
+	update_flags();
+
 	u8 result = reg_one >> 1;
 
 	//Zero flag
@@ -1058,6 +962,8 @@ u8 S1C88::srl_u8(u8 reg_one)
 /****** Shift Right Arithmetic ******/
 u8 S1C88::sra_u8(u8 reg_one)
 {
+	update_flags();
+
 	u8 result = reg_one >> 1;
 	if(reg_one & 0x80) { result |= 0x80; }
 
@@ -1082,6 +988,8 @@ u8 S1C88::sra_u8(u8 reg_one)
 /****** Rotate Left Circular ******/
 u8 S1C88::rlc_u8(u8 reg_one)
 {
+	update_flags();
+
 	u8 result = reg_one << 1;
 	if(reg_one & 0x80) { result |= 0x1; }
 
@@ -1103,6 +1011,8 @@ u8 S1C88::rlc_u8(u8 reg_one)
 /****** Rotate Left with Carry ******/
 u8 S1C88::rl_u8(u8 reg_one)
 {
+	update_flags();
+
 	u8 result = reg_one << 1;
 	if(reg.sc & 0x2) { result |= 0x1; }
 
@@ -1124,6 +1034,8 @@ u8 S1C88::rl_u8(u8 reg_one)
 /****** Rotate Right Circular ******/
 u8 S1C88::rrc_u8(u8 reg_one)
 {
+	update_flags();
+
 	u8 result = reg_one >> 1;
 	if(reg_one & 0x1) { result |= 0x80; }
 
@@ -1145,6 +1057,8 @@ u8 S1C88::rrc_u8(u8 reg_one)
 /****** Rotate Right with Carry ******/
 u8 S1C88::rr_u8(u8 reg_one)
 {
+	update_flags();
+
 	u8 result = reg_one >> 1;
 	if(reg.sc & 0x2) { result |= 0x80; }
 
@@ -2278,7 +2192,8 @@ void S1C88::execute()
 
 		//AND SC, #nn
 		case 0x9C:
-			reg.sc = and_u8(reg.sc, mem->read_u8(reg.pc_ex++));
+			update_flags();
+			reg.sc &= mem->read_u8(reg.pc_ex++);
 			system_cycles = 12;
 			skip_irq = true;
 
@@ -2287,7 +2202,8 @@ void S1C88::execute()
 
 		//OR SC, #nn
 		case 0x9D:
-			reg.sc = or_u8(reg.sc, mem->read_u8(reg.pc_ex++));
+			update_flags();
+			reg.sc |= mem->read_u8(reg.pc_ex++);
 			system_cycles = 12;
 			skip_irq = true;
 
@@ -2296,7 +2212,8 @@ void S1C88::execute()
 
 		//XOR SC, #nn
 		case 0x9E:
-			reg.sc = xor_u8(reg.sc, mem->read_u8(reg.pc_ex++));
+			update_flags();
+			reg.sc ^= mem->read_u8(reg.pc_ex++);
 			system_cycles = 12;
 			skip_irq = true;
 
@@ -2306,6 +2223,7 @@ void S1C88::execute()
 		//LD SC, #nn
 		case 0x9F:
 			reg.sc = mem->read_u8(reg.pc_ex++);
+			flag_op = S1C88_FLAGS_NONE;
 			system_cycles = 12;
 			skip_irq = true;
 
@@ -2361,6 +2279,7 @@ void S1C88::execute()
 
 		//PUSH SC
 		case 0xA7:
+			update_flags();
 			mem->write_u8(--reg.sp, reg.sc);
 			system_cycles = 12;
 			break;
@@ -2415,6 +2334,7 @@ void S1C88::execute()
 		//POP SC
 		case 0xAF:
 			reg.sc = mem->read_u8(reg.sp++);
+			flag_op = S1C88_FLAGS_NONE;
 			system_cycles = 8;
 			skip_irq = true;
 			break;
@@ -3898,6 +3818,7 @@ void S1C88::execute()
 
 				//LD A, SC
 				case 0xC1:
+					update_flags();
 					reg.a = reg.sc;
 					system_cycles = 8;
 					break;
@@ -3911,6 +3832,7 @@ void S1C88::execute()
 				//LD SC, A
 				case 0xC3:
 					reg.sc = reg.a;
+					flag_op = S1C88_FLAGS_NONE;
 					system_cycles = 12;
 					skip_irq = true;
 					break;
@@ -4087,6 +4009,7 @@ void S1C88::execute()
 						s_temp = mem->read_s8(reg.pc_ex++);
 						reg.pc++;
 
+						update_flags();
 						u8 flag_1 = (reg.sc & OVERFLOW_FLAG) ? 1 : 0;
 						u8 flag_2 = (reg.sc & NEGATIVE_FLAG) ? 1 : 0;
 
@@ -4107,6 +4030,7 @@ void S1C88::execute()
 						s_temp = mem->read_s8(reg.pc_ex++);
 						reg.pc++;
 
+						update_flags();
 						u8 flag_1 = (reg.sc & OVERFLOW_FLAG) ? 1 : 0;
 						u8 flag_2 = (reg.sc & NEGATIVE_FLAG) ? 1 : 0;
 						u8 flag_3 = (reg.sc & ZERO_FLAG) ? 1 : 0;
@@ -4128,6 +4052,7 @@ void S1C88::execute()
 						s_temp = mem->read_s8(reg.pc_ex++);
 						reg.pc++;
 
+						update_flags();
 						u8 flag_1 = (reg.sc & OVERFLOW_FLAG) ? 1 : 0;
 						u8 flag_2 = (reg.sc & NEGATIVE_FLAG) ? 1 : 0;
 						u8 flag_3 = (reg.sc & ZERO_FLAG) ? 1 : 0;
@@ -4149,6 +4074,7 @@ void S1C88::execute()
 						s_temp = mem->read_s8(reg.pc_ex++);
 						reg.pc++;
 
+						update_flags();
 						u8 flag_1 = (reg.sc & OVERFLOW_FLAG) ? 1 : 0;
 						u8 flag_2 = (reg.sc & NEGATIVE_FLAG) ? 1 : 0;
 
@@ -4168,6 +4094,7 @@ void S1C88::execute()
 					s_temp = mem->read_s8(reg.pc_ex++);
 					reg.pc++;
 
+					update_flags();
 					if(reg.sc & OVERFLOW_FLAG)
 					{
 						reg.cb = reg.nb;
@@ -4183,6 +4110,7 @@ void S1C88::execute()
 					s_temp = mem->read_s8(reg.pc_ex++);
 					reg.pc++;
 
+					update_flags();
 					if((reg.sc & OVERFLOW_FLAG) == 0)
 					{
 						reg.cb = reg.nb;
@@ -4198,6 +4126,7 @@ void S1C88::execute()
 					s_temp = mem->read_s8(reg.pc_ex++);
 					reg.pc++;
 
+					update_flags();
 					if((reg.sc & NEGATIVE_FLAG) == 0)
 					{
 						reg.cb = reg.nb;
@@ -4213,6 +4142,7 @@ void S1C88::execute()
 					s_temp = mem->read_s8(reg.pc_ex++);
 					reg.pc++;
 
+					update_flags();
 					if(reg.sc & NEGATIVE_FLAG)
 					{
 						reg.cb = reg.nb;
@@ -4229,6 +4159,7 @@ void S1C88::execute()
 						s_temp = mem->read_s8(reg.pc_ex++);
 						reg.pc++;
 
+						update_flags();
 						u8 flag_1 = (reg.sc & OVERFLOW_FLAG) ? 1 : 0;
 						u8 flag_2 = (reg.sc & NEGATIVE_FLAG) ? 1 : 0;
 
@@ -4255,6 +4186,7 @@ void S1C88::execute()
 						s_temp = mem->read_s8(reg.pc_ex++);
 						reg.pc++;
 
+						update_flags();
 						u8 flag_1 = (reg.sc & OVERFLOW_FLAG) ? 1 : 0;
 						u8 flag_2 = (reg.sc & NEGATIVE_FLAG) ? 1 : 0;
 						u8 flag_3 = (reg.sc & ZERO_FLAG) ? 1 : 0;
@@ -4282,6 +4214,7 @@ void S1C88::execute()
 						s_temp = mem->read_s8(reg.pc_ex++);
 						reg.pc++;
 
+						update_flags();
 						u8 flag_1 = (reg.sc & OVERFLOW_FLAG) ? 1 : 0;
 						u8 flag_2 = (reg.sc & NEGATIVE_FLAG) ? 1 : 0;
 						u8 flag_3 = (reg.sc & ZERO_FLAG) ? 1 : 0;
@@ -4309,6 +4242,7 @@ void S1C88::execute()
 						s_temp = mem->read_s8(reg.pc_ex++);
 						reg.pc++;
 
+						update_flags();
 						u8 flag_1 = (reg.sc & OVERFLOW_FLAG) ? 1 : 0;
 						u8 flag_2 = (reg.sc & NEGATIVE_FLAG) ? 1 : 0;
 
@@ -4334,6 +4268,7 @@ void S1C88::execute()
 					s_temp = mem->read_s8(reg.pc_ex++);
 					reg.pc++;
 
+					update_flags();
 					if(reg.sc & OVERFLOW_FLAG)
 					{
 						mem->write_u8(--reg.sp, (reg.cb));
@@ -4355,6 +4290,7 @@ void S1C88::execute()
 					s_temp = mem->read_s8(reg.pc_ex++);
 					reg.pc++;
 
+					update_flags();
 					if((reg.sc & OVERFLOW_FLAG) == 0)
 					{
 						mem->write_u8(--reg.sp, (reg.cb));
@@ -4376,6 +4312,7 @@ void S1C88::execute()
 					s_temp = mem->read_s8(reg.pc_ex++);
 					reg.pc++;
 
+					update_flags();
 					if((reg.sc & NEGATIVE_FLAG) == 0)
 					{
 						mem->write_u8(--reg.sp, (reg.cb));
@@ -4397,6 +4334,7 @@ void S1C88::execute()
 					s_temp = mem->read_s8(reg.pc_ex++);
 					reg.pc++;
 
+					update_flags();
 					if(reg.sc & NEGATIVE_FLAG)
 					{
 						mem->write_u8(--reg.sp, (reg.cb));
@@ -5470,6 +5408,7 @@ void S1C88::execute()
 			s_temp = mem->read_s8(reg.pc_ex++);
 			reg.pc++;
 
+			update_flags();
 			if(reg.sc & CARRY_FLAG)
 			{
 				mem->write_u8(--reg.sp, reg.cb);
@@ -5491,6 +5430,7 @@ void S1C88::execute()
 			s_temp = mem->read_s8(reg.pc_ex++);
 			reg.pc++;
 
+			update_flags();
 			if((reg.sc & CARRY_FLAG) == 0)
 			{
 				mem->write_u8(--reg.sp, reg.cb);
@@ -5512,6 +5452,7 @@ void S1C88::execute()
 			s_temp = mem->read_s8(reg.pc_ex++);
 			reg.pc++;
 
+			update_flags();
 			if(reg.sc & ZERO_FLAG)
 			{
 				mem->write_u8(--reg.sp, reg.cb);
@@ -5533,6 +5474,7 @@ void S1C88::execute()
 			s_temp = mem->read_s8(reg.pc_ex++);
 			reg.pc++;
 
+			update_flags();
 			if((reg.sc & ZERO_FLAG) == 0)
 			{
 				mem->write_u8(--reg.sp, reg.cb);
@@ -5554,6 +5496,7 @@ void S1C88::execute()
 			s_temp = mem->read_s8(reg.pc_ex++);
 			reg.pc++;
 
+			update_flags();
 			if(reg.sc & CARRY_FLAG)
 			{
 				reg.cb = reg.nb;
@@ -5569,6 +5512,7 @@ void S1C88::execute()
 			s_temp = mem->read_s8(reg.pc_ex++);
 			reg.pc++;
 
+			update_flags();
 			if((reg.sc & CARRY_FLAG) == 0)
 			{
 				reg.cb = reg.nb;
@@ -5584,6 +5528,7 @@ void S1C88::execute()
 			s_temp = mem->read_s8(reg.pc_ex++);
 			reg.pc++;
 
+			update_flags();
 			if(reg.sc & ZERO_FLAG)
 			{
 				reg.cb = reg.nb;
@@ -5599,6 +5544,7 @@ void S1C88::execute()
 			s_temp = mem->read_s8(reg.pc_ex++);
 			reg.pc++;
 
+			update_flags();
 			if((reg.sc & ZERO_FLAG) == 0)
 			{
 				reg.cb = reg.nb;
@@ -5614,6 +5560,7 @@ void S1C88::execute()
 			s_temp = mem->read_s16(reg.pc_ex);
 			reg.pc += 2;
 
+			update_flags();
 			if(reg.sc & CARRY_FLAG)
 			{
 				mem->write_u8(--reg.sp, reg.cb);
@@ -5635,6 +5582,7 @@ void S1C88::execute()
 			s_temp = mem->read_s16(reg.pc_ex);
 			reg.pc += 2;
 
+			update_flags();
 			if((reg.sc & CARRY_FLAG) == 0)
 			{
 				mem->write_u8(--reg.sp, reg.cb);
@@ -5656,6 +5604,7 @@ void S1C88::execute()
 			s_temp = mem->read_s16(reg.pc_ex);
 			reg.pc += 2;
 
+			update_flags();
 			if(reg.sc & ZERO_FLAG)
 			{
 				mem->write_u8(--reg.sp, reg.cb);
@@ -5677,6 +5626,7 @@ void S1C88::execute()
 			s_temp = mem->read_s16(reg.pc_ex);
 			reg.pc += 2;
 
+			update_flags();
 			if((reg.sc & ZERO_FLAG) == 0)
 			{
 				mem->write_u8(--reg.sp, reg.cb);
@@ -5698,6 +5648,7 @@ void S1C88::execute()
 			s_temp = mem->read_s16(reg.pc_ex);
 			reg.pc += 2;
 
+			update_flags();
 			if(reg.sc & CARRY_FLAG)
 			{
 				reg.cb = reg.nb;
@@ -5713,6 +5664,7 @@ void S1C88::execute()
 			s_temp = mem->read_s16(reg.pc_ex);
 			reg.pc += 2;
 
+			update_flags();
 			if((reg.sc & CARRY_FLAG) == 0)
 			{
 				reg.cb = reg.nb;
@@ -5728,6 +5680,7 @@ void S1C88::execute()
 			s_temp = mem->read_s16(reg.pc_ex);
 			reg.pc += 2;
 
+			update_flags();
 			if(reg.sc & ZERO_FLAG)
 			{
 				reg.cb = reg.nb;
@@ -5743,6 +5696,7 @@ void S1C88::execute()
 			s_temp = mem->read_s16(reg.pc_ex);
 			reg.pc += 2;
 
+			update_flags();
 			if((reg.sc & ZERO_FLAG) == 0)
 			{
 				reg.cb = reg.nb;
@@ -5812,6 +5766,7 @@ void S1C88::execute()
 			reg.pc++;
 			reg.b = dec_u8(reg.b);
 
+			update_flags();
 			if((reg.sc & ZERO_FLAG) == 0)
 			{
 				reg.cb = reg.nb;
@@ -5850,6 +5805,7 @@ void S1C88::execute()
 		//RETE
 		case 0xF9:
 			reg.sc = mem->read_u8(reg.sp);
+			flag_op = S1C88_FLAGS_NONE;
 			reg.pc = mem->read_u16(reg.sp + 1);
 			reg.cb = mem->read_u8(reg.sp + 3);
 			reg.sp += 4;
@@ -5887,6 +5843,7 @@ void S1C88::execute()
 			mem->write_u8(--reg.sp, reg.cb);
 			mem->write_u8(--reg.sp, (reg.pc >> 8));
 			mem->write_u8(--reg.sp, (reg.pc & 0xFF));
+			update_flags();
 			mem->write_u8(--reg.sp, reg.sc);
 			reg.cb = reg.nb;
 			reg.pc = mem->read_u16(temp_val);
@@ -5939,6 +5896,7 @@ void S1C88::handle_interrupt()
 					mem->write_u8(--reg.sp, reg.cb);
 					mem->write_u8(--reg.sp, (reg.pc >> 8));
 					mem->write_u8(--reg.sp, (reg.pc & 0xFF));
+					update_flags();
 					mem->write_u8(--reg.sp, reg.sc);
 
 					reg.cb = 0;
@@ -6289,6 +6247,7 @@ bool S1C88::cpu_read(u32 offset, std::string filename)
 
 	//Serialize CPU registers data from file stream
 	file.read((char*)&reg, sizeof(reg));
+	flag_op = S1C88_FLAGS_NONE;
 
 	//Serialize misc CPU data from file stream
 	file.read((char*)&opcode, sizeof(opcode));
@@ -6317,6 +6276,9 @@ bool S1C88::cpu_write(std::string filename)
 	
 	if(!file.is_open()) { return false; }
 
+	//Flags are saved as part of SC
+	update_flags();
+
 	//Serialize CPU registers data to save state
 	file.write((char*)&reg, sizeof(reg));
 
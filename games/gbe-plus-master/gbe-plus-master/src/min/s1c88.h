@@ -20,6 +20,13 @@
 #include "timer.h"
 #include "apu.h"
 
+//Kinds of ALU operations waiting to be applied to the SC register
+const u8 S1C88_FLAGS_NONE = 0;
+const u8 S1C88_FLAGS_ADD = 1;
+const u8 S1C88_FLAGS_SUB = 2;
+const u8 S1C88_FLAGS_LOGICAL = 3;
+const u8 S1C88_FLAGS_ZERO = 4;
+
 class S1C88
 {
 	public:
@@ -86,6 +93,14 @@ class S1C88
 
 	u32 debug_opcode;
 
+	//Last flag-setting ALU operation - Z, C, V, and N in SC are stale until update_flags() applies it
+	u8 flag_op;
+	u32 flag_input;
+	u32 flag_operand;
+	u32 flag_result;
+	u8 flag_carry;
+	u32 flag_msb;
+
 	//Memory management unit
 	MIN_MMU* mem;
 
@@ -110,6 +125,10 @@ class S1C88
 	void handle_interrupt();
 	void clock_system();
 
+	void defer_flags(u8 op, u32 input, u32 operand, u32 result, u8 carry, u32 msb);
+	void update_flags();
+	u8 get_sc() const;
+
 	u8 add_u8(u8 reg_one, u8 reg_two);
 	u16 add_u16(u16 reg_one, u16 reg_two);
 
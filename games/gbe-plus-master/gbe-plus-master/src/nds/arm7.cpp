@@ -10,6 +10,12 @@
 
 #include "arm7.h"
 
+//Instruction lookup tables
+const std::array<NTR_ARM7::arm_instructions, 4096> NTR_ARM7::arm_decode_table = make_arm_decode_table();
+const std::array<NTR_ARM7::arm_handler_func, 4096> NTR_ARM7::arm_handler_table = make_arm_handler_table(std::make_index_sequence<4096>());
+const std::array<NTR_ARM7::arm_instructions, 1024> NTR_ARM7::thumb_decode_table = make_thumb_decode_table();
+const std::array<NTR_ARM7::thumb_handler_func, 1024> NTR_ARM7::thumb_handler_table = make_thumb_handler_table(std::make_index_sequence<1024>());
+
 /****** CPU Constructor ******/
 NTR_ARM7::NTR_ARM7()
 {
@@ -61,6 +67,16 @@ void NTR_ARM7::reset()
 	idle_state = 0;
 	last_idle_state = 0;
 
+	idle_loop_skip = config::nds_idle_loop_skip;
+	idle_loop_addr = 0xFFFFFFFF;
+	idle_loop_length = 0;
+	idle_flush_count = 0;
+	idle_loop_flush_count = 0;
+	flag_op = LAZY_FLAGS_NONE;
+
+	for(u32 x = 0; x < 16; x++) { idle_regs[x] = 0; }
+	for(u32 x = 0; x < IDLE_LOOP_MAX_OPS; x++) { idle_poll_values[x] = 0; }
+
 	thumb_long_branch = false;
 	last_instr_branch = false;
 	swi_waitbyloop_count = 0;
@@ -95,6 +111,7 @@ void NTR_ARM7::reset()
 
 	flush_pipeline();
 	mem = NULL;
+	scheduler = NULL;
 
 	std::cout<<"CPU::ARM7 - Initialized\n";
 }
@@ -481,9 +498,6 @@ void NTR_ARM7::fetch()
 
 		//Set the operation to perform as UNDEFINED until decoded
 		instruction_operation[pipeline_pointer] = UNDEFINED;
-
-		//Clock CPU when retrieving opcodes - Account for sequential and non-sequential access
-		system_cycles += (instruction_operation[0] == PIPELINE_FILL) ? cpu_timing[reg.r15 >> 24][CODE_N16] : cpu_timing[reg.r15 >> 24][CODE_S16];
 	}
 
 	//Fetch ARM instructions
@@ -494,12 +508,15 @@ void NTR_ARM7::fetch()
 
 		//Set the operation to perform as UNDEFINED until decoded
 		instruction_operation[pipeline_pointer] = UNDEFINED;
-
-		//Clock CPU when retrieving opcodes - Account for sequential and non-sequential access
-		system_cycles += (instruction_operation[0] == PIPELINE_FILL) ? cpu_timing[reg.r15 >> 24][CODE_N32] : cpu_timing[reg.r15 >> 24][CODE_S32];
 	}
 }
 
+/****** Reads an ARM or THUMB opcode from memory without touching the pipeline ******/
+u32 NTR_ARM7::read_opcode(u32 addr)
+{
+	return (arm_mode == THUMB) ? mem->read_u16(addr) : mem->read_u32(addr);
+}
+
 /****** Decode ARM instruction ******/
 void NTR_ARM7::decode()
 {
@@ -510,261 +527,13 @@ void NTR_ARM7::decode()
 	//Decode THUMB instructions
 	if(arm_mode == THUMB)
 	{
-		u16 current_instruction = instruction_pipeline[pipeline_id];
-		
-		if(((current_instruction >> 13) == 0) && (((current_instruction >> 11) & 0x7) != 0x3))
-		{
-			//THUMB_1
-			instruction_operation[pipeline_id] = THUMB_1;
-		}
-
-		else if(((current_instruction >> 11) & 0x1F) == 0x3)
-		{
-			//THUMB_2
-			instruction_operation[pipeline_id] = THUMB_2;
-		}
-
-		else if((current_instruction >> 13) == 0x1)
-		{
-			//THUMB_3
-			instruction_operation[pipeline_id] = THUMB_3;
-		}
-
-		else if(((current_instruction >> 10) & 0x3F) == 0x10)
-		{
-			//THUMB_4
-			instruction_operation[pipeline_id] = THUMB_4;
-		}
-
-		else if(((current_instruction >> 10) & 0x3F) == 0x11)
-		{
-			//THUMB_5
-			instruction_operation[pipeline_id] = THUMB_5;
-		}
-
-		else if((current_instruction >> 11) == 0x9)
-		{
-			//THUMB_6
-			instruction_operation[pipeline_id] = THUMB_6;
-		}
-
-		else if((current_instruction >> 12) == 0x5)
-		{
-			if(current_instruction & 0x200)
-			{
-				//THUMB_8
-				instruction_operation[pipeline_id] = THUMB_8;
-			}
-
-			else
-			{
-				//THUMB_7
-				instruction_operation[pipeline_id] = THUMB_7;
-			}
-		}
-
-		else if(((current_instruction >> 13) & 0x7) == 0x3)
-		{
-			//THUMB_9
-			instruction_operation[pipeline_id] = THUMB_9;
-		}
-
-		else if((current_instruction >> 12) == 0x8)
-		{
-			//THUMB_10
-			instruction_operation[pipeline_id] = THUMB_10;
-		}
-
-		else if((current_instruction >> 12) == 0x9)
-		{
-			//THUMB_11
-			instruction_operation[pipeline_id] = THUMB_11;
-		}
-
-		else if((current_instruction >> 12) == 0xA)
-		{
-			//THUMB_12
-			instruction_operation[pipeline_id] = THUMB_12;
-		}
-
-		else if((current_instruction >> 8) == 0xB0)
-		{
-			//THUMB_13
-			instruction_operation[pipeline_id] = THUMB_13;
-		}
-
-		else if((current_instruction >> 12) == 0xB)
-		{
-			//THUMB_14
-			instruction_operation[pipeline_id] = THUMB_14;
-		}
-
-		else if((current_instruction >> 12) == 0xC)
-		{
-			//THUMB_15
-			instruction_operation[pipeline_id] = THUMB_15;
-		}
-
-		else if((current_instruction >> 12) == 13)
-		{
-			//THUMB_16
-			instruction_operation[pipeline_id] = THUMB_16;
-		}
-
-		else if((current_instruction >> 11) == 0x1C)
-		{
-			//THUMB_18
-			instruction_operation[pipeline_id] = THUMB_18;
-		}
-
-		else if((current_instruction >> 11) >= 0x1E)
-		{
-			//THUMB_19
-			instruction_operation[pipeline_id] = THUMB_19;
-		}
+		instruction_operation[pipeline_id] = decode_thumb(instruction_pipeline[pipeline_id]);
 	}
 
 	//Decode ARM instructions
 	if(arm_mode == ARM)
 	{
-		u32 current_instruction = instruction_pipeline[pipeline_id];
-
-		if(((current_instruction >> 8) & 0xFFFFF) == 0x12FFF)
-		{
-			//ARM_3
-			instruction_operation[pipeline_id] = ARM_3;
-		}
-
-		else if(((current_instruction >> 25) & 0x7) == 0x5)
-		{
-			//ARM_4
-			instruction_operation[pipeline_id] = ARM_4;
-		}
-
-		//TODO - Move ARM_6 decoding to final stage of ARM_5 decoding
-		//TODO - Move ARM_12 deconding to final stage of ARM_10 decoding		
-
-		else if((current_instruction & 0xD900000) == 0x1000000) 
-		{
-
-			if((current_instruction & 0x80) && (current_instruction & 0x10) && ((current_instruction & 0x2000000) == 0))
-			{
-				if(((current_instruction >> 5) & 0x3) == 0) 
-				{ 
-					instruction_operation[pipeline_id] = ARM_12;
-				}
-
-				else 
-				{
-					instruction_operation[pipeline_id] = ARM_10;
-				}
-			}
-
-			else 
-			{
-				//ARM7
-				if((current_instruction & 0x80) && ((current_instruction & 0x2000000) == 0))
-				{
-					instruction_operation[pipeline_id] = ARM_7;
-				}
-
-				//ARM_6
-				else
-				{
-					instruction_operation[pipeline_id] = ARM_6;
-				}
-			}
-		}
-
-		else if(((current_instruction >> 26) & 0x3) == 0x0)
-		{
-			if((current_instruction & 0x80) && ((current_instruction & 0x10) == 0))
-			{
-				//ARM.5
-				if(current_instruction & 0x2000000)
-				{
-					instruction_operation[pipeline_id] = ARM_5;
-				}
-
-				//ARM.5
-				else if((current_instruction & 0x100000) && (((current_instruction >> 23) & 0x3) == 0x2))
-				{
-					instruction_operation[pipeline_id] = ARM_5;
-				}
-
-				//ARM.5
-				else if(((current_instruction >> 23) & 0x3) != 0x2)
-				{
-					instruction_operation[pipeline_id] = ARM_5;
-				}
-
-				//ARM.7
-				else
-				{
-					instruction_operation[pipeline_id] = ARM_7;
-				}
-			}
-
-			else if((current_instruction & 0x80) && (current_instruction & 0x10))
-			{
-				if(((current_instruction >> 4) & 0xF) == 0x9)
-				{
-					//ARM.5
-					if(current_instruction & 0x2000000)
-					{
-						instruction_operation[pipeline_id] = ARM_5;
-					}
-
-					//ARM.12
-					else if(((current_instruction >> 23) & 0x3) == 0x2)
-					{
-						instruction_operation[pipeline_id] = ARM_12;
-					}
-
-					//ARM.7
-					else
-					{
-						instruction_operation[pipeline_id] = ARM_7;
-					}
-				}
-
-				//ARM.5
-				else if(current_instruction & 0x2000000)
-				{
-					instruction_operation[pipeline_id] = ARM_5;
-				}
-
-				//ARM.10
-				else
-				{
-					instruction_operation[pipeline_id] = ARM_10;
-				}
-			}
-
-			//ARM.5
-			else
-			{
-				instruction_operation[pipeline_id] = ARM_5;
-			}
-		}
-
-		else if(((current_instruction >> 26) & 0x3) == 0x1)
-		{
-			//ARM_9
-			instruction_operation[pipeline_id] = ARM_9;
-		}
-
-		else if(((current_instruction >> 25) & 0x7) == 0x4)
-		{
-			//ARM_11
-			instruction_operation[pipeline_id] = ARM_11;
-		}
-
-		else if(((current_instruction >> 24) & 0xF) == 0xF)
-		{
-			//ARM_13
-			instruction_operation[pipeline_id] = ARM_13;
-		}
+		instruction_operation[pipeline_id] = decode_arm(instruction_pipeline[pipeline_id]);
 	}
 }
 
@@ -802,7 +571,7 @@ void NTR_ARM7::execute()
 				break;
 
 			case THUMB_4:
-				alu_ops(instruction_pipeline[pipeline_id]);
+				(this->*thumb_handler_table[(instruction_pipeline[pipeline_id] >> 6) & 0x3FF])(instruction_pipeline[pipeline_id]);
 				debug_message = 0x3; debug_code = instruction_pipeline[pipeline_id];
 				break;
 
@@ -905,7 +674,7 @@ void NTR_ARM7::execute()
 					break;
 
 				case ARM_5:
-					data_processing(instruction_pipeline[pipeline_id]);
+					(this->*arm_handler_table[((instruction_pipeline[pipeline_id] >> 16) & 0xFF0) | ((instruction_pipeline[pipeline_id] >> 4) & 0xF)])(instruction_pipeline[pipeline_id]);
 					debug_message = 0x16; debug_code = instruction_pipeline[pipeline_id];
 					break;
 
@@ -920,7 +689,7 @@ void NTR_ARM7::execute()
 					break;
 
 				case ARM_9:
-					single_data_transfer(instruction_pipeline[pipeline_id]);
+					(this->*arm_handler_table[((instruction_pipeline[pipeline_id] >> 16) & 0xFF0) | ((instruction_pipeline[pipeline_id] >> 4) & 0xF)])(instruction_pipeline[pipeline_id]);
 					debug_message = 0x19; debug_code = instruction_pipeline[pipeline_id];
 					break;
 
@@ -971,6 +740,7 @@ void NTR_ARM7::flush_pipeline()
 	pipeline_pointer = 0;
 	instruction_pipeline[0] = instruction_pipeline[1] = instruction_pipeline[2] = 0;
 	instruction_operation[0] = instruction_operation[1] = instruction_operation[2] = PIPELINE_FILL;
+	idle_flush_count++;
 }
 
 /****** Updates the PC after each fetch-decode-execute ******/
@@ -979,329 +749,6 @@ void NTR_ARM7::update_pc()
 	reg.r15 += (arm_mode == ARM) ? 4 : 2;
 }
 
-/****** Check conditional code ******/
-bool NTR_ARM7::check_condition(u32 current_arm_instruction) const
-{
-	switch(current_arm_instruction >> 28)
-	{
-		//EQ
-		case 0x0:
-			if(reg.cpsr & CPSR_Z_FLAG) { return true; }
-			else { return false; }
-			break;
-
-		//NE
-		case 0x1:
-			if(reg.cpsr & CPSR_Z_FLAG) { return false; }
-			else { return true; }
-			break;
-
-		//CS
-		case 0x2:
-			if(reg.cpsr & CPSR_C_FLAG) { return true; }
-			else { return false; }
-			break;
-
-		//CC
-		case 0x3:
-			if(reg.cpsr & CPSR_C_FLAG) { return false; }
-			else { return true; }
-			break;
-
-		//MI
-		case 0x4:
-			if(reg.cpsr & CPSR_N_FLAG) { return true; }
-			else { return false; }
-			break;
-
-		//PL
-		case 0x5:
-			if(reg.cpsr & CPSR_N_FLAG) { return false; }
-			else { return true; }
-			break;
-
-		//VS
-		case 0x6:
-			if(reg.cpsr & CPSR_V_FLAG) { return true; }
-			else { return false; }
-			break;
-
-		//VC
-		case 0x7:
-			if(reg.cpsr & CPSR_V_FLAG) { return false; }
-			else { return true; }
-			break;
-
-		//HI
-		case 0x8:
-			if((reg.cpsr & CPSR_C_FLAG) && ((reg.cpsr & CPSR_Z_FLAG) == 0)) { return true; }
-			else { return false; }
-			break;
-
-		//LS
-		case 0x9:
-			if((reg.cpsr & CPSR_Z_FLAG) || ((reg.cpsr & CPSR_C_FLAG) == 0)) { return true; }
-			else { return false; }
-			break;
-
-		//GE
-		case 0xA:
-			{
-				u8 n = (reg.cpsr & CPSR_N_FLAG) ? 1 : 0;
-				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
-
-				if(n == v) { return true; }
-				else { return false; }
-			}
-			break;
-
-		//LT
-		case 0xB:
-			{
-				u8 n = (reg.cpsr & CPSR_N_FLAG) ? 1 : 0;
-				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
-
-				if(n != v) { return true; }
-				else { return false; }
-			}
-			break;
-
-		//GT
-		case 0xC:
-			{
-				u8 n = (reg.cpsr & CPSR_N_FLAG) ? 1 : 0;
-				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
-				u8 z = (reg.cpsr & CPSR_Z_FLAG) ? 1 : 0;
-
-				if((z == 0) && (n == v)) { return true; }
-				else { return false; }
-			}
-			break;
-
-		//LE
-		case 0xD:
-			{
-				u8 n = (reg.cpsr & CPSR_N_FLAG) ? 1 : 0;
-				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
-				u8 z = (reg.cpsr & CPSR_Z_FLAG) ? 1 : 0;
-
-				if((z == 1) || (n != v)) { return true; }
-				else { return false; }
-			}
-			break;
-
-		//AL
-		case 0xE: return true; break;
-
-		//NV
-		default: std::cout<<"CPU::ARM7::Warning: ARM instruction uses reserved conditional code NV \n"; return true;
-	}
-}
-
-/****** Updates the condition codes in the CPSR register after logical operations ******/
-void NTR_ARM7::update_condition_logical(u32 result, u8 shift_out)
-{
-	//Negative flag
-	if(result & 0x80000000) { reg.cpsr |= CPSR_N_FLAG; }
-	else { reg.cpsr &= ~CPSR_N_FLAG; }
-
-	//Zero flag
-	if(result == 0) { reg.cpsr |= CPSR_Z_FLAG; }
-	else { reg.cpsr &= ~CPSR_Z_FLAG; }
-
-	//Carry flag
-	if(shift_out == 1) { reg.cpsr |= CPSR_C_FLAG; }
-	else if(shift_out == 0) { reg.cpsr &= ~CPSR_C_FLAG; }
-}
-
-/****** Updates the condition codes in the CPSR register after arithmetic operations ******/
-void NTR_ARM7::update_condition_arithmetic(u32 input, u32 operand, u32 result, bool addition)
-{
-	//Negative flag
-	if(result & 0x80000000) { reg.cpsr |= CPSR_N_FLAG; }
-	else { reg.cpsr &= ~CPSR_N_FLAG; }
-
-	//Zero flag
-	if(result == 0) { reg.cpsr |= CPSR_Z_FLAG; }
-	else { reg.cpsr &= ~CPSR_Z_FLAG; }
-
-	//Carry flag - Addition
-	if((operand > (0xFFFFFFFF - input)) && (addition)) { reg.cpsr |= CPSR_C_FLAG; }
-
-	//Carry flag - Subtraction
-	else if((operand <= input) && (!addition)) { reg.cpsr |= CPSR_C_FLAG; }
-
-	else { reg.cpsr &= ~CPSR_C_FLAG; }
-
-	//Overflow flag
-	u8 input_msb = (input & 0x80000000) ? 1 : 0;
-	u8 operand_msb = (operand & 0x80000000) ? 1 : 0;
-	u8 result_msb = (result & 0x80000000) ? 1 : 0;
-
-	if(addition)
-	{
-		if(input_msb != operand_msb) { reg.cpsr &= ~CPSR_V_FLAG; }
-		
-		else
-		{
-			if((result_msb == input_msb) && (result_msb == operand_msb)) { reg.cpsr &= ~CPSR_V_FLAG; }
-			else { reg.cpsr |= CPSR_V_FLAG; }
-		}
-	}
-
-	else
-	{
-		if(input_msb == operand_msb) { reg.cpsr &= ~CPSR_V_FLAG; }
-		
-		else
-		{
-			if(result_msb == operand_msb) { reg.cpsr |= CPSR_V_FLAG; }
-			else { reg.cpsr &= ~CPSR_V_FLAG; }
-		}
-	}
-}
-
-/****** Performs 32-bit logical shift left - Returns Carry Out ******/
-u8 NTR_ARM7::logical_shift_left(u32& input, u8 offset)
-{
-	u8 carry_out = 0;
-
-	if(offset > 0)
-	{
-		//Test for carry
-		//Perform LSL #(n-1), if Bit 31 is 1, we know it will carry out
-		u32 carry_test = input << (offset - 1);
-		carry_out = (carry_test & 0x80000000) ? 1 : 0;
-
-		if(offset >= 32)
-		{
-			input = 0;
-			carry_out = (offset == 32) ? carry_out : 0;
-		}
-
-		else { input <<= offset; }
-	}
-
-	//LSL #0
-	//No shift performed, carry flag not affected, set it to something not 0 or 1 to check!
-	else { carry_out = 2; }
-
-	return carry_out;
-}
-
-/****** Performs 32-bit logical shift right - Returns Carry Out ******/
-u8 NTR_ARM7::logical_shift_right(u32& input, u8 offset)
-{
-	u8 carry_out = 0;
-
-	if(offset > 0)
-	{
-		//Test for carry
-		//Perform LSR #(n-1), if Bit 0 is 1, we know it will carry out
-		u32 carry_test = input >> (offset - 1);
-		carry_out = (carry_test & 0x1) ? 1 : 0;
-
-		if(offset >= 32)
-		{
-			input = 0;
-			carry_out = (offset == 32) ? carry_out : 0;
-		}
-
-		else { input >>= offset; }
-	}
-
-	//LSR #0
-	//Same as LSR #32, input becomes zero, carry flag is Bit 31 of input
-	else
-	{
-		carry_out = (input & 0x80000000) ? 1 : 0;
-		input = 0;
-	}
-
-	return carry_out;
-}
-
-/****** Performs 32-bit arithmetic shift right - Returns Carry Out ******/
-u8 NTR_ARM7::arithmetic_shift_right(u32& input, u8 offset)
-{
-	u8 carry_out = 0;
-
-	if(offset > 0)
-	{
-		u8 high_bit = (input & 0x80000000) ? 1 : 0;		
-
-		//Basically LSR, but bits become Bit 31
-		for(int x = 0; x < offset; x++)
-		{
-			carry_out = (input & 0x1) ? 1 : 0;
-			input >>= 1;
-			if(high_bit == 1) { input |= 0x80000000; }
-		}	
-	}
-
-	//ASR #0
-	//Same as ASR #32, input becomes 0xFFFFFFFF or 0x0 depending on Bit 31 of input
-	//Carry flag set to 0 or 1 depending on Bit 31 of input
-	else
-	{
-		if(input & 0x80000000) { input = 0xFFFFFFFF; carry_out = 1; }
-		else { input = 0; carry_out = 0; }
-	}
-
-	return carry_out;
-}
-
-/****** Performs 32-bit rotate right ******/
-u8 NTR_ARM7::rotate_right(u32& input, u8 offset)
-{
-	u8 carry_out = 0;
-
-	if(offset > 0)
-	{
-		//Perform ROR shift on immediate
-		for(int x = 0; x < offset; x++)
-		{
-			carry_out = input & 0x1;
-			input >>= 1;
-
-			if(carry_out) { input |= 0x80000000; }
-		}
-	}
-
-	//ROR #0
-	//Same as RRX #1, which is similar to ROR #1, except Bit 31 now becomes the old carry flag
-	else
-	{
-		u8 old_carry = (reg.cpsr & CPSR_C_FLAG) ? 1 : 0;
-		carry_out = input & 0x1;
-		input >>= 1;
-		
-		if(old_carry) { input |= 0x80000000; }
-	}
-
-	return carry_out;
-}
-
-/****** Performs 32-bit rotate right - For ARM.5 Data Processing when Bit 25 is 1 ******/
-u8 NTR_ARM7::rotate_right_special(u32& input, u8 offset)
-{
-	u8 carry_out = 2;
-
-	if(offset > 0)
-	{
-		//Perform ROR shift on immediate
-		for(int x = 0; x < (offset * 2); x++)
-		{
-			u8 carry_out = input & 0x1;
-			input >>= 1;
-
-			if(carry_out) { input |= 0x80000000; }
-		}
-	}
-
-	return carry_out;
-}			
-
 /****** Checks address before 32-bit reading/writing for special case scenarios ******/
 void NTR_ARM7::mem_check_32(u32 addr, u32& value, bool load_store)
 {
@@ -1399,11 +846,9 @@ void NTR_ARM7::clock_system()
 	//ARM7 CPU sync cycles
 	sync_cycles += system_cycles;
 
-	//Run DMA channels
-	clock_dma();
-
-	//Run timers
-	clock_timers(system_cycles);
+	//Advance the system clock, then run any controllers that have events due
+	scheduler->nds7_cycle += system_cycles;
+	if(scheduler->nds7_cycle >= scheduler->nds7_next_event) { process_events(); }
 
 	//Run RTC
 	if((mem->nds7_ie & 0x80) && (mem->nds7_rtc.int1_enable) && (mem->memory_map[NDS_RCNT+1] & 0x1))
@@ -1432,48 +877,24 @@ void NTR_ARM7::clock_dma()
 	}
 }
 
-/****** Runs timer controllers ******/
-void NTR_ARM7::clock_timers(u8 access_cycles)
+/****** Handles a timer overflowing ******/
+void NTR_ARM7::timer_overflow(u8 timer_id)
 {
-	u32 due_cycles = 0;
-	u32 update_count = 0;
-	u32 old_count = 0;
+	//Bring counter up to the point of overflow, then reload
+	mem->sync_timer(timer_id + 4);
+	controllers.timer[timer_id].counter = controllers.timer[timer_id].reload_value;
 
-	for(u32 x = 0; x < 4; x++)
+	//Increment next timer if in count-up mode, which may overflow in turn
+	if((timer_id < 3) && (controllers.timer[timer_id+1].enable) && (controllers.timer[timer_id+1].count_up))
 	{
-		//See if this timer is enabled first
-		if(controllers.timer[x].enable)
-		{
-			//If internal clock goes past 0, increment counter
-			if((controllers.timer[x].clock - access_cycles) & 0x80000000)
-			{
-				old_count = controllers.timer[x].counter;
-				due_cycles = ~(controllers.timer[x].clock - access_cycles) + 1;
-				update_count = due_cycles / controllers.timer[x].prescalar;
-				due_cycles -= (update_count * controllers.timer[x].prescalar);
-
-				if((controllers.timer[x].prescalar == 1)) { controllers.timer[x].clock = 0; }
-				else { controllers.timer[x].clock = controllers.timer[x].prescalar - due_cycles; }
-
-				if(!update_count) { update_count = 1; }
-				if(!controllers.timer[x].count_up) { controllers.timer[x].counter += update_count; }
-
-				//If counter overflows, reload value, trigger interrupt if necessary
-				if((old_count + update_count) > 0xFFFF) 
-				{
-					controllers.timer[x].counter = controllers.timer[x].reload_value;
-
-					//Increment next timer if in count-up mode
-					if((x < 4) && (controllers.timer[x+1].count_up)) { controllers.timer[x+1].counter++; }
+		controllers.timer[timer_id+1].counter++;
+		if(controllers.timer[timer_id+1].counter == 0) { timer_overflow(timer_id + 1); }
+	}
 
-					//Interrupt
-					if(controllers.timer[x].interrupt) { mem->nds7_if |= (8 << x); }
-				}
-			}
+	//Interrupt
+	if(controllers.timer[timer_id].interrupt) { mem->nds7_if |= (8 << timer_id); }
 
-			else { controllers.timer[x].clock -= access_cycles; }
-		}
-	}
+	mem->schedule_timer(timer_id + 4);
 }
 
 /****** Jumps to or exits an interrupt ******/
@@ -1496,6 +917,7 @@ void NTR_ARM7::handle_interrupt()
 		reg.r15 = get_reg(14) - 4;
 
 		//Set CPSR from SPSR, turn on IRQ flag
+		update_flags();
 		reg.cpsr = get_spsr();
 
 		//Set the CPU mode accordingly
@@ -1538,6 +960,7 @@ void NTR_ARM7::handle_interrupt()
 
 			//Set PC and SPSR
 			reg.r15 = mem->nds7_bios_vector + 0x18;
+			update_flags();
 			set_spsr(reg.cpsr);
 
 			//Request pipeline flush, signal interrupt handling, and go to ARM mode
@@ -1590,6 +1013,7 @@ bool NTR_ARM7::cpu_read(u32 offset, std::string filename)
 
 	//Serialize CPU registers data from file stream
 	file.read((char*)&reg, sizeof(reg));
+	flag_op = LAZY_FLAGS_NONE;
 
 	//Serialize misc CPU data to save state
 	file.read((char*)&current_cpu_mode, sizeof(current_cpu_mode));
@@ -1599,6 +1023,9 @@ bool NTR_ARM7::cpu_read(u32 offset, std::string filename)
 	file.read((char*)&in_interrupt, sizeof(in_interrupt));
 	file.read((char*)&idle_state, sizeof(idle_state));
 	file.read((char*)&last_idle_state, sizeof(last_idle_state));
+
+	//Polling loops are detected again after loading
+	if(idle_state == 4) { idle_state = 0; }
 	file.read((char*)&thumb_long_branch, sizeof(thumb_long_branch));
 	file.read((char*)&last_instr_branch, sizeof(last_instr_branch));
 	file.read((char*)&swi_waitbyloop_count, sizeof(swi_waitbyloop_count));
@@ -1634,6 +1061,9 @@ bool NTR_ARM7::cpu_write(std::string filename)
 	
 	if(!file.is_open()) { return false; }
 
+	//Condition codes are saved as part of the CPSR
+	update_flags();
+
 	//Serialize CPU registers data to save state
 	file.write((char*)&reg, sizeof(reg));
 
@@ -14,14 +14,25 @@
 #include <string>
 #include <iostream>
 #include <vector>
+#include <array>
 
 #include "common.h"
+#include "common/arm_interpreter.h"
 #include "timer.h"
+#include "scheduler.h"
 #include "mmu.h"
 #include "lcd.h"
 #include "apu.h"
 
-class NTR_ARM7
+//NDS7 CPU traits
+struct ntr_arm7_traits : armv4t_traits
+{
+	static constexpr const char* log_name = "CPU::ARM7";
+	static const bool idle_loop_branches = true;
+	static const bool long_branch_holds_irq = true;
+};
+
+class NTR_ARM7 : public arm_interpreter<NTR_ARM7, ntr_arm7_traits>
 {
 	public:
 
@@ -93,18 +104,15 @@ class NTR_ARM7
 		BIOS_SWI_FINISH
 	};
 
-	//Memory access enumerations
-	enum mem_modes
-	{
-		CODE_N16,
-		CODE_N32,
-		CODE_S16,
-		CODE_S32,
-		DATA_N16,
-		DATA_N32,
-		DATA_S16,
-		DATA_S32
-	};
+	typedef void (NTR_ARM7::*arm_handler_func)(u32);
+	typedef void (NTR_ARM7::*thumb_handler_func)(u16);
+
+	//Instruction lookup tables - ARM is indexed by Bits 20-27 and 4-7, THUMB is indexed by Bits 6-15
+	//Handlers for ARM.5, ARM.9, and THUMB.4 are specialized for each combination of those bits
+	static const std::array<arm_instructions, 4096> arm_decode_table;
+	static const std::array<arm_instructions, 1024> thumb_decode_table;
+	static const std::array<arm_handler_func, 4096> arm_handler_table;
+	static const std::array<thumb_handler_func, 1024> thumb_handler_table;
 
 	cpu_modes current_cpu_mode;
 	instr_modes arm_mode;
@@ -178,6 +186,10 @@ class NTR_ARM7
 	u8 idle_state;
 	u8 last_idle_state;
 
+	//Pipeline flushes so far, and the count when the current polling loop last branched back
+	u32 idle_flush_count;
+	u32 idle_loop_flush_count;
+
 	bool thumb_long_branch;
 	bool last_instr_branch;
 	u32 swi_waitbyloop_count;
@@ -197,6 +209,7 @@ class NTR_ARM7
 	bool re_sync;
 
 	NTR_MMU* mem;
+	ntr_scheduler* scheduler;
 
 	//Audio-Video and other controllers
 	//TODO - NDS7 will handle audio
@@ -215,6 +228,7 @@ class NTR_ARM7
 	void execute();
 	void update_pc();
 	void flush_pipeline();
+	u32 read_opcode(u32 addr);
 
 	void reset();
 	void setup_cpu_timing();
@@ -226,58 +240,19 @@ class NTR_ARM7
 	u32 get_spsr() const;
 	void set_spsr(u32 value);
 
-	//ARM instructions
-	void branch_exchange(u32 current_arm_instruction);
-	void branch_link(u32 current_arm_instruction);
-	void data_processing(u32 current_arm_instruction);
-	void psr_transfer(u32 current_arm_instruction);
-	void multiply(u32 current_arm_instruction);
-	void single_data_transfer(u32 current_arm_instruction);
-	void halfword_signed_transfer(u32 current_arm_instruction);
-	void block_data_transfer(u32 current_arm_instruction);
-	void single_data_swap(u32 current_arm_instruction);
-	void software_interrupt_breakpoint(u32 current_arm_instruction);
-
-	//THUMB instructions
-	void move_shifted_register(u16 current_thumb_instruction);
-	void add_sub_immediate(u16 current_thumb_instruction);
-	void mcas_immediate(u16 current_thumb_instruction);
-	void alu_ops(u16 current_thumb_instruction);
-	void hireg_bx(u16 current_thumb_instruction);
-	void load_pc_relative(u16 current_thumb_instruction);
-	void load_store_reg_offset(u16 current_thumb_instruction);
-	void load_store_sign_ex(u16 current_thumb_instruction);
-	void load_store_imm_offset(u16 current_thumb_instruction);
-	void load_store_halfword(u16 current_thumb_instruction);
-	void load_store_sp_relative(u16 current_thumb_instruction);
-	void get_relative_address(u16 current_thumb_instruction);
-	void add_offset_sp(u16 current_thumb_instruction);
-	void push_pop(u16 current_thumb_instruction);
-	void multiple_load_store(u16 current_thumb_instruction);
-	void conditional_branch(u16 current_thumb_instruction);
-	void unconditional_branch(u16 current_thumb_instruction);
-	void long_branch_link(u16 current_thumb_instruction);
-
 	//System functions
 	void clock(u32 access_address, mem_modes current_mode);
 	void clock();
-	void clock_timers(u8 access_cycles);
+	void timer_overflow(u8 timer_id);
 	void clock_system();
 	void clock_dma();
+	void process_events();
 	void handle_interrupt();
 
 	//DMA functions
 	void nds7_dma(u8 index);
 
 	//Misc CPU helpers
-	void update_condition_logical(u32 result, u8 shift_out);
-	void update_condition_arithmetic(u32 input, u32 operand, u32 result, bool addition);
-	bool check_condition(u32 current_arm_instruction) const;
-	u8 logical_shift_left(u32& input, u8 offset);
-	u8 logical_shift_right(u32& input, u8 offset);
-	u8 arithmetic_shift_right(u32& input, u8 offset);
-	u8 rotate_right(u32& input, u8 offset);
-	u8 rotate_right_special(u32& input, u8 offset);
 	void mem_check_32(u32 addr, u32& value, bool load_store);
 	void mem_check_16(u32 addr, u32& value, bool load_store);
 	void mem_check_8(u32 addr, u32& value, bool load_store);
@@ -297,8 +272,8 @@ class NTR_ARM7
 	void swi_sleep();
 	void swi_intrwait();
 	void swi_vblankintrwait();
-	void swi_lz77uncompvram();
-	void swi_rluncompvram();
+	void swi_lz77uncompvram(bool vram);
+	void swi_rluncompvram(bool vram);
 	void swi_huffuncomp();
 	void swi_getbioschecksum();
 	void swi_bgaffineset();
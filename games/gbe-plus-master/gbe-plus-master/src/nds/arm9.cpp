@@ -11,6 +11,12 @@
 
 #include "arm9.h"
 
+//Instruction lookup tables
+const std::array<NTR_ARM9::arm_instructions, 4096> NTR_ARM9::arm_decode_table = make_arm_decode_table();
+const std::array<NTR_ARM9::arm_handler_func, 4096> NTR_ARM9::arm_handler_table = make_arm_handler_table(std::make_index_sequence<4096>());
+const std::array<NTR_ARM9::arm_instructions, 1024> NTR_ARM9::thumb_decode_table = make_thumb_decode_table();
+const std::array<NTR_ARM9::thumb_handler_func, 1024> NTR_ARM9::thumb_handler_table = make_thumb_handler_table(std::make_index_sequence<1024>());
+
 /****** CPU Constructor ******/
 NTR_ARM9::NTR_ARM9()
 {
@@ -65,6 +71,16 @@ void NTR_ARM9::reset()
 	idle_state = 0;
 	last_idle_state = 0;
 
+	idle_loop_skip = config::nds_idle_loop_skip;
+	idle_loop_addr = 0xFFFFFFFF;
+	idle_loop_length = 0;
+	idle_flush_count = 0;
+	idle_loop_flush_count = 0;
+	flag_op = LAZY_FLAGS_NONE;
+
+	for(u32 x = 0; x < 16; x++) { idle_regs[x] = 0; }
+	for(u32 x = 0; x < IDLE_LOOP_MAX_OPS; x++) { idle_poll_values[x] = 0; }
+
 	thumb_long_branch = false;
 	last_instr_branch = false;
 	swi_waitbyloop_count = 0;
@@ -99,6 +115,7 @@ void NTR_ARM9::reset()
 
 	flush_pipeline();
 	mem = NULL;
+	scheduler = NULL;
 
 	co_proc.reset();
 
@@ -416,6 +433,16 @@ void NTR_ARM9::fetch()
 	mem->fetch_request = false;
 }
 
+/****** Reads an ARM or THUMB opcode from memory without touching the pipeline ******/
+u32 NTR_ARM9::read_opcode(u32 addr)
+{
+	mem->fetch_request = true;
+	u32 opcode = (arm_mode == THUMB) ? mem->read_u16(addr) : mem->read_u32(addr);
+	mem->fetch_request = false;
+
+	return opcode;
+}
+
 /****** Decode ARM instruction ******/
 void NTR_ARM9::decode()
 {
@@ -426,291 +453,13 @@ void NTR_ARM9::decode()
 	//Decode THUMB instructions
 	if(arm_mode == THUMB)
 	{
-		u16 current_instruction = instruction_pipeline[pipeline_id];
-		
-		if(((current_instruction >> 13) == 0) && (((current_instruction >> 11) & 0x7) != 0x3))
-		{
-			//THUMB_1
-			instruction_operation[pipeline_id] = THUMB_1;
-		}
-
-		else if(((current_instruction >> 11) & 0x1F) == 0x3)
-		{
-			//THUMB_2
-			instruction_operation[pipeline_id] = THUMB_2;
-		}
-
-		else if((current_instruction >> 13) == 0x1)
-		{
-			//THUMB_3
-			instruction_operation[pipeline_id] = THUMB_3;
-		}
-
-		else if(((current_instruction >> 10) & 0x3F) == 0x10)
-		{
-			//THUMB_4
-			instruction_operation[pipeline_id] = THUMB_4;
-		}
-
-		else if(((current_instruction >> 10) & 0x3F) == 0x11)
-		{
-			//THUMB_5
-			instruction_operation[pipeline_id] = THUMB_5;
-		}
-
-		else if((current_instruction >> 11) == 0x9)
-		{
-			//THUMB_6
-			instruction_operation[pipeline_id] = THUMB_6;
-		}
-
-		else if((current_instruction >> 12) == 0x5)
-		{
-			if(current_instruction & 0x200)
-			{
-				//THUMB_8
-				instruction_operation[pipeline_id] = THUMB_8;
-			}
-
-			else
-			{
-				//THUMB_7
-				instruction_operation[pipeline_id] = THUMB_7;
-			}
-		}
-
-		else if(((current_instruction >> 13) & 0x7) == 0x3)
-		{
-			//THUMB_9
-			instruction_operation[pipeline_id] = THUMB_9;
-		}
-
-		else if((current_instruction >> 12) == 0x8)
-		{
-			//THUMB_10
-			instruction_operation[pipeline_id] = THUMB_10;
-		}
-
-		else if((current_instruction >> 12) == 0x9)
-		{
-			//THUMB_11
-			instruction_operation[pipeline_id] = THUMB_11;
-		}
-
-		else if((current_instruction >> 12) == 0xA)
-		{
-			//THUMB_12
-			instruction_operation[pipeline_id] = THUMB_12;
-		}
-
-		else if((current_instruction >> 8) == 0xB0)
-		{
-			//THUMB_13
-			instruction_operation[pipeline_id] = THUMB_13;
-		}
-
-		else if((current_instruction >> 12) == 0xB)
-		{
-			//THUMB_14
-			instruction_operation[pipeline_id] = THUMB_14;
-		}
-
-		else if((current_instruction >> 12) == 0xC)
-		{
-			//THUMB_15
-			instruction_operation[pipeline_id] = THUMB_15;
-		}
-
-		else if((current_instruction >> 12) == 13)
-		{
-			//THUMB_16
-			instruction_operation[pipeline_id] = THUMB_16;
-		}
-
-		else if((current_instruction >> 11) == 0x1C)
-		{
-			//THUMB_18
-			instruction_operation[pipeline_id] = THUMB_18;
-		}
-
-		else if((current_instruction >> 11) >= 0x1E)
-		{
-			//THUMB_19
-			instruction_operation[pipeline_id] = THUMB_19;
-		}
-
-		else if((current_instruction & 0xF800) == 0xE800)
-		{
-			//THUMB_19 BLX
-			instruction_operation[pipeline_id] = THUMB_19;
-		}
+		instruction_operation[pipeline_id] = decode_thumb(instruction_pipeline[pipeline_id]);
 	}
 
 	//Decode ARM instructions
 	if(arm_mode == ARM)
 	{
-		u32 current_instruction = instruction_pipeline[pipeline_id];
-
-		if(((current_instruction >> 8) & 0xFFFFF) == 0x12FFF)
-		{
-			//ARM_3
-			instruction_operation[pipeline_id] = ARM_3;
-		}
-
-		else if(((current_instruction >> 25) & 0x7) == 0x5)
-		{
-			//ARM_4
-			instruction_operation[pipeline_id] = ARM_4;
-		}		
-
-		else if((current_instruction & 0xD900000) == 0x1000000) 
-		{
-
-			if((((current_instruction >> 16) & 0xFFF) == 0x16F) && (((current_instruction >> 4) & 0xFF) == 0xF1))
-			{
-				//ARM CLZ
-				instruction_operation[pipeline_id] = ARM_CLZ;
-			}
-
-			else if((((current_instruction >> 24) & 0xF) == 0x1) && (((current_instruction >> 4) & 0xFF) == 0x5))
-			{
-				//ARM QADD-QSUB
-				instruction_operation[pipeline_id] = ARM_QADD_QSUB;
-			}
-
-			else if((current_instruction & 0x80) && (current_instruction & 0x10) && ((current_instruction & 0x2000000) == 0))
-			{
-				if(((current_instruction >> 5) & 0x3) == 0) 
-				{ 
-					instruction_operation[pipeline_id] = ARM_12;
-				}
-
-				else 
-				{
-					instruction_operation[pipeline_id] = ARM_10;
-				}
-			}
-
-			else 
-			{
-				//ARM7
-				if((current_instruction & 0x80) && ((current_instruction & 0x2000000) == 0))
-				{
-					instruction_operation[pipeline_id] = ARM_7;
-				}
-
-				//ARM_6
-				else
-				{
-					instruction_operation[pipeline_id] = ARM_6;
-				}
-			}
-		}
-
-		else if(((current_instruction >> 26) & 0x3) == 0x0)
-		{
-			if((current_instruction & 0x80) && ((current_instruction & 0x10) == 0))
-			{
-				//ARM.5
-				if(current_instruction & 0x2000000)
-				{
-					instruction_operation[pipeline_id] = ARM_5;
-				}
-
-				//ARM.5
-				else if((current_instruction & 0x100000) && (((current_instruction >> 23) & 0x3) == 0x2))
-				{
-					instruction_operation[pipeline_id] = ARM_5;
-				}
-
-				//ARM.5
-				else if(((current_instruction >> 23) & 0x3) != 0x2)
-				{
-					instruction_operation[pipeline_id] = ARM_5;
-				}
-
-				//ARM.7
-				else
-				{
-					instruction_operation[pipeline_id] = ARM_7;
-				}
-			}
-
-			else if((current_instruction & 0x80) && (current_instruction & 0x10))
-			{
-				if(((current_instruction >> 4) & 0xF) == 0x9)
-				{
-					//ARM.5
-					if(current_instruction & 0x2000000)
-					{
-						instruction_operation[pipeline_id] = ARM_5;
-					}
-
-					//ARM.12
-					else if(((current_instruction >> 23) & 0x3) == 0x2)
-					{
-						instruction_operation[pipeline_id] = ARM_12;
-					}
-
-					//ARM.7
-					else
-					{
-						instruction_operation[pipeline_id] = ARM_7;
-					}
-				}
-
-				//ARM.5
-				else if(current_instruction & 0x2000000)
-				{
-					instruction_operation[pipeline_id] = ARM_5;
-				}
-
-				//ARM.10
-				else
-				{
-					instruction_operation[pipeline_id] = ARM_10;
-				}
-			}
-
-			//ARM.5
-			else
-			{
-				instruction_operation[pipeline_id] = ARM_5;
-			}
-		}
-
-		else if(((current_instruction >> 26) & 0x3) == 0x1)
-		{
-			//ARM_9
-			instruction_operation[pipeline_id] = ARM_9;
-		}
-
-		else if(((current_instruction >> 25) & 0x7) == 0x4)
-		{
-			//ARM_11
-			instruction_operation[pipeline_id] = ARM_11;
-		}
-
-		else if(((current_instruction >> 24) & 0xF) == 0xF)
-		{
-			//ARM_13
-			instruction_operation[pipeline_id] = ARM_13;
-		}
-
-		else if(((current_instruction >> 24) & 0xF) == 0xE)
-		{
-			//ARM Coprocessor Register Transfer
-			if(current_instruction & 0x10) { instruction_operation[pipeline_id] = ARM_COP_REG_TRANSFER; }
-			
-			//ARM Coprocessor Data Operation
-			else { instruction_operation[pipeline_id] = ARM_COP_DATA_OP; }
-		}
-
-		else if(((current_instruction >> 25) & 0x7) == 6)
-		{
-			//ARM Coprocessor Data Transfer
-			instruction_operation[pipeline_id] = ARM_COP_DATA_TRANSFER;
-		}
+		instruction_operation[pipeline_id] = decode_arm(instruction_pipeline[pipeline_id]);
 	}
 }
 
@@ -748,7 +497,7 @@ void NTR_ARM9::execute()
 				break;
 
 			case THUMB_4:
-				alu_ops(instruction_pipeline[pipeline_id]);
+				(this->*thumb_handler_table[(instruction_pipeline[pipeline_id] >> 6) & 0x3FF])(instruction_pipeline[pipeline_id]);
 				debug_message = 0x3; debug_code = instruction_pipeline[pipeline_id];
 				break;
 
@@ -852,7 +601,7 @@ void NTR_ARM9::execute()
 					break;
 
 				case ARM_5:
-					data_processing(instruction_pipeline[pipeline_id]);
+					(this->*arm_handler_table[((instruction_pipeline[pipeline_id] >> 16) & 0xFF0) | ((instruction_pipeline[pipeline_id] >> 4) & 0xF)])(instruction_pipeline[pipeline_id]);
 					debug_message = 0x16; debug_code = instruction_pipeline[pipeline_id];
 					break;
 
@@ -867,7 +616,7 @@ void NTR_ARM9::execute()
 					break;
 
 				case ARM_9:
-					single_data_transfer(instruction_pipeline[pipeline_id]);
+					(this->*arm_handler_table[((instruction_pipeline[pipeline_id] >> 16) & 0xFF0) | ((instruction_pipeline[pipeline_id] >> 4) & 0xF)])(instruction_pipeline[pipeline_id]);
 					debug_message = 0x19; debug_code = instruction_pipeline[pipeline_id];
 					break;
 
@@ -946,6 +695,7 @@ void NTR_ARM9::flush_pipeline()
 	pipeline_pointer = 0;
 	instruction_pipeline[0] = instruction_pipeline[1] = instruction_pipeline[2];
 	instruction_operation[0] = instruction_operation[1] = instruction_operation[2] = PIPELINE_FILL;
+	idle_flush_count++;
 }
 
 /****** Updates the PC after each fetch-decode-execute ******/
@@ -954,357 +704,306 @@ void NTR_ARM9::update_pc()
 	reg.r15 += (arm_mode == ARM) ? 4 : 2;
 }
 
-/****** Check conditional code ******/
-bool NTR_ARM9::check_condition(u32 current_arm_instruction) const
+/****** Coprocessor Register Transfer ******/
+void NTR_ARM9::coprocessor_register_transfer(u32 current_instruction)
 {
-	switch(current_arm_instruction >> 28)
-	{
-		//EQ
-		case 0x0:
-			if(reg.cpsr & CPSR_Z_FLAG) { return true; }
-			else { return false; }
-			break;
-
-		//NE
-		case 0x1:
-			if(reg.cpsr & CPSR_Z_FLAG) { return false; }
-			else { return true; }
-			break;
+	//Grab opcode
+	u8 cop_opcode_1 = (current_instruction >> 21) & 0x7;
 
-		//CS
-		case 0x2:
-			if(reg.cpsr & CPSR_C_FLAG) { return true; }
-			else { return false; }
-			break;
+	//Make sure opcode is zero to access CP15
+	if(cop_opcode_1 != 0)
+	{
+		std::cout<<"COP::Warning - Unknown Coprocessor Opcode 1 in Register Transfer : 0x" << std::hex << (int)cop_opcode_1 << "\n";
+		return;
+	}
 
-		//CC
-		case 0x3:
-			if(reg.cpsr & CPSR_C_FLAG) { return false; }
-			else { return true; }
-			break;
+	//Grab ARM opcode
+	u8 arm_opcode = (current_instruction & 0x100000) ? 1 : 0;
 
-		//MI
-		case 0x4:
-			if(reg.cpsr & CPSR_N_FLAG) { return true; }
-			else { return false; }
-			break;
+	//Grab coprocessor/ARM source/destination registers
+	u8 cop_reg = (current_instruction >> 16) & 0xF;
+	u8 arm_reg = (current_instruction >> 12) & 0xF;
 
-		//PL
-		case 0x5:
-			if(reg.cpsr & CPSR_N_FLAG) { return false; }
-			else { return true; }
-			break;
+	//Grab coprocessor operand
+	u8 cop_opr = current_instruction & 0xF;
 
-		//VS
-		case 0x6:
-			if(reg.cpsr & CPSR_V_FLAG) { return true; }
-			else { return false; }
-			break;
+	//Grab coprocessor info
+	u8 cop_info = (current_instruction >> 5) & 0x7;
 
-		//VC
-		case 0x7:
-			if(reg.cpsr & CPSR_V_FLAG) { return false; }
-			else { return true; }
-			break;
+	//Execute MRC - Read from CP15 registers
+	if(arm_opcode)
+	{
+		//std::cout<<"MRC -> C" << (int)cop_reg << ",C" << (int)cop_opr << "," << (int)cop_info << "\n";
 
-		//HI
-		case 0x8:
-			if((reg.cpsr & CPSR_C_FLAG) && ((reg.cpsr & CPSR_Z_FLAG) == 0)) { return true; }
-			else { return false; }
-			break;
+		//Move from C0,C0,0 - 2 to ARM register
+		if((cop_reg == 0) && (cop_opr == 0))
+		{
+			switch(cop_info)
+			{
+				case 0x0: set_reg(arm_reg, co_proc.regs[CP15::C0_C0_0]); break;
+				case 0x1: set_reg(arm_reg, co_proc.regs[CP15::C0_C0_1]); break;
+				case 0x2: set_reg(arm_reg, co_proc.regs[CP15::C0_C0_2]); break;
+			}
+		}
 
-		//LS
-		case 0x9:
-			if((reg.cpsr & CPSR_Z_FLAG) || ((reg.cpsr & CPSR_C_FLAG) == 0)) { return true; }
-			else { return false; }
-			break;
+		//Move from C1,C0,0 to ARM register
+		else if((cop_reg == 1) && (cop_opr == 0) && (cop_info == 0)) { set_reg(arm_reg, co_proc.regs[CP15::C1_C0_0]); }
 
-		//GE
-		case 0xA:
+		//Move from C2,C0,0 - 1 to ARM register
+		else if((cop_reg == 2) && (cop_opr == 0))
+		{
+			switch(cop_info)
 			{
-				u8 n = (reg.cpsr & CPSR_N_FLAG) ? 1 : 0;
-				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
-
-				if(n == v) { return true; }
-				else { return false; }
+				case 0x0: set_reg(arm_reg, co_proc.regs[CP15::C2_C0_0]); break;
+				case 0x1: set_reg(arm_reg, co_proc.regs[CP15::C2_C0_1]); break;
 			}
-			break;
+		}
 
-		//LT
-		case 0xB:
-			{
-				u8 n = (reg.cpsr & CPSR_N_FLAG) ? 1 : 0;
-				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
+		//Move from C3,C0,0 to ARM register
+		else if((cop_reg == 3) && (cop_opr == 0) && (cop_info == 0)) { set_reg(arm_reg, co_proc.regs[CP15::C3_C0_0]); }
 
-				if(n != v) { return true; }
-				else { return false; }
+		//Move from C5,C0,0 - 3 to ARM register
+		else if((cop_reg == 5) && (cop_opr == 0))
+		{
+			switch(cop_info)
+			{
+				case 0x0: set_reg(arm_reg, co_proc.regs[CP15::C5_C0_0]); break;
+				case 0x1: set_reg(arm_reg, co_proc.regs[CP15::C5_C0_1]); break;
+				case 0x2: set_reg(arm_reg, co_proc.regs[CP15::C5_C0_2]); break;
+				case 0x3: set_reg(arm_reg, co_proc.regs[CP15::C5_C0_3]); break;
 			}
-			break;
+		}
 
-		//GT
-		case 0xC:
+		//Move from C6,C0-C7,0 to ARM register
+		else if((cop_reg == 0) && (cop_info == 0))
+		{
+			switch(cop_opr)
 			{
-				u8 n = (reg.cpsr & CPSR_N_FLAG) ? 1 : 0;
-				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
-				u8 z = (reg.cpsr & CPSR_Z_FLAG) ? 1 : 0;
+				case 0x0: set_reg(arm_reg, co_proc.regs[CP15::C6_C0_0]); break;
+				case 0x1: set_reg(arm_reg, co_proc.regs[CP15::C6_C1_0]); break;
+				case 0x2: set_reg(arm_reg, co_proc.regs[CP15::C6_C2_0]); break;
+				case 0x3: set_reg(arm_reg, co_proc.regs[CP15::C6_C3_0]); break;
+				case 0x4: set_reg(arm_reg, co_proc.regs[CP15::C6_C4_0]); break;
+				case 0x5: set_reg(arm_reg, co_proc.regs[CP15::C6_C5_0]); break;
+				case 0x6: set_reg(arm_reg, co_proc.regs[CP15::C6_C6_0]); break;
+				case 0x7: set_reg(arm_reg, co_proc.regs[CP15::C6_C7_0]); break;
 
-				if((z == 0) && (n == v)) { return true; }
-				else { return false; }
 			}
-			break;
+		}
 
-		//LE
-		case 0xD:
+		//Move from C6,C0-C7,1 to ARM register
+		else if((cop_reg == 0) && (cop_info == 1))
+		{
+			switch(cop_opr)
 			{
-				u8 n = (reg.cpsr & CPSR_N_FLAG) ? 1 : 0;
-				u8 v = (reg.cpsr & CPSR_V_FLAG) ? 1 : 0;
-				u8 z = (reg.cpsr & CPSR_Z_FLAG) ? 1 : 0;
+				case 0x0: set_reg(arm_reg, co_proc.regs[CP15::C6_C0_1]); break;
+				case 0x1: set_reg(arm_reg, co_proc.regs[CP15::C6_C1_1]); break;
+				case 0x2: set_reg(arm_reg, co_proc.regs[CP15::C6_C2_1]); break;
+				case 0x3: set_reg(arm_reg, co_proc.regs[CP15::C6_C3_1]); break;
+				case 0x4: set_reg(arm_reg, co_proc.regs[CP15::C6_C4_1]); break;
+				case 0x5: set_reg(arm_reg, co_proc.regs[CP15::C6_C5_1]); break;
+				case 0x6: set_reg(arm_reg, co_proc.regs[CP15::C6_C6_1]); break;
+				case 0x7: set_reg(arm_reg, co_proc.regs[CP15::C6_C7_1]); break;
 
-				if((z == 1) || (n != v)) { return true; }
-				else { return false; }
 			}
-			break;
+		}
 
-		//AL
-		case 0xE: return true; break;
+		//C7,Cm,OP are write-only
 
-		//NV
-		default:
-			if(instruction_pipeline[((pipeline_pointer + 1) % 3)] != ARM_4)
+		//Move from C9,C0,0-1 to ARM register
+		else if((cop_reg == 9) && (cop_opr == 0))
+		{
+			switch(cop_info)
 			{
-				//std::cout<<"CPU::ARM9::Warning: ARM instruction uses reserved conditional code NV \n";
+				case 0x0: set_reg(arm_reg, co_proc.regs[CP15::C9_C0_0]); break;
+				case 0x1: set_reg(arm_reg, co_proc.regs[CP15::C9_C0_1]); break;
 			}
+		}
 
-			return true;
-	}
-}
-
-/****** Updates the condition codes in the CPSR register after logical operations ******/
-void NTR_ARM9::update_condition_logical(u32 result, u8 shift_out)
-{
-	//Negative flag
-	if(result & 0x80000000) { reg.cpsr |= CPSR_N_FLAG; }
-	else { reg.cpsr &= ~CPSR_N_FLAG; }
-
-	//Zero flag
-	if(result == 0) { reg.cpsr |= CPSR_Z_FLAG; }
-	else { reg.cpsr &= ~CPSR_Z_FLAG; }
-
-	//Carry flag
-	if(shift_out == 1) { reg.cpsr |= CPSR_C_FLAG; }
-	else if(shift_out == 0) { reg.cpsr &= ~CPSR_C_FLAG; }
-}
-
-/****** Updates the condition codes in the CPSR register after arithmetic operations ******/
-void NTR_ARM9::update_condition_arithmetic(u32 input, u32 operand, u32 result, bool addition)
-{
-	//Negative flag
-	if(result & 0x80000000) { reg.cpsr |= CPSR_N_FLAG; }
-	else { reg.cpsr &= ~CPSR_N_FLAG; }
-
-	//Zero flag
-	if(result == 0) { reg.cpsr |= CPSR_Z_FLAG; }
-	else { reg.cpsr &= ~CPSR_Z_FLAG; }
-
-	//Carry flag - Addition
-	if((operand > (0xFFFFFFFF - input)) && (addition)) { reg.cpsr |= CPSR_C_FLAG; }
-
-	//Carry flag - Subtraction
-	else if((operand <= input) && (!addition)) { reg.cpsr |= CPSR_C_FLAG; }
-
-	else { reg.cpsr &= ~CPSR_C_FLAG; }
-
-	//Overflow flag
-	u8 input_msb = (input & 0x80000000) ? 1 : 0;
-	u8 operand_msb = (operand & 0x80000000) ? 1 : 0;
-	u8 result_msb = (result & 0x80000000) ? 1 : 0;
-
-	if(addition)
-	{
-		if(input_msb != operand_msb) { reg.cpsr &= ~CPSR_V_FLAG; }
-		
-		else
+		//Move from C9,C1,0-1 to ARM register
+		else if((cop_reg == 9) && (cop_opr == 1))
 		{
-			if((result_msb == input_msb) && (result_msb == operand_msb)) { reg.cpsr &= ~CPSR_V_FLAG; }
-			else { reg.cpsr |= CPSR_V_FLAG; }
+			switch(cop_info)
+			{
+				case 0x0: set_reg(arm_reg, co_proc.regs[CP15::C9_C1_0]); break;
+				case 0x1: set_reg(arm_reg, co_proc.regs[CP15::C9_C1_1]); break;
+			}
 		}
-	}
 
-	else
-	{
-		if(input_msb == operand_msb) { reg.cpsr &= ~CPSR_V_FLAG; }
-		
 		else
 		{
-			if(result_msb == operand_msb) { reg.cpsr |= CPSR_V_FLAG; }
-			else { reg.cpsr &= ~CPSR_V_FLAG; }
-		}
-	}
-}
-
-/****** Updates the condition code in CPSR for Stick Overflow after QADD or QSUB operations ******/
-u8 NTR_ARM9::update_sticky_overflow(u32 input, u32 operand, u32 result, bool addition)
-{
-	u8 input_msb = (input & 0x80000000) ? 1 : 0;
-	u8 operand_msb = (operand & 0x80000000) ? 1 : 0;
-	u8 result_msb = (result & 0x80000000) ? 1 : 0;
-	u8 saturation_code = 0;
-
-	if(addition)
-	{
-		if(!input_msb && !operand_msb && result_msb) { reg.cpsr |= CPSR_Q_FLAG; saturation_code = 1; }
-		else if(input_msb && operand_msb && !result_msb) { reg.cpsr |= CPSR_Q_FLAG; saturation_code = 2; }
+			std::cout<<"COP::Warning - MRC accessed unknown C15 register : C" << (int)cop_reg << ",C" << (int)cop_opr << "," << (int)cop_info << "\n";
+		} 
 	}
 
+	//Execute MCR - Write to CP15 registers
 	else
 	{
-		if(!input_msb && operand_msb && result_msb) { reg.cpsr |= CPSR_Q_FLAG; saturation_code = 1; }
-		else if(input_msb && !operand_msb && !result_msb) { reg.cpsr |= CPSR_Q_FLAG; saturation_code = 2; }
-	} 
+		//std::cout<<"MCR -> C" << std::dec << (int)cop_reg << ",C" << (int)cop_opr << "," << (int)cop_info << " --> 0x" << std::hex << get_reg(arm_reg) <<"\n";
 
-	return saturation_code;
-}
+		//C0,C0,0 - 2 are read-only
 
-/****** Performs 32-bit logical shift left - Returns Carry Out ******/
-u8 NTR_ARM9::logical_shift_left(u32& input, u8 offset)
-{
-	u8 carry_out = 0;
-
-	if(offset > 0)
-	{
-		//Test for carry
-		//Perform LSL #(n-1), if Bit 31 is 1, we know it will carry out
-		u32 carry_test = input << (offset - 1);
-		carry_out = (carry_test & 0x80000000) ? 1 : 0;
-
-		if(offset >= 32)
+		//Move ARM register to C1,C0,0
+		if((cop_reg == 1) && (cop_opr == 0) && (cop_info == 0))
 		{
-			input = 0;
-			carry_out = (offset == 32) ? carry_out : 0;
+			//Mask C1,C0,0
+			//Bits 0, 2, 7, and 12-19 are RW
+			//Bits 3-6 are always set
+			co_proc.regs[CP15::C1_C0_0] = (get_reg(arm_reg) & 0xFF0FD);
+			co_proc.regs[CP15::C1_C0_0] |= 0x78;
+
+			co_proc.pu_enable = (co_proc.regs[CP15::C1_C0_0] & 0x1) ? true : false;
+			co_proc.unified_cache = (co_proc.regs[CP15::C1_C0_0] & 0x4) ? true : false;
+			co_proc.instr_cache = ((co_proc.regs[CP15::C1_C0_0] & 0x1000) && (!co_proc.unified_cache)) ? true : false;
+			co_proc.exception_vector = (co_proc.regs[CP15::C1_C0_0] & 0x2000) ? 0xFFFF0000 : 0x0;
+			co_proc.cache_replacement = (co_proc.regs[CP15::C1_C0_0] & 0x4000) ? true : false;
+			co_proc.pre_armv5 = (co_proc.regs[CP15::C1_C0_0] & 0x8000) ? true : false;
+			co_proc.dtcm_enable = (co_proc.regs[CP15::C1_C0_0] & 0x10000) ? true : false;
+			co_proc.itcm_enable = (co_proc.regs[CP15::C1_C0_0] & 0x40000) ? true : false;
+			
+			mem->dtcm_load_mode = (co_proc.regs[CP15::C1_C0_0] & 0x20000) ? true : false;
+			mem->itcm_load_mode = (co_proc.regs[CP15::C1_C0_0] & 0x80000) ? true : false;
+			mem->update_page_tables();
 		}
 
-		else { input <<= offset; }
-	}
+		//Move ARM register to C2,C0,0
+		else if((cop_reg == 2) && (cop_opr == 0))
+		{
+			switch(cop_info)
+			{
+				case 0x0: co_proc.regs[CP15::C2_C0_0] = get_reg(arm_reg); break;
+				case 0x1: co_proc.regs[CP15::C2_C0_1] = get_reg(arm_reg); break;
+			}
+		}
 
-	//LSL #0
-	//No shift performed, carry flag not affected, set it to something not 0 or 1 to check!
-	else { carry_out = 2; }
+		//Move ARM register to C3,C0,0
+		else if((cop_reg == 3) && (cop_opr == 0) && (cop_info == 0)) { co_proc.regs[CP15::C3_C0_0] = get_reg(arm_reg); }
 
-	return carry_out;
-}
+		//Move ARM register to C5,C0,0 - 3
+		else if((cop_reg == 5) && (cop_opr == 0))
+		{
+			switch(cop_info)
+			{
+				case 0x0: co_proc.regs[CP15::C5_C0_0] = get_reg(arm_reg); break;
+				case 0x1: co_proc.regs[CP15::C5_C0_1] = get_reg(arm_reg); break;
+				case 0x2: co_proc.regs[CP15::C5_C0_2] = get_reg(arm_reg); break;
+				case 0x3: co_proc.regs[CP15::C5_C0_3] = get_reg(arm_reg); break;
+			}
+		}
 
-/****** Performs 32-bit logical shift right - Returns Carry Out ******/
-u8 NTR_ARM9::logical_shift_right(u32& input, u8 offset)
-{
-	u8 carry_out = 0;
+		//Move ARM register to C6,C0-C7,0
+		else if((cop_reg == 6) && (cop_info == 0))
+		{
+			switch(cop_opr)
+			{
+				case 0x0: co_proc.regs[CP15::C6_C0_0] = get_reg(arm_reg); break;
+				case 0x1: co_proc.regs[CP15::C6_C1_0] = get_reg(arm_reg); break;
+				case 0x2: co_proc.regs[CP15::C6_C2_0] = get_reg(arm_reg); break;
+				case 0x3: co_proc.regs[CP15::C6_C3_0] = get_reg(arm_reg); break;
+				case 0x4: co_proc.regs[CP15::C6_C4_0] = get_reg(arm_reg); break;
+				case 0x5: co_proc.regs[CP15::C6_C5_0] = get_reg(arm_reg); break;
+				case 0x6: co_proc.regs[CP15::C6_C6_0] = get_reg(arm_reg); break;
+				case 0x7: co_proc.regs[CP15::C6_C7_0] = get_reg(arm_reg); break;
 
-	if(offset > 0)
-	{
-		//Test for carry
-		//Perform LSR #(n-1), if Bit 0 is 1, we know it will carry out
-		u32 carry_test = input >> (offset - 1);
-		carry_out = (carry_test & 0x1) ? 1 : 0;
+			}
+		}
 
-		if(offset >= 32)
+		//Move ARM register to C6,C0-C7,1
+		else if((cop_reg == 6) && (cop_info == 1))
 		{
-			input = 0;
-			carry_out = (offset == 32) ? carry_out : 0;
+			switch(cop_opr)
+			{
+				case 0x0: co_proc.regs[CP15::C6_C0_1] = get_reg(arm_reg); break;
+				case 0x1: co_proc.regs[CP15::C6_C1_1] = get_reg(arm_reg); break;
+				case 0x2: co_proc.regs[CP15::C6_C2_1] = get_reg(arm_reg); break;
+				case 0x3: co_proc.regs[CP15::C6_C3_1] = get_reg(arm_reg); break;
+				case 0x4: co_proc.regs[CP15::C6_C4_1] = get_reg(arm_reg); break;
+				case 0x5: co_proc.regs[CP15::C6_C5_1] = get_reg(arm_reg); break;
+				case 0x6: co_proc.regs[CP15::C6_C6_1] = get_reg(arm_reg); break;
+				case 0x7: co_proc.regs[CP15::C6_C7_1] = get_reg(arm_reg); break;
+
+			}
 		}
 
-		else { input >>= offset; }
-	}
+		//Move ARM register to C7,Cm,OP
+		else if(cop_reg == 7)
+		{
+			co_proc.regs[CP15::C7_CM_XX] = get_reg(arm_reg);
 
-	//LSR #0
-	//Same as LSR #32, input becomes zero, carry flag is Bit 31 of input
-	else
-	{
-		carry_out = (input & 0x80000000) ? 1 : 0;
-		input = 0;
-	}
+			//C7, C0, 4
+			if((cop_opr == 0) && (cop_info == 4))
+			{
+				idle_state = 1;
+				last_idle_state = 1;
+				mem->nds9_temp_if = mem->nds9_if;
+				mem->nds9_if = 0;
+				//std::cout<<"ARM9 HALT\n";
+			}
 
-	return carry_out;
-}
+			//C7,C5,0
+			if((cop_opr == 5) && (cop_info == 0)) { co_proc.invalidate_instr_cache(); }
 
-/****** Performs 32-bit arithmetic shift right - Returns Carry Out ******/
-u8 NTR_ARM9::arithmetic_shift_right(u32& input, u8 offset)
-{
-	u8 carry_out = 0;
+			//C7,C5,1
+			else if((cop_opr == 5) && (cop_info == 1)) { co_proc.invalidate_instr_cache_line(co_proc.regs[CP15::C7_CM_XX]); }
 
-	if(offset > 0)
-	{
-		u8 high_bit = (input & 0x80000000) ? 1 : 0;		
+			//C7,C6,0
+			else if((cop_opr == 6) && (cop_info == 0)) { co_proc.invalidate_data_cache(); }
 
-		//Basically LSR, but bits become Bit 31
-		for(int x = 0; x < offset; x++)
-		{
-			carry_out = (input & 0x1) ? 1 : 0;
-			input >>= 1;
-			if(high_bit == 1) { input |= 0x80000000; }
-		}	
-	}
+			//C7,C6,1
+			else if((cop_opr == 6) && (cop_info == 1)) { co_proc.invalidate_data_cache_line(co_proc.regs[CP15::C7_CM_XX]); }
 
-	//ASR #0
-	//Same as ASR #32, input becomes 0xFFFFFFFF or 0x0 depending on Bit 31 of input
-	//Carry flag set to 0 or 1 depending on Bit 31 of input
-	else
-	{
-		if(input & 0x80000000) { input = 0xFFFFFFFF; carry_out = 1; }
-		else { input = 0; carry_out = 0; }
-	}
+			//C7,C8,2
+			else if((cop_opr == 8) && (cop_info == 2)) { idle_state = 1; }
 
-	return carry_out;
-}
+			//C7,C10,4
+			else if((cop_opr == 10) && (cop_info == 4)) { co_proc.drain_write_buffer(); }
 
-/****** Performs 32-bit rotate right ******/
-u8 NTR_ARM9::rotate_right(u32& input, u8 offset)
-{
-	u8 carry_out = 0;
+		}
 
-	if(offset > 0)
-	{
-		//Perform ROR shift on immediate
-		for(int x = 0; x < offset; x++)
+		//Move ARM register to C9,C0,0-1
+		else if((cop_reg == 9) && (cop_opr == 0))
 		{
-			carry_out = input & 0x1;
-			input >>= 1;
+			switch(cop_info)
+			{
+				case 0x0:
+					co_proc.regs[CP15::C9_C0_0] = get_reg(arm_reg);
+					co_proc.data_cache_lockdown();
+					break;
 
-			if(carry_out) { input |= 0x80000000; }
+				case 0x1:
+					co_proc.regs[CP15::C9_C0_1] = get_reg(arm_reg);
+					co_proc.instr_cache_lockdown();
+					break;
+			}
 		}
-	}
 
-	//ROR #0
-	//Same as RRX #1, which is similar to ROR #1, except Bit 31 now becomes the old carry flag
-	else
-	{
-		u8 old_carry = (reg.cpsr & CPSR_C_FLAG) ? 1 : 0;
-		carry_out = input & 0x1;
-		input >>= 1;
-		
-		if(old_carry) { input |= 0x80000000; }
-	}
-
-	return carry_out;
-}
+		//Move ARM register to C9,C1,0-1
+		else if((cop_reg == 9) && (cop_opr == 1))
+		{
+			switch(cop_info)
+			{
+				case 0x0:
+					co_proc.regs[CP15::C9_C1_0] = get_reg(arm_reg);
+					co_proc.set_dtcm_size_base();
+					mem->nds9_irq_handler = co_proc.regs[CP15::CP15_TEMP] + 0x3FFC;
+					mem->dtcm_addr = co_proc.regs[CP15::CP15_TEMP];
+					mem->dtcm_end = mem->dtcm_addr + (512 << ((co_proc.regs[CP15::C9_C1_0] >> 1) & 0x1F));
+					mem->update_page_tables();
+					break;
 
-/****** Performs 32-bit rotate right - For ARM.5 Data Processing when Bit 25 is 1 ******/
-u8 NTR_ARM9::rotate_right_special(u32& input, u8 offset)
-{
-	u8 carry_out = 2;
+				case 0x1:
+					co_proc.regs[CP15::C9_C1_1] = get_reg(arm_reg);
+					co_proc.set_itcm_size_base();
+					break;
+			}
+		}
 
-	if(offset > 0)
-	{
-		//Perform ROR shift on immediate
-		for(int x = 0; x < (offset * 2); x++)
+		else
 		{
-			carry_out = input & 0x1;
-			input >>= 1;
-
-			if(carry_out) { input |= 0x80000000; }
+			std::cout<<"COP::Warning - MCR accessed unknown C15 register : C" << (int)cop_reg << ",C" << (int)cop_opr << "," << (int)cop_info << "\n";
 		}
 	}
-
-	return carry_out;
-}			
+}
 
 /****** Checks address before 32-bit reading/writing for special case scenarios ******/
 void NTR_ARM9::mem_check_32(u32 addr, u32& value, bool load_store)
@@ -1408,14 +1107,9 @@ void NTR_ARM9::clock_system()
 	//ARM9 CPU sync cycles
 	sync_cycles += system_cycles;
 
-	//Run controllers for each cycle		 
-	for(int x = 0; x < system_cycles; x++) { controllers.video.step(); }
-
-	//Run DMA channels
-	clock_dma();
-
-	//Run timers
-	clock_timers(system_cycles);
+	//Advance the system clock, then run any controllers that have events due
+	scheduler->nds9_cycle += system_cycles;
+	if(scheduler->nds9_cycle >= scheduler->nds9_next_event) { process_events(); }
 
 	//Reset system cycles
 	system_cycles = 2;
@@ -1431,48 +1125,24 @@ void NTR_ARM9::clock_dma()
 	}
 }
 
-/****** Runs Timer controllers every clock cycle ******/
-void NTR_ARM9::clock_timers(u8 access_cycles)
+/****** Handles a timer overflowing ******/
+void NTR_ARM9::timer_overflow(u8 timer_id)
 {
-	u32 due_cycles = 0;
-	u32 update_count = 0;
-	u32 old_count = 0;
+	//Bring counter up to the point of overflow, then reload
+	mem->sync_timer(timer_id);
+	controllers.timer[timer_id].counter = controllers.timer[timer_id].reload_value;
 
-	for(u32 x = 0; x < 4; x++)
+	//Increment next timer if in count-up mode, which may overflow in turn
+	if((timer_id < 3) && (controllers.timer[timer_id+1].enable) && (controllers.timer[timer_id+1].count_up))
 	{
-		//See if this timer is enabled first
-		if(controllers.timer[x].enable)
-		{
-			//If internal clock goes past 0, increment counter
-			if((controllers.timer[x].clock - access_cycles) & 0x80000000)
-			{
-				old_count = controllers.timer[x].counter;
-				due_cycles = ~(controllers.timer[x].clock - access_cycles) + 1;
-				update_count = due_cycles / controllers.timer[x].prescalar;
-				due_cycles -= (update_count * controllers.timer[x].prescalar);
-
-				if((controllers.timer[x].prescalar == 1)) { controllers.timer[x].clock = 0; }
-				else { controllers.timer[x].clock = controllers.timer[x].prescalar - due_cycles; }
-
-				if(!update_count) { update_count = 1; }
-				if(!controllers.timer[x].count_up) { controllers.timer[x].counter += update_count; }
-
-				//If counter overflows, reload value, trigger interrupt if necessary
-				if((old_count + update_count) > 0xFFFF) 
-				{
-					controllers.timer[x].counter = controllers.timer[x].reload_value;
-
-					//Increment next timer if in count-up mode
-					if((x < 4) && (controllers.timer[x+1].count_up)) { controllers.timer[x+1].counter++; }
+		controllers.timer[timer_id+1].counter++;
+		if(controllers.timer[timer_id+1].counter == 0) { timer_overflow(timer_id + 1); }
+	}
 
-					//Interrupt
-					if(controllers.timer[x].interrupt) { mem->nds9_if |= (8 << x); }
-				}
-			}
+	//Interrupt
+	if(controllers.timer[timer_id].interrupt) { mem->nds9_if |= (8 << timer_id); }
 
-			else { controllers.timer[x].clock -= access_cycles; }
-		}
-	}
+	mem->schedule_timer(timer_id);
 }
 
 /****** Jumps to or exits an interrupt ******/
@@ -1495,6 +1165,7 @@ void NTR_ARM9::handle_interrupt()
 		reg.r15 = get_reg(14) - 4;
 
 		//Set CPSR from SPSR, turn on IRQ flag
+		update_flags();
 		reg.cpsr = get_spsr();
 
 		//Set the CPU mode accordingly
@@ -1537,6 +1208,7 @@ void NTR_ARM9::handle_interrupt()
 
 			//Set PC and SPSR
 			reg.r15 = mem->nds9_bios_vector + 0x18;
+			update_flags();
 			set_spsr(reg.cpsr);
 
 			//Request pipeline flush, signal interrupt handling, and go to ARM mode
@@ -1597,6 +1269,7 @@ bool NTR_ARM9::cpu_read(u32 offset, std::string filename)
 
 	//Serialize CPU registers data from file stream
 	file.read((char*)&reg, sizeof(reg));
+	flag_op = LAZY_FLAGS_NONE;
 
 	//Serialize misc CPU data to save state
 	file.read((char*)&current_cpu_mode, sizeof(current_cpu_mode));
@@ -1608,6 +1281,9 @@ bool NTR_ARM9::cpu_read(u32 offset, std::string filename)
 	file.read((char*)&in_interrupt, sizeof(in_interrupt));
 	file.read((char*)&idle_state, sizeof(idle_state));
 	file.read((char*)&last_idle_state, sizeof(last_idle_state));
+
+	//Polling loops are detected again after loading
+	if(idle_state == 4) { idle_state = 0; }
 	file.read((char*)&thumb_long_branch, sizeof(thumb_long_branch));
 	file.read((char*)&last_instr_branch, sizeof(last_instr_branch));
 	file.read((char*)&swi_waitbyloop_count, sizeof(swi_waitbyloop_count));
@@ -1646,6 +1322,9 @@ bool NTR_ARM9::cpu_write(std::string filename)
 	
 	if(!file.is_open()) { return false; }
 
+	//Condition codes are saved as part of the CPSR
+	update_flags();
+
 	//Serialize CPU registers data to save state
 	file.write((char*)&reg, sizeof(reg));
 
@@ -46,6 +46,12 @@ NTR_core::NTR_core()
 	core_mmu.nds9_timer = &core_cpu_nds9.controllers.timer;
 	core_mmu.nds7_timer = &core_cpu_nds7.controllers.timer;
 
+	//Link CPUs, MMU, and scheduler
+	core_cpu_nds9.scheduler = &core_scheduler;
+	core_cpu_nds7.scheduler = &core_scheduler;
+	core_mmu.scheduler = &core_scheduler;
+	reset_scheduler();
+
 	db_unit.debug_mode = false;
 	//db_unit.display_cycles = false;
 	db_unit.print_all = false;
@@ -65,6 +71,7 @@ NTR_core::NTR_core()
 
 	//Reset CPU sync
 	cpu_sync_cycles = 0.0;
+	cpu_sync_quantum = config::nds_sync_quantum;
 	core_cpu_nds9.re_sync = true;
 	core_cpu_nds7.re_sync = false;
 
@@ -174,8 +181,15 @@ void NTR_core::reset()
 	core_mmu.nds9_timer = &core_cpu_nds9.controllers.timer;
 	core_mmu.nds7_timer = &core_cpu_nds7.controllers.timer;
 
+	//Link CPUs, MMU, and scheduler
+	core_cpu_nds9.scheduler = &core_scheduler;
+	core_cpu_nds7.scheduler = &core_scheduler;
+	core_mmu.scheduler = &core_scheduler;
+	reset_scheduler();
+
 	//Reset CPU sync
 	cpu_sync_cycles = 0.0;
+	cpu_sync_quantum = config::nds_sync_quantum;
 	core_cpu_nds9.re_sync = true;
 	core_cpu_nds7.re_sync = false;
 
@@ -249,7 +263,10 @@ void NTR_core::run_core()
 				//Check to see if CPU is paused or idle for any reason
 				if(core_cpu_nds9.idle_state)
 				{
-					core_cpu_nds9.system_cycles += 8;
+					//Skip ahead to the next event when both CPUs are idle
+					//A CPU parked in a polling loop can also run ahead on its own until its next event
+					if(core_cpu_nds9.idle_state == 4) { core_cpu_nds9.system_cycles += ((get_poll_cycles(5, core_scheduler.nds9_cycle, core_scheduler.nds9_next_event) << 1) - 2); }
+					else { core_cpu_nds9.system_cycles += ((get_idle_cycles(5) << 1) - 2); }
 
 					switch(core_cpu_nds9.idle_state)
 					{
@@ -322,6 +339,16 @@ void NTR_core::run_core()
 							//Clear IF flags to wait for new one
 							if(core_cpu_nds9.idle_state) { core_mmu.nds9_if &= ~core_mmu.nds9_temp_if; }
 
+							break;
+
+						//Polling loop
+						case 0x4:
+							//Wake once the loop would read something new, or when an interrupt is due
+							if((core_cpu_nds9.idle_loop_changed()) || ((core_mmu.nds9_ime & 0x1) && (core_mmu.nds9_ie & core_mmu.nds9_if) && ((core_cpu_nds9.reg.cpsr & CPSR_IRQ) == 0)))
+							{
+								core_cpu_nds9.idle_state = 0;
+							}
+
 							break;
 					}
 
@@ -365,7 +392,8 @@ void NTR_core::run_core()
 				//Determine if NDS7 needs to run in order to sync
 				cpu_sync_cycles -= core_cpu_nds9.sync_cycles;	
 
-				if(cpu_sync_cycles <= 0)
+				//Switch once this CPU is a full quantum ahead, or sooner if it touched shared state
+				if((cpu_sync_cycles <= -cpu_sync_quantum) || ((cpu_sync_cycles <= 0) && (core_mmu.sync_request)))
 				{
 					core_cpu_nds9.re_sync = false;
 					core_cpu_nds7.re_sync = true;
@@ -373,6 +401,8 @@ void NTR_core::run_core()
 					core_mmu.access_mode = 0;
 				}
 
+				core_mmu.sync_request = false;
+
 				core_cpu_nds9.thumb_long_branch = false;
 			}
 
@@ -384,7 +414,10 @@ void NTR_core::run_core()
 				//Check to see if CPU is paused or idle for any reason
 				if(core_cpu_nds7.idle_state)
 				{
-					core_cpu_nds7.system_cycles += 8;
+					//Skip ahead to the next event when both CPUs are idle
+					//A CPU parked in a polling loop can also run ahead on its own until its next event
+					if(core_cpu_nds7.idle_state == 4) { core_cpu_nds7.system_cycles += (get_poll_cycles(10, core_scheduler.nds7_cycle, core_scheduler.nds7_next_event) - 2); }
+					else { core_cpu_nds7.system_cycles += (get_idle_cycles(10) - 2); }
 
 					switch(core_cpu_nds7.idle_state)
 					{
@@ -454,6 +487,16 @@ void NTR_core::run_core()
 							//Clear IF flags to wait for new one
 							if(core_cpu_nds7.idle_state) { core_mmu.nds7_if &= ~core_mmu.nds7_temp_if; }
 
+							break;
+
+						//Polling loop
+						case 0x4:
+							//Wake once the loop would read something new, or when an interrupt is due
+							if((core_cpu_nds7.idle_loop_changed()) || ((core_mmu.nds7_ime & 0x1) && (core_mmu.nds7_ie & core_mmu.nds7_if) && ((core_cpu_nds7.reg.cpsr & CPSR_IRQ) == 0)))
+							{
+								core_cpu_nds7.idle_state = 0;
+							}
+
 							break;
 					}
 
@@ -497,7 +540,8 @@ void NTR_core::run_core()
 				//Determine if NDS9 needs to run in order to sync
 				cpu_sync_cycles -= core_cpu_nds7.sync_cycles;
 
-				if(cpu_sync_cycles <= 0)
+				//Switch once this CPU is a full quantum ahead, or sooner if it touched shared state
+				if((cpu_sync_cycles <= -cpu_sync_quantum) || ((cpu_sync_cycles <= 0) && (core_mmu.sync_request)))
 				{
 					core_cpu_nds7.re_sync = false;
 					core_cpu_nds9.re_sync = true;
@@ -505,6 +549,8 @@ void NTR_core::run_core()
 					core_mmu.access_mode = 1;
 				}
 
+				core_mmu.sync_request = false;
+
 				core_cpu_nds7.thumb_long_branch = false;
 			}
 		}
@@ -533,7 +579,10 @@ void NTR_core::step()
 			//Check to see if CPU is paused or idle for any reason
 			if(core_cpu_nds9.idle_state)
 			{
-				core_cpu_nds9.system_cycles += 8;
+				//Skip ahead to the next event when both CPUs are idle
+				//A CPU parked in a polling loop can also run ahead on its own until its next event
+				if(core_cpu_nds9.idle_state == 4) { core_cpu_nds9.system_cycles += ((get_poll_cycles(5, core_scheduler.nds9_cycle, core_scheduler.nds9_next_event) << 1) - 2); }
+				else { core_cpu_nds9.system_cycles += ((get_idle_cycles(5) << 1) - 2); }
 
 				switch(core_cpu_nds9.idle_state)
 				{
@@ -578,6 +627,16 @@ void NTR_core::step()
 							if(core_cpu_nds9.idle_state) { core_mmu.nds9_if &= ~core_mmu.nds9_temp_if; }
 						}
 
+						break;
+
+					//Polling loop
+					case 0x4:
+						//Wake once the loop would read something new, or when an interrupt is due
+						if((core_cpu_nds9.idle_loop_changed()) || ((core_mmu.nds9_ime & 0x1) && (core_mmu.nds9_ie & core_mmu.nds9_if) && ((core_cpu_nds9.reg.cpsr & CPSR_IRQ) == 0)))
+						{
+							core_cpu_nds9.idle_state = 0;
+						}
+
 						break;
 				}
 
@@ -616,13 +675,16 @@ void NTR_core::step()
 			//Determine if NDS7 needs to run in order to sync
 			cpu_sync_cycles -= core_cpu_nds9.sync_cycles;	
 
-			if(cpu_sync_cycles <= 0)
+			//Switch once this CPU is a full quantum ahead, or sooner if it touched shared state
+			if((cpu_sync_cycles <= -cpu_sync_quantum) || ((cpu_sync_cycles <= 0) && (core_mmu.sync_request)))
 			{
 				core_cpu_nds9.re_sync = false;
 				core_cpu_nds7.re_sync = true;
 				cpu_sync_cycles *= -1.0;
 				core_mmu.access_mode = 0;
 			}
+
+			core_mmu.sync_request = false;
 		}
 
 		//Run NDS7
@@ -633,7 +695,10 @@ void NTR_core::step()
 			//Check to see if CPU is paused or idle for any reason
 			if(core_cpu_nds7.idle_state)
 			{
-				core_cpu_nds7.system_cycles += 8;
+				//Skip ahead to the next event when both CPUs are idle
+				//A CPU parked in a polling loop can also run ahead on its own until its next event
+				if(core_cpu_nds7.idle_state == 4) { core_cpu_nds7.system_cycles += (get_poll_cycles(10, core_scheduler.nds7_cycle, core_scheduler.nds7_next_event) - 2); }
+				else { core_cpu_nds7.system_cycles += (get_idle_cycles(10) - 2); }
 
 				switch(core_cpu_nds7.idle_state)
 				{
@@ -675,6 +740,16 @@ void NTR_core::step()
 							if(core_cpu_nds7.idle_state) { core_mmu.nds7_if &= ~core_mmu.nds7_temp_if; }
 						}
 
+						break;
+
+					//Polling loop
+					case 0x4:
+						//Wake once the loop would read something new, or when an interrupt is due
+						if((core_cpu_nds7.idle_loop_changed()) || ((core_mmu.nds7_ime & 0x1) && (core_mmu.nds7_ie & core_mmu.nds7_if) && ((core_cpu_nds7.reg.cpsr & CPSR_IRQ) == 0)))
+						{
+							core_cpu_nds7.idle_state = 0;
+						}
+
 						break;
 				}
 
@@ -713,13 +788,16 @@ void NTR_core::step()
 			//Determine if NDS9 needs to run in order to sync
 			cpu_sync_cycles -= core_cpu_nds7.sync_cycles;
 
-			if(cpu_sync_cycles <= 0)
+			//Switch once this CPU is a full quantum ahead, or sooner if it touched shared state
+			if((cpu_sync_cycles <= -cpu_sync_quantum) || ((cpu_sync_cycles <= 0) && (core_mmu.sync_request)))
 			{
 				core_cpu_nds7.re_sync = false;
 				core_cpu_nds9.re_sync = true;
 				cpu_sync_cycles *= -1.0;
 				core_mmu.access_mode = 1;
 			}
+
+			core_mmu.sync_request = false;
 		}
 	}
 }
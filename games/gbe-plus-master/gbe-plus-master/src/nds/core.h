@@ -64,14 +64,21 @@ class NTR_core : virtual public core_emu
 		void start_netplay();
 		void stop_netplay();
 
+		//Scheduler
+		void reset_scheduler();
+		u32 get_idle_cycles(u32 min_cycles);
+		u32 get_poll_cycles(u32 min_cycles, u64 current_cycle, u64 next_event);
+
 		//Misc
 		u32 get_core_data(u32 core_index);
 
 		NTR_MMU core_mmu;
 		NTR_ARM7 core_cpu_nds7;
 		NTR_ARM9 core_cpu_nds9;
+		ntr_scheduler core_scheduler;
 
 		double cpu_sync_cycles;
+		double cpu_sync_quantum;
 		bool nds9_debug;
 		bool arm_debug;
 
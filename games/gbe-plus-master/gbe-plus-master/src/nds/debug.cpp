@@ -218,7 +218,7 @@ void NTR_core::debug_display() const
 	u32 debug_code = nds9_debug ? core_cpu_nds9.debug_code : core_cpu_nds7.debug_code;
 	u8 debug_message = nds9_debug ? core_cpu_nds9.debug_message : core_cpu_nds7.debug_message;
 	u32 cpu_regs[16];
-	u32 cpsr = nds9_debug ? core_cpu_nds9.reg.cpsr : core_cpu_nds7.reg.cpsr;
+	u32 cpsr = nds9_debug ? core_cpu_nds9.get_cpsr() : core_cpu_nds7.get_cpsr();
 
 	for(u32 x = 0; x < 16; x++)
 	{
@@ -1764,8 +1764,8 @@ void NTR_core::debug_process_command()
 
 					case 0x10:
 						std::cout<<"\nSetting Register CPSR to 0x" << std::hex << reg_value << "\n";
-						if(main_cpu) { core_cpu_nds9.reg.cpsr = reg_value; }
-						else { core_cpu_nds7.reg.cpsr = reg_value; }
+						if(main_cpu) { core_cpu_nds9.reg.cpsr = reg_value; core_cpu_nds9.flag_op = LAZY_FLAGS_NONE; }
+						else { core_cpu_nds7.reg.cpsr = reg_value; core_cpu_nds7.flag_op = LAZY_FLAGS_NONE; }
 						break;
 
 					case 0x11:
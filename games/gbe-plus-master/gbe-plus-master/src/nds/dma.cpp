@@ -20,7 +20,6 @@ void NTR_ARM9::nds9_dma(u8 index)
 	//Check DMA control register to start transfer
 	if((mem->dma[index].control & 0x80000000) == 0) { mem->dma[index].enable = false; return; }
 
-	u32 temp_value = 0;
 	u32 original_dest_addr = mem->dma[index].destination_address;
 	u8 dma_mode = ((mem->dma[index].control >> 27) & 0x7);
 
@@ -53,65 +52,10 @@ void NTR_ARM9::nds9_dma(u8 index)
 		//DMA fill operation
 		if(mem->dma[index].start_address == fill_addr) { mem->dma[index].src_addr_ctrl = 4; }
 
-		//16-bit transfer
-		if(mem->dma[index].word_type == 0)
-		{
-			//Align addresses to half-word
-			mem->dma[index].start_address &= ~0x1;
-			mem->dma[index].destination_address &= ~0x1;
-
-			while(mem->dma[index].word_count != 0)
-			{
-				temp_value = mem->read_u16(mem->dma[index].start_address);
-				mem->write_u16(mem->dma[index].destination_address, temp_value);
-
-				//Update DMA Start Address
-				if(mem->dma[index].src_addr_ctrl == 0) { mem->dma[index].start_address += 2; }
-				else if(mem->dma[index].src_addr_ctrl == 1) { mem->dma[index].start_address -= 2; }
-				else if(mem->dma[index].src_addr_ctrl == 3) { mem->dma[index].start_address += 2; }
-
-				//Update DMA Destination Address
-				if(mem->dma[index].dest_addr_ctrl == 0) { mem->dma[index].destination_address += 2; }
-				else if(mem->dma[index].dest_addr_ctrl == 1) { mem->dma[index].destination_address -= 2; }
-				else if(mem->dma[index].dest_addr_ctrl == 3) { mem->dma[index].destination_address += 2; }
-
-				mem->dma[index].word_count--;
-			}
-		}
-
-		//32-bit transfer
-		else
-		{
-			//Align addresses to word
-			mem->dma[index].start_address &= ~0x3;
-			mem->dma[index].destination_address &= ~0x3;
-
-			while(mem->dma[index].word_count != 0)
-			{
-				temp_value = mem->read_u32(mem->dma[index].start_address);
-				mem->write_u32(mem->dma[index].destination_address, temp_value);
-
-				//Update DMA Start Address
-				if(mem->dma[index].src_addr_ctrl == 0) { mem->dma[index].start_address += 4; }
-				else if(mem->dma[index].src_addr_ctrl == 1) { mem->dma[index].start_address -= 4; }
-				else if(mem->dma[index].src_addr_ctrl == 3) { mem->dma[index].start_address += 4; }
-
-				//Update DMA Destination Address
-				if(mem->dma[index].dest_addr_ctrl == 0) { mem->dma[index].destination_address += 4; }
-				else if(mem->dma[index].dest_addr_ctrl == 1) { mem->dma[index].destination_address -= 4; }
-				else if(mem->dma[index].dest_addr_ctrl == 3) { mem->dma[index].destination_address += 4; }
-
-				mem->dma[index].word_count--;
-
-				//Force LCD to process GX commands if necessary
-				//Some games manually use an NDS9 DMA to GXFIFO (fixed destination, 32-bit, inc/dec source)
-				if(mem->gx_command)
-				{
-					controllers.video.process_gx_command();
-					mem->gx_command = false;
-				}
-			}
-		}
+		//Some games manually use an NDS9 DMA to GXFIFO (fixed destination, 32-bit, inc/dec source)
+		//32-bit transfers into I/O go through GXFIFO handling in case they land there
+		if((mem->dma[index].word_type) && ((mem->dma[index].destination_address >> 24) == 0x4)) { dma_gx_fifo(index, false); }
+		else { mem->dma_transfer(index); }
 	}
 
 	else if(dma_mode == 5)
@@ -127,7 +71,12 @@ void NTR_ARM9::nds9_dma(u8 index)
 
 		while(mem->dma[index].word_count != 0)
 		{
-			mem->memory_map[mem->dma[index].destination_address++] = mem->cart_data[mem->nds_card.transfer_src++];
+			u32 dest_addr = mem->dma[index].destination_address++;
+			u8 value = mem->cart_data[mem->nds_card.transfer_src++];
+
+			//Drop writes to VRAM without a bank
+			if(((dest_addr >> 24) != 0x6) || (mem->memory_map.get_vram_offset(dest_addr) != 0xFFFFFFFF)) { mem->memory_map[dest_addr] = value; }
+
 			mem->dma[index].word_count--;
 		}
 
@@ -143,29 +92,7 @@ void NTR_ARM9::nds9_dma(u8 index)
 		std::cout<<"GX FIFO DMA\n";
 
 		mem->gx_command = false;
-
-		//Align addresses to word
-		mem->dma[index].start_address &= ~0x3;
-
-		while(mem->dma[index].word_count != 0)
-		{
-			temp_value = mem->read_u32(mem->dma[index].start_address);
-			mem->write_u32(NDS_GXFIFO, temp_value);
-
-			//Update DMA Start Address
-			if(mem->dma[index].src_addr_ctrl == 0) { mem->dma[index].start_address += 4; }
-			else if(mem->dma[index].src_addr_ctrl == 1) { mem->dma[index].start_address -= 4; }
-			else if(mem->dma[index].src_addr_ctrl == 3) { mem->dma[index].start_address += 4; }
-
-			mem->dma[index].word_count--;
-
-			//Force LCD to process GX commands
-			if(mem->gx_command)
-			{
-				controllers.video.process_gx_command();
-				mem->gx_command = false;
-			}
-		}
+		dma_gx_fifo(index, true);
 	}
 
 	mem->dma[index].control &= ~0x1FFFFF;
@@ -198,6 +125,62 @@ void NTR_ARM9::nds9_dma(u8 index)
 	}
 }
 
+/****** Feeds an NDS9 DMA to GXFIFO - Runs of plain memory go to the geometry engine as one command list ******/
+void NTR_ARM9::dma_gx_fifo(u8 index, bool fixed_gxfifo)
+{
+	//Align addresses to word
+	mem->dma[index].start_address &= ~0x3;
+	if(!fixed_gxfifo) { mem->dma[index].destination_address &= ~0x3; }
+
+	u32 dest_addr = (fixed_gxfifo) ? NDS_GXFIFO : mem->dma[index].destination_address;
+
+	s32 src_step = 4;
+	s32 dest_step = 4;
+
+	if(mem->dma[index].src_addr_ctrl == 1) { src_step = -4; }
+	else if((mem->dma[index].src_addr_ctrl == 2) || (mem->dma[index].src_addr_ctrl == 4)) { src_step = 0; }
+
+	if(fixed_gxfifo || (mem->dma[index].dest_addr_ctrl == 2)) { dest_step = 0; }
+	else if(mem->dma[index].dest_addr_ctrl == 1) { dest_step = -4; }
+
+	//GXFIFO is mirrored from 0x4000400 to 0x400043F and only takes commands while the 3D engine is powered
+	bool gx_list = ((dest_step == 0) && (dest_addr >= NDS_GXFIFO) && (dest_addr <= 0x400043F) && (mem->power_cnt1 & 0x8));
+
+	while(mem->dma[index].word_count != 0)
+	{
+		u32 count = 0;
+		u32 src_addr = mem->dma[index].start_address;
+		u8* page = ((gx_list) && (src_step > 0)) ? mem->get_read_page(src_addr) : NULL;
+
+		if(page != NULL)
+		{
+			count = (0x4000 - (src_addr & 0x3FFF)) >> 2;
+			if(count > mem->dma[index].word_count) { count = mem->dma[index].word_count; }
+
+			controllers.video.process_gx_list(&page[src_addr & 0x3FFF], count);
+		}
+
+		else
+		{
+			mem->write_u32(dest_addr, mem->read_u32(src_addr));
+			count = 1;
+
+			//Force LCD to process GX commands if necessary
+			if(mem->gx_command)
+			{
+				controllers.video.process_gx_command();
+				mem->gx_command = false;
+			}
+		}
+
+		mem->dma[index].start_address += (src_step * count);
+		dest_addr += (dest_step * count);
+		mem->dma[index].word_count -= count;
+	}
+
+	if(!fixed_gxfifo) { mem->dma[index].destination_address = dest_addr; }
+}
+
 /****** Performs DMA0 through DMA3 transfers - NDS7 ******/
 void NTR_ARM7::nds7_dma(u8 index)
 {
@@ -205,7 +188,6 @@ void NTR_ARM7::nds7_dma(u8 index)
 
 	if((mem->dma[index].control & 0x80000000) == 0) { mem->dma[index].enable = false; return; }
 
-	u32 temp_value = 0;
 	u32 original_dest_addr = mem->dma[index].destination_address;
 
 	u8 dma_mode = ((mem->dma[index].control >> 28) & 0x3);
@@ -225,57 +207,7 @@ void NTR_ARM7::nds7_dma(u8 index)
 	//std::cout<<"DEST  ADDR -> 0x" << std::hex << mem->dma[index].destination_address << "\n";
 	//std::cout<<"WORD COUNT -> 0x" << std::hex << mem->dma[index].word_count << "\n";
 
-	//16-bit transfer
-	if(mem->dma[index].word_type == 0)
-	{
-		//Align addresses to half-word
-		mem->dma[index].start_address &= ~0x1;
-		mem->dma[index].destination_address &= ~0x1;
-
-		while(mem->dma[index].word_count != 0)
-		{
-			temp_value = mem->read_u16(mem->dma[index].start_address);
-			mem->write_u16(mem->dma[index].destination_address, temp_value);
-
-			//Update DMA Start Address
-			if(mem->dma[index].src_addr_ctrl == 0) { mem->dma[index].start_address += 2; }
-			else if(mem->dma[index].src_addr_ctrl == 1) { mem->dma[index].start_address -= 2; }
-			else if(mem->dma[index].src_addr_ctrl == 3) { mem->dma[index].start_address += 2; }
-
-			//Update DMA Destination Address
-			if(mem->dma[index].dest_addr_ctrl == 0) { mem->dma[index].destination_address += 2; }
-			else if(mem->dma[index].dest_addr_ctrl == 1) { mem->dma[index].destination_address -= 2; }
-			else if(mem->dma[index].dest_addr_ctrl == 3) { mem->dma[index].destination_address += 2; }
-
-			mem->dma[index].word_count--;
-		}
-	}
-
-	//32-bit transfer
-	else
-	{
-		//Align addresses to word
-		mem->dma[index].start_address &= ~0x3;
-		mem->dma[index].destination_address &= ~0x3;
-
-		while(mem->dma[index].word_count != 0)
-		{
-			temp_value = mem->read_u32(mem->dma[index].start_address);
-			mem->write_u32(mem->dma[index].destination_address, temp_value);
-
-			//Update DMA Start Address
-			if(mem->dma[index].src_addr_ctrl == 0) { mem->dma[index].start_address += 4; }
-			else if(mem->dma[index].src_addr_ctrl == 1) { mem->dma[index].start_address -= 4; }
-			else if(mem->dma[index].src_addr_ctrl == 3) { mem->dma[index].start_address += 4; }
-
-			//Update DMA Destination Address
-			if(mem->dma[index].dest_addr_ctrl == 0) { mem->dma[index].destination_address += 4; }
-			else if(mem->dma[index].dest_addr_ctrl == 1) { mem->dma[index].destination_address -= 4; }
-			else if(mem->dma[index].dest_addr_ctrl == 3) { mem->dma[index].destination_address += 4; }
-
-			mem->dma[index].word_count--;
-		}
-	}
+	mem->dma_transfer(index);
 
 	mem->dma[index].control &= ~0xFFFF;
 
@@ -108,6 +108,9 @@ void NTR_MMU::process_card_bus()
 					{
 						do_dma = true;
 						dma[x].started = true;
+
+						if(x < 4) { schedule_event(NTR_NDS9_DMA_EVENT, scheduler->nds9_cycle + 1); }
+						else { schedule_event(NTR_NDS7_DMA_EVENT, scheduler->nds7_cycle + 1); }
 					}
 				}
 
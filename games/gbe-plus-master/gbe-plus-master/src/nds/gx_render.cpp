@@ -28,6 +28,7 @@ void NTR_LCD::render_bg_3D()
 
 	u8 bg_priority = lcd_stat.bg_priority_a[0] + 1;
 	u16 x_offset = lcd_stat.bg_offset_x_a[0];
+	ntr_engine_line& engine = engine_line[0];
 
 	//Grab data from the previous buffer
 	u16 current_buffer = (lcd_3D_stat.buffer_id);
@@ -45,19 +46,17 @@ void NTR_LCD::render_bg_3D()
 			{
 				render_buffer_a[x] = bg_priority;
 				scanline_buffer_a[x] = gx_screen_buffer[current_buffer][gx_index + i];
-				line_buffer[4][x] |= 1;
+				engine.line_buffer[4][x] |= 1;
 			}
 		}
 
-		line_buffer[0][x] = scanline_buffer_a[x];
+		engine.line_buffer[0][x] = scanline_buffer_a[x];
 	} 
 }
 
-/****** Renders geometry to the 3D screen buffers ******/
-void NTR_LCD::render_geometry()
+/****** Transforms a completed polygon and stores it in Polygon and Vertex RAM ******/
+void NTR_LCD::store_polygon()
 {
-	u8 bg_priority = lcd_stat.bg_priority_a[0] + 1;
-
 	//Calculate origin coordinates based on viewport dimensions
 	u8 viewport_width = (lcd_3D_stat.view_port_x2 - lcd_3D_stat.view_port_x1);
 	u8 viewport_height = (lcd_3D_stat.view_port_y2 - lcd_3D_stat.view_port_y1);
@@ -69,7 +68,6 @@ void NTR_LCD::render_geometry()
 	float plot_w[4];
 	float plot_tx[4];
 	float plot_ty[4];
-	s32 buffer_index = 0;
 	u8 vert_count = 0;
 	gx_matrix vert_matrix = current_poly;
 	gx_matrix temp_matrix;
@@ -153,6 +151,73 @@ void NTR_LCD::render_geometry()
 		}
 	}
 
+	//Latch polygon and texture attributes
+	ntr_gx_polygon poly;
+
+	poly.vert_index = gx_vert_ram.size();
+	poly.vert_count = vert_count;
+	poly.vertex_mode = lcd_3D_stat.vertex_mode;
+	poly.vertex_color = lcd_3D_stat.vertex_color;
+
+	poly.poly_id = lcd_3D_stat.poly_id;
+	poly.poly_alpha = lcd_3D_stat.poly_alpha;
+	poly.poly_mode = lcd_3D_stat.poly_mode;
+	poly.poly_new_depth = lcd_3D_stat.poly_new_depth;
+	poly.poly_depth_test = lcd_3D_stat.poly_depth_test;
+
+	poly.use_texture = lcd_3D_stat.use_texture;
+	poly.tex_offset = lcd_3D_stat.tex_offset;
+	poly.pal_base = lcd_3D_stat.pal_base;
+	poly.pal_bank_addr = lcd_3D_stat.pal_bank_addr;
+	poly.tex_src_width = lcd_3D_stat.tex_src_width;
+	poly.tex_src_height = lcd_3D_stat.tex_src_height;
+	poly.tex_format = lcd_3D_stat.tex_format;
+	poly.tex_color_zero = lcd_3D_stat.tex_color_zero;
+	poly.repeat_tex_x = lcd_3D_stat.repeat_tex_x;
+	poly.repeat_tex_y = lcd_3D_stat.repeat_tex_y;
+	poly.flip_tex_x = lcd_3D_stat.flip_tex_x;
+	poly.flip_tex_y = lcd_3D_stat.flip_tex_y;
+
+	gx_poly_ram.push_back(poly);
+
+	//Store screen coordinates in Vertex RAM
+	for(u8 a = 0; a < vert_count; a++)
+	{
+		ntr_gx_vertex vert;
+
+		vert.x = plot_x[a];
+		vert.y = plot_y[a];
+		vert.z = plot_z[a];
+		vert.w = plot_w[a];
+		vert.tx = plot_tx[a];
+		vert.ty = plot_ty[a];
+		vert.color = vert_colors[a];
+
+		gx_vert_ram.push_back(vert);
+	}
+
+	lcd_3D_stat.render_polygon = false;
+	lcd_3D_stat.clip_flags = 0;
+}
+
+/****** Renders all polygons in Polygon RAM to the 3D screen buffers ******/
+void NTR_LCD::render_geometry()
+{
+	//VRAM may have changed since the last frame, so always decode the first texture
+	gx_tex_loaded = false;
+
+	for(u32 x = 0; x < gx_poly_ram.size(); x++) { rasterize_polygon(gx_poly_ram[x]); }
+
+	gx_poly_ram.clear();
+	gx_vert_ram.clear();
+}
+
+/****** Renders a single polygon to the 3D screen buffers ******/
+void NTR_LCD::rasterize_polygon(ntr_gx_polygon &poly)
+{
+	ntr_gx_vertex* vert = &gx_vert_ram[poly.vert_index];
+	u8 vert_count = poly.vert_count;
+
 	//Reset hi and lo fill coordinates
 	for(int x = 0; x < 256; x++)
 	{
@@ -173,13 +238,13 @@ void NTR_LCD::render_geometry()
 	}
 
 	//Find minimum and maximum X values for polygon
-	float x_min = plot_x[0];
-	float x_max = plot_x[0];
+	float x_min = vert[0].x;
+	float x_max = vert[0].x;
 
 	for(u8 x = 1; x < vert_count; x++)
 	{
-		if(plot_x[x] < x_min) { x_min = plot_x[x]; }
-		if(plot_x[x] > x_max) { x_max = plot_x[x]; }
+		if(vert[x].x < x_min) { x_min = vert[x].x; }
+		if(vert[x].x > x_max) { x_max = vert[x].x; }
 	}
 
 	lcd_3D_stat.poly_min_x = round(x_min);
@@ -197,25 +262,25 @@ void NTR_LCD::render_geometry()
 		u8 next_index = x + 1;
 		if(next_index == vert_count) { next_index = 0; }
 
-		float x_dist = (plot_x[next_index] - plot_x[x]);
-		float y_dist = (plot_y[next_index] - plot_y[x]);
-		float z_dist = (plot_z[next_index] - plot_z[x]);
+		float x_dist = (vert[next_index].x - vert[x].x);
+		float y_dist = (vert[next_index].y - vert[x].y);
+		float z_dist = (vert[next_index].z - vert[x].z);
 
 		float x_inc = 0.0;
 		float y_inc = 0.0;
 		float z_inc = 0.0;
 
-		float x_coord = plot_x[x];
-		float y_coord = plot_y[x];
-		float z_coord = plot_z[x];
-		float w_coord = plot_w[x];
+		float x_coord = vert[x].x;
+		float y_coord = vert[x].y;
+		float z_coord = vert[x].z;
+		float w_coord = vert[x].w;
 
 		s32 xy_start = 0;
 		s32 xy_end = 0;
 		s32 xy_len = 0;
 
-		u32 c1 = vert_colors[x];
-		u32 c2 = vert_colors[next_index];
+		u32 c1 = vert[x].color;
+		u32 c2 = vert[next_index].color;
 		u32 c3 = 0;
 		float c_ratio = 0.0;
 		float c_inc = 0.0;
@@ -223,8 +288,8 @@ void NTR_LCD::render_geometry()
 		float tx_inc = 0.0;
 		float ty_inc = 0.0;
 
-		float tx = plot_tx[x];
-		float ty = plot_ty[x];
+		float tx = vert[x].tx;
+		float ty = vert[x].ty;
 
 		u32 overflow = 0;
 
@@ -242,8 +307,8 @@ void NTR_LCD::render_geometry()
 				if((x_dist < 0) && (x_inc > 0)) { x_inc *= -1.0; }
 				else if((x_dist > 0) && (x_inc < 0)) { x_inc *= -1.0; }
 
-				xy_start = plot_y[x];
-				xy_end = plot_y[next_index];
+				xy_start = vert[x].y;
+				xy_end = vert[next_index].y;
 			}
 
 			//Gentle slope, X = 1
@@ -255,8 +320,8 @@ void NTR_LCD::render_geometry()
 				if((y_dist < 0) && (y_inc > 0)) { y_inc *= -1.0; }
 				else if((y_dist > 0) && (y_inc < 0)) { y_inc *= -1.0; }
 
-				xy_start = plot_x[x];
-				xy_end = plot_x[next_index];
+				xy_start = vert[x].x;
+				xy_end = vert[next_index].x;
 			}
 		}
 
@@ -265,8 +330,8 @@ void NTR_LCD::render_geometry()
 			x_inc = 0.0;
 			y_inc = (y_dist > 0) ? 1.0 : -1.0;
 
-			xy_start = plot_y[x];
-			xy_end = plot_y[next_index];
+			xy_start = vert[x].y;
+			xy_end = vert[next_index].y;
 		}
 
 		else if(y_dist == 0)
@@ -274,19 +339,19 @@ void NTR_LCD::render_geometry()
 			x_inc = (x_dist > 0) ? 1.0 : -1.0;
 			y_inc = 0.0;
 
-			xy_start = plot_x[x];
-			xy_end = plot_x[next_index];
+			xy_start = vert[x].x;
+			xy_end = vert[next_index].x;
 		}
 
 		xy_len = std::abs(xy_end - xy_start);
 
 		if(xy_len != 0)
 		{
-			z_inc = (plot_z[next_index] - plot_z[x]) / xy_len;
+			z_inc = (vert[next_index].z - vert[x].z) / xy_len;
 			c_inc = 1.0 / xy_len;
 
-			tx_inc = (plot_tx[next_index] - plot_tx[x]) / xy_len;
-			ty_inc = (plot_ty[next_index] - plot_ty[x]) / xy_len;
+			tx_inc = (vert[next_index].tx - vert[x].tx) / xy_len;
+			ty_inc = (vert[next_index].ty - vert[x].ty) / xy_len;
 		}
 
 		while(xy_len)
@@ -352,23 +417,23 @@ void NTR_LCD::render_geometry()
 	}
 
 	//Fill in polygon
-	switch(lcd_3D_stat.vertex_mode)
+	switch(poly.vertex_mode)
 	{
 		//Triangles
 		//Triangle Strips
 		case 0x0:
 		case 0x2:
 			//Shadow polygons
-			if(lcd_3D_stat.poly_mode == 3) { }
+			if(poly.poly_mode == 3) { }
 
 			//Textured color fill
-			else if(lcd_3D_stat.use_texture) { fill_poly_textured(); }
+			else if(poly.use_texture) { fill_poly_textured(poly); }
 
 			//Solid color fill
-			else if((vert_colors[0] == vert_colors[1]) && (vert_colors[0] == vert_colors[2])) { fill_poly_solid(); }
+			else if((vert[0].color == vert[1].color) && (vert[0].color == vert[2].color)) { fill_poly_solid(poly); }
 			
 			//Interpolated color fill
-			else { fill_poly_interpolated(); }
+			else { fill_poly_interpolated(poly); }
 
 			break;
 
@@ -377,36 +442,33 @@ void NTR_LCD::render_geometry()
 		case 0x1:
 		case 0x3:
 			//Shadow polygons
-			if(lcd_3D_stat.poly_mode == 3) { }
+			if(poly.poly_mode == 3) { }
 
 			//Textured color fill
-			else if(lcd_3D_stat.use_texture) { fill_poly_textured(); }
+			else if(poly.use_texture) { fill_poly_textured(poly); }
 
 			//Solid color fill
-			else if((vert_colors[0] == vert_colors[1]) && (vert_colors[0] == vert_colors[2]) && (vert_colors[0] == vert_colors[3])) { fill_poly_solid(); }
+			else if((vert[0].color == vert[1].color) && (vert[0].color == vert[2].color) && (vert[0].color == vert[3].color)) { fill_poly_solid(poly); }
 
 			//Interpolated color fill
-			else { fill_poly_interpolated(); }
+			else { fill_poly_interpolated(poly); }
 
 			break;
 	}
-
-	lcd_3D_stat.render_polygon = false;
-	lcd_3D_stat.clip_flags = 0;
 }
 
 /****** NDS 3D Software Renderer - Fills a given poly with a solid color ******/
-void NTR_LCD::fill_poly_solid()
+void NTR_LCD::fill_poly_solid(ntr_gx_polygon &poly)
 {
 	u8 y_coord = 0;
 	u8 buffer_id = (lcd_3D_stat.buffer_id + 1) & 0x1;
 	u32 buffer_index = 0;
 	u32 vert_color = 0;
 
-	bool use_alpha = (lcd_3D_stat.poly_alpha <= 30) ? true : false;
+	bool use_alpha = (poly.poly_alpha <= 30) ? true : false;
 
 	bool use_edge = lcd_3D_stat.edge_marking;
-	u32 edge_color = lcd_3D_stat.edge_color[lcd_3D_stat.poly_id >> 3];
+	u32 edge_color = lcd_3D_stat.edge_color[poly.poly_id >> 3];
 	u8 edge_x1 = lcd_3D_stat.poly_min_x;
 	u8 edge_x2 = lcd_3D_stat.poly_max_x - 1;
 
@@ -436,7 +498,7 @@ void NTR_LCD::fill_poly_solid()
 
 		while(y_coord < lcd_3D_stat.lo_fill[x])
 		{
-			vert_color = vert_colors[0];
+			vert_color = gx_vert_ram[poly.vert_index].color;
 
 			//Convert plot points to buffer index
 			buffer_index = (y_coord * 256) + x;
@@ -445,13 +507,13 @@ void NTR_LCD::fill_poly_solid()
 			if(z_start < gx_z_buffer[buffer_index])
 			{
 				//Do alpha-blending if necessary
-				if(use_alpha) { vert_color = alpha_blend_pixel(vert_color, gx_screen_buffer[buffer_id][buffer_index], lcd_3D_stat.poly_alpha); }
+				if(use_alpha) { vert_color = alpha_blend_pixel(vert_color, gx_screen_buffer[buffer_id][buffer_index], poly.poly_alpha); }
 
 				gx_screen_buffer[buffer_id][buffer_index] = vert_color;
 				gx_render_buffer[buffer_id][buffer_index] = 1;
 
 				//Update Z-buffer if necessary
-				if(lcd_3D_stat.poly_new_depth) { gx_z_buffer[buffer_index] = z_start; }
+				if(poly.poly_new_depth) { gx_z_buffer[buffer_index] = z_start; }
 			}
 
 			y_coord++;
@@ -461,17 +523,17 @@ void NTR_LCD::fill_poly_solid()
 }
 
 /****** NDS 3D Software Renderer - Fills a given poly with interpolated colors from its vertices ******/
-void NTR_LCD::fill_poly_interpolated()
+void NTR_LCD::fill_poly_interpolated(ntr_gx_polygon &poly)
 {
 	u8 y_coord = 0;
 	u8 buffer_id = (lcd_3D_stat.buffer_id + 1) & 0x1;
 	u32 buffer_index = 0;
 	u32 color = 0;
 
-	bool use_alpha = (lcd_3D_stat.poly_alpha <= 30) ? true : false;
+	bool use_alpha = (poly.poly_alpha <= 30) ? true : false;
 
 	bool use_edge = lcd_3D_stat.edge_marking;
-	u32 edge_color = lcd_3D_stat.edge_color[lcd_3D_stat.poly_id >> 3];
+	u32 edge_color = lcd_3D_stat.edge_color[poly.poly_id >> 3];
 
 	for(u32 x = lcd_3D_stat.poly_min_x; x <= lcd_3D_stat.poly_max_x; x++)
 	{
@@ -519,13 +581,13 @@ void NTR_LCD::fill_poly_interpolated()
 				color = interpolate_rgb(c1, c2, c_ratio);
 
 				//Do alpha-blending if necessary
-				if(use_alpha) { color = alpha_blend_pixel(color, gx_screen_buffer[buffer_id][buffer_index], lcd_3D_stat.poly_alpha); }
+				if(use_alpha) { color = alpha_blend_pixel(color, gx_screen_buffer[buffer_id][buffer_index], poly.poly_alpha); }
 
 				gx_screen_buffer[buffer_id][buffer_index] = color;
 				gx_render_buffer[buffer_id][buffer_index] = 1;
 
 				//Update Z-buffer if necessary
-				if(lcd_3D_stat.poly_new_depth) { gx_z_buffer[buffer_index] = z_start; }
+				if(poly.poly_new_depth) { gx_z_buffer[buffer_index] = z_start; }
 			}
 
 			y_coord++;
@@ -536,7 +598,7 @@ void NTR_LCD::fill_poly_interpolated()
 }
 
 /****** NDS 3D Software Renderer - Fills a given poly with color from a texture ******/
-void NTR_LCD::fill_poly_textured()
+void NTR_LCD::fill_poly_textured(ntr_gx_polygon &poly)
 {
 	u8 y_coord = 0;
 	u8 buffer_id = (lcd_3D_stat.buffer_id + 1) & 0x1;
@@ -544,36 +606,54 @@ void NTR_LCD::fill_poly_textured()
 	u32 texel_index = 0;
 	u32 texel = 0;
 
-	u8 slot = (lcd_3D_stat.tex_offset >> 17);
+	u8 slot = (poly.tex_offset >> 17);
 
-	bool use_alpha = (lcd_3D_stat.poly_alpha <= 30) ? true : false;
+	bool use_alpha = (poly.poly_alpha <= 30) ? true : false;
 	bool use_new_z = false;
 	bool texel_depth_test;
 
-	if((use_alpha && lcd_3D_stat.poly_new_depth) || (!use_alpha)) { use_new_z = true; }
-	bool skip_tex_blending = ((lcd_3D_stat.poly_mode == 0) && (!use_alpha) && (lcd_3D_stat.vertex_color == 0xFFFCFCFC));
+	if((use_alpha && poly.poly_new_depth) || (!use_alpha)) { use_new_z = true; }
+	bool skip_tex_blending = ((poly.poly_mode == 0) && (!use_alpha) && (poly.vertex_color == 0xFFFCFCFC));
 
 	bool use_edge = lcd_3D_stat.edge_marking;
-	u32 edge_color = lcd_3D_stat.edge_color[lcd_3D_stat.poly_id >> 3];
+	u32 edge_color = lcd_3D_stat.edge_color[poly.poly_id >> 3];
 
 	//Calculate VRAM address of texture
-	u32 tex_addr = (mem->vram_tex_slot[slot] + (lcd_3D_stat.tex_offset & 0x1FFFF));
+	u32 tex_addr = (mem->vram_tex_slot[slot] + (poly.tex_offset & 0x1FFFF));
+
+	//Check if the previous textured polygon already decoded the same texture
+	bool tex_reuse = (gx_tex_loaded && (gx_tex_addr == tex_addr));
+
+	if(gx_tex_attr.tex_format != poly.tex_format) { tex_reuse = false; }
+	if(gx_tex_attr.tex_offset != poly.tex_offset) { tex_reuse = false; }
+	if(gx_tex_attr.tex_src_width != poly.tex_src_width) { tex_reuse = false; }
+	if(gx_tex_attr.tex_src_height != poly.tex_src_height) { tex_reuse = false; }
+	if(gx_tex_attr.pal_bank_addr != poly.pal_bank_addr) { tex_reuse = false; }
+	if(gx_tex_attr.pal_base != poly.pal_base) { tex_reuse = false; }
+	if(gx_tex_attr.tex_color_zero != poly.tex_color_zero) { tex_reuse = false; }
 
 	//Generate pixel data from VRAM
-	switch(lcd_3D_stat.tex_format)
+	if(!tex_reuse)
 	{
-		case 0x1: gen_tex_1(tex_addr); break;
-		case 0x2: gen_tex_2(tex_addr); break;
-		case 0x3: gen_tex_3(tex_addr); break;
-		case 0x4: gen_tex_4(tex_addr); break;
-		case 0x5: gen_tex_5(tex_addr); break;
-		case 0x6: gen_tex_6(tex_addr); break;
-		case 0x7: gen_tex_7(tex_addr); break;
+		switch(poly.tex_format)
+		{
+			case 0x1: gen_tex_1(tex_addr, poly); break;
+			case 0x2: gen_tex_2(tex_addr, poly); break;
+			case 0x3: gen_tex_3(tex_addr, poly); break;
+			case 0x4: gen_tex_4(tex_addr, poly); break;
+			case 0x5: gen_tex_5(tex_addr, poly); break;
+			case 0x6: gen_tex_6(tex_addr, poly); break;
+			case 0x7: gen_tex_7(tex_addr, poly); break;
+		}
+
+		gx_tex_loaded = true;
+		gx_tex_addr = tex_addr;
+		gx_tex_attr = poly;
 	}
 
 	u32 tex_size = lcd_3D_stat.tex_data.size();
-	u32 tw = lcd_3D_stat.tex_src_width;
-	u32 th = lcd_3D_stat.tex_src_height;
+	u32 tw = poly.tex_src_width;
+	u32 th = poly.tex_src_height;
 
 	for(u32 x = lcd_3D_stat.poly_min_x; x <= lcd_3D_stat.poly_max_x; x++)
 	{
@@ -625,12 +705,12 @@ void NTR_LCD::fill_poly_textured()
 			real_ty = ty1;
 
 			//Wrap horizontally, if necessary
-			if(lcd_3D_stat.repeat_tex_x)
+			if(poly.repeat_tex_x)
 			{
 				u8 x_flip = u32(std::abs(tx1 / tw)) & 0x1;
 
 				//No flipping horizontally
-				if(!lcd_3D_stat.flip_tex_x || !x_flip)
+				if(!poly.flip_tex_x || !x_flip)
 				{
 					if(tx1 < 0) { real_tx = (tx1 + (tw * (std::abs(s32(tx1 / tw)) + 1))); }
 					else if(tx1 >= tw) { real_tx = (tx1 - (tw * (s32(tx1 / tw)))); }
@@ -645,12 +725,12 @@ void NTR_LCD::fill_poly_textured()
 			}
 
 			//Wrap vertically, if necessary
-			if(lcd_3D_stat.repeat_tex_y)
+			if(poly.repeat_tex_y)
 			{
 				u8 y_flip = u32(std::abs(ty1 / th)) & 0x1;
 
 				//No flipping vertically
-				if(!lcd_3D_stat.flip_tex_y || !y_flip)
+				if(!poly.flip_tex_y || !y_flip)
 				{
 					if(ty1 < 0) { real_ty = (ty1 + (th * (std::abs(s32(ty1 / th)) + 1))); }
 					else if(ty1 >= th) { real_ty = (ty1 - (th * s32(ty1 / th))); }
@@ -671,7 +751,7 @@ void NTR_LCD::fill_poly_textured()
 			texel_index = u32(u32(real_ty) * tw) + u32(real_tx);
 
 			//Calculate depth test
-			texel_depth_test = (lcd_3D_stat.poly_depth_test) ? (z_start <= gx_z_buffer[buffer_index]) : (z_start < gx_z_buffer[buffer_index]);
+			texel_depth_test = (poly.poly_depth_test) ? (z_start <= gx_z_buffer[buffer_index]) : (z_start < gx_z_buffer[buffer_index]);
 
 			//Check Z buffer if drawing is applicable
 			//Make sure texel exists as well
@@ -683,12 +763,12 @@ void NTR_LCD::fill_poly_textured()
 				if(texel & 0xFF000000)
 				{
 					//Apply texture blending if necessary
-					if(!skip_tex_blending) { texel = blend_texel(texel); }
+					if(!skip_tex_blending) { texel = blend_texel(texel, poly); }
 
 					//Alpha-blend if necessary
 					if(((texel >> 24) != 0xFF) || (use_alpha))
 					{
-						texel = alpha_blend_texel(texel, gx_screen_buffer[buffer_id][buffer_index]);
+						texel = alpha_blend_texel(texel, gx_screen_buffer[buffer_id][buffer_index], poly.poly_alpha);
 					}
 
 					gx_screen_buffer[buffer_id][buffer_index] = texel;
@@ -1364,8 +1444,8 @@ void NTR_LCD::process_gx_command()
 
 					last_poly = current_poly;
 
-					//Render geometry now if command was sent by GX FIFO
-					if(mem->gx_command) { render_geometry(); }
+					//Store polygon now if command was sent by GX FIFO
+					if(mem->gx_command) { store_polygon(); }
 				}
 			}
 
@@ -1429,8 +1509,8 @@ void NTR_LCD::process_gx_command()
 
 					last_poly = current_poly;
 
-					//Render geometry now if command was sent by GX FIFO
-					if(mem->gx_command) { render_geometry(); }
+					//Store polygon now if command was sent by GX FIFO
+					if(mem->gx_command) { store_polygon(); }
 				}
 			}
 
@@ -1524,8 +1604,8 @@ void NTR_LCD::process_gx_command()
 
 					last_poly = current_poly;
 
-					//Render geometry now if command was sent by GX FIFO
-					if(mem->gx_command) { render_geometry(); }
+					//Store polygon now if command was sent by GX FIFO
+					if(mem->gx_command) { store_polygon(); }
 				}
 			}
 
@@ -1588,8 +1668,8 @@ void NTR_LCD::process_gx_command()
 
 					last_poly = current_poly;
 
-					//Render geometry now if command was sent by GX FIFO
-					if(mem->gx_command) { render_geometry(); }
+					//Store polygon now if command was sent by GX FIFO
+					if(mem->gx_command) { store_polygon(); }
 				}
 			}
 
@@ -1942,6 +2022,75 @@ void NTR_LCD::process_gx_command()
 	mem->gx_command = false;
 }
 
+/****** Processes a list of words from memory - Whole commands are decoded in place, GXFIFO only sees commands split across lists ******/
+void NTR_LCD::process_gx_list(u8* list, u32 count)
+{
+	u32 x = 0;
+
+	//Finish anything GXFIFO is still in the middle of first
+	for(; (x < count) && ((lcd_3D_stat.gx_state & 0x1) || !mem->nds9_gx_fifo.empty()); x++)
+	{
+		u8* word = list + (x * 4);
+		mem->write_gx_fifo((word[3] << 24) | (word[2] << 16) | (word[1] << 8) | word[0]);
+		if(mem->gx_command) { process_gx_command(); }
+	}
+
+	while(x < count)
+	{
+		u8* word = list + (x * 4);
+		u32 entry = (word[3] << 24) | (word[2] << 16) | (word[1] << 8) | word[0];
+
+		//Ignore NOPs
+		if(!entry)
+		{
+			x++;
+			continue;
+		}
+
+		//Packed commands with no parameters still take the next word, same as GXFIFO
+		u32 length = 0;
+		for(u32 packed = entry; packed; packed >>= 8) { length += mem->get_gx_command_length(packed & 0xFF); }
+		if((entry & 0xFFFFFF00) && !length) { length = 1; }
+
+		//Leave commands that run past the end of this list to GXFIFO
+		if((x + 1 + length) > count) { break; }
+
+		u8* param = word + 4;
+
+		for(u32 packed = entry; packed; packed >>= 8)
+		{
+			u8 command = (packed & 0xFF);
+			u32 param_length = mem->get_gx_command_length(command);
+
+			for(u32 y = 0; y < param_length; y++, param += 4)
+			{
+				lcd_3D_stat.command_parameters[(y * 4)] = param[3];
+				lcd_3D_stat.command_parameters[(y * 4) + 1] = param[2];
+				lcd_3D_stat.command_parameters[(y * 4) + 2] = param[1];
+				lcd_3D_stat.command_parameters[(y * 4) + 3] = param[0];
+			}
+
+			//Clear GX_STAT Geometry Engine busy flag, set FIFO less than half full flag
+			lcd_3D_stat.gx_stat &= ~0x8000000;
+			lcd_3D_stat.gx_stat |= 0x2000000;
+
+			lcd_3D_stat.current_gx_command = command;
+			mem->gx_command = true;
+			process_gx_command();
+		}
+
+		x += (1 + length);
+	}
+
+	//Start any command that continues in the next list
+	for(; x < count; x++)
+	{
+		u8* word = list + (x * 4);
+		mem->write_gx_fifo((word[3] << 24) | (word[2] << 16) | (word[1] << 8) | word[0]);
+		if(mem->gx_command) { process_gx_command(); }
+	}
+}
+
 /****** Reads GX command parameters as a 32-bit value *****/
 u32 NTR_LCD::read_param_u32(u8 i)
 {
@@ -2018,12 +2167,9 @@ u32 NTR_LCD::alpha_blend_pixel(u32 color_1, u32 color_2, u8 poly_alpha)
 }
 
 /****** Alpha blends given texel with 3D framebuffer ******/
-u32 NTR_LCD::alpha_blend_texel(u32 color_1, u32 color_2)
+u32 NTR_LCD::alpha_blend_texel(u32 color_1, u32 color_2, u8 poly_alpha)
 {
-	u8 poly_alpha = 0;
-
 	if((color_1 >> 24) != 0xFF) { poly_alpha = (color_1 >> 24); }
-	else { poly_alpha = lcd_3D_stat.poly_alpha; }
 
 	if(poly_alpha == 0) { return color_2; }
 
@@ -2046,7 +2192,7 @@ u32 NTR_LCD::alpha_blend_texel(u32 color_1, u32 color_2)
 }
 
 /****** Blends texel via modulation, decal mode, toon shading, or highlight shading ******/
-u32 NTR_LCD::blend_texel(u32 color_1)
+u32 NTR_LCD::blend_texel(u32 color_1, ntr_gx_polygon &poly)
 {
 	u16 poly_r = (color_1 >> 18) & 0x3F;
 	u16 poly_g = (color_1 >> 10) & 0x3F;
@@ -2054,7 +2200,7 @@ u32 NTR_LCD::blend_texel(u32 color_1)
 	u16 poly_a = 0;
 
 	if((color_1 >> 24) != 0xFF) { poly_a = (color_1 >> 24); }
-	else { poly_a = lcd_3D_stat.poly_alpha; }
+	else { poly_a = poly.poly_alpha; }
 
 	poly_a = (poly_a == 31) ? 63 : (poly_a << 1);
 
@@ -2071,14 +2217,14 @@ u32 NTR_LCD::blend_texel(u32 color_1)
 
 	u32 final_color = color_1;
 
-	switch(lcd_3D_stat.poly_mode & 0x3)
+	switch(poly.poly_mode & 0x3)
 	{
 		//Modulation
 		case 0:
-			blend_r = (lcd_3D_stat.vertex_color >> 18) & 0x3F;
-			blend_g = (lcd_3D_stat.vertex_color >> 10) & 0x3F;
-			blend_b = (lcd_3D_stat.vertex_color >> 2) & 0x3F;
-			blend_a = (lcd_3D_stat.poly_alpha == 31) ? 63 : (lcd_3D_stat.poly_alpha << 1);
+			blend_r = (poly.vertex_color >> 18) & 0x3F;
+			blend_g = (poly.vertex_color >> 10) & 0x3F;
+			blend_b = (poly.vertex_color >> 2) & 0x3F;
+			blend_a = (poly.poly_alpha == 31) ? 63 : (poly.poly_alpha << 1);
 
 			frame_r = modulation_lut[(poly_r << 6) | blend_r];
 			frame_g = modulation_lut[(poly_g << 6) | blend_g];
@@ -2100,10 +2246,10 @@ u32 NTR_LCD::blend_texel(u32 color_1)
 
 		//Decal Mode
 		case 1:
-			blend_r = (lcd_3D_stat.vertex_color >> 18) & 0x3F;
-			blend_g = (lcd_3D_stat.vertex_color >> 10) & 0x3F;
-			blend_b = (lcd_3D_stat.vertex_color >> 2) & 0x3F;
-			blend_a = lcd_3D_stat.poly_alpha;
+			blend_r = (poly.vertex_color >> 18) & 0x3F;
+			blend_g = (poly.vertex_color >> 10) & 0x3F;
+			blend_b = (poly.vertex_color >> 2) & 0x3F;
+			blend_a = poly.poly_alpha;
 
 			if(poly_a == 0)
 			{
@@ -2139,14 +2285,14 @@ u32 NTR_LCD::blend_texel(u32 color_1)
 }
 
 /****** Generates pixel data fram VRAM for A315 textures ******/
-void NTR_LCD::gen_tex_1(u32 address)
+void NTR_LCD::gen_tex_1(u32 address, ntr_gx_polygon &poly)
 {
 	lcd_3D_stat.tex_data.clear();
-	u32 tex_size = (lcd_3D_stat.tex_src_width * lcd_3D_stat.tex_src_height);
+	u32 tex_size = (poly.tex_src_width * poly.tex_src_height);
 	u32 color = 0;
 
 	//Generate temporary palette
-	u32 pal_addr = lcd_3D_stat.pal_bank_addr + (lcd_3D_stat.pal_base * 0x10);
+	u32 pal_addr = poly.pal_bank_addr + (poly.pal_base * 0x10);
 	u32 tex_pal[32];
 
 	for(u32 x = 0; x < 32; x++)
@@ -2160,7 +2306,7 @@ void NTR_LCD::gen_tex_1(u32 address)
 
 	while(tex_size)
 	{
-		u8 index = mem->memory_map[address++];
+		u8 index = mem->memory_map.read(address++);
 		color = (tex_pal[index & 0x1F] & ~0xFF000000);
 		index >>= 5;
 
@@ -2174,13 +2320,13 @@ void NTR_LCD::gen_tex_1(u32 address)
 }
 
 /****** Generates pixel data from VRAM for 4 color textures ******/
-void NTR_LCD::gen_tex_2(u32 address)
+void NTR_LCD::gen_tex_2(u32 address, ntr_gx_polygon &poly)
 {
 	lcd_3D_stat.tex_data.clear();
-	u32 tex_size = (lcd_3D_stat.tex_src_width * lcd_3D_stat.tex_src_height);
+	u32 tex_size = (poly.tex_src_width * poly.tex_src_height);
 
 	//Generate temporary palette
-	u32 pal_addr = lcd_3D_stat.pal_bank_addr + (lcd_3D_stat.pal_base * 0x8);
+	u32 pal_addr = poly.pal_bank_addr + (poly.pal_base * 0x8);
 	u32 tex_pal[4];
 
 	for(u32 x = 0; x < 4; x++)
@@ -2190,11 +2336,11 @@ void NTR_LCD::gen_tex_2(u32 address)
 	}
 
 	//First palette color is used for transparency
-	if(lcd_3D_stat.tex_color_zero) { tex_pal[0] &= ~0xFF000000; }
+	if(poly.tex_color_zero) { tex_pal[0] &= ~0xFF000000; }
 
 	while(tex_size)
 	{
-		u8 index = mem->memory_map[address++];
+		u8 index = mem->memory_map.read(address++);
 		lcd_3D_stat.tex_data.push_back(tex_pal[index & 0x3]);
 		lcd_3D_stat.tex_data.push_back(tex_pal[(index >> 2) & 0x3]);
 		lcd_3D_stat.tex_data.push_back(tex_pal[(index >> 4) & 0x3]);
@@ -2204,13 +2350,13 @@ void NTR_LCD::gen_tex_2(u32 address)
 }
 
 /****** Generates pixel data from VRAM for 16 color textures ******/
-void NTR_LCD::gen_tex_3(u32 address)
+void NTR_LCD::gen_tex_3(u32 address, ntr_gx_polygon &poly)
 {
 	lcd_3D_stat.tex_data.clear();
-	u32 tex_size = (lcd_3D_stat.tex_src_width * lcd_3D_stat.tex_src_height);
+	u32 tex_size = (poly.tex_src_width * poly.tex_src_height);
 
 	//Generate temporary palette
-	u32 pal_addr = lcd_3D_stat.pal_bank_addr + (lcd_3D_stat.pal_base * 0x10);
+	u32 pal_addr = poly.pal_bank_addr + (poly.pal_base * 0x10);
 	u32 tex_pal[16];
 
 	for(u32 x = 0; x < 16; x++)
@@ -2220,11 +2366,11 @@ void NTR_LCD::gen_tex_3(u32 address)
 	}
 
 	//First palette color is used for transparency
-	if(lcd_3D_stat.tex_color_zero) { tex_pal[0] &= ~0xFF000000; }
+	if(poly.tex_color_zero) { tex_pal[0] &= ~0xFF000000; }
 
 	while(tex_size)
 	{
-		u8 index = mem->memory_map[address++];
+		u8 index = mem->memory_map.read(address++);
 		lcd_3D_stat.tex_data.push_back(tex_pal[index & 0xF]);
 		lcd_3D_stat.tex_data.push_back(tex_pal[index >> 4]);
 		tex_size -= 2;
@@ -2232,13 +2378,13 @@ void NTR_LCD::gen_tex_3(u32 address)
 }
 
 /****** Generates pixel data from VRAM for 256 color textures ******/
-void NTR_LCD::gen_tex_4(u32 address)
+void NTR_LCD::gen_tex_4(u32 address, ntr_gx_polygon &poly)
 {
 	lcd_3D_stat.tex_data.clear();
-	u32 tex_size = (lcd_3D_stat.tex_src_width * lcd_3D_stat.tex_src_height);
+	u32 tex_size = (poly.tex_src_width * poly.tex_src_height);
 
 	//Generate temporary palette
-	u32 pal_addr = lcd_3D_stat.pal_bank_addr + (lcd_3D_stat.pal_base * 0x10);
+	u32 pal_addr = poly.pal_bank_addr + (poly.pal_base * 0x10);
 	u32 tex_pal[256];
 
 	for(u32 x = 0; x < 256; x++)
@@ -2248,34 +2394,34 @@ void NTR_LCD::gen_tex_4(u32 address)
 	}
 
 	//First palette color is used for transparency
-	if(lcd_3D_stat.tex_color_zero) { tex_pal[0] &= ~0xFF000000; }
+	if(poly.tex_color_zero) { tex_pal[0] &= ~0xFF000000; }
 
 	while(tex_size)
 	{
-		u8 index = mem->memory_map[address++];
+		u8 index = mem->memory_map.read(address++);
 		lcd_3D_stat.tex_data.push_back(tex_pal[index]);
 		tex_size--;
 	}
 }
 
 /****** Generates pixel data from VRAM for 4x4 texel compressed textures ******/
-void NTR_LCD::gen_tex_5(u32 address)
+void NTR_LCD::gen_tex_5(u32 address, ntr_gx_polygon &poly)
 {
-	u8 slot = (lcd_3D_stat.tex_offset >> 17);
-	u32 tex_size = (lcd_3D_stat.tex_src_width * lcd_3D_stat.tex_src_height);
+	u8 slot = (poly.tex_offset >> 17);
+	u32 tex_size = (poly.tex_src_width * poly.tex_src_height);
 	lcd_3D_stat.tex_data.clear();
 	lcd_3D_stat.tex_data.resize(tex_size, 0x00);
 
 	u32 color = 0;
-	u32 slot_addr = mem->vram_tex_slot[1] + ((lcd_3D_stat.tex_offset & 0x1FFFF) >> 1);
+	u32 slot_addr = mem->vram_tex_slot[1] + ((poly.tex_offset & 0x1FFFF) >> 1);
 	u32 pal_addr = 0;
 	u8 pal_mode = 0;
 
 	u32 texel_data = 0;
 	u32 texel_index = 0;
 	u32 texel_block = 0;
-	u32 block_width = lcd_3D_stat.tex_src_width >> 2;
-	u32 block_height = lcd_3D_stat.tex_src_height >> 2;
+	u32 block_width = poly.tex_src_width >> 2;
+	u32 block_height = poly.tex_src_height >> 2;
 	u32 tex_pal[4];	
 	u8 texel_row = 0;
 
@@ -2288,10 +2434,10 @@ void NTR_LCD::gen_tex_5(u32 address)
 		//Calculate buffer position for texels
 		u32 index_x = (texel_block % block_width) << 2;
 		u32 index_y = (texel_block / block_width) << 2;
-		texel_index = (index_y * lcd_3D_stat.tex_src_width) + index_x;
+		texel_index = (index_y * poly.tex_src_width) + index_x;
 
 		//Grab palette data for 4x4 block
-		u32 pal_addr = lcd_3D_stat.pal_bank_addr + ((mem->read_u16_fast(slot_addr) & 0x3FFF) << 2) + (lcd_3D_stat.pal_base * 0x10);
+		u32 pal_addr = poly.pal_bank_addr + ((mem->read_u16_fast(slot_addr) & 0x3FFF) << 2) + (poly.pal_base * 0x10);
 
 		//Grab palette mode for 4x4 block
 		pal_mode = (mem->read_u16_fast(slot_addr) >> 14);
@@ -2338,7 +2484,7 @@ void NTR_LCD::gen_tex_5(u32 address)
 			}
 
 			texel_data >>= 8;
-			texel_index += lcd_3D_stat.tex_src_width;
+			texel_index += poly.tex_src_width;
 		}
 
 		address += 4;
@@ -2348,14 +2494,14 @@ void NTR_LCD::gen_tex_5(u32 address)
 }
 
 /****** Generates pixel data from VRAM for A513 textures ******/
-void NTR_LCD::gen_tex_6(u32 address)
+void NTR_LCD::gen_tex_6(u32 address, ntr_gx_polygon &poly)
 {
 	lcd_3D_stat.tex_data.clear();
-	u32 tex_size = (lcd_3D_stat.tex_src_width * lcd_3D_stat.tex_src_height);
+	u32 tex_size = (poly.tex_src_width * poly.tex_src_height);
 	u32 color = 0;
 
 	//Generate temporary palette
-	u32 pal_addr = lcd_3D_stat.pal_bank_addr + (lcd_3D_stat.pal_base * 0x10);
+	u32 pal_addr = poly.pal_bank_addr + (poly.pal_base * 0x10);
 	u32 tex_pal[8];
 
 	for(u32 x = 0; x < 8; x++)
@@ -2369,7 +2515,7 @@ void NTR_LCD::gen_tex_6(u32 address)
 
 	while(tex_size)
 	{
-		u8 index = mem->memory_map[address++];
+		u8 index = mem->memory_map.read(address++);
 		color = (tex_pal[index & 0x7] & ~0xFF000000);
 		index >>= 3;
 
@@ -2383,10 +2529,10 @@ void NTR_LCD::gen_tex_6(u32 address)
 }
 
 /****** Generates pixel data from VRAM for Direct Color textures ******/
-void NTR_LCD::gen_tex_7(u32 address)
+void NTR_LCD::gen_tex_7(u32 address, ntr_gx_polygon &poly)
 {
 	lcd_3D_stat.tex_data.clear();
-	u32 tex_size = (lcd_3D_stat.tex_src_width * lcd_3D_stat.tex_src_height);
+	u32 tex_size = (poly.tex_src_width * poly.tex_src_height);
 
 	while(tex_size)
 	{
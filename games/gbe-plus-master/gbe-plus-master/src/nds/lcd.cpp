@@ -10,9 +10,12 @@
 // Responsible for blitting pixel data and limiting frame rate
 
 #include <cmath>
+#include <cstring>
+#include <chrono>
 
 #include "lcd.h"
 #include "common/util.h"
+#include "common/sfx_util.h"
 
 /****** LCD Constructor ******/
 NTR_LCD::NTR_LCD()
@@ -24,6 +27,8 @@ NTR_LCD::NTR_LCD()
 /****** LCD Destructor ******/
 NTR_LCD::~NTR_LCD()
 {
+	stop_engine_b_thread();
+
 	screen_buffer.clear();
 
 	scanline_buffer_a.clear();
@@ -75,7 +80,6 @@ void NTR_LCD::reset()
 	}
 
 	lcd_stat.current_scanline = 0;
-	scanline_pixel_counter = 0;
 
 	lcd_stat.lyc_nds9 = 0;
 	lcd_stat.lyc_nds7 = 0;
@@ -96,15 +100,23 @@ void NTR_LCD::reset()
 	gx_render_buffer[1].resize(0xC000, 0);
 	gx_z_buffer.resize(0xC000, 4096);
 
-	line_buffer.resize(8);
-	for(u32 x = 0; x < 8; x++) { line_buffer[x].resize(0x100); }
+	for(u32 engine_id = 0; engine_id < 2; engine_id++)
+	{
+		engine_line[engine_id].line_buffer.resize(8);
+		for(u32 x = 0; x < 8; x++) { engine_line[engine_id].line_buffer[x].resize(0x100); }
 
-	obj_line_buffer.resize(8);
-	for(u32 x = 0; x < 8; x++) { obj_line_buffer[x].resize(0x100); }
+		engine_line[engine_id].obj_line_buffer.resize(8);
+		for(u32 x = 0; x < 8; x++) { engine_line[engine_id].obj_line_buffer[x].resize(0x100); }
+	}
 
 	full_scanline_render_a = false;
 	full_scanline_render_b = false;
 
+	//Engine B render thread setup - Only worth it with more than one host core
+	stop_engine_b_thread();
+	engine_b_state.store(ENGINE_B_IDLE);
+	threaded_2d = (config::nds_threaded_2d) && (std::thread::hardware_concurrency() > 1);
+
 	//BG palette initialization
 	lcd_stat.bg_pal_update_a = true;
 	lcd_stat.bg_pal_update_list_a.resize(0x100, true);
@@ -139,6 +151,10 @@ void NTR_LCD::reset()
 	lcd_stat.oam_update = true;
 	lcd_stat.oam_update_list.resize(0x100, true);
 
+	//Tile cache initialization - One decoded 4bpp tile for every 32 bytes of the VRAM banks
+	tile_cache.resize(0x148000, 0);
+	lcd_stat.vram_tile_update_list.assign(0x5200, true);
+
 	lcd_stat.update_bg_control_a = false;
 	lcd_stat.update_bg_control_b = false;
 
@@ -383,6 +399,14 @@ void NTR_LCD::reset()
 	current_poly.make_identity(4);
 	last_poly.make_identity(4);
 
+	//Polygon and Vertex RAM
+	gx_poly_ram.clear();
+	gx_poly_ram.reserve(2048);
+	gx_vert_ram.clear();
+	gx_vert_ram.reserve(6144);
+	gx_tex_loaded = false;
+	gx_tex_addr = 0;
+
 	//GX Matrices
 	gx_projection_matrix.resize(4, 4);
 	gx_position_matrix.resize(4, 4);
@@ -959,13 +983,13 @@ void NTR_LCD::update_palettes()
 /****** Render the line for a BG ******/
 void NTR_LCD::render_bg_scanline(u32 bg_control)
 {
+	//Grab line buffers for Engine A or B
+	ntr_engine_line& engine = engine_line[(bg_control & 0x1000) ? 1 : 0];
+
 	u8 bg_mode = (bg_control & 0x1000) ? lcd_stat.bg_mode_b : lcd_stat.bg_mode_a;
 	u8 bg_render_list[4];
 	u8 bg_id = 0;
 
-	//Calculate window status for Engine A and Engine B for current scanline
-	calculate_window_on_scanline();
-
 	//Render Engine A
 	if((bg_control & 0x1000) == 0)
 	{
@@ -976,8 +1000,8 @@ void NTR_LCD::render_bg_scanline(u32 bg_control)
 		//Reset line buffers
 		for(u32 x = 0; x < 8; x++)
 		{
-			line_buffer[x].assign(0x100, 0x00);
-			obj_line_buffer[x].assign(0x100, 0x00);
+			engine.line_buffer[x].assign(0x100, 0x00);
+			engine.obj_line_buffer[x].assign(0x100, 0x00);
 		}
 
 		//Clear scanline with backdrop
@@ -1159,8 +1183,8 @@ void NTR_LCD::render_bg_scanline(u32 bg_control)
 		//Reset line buffers
 		for(u32 x = 0; x < 8; x++)
 		{
-			line_buffer[x].assign(0x100, 0x00);
-			obj_line_buffer[x].assign(0x100, 0x00);
+			engine.line_buffer[x].assign(0x100, 0x00);
+			engine.obj_line_buffer[x].assign(0x100, 0x00);
 		}
 
 		//Clear scanline with backdrop
@@ -1325,6 +1349,7 @@ void NTR_LCD::render_obj_scanline(u32 bg_control)
 {
 	//Detemine if Engine A or B
 	u8 engine_id = (bg_control & 0x1000) ? 1 : 0;
+	ntr_engine_line& engine = engine_line[engine_id];
 
 	//Abort if no OBJs are rendered on this line
 	if(!engine_id && !obj_render_length_a) { return; }
@@ -1392,7 +1417,6 @@ void NTR_LCD::render_obj_scanline(u32 bg_control)
 
 			u8 meta_width = obj[obj_id].width / 8;
 			u8 bit_depth = obj[obj_id].bit_depth * 8;
-			u8 pixel_shift = (bit_depth == 32) ? 1 : 0;
 			u16 draw_width = (obj[obj_id].affine_enable && obj[obj_id].type) ? (obj[obj_id].width * 2) : obj[obj_id].width;
 
 			u8 bitmap_mask_a = (lcd_stat.display_control_a & 0x20) ? 0x1F : 0xF;
@@ -1481,27 +1505,26 @@ void NTR_LCD::render_obj_scanline(u32 bg_control)
 						if(disp_cnt & 0x10)
 						{
 							obj_addr += (((meta_y * meta_width) + meta_x) * bit_depth);
-							obj_addr += (((obj_y % 8) * 8) + (obj_x % 8)) >> pixel_shift;
 						}
 
 						//2D addressing
 						else
 						{
 							obj_addr = base + ((obj[obj_id].tile_number + meta_x + (meta_y << 5)) << 5);
-							obj_addr += (((obj_y % 8) * 8) + (obj_x % 8)) >> pixel_shift; 
 						}
 
-						raw_color = mem->memory_map[obj_addr];
+						u8 tile_pixel = ((obj_y % 8) * 8) + (obj_x % 8);
 
-						//Process 4-bit depth if necessary
-						if((bit_depth == 32) && (!ext_pal)) { raw_color = (obj_x & 0x1) ? (raw_color >> 4) : (raw_color & 0xF); }
+						//Grab dot-data - 4-bit tiles come from the decoded tile cache
+						if(bit_depth == 32) { raw_color = get_decoded_tile(obj_addr, engine.tile_scratch)[tile_pixel]; }
+						else { raw_color = mem->memory_map.read(obj_addr + tile_pixel); }
 
 						//Draw for Engine A
 						if(!engine_id && raw_color && !render_buffer_a[scanline_pixel_counter] && render_obj)
 						{
 							scanline_buffer_a[scanline_pixel_counter] = (ext_pal) ? lcd_stat.obj_ext_pal_a[pal_id + raw_color] : lcd_stat.obj_pal_a[pal_id + raw_color];
 							render_buffer_a[scanline_pixel_counter] = (obj[obj_id].bg_priority + 1);
-							obj_line_buffer[obj[obj_id].bg_priority][scanline_pixel_counter] = scanline_buffer_a[scanline_pixel_counter];
+							engine.obj_line_buffer[obj[obj_id].bg_priority][scanline_pixel_counter] = scanline_buffer_a[scanline_pixel_counter];
 						}
 
 						//Draw for Engine B
@@ -1509,15 +1532,15 @@ void NTR_LCD::render_obj_scanline(u32 bg_control)
 						{
 							scanline_buffer_b[scanline_pixel_counter] = (ext_pal) ? lcd_stat.obj_ext_pal_b[pal_id + raw_color] : lcd_stat.obj_pal_b[pal_id + raw_color];
 							render_buffer_b[scanline_pixel_counter] = (obj[obj_id].bg_priority + 1);
-							obj_line_buffer[obj[obj_id].bg_priority][scanline_pixel_counter] = scanline_buffer_b[scanline_pixel_counter];
+							engine.obj_line_buffer[obj[obj_id].bg_priority][scanline_pixel_counter] = scanline_buffer_b[scanline_pixel_counter];
 						}
 
 						//Line buffer
 						if(raw_color && render_obj)
 						{
-							obj_line_buffer[obj[obj_id].bg_priority + 4][scanline_pixel_counter] |= 0x80;
-							if(obj[obj_id].mode == 1) { obj_line_buffer[obj[obj_id].bg_priority + 4][scanline_pixel_counter] |= 0x40; }
-							else { obj_line_buffer[obj[obj_id].bg_priority + 4][scanline_pixel_counter] |= 0x20; }
+							engine.obj_line_buffer[obj[obj_id].bg_priority + 4][scanline_pixel_counter] |= 0x80;
+							if(obj[obj_id].mode == 1) { engine.obj_line_buffer[obj[obj_id].bg_priority + 4][scanline_pixel_counter] |= 0x40; }
+							else { engine.obj_line_buffer[obj[obj_id].bg_priority + 4][scanline_pixel_counter] |= 0x20; }
 						}
 					}
 
@@ -1552,7 +1575,7 @@ void NTR_LCD::render_obj_scanline(u32 bg_control)
 						{
 							scanline_buffer_a[scanline_pixel_counter] = get_rgb15(raw_pixel);
 							render_buffer_a[scanline_pixel_counter] = (obj[obj_id].bg_priority + 1);
-							obj_line_buffer[obj[obj_id].bg_priority][scanline_pixel_counter] = scanline_buffer_a[scanline_pixel_counter];
+							engine.obj_line_buffer[obj[obj_id].bg_priority][scanline_pixel_counter] = scanline_buffer_a[scanline_pixel_counter];
 						}
 
 						//Draw for Engine B
@@ -1560,15 +1583,15 @@ void NTR_LCD::render_obj_scanline(u32 bg_control)
 						{
 							scanline_buffer_b[scanline_pixel_counter] = get_rgb15(raw_pixel);
 							render_buffer_b[scanline_pixel_counter] = (obj[obj_id].bg_priority + 1);
-							obj_line_buffer[obj[obj_id].bg_priority][scanline_pixel_counter] = scanline_buffer_b[scanline_pixel_counter];
+							engine.obj_line_buffer[obj[obj_id].bg_priority][scanline_pixel_counter] = scanline_buffer_b[scanline_pixel_counter];
 						}
 
 						//Line buffer
 						if(raw_color && render_obj)
 						{
-							obj_line_buffer[obj[obj_id].bg_priority + 4][scanline_pixel_counter] |= 0x80;
-							if(obj[obj_id].mode == 1) { obj_line_buffer[obj[obj_id].bg_priority + 4][scanline_pixel_counter] |= 0x40; }
-							else { obj_line_buffer[obj[obj_id].bg_priority + 4][scanline_pixel_counter] |= 0x20; }
+							engine.obj_line_buffer[obj[obj_id].bg_priority + 4][scanline_pixel_counter] |= 0x80;
+							if(obj[obj_id].mode == 1) { engine.obj_line_buffer[obj[obj_id].bg_priority + 4][scanline_pixel_counter] |= 0x40; }
+							else { engine.obj_line_buffer[obj[obj_id].bg_priority + 4][scanline_pixel_counter] |= 0x20; }
 						}
 					}
 						
@@ -1583,9 +1606,51 @@ void NTR_LCD::render_obj_scanline(u32 bg_control)
 	}
 }			
 
+/****** Returns the palette indices of a 4bpp tile, decoding it again only if VRAM changed since last time ******/
+u8* NTR_LCD::get_decoded_tile(u32 tile_addr, u8* scratch)
+{
+	tile_addr &= ~0x1F;
+
+	//Tiles outside of the VRAM banks are never cached
+	u8* tile = scratch;
+	u32 offset = mem->memory_map.get_vram_offset(tile_addr);
+
+	if(offset != 0xFFFFFFFF)
+	{
+		u32 tile_id = (offset >> 5);
+		tile = &tile_cache[tile_id << 6];
+
+		if(!lcd_stat.vram_tile_update_list[tile_id]) { return tile; }
+		lcd_stat.vram_tile_update_list[tile_id] = false;
+	}
+
+	//Each byte holds 2 pixels, low nibble first
+	for(u32 x = 0; x < 32; x++)
+	{
+		u8 data = mem->memory_map.read(tile_addr + x);
+		tile[x << 1] = (data & 0xF);
+		tile[(x << 1) + 1] = (data >> 4);
+	}
+
+	return tile;
+}
+
+/****** Returns one line of an 8-bit tile straight from VRAM - Unmapped memory reads as zero ******/
+u8* NTR_LCD::get_tile_row(u32 row_addr, u8* scratch)
+{
+	u8* page = mem->memory_map.get_page(row_addr);
+	if(page != NULL) { return page + (row_addr & 0x3FFF); }
+
+	std::fill(scratch, scratch + 8, 0);
+	return scratch;
+}
+
 /****** Render BG Mode Text scanline ******/
 void NTR_LCD::render_bg_mode_text(u32 bg_control)
 {
+	//Grab line buffers for Engine A or B
+	ntr_engine_line& engine = engine_line[(bg_control & 0x1000) ? 1 : 0];
+
 	//Render Engine A
 	if((bg_control & 0x1000) == 0)
 	{
@@ -1640,7 +1705,6 @@ void NTR_LCD::render_bg_mode_text(u32 bg_control)
 
 		//Grab BG bit-depth and offset for the current tile line
 		u8 bit_depth = lcd_stat.bg_depth_a[bg_id] ? 64 : 32;
-		u8 line_offset;
 
 		//Get tile and map addresses
 		u32 tile_addr = 0x6000000 + lcd_stat.bg_base_tile_addr_a[bg_id];
@@ -1700,96 +1764,44 @@ void NTR_LCD::render_bg_mode_text(u32 bg_control)
 			flip = (map_data >> 10) & 0x3;
 			pal_id <<= 4;
 
-			//Calculate VRAM address to start pulling up tile data
-			line_offset = (flip & 0x2) ? ((bit_depth >> 3) * inv_lut[current_tile_line]) : ((bit_depth >> 3) * current_tile_line);
-			u32 tile_data_addr = tile_addr + (tile_id * bit_depth) + line_offset;
-			if(flip & 0x1) { tile_data_addr += ((bit_depth >> 3) - 1); }
-
-			//Read 8 pixels from VRAM and put them in the scanline buffer
-			for(u32 y = tile_offset_x; y < 8; y++, x++)
-			{
-				//Process 8-bit depth
-				if(bit_depth == 64)
-				{
-					//Grab dot-data, account for horizontal flipping 
-					u8 raw_color = (flip & 0x1) ? mem->memory_map[tile_data_addr--] : mem->memory_map[tile_data_addr++];
+			//Grab palette indices for this tile line, account for vertical flipping
+			//4-bit tiles come from the decoded tile cache, 8-bit tiles already hold one index per byte
+			u8 tile_line = (flip & 0x2) ? inv_lut[current_tile_line] : current_tile_line;
+			u8* tile_row = (bit_depth == 64) ? get_tile_row(tile_addr + (tile_id * 64) + (tile_line * 8), engine.tile_scratch) : (get_decoded_tile(tile_addr + (tile_id * 32), engine.tile_scratch) + (tile_line * 8));
 
-					//Only draw if no previous pixel was rendered
-					if(!render_buffer_a[scanline_pixel_counter] || (bg_priority < render_buffer_a[scanline_pixel_counter]))
-					{
-						//Only draw colors if not transparent
-						if(raw_color && window_draw[scanline_pixel_counter])
-						{
-							scanline_buffer_a[scanline_pixel_counter] = (lcd_stat.ext_pal_a & 0x1) ? lcd_stat.bg_ext_pal_a[ext_pal_id + raw_color]  : lcd_stat.bg_pal_a[raw_color];
-							render_buffer_a[scanline_pixel_counter] = bg_priority;
-						}
-
-						else { full_render = false; }
-					}
+			//Only the pixels left in the first tile are drawn, 4-bit tiles draw them in pairs
+			u8 tile_pixels = (bit_depth == 64) ? (8 - tile_offset_x) : ((9 - tile_offset_x) & ~0x1);
 
-					//Line buffer
-					line_buffer[bg_id][scanline_pixel_counter] = (lcd_stat.ext_pal_a & 0x1) ? lcd_stat.bg_ext_pal_a[ext_pal_id + raw_color]  : lcd_stat.bg_pal_a[raw_color];
-					if(raw_color && window_draw[scanline_pixel_counter] && enable) { line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
+			//Read pixels from the tile line and put them in the scanline buffer
+			for(u32 y = 0; y < tile_pixels; y++, x++)
+			{
+				//Grab dot-data, account for horizontal flipping
+				u8 raw_color = tile_row[(flip & 0x1) ? (7 - y) : y];
+				u32 color;
 
-					//Draw 256 pixels max
-					scanline_pixel_counter++;
-					current_screen_pixel++;
-					if(scanline_pixel_counter & 0x100) { return; }
-				}
+				if(bit_depth == 64) { color = (lcd_stat.ext_pal_a & 0x1) ? lcd_stat.bg_ext_pal_a[ext_pal_id + raw_color] : lcd_stat.bg_pal_a[raw_color]; }
+				else { color = lcd_stat.bg_pal_a[pal_id + raw_color]; }
 
-				//Process 4-bit depth
-				else
+				//Only draw if no previous pixel was rendered
+				if(!render_buffer_a[scanline_pixel_counter] || (bg_priority < render_buffer_a[scanline_pixel_counter]))
 				{
-					//Grab dot-data, account for horizontal flipping 
-					u8 raw_color = (flip & 0x1) ? mem->memory_map[tile_data_addr--] : mem->memory_map[tile_data_addr++];
-
-					u8 pal_1 = (flip & 0x1) ? (pal_id + (raw_color >> 4)) : (pal_id + (raw_color & 0xF));
-					u8 pal_2 = (flip & 0x1) ? (pal_id + (raw_color & 0xF)) : (pal_id + (raw_color >> 4));
-
-					//Only draw if no previous pixel was rendered
-					if(!render_buffer_a[scanline_pixel_counter] || (bg_priority < render_buffer_a[scanline_pixel_counter]))
+					//Only draw colors if not transparent
+					if(raw_color && window_draw[scanline_pixel_counter])
 					{
-						//Only draw colors if not transparent
-						if((raw_color & 0xF) && (window_draw[scanline_pixel_counter]))
-						{
-							scanline_buffer_a[scanline_pixel_counter] = lcd_stat.bg_pal_a[pal_1];
-							render_buffer_a[scanline_pixel_counter] = bg_priority;
-						}
-
-						else { full_render = false; }
-					}
-
-					//Line buffer
-					line_buffer[bg_id][scanline_pixel_counter] = lcd_stat.bg_pal_a[pal_1];
-					if((raw_color & 0xF) && (window_draw[scanline_pixel_counter]) && (enable)) { line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
-
-					//Draw 256 pixels max
-					if(++scanline_pixel_counter & 0x100) { return; }
-
-					//Only draw if no previous pixel was rendered
-					if(!render_buffer_a[scanline_pixel_counter] || (bg_priority < render_buffer_a[scanline_pixel_counter]))
-					{
-						//Only draw colors if not transparent
-						if((raw_color >> 4) && (window_draw[scanline_pixel_counter]))
-						{
-							scanline_buffer_a[scanline_pixel_counter] = lcd_stat.bg_pal_a[pal_2];
-							render_buffer_a[scanline_pixel_counter] = bg_priority;
-
-						}
-
-						else { full_render = false; }
+						scanline_buffer_a[scanline_pixel_counter] = color;
+						render_buffer_a[scanline_pixel_counter] = bg_priority;
 					}
 
-					//Line buffer
-					line_buffer[bg_id][scanline_pixel_counter] = lcd_stat.bg_pal_a[pal_2];
-					if((raw_color >> 4) && (window_draw[scanline_pixel_counter]) && (enable)) { line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
+					else { full_render = false; }
+				}
 
-					//Draw 256 pixels max
-					if(++scanline_pixel_counter & 0x100) { return; }
+				//Line buffer
+				engine.line_buffer[bg_id][scanline_pixel_counter] = color;
+				if(raw_color && window_draw[scanline_pixel_counter] && enable) { engine.line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
 
-					current_screen_pixel += 2;
-					y++;
-				}
+				//Draw 256 pixels max
+				current_screen_pixel++;
+				if(++scanline_pixel_counter & 0x100) { return; }
 			}
 
 			tile_offset_x = 0;
@@ -1852,7 +1864,6 @@ void NTR_LCD::render_bg_mode_text(u32 bg_control)
 
 		//Grab BG bit-depth and offset for the current tile line
 		u8 bit_depth = lcd_stat.bg_depth_b[bg_id] ? 64 : 32;
-		u8 line_offset;
 
 		//Get tile and map addresses
 		u32 tile_addr = 0x6200000 + lcd_stat.bg_base_tile_addr_b[bg_id];
@@ -1912,95 +1923,44 @@ void NTR_LCD::render_bg_mode_text(u32 bg_control)
 			flip = (map_data >> 10) & 0x3;
 			pal_id <<= 4;
 
-			//Calculate VRAM address to start pulling up tile data
-			line_offset = (flip & 0x2) ? ((bit_depth >> 3) * inv_lut[current_tile_line]) : ((bit_depth >> 3) * current_tile_line);
-			u32 tile_data_addr = tile_addr + (tile_id * bit_depth) + line_offset;
-			if(flip & 0x1) { tile_data_addr += ((bit_depth >> 3) - 1); }
-
-			//Read 8 pixels from VRAM and put them in the scanline buffer
-			for(u32 y = tile_offset_x; y < 8; y++, x++)
-			{
-				//Process 8-bit depth
-				if(bit_depth == 64)
-				{
-					//Grab dot-data, account for horizontal flipping 
-					u8 raw_color = (flip & 0x1) ? mem->memory_map[tile_data_addr--] : mem->memory_map[tile_data_addr++];
-
-					//Only draw if no previous pixel was rendered
-					if(!render_buffer_b[scanline_pixel_counter] || (bg_priority < render_buffer_b[scanline_pixel_counter]))
-					{
-						//Only draw colors if not transparent
-						if(raw_color && window_draw[scanline_pixel_counter])
-						{
-							scanline_buffer_b[scanline_pixel_counter] = (lcd_stat.ext_pal_b & 0x1) ? lcd_stat.bg_ext_pal_b[ext_pal_id + raw_color]  : lcd_stat.bg_pal_b[raw_color];
-							render_buffer_b[scanline_pixel_counter] = bg_priority;
-						}
+			//Grab palette indices for this tile line, account for vertical flipping
+			//4-bit tiles come from the decoded tile cache, 8-bit tiles already hold one index per byte
+			u8 tile_line = (flip & 0x2) ? inv_lut[current_tile_line] : current_tile_line;
+			u8* tile_row = (bit_depth == 64) ? get_tile_row(tile_addr + (tile_id * 64) + (tile_line * 8), engine.tile_scratch) : (get_decoded_tile(tile_addr + (tile_id * 32), engine.tile_scratch) + (tile_line * 8));
 
-						else { full_render = false; }
-					}
+			//Only the pixels left in the first tile are drawn, 4-bit tiles draw them in pairs
+			u8 tile_pixels = (bit_depth == 64) ? (8 - tile_offset_x) : ((9 - tile_offset_x) & ~0x1);
 
-					//Line buffer
-					line_buffer[bg_id][scanline_pixel_counter] = (lcd_stat.ext_pal_b & 0x1) ? lcd_stat.bg_ext_pal_b[ext_pal_id + raw_color]  : lcd_stat.bg_pal_b[raw_color];
-					if(raw_color && window_draw[scanline_pixel_counter] && enable) { line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
+			//Read pixels from the tile line and put them in the scanline buffer
+			for(u32 y = 0; y < tile_pixels; y++, x++)
+			{
+				//Grab dot-data, account for horizontal flipping
+				u8 raw_color = tile_row[(flip & 0x1) ? (7 - y) : y];
+				u32 color;
 
-					//Draw 256 pixels max
-					scanline_pixel_counter++;
-					current_screen_pixel++;
-					if(scanline_pixel_counter & 0x100) { return; }
-				}
+				if(bit_depth == 64) { color = (lcd_stat.ext_pal_b & 0x1) ? lcd_stat.bg_ext_pal_b[ext_pal_id + raw_color] : lcd_stat.bg_pal_b[raw_color]; }
+				else { color = lcd_stat.bg_pal_b[pal_id + raw_color]; }
 
-				//Process 4-bit depth
-				else
+				//Only draw if no previous pixel was rendered
+				if(!render_buffer_b[scanline_pixel_counter] || (bg_priority < render_buffer_b[scanline_pixel_counter]))
 				{
-					//Grab dot-data, account for horizontal flipping 
-					u8 raw_color = (flip & 0x1) ? mem->memory_map[tile_data_addr--] : mem->memory_map[tile_data_addr++];
-
-					u8 pal_1 = (flip & 0x1) ? (pal_id + (raw_color >> 4)) : (pal_id + (raw_color & 0xF));
-					u8 pal_2 = (flip & 0x1) ? (pal_id + (raw_color & 0xF)) : (pal_id + (raw_color >> 4));
-
-					//Only draw if no previous pixel was rendered
-					if(!render_buffer_b[scanline_pixel_counter] || (bg_priority < render_buffer_b[scanline_pixel_counter]))
+					//Only draw colors if not transparent
+					if(raw_color && window_draw[scanline_pixel_counter])
 					{
-						//Only draw colors if not transparent
-						if((raw_color & 0xF) && (window_draw[scanline_pixel_counter]))
-						{
-							scanline_buffer_b[scanline_pixel_counter] = lcd_stat.bg_pal_b[pal_1];
-							render_buffer_b[scanline_pixel_counter] = bg_priority;
-						}
-
-						else { full_render = false; }
-					}
-
-					//Line buffer
-					line_buffer[bg_id][scanline_pixel_counter] = lcd_stat.bg_pal_b[pal_1];
-					if((raw_color & 0xF) && (window_draw[scanline_pixel_counter]) && (enable)) { line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
-
-					//Draw 256 pixels max
-					if(++scanline_pixel_counter & 0x100) { return; }
-
-					//Only draw if no previous pixel was rendered
-					if(!render_buffer_b[scanline_pixel_counter] || (bg_priority < render_buffer_b[scanline_pixel_counter]))
-					{
-						//Only draw colors if not transparent
-						if((raw_color >> 4) && (window_draw[scanline_pixel_counter]))
-						{
-							scanline_buffer_b[scanline_pixel_counter] = lcd_stat.bg_pal_b[pal_2];
-							render_buffer_b[scanline_pixel_counter] = bg_priority;
-						}
-
-						else { full_render = false; }
+						scanline_buffer_b[scanline_pixel_counter] = color;
+						render_buffer_b[scanline_pixel_counter] = bg_priority;
 					}
 
-					//Line buffer
-					line_buffer[bg_id][scanline_pixel_counter] = lcd_stat.bg_pal_b[pal_2]; 
-					if((raw_color >> 4) && (window_draw[scanline_pixel_counter]) && (enable)) { line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
+					else { full_render = false; }
+				}
 
-					//Draw 256 pixels max
-					if(++scanline_pixel_counter & 0x100) { return; }
+				//Line buffer
+				engine.line_buffer[bg_id][scanline_pixel_counter] = color;
+				if(raw_color && window_draw[scanline_pixel_counter] && enable) { engine.line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
 
-					current_screen_pixel += 2;
-					y++;
-				}
+				//Draw 256 pixels max
+				current_screen_pixel++;
+				if(++scanline_pixel_counter & 0x100) { return; }
 			}
 
 			tile_offset_x = 0;
@@ -2013,6 +1973,9 @@ void NTR_LCD::render_bg_mode_text(u32 bg_control)
 /****** Render BG Mode Affine scanline ******/
 void NTR_LCD::render_bg_mode_affine(u32 bg_control)
 {
+	//Grab line buffers for Engine A or B
+	ntr_engine_line& engine = engine_line[(bg_control & 0x1000) ? 1 : 0];
+
 	//Render Engine A
 	if((bg_control & 0x1000) == 0)
 	{
@@ -2107,7 +2070,7 @@ void NTR_LCD::render_bg_mode_affine(u32 bg_control)
 					u16 tile_number = ((src_y / 8) * bg_tile_size) + (src_x / 8);
 
 					//Look at the Tile Map #(tile_number), see what Tile # it points to
-					u8 map_entry = mem->memory_map[map_base + tile_number];
+					u8 map_entry = mem->memory_map.read(map_base + tile_number);
 
 					//Get address of Tile #(map_entry)
 					u32 tile_addr = tile_base + (map_entry * 64);
@@ -2116,7 +2079,7 @@ void NTR_LCD::render_bg_mode_affine(u32 bg_control)
 
 					//Grab the byte corresponding to (current_tile_pixel), render it as ARGB - 8-bit version
 					tile_addr += current_tile_pixel;
-					raw_color = mem->memory_map[tile_addr];
+					raw_color = mem->memory_map.read(tile_addr);
 
 					//Only draw BG color if not transparent
 					if(raw_color && in_window && out_window)
@@ -2132,8 +2095,8 @@ void NTR_LCD::render_bg_mode_affine(u32 bg_control)
 			}
 
 			//Line buffer
-			line_buffer[bg_id][scanline_pixel_counter] = lcd_stat.bg_pal_a[raw_color];
-			if(raw_color && in_window && out_window && enable) { line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
+			engine.line_buffer[bg_id][scanline_pixel_counter] = lcd_stat.bg_pal_a[raw_color];
+			if(raw_color && in_window && out_window && enable) { engine.line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
 		}
 
 		//Update XREF and YREF for next line
@@ -2237,7 +2200,7 @@ void NTR_LCD::render_bg_mode_affine(u32 bg_control)
 					u16 tile_number = ((src_y / 8) * bg_tile_size) + (src_x / 8);
 
 					//Look at the Tile Map #(tile_number), see what Tile # it points to
-					u8 map_entry = mem->memory_map[map_base + tile_number];
+					u8 map_entry = mem->memory_map.read(map_base + tile_number);
 
 					//Get address of Tile #(map_entry)
 					u32 tile_addr = tile_base + (map_entry * 64);
@@ -2246,7 +2209,7 @@ void NTR_LCD::render_bg_mode_affine(u32 bg_control)
 
 					//Grab the byte corresponding to (current_tile_pixel), render it as ARGB - 8-bit version
 					tile_addr += current_tile_pixel;
-					raw_color = mem->memory_map[tile_addr];
+					raw_color = mem->memory_map.read(tile_addr);
 
 					//Only draw BG color if not transparent
 					if(raw_color && in_window && out_window)
@@ -2262,8 +2225,8 @@ void NTR_LCD::render_bg_mode_affine(u32 bg_control)
 			}
 
 			//Line buffer
-			line_buffer[bg_id][scanline_pixel_counter] = lcd_stat.bg_pal_b[raw_color];
-			if(raw_color && in_window && out_window && enable) { line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
+			engine.line_buffer[bg_id][scanline_pixel_counter] = lcd_stat.bg_pal_b[raw_color];
+			if(raw_color && in_window && out_window && enable) { engine.line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
 		}
 
 		//Update XREF and YREF for next line
@@ -2277,6 +2240,9 @@ void NTR_LCD::render_bg_mode_affine(u32 bg_control)
 /****** Render BG Mode Affine-Extended scanline ******/
 void NTR_LCD::render_bg_mode_affine_ext(u32 bg_control)
 {
+	//Grab line buffers for Engine A or B
+	ntr_engine_line& engine = engine_line[(bg_control & 0x1000) ? 1 : 0];
+
 	//Render Engine A
 	if((bg_control & 0x1000) == 0)
 	{
@@ -2397,7 +2363,7 @@ void NTR_LCD::render_bg_mode_affine_ext(u32 bg_control)
 
 					//Grab the byte corresponding to (current_tile_pixel), render it as ARGB - 8-bit version
 					tile_addr += current_tile_pixel;
-					raw_color = mem->memory_map[tile_addr];
+					raw_color = mem->memory_map.read(tile_addr);
 
 					//Only draw BG color if not transparent
 					if(raw_color && in_window && out_window)
@@ -2413,8 +2379,8 @@ void NTR_LCD::render_bg_mode_affine_ext(u32 bg_control)
 			}
 
 			//Line buffer
-			line_buffer[bg_id][scanline_pixel_counter] = lcd_stat.bg_pal_a[raw_color];
-			if(raw_color && in_window && out_window && enable) { line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
+			engine.line_buffer[bg_id][scanline_pixel_counter] = lcd_stat.bg_pal_a[raw_color];
+			if(raw_color && in_window && out_window && enable) { engine.line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
 		}
 
 		//Update XREF and YREF for next line
@@ -2544,7 +2510,7 @@ void NTR_LCD::render_bg_mode_affine_ext(u32 bg_control)
 
 					//Grab the byte corresponding to (current_tile_pixel), render it as ARGB - 8-bit version
 					tile_addr += current_tile_pixel;
-					raw_color = mem->memory_map[tile_addr];
+					raw_color = mem->memory_map.read(tile_addr);
 
 					//Only draw BG color if not transparent
 					if(raw_color && in_window && out_window)
@@ -2560,8 +2526,8 @@ void NTR_LCD::render_bg_mode_affine_ext(u32 bg_control)
 			}
 
 			//Line buffer
-			line_buffer[bg_id][scanline_pixel_counter] = lcd_stat.bg_pal_b[raw_color];
-			if(raw_color && in_window && out_window && enable) { line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
+			engine.line_buffer[bg_id][scanline_pixel_counter] = lcd_stat.bg_pal_b[raw_color];
+			if(raw_color && in_window && out_window && enable) { engine.line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
 		}
 
 		//Update XREF and YREF for next line
@@ -2575,6 +2541,9 @@ void NTR_LCD::render_bg_mode_affine_ext(u32 bg_control)
 /****** Render BG Mode 256-color scanline ******/
 void NTR_LCD::render_bg_mode_bitmap(u32 bg_control)
 {
+	//Grab line buffers for Engine A or B
+	ntr_engine_line& engine = engine_line[(bg_control & 0x1000) ? 1 : 0];
+
 	//Render Engine A
 	if((bg_control & 0x1000) == 0)
 	{
@@ -2679,7 +2648,7 @@ void NTR_LCD::render_bg_mode_bitmap(u32 bg_control)
 					src_x = new_x;
 					src_y = new_y;
 
-					raw_color = mem->memory_map[bitmap_addr + (src_y * bg_pixel_width) + src_x];
+					raw_color = mem->memory_map.read(bitmap_addr + (src_y * bg_pixel_width) + src_x);
 			
 					if(raw_color && in_window && out_window)
 					{
@@ -2694,8 +2663,8 @@ void NTR_LCD::render_bg_mode_bitmap(u32 bg_control)
 			}
 
 			//Line buffer
-			line_buffer[bg_id][scanline_pixel_counter] = lcd_stat.bg_pal_a[raw_color];
-			if(raw_color && in_window && out_window && enable) { line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
+			engine.line_buffer[bg_id][scanline_pixel_counter] = lcd_stat.bg_pal_a[raw_color];
+			if(raw_color && in_window && out_window && enable) { engine.line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
 
 			scanline_pixel_counter++;
 
@@ -2815,7 +2784,7 @@ void NTR_LCD::render_bg_mode_bitmap(u32 bg_control)
 					src_x = new_x;
 					src_y = new_y;
 
-					raw_color = mem->memory_map[bitmap_addr + (src_y * bg_pixel_width) + src_x];
+					raw_color = mem->memory_map.read(bitmap_addr + (src_y * bg_pixel_width) + src_x);
 			
 					if(raw_color && in_window && out_window)
 					{
@@ -2830,8 +2799,8 @@ void NTR_LCD::render_bg_mode_bitmap(u32 bg_control)
 			}
 
 			//Line buffer
-			line_buffer[bg_id][scanline_pixel_counter] = lcd_stat.bg_pal_b[raw_color];
-			if(raw_color && in_window && out_window && enable) { line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
+			engine.line_buffer[bg_id][scanline_pixel_counter] = lcd_stat.bg_pal_b[raw_color];
+			if(raw_color && in_window && out_window && enable) { engine.line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
 
 			scanline_pixel_counter++;
 
@@ -2851,6 +2820,9 @@ void NTR_LCD::render_bg_mode_bitmap(u32 bg_control)
 /****** Render BG Mode direct color scanline ******/
 void NTR_LCD::render_bg_mode_direct(u32 bg_control)
 {
+	//Grab line buffers for Engine A or B
+	ntr_engine_line& engine = engine_line[(bg_control & 0x1000) ? 1 : 0];
+
 	//Render Engine A
 	if((bg_control & 0x1000) == 0)
 	{
@@ -2971,8 +2943,8 @@ void NTR_LCD::render_bg_mode_direct(u32 bg_control)
 						render_buffer_a[scanline_pixel_counter] = bg_priority;
 
 						//Line buffer
-						line_buffer[bg_id][scanline_pixel_counter] = scanline_buffer_a[scanline_pixel_counter];
-						if(in_window && out_window && enable) { line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
+						engine.line_buffer[bg_id][scanline_pixel_counter] = scanline_buffer_a[scanline_pixel_counter];
+						if(in_window && out_window && enable) { engine.line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
 					}
 
 					else { full_render = false; }
@@ -3115,8 +3087,8 @@ void NTR_LCD::render_bg_mode_direct(u32 bg_control)
 						render_buffer_b[scanline_pixel_counter] = bg_priority;
 
 						//Line buffer
-						line_buffer[bg_id][scanline_pixel_counter] = scanline_buffer_b[scanline_pixel_counter];
-						if(in_window && out_window && enable) { line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
+						engine.line_buffer[bg_id][scanline_pixel_counter] = scanline_buffer_b[scanline_pixel_counter];
+						if(in_window && out_window && enable) { engine.line_buffer[bg_id + 4][scanline_pixel_counter] |= 1; }
 					}
 
 					else { full_render = false; }
@@ -3142,6 +3114,43 @@ void NTR_LCD::render_bg_mode_direct(u32 bg_control)
 
 /****** Render pixels for a given scanline (per-pixel) ******/
 void NTR_LCD::render_scanline()
+{
+	//Calculate window status for Engine A and Engine B for current scanline
+	if((lcd_stat.display_mode_a == 0x1) || (lcd_stat.display_mode_b == 0x1)) { calculate_window_on_scanline(); }
+
+	//Render Engines A and B one after the other
+	if(!threaded_2d)
+	{
+		render_engine_a();
+		render_engine_b();
+		return;
+	}
+
+	//Render Engine B on its own thread while Engine A renders here
+	if(!engine_b_thread.joinable()) { engine_b_thread = std::thread(&NTR_LCD::engine_b_worker, this); }
+
+	{
+		std::lock_guard<std::mutex> lock(engine_b_mutex);
+		engine_b_state.store(ENGINE_B_BUSY);
+	}
+
+	engine_b_wake.notify_one();
+	render_engine_a();
+
+	//Both engines must finish before anything else (HBlank IRQs, DMA) can change what they read
+	//Engine B usually finishes around the same time as Engine A, so spin briefly before sleeping
+	for(u32 spin = 0; engine_b_state.load(std::memory_order_acquire) != ENGINE_B_IDLE; spin++)
+	{
+		if(spin >= 0x400)
+		{
+			std::unique_lock<std::mutex> lock(engine_b_mutex);
+			engine_b_done.wait(lock, [this] { return engine_b_state.load() == ENGINE_B_IDLE; });
+		}
+	}
+}
+
+/****** Render Engine A's pixels for the current scanline ******/
+void NTR_LCD::render_engine_a()
 {
 	//Engine A - Render based on display modes
 	switch(lcd_stat.display_mode_a)
@@ -3190,7 +3199,11 @@ void NTR_LCD::render_scanline()
 			std::cout<<"LCD::Warning - Engine A - Unsupported Display Mode 3 \n";
 			break;
 	}
+}
 
+/****** Render Engine B's pixels for the current scanline ******/
+void NTR_LCD::render_engine_b()
+{
 	//Engine B - Render based on display modes
 	switch(lcd_stat.display_mode_b)
 	{
@@ -3215,14 +3228,67 @@ void NTR_LCD::render_scanline()
 	}		
 }
 
+/****** Engine B render thread - Renders Engine B's scanline whenever render_scanline() asks for it ******/
+void NTR_LCD::engine_b_worker()
+{
+	while(true)
+	{
+		//Scanlines come quickly while the LCD is drawing, so spin for a short while before going to sleep
+		auto spin_start = std::chrono::steady_clock::now();
+
+		for(u32 spin = 1; engine_b_state.load(std::memory_order_acquire) == ENGINE_B_IDLE; spin++)
+		{
+			if(((spin & 0xFF) == 0) && ((std::chrono::steady_clock::now() - spin_start) > std::chrono::microseconds(200)))
+			{
+				std::unique_lock<std::mutex> lock(engine_b_mutex);
+				engine_b_wake.wait(lock, [this] { return engine_b_state.load() != ENGINE_B_IDLE; });
+			}
+		}
+
+		if(engine_b_state.load(std::memory_order_acquire) == ENGINE_B_QUIT) { return; }
+
+		render_engine_b();
+
+		{
+			std::lock_guard<std::mutex> lock(engine_b_mutex);
+			engine_b_state.store(ENGINE_B_IDLE, std::memory_order_release);
+		}
+
+		engine_b_done.notify_one();
+	}
+}
+
+/****** Stops the Engine B render thread ******/
+void NTR_LCD::stop_engine_b_thread()
+{
+	if(!engine_b_thread.joinable()) { return; }
+
+	{
+		std::lock_guard<std::mutex> lock(engine_b_mutex);
+		engine_b_state.store(ENGINE_B_QUIT);
+	}
+
+	engine_b_wake.notify_one();
+	engine_b_thread.join();
+
+	engine_b_state.store(ENGINE_B_IDLE);
+}
+
 /****** Apply SFX to scanline pixels ******/
 void NTR_LCD::apply_sfx(u32 bg_control)
 {
+	//Grab line buffers for Engine A or B
+	ntr_engine_line& engine = engine_line[(bg_control & 0x1000) ? 1 : 0];
+
 	//TODO - Determine is SFX can be applied here based on various other conditions
 
 	nds_sfx_types temp_type = (bg_control == NDS_DISPCNT_A) ? lcd_stat.current_sfx_type_a : lcd_stat.current_sfx_type_b;
 
-	//Apply the specified SFX
+	if(temp_type == NDS_NORMAL) { return; }
+
+	memset(engine.sfx_op, sfx_util::SFX_NONE, 256);
+
+	//Find the targets for the specified SFX
 	switch(temp_type)
 	{
 		case NDS_BRIGHTNESS_UP:
@@ -3237,11 +3303,33 @@ void NTR_LCD::apply_sfx(u32 bg_control)
 			alpha_blend(bg_control);
 			break;
 	}
+
+	//Blend or fade the whole scanline at once
+	if(bg_control == NDS_DISPCNT_A)
+	{
+		sfx_util::apply_line(engine.sfx_op, engine.sfx_color_1, engine.sfx_color_2, &scanline_buffer_a[0], 256,
+			lcd_stat.alpha_coef_a[0], lcd_stat.alpha_coef_a[1], lcd_stat.brightness_coef_a);
+	}
+
+	else
+	{
+		sfx_util::apply_line(engine.sfx_op, engine.sfx_color_1, engine.sfx_color_2, &scanline_buffer_b[0], 256,
+			lcd_stat.alpha_coef_b[0], lcd_stat.alpha_coef_b[1], lcd_stat.brightness_coef_b);
+	}
+}
+
+/****** Converts a 32-bit scanline color to the RGB15 format used by SFX ******/
+u16 NTR_LCD::get_sfx_color(u32 color)
+{
+	return ((color >> 19) & 0x1F) | (((color >> 11) & 0x1F) << 5) | (((color >> 3) & 0x1F) << 10);
 }
 
 /****** SFX - Adjust scanline brightness up ******/
 void NTR_LCD::brightness_up(u32 bg_control)
 {
+	//Grab line buffers for Engine A or B
+	ntr_engine_line& engine = engine_line[(bg_control & 0x1000) ? 1 : 0];
+
 	u8 bg_render_list[4];
 	u8 bg_layer[4];
 
@@ -3250,8 +3338,6 @@ void NTR_LCD::brightness_up(u32 bg_control)
 	u8 bg_priority_2 = (bg_control == NDS_DISPCNT_A) ? lcd_stat.bg_priority_a[2] : lcd_stat.bg_priority_b[2];
 	u8 bg_priority_3 = (bg_control == NDS_DISPCNT_A) ? lcd_stat.bg_priority_a[3] : lcd_stat.bg_priority_b[3];
 
-	double coef = (bg_control == NDS_DISPCNT_A) ? lcd_stat.brightness_coef_a : lcd_stat.brightness_coef_b;
-
 	//Determine BG priority
 	for(int x = 0, list_length = 0; x < 4; x++)
 	{
@@ -3275,7 +3361,7 @@ void NTR_LCD::brightness_up(u32 bg_control)
 		{
 			target = bg_render_list[y];
 
-			if(obj_line_buffer[y + 4][x])
+			if(engine.obj_line_buffer[y + 4][x])
 			{
 				found_target = true;
 				is_obj = true;
@@ -3287,7 +3373,7 @@ void NTR_LCD::brightness_up(u32 bg_control)
 			}
 
 			//If 1st target is BG, check SFX Targets 0-3 and pull data from ordered layer
-			else if((bg_layer[0] == y) && (line_buffer[bg_render_list[0] + 4][x]))
+			else if((bg_layer[0] == y) && (engine.line_buffer[bg_render_list[0] + 4][x]))
 			{
 				found_target = true;
 				target = bg_render_list[0];
@@ -3296,7 +3382,7 @@ void NTR_LCD::brightness_up(u32 bg_control)
 				break;
 			}
 
-			else if((bg_layer[1] == y) && (line_buffer[bg_render_list[1] + 4][x]))
+			else if((bg_layer[1] == y) && (engine.line_buffer[bg_render_list[1] + 4][x]))
 			{
 				found_target = true;
 				target = bg_render_list[1];
@@ -3305,7 +3391,7 @@ void NTR_LCD::brightness_up(u32 bg_control)
 				break;
 			}
 
-			else if((bg_layer[2] == y) && (line_buffer[bg_render_list[2] + 4][x]))
+			else if((bg_layer[2] == y) && (engine.line_buffer[bg_render_list[2] + 4][x]))
 			{
 				found_target = true;
 				target = bg_render_list[2];
@@ -3314,7 +3400,7 @@ void NTR_LCD::brightness_up(u32 bg_control)
 				break;
 			}
 
-			else if((bg_layer[3] == y) && (line_buffer[bg_render_list[3] + 4][x]))
+			else if((bg_layer[3] == y) && (engine.line_buffer[bg_render_list[3] + 4][x]))
 			{
 				found_target = true;
 				target = bg_render_list[3];
@@ -3330,34 +3416,19 @@ void NTR_LCD::brightness_up(u32 bg_control)
 		//Check to see if target is enabled
 		target_enable = (bg_control == NDS_DISPCNT_A) ? lcd_stat.sfx_target_a[target][0] : lcd_stat.sfx_target_b[target][0];
 
-		//Proceed with SFX
+		//Queue SFX
 		if(target_enable)
 		{
 			u32 color = 0;
-			s16 result = 0;
 
 			//Pull color from backdrop
 			if(target == 5) { color = (bg_control == NDS_DISPCNT_A) ? lcd_stat.bg_pal_a[0] : lcd_stat.bg_pal_b[0]; }
 
 			//Pull color from layers
-			else { color = (is_obj) ? obj_line_buffer[layer][x] : line_buffer[layer][x]; }
-
-			//Increase RGB intensities
-			u8 red = ((color >> 19) & 0x1F);
-			result = red + ((0x1F - red) * coef);
-			red = (result > 0x1F) ? 0x1F : result;
+			else { color = (is_obj) ? engine.obj_line_buffer[layer][x] : engine.line_buffer[layer][x]; }
 
-			u8 green = ((color >> 11) & 0x1F);
-			result = green + ((0x1F - green) * coef);
-			green = (result > 0x1F) ? 0x1F : result;
-
-			u8 blue = ((color >> 3) & 0x1F);
-			result = blue + ((0x1F - blue) * coef);
-			blue = (result > 0x1F) ? 0x1F : result;
-
-			//Copy 32-bit color to scanline buffer
-			if(bg_control == NDS_DISPCNT_A) { scanline_buffer_a[x] = 0xFF000000 | (red << 19) | (green << 11) | (blue << 3); }
-			else { scanline_buffer_b[x] = 0xFF000000 | (red << 19) | (green << 11) | (blue << 3); }
+			engine.sfx_op[x] = sfx_util::SFX_BRIGHTEN;
+			engine.sfx_color_1[x] = get_sfx_color(color);
 		}
 	}
 }
@@ -3365,6 +3436,9 @@ void NTR_LCD::brightness_up(u32 bg_control)
 /****** SFX - Adjust scanline brightness down ******/
 void NTR_LCD::brightness_down(u32 bg_control)
 {
+	//Grab line buffers for Engine A or B
+	ntr_engine_line& engine = engine_line[(bg_control & 0x1000) ? 1 : 0];
+
 	u8 bg_render_list[4];
 	u8 bg_layer[4];
 
@@ -3373,8 +3447,6 @@ void NTR_LCD::brightness_down(u32 bg_control)
 	u8 bg_priority_2 = (bg_control == NDS_DISPCNT_A) ? lcd_stat.bg_priority_a[2] : lcd_stat.bg_priority_b[2];
 	u8 bg_priority_3 = (bg_control == NDS_DISPCNT_A) ? lcd_stat.bg_priority_a[3] : lcd_stat.bg_priority_b[3];
 
-	double coef = (bg_control == NDS_DISPCNT_A) ? lcd_stat.brightness_coef_a : lcd_stat.brightness_coef_b;
-
 	//Determine BG priority
 	for(int x = 0, list_length = 0; x < 4; x++)
 	{
@@ -3398,7 +3470,7 @@ void NTR_LCD::brightness_down(u32 bg_control)
 		{
 			target = bg_render_list[y];
 
-			if(obj_line_buffer[y + 4][x])
+			if(engine.obj_line_buffer[y + 4][x])
 			{
 				found_target = true;
 				is_obj = true;
@@ -3410,7 +3482,7 @@ void NTR_LCD::brightness_down(u32 bg_control)
 			}
 
 			//If 1st target is BG, check SFX Targets 0-3 and pull data from ordered layer
-			else if((bg_layer[0] == y) && (line_buffer[bg_render_list[0] + 4][x]))
+			else if((bg_layer[0] == y) && (engine.line_buffer[bg_render_list[0] + 4][x]))
 			{
 				found_target = true;
 				target = bg_render_list[0];
@@ -3419,7 +3491,7 @@ void NTR_LCD::brightness_down(u32 bg_control)
 				break;
 			}
 
-			else if((bg_layer[1] == y) && (line_buffer[bg_render_list[1] + 4][x]))
+			else if((bg_layer[1] == y) && (engine.line_buffer[bg_render_list[1] + 4][x]))
 			{
 				found_target = true;
 				target = bg_render_list[1];
@@ -3428,7 +3500,7 @@ void NTR_LCD::brightness_down(u32 bg_control)
 				break;
 			}
 
-			else if((bg_layer[2] == y) && (line_buffer[bg_render_list[2] + 4][x]))
+			else if((bg_layer[2] == y) && (engine.line_buffer[bg_render_list[2] + 4][x]))
 			{
 				found_target = true;
 				target = bg_render_list[2];
@@ -3437,7 +3509,7 @@ void NTR_LCD::brightness_down(u32 bg_control)
 				break;
 			}
 
-			else if((bg_layer[3] == y) && (line_buffer[bg_render_list[3] + 4][x]))
+			else if((bg_layer[3] == y) && (engine.line_buffer[bg_render_list[3] + 4][x]))
 			{
 				found_target = true;
 				target = bg_render_list[3];
@@ -3453,34 +3525,19 @@ void NTR_LCD::brightness_down(u32 bg_control)
 		//Check to see if target is enabled
 		target_enable = (bg_control == NDS_DISPCNT_A) ? lcd_stat.sfx_target_a[target][0] : lcd_stat.sfx_target_b[target][0];
 
-		//Proceed with SFX
+		//Queue SFX
 		if(target_enable)
 		{
 			u32 color = 0;
-			s16 result = 0;
 
 			//Pull color from backdrop
 			if(target == 5) { color = (bg_control == NDS_DISPCNT_A) ? lcd_stat.bg_pal_a[0] : lcd_stat.bg_pal_b[0]; }
 
 			//Pull color from layers
-			else { color = (is_obj) ? obj_line_buffer[layer][x] : line_buffer[layer][x]; }
-
-			//Decrease RGB intensities 
-			u8 red = ((color >> 19) & 0x1F);
-			result = red - (red * coef);
-			red = (result < 0) ? 0 : result;
-
-			u8 green = ((color >> 11) & 0x1F);
-			result = green - (green * coef);
-			green = (result < 0) ? 0 : result;
-
-			u8 blue = ((color >> 3) & 0x1F);
-			result = blue - (blue * coef);
-			blue = (result < 0) ? 0 : result;
+			else { color = (is_obj) ? engine.obj_line_buffer[layer][x] : engine.line_buffer[layer][x]; }
 
-			//Copy 32-bit color to scanline buffer
-			if(bg_control == NDS_DISPCNT_A) { scanline_buffer_a[x] = 0xFF000000 | (red << 19) | (green << 11) | (blue << 3); }
-			else { scanline_buffer_b[x] = 0xFF000000 | (red << 19) | (green << 11) | (blue << 3); }
+			engine.sfx_op[x] = sfx_util::SFX_DARKEN;
+			engine.sfx_color_1[x] = get_sfx_color(color);
 		}
 	}
 }
@@ -3488,16 +3545,12 @@ void NTR_LCD::brightness_down(u32 bg_control)
 /****** SFX - Alpha blending *****/
 void NTR_LCD::alpha_blend(u32 bg_control)
 {
+	//Grab line buffers for Engine A or B
+	ntr_engine_line& engine = engine_line[(bg_control & 0x1000) ? 1 : 0];
+
 	u8 bg_render_list[4];
 	u8 bg_layer[4];
 
-	u8 r1, r2;
-	u8 g1, g2;
-	u8 b1, b2;
-
-	double coef_1 = (bg_control == NDS_DISPCNT_A) ? lcd_stat.alpha_coef_a[0] : lcd_stat.alpha_coef_b[0];
-	double coef_2 = (bg_control == NDS_DISPCNT_A) ? lcd_stat.alpha_coef_a[1] : lcd_stat.alpha_coef_b[1];
-
 	u8 bg_priority_0 = (bg_control == NDS_DISPCNT_A) ? lcd_stat.bg_priority_a[0] : lcd_stat.bg_priority_b[0];
 	u8 bg_priority_1 = (bg_control == NDS_DISPCNT_A) ? lcd_stat.bg_priority_a[1] : lcd_stat.bg_priority_b[1];
 	u8 bg_priority_2 = (bg_control == NDS_DISPCNT_A) ? lcd_stat.bg_priority_a[2] : lcd_stat.bg_priority_b[2];
@@ -3536,7 +3589,7 @@ void NTR_LCD::alpha_blend(u32 bg_control)
 		for(int y = 0; y < 4; y++)
 		{
 			//If 1st target is OBJ, check SFX Target 4 and pull data from regular layer
-			if(obj_line_buffer[y + 4][x])
+			if(engine.obj_line_buffer[y + 4][x])
 			{
 				found_target_1 = true;
 				is_obj_1 = true;
@@ -3544,13 +3597,13 @@ void NTR_LCD::alpha_blend(u32 bg_control)
 				target_1 = 4;
 				layer_1 = y;
 
-				if((obj_line_buffer[y + 4][x] & 0xE0) == 0xC0) { obj_semi_1 = true; }
+				if((engine.obj_line_buffer[y + 4][x] & 0xE0) == 0xC0) { obj_semi_1 = true; }
 
 				break;
 			}
 
 			//If 1st target is BG, check SFX Targets 0-3 and pull data from ordered layer
-			else if((bg_layer[0] == y) && (line_buffer[bg_render_list[0] + 4][x]))
+			else if((bg_layer[0] == y) && (engine.line_buffer[bg_render_list[0] + 4][x]))
 			{
 				found_target_1 = true;
 
@@ -3560,7 +3613,7 @@ void NTR_LCD::alpha_blend(u32 bg_control)
 				break;
 			}
 
-			else if((bg_layer[1] == y) && (line_buffer[bg_render_list[1] + 4][x]))
+			else if((bg_layer[1] == y) && (engine.line_buffer[bg_render_list[1] + 4][x]))
 			{
 				found_target_1 = true;
 
@@ -3570,7 +3623,7 @@ void NTR_LCD::alpha_blend(u32 bg_control)
 				break;
 			}
 
-			else if((bg_layer[2] == y) && (line_buffer[bg_render_list[2] + 4][x]))
+			else if((bg_layer[2] == y) && (engine.line_buffer[bg_render_list[2] + 4][x]))
 			{
 				found_target_1 = true;
 
@@ -3580,7 +3633,7 @@ void NTR_LCD::alpha_blend(u32 bg_control)
 				break;
 			}
 
-			else if((bg_layer[3] == y) && (line_buffer[bg_render_list[3] + 4][x]))
+			else if((bg_layer[3] == y) && (engine.line_buffer[bg_render_list[3] + 4][x]))
 			{
 				found_target_1 = true;
 
@@ -3595,7 +3648,7 @@ void NTR_LCD::alpha_blend(u32 bg_control)
 		for(int y = 0; y < 4; y++)
 		{
 			//If 2nd target is OBJ, check SFX Target 4 and pull data from regular layer
-			if((obj_line_buffer[y + 4][x] & 0x80) && (layer_1 != y))
+			if((engine.obj_line_buffer[y + 4][x] & 0x80) && (layer_1 != y))
 			{
 				found_target_2 = true;
 				is_obj_2 = true;
@@ -3603,13 +3656,13 @@ void NTR_LCD::alpha_blend(u32 bg_control)
 				target_2 = 4;
 				layer_2 = y;
 
-				if((obj_line_buffer[y + 4][x] & 0xE0) == 0xC0) { obj_semi_2 = true; }
+				if((engine.obj_line_buffer[y + 4][x] & 0xE0) == 0xC0) { obj_semi_2 = true; }
 
 				break;
 			}
 
 			//If 2nd target is BG, check SFX Targets 0-3 and pull data from ordered layer
-			else if((bg_layer[0] == y) && (line_buffer[bg_render_list[0] + 4][x]) && ((layer_1 != bg_render_list[0]) || (obj_semi_1)))
+			else if((bg_layer[0] == y) && (engine.line_buffer[bg_render_list[0] + 4][x]) && ((layer_1 != bg_render_list[0]) || (obj_semi_1)))
 			{
 				found_target_2 = true;
 
@@ -3619,7 +3672,7 @@ void NTR_LCD::alpha_blend(u32 bg_control)
 				break;
 			}
 
-			else if((bg_layer[1] == y) && (line_buffer[bg_render_list[1] + 4][x]) && ((layer_1 != bg_render_list[1]) || (obj_semi_1)))
+			else if((bg_layer[1] == y) && (engine.line_buffer[bg_render_list[1] + 4][x]) && ((layer_1 != bg_render_list[1]) || (obj_semi_1)))
 			{
 				found_target_2 = true;
 
@@ -3629,7 +3682,7 @@ void NTR_LCD::alpha_blend(u32 bg_control)
 				break;
 			}
 
-			else if((bg_layer[2] == y) && (line_buffer[bg_render_list[2] + 4][x]) && ((layer_1 != bg_render_list[2]) || (obj_semi_1)))
+			else if((bg_layer[2] == y) && (engine.line_buffer[bg_render_list[2] + 4][x]) && ((layer_1 != bg_render_list[2]) || (obj_semi_1)))
 			{
 				found_target_2 = true;
 
@@ -3639,7 +3692,7 @@ void NTR_LCD::alpha_blend(u32 bg_control)
 				break;
 			}
 
-			else if((bg_layer[3] == y) && (line_buffer[bg_render_list[3] + 4][x]) && ((layer_1 != bg_render_list[3]) || (obj_semi_1)))
+			else if((bg_layer[3] == y) && (engine.line_buffer[bg_render_list[3] + 4][x]) && ((layer_1 != bg_render_list[3]) || (obj_semi_1)))
 			{
 				found_target_2 = true;
 
@@ -3663,40 +3716,21 @@ void NTR_LCD::alpha_blend(u32 bg_control)
 		//If 1st target is 3D BG0, a separate alpha-blending formula must be used
 		target_3D = ((bg0_is_3D) && (target_1 == 0));
 
-		//Proceed with alpha blending if conditions met
+		//Queue alpha blending if conditions met
 		if(found_target_1 && found_target_2 && target_1_enable && target_2_enable && !target_3D)
 		{
-			u8 result = 0;
-			u32 color_1 = (is_obj_1) ? obj_line_buffer[layer_1][x] : line_buffer[layer_1][x];
+			u32 color_1 = (is_obj_1) ? engine.obj_line_buffer[layer_1][x] : engine.line_buffer[layer_1][x];
 			u32 color_2 = 0;
 
 			//Pull color from backdrop
 			if(target_2 == 5) { color_2 = (bg_control == NDS_DISPCNT_A) ? lcd_stat.bg_pal_a[0] : lcd_stat.bg_pal_b[0]; }
 
 			//Pull color from layers
-			else { color_2 = (is_obj_2) ? obj_line_buffer[layer_2][x] : line_buffer[layer_2][x]; }
+			else { color_2 = (is_obj_2) ? engine.obj_line_buffer[layer_2][x] : engine.line_buffer[layer_2][x]; }
 
-			//Grab RGB15 values of both targets
-			r1 = (color_1 >> 19) & 0x1F;
-			g1 = (color_1 >> 11) & 0x1F;
-			b1 = (color_1 >> 3) & 0x1F;
-
-			r2 = (color_2 >> 19) & 0x1F;
-			g2 = (color_2 >> 11) & 0x1F;
-			b2 = (color_2 >> 3) & 0x1F;
-
-			result = (r1 * coef_1) + (r2 * coef_2);
-			u8 red = (result > 0x1F) ? 0x1F : result;
-
-			result = (g1 * coef_1) + (g2 * coef_2);
-			u8 green = (result > 0x1F) ? 0x1F : result;
-
-			result = (b1 * coef_1) + (b2 * coef_2);
-			u8 blue = (result > 0x1F) ? 0x1F : result;
-
-			//Copy 32-bit color to scanline buffer
-			if(bg_control == NDS_DISPCNT_A) { scanline_buffer_a[x] = 0xFF000000 | (red << 19) | (green << 11) | (blue << 3); }
-			else { scanline_buffer_b[x] = 0xFF000000 | (red << 19) | (green << 11) | (blue << 3); }
+			engine.sfx_op[x] = sfx_util::SFX_BLEND;
+			engine.sfx_color_1[x] = get_sfx_color(color_1);
+			engine.sfx_color_2[x] = get_sfx_color(color_2);
 		}
 	}
 }
@@ -3705,114 +3739,13 @@ void NTR_LCD::alpha_blend(u32 bg_control)
 void NTR_LCD::adjust_master_brightness(u8 engine_id)
 {
 	u16 master_bright = (engine_id) ? lcd_stat.master_bright_a : lcd_stat.master_bright_b;
-
-	double factor = (master_bright & 0x1F) / 16.0;
-	u32 color = 0;
-	
-	u8 r = 0;
-	u8 g = 0;
-	u8 b = 0;
-	s16 result = 0;
+	u32* line = (engine_id) ? &scanline_buffer_a[0] : &scanline_buffer_b[0];
 
 	//Master Brightness Up
-	if((master_bright >> 14) == 0x1)
-	{
-		//Engine A pixels
-		if(engine_id)
-		{
-			for(u32 x = 0; x < 256; x++)
-			{
-				color = scanline_buffer_a[x];
-
-				r = (color >> 18) & 0x3F;
-				result = r + ((63 - r) * factor);
-				r = (result > 63) ? 63 : result;
-
-				g = (color >> 10) & 0x3F;
-				result = g + ((63 - g) * factor);
-				g = (result > 63) ? 63 : result;
-
-				b = (color >> 2) & 0x3F;
-				result = b + ((63 - b) * factor);
-				b = (result > 63) ? 63 : result;
-
-				scanline_buffer_a[x] = 0xFF000000 | (r << 18) | (g << 10) | (b << 2);
-			}
-		}
-
-		//Engine B pixels
-		else
-		{
-			for(u32 x = 0; x < 256; x++)
-			{
-				color = scanline_buffer_b[x];
-
-				r = (color >> 18) & 0x3F;
-				result = r + ((63 - r) * factor);
-				r = (result > 63) ? 63 : result;
-
-				g = (color >> 10) & 0x3F;
-				result = g + ((63 - g) * factor);
-				g = (result > 63) ? 63 : result;
-
-				b = (color >> 2) & 0x3F;
-				result = b + ((63 - b) * factor);
-				b = (result > 63) ? 63 : result;
-
-				scanline_buffer_b[x] = 0xFF000000 | (r << 18) | (g << 10) | (b << 2);
-			}
-		}
-	}
+	if((master_bright >> 14) == 0x1) { sfx_util::master_brightness_line(line, 256, true, (master_bright & 0x1F)); }
 
 	//Master Bright Down
-	if((master_bright >> 14) == 0x2)
-	{
-		//Engine A pixels
-		if(engine_id)
-		{
-			for(u32 x = 0; x < 256; x++)
-			{
-				color = scanline_buffer_a[x];
-
-				r = ((color >> 18) & 0x3F);
-				result = r - (r * factor);
-				r = (result < 0) ? 0 : result;
-
-				g = ((color >> 10) & 0x3F);
-				result = g - (g * factor);
-				g = (result < 0) ? 0 : result;
-
-				b = ((color >> 2) & 0x3F);
-				result = b - (b * factor);
-				b = (result < 0) ? 0 : result;
-
-				scanline_buffer_a[x] = 0xFF000000 | (r << 18) | (g << 10) | (b << 2);
-			}
-		}
-
-		//Engine B pixels
-		else
-		{
-			for(u32 x = 0; x < 256; x++)
-			{
-				color = scanline_buffer_b[x];
-
-				r = ((color >> 18) & 0x3F);
-				result = r - (r * factor);
-				r = (result < 0) ? 0 : result;
-
-				g = ((color >> 10) & 0x3F);
-				result = g - (g * factor);
-				g = (result < 0) ? 0 : result;
-
-				b = ((color >> 2) & 0x3F);
-				result = b - (b * factor);
-				b = (result < 0) ? 0 : result;
-
-				scanline_buffer_b[x] = 0xFF000000 | (r << 18) | (g << 10) | (b << 2);
-			}
-		}
-	}
+	if((master_bright >> 14) == 0x2) { sfx_util::master_brightness_line(line, 256, false, (master_bright & 0x1F)); }
 }
 
 /****** Calculates what coordinates of a scanline are within a Window ******/
@@ -4030,11 +3963,6 @@ void NTR_LCD::step()
 {
 	lcd_stat.lcd_clock++;
 
-	//Process GX commands and states
-	if(lcd_3D_stat.process_command) { process_gx_command(); }
-	
-	if(lcd_3D_stat.render_polygon) { render_geometry(); }
-
 	//Mode 0 - Scanline rendering
 	if(((lcd_stat.lcd_clock % 2130) <= 1536) && (lcd_stat.lcd_clock < 408960)) 
 	{
@@ -4326,6 +4254,9 @@ void NTR_LCD::step()
 				lcd_3D_stat.poly_count = 0;
 				lcd_3D_stat.vert_count = 0;
 
+				//Rasterize this frame's polygons to the back buffer
+				render_geometry();
+
 				//Clear 3D buffer and fill with rear plane
 				gx_screen_buffer[lcd_3D_stat.buffer_id].clear();
 				gx_screen_buffer[lcd_3D_stat.buffer_id].resize(0xC000, lcd_3D_stat.rear_plane_color);
@@ -4401,6 +4332,33 @@ void NTR_LCD::step()
 	}
 }
 
+/****** Returns the number of cycles until the LCD needs to step again ******/
+u32 NTR_LCD::cycles_to_next_event()
+{
+	u32 next_clock = lcd_stat.lcd_clock + 1;
+	u32 line_pos = (next_clock % 2130);
+	u32 line_start = next_clock - line_pos;
+
+	//Visible lines - Next event is the start of HBlank
+	if((line_pos <= 1536) && (next_clock < 408960))
+	{
+		if(lcd_stat.lcd_mode != 0) { return 1; }
+		return (line_start + 1537) - lcd_stat.lcd_clock;
+	}
+
+	//HBlank - Next event is the start of the next line or VBlank
+	else if(next_clock < 408960)
+	{
+		if(lcd_stat.lcd_mode != 1) { return 1; }
+		return (line_start + 2130) - lcd_stat.lcd_clock;
+	}
+
+	//VBlank - Next event is the scanline increment or end of HBlank
+	if((lcd_stat.lcd_mode != 2) || (line_pos == 0) || (line_pos == 1536)) { return 1; }
+	else if(line_pos < 1536) { return (line_start + 1536) - lcd_stat.lcd_clock; }
+	else { return (line_start + 2130) - lcd_stat.lcd_clock; }
+}
+
 /****** Compare VCOUNT to LYC ******/
 void NTR_LCD::scanline_compare()
 {
@@ -9,6 +9,11 @@
 // Draws background, window, and sprites to screen
 // Responsible for blitting pixel data and limiting frame rate
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
 #include "SDL2/SDL.h"
 #include "SDL2/SDL_opengl.h"
 #include "mmu.h"
@@ -17,6 +22,13 @@
 #ifndef NDS_LCD
 #define NDS_LCD
 
+enum ntr_engine_b_states
+{
+	ENGINE_B_IDLE,
+	ENGINE_B_BUSY,
+	ENGINE_B_QUIT,
+};
+
 class NTR_LCD
 {
 	public:
@@ -29,6 +41,7 @@ class NTR_LCD
 	~NTR_LCD();
 
 	void step();
+	u32 cycles_to_next_event();
 	void reset();
 	bool init();
 	bool opengl_init();
@@ -56,8 +69,11 @@ class NTR_LCD
 
 	int max_fullscreen_ratio;
 
-	//Needs to be called by ARM9 when performing GXFIFO DMA, so not private
+	//Needs to be called by ARM9 when performing GXFIFO DMA or scheduled GX events, so not private
 	void process_gx_command();
+	void process_gx_list(u8* list, u32 count);
+	void store_polygon();
+	void render_geometry();
 
 	private:
 
@@ -136,9 +152,27 @@ class NTR_LCD
 	std::vector< std::vector<u8> > gx_render_buffer;
 	std::vector<float> gx_z_buffer;
 
-	//Other buffers
-	std::vector< std::vector<u32> > line_buffer;
-	std::vector< std::vector<u32> > obj_line_buffer;
+	//Working buffers for each 2D engine's scanline - Kept separate so Engines A and B can render at the same time
+	struct ntr_engine_line
+	{
+		std::vector< std::vector<u32> > line_buffer;
+		std::vector< std::vector<u32> > obj_line_buffer;
+
+		u8 tile_scratch[64];
+
+		//SFX to apply to each pixel on the scanline and the RGB15 targets they use
+		u8 sfx_op[256];
+		u16 sfx_color_1[256];
+		u16 sfx_color_2[256];
+	} engine_line[2];
+
+	//Engine B render thread - Draws Engine B's scanline while Engine A is drawn on the emulation thread
+	std::thread engine_b_thread;
+	std::mutex engine_b_mutex;
+	std::condition_variable engine_b_wake;
+	std::condition_variable engine_b_done;
+	std::atomic<u8> engine_b_state;
+	bool threaded_2d;
 
 	//Display Capture
 	bool capture_on;
@@ -147,8 +181,6 @@ class NTR_LCD
 	bool full_scanline_render_a;
 	bool full_scanline_render_b;
 
-	u32 scanline_pixel_counter;
-
 	int frame_start_time;
 	int frame_current_time;
 	int fps_count;
@@ -159,12 +191,24 @@ class NTR_LCD
 
 	u8 inv_lut[8];
 	u16 screen_offset_lut[512];
+
+	//4bpp tiles decoded into palette indices - One tile per 32 bytes of the VRAM banks, redecoded when VRAM changes
+	std::vector<u8> tile_cache;
 	u8 modulation_lut[4096];
 
 	//3D Polygons
 	gx_matrix last_poly;
 	gx_matrix current_poly;
 
+	//Polygon and Vertex RAM - Holds the frame's transformed geometry until it is rasterized on SWAP_BUFFERS
+	std::vector<ntr_gx_polygon> gx_poly_ram;
+	std::vector<ntr_gx_vertex> gx_vert_ram;
+
+	//Last texture decoded into tex_data while rasterizing - Consecutive polygons with the same texture reuse it
+	ntr_gx_polygon gx_tex_attr;
+	u32 gx_tex_addr;
+	bool gx_tex_loaded;
+
 	//Matrix Stacks
 	std::vector<gx_matrix> gx_projection_stack;
 	std::vector<gx_matrix> gx_position_stack;
@@ -194,6 +238,10 @@ class NTR_LCD
 	float shine_table[4];
 
 	void render_scanline();
+	void render_engine_a();
+	void render_engine_b();
+	void engine_b_worker();
+	void stop_engine_b_thread();
 	void render_bg_scanline(u32 bg_control);
 	void render_bg_mode_text(u32 bg_control);
 	void render_bg_mode_affine(u32 bg_control);
@@ -201,24 +249,26 @@ class NTR_LCD
 	void render_bg_mode_bitmap(u32 bg_control);
 	void render_bg_mode_direct(u32 bg_control);
 	void render_obj_scanline(u32 bg_control);
+	u8* get_decoded_tile(u32 tile_addr, u8* scratch);
+	u8* get_tile_row(u32 row_addr, u8* scratch);
 	void scanline_compare();
 	void reload_affine_references(u32 bg_control);
 
 	//3D functions
 	void render_bg_3D();
-	void render_geometry();
-	void fill_poly_solid();
-	void fill_poly_interpolated();
-	void fill_poly_textured();
+	void rasterize_polygon(ntr_gx_polygon &poly);
+	void fill_poly_solid(ntr_gx_polygon &poly);
+	void fill_poly_interpolated(ntr_gx_polygon &poly);
+	void fill_poly_textured(ntr_gx_polygon &poly);
 	void build_verts(u8 &l_size, u8 &index);
 	bool poly_push();
 	u32 read_param_u32(u8 index);
 	u16 read_param_u16(u8 index);
 	u32 get_rgb15(u16 color_bytes);
 	u32 interpolate_rgb(u32 color_1, u32 color_2, float ratio);
-	u32 alpha_blend_texel(u32 color_1, u32 color_2);
+	u32 alpha_blend_texel(u32 color_1, u32 color_2, u8 poly_alpha);
 	u32 alpha_blend_pixel(u32 color_1, u32 color_2, u8 poly_alpha);
-	u32 blend_texel(u32 color_1);
+	u32 blend_texel(u32 color_1, ntr_gx_polygon &poly);
 	void update_clip_matrix();
 	void update_vector_matrix();
 	float get_u16_float(u16 value);
@@ -228,13 +278,13 @@ class NTR_LCD
 	void render_virtual_cursor();
 
 	//Texture functions
-	void gen_tex_1(u32 address);
-	void gen_tex_2(u32 address);
-	void gen_tex_3(u32 address);
-	void gen_tex_4(u32 address);
-	void gen_tex_5(u32 address);
-	void gen_tex_6(u32 address);
-	void gen_tex_7(u32 address);
+	void gen_tex_1(u32 address, ntr_gx_polygon &poly);
+	void gen_tex_2(u32 address, ntr_gx_polygon &poly);
+	void gen_tex_3(u32 address, ntr_gx_polygon &poly);
+	void gen_tex_4(u32 address, ntr_gx_polygon &poly);
+	void gen_tex_5(u32 address, ntr_gx_polygon &poly);
+	void gen_tex_6(u32 address, ntr_gx_polygon &poly);
+	void gen_tex_7(u32 address, ntr_gx_polygon &poly);
 
 	//SFX functions
 	void apply_sfx(u32 bg_control);
@@ -242,6 +292,7 @@ class NTR_LCD
 	void brightness_down(u32 bg_control);
 	void alpha_blend(u32 bg_control);
 	void adjust_master_brightness(u8 engine_id);
+	u16 get_sfx_color(u32 color);
 
 	//Window functions
 	void calculate_window_on_scanline();
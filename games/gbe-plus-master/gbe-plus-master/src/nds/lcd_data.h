@@ -150,11 +150,11 @@ struct ntr_lcd_data
 	nds_sfx_types current_sfx_type_a;
 	nds_sfx_types current_sfx_type_b;
 
-	double brightness_coef_a;
-	double brightness_coef_b;
+	u8 brightness_coef_a;
+	u8 brightness_coef_b;
 
-	double alpha_coef_a[2];
-	double alpha_coef_b[2];
+	u8 alpha_coef_a[2];
+	u8 alpha_coef_b[2];
 
 	u16 window_x_a[2][2];
 	u16 window_x_b[2][2];
@@ -225,6 +225,8 @@ struct ntr_lcd_data
 
 	bool oam_update;
 	std::vector<bool> oam_update_list;
+
+	std::vector<u8> vram_tile_update_list;
 };
 
 struct ntr_lcd_3D_data
@@ -322,4 +324,46 @@ struct ntr_lcd_3D_data
 	float lo_ty[256];
 };
 
+//3D vertex transformed to screen coordinates - Stored in Vertex RAM until the frame is rasterized
+struct ntr_gx_vertex
+{
+	float x;
+	float y;
+	float z;
+	float w;
+	float tx;
+	float ty;
+	u32 color;
+};
+
+//3D polygon and the attributes latched when it was submitted - Stored in Polygon RAM until the frame is rasterized
+struct ntr_gx_polygon
+{
+	u16 vert_index;
+	u8 vert_count;
+	u8 vertex_mode;
+	u32 vertex_color;
+
+	//Polygon Attribute
+	u8 poly_id;
+	u8 poly_alpha;
+	u8 poly_mode;
+	bool poly_new_depth;
+	bool poly_depth_test;
+
+	//Texture Attribute
+	bool use_texture;
+	u32 tex_offset;
+	u32 pal_base;
+	u32 pal_bank_addr;
+	u16 tex_src_width;
+	u16 tex_src_height;
+	u8 tex_format;
+	bool tex_color_zero;
+	bool repeat_tex_x;
+	bool repeat_tex_y;
+	bool flip_tex_x;
+	bool flip_tex_y;
+};
+
 #endif // NDS_LCD_DATA
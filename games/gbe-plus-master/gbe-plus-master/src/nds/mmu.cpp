@@ -15,6 +15,142 @@
 #include <cmath>
 #include <algorithm>
 
+/****** Memory map constructor ******/
+ntr_memory::ntr_memory()
+{
+	for(u32 x = 0; x < 0x4000; x++) { pages[x] = NULL; }
+}
+
+/****** Allocates and maps all memory regions, everything is zero-filled ******/
+void ntr_memory::reset()
+{
+	clear();
+
+	itcm.resize(0x8000, 0);
+	main_ram.resize(0x400000, 0);
+	shared_wram.resize(0x8000, 0);
+	nds7_wram.resize(0x10000, 0);
+	palette.resize(0x8000, 0);
+	vram.resize(0xA4000, 0);
+	vram_unmapped.resize(0x4000, 0);
+	oam.resize(0x8000, 0);
+
+	//Main RAM mirrors across its entire 16MB area
+	//Other mirrors depend on the CPU and WRAMCNT, so they are handled by the per-CPU page tables
+	map_region(0x0000000, 0x0007FFF, itcm);
+	map_region(0x2000000, 0x2FFFFFF, main_ram);
+	map_region(0x3000000, 0x3007FFF, shared_wram);
+	map_region(0x3800000, 0x380FFFF, nds7_wram);
+	map_region(0x5000000, 0x5007FFF, palette);
+	map_region(0x7000000, 0x7007FFF, oam);
+
+	u32 bank_window[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+	map_vram(bank_window);
+}
+
+/****** Frees all memory regions ******/
+void ntr_memory::clear()
+{
+	for(u32 x = 0; x < 0x4000; x++) { pages[x] = NULL; }
+
+	itcm.clear();
+	main_ram.clear();
+	shared_wram.clear();
+	nds7_wram.clear();
+	palette.clear();
+	vram.clear();
+	vram_unmapped.clear();
+	oam.clear();
+	unmapped_pages.clear();
+}
+
+/****** Maps VRAM banks A-I into the BG/OBJ areas - Each bank is always visible in the LCDC area ******/
+void ntr_memory::map_vram(u32 bank_window[9])
+{
+	//Banks are stored back-to-back in the same order as the LCDC area
+	const u32 bank_offset[9] = { 0x0, 0x20000, 0x40000, 0x60000, 0x80000, 0x90000, 0x94000, 0x98000, 0xA0000 };
+	const u32 bank_size[9] = { 0x20000, 0x20000, 0x20000, 0x20000, 0x10000, 0x4000, 0x4000, 0x8000, 0x4000 };
+
+	//Parts of BG/OBJ VRAM without a bank read from a shared zero page
+	//Writes there are dropped, so the zero page is never handed out for writing
+	map_region(0x6000000, 0x67FFFFF, vram_unmapped);
+	map_region(0x6800000, 0x68A3FFF, vram);
+
+	for(u32 x = 0; x < 9; x++)
+	{
+		u32 start = bank_window[x];
+
+		if((start >= 0x6000000) && (start < 0x6800000))
+		{
+			map_region(start, (start + bank_size[x] - 1), vram, bank_offset[x]);
+		}
+	}
+}
+
+/****** Returns the page holding an address, or NULL if nothing has been mapped or allocated there ******/
+u8* ntr_memory::get_page(u32 address) const
+{
+	return pages[(address >> 14) & 0x3FFF];
+}
+
+/****** Returns where an address lands inside the VRAM banks, or 0xFFFFFFFF if no bank is mapped there ******/
+u32 ntr_memory::get_vram_offset(u32 address) const
+{
+	u8* page = pages[(address >> 14) & 0x3FFF];
+
+	if((page == NULL) || (page < vram.data()) || (page >= (vram.data() + vram.size()))) { return 0xFFFFFFFF; }
+	return (page - vram.data()) + (address & 0x3FFF);
+}
+
+/****** Reads a block of memory from a file, page by page ******/
+void ntr_memory::load_block(std::ifstream& file, u32 address, u32 length)
+{
+	while(length)
+	{
+		u32 chunk = std::min(length, (0x4000 - (address & 0x3FFF)));
+
+		//BG/OBJ VRAM without a bank stays zero
+		if(pages[(address >> 14) & 0x3FFF] == vram_unmapped.data()) { file.seekg(chunk, std::ios::cur); }
+		else { file.read(reinterpret_cast<char*> (&(*this)[address]), chunk); }
+
+		address += chunk;
+		length -= chunk;
+	}
+}
+
+/****** Writes a block of memory to a file, page by page ******/
+void ntr_memory::save_block(std::ofstream& file, u32 address, u32 length)
+{
+	while(length)
+	{
+		u32 chunk = std::min(length, (0x4000 - (address & 0x3FFF)));
+		file.write(reinterpret_cast<char*> (&(*this)[address]), chunk);
+
+		address += chunk;
+		length -= chunk;
+	}
+}
+
+/****** Points pages between two addresses to a region, repeating the region if the range is larger ******/
+void ntr_memory::map_region(u32 start, u32 end, std::vector<u8>& region, u32 offset)
+{
+	for(u32 x = start; x < end; x += 0x4000)
+	{
+		pages[x >> 14] = &region[(offset + x - start) % region.size()];
+	}
+}
+
+/****** Allocates a zero-filled page for memory that doesn't belong to any region ******/
+u8* ntr_memory::allocate_page(u32 address)
+{
+	unmapped_pages.push_back(std::vector<u8>(0x4000, 0));
+
+	u8* page = &unmapped_pages.back()[0];
+	pages[(address >> 14) & 0x3FFF] = page;
+
+	return page;
+}
+
 /****** MMU Constructor ******/
 NTR_MMU::NTR_MMU() 
 {
@@ -81,8 +217,7 @@ void NTR_MMU::reset()
 			break;
 	}	
 
-	memory_map.clear();
-	memory_map.resize(0x10000000, 0);
+	memory_map.reset();
 
 	cart_data.clear();
 
@@ -279,6 +414,7 @@ void NTR_MMU::reset()
 	g_pad = NULL;
 	nds9_timer = NULL;
 	nds7_timer = NULL;
+	scheduler = NULL;
 
 	dtcm_addr = 0xDEADC0DE;
 	dtcm_end = 0xDEADC0DE;
@@ -318,6 +454,7 @@ void NTR_MMU::reset()
 	}
 
 	access_mode = 1;
+	sync_request = false;
 	wram_mode = 3;
 	rumble_state = 0;
 	do_save = false;
@@ -337,6 +474,8 @@ void NTR_MMU::reset()
 	debug_access = 0;
 	#endif
 
+	update_vram_map();
+
 	std::cout<<"MMU::Initialized\n";
 }
 
@@ -350,6 +489,10 @@ u8 NTR_MMU::read_u8(u32 address)
 	debug_addr[(address & 0x3) + (access_mode << 2)] = address;
 	#endif
 
+	//Plain memory is read straight from the current CPU's page table
+	u8* page = get_read_page(address);
+	if(page != NULL) { return page[address & 0x3FFF]; }
+
 	//Check DTCM first
 	if((access_mode) && (!fetch_request) && (address >= dtcm_addr) && (address <= dtcm_end) && (!dtcm_load_mode))
 	{
@@ -410,6 +553,9 @@ u8 NTR_MMU::read_u8(u32 address)
 				address &= 0x400040F;
 			}
 
+			//IPC registers are shared with the other CPU, so let it catch up
+			else if(((address >= NDS_IPCSYNC) && (address <= (NDS_IPCFIFOSND + 3))) || ((address & ~0x3) == NDS_IPCFIFORECV)) { sync_request = true; }
+
 			break;
 
 		case 0x5:
@@ -530,9 +676,18 @@ u8 NTR_MMU::read_u8(u32 address)
 		if(access_mode && timer_cnt) { return ((nds9_timer->at(timer_id).cnt >> addr_shift) & 0xFF); }
 		else if(!access_mode && timer_cnt) { return ((nds7_timer->at(timer_id).cnt >> addr_shift) & 0xFF); }
 
-		//NDS9 and NDS7 timer counter
-		else if(access_mode && !timer_cnt) { return ((nds9_timer->at(timer_id).counter >> addr_shift) & 0xFF); }
-		else { return ((nds7_timer->at(timer_id).counter >> addr_shift) & 0xFF); }
+		//NDS9 and NDS7 timer counter - Bring counter up to date first
+		else if(access_mode && !timer_cnt)
+		{
+			sync_timer(timer_id);
+			return ((nds9_timer->at(timer_id).counter >> addr_shift) & 0xFF);
+		}
+
+		else
+		{
+			sync_timer(timer_id + 4);
+			return ((nds7_timer->at(timer_id).counter >> addr_shift) & 0xFF);
+		}
 	}
 
 	//Check for IPCSYNC
@@ -976,50 +1131,73 @@ u8 NTR_MMU::read_u8(u32 address)
 /****** Read 2 bytes from memory ******/
 u16 NTR_MMU::read_u16(u32 address)
 {
-	address &= ~0x1;
-	return ((read_u8(address+1) << 8) | read_u8(address)); 
+	return read<u16>(address);
 }
 
 /****** Read 4 bytes from memory ******/
 u32 NTR_MMU::read_u32(u32 address)
 {
-	//Misaligned word read
-	if(address & 0x3)
-	{
-		//Align by word, ROR value by offset
-		u8 offset = (address & 0x3);
-		address &= ~0x3;
+	u32 value = read<u32>(address);
 
-		switch(offset)
-		{
-			//ROR 8
-			case 0x1:
-				return ((read_u8(address) << 24) | (read_u8(address+3) << 16) | (read_u8(address+2) << 8) | read_u8(address+1));
+	//Misaligned word read - ROR aligned value by offset
+	u8 shift = ((address & 0x3) << 3);
+	if(shift) { value = (value >> shift) | (value << (32 - shift)); }
 
-			//ROR 16
-			case 0x2:
-				return ((read_u8(address+1) << 24) | (read_u8(address) << 16) | (read_u8(address+3) << 8) | read_u8(address+2));
+	return value;
+}
 
-			//ROR 24
-			case 0x3:
-				return ((read_u8(address+2) << 24) | (read_u8(address+1) << 16) | (read_u8(address) << 8) | read_u8(address+3));
-		}
+/****** Reads 1, 2, or 4 aligned bytes from memory - Plain memory is read with one load, everything else goes through read_u8() ******/
+template<typename T> T NTR_MMU::read(u32 address)
+{
+	//Always force alignment
+	address &= ~(sizeof(T) - 1);
+
+	u8* page = get_read_page(address);
+
+	if(page != NULL)
+	{
+		u8* data = &page[address & 0x3FFF];
+
+		if(sizeof(T) == 1) { return data[0]; }
+		else if(sizeof(T) == 2) { return ((data[1] << 8) | data[0]); }
+		else { return (((u32)data[3] << 24) | (data[2] << 16) | (data[1] << 8) | data[0]); }
 	}
 
-	return ((read_u8(address+3) << 24) | (read_u8(address+2) << 16) | (read_u8(address+1) << 8) | read_u8(address));
+	//Read from the highest byte down, so registers with side-effects on their lowest byte see it last
+	T value = 0;
+	for(s32 x = (sizeof(T) - 1); x >= 0; x--) { value |= ((T)read_u8(address + x) << (x * 8)); }
+
+	return value;
 }
 
+template u8 NTR_MMU::read<u8>(u32 address);
+template u16 NTR_MMU::read<u16>(u32 address);
+template u32 NTR_MMU::read<u32>(u32 address);
+
 /****** Reads 2 bytes from memory - No checks done on the read, used for known memory locations such as registers ******/
-u16 NTR_MMU::read_u16_fast(u32 address) const
+u16 NTR_MMU::read_u16_fast(u32 address)
 {
 	address &= ~0x1;
-	return ((memory_map[address+1] << 8) | memory_map[address]);
+
+	//Never allocates, so the renderer threads can use this too
+	u8* data = memory_map.get_page(address);
+	if(data == NULL) { return 0; }
+
+	data += (address & 0x3FFF);
+	return ((data[1] << 8) | data[0]);
 }
 
 /****** Reads 4 bytes from memory - No checks done on the read, used for known memory locations such as registers ******/
-u32 NTR_MMU::read_u32_fast(u32 address) const
+u32 NTR_MMU::read_u32_fast(u32 address)
 {
-	return ((memory_map[address+3] << 24) | (memory_map[address+2] << 16) | (memory_map[address+1] << 8) | memory_map[address]);
+	//Look up the page only once unless the read crosses into the next page
+	if((address & 0x3FFF) > 0x3FFC) { return ((memory_map.read(address+3) << 24) | (memory_map.read(address+2) << 16) | (memory_map.read(address+1) << 8) | memory_map.read(address)); }
+
+	u8* data = memory_map.get_page(address);
+	if(data == NULL) { return 0; }
+
+	data += (address & 0x3FFF);
+	return ((data[3] << 24) | (data[2] << 16) | (data[1] << 8) | data[0]);
 }
 
 /****** Reads 2 bytes from cartridge memory - No checks done on the read ******/
@@ -1044,6 +1222,15 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 	debug_addr[(address & 0x3) + (access_mode << 2)] = address;
 	#endif
 
+	//Plain memory is written straight through the current CPU's page table
+	u8* page = get_write_page(address);
+
+	if(page != NULL)
+	{
+		page[address & 0x3FFF] = value;
+		return;
+	}
+
 	//Check DTCM first
 	if((access_mode) && (address >= dtcm_addr) && (address <= dtcm_end))
 	{
@@ -1100,6 +1287,10 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 				address &= 0x400040F;
 			}
 
+			//IPC and WRAM/VRAM control registers are shared with the other CPU, so let it catch up
+			else if((address >= NDS_IPCSYNC) && (address <= (NDS_IPCFIFOSND + 3))) { sync_request = true; }
+			else if((address >= NDS_VRAMCNT_A) && (address <= NDS_VRAMCNT_I)) { sync_request = true; }
+
 			//Some 3D on NDS9 and sound on NDS7 share I/O addresses
 			//Process NDS9 stuff here
 			if((access_mode) && (address >= 0x4000400) && (address < 0x40005D0) && (power_cnt1 & 0x8))
@@ -1115,113 +1306,9 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 					case NDS_GXFIFO+2:
 					case NDS_GXFIFO+3:
 						memory_map[address] = value;
-						gx_fifo_entry = ((memory_map[NDS_GXFIFO+3] << 24) | (memory_map[NDS_GXFIFO+2] << 16) | (memory_map[NDS_GXFIFO+1] << 8) | memory_map[NDS_GXFIFO]);
 
-						if(address == NDS_GXFIFO)
-						{
-							bool delay_state = false;
-							bool nop = false;
-
-							//Determine if new command is packed or unpacked
-							if((lcd_3D_stat->gx_state & 0x1) == 0)
-							{
-								lcd_3D_stat->current_gx_command = 0;
-								lcd_3D_stat->fifo_params = 0;
-								gx_command = false;
-
-								//Begin processing packed commands
-								if(gx_fifo_entry & 0xFFFFFF00)
-								{
-									lcd_3D_stat->current_packed_command = gx_fifo_entry;
-									lcd_3D_stat->packed_command = true;
-									delay_state = true;
-
-									while(gx_fifo_entry)
-									{
-										nds9_gx_fifo.push(gx_fifo_entry & 0xFF);
-										gx_fifo_entry >>= 8;
-									}
-
-									lcd_3D_stat->current_gx_command = nds9_gx_fifo.front();
-									lcd_3D_stat->parameter_index = 0;
-									lcd_3D_stat->gx_state |= 0x1;
-								}
-
-								//Begin processing unpacked commands
-								else if(gx_fifo_entry & 0xFF)
-								{
-									lcd_3D_stat->packed_command = false;
-									delay_state = true;
-
-									nds9_gx_fifo.push(gx_fifo_entry);
-									lcd_3D_stat->current_gx_command = gx_fifo_entry & 0xFF;
-									lcd_3D_stat->parameter_index = 0;
-									lcd_3D_stat->gx_state |= 0x1;
-								}
-
-								//Ignore NOPs
-								else { nop = true; }
-
-								//Determine command parameter length
-								get_gx_fifo_param_length();
-
-								//If unpacked command has no parameters, wait for next command instead of waiting for parameters
-								if(!lcd_3D_stat->packed_command && !gx_fifo_param_length && !nop)
-								{
-									delay_state = false;
-									lcd_3D_stat->process_command = true;
-									lcd_3D_stat->gx_state &= ~0x1;
-									gx_command = true;
-								}	
-							}
-
-							//Gather parameters
-							else
-							{
-								if(gx_fifo_param_length)
-								{
-									lcd_3D_stat->command_parameters[lcd_3D_stat->parameter_index++] = memory_map[NDS_GXFIFO+3];
-									lcd_3D_stat->command_parameters[lcd_3D_stat->parameter_index++] = memory_map[NDS_GXFIFO+2];
-									lcd_3D_stat->command_parameters[lcd_3D_stat->parameter_index++] = memory_map[NDS_GXFIFO+1];
-									lcd_3D_stat->command_parameters[lcd_3D_stat->parameter_index++] = memory_map[NDS_GXFIFO];
-									gx_fifo_param_length--;
-								}
-
-								//FIFO entry is finished - Process command if all parameters gathered
-								if(!gx_fifo_param_length)
-								{
-									lcd_3D_stat->process_command = true;
-									lcd_3D_stat->gx_state &= ~0x1;
-									lcd_3D_stat->parameter_index = (lcd_3D_stat->fifo_params & 0xFF) * 4;
-									gx_command = true;
-								}
-							}
-
-							if(delay_state) { lcd_3D_stat->gx_state |= 0x1; }
-
-							//Set GX_STAT Geometry Engine busy flag
-							lcd_3D_stat->gx_stat &= ~0x8000000;
-
-							//Set GX_STAT FIFO less than half full flag
-							lcd_3D_stat->gx_stat |= 0x2000000;
-
-							//GXFIFO half empty IRQ
-							if((lcd_3D_stat->gx_stat & 0xC0000000) == 0x40000000) { nds9_if |= 0x200000; }
-
-							//Set GX_STAT FIFO empty flag
-							if(nds9_gx_fifo.empty())
-							{
-								lcd_3D_stat->gx_stat |= 0x4000000;
-								
-								//GXFIFO empty IRQ
-								if((lcd_3D_stat->gx_stat & 0xC0000000) == 0x80000000) { nds9_if |= 0x200000; }
-							}
-
-							else
-							{
-								lcd_3D_stat->gx_stat &= ~0x4000000;
-							}
-						}
+						//The whole entry is taken once its lowest byte is written
+						if(address == NDS_GXFIFO) { process_gx_fifo(); }
 
 						break;
 
@@ -1606,6 +1693,9 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 						break;
 						
 				}
+
+				//Let the geometry engine process any completed commands on the next cycle
+				if(lcd_3D_stat->process_command) { schedule_event(NTR_GX_EVENT, scheduler->nds9_cycle + 1); }
 			}
 
 			break;
@@ -1622,6 +1712,9 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 				return;
 			}
 
+			//Drop writes to VRAM without a bank
+			if(memory_map.get_vram_offset(address) == 0xFFFFFFFF) { return; }
+
 			break;
 
 		case 0x7:
@@ -1783,6 +1876,10 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 			lcd_stat->current_scanline = (memory_map[NDS_VCOUNT+1] << 8) | memory_map[NDS_VCOUNT];
 			lcd_stat->lcd_clock = (2130 * lcd_stat->current_scanline);
 			lcd_stat->lcd_mode = (lcd_stat->lcd_clock < 4089600) ? 0 : 2;
+
+			//LCD timing restarts from here
+			scheduler->lcd_sync = scheduler->nds9_cycle;
+			schedule_event(NTR_LCD_EVENT, scheduler->nds9_cycle + 1);
 			break;
 
 		case NDS_VCOUNT+1:
@@ -1790,6 +1887,10 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 			lcd_stat->current_scanline = (memory_map[NDS_VCOUNT+1] << 8) | memory_map[NDS_VCOUNT];
 			lcd_stat->lcd_clock = (2130 * lcd_stat->current_scanline);
 			lcd_stat->lcd_mode = (lcd_stat->lcd_clock < 4089600) ? 0 : 2;
+
+			//LCD timing restarts from here
+			scheduler->lcd_sync = scheduler->nds9_cycle;
+			schedule_event(NTR_LCD_EVENT, scheduler->nds9_cycle + 1);
 			break;
 
 		//BG0 Control A
@@ -2960,16 +3061,16 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 		case NDS_BLDALPHA_A:
 			memory_map[address] = value;
 
-			if(value & 0x10) { lcd_stat->alpha_coef_a[0] = 1.0; }
-			else { lcd_stat->alpha_coef_a[0] = (value & 0xF) / 16.0; }
+			if(value & 0x10) { lcd_stat->alpha_coef_a[0] = 0x10; }
+			else { lcd_stat->alpha_coef_a[0] = (value & 0xF); }
 			
 			break;
 
 		case NDS_BLDALPHA_A+1:
 			memory_map[address] = value;
 
-			if(value & 0x10) { lcd_stat->alpha_coef_a[1] = 1.0; }
-			else { lcd_stat->alpha_coef_a[1] = (value & 0xF) / 16.0; }
+			if(value & 0x10) { lcd_stat->alpha_coef_a[1] = 0x10; }
+			else { lcd_stat->alpha_coef_a[1] = (value & 0xF); }
 
 			break;
 
@@ -2978,8 +3079,8 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 			if(memory_map[address] == value) { return ; }
 
 			memory_map[address] = value;
-			if(value & 0x10) { lcd_stat->brightness_coef_a = 1.0; }
-			else { lcd_stat->brightness_coef_a = (value & 0xF) / 16.0; }
+			if(value & 0x10) { lcd_stat->brightness_coef_a = 0x10; }
+			else { lcd_stat->brightness_coef_a = (value & 0xF); }
 
 			break;
 
@@ -3017,16 +3118,16 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 		case NDS_BLDALPHA_B:
 			memory_map[address] = value;
 
-			if(value & 0x10) { lcd_stat->alpha_coef_b[0] = 1.0; }
-			else { lcd_stat->alpha_coef_b[0] = (value & 0xF) / 16.0; }
+			if(value & 0x10) { lcd_stat->alpha_coef_b[0] = 0x10; }
+			else { lcd_stat->alpha_coef_b[0] = (value & 0xF); }
 
 			break;
 
 		case NDS_BLDALPHA_B+1:
 			memory_map[address] = value;
 
-			if(value & 0x10) { lcd_stat->alpha_coef_b[1] = 1.0; }
-			else { lcd_stat->alpha_coef_b[1] = (value & 0xF) / 16.0; }
+			if(value & 0x10) { lcd_stat->alpha_coef_b[1] = 0x10; }
+			else { lcd_stat->alpha_coef_b[1] = (value & 0xF); }
 
 			break;
 
@@ -3035,8 +3136,8 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 			if(memory_map[address] == value) { return ; }
 
 			memory_map[address] = value;
-			if(value & 0x10) { lcd_stat->brightness_coef_b = 1.0; }
-			else { lcd_stat->brightness_coef_b = (value & 0xF) / 16.0; }
+			if(value & 0x10) { lcd_stat->brightness_coef_b = 0x10; }
+			else { lcd_stat->brightness_coef_b = (value & 0xF); }
 
 			break;
 
@@ -3066,6 +3167,7 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 			{
 				memory_map[address] = (value & 0x3);
 				wram_mode = (value & 0x3);
+				update_page_tables();
 			}
 
 			break;
@@ -3082,7 +3184,6 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 		case NDS_VRAMCNT_I:
 			if(access_mode)
 			{
-				u8 old_mst = (memory_map[address] & 0x7);
 				memory_map[address] = value;
 
 				u8 mst = (value & 0x7);
@@ -3294,11 +3395,13 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 				else
 				{
 					lcd_stat->vram_bank_enable[bank_id] = false;
-
-					//Deallocate VRAM when disabling a bank 
-					deallocate_vram(bank_id, old_mst);
 				}
 
+				//Remap VRAM banks, disabled banks simply drop out of BG/OBJ VRAM
+				//NDS7 writes to its own banks are not tracked, so decode every tile again
+				update_vram_map();
+				lcd_stat->vram_tile_update_list.assign(lcd_stat->vram_tile_update_list.size(), true);
+
 				//Check if any banks for Engine A BG are enabled for use
 				bg_vram_bank_enable_a = false;
 				
@@ -3432,6 +3535,7 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 				dma[0].enable = true;
 				dma[0].started = false;
 				dma[0].delay = 2;
+				schedule_event(NTR_NDS9_DMA_EVENT, scheduler->nds9_cycle + 1);
 			}
 
 			//NDS7 DMA0 CNT
@@ -3447,6 +3551,7 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 				dma[4].enable = true;
 				dma[4].started = false;
 				dma[4].delay = 2;
+				schedule_event(NTR_NDS7_DMA_EVENT, scheduler->nds7_cycle + 1);
 			}
 
 			break;
@@ -3514,6 +3619,7 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 				dma[1].enable = true;
 				dma[1].started = false;
 				dma[1].delay = 2;
+				schedule_event(NTR_NDS9_DMA_EVENT, scheduler->nds9_cycle + 1);
 			}
 
 			//NDS7 DMA1 CNT
@@ -3529,6 +3635,7 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 				dma[5].enable = true;
 				dma[5].started = false;
 				dma[5].delay = 2;
+				schedule_event(NTR_NDS7_DMA_EVENT, scheduler->nds7_cycle + 1);
 			}
 
 			break;
@@ -3596,6 +3703,7 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 				dma[2].enable = true;
 				dma[2].started = false;
 				dma[2].delay = 2;
+				schedule_event(NTR_NDS9_DMA_EVENT, scheduler->nds9_cycle + 1);
 			}
 
 			//NDS7 DMA2 CNT
@@ -3611,6 +3719,7 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 				dma[6].enable = true;
 				dma[6].started = false;
 				dma[6].delay = 2;
+				schedule_event(NTR_NDS7_DMA_EVENT, scheduler->nds7_cycle + 1);
 			}
 
 			break;
@@ -3678,6 +3787,7 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 				dma[3].enable = true;
 				dma[3].started = false;
 				dma[3].delay = 2;
+				schedule_event(NTR_NDS9_DMA_EVENT, scheduler->nds9_cycle + 1);
 			}
 
 			//NDS7 DMA3 CNT
@@ -3693,6 +3803,7 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 				dma[7].enable = true;
 				dma[7].started = false;
 				dma[7].delay = 2;
+				schedule_event(NTR_NDS7_DMA_EVENT, scheduler->nds7_cycle + 1);
 			}
 
 			break;
@@ -3818,6 +3929,10 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 			{
 				//Grab pointer to NDS9 or NDS7 Timer 0
 				nds_timer* timer = (access_mode) ? &nds9_timer->at(0) : &nds7_timer->at(0);
+				u8 timer_id = (access_mode) ? 0 : 4;
+
+				//Bring counter up to date before changing how it counts
+				sync_timer(timer_id);
 
 				bool prev_enable = (timer->cnt & 0x80) ?  true : false;
 				timer->cnt &= (address & 0x1) ? 0xFF : 0xFF00;
@@ -3837,7 +3952,8 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 
 				if(timer->count_up) { timer->prescalar = 1; }
 
-				timer->clock = (timer->prescalar - 1);
+				timer->clock = timer->prescalar;
+				schedule_timer(timer_id);
 			}
 
 			break;
@@ -3848,6 +3964,10 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 			{
 				//Grab pointer to NDS9 or NDS7 Timer 1
 				nds_timer* timer = (access_mode) ? &nds9_timer->at(1) : &nds7_timer->at(1);
+				u8 timer_id = (access_mode) ? 1 : 5;
+
+				//Bring counter up to date before changing how it counts
+				sync_timer(timer_id);
 
 				bool prev_enable = (timer->cnt & 0x80) ?  true : false;
 				timer->cnt &= (address & 0x1) ? 0xFF : 0xFF00;
@@ -3868,7 +3988,8 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 
 				if(timer->count_up) { timer->prescalar = 1; }
 
-				timer->clock = timer->prescalar; 
+				timer->clock = timer->prescalar;
+				schedule_timer(timer_id);
 			}
 
 			break;
@@ -3879,6 +4000,10 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 			{
 				//Grab pointer to NDS9 or NDS7 Timer 2
 				nds_timer* timer = (access_mode) ? &nds9_timer->at(2) : &nds7_timer->at(2);
+				u8 timer_id = (access_mode) ? 2 : 6;
+
+				//Bring counter up to date before changing how it counts
+				sync_timer(timer_id);
 
 				bool prev_enable = (timer->cnt & 0x80) ?  true : false;
 				timer->cnt &= (address & 0x1) ? 0xFF : 0xFF00;
@@ -3899,7 +4024,8 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 
 				if(timer->count_up) { timer->prescalar = 1; }
 
-				timer->clock = timer->prescalar; 
+				timer->clock = timer->prescalar;
+				schedule_timer(timer_id);
 			}
 
 			break;
@@ -3910,6 +4036,10 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 			{
 				//Grab pointer to NDS9 or NDS7 Timer 3
 				nds_timer* timer = (access_mode) ? &nds9_timer->at(3) : &nds7_timer->at(3);
+				u8 timer_id = (access_mode) ? 3 : 7;
+
+				//Bring counter up to date before changing how it counts
+				sync_timer(timer_id);
 
 				bool prev_enable = (timer->cnt & 0x80) ?  true : false;
 				timer->cnt &= (address & 0x1) ? 0xFF : 0xFF00;
@@ -3930,7 +4060,8 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 
 				if(timer->count_up) { timer->prescalar = 1; }
 
-				timer->clock = timer->prescalar; 
+				timer->clock = timer->prescalar;
+				schedule_timer(timer_id);
 			}
 
 			break;
@@ -5022,7 +5153,11 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 			{
 				lcd_3D_stat->current_gx_command = 0x60;
 				lcd_3D_stat->command_parameters[lcd_3D_stat->parameter_index++] = value;
-				if(lcd_3D_stat->parameter_index == 4) { lcd_3D_stat->process_command = true; }
+				if(lcd_3D_stat->parameter_index == 4)
+				{
+					lcd_3D_stat->process_command = true;
+					schedule_event(NTR_GX_EVENT, scheduler->nds9_cycle + 1);
+				}
 			}
 			
 			break;
@@ -5032,6 +5167,114 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 			break;
 	}
 
+	//Palettes, extended palettes, and OAM have to flag LCD updates
+	mark_lcd_write(address);
+
+	//Toon Table
+	if((address >= 0x4000380) && (address <= 0x400003BF) && (access_mode))
+	{
+		u8 toon_id = (address & 0x3F) >> 1;
+
+		u32 color_addr = (address & ~0x1);
+		u16 color_bytes = (memory_map[color_addr + 1] << 8) | memory_map[color_addr];
+
+		u8 red = ((color_bytes & 0x1F) << 3);
+		color_bytes >>= 5;
+
+		u8 green = ((color_bytes & 0x1F) << 3);
+		color_bytes >>= 5;
+
+		u8 blue = ((color_bytes & 0x1F) << 3);
+
+		lcd_3D_stat->toon_table[toon_id] = 0xFF000000 | (red << 16) | (green << 8) | (blue);
+	}
+}
+
+/****** Write 2 bytes into memory ******/
+void NTR_MMU::write_u16(u32 address, u16 value)
+{
+	write<u16>(address, value);
+}
+
+/****** Write 4 bytes into memory ******/
+void NTR_MMU::write_u32(u32 address, u32 value)
+{
+	write<u32>(address, value);
+}
+
+/****** Writes 1, 2, or 4 aligned bytes into memory - Plain memory is written with one store, everything else goes through write_u8() ******/
+template<typename T> void NTR_MMU::write(u32 address, T value)
+{
+	//Always force alignment
+	address &= ~(sizeof(T) - 1);
+
+	u8* page = get_write_page(address);
+
+	if(page != NULL)
+	{
+		u8* data = &page[address & 0x3FFF];
+
+		for(u32 x = 0; x < sizeof(T); x++) { data[x] = ((value >> (x * 8)) & 0xFF); }
+		return;
+	}
+
+	//Write from the highest byte down, so registers that act on their lowest byte see the whole value
+	for(s32 x = (sizeof(T) - 1); x >= 0; x--) { write_u8((address + x), ((value >> (x * 8)) & 0xFF)); }
+}
+
+template void NTR_MMU::write<u8>(u32 address, u8 value);
+template void NTR_MMU::write<u16>(u32 address, u16 value);
+template void NTR_MMU::write<u32>(u32 address, u32 value);
+
+/****** Writes 2 bytes into memory - No checks done on the read, used for known memory locations such as registers ******/
+void NTR_MMU::write_u16_fast(u32 address, u16 value)
+{
+	//Always force half-word alignment
+	address &= ~0x1;
+
+	memory_map[address] = (value & 0xFF);
+	memory_map[address+1] = ((value >> 8) & 0xFF);
+}
+
+/****** Writes 4 bytes into memory - No checks done on the read, used for known memory locations such as registers ******/
+void NTR_MMU::write_u32_fast(u32 address, u32 value)
+{
+	//Always force word alignment
+	address &= ~0x3;
+
+	memory_map[address] = (value & 0xFF);
+	memory_map[address+1] = ((value >> 8) & 0xFF);
+	memory_map[address+2] = ((value >> 16) & 0xFF);
+	memory_map[address+3] = ((value >> 24) & 0xFF);
+}
+
+/****** Writes 8 bytes into memory - No checks done on the read, used for known memory locations such as registers ******/
+void NTR_MMU::write_u64_fast(u32 address, u64 value)
+{
+	memory_map[address] = (value & 0xFF);
+	memory_map[address+1] = ((value >> 8) & 0xFF);
+	memory_map[address+2] = ((value >> 16) & 0xFF);
+	memory_map[address+3] = ((value >> 24) & 0xFF);
+
+	value >>= 16;
+	value >>= 16;
+
+	memory_map[address+4] = (value & 0xFF);
+	memory_map[address+5] = ((value >> 8) & 0xFF);
+	memory_map[address+6] = ((value >> 16) & 0xFF);
+	memory_map[address+7] = ((value >> 24) & 0xFF);
+}
+
+/****** Flags palette, extended palette, and OAM writes so the LCD updates its copies ******/
+void NTR_MMU::mark_lcd_write(u32 address)
+{
+	//Trigger tile decoding in LCD - Tracked by where the write lands in the VRAM banks, since banks can be mapped anywhere
+	if((address >> 24) == 0x6)
+	{
+		u32 offset = memory_map.get_vram_offset(address);
+		if(offset != 0xFFFFFFFF) { lcd_stat->vram_tile_update_list[offset >> 5] = true; }
+	}
+
 	//Trigger BG palette update in LCD - Engine A
 	if((address >= 0x5000000) && (address <= 0x50001FF))
 	{
@@ -5108,86 +5351,311 @@ void NTR_MMU::write_u8(u32 address, u8 value)
 		lcd_stat->oam_update = true;
 		lcd_stat->oam_update_list[(address & 0x7FF) >> 3] = true;
 	}
+}
 
-	//Toon Table
-	else if((address >= 0x4000380) && (address <= 0x400003BF) && (access_mode))
+/****** Returns the current CPU's page for a plain memory read, or NULL if the read needs the full handler ******/
+u8* NTR_MMU::get_read_page(u32 address)
+{
+	if(address >= 0x10000000) { return NULL; }
+	else if(!access_mode) { return nds7_pages[address >> 14]; }
+	else if(fetch_request) { return nds9_fetch_pages[address >> 14]; }
+	else { return nds9_read_pages[address >> 14]; }
+}
+
+/****** Returns the current CPU's page for a plain memory write, or NULL if the write needs the full handler ******/
+u8* NTR_MMU::get_write_page(u32 address)
+{
+	if(address >= 0x10000000) { return NULL; }
+	else if(!access_mode) { return nds7_pages[address >> 14]; }
+	else { return nds9_write_pages[address >> 14]; }
+}
+
+/****** Moves the remaining units of a DMA, copying runs of plain memory directly ******/
+void NTR_MMU::dma_transfer(u8 index)
+{
+	u8 unit = (dma[index].word_type) ? 4 : 2;
+
+	//Align addresses to half-word or word
+	dma[index].start_address &= ~(unit - 1);
+	dma[index].destination_address &= ~(unit - 1);
+
+	//Work out how each address moves per unit - Increment/Reload counts as increment, fills are fixed
+	s32 src_step = unit;
+	s32 dest_step = unit;
+
+	if(dma[index].src_addr_ctrl == 1) { src_step = -unit; }
+	else if((dma[index].src_addr_ctrl == 2) || (dma[index].src_addr_ctrl == 4)) { src_step = 0; }
+
+	if(dma[index].dest_addr_ctrl == 1) { dest_step = -unit; }
+	else if(dma[index].dest_addr_ctrl == 2) { dest_step = 0; }
+
+	while(dma[index].word_count != 0)
 	{
-		u8 toon_id = (address & 0x3F) >> 1;
+		u32 count = 0;
 
-		u32 color_addr = (address & ~0x1);
-		u16 color_bytes = (memory_map[color_addr + 1] << 8) | memory_map[color_addr];
+		if((dest_step > 0) && (src_step >= 0))
+		{
+			count = dma_block(dma[index].destination_address, dma[index].start_address, dma[index].word_count, unit, (src_step == 0));
+		}
 
-		u8 red = ((color_bytes & 0x1F) << 3);
-		color_bytes >>= 5;
+		//Everything else moves one unit at a time through the full handlers
+		if(count == 0)
+		{
+			if(unit == 2) { write_u16(dma[index].destination_address, read_u16(dma[index].start_address)); }
+			else { write_u32(dma[index].destination_address, read_u32(dma[index].start_address)); }
 
-		u8 green = ((color_bytes & 0x1F) << 3);
-		color_bytes >>= 5;
+			count = 1;
+		}
 
-		u8 blue = ((color_bytes & 0x1F) << 3);
+		dma[index].start_address += (src_step * count);
+		dma[index].destination_address += (dest_step * count);
+		dma[index].word_count -= count;
+	}
+}
 
-		lcd_3D_stat->toon_table[toon_id] = 0xFF000000 | (red << 16) | (green << 8) | (blue);
+/****** Copies or fills plain memory for DMA and BIOS copies, up to the end of the current run - Returns the number of units moved ******/
+u32 NTR_MMU::dma_block(u32 dest_addr, u32 src_addr, u32 count, u8 unit, bool fixed_src)
+{
+	u32 src_room = (fixed_src) ? unit : (count * unit);
+	u32 dest_room = (count * unit);
+
+	u8* src = get_host_read(src_addr, src_room);
+	u8* dest = get_host_write(dest_addr, dest_room);
+
+	//DMA fills keep reading the same DMAFILL register
+	if((src == NULL) && (fixed_src) && (access_mode) && (src_addr >= NDS_DMA0FILL) && (src_addr < (NDS_DMA0FILL + 0x10)))
+	{
+		src = &memory_map[src_addr];
+		src_room = unit;
+	}
+
+	if((src == NULL) || (dest == NULL)) { return 0; }
+
+	//Stop at the end of the source or destination run
+	if(count > (dest_room / unit)) { count = (dest_room / unit); }
+	if((!fixed_src) && (count > (src_room / unit))) { count = (src_room / unit); }
+	if((count == 0) || (src_room < unit)) { return 0; }
+
+	u32 length = count * unit;
+
+	//Fill with the same unit
+	if(fixed_src)
+	{
+		u8 fill[4] = { src[0], src[1], 0, 0 };
+		if(unit == 4) { fill[2] = src[2]; fill[3] = src[3]; }
+
+		for(u32 x = 0; x < length; x++) { dest[x] = fill[x & (unit - 1)]; }
 	}
+
+	//Copy blocks that don't overlap all at once
+	else if(((dest + length) <= src) || ((src + length) <= dest)) { std::copy(src, src + length, dest); }
+
+	//Overlapping blocks copy forward, the same as moving one unit at a time
+	else { for(u32 x = 0; x < length; x++) { dest[x] = src[x]; } }
+
+	mark_host_write(dest_addr, length);
+	return count;
 }
 
-/****** Write 2 bytes into memory ******/
-void NTR_MMU::write_u16(u32 address, u16 value)
+/****** Returns host memory the current CPU can read directly - Length is cut down to the bytes available in one run ******/
+u8* NTR_MMU::get_host_read(u32 address, u32 &length)
 {
-	//Always force half-word alignment
-	address &= ~0x1;
+	u8** pages = nds7_pages;
+	if(access_mode) { pages = (fetch_request) ? nds9_fetch_pages : nds9_read_pages; }
 
-	write_u8((address+1), ((value >> 8) & 0xFF));
-	write_u8(address, (value & 0xFF));
+	return get_host_run(pages, address, length);
 }
 
-/****** Write 4 bytes into memory ******/
-void NTR_MMU::write_u32(u32 address, u32 value)
+/****** Returns host memory the current CPU can write directly - Call mark_host_write() once done writing ******/
+u8* NTR_MMU::get_host_write(u32 address, u32 &length)
 {
-	//Always force word alignment
-	address &= ~0x3;
+	u8** pages = (access_mode) ? nds9_write_pages : nds7_pages;
+
+	//NDS9 palettes, VRAM, and OAM are plain memory, but writes there have to flag LCD updates
+	if((access_mode) && (address >= 0x5000000) && (address < 0x8000000) && (nds9_write_pages[address >> 14] == NULL)) { pages = nds9_read_pages; }
 
-	write_u8((address+3), ((value >> 24) & 0xFF));
-	write_u8((address+2), ((value >> 16) & 0xFF));
-	write_u8((address+1), ((value >> 8) & 0xFF));
-	write_u8(address, (value & 0xFF));
+	//VRAM without a bank drops writes, so it is never handed out
+	if((access_mode) && ((address >> 24) == 0x6) && (memory_map.get_vram_offset(address) == 0xFFFFFFFF)) { length = 0; return NULL; }
+
+	return get_host_run(pages, address, length);
 }
 
-/****** Writes 2 bytes into memory - No checks done on the read, used for known memory locations such as registers ******/
-void NTR_MMU::write_u16_fast(u32 address, u16 value)
+/****** Flags LCD updates after the NDS9 writes palettes, VRAM, or OAM through get_host_write() ******/
+void NTR_MMU::mark_host_write(u32 address, u32 length)
 {
-	//Always force half-word alignment
-	address &= ~0x1;
+	if((length == 0) || (!access_mode) || (address < 0x5000000) || (address >= 0x8000000) || (nds9_write_pages[address >> 14] != NULL)) { return; }
 
-	memory_map[address] = (value & 0xFF);
-	memory_map[address+1] = ((value >> 8) & 0xFF);
+	//Palettes and OAM are mirrored, VRAM is not
+	for(u32 x = (address & ~0x1); x < (address + length); x += 2)
+	{
+		if((x >> 24) == 0x6) { mark_lcd_write(x); }
+		else { mark_lcd_write(x & 0xF007FFF); }
+	}
 }
 
-/****** Writes 4 bytes into memory - No checks done on the read, used for known memory locations such as registers ******/
-void NTR_MMU::write_u32_fast(u32 address, u32 value)
+/****** Returns host memory from a page table - Length is cut down to the bytes that follow one another in host memory ******/
+u8* NTR_MMU::get_host_run(u8** pages, u32 address, u32 &length)
 {
-	//Always force word alignment
-	address &= ~0x3;
+	if((address >= 0x10000000) || (pages[address >> 14] == NULL)) { length = 0; return NULL; }
 
-	memory_map[address] = (value & 0xFF);
-	memory_map[address+1] = ((value >> 8) & 0xFF);
-	memory_map[address+2] = ((value >> 16) & 0xFF);
-	memory_map[address+3] = ((value >> 24) & 0xFF);
+	u8* data = &pages[address >> 14][address & 0x3FFF];
+	u32 run = 0x4000 - (address & 0x3FFF);
+
+	//Regions are single buffers, so pages keep following on until the region ends or mirrors
+	while((run < length) && ((address + run) < 0x10000000) && (pages[(address + run) >> 14] == (data + run))) { run += 0x4000; }
+
+	if(run < length) { length = run; }
+	return data;
 }
 
-/****** Writes 8 bytes into memory - No checks done on the read, used for known memory locations such as registers ******/
-void NTR_MMU::write_u64_fast(u32 address, u64 value)
+/****** Maps VRAM banks into BG/OBJ VRAM based on VRAMCNT, then rebuilds the CPU page tables ******/
+void NTR_MMU::update_vram_map()
 {
-	memory_map[address] = (value & 0xFF);
-	memory_map[address+1] = ((value >> 8) & 0xFF);
-	memory_map[address+2] = ((value >> 16) & 0xFF);
-	memory_map[address+3] = ((value >> 24) & 0xFF);
+	u32 bank_window[9];
 
-	value >>= 16;
-	value >>= 16;
+	for(u32 bank_id = 0; bank_id < 9; bank_id++)
+	{
+		//VRAMCNT_H and VRAMCNT_I come after WRAMCNT
+		u8 cnt = memory_map[NDS_VRAMCNT_A + bank_id + ((bank_id > 6) ? 1 : 0)];
+		u8 mst = (cnt & 0x7);
 
-	memory_map[address+4] = (value & 0xFF);
-	memory_map[address+5] = ((value >> 8) & 0xFF);
-	memory_map[address+6] = ((value >> 16) & 0xFF);
-	memory_map[address+7] = ((value >> 24) & 0xFF);
+		//Bit 2 of MST is unused by banks A, B, H, and I
+		if((bank_id < 2) || (bank_id > 6)) { mst &= 0x3; }
+
+		bank_window[bank_id] = 0;
+
+		//Only MST settings that place a bank in BG/OBJ VRAM get a window there
+		//Texture and palette slots are addressed through the LCDC area, which always holds every bank
+		if(cnt & 0x80)
+		{
+			switch(mst)
+			{
+				case 0x1:
+					bank_window[bank_id] = lcd_stat->vram_bank_addr[bank_id];
+					break;
+
+				case 0x2:
+					if(bank_id != 7) { bank_window[bank_id] = lcd_stat->vram_bank_addr[bank_id]; }
+					break;
+
+				case 0x4:
+					if((bank_id == 2) || (bank_id == 3)) { bank_window[bank_id] = lcd_stat->vram_bank_addr[bank_id]; }
+					break;
+			}
+		}
+	}
+
+	memory_map.map_vram(bank_window);
+	update_page_tables();
+}
+
+/****** Rebuilds the ARM9 and ARM7 page tables used for plain memory accesses ******/
+void NTR_MMU::update_page_tables()
+{
+	for(u32 x = 0; x < 0x4000; x++)
+	{
+		u32 addr = (x << 14);
+
+		u8* nds9_page = NULL;
+		u8* nds7_page = NULL;
+		bool nds9_write = true;
+
+		switch(addr >> 24)
+		{
+			//ITCM - NDS9 only
+			case 0x0:
+				nds9_page = memory_map.get_page(addr & 0x7FFF);
+				break;
+
+			//Main RAM
+			case 0x2:
+				nds9_page = memory_map.get_page(addr & 0x23FFFFF);
+				nds7_page = nds9_page;
+				break;
+
+			//Shared WRAM and NDS7 WRAM
+			case 0x3:
+				switch(wram_mode)
+				{
+					case 0x0:
+						nds9_page = memory_map.get_page(addr & 0x3007FFF);
+						nds7_page = memory_map.get_page(0x3800000 | (addr & 0xFFFF));
+						break;
+
+					case 0x1:
+						nds9_page = memory_map.get_page(0x3004000 | (addr & 0x3FFF));
+						nds7_page = memory_map.get_page(0x3000000 | (addr & 0x3FFF));
+						break;
+
+					case 0x2:
+						nds9_page = memory_map.get_page(0x3000000 | (addr & 0x3FFF));
+						nds7_page = memory_map.get_page(0x3004000 | (addr & 0x3FFF));
+						break;
+
+					case 0x3:
+						nds7_page = memory_map.get_page(addr & 0x3007FFF);
+						break;
+				}
+
+				if(addr >= 0x3800000) { nds7_page = memory_map.get_page(addr & 0x380FFFF); }
+				break;
+
+			//Palettes and OAM - NDS9 writes have to flag LCD updates
+			case 0x5:
+			case 0x7:
+				nds9_page = memory_map.get_page(addr & 0xF007FFF);
+				nds9_write = false;
+				break;
+
+			//VRAM - NDS9 writes have to flag LCD updates, NDS7 sees its own VRAM
+			case 0x6:
+				nds9_page = memory_map.get_page(addr);
+				nds9_write = false;
+				nds7_page = &nds7_vwram[addr & 0x3FFFF];
+				break;
+		}
+
+		nds9_read_pages[x] = nds9_page;
+		nds9_write_pages[x] = (nds9_write) ? nds9_page : NULL;
+		nds9_fetch_pages[x] = nds9_page;
+		nds7_pages[x] = nds7_page;
+	}
+
+	//DTCM sits over NDS9 data accesses, but not opcode fetches
+	//Pages only partially covered by DTCM go through the full handlers
+	if(dtcm_addr < 0x10000000)
+	{
+		for(u32 x = (dtcm_addr >> 14); (x < 0x4000) && ((x << 14) <= dtcm_end); x++)
+		{
+			u32 addr = (x << 14);
+			u8* page = NULL;
+
+			if(((dtcm_addr & 0x3FFF) == 0) && (addr >= dtcm_addr) && ((addr + 0x3FFF) < dtcm_end)) { page = &dtcm[0]; }
+
+			nds9_write_pages[x] = page;
+			if(!dtcm_load_mode) { nds9_read_pages[x] = page; }
+		}
+	}
+}
+
+/****** Checks whether a polling loop can read from this address without waiting on anything other than the other CPU or scheduled events ******/
+bool NTR_MMU::is_idle_poll_address(u32 address) const
+{
+	//DISPSTAT and VCOUNT
+	if((address >= NDS_DISPSTAT) && (address <= (NDS_VCOUNT + 1))) { return true; }
+
+	//KEYINPUT and EXTKEYIN
+	if((address == NDS_KEYINPUT) || (address == (NDS_KEYINPUT + 1))) { return true; }
+	if((address == NDS_EXTKEYIN) || (address == (NDS_EXTKEYIN + 1))) { return true; }
+
+	//IPCSYNC and IPCFIFOCNT
+	if((address >= NDS_IPCSYNC) && (address <= (NDS_IPCFIFOCNT + 1))) { return true; }
+
+	//IME, IE, and IF
+	if((address >= NDS_IME) && (address <= (NDS_IME + 3))) { return true; }
+	if((address >= NDS_IE) && (address <= (NDS_IF + 3))) { return true; }
+
+	return false;
 }
 
 /****** Read binary file to memory ******/
@@ -5290,7 +5758,7 @@ bool NTR_MMU::read_slot2_file(std::string filename)
 	if(file_size > 0x2000000) { file_size = 0x2000000; }
 
 	//Read data from the ROM file
-	file.read(reinterpret_cast<char*> (&memory_map[0x8000000]), file_size);
+	memory_map.load_block(file, 0x8000000, file_size);
 
 	file.close();
 
@@ -5373,7 +5841,7 @@ bool NTR_MMU::read_slot2_file(std::string filename)
 		}
 
 		//Read data from file
-		file.read(reinterpret_cast<char*> (&memory_map[0xE000000]), 0x8000);
+		memory_map.load_block(file, 0xE000000, 0x8000);
 	}
 
 	//Load 64KB FLASH RAM
@@ -5389,7 +5857,7 @@ bool NTR_MMU::read_slot2_file(std::string filename)
 		}
 
 		//Read data from file
-		file.read(reinterpret_cast<char*> (&memory_map[0xE000000]), 0x10d000);
+		memory_map.load_block(file, 0xE000000, 0x10d000);
 	}
 
 	std::cout<<"MMU::GBA save file" << filename << " loaded successfully. \n";
@@ -5671,6 +6139,59 @@ void NTR_MMU::start_dma(u8 dma_bits)
 	}
 }
 
+/****** Schedules an event on the NDS9 or NDS7 ******/
+void NTR_MMU::schedule_event(u8 event_type, u64 event_cycle)
+{
+	scheduler->event_time[event_type] = event_cycle;
+
+	if(event_type < NTR_NDS7_TIMER0_EVENT)
+	{
+		if(event_cycle < scheduler->nds9_next_event) { scheduler->nds9_next_event = event_cycle; }
+	}
+
+	else if(event_cycle < scheduler->nds7_next_event) { scheduler->nds7_next_event = event_cycle; }
+}
+
+/****** Brings a timer's counter up to date with its CPU's clock - Timers 0-3 are NDS9, 4-7 are NDS7 ******/
+void NTR_MMU::sync_timer(u8 timer_id)
+{
+	nds_timer* timer = (timer_id < 4) ? &nds9_timer->at(timer_id) : &nds7_timer->at(timer_id & 0x3);
+	u64 current_cycle = (timer_id < 4) ? scheduler->nds9_cycle : scheduler->nds7_cycle;
+
+	u64 elapsed = current_cycle - scheduler->timer_sync[timer_id];
+	scheduler->timer_sync[timer_id] = current_cycle;
+
+	//Count-up timers are only incremented when the previous timer overflows
+	if((!timer->enable) || (timer->count_up) || (elapsed == 0)) { return; }
+
+	//Internal clock counts down to the next increment
+	if(elapsed < timer->clock)
+	{
+		timer->clock -= elapsed;
+		return;
+	}
+
+	elapsed -= timer->clock;
+	timer->counter += (1 + (elapsed / timer->prescalar));
+	timer->clock = timer->prescalar - (elapsed % timer->prescalar);
+}
+
+/****** Calculates when a timer will overflow next - Timers 0-3 are NDS9, 4-7 are NDS7 ******/
+void NTR_MMU::schedule_timer(u8 timer_id)
+{
+	nds_timer* timer = (timer_id < 4) ? &nds9_timer->at(timer_id) : &nds7_timer->at(timer_id & 0x3);
+	u8 event_type = (timer_id < 4) ? (NTR_NDS9_TIMER0_EVENT + timer_id) : (NTR_NDS7_TIMER0_EVENT + (timer_id & 0x3));
+
+	if((!timer->enable) || (timer->count_up))
+	{
+		scheduler->event_time[event_type] = NTR_NO_EVENT;
+		return;
+	}
+
+	u64 ticks = 0x10000 - timer->counter;
+	schedule_event(event_type, scheduler->timer_sync[timer_id] + timer->clock + ((ticks - 1) * timer->prescalar));
+}
+
 /****** Parses cartridge header ******/
 void NTR_MMU::parse_header()
 {
@@ -6448,6 +6969,129 @@ void NTR_MMU::setup_default_firmware()
 	touchscreen.scr_y2 = read_u8(0x27FFCE3);
 }
 
+/****** Takes the word written to GXFIFO as a new command or as parameters for the current command ******/
+void NTR_MMU::process_gx_fifo()
+{
+	gx_fifo_entry = ((memory_map[NDS_GXFIFO+3] << 24) | (memory_map[NDS_GXFIFO+2] << 16) | (memory_map[NDS_GXFIFO+1] << 8) | memory_map[NDS_GXFIFO]);
+
+	bool delay_state = false;
+	bool nop = false;
+
+	//Determine if new command is packed or unpacked
+	if((lcd_3D_stat->gx_state & 0x1) == 0)
+	{
+		lcd_3D_stat->current_gx_command = 0;
+		lcd_3D_stat->fifo_params = 0;
+		gx_command = false;
+
+		//Begin processing packed commands
+		if(gx_fifo_entry & 0xFFFFFF00)
+		{
+			lcd_3D_stat->current_packed_command = gx_fifo_entry;
+			lcd_3D_stat->packed_command = true;
+			delay_state = true;
+
+			while(gx_fifo_entry)
+			{
+				nds9_gx_fifo.push(gx_fifo_entry & 0xFF);
+				gx_fifo_entry >>= 8;
+			}
+
+			lcd_3D_stat->current_gx_command = nds9_gx_fifo.front();
+			lcd_3D_stat->parameter_index = 0;
+			lcd_3D_stat->gx_state |= 0x1;
+		}
+
+		//Begin processing unpacked commands
+		else if(gx_fifo_entry & 0xFF)
+		{
+			lcd_3D_stat->packed_command = false;
+			delay_state = true;
+
+			nds9_gx_fifo.push(gx_fifo_entry);
+			lcd_3D_stat->current_gx_command = gx_fifo_entry & 0xFF;
+			lcd_3D_stat->parameter_index = 0;
+			lcd_3D_stat->gx_state |= 0x1;
+		}
+
+		//Ignore NOPs
+		else { nop = true; }
+
+		//Determine command parameter length
+		get_gx_fifo_param_length();
+
+		//If unpacked command has no parameters, wait for next command instead of waiting for parameters
+		if(!lcd_3D_stat->packed_command && !gx_fifo_param_length && !nop)
+		{
+			delay_state = false;
+			lcd_3D_stat->process_command = true;
+			lcd_3D_stat->gx_state &= ~0x1;
+			gx_command = true;
+		}	
+	}
+
+	//Gather parameters
+	else
+	{
+		if(gx_fifo_param_length)
+		{
+			lcd_3D_stat->command_parameters[lcd_3D_stat->parameter_index++] = memory_map[NDS_GXFIFO+3];
+			lcd_3D_stat->command_parameters[lcd_3D_stat->parameter_index++] = memory_map[NDS_GXFIFO+2];
+			lcd_3D_stat->command_parameters[lcd_3D_stat->parameter_index++] = memory_map[NDS_GXFIFO+1];
+			lcd_3D_stat->command_parameters[lcd_3D_stat->parameter_index++] = memory_map[NDS_GXFIFO];
+			gx_fifo_param_length--;
+		}
+
+		//FIFO entry is finished - Process command if all parameters gathered
+		if(!gx_fifo_param_length)
+		{
+			lcd_3D_stat->process_command = true;
+			lcd_3D_stat->gx_state &= ~0x1;
+			lcd_3D_stat->parameter_index = (lcd_3D_stat->fifo_params & 0xFF) * 4;
+			gx_command = true;
+		}
+	}
+
+	if(delay_state) { lcd_3D_stat->gx_state |= 0x1; }
+
+	//Set GX_STAT Geometry Engine busy flag
+	lcd_3D_stat->gx_stat &= ~0x8000000;
+
+	//Set GX_STAT FIFO less than half full flag
+	lcd_3D_stat->gx_stat |= 0x2000000;
+
+	//GXFIFO half empty IRQ
+	if((lcd_3D_stat->gx_stat & 0xC0000000) == 0x40000000) { nds9_if |= 0x200000; }
+
+	//Set GX_STAT FIFO empty flag
+	if(nds9_gx_fifo.empty())
+	{
+		lcd_3D_stat->gx_stat |= 0x4000000;
+		
+		//GXFIFO empty IRQ
+		if((lcd_3D_stat->gx_stat & 0xC0000000) == 0x80000000) { nds9_if |= 0x200000; }
+	}
+
+	else
+	{
+		lcd_3D_stat->gx_stat &= ~0x4000000;
+	}
+}
+
+/****** Writes a whole word to GXFIFO - Lets DMA feed command lists without going through write_u8() ******/
+void NTR_MMU::write_gx_fifo(u32 value)
+{
+	memory_map[NDS_GXFIFO] = (value & 0xFF);
+	memory_map[NDS_GXFIFO+1] = ((value >> 8) & 0xFF);
+	memory_map[NDS_GXFIFO+2] = ((value >> 16) & 0xFF);
+	memory_map[NDS_GXFIFO+3] = ((value >> 24) & 0xFF);
+
+	process_gx_fifo();
+
+	//Let the geometry engine process any completed commands on the next cycle
+	if(lcd_3D_stat->process_command) { schedule_event(NTR_GX_EVENT, scheduler->nds9_cycle + 1); }
+}
+
 /****** Calculates parameter length (in words) for a given GX packed or unpacked command ******/
 void NTR_MMU::get_gx_fifo_param_length()
 {
@@ -6458,47 +7102,7 @@ void NTR_MMU::get_gx_fifo_param_length()
 
 	while(command)
 	{
-		switch(command & 0xFF)
-		{
-			case 0x10: length = 1; break;
-			case 0x11: length = 0; break;
-			case 0x12: length = 1; break;
-			case 0x13: length = 1; break;
-			case 0x14: length = 1; break;
-			case 0x15: length = 0; break;
-			case 0x16: length = 16; break;
-			case 0x17: length = 12; break;
-			case 0x18: length = 16; break;
-			case 0x19: length = 12; break;
-			case 0x1A: length = 9; break;
-			case 0x1B: length = 3; break;
-			case 0x1C: length = 3; break;
-			case 0x20: length = 1; break;
-			case 0x21: length = 1; break;
-			case 0x22: length = 1; break;
-			case 0x23: length = 2; break;
-			case 0x24: length = 1; break;
-			case 0x25: length = 1; break;
-			case 0x26: length = 1; break;
-			case 0x27: length = 1; break;
-			case 0x28: length = 1; break;
-			case 0x29: length = 1; break;
-			case 0x2A: length = 1; break;
-			case 0x2B: length = 1; break;
-			case 0x30: length = 1; break;
-			case 0x31: length = 1; break;
-			case 0x32: length = 1; break;
-			case 0x33: length = 1; break;
-			case 0x34: length = 32; break;
-			case 0x40: length = 1; break;
-			case 0x41: length = 0; break;
-			case 0x50: length = 1; break;
-			case 0x60: length = 1; break;
-			case 0x70: length = 3; break;
-			case 0x71: length = 2; break;
-			case 0x72: length = 1; break;
-			default: length = 0;
-		}
+		length = get_gx_command_length(command & 0xFF);
 
 		gx_fifo_param_length += length;
 		lcd_3D_stat->fifo_params |= (length << pos);
@@ -6508,6 +7112,52 @@ void NTR_MMU::get_gx_fifo_param_length()
 	}
 }
 
+/****** Returns the parameter length (in words) of a single GX command ******/
+u8 NTR_MMU::get_gx_command_length(u8 command)
+{
+	switch(command)
+	{
+		case 0x10: return 1;
+		case 0x11: return 0;
+		case 0x12: return 1;
+		case 0x13: return 1;
+		case 0x14: return 1;
+		case 0x15: return 0;
+		case 0x16: return 16;
+		case 0x17: return 12;
+		case 0x18: return 16;
+		case 0x19: return 12;
+		case 0x1A: return 9;
+		case 0x1B: return 3;
+		case 0x1C: return 3;
+		case 0x20: return 1;
+		case 0x21: return 1;
+		case 0x22: return 1;
+		case 0x23: return 2;
+		case 0x24: return 1;
+		case 0x25: return 1;
+		case 0x26: return 1;
+		case 0x27: return 1;
+		case 0x28: return 1;
+		case 0x29: return 1;
+		case 0x2A: return 1;
+		case 0x2B: return 1;
+		case 0x30: return 1;
+		case 0x31: return 1;
+		case 0x32: return 1;
+		case 0x33: return 1;
+		case 0x34: return 32;
+		case 0x40: return 1;
+		case 0x41: return 0;
+		case 0x50: return 1;
+		case 0x60: return 1;
+		case 0x70: return 3;
+		case 0x71: return 2;
+		case 0x72: return 1;
+		default: return 0;
+	}
+}
+
 /****** Updates Display Capture Unit data ******/
 void NTR_MMU::copy_capture_buffer(u32 capture_addr)
 {
@@ -6569,48 +7219,6 @@ void NTR_MMU::copy_capture_buffer(u32 capture_addr)
 	}
 }
 
-/****** Deallocates VRAM when switching a bank back to LCDC mode ******/
-void NTR_MMU::deallocate_vram(u8 bank_id, u8 mst)
-{
-	u32 v_addr = lcd_stat->vram_bank_addr[bank_id];
-
-	if(v_addr)
-	{
-		switch(bank_id)
-		{
-			case 0x0:
-			case 0x1:
-			case 0x2:
-			case 0x3:
-				//Only try to deallocate memory VRAM mapped to CPU space
-				if(mst == 3) { return; }
-
-				for(u32 x = 0; x < 0x20000; x++) { memory_map[v_addr + x] = 0; }
-				break;
-
-			case 0x4:
-				//Only try to deallocate memory VRAM mapped to CPU space
-				if((mst == 3) || (mst == 4)) { return; }
-
-				for(u32 x = 0; x < 0x10000; x++) { memory_map[v_addr + x] = 0; }
-				break;
-
-			case 0x5:
-			case 0x6:
-			case 0x8:
-				//Only try to deallocate memory VRAM mapped to CPU space
-				if((bank_id < 8) && ((mst == 4) || (mst == 5))) { return; }
-
-				for(u32 x = 0; x < 0x4000; x++) { memory_map[v_addr + x] = 0; }
-				break;
-
-			case 0x7:
-				for(u32 x = 0; x < 0x8000; x++) { memory_map[v_addr + x] = 0; }
-				break;
-		}
-	}
-}
-
 /****** Points the MMU to an lcd_data structure (FROM THE LCD ITSELF) ******/
 void NTR_MMU::set_lcd_data(ntr_lcd_data* ex_lcd_stat) { lcd_stat = ex_lcd_stat; }
 
@@ -6637,56 +7245,38 @@ bool NTR_MMU::mmu_read(u32 offset, std::string filename)
 	file.seekg(offset);
 
 	//Serialize WRAM from save state
-	u8* ex_mem = &memory_map[0x2000000];
-	file.read((char*)ex_mem, 0x400000);
+	memory_map.load_block(file, 0x2000000, 0x400000);
 
 	//Serialize WRAM from save state
-	ex_mem = &memory_map[0x3000000];
-	file.read((char*)ex_mem, 0x8000);
+	memory_map.load_block(file, 0x3000000, 0x8000);
 
 	//Serialize WRAM from save state
-	ex_mem = &memory_map[0x3800000];
-	file.read((char*)ex_mem, 0x10000);
+	memory_map.load_block(file, 0x3800000, 0x10000);
 
 	//Serialize ARM9 IO registers from save state
-	ex_mem = &memory_map[0x4000000];
-	file.read((char*)ex_mem, 0x700);
-
-	ex_mem = &memory_map[0x4001000];
-	file.read((char*)ex_mem, 0x70);
-
-	ex_mem = &memory_map[0x4100000];
-	file.read((char*)ex_mem, 0x4);
-
-	ex_mem = &memory_map[0x4100010];
-	file.read((char*)ex_mem, 0x4);
+	memory_map.load_block(file, 0x4000000, 0x700);
+	memory_map.load_block(file, 0x4001000, 0x70);
+	memory_map.load_block(file, 0x4100000, 0x4);
+	memory_map.load_block(file, 0x4100010, 0x4);
 	
 	//Serialize palettes from save state
-	ex_mem = &memory_map[0x5000000];
-	file.read((char*)ex_mem, 0x800);
+	memory_map.load_block(file, 0x5000000, 0x800);
 
 	//Serialize VRAM from save state
-	ex_mem = &memory_map[0x6000000];
-	file.read((char*)ex_mem, 0x80000);
+	memory_map.load_block(file, 0x6000000, 0x80000);
+	memory_map.load_block(file, 0x6200000, 0x20000);
+	memory_map.load_block(file, 0x6400000, 0x40000);
+	memory_map.load_block(file, 0x6600000, 0x20000);
+	memory_map.load_block(file, 0x6800000, 0xA4000);
 
-	ex_mem = &memory_map[0x6200000];
-	file.read((char*)ex_mem, 0x20000);
-
-	ex_mem = &memory_map[0x6400000];
-	file.read((char*)ex_mem, 0x40000);
-
-	ex_mem = &memory_map[0x6600000];
-	file.read((char*)ex_mem, 0x20000);
-
-	ex_mem = &memory_map[0x6800000];
-	file.read((char*)ex_mem, 0xA4000);
+	//VRAM was reloaded, so decode every tile again
+	lcd_stat->vram_tile_update_list.assign(lcd_stat->vram_tile_update_list.size(), true);
 
 	//Serialize OAM from save state
-	ex_mem = &memory_map[0x7000000];
-	file.read((char*)ex_mem, 0x800);
+	memory_map.load_block(file, 0x7000000, 0x800);
 
 	//Serialize DTCM
-	ex_mem = &dtcm[0];
+	u8* ex_mem = &dtcm[0];
 	file.read((char*)ex_mem, 0x4000);
 
 	//Serialize misc data from MMU from save state
@@ -6768,6 +7358,9 @@ bool NTR_MMU::mmu_read(u32 offset, std::string filename)
 	file.read((char*)&pal_b_obj_slot, sizeof(pal_b_obj_slot));
 	file.read((char*)&vram_tex_slot, sizeof(vram_tex_slot));
 
+	//VRAMCNT, WRAMCNT, and DTCM may have all changed
+	update_vram_map();
+
 	file.close();
 	return true;
 }
@@ -6780,56 +7373,35 @@ bool NTR_MMU::mmu_write(std::string filename)
 	if(!file.is_open()) { return false; }
 
 	//Serialize WRAM to save state
-	u8* ex_mem = &memory_map[0x2000000];
-	file.write((char*)ex_mem, 0x400000);
+	memory_map.save_block(file, 0x2000000, 0x400000);
 
 	//Serialize WRAM to save state
-	ex_mem = &memory_map[0x3000000];
-	file.write((char*)ex_mem, 0x8000);
+	memory_map.save_block(file, 0x3000000, 0x8000);
 
 	//Serialize WRAM to save state
-	ex_mem = &memory_map[0x3800000];
-	file.write((char*)ex_mem, 0x10000);
+	memory_map.save_block(file, 0x3800000, 0x10000);
 
 	//Serialize ARM9 IO registers to save state
-	ex_mem = &memory_map[0x4000000];
-	file.write((char*)ex_mem, 0x700);
-
-	ex_mem = &memory_map[0x4001000];
-	file.write((char*)ex_mem, 0x70);
-
-	ex_mem = &memory_map[0x4100000];
-	file.write((char*)ex_mem, 0x4);
-
-	ex_mem = &memory_map[0x4100010];
-	file.write((char*)ex_mem, 0x4);
+	memory_map.save_block(file, 0x4000000, 0x700);
+	memory_map.save_block(file, 0x4001000, 0x70);
+	memory_map.save_block(file, 0x4100000, 0x4);
+	memory_map.save_block(file, 0x4100010, 0x4);
 	
 	//Serialize palettes to save state
-	ex_mem = &memory_map[0x5000000];
-	file.write((char*)ex_mem, 0x800);
+	memory_map.save_block(file, 0x5000000, 0x800);
 
 	//Serialize VRAM to save state
-	ex_mem = &memory_map[0x6000000];
-	file.write((char*)ex_mem, 0x80000);
-
-	ex_mem = &memory_map[0x6200000];
-	file.write((char*)ex_mem, 0x20000);
-
-	ex_mem = &memory_map[0x6400000];
-	file.write((char*)ex_mem, 0x40000);
-
-	ex_mem = &memory_map[0x6600000];
-	file.write((char*)ex_mem, 0x20000);
-
-	ex_mem = &memory_map[0x6800000];
-	file.write((char*)ex_mem, 0xA4000);
+	memory_map.save_block(file, 0x6000000, 0x80000);
+	memory_map.save_block(file, 0x6200000, 0x20000);
+	memory_map.save_block(file, 0x6400000, 0x40000);
+	memory_map.save_block(file, 0x6600000, 0x20000);
+	memory_map.save_block(file, 0x6800000, 0xA4000);
 
 	//Serialize OAM to save state
-	ex_mem = &memory_map[0x7000000];
-	file.write((char*)ex_mem, 0x800);
+	memory_map.save_block(file, 0x7000000, 0x800);
 
 	//Serialize DTCM
-	ex_mem = &dtcm[0];
+	u8* ex_mem = &dtcm[0];
 	file.write((char*)ex_mem, 0x4000);
 
 	//Serialize misc data to MMU to save state
@@ -20,10 +20,60 @@
 #include "common.h"
 #include "gamepad.h"
 #include "timer.h"
+#include "scheduler.h"
 #include "common/config.h"
 #include "lcd_data.h"
 #include "apu_data.h"
 
+class ntr_memory
+{
+	public:
+
+	ntr_memory();
+
+	//Access any byte in the 28-bit address space
+	u8& operator[](u32 address)
+	{
+		u8* page = pages[(address >> 14) & 0x3FFF];
+		if(page == NULL) { page = allocate_page(address); }
+		return page[address & 0x3FFF];
+	}
+
+	//Read any byte without allocating a page - Unmapped addresses read as zero, so the renderer threads can use this
+	u8 read(u32 address) const
+	{
+		u8* page = pages[(address >> 14) & 0x3FFF];
+		return (page == NULL) ? 0 : page[address & 0x3FFF];
+	}
+
+	void reset();
+	void clear();
+	void map_vram(u32 bank_window[9]);
+	u8* get_page(u32 address) const;
+	u32 get_vram_offset(u32 address) const;
+
+	void load_block(std::ifstream& file, u32 address, u32 length);
+	void save_block(std::ofstream& file, u32 address, u32 length);
+
+	private:
+
+	u8* allocate_page(u32 address);
+	void map_region(u32 start, u32 end, std::vector<u8>& region, u32 offset = 0);
+
+	u8* pages[0x4000];
+
+	std::vector<u8> itcm;
+	std::vector<u8> main_ram;
+	std::vector<u8> shared_wram;
+	std::vector<u8> nds7_wram;
+	std::vector<u8> palette;
+	std::vector<u8> vram;
+	std::vector<u8> vram_unmapped;
+	std::vector<u8> oam;
+
+	std::vector< std::vector<u8> > unmapped_pages;
+};
+
 class NTR_MMU
 {
 	public:
@@ -75,7 +125,7 @@ class NTR_MMU
 	slot1_types current_slot1_device;
 	slot2_types current_slot2_device;
 
-	std::vector <u8> memory_map;
+	ntr_memory memory_map;
 	std::vector <u8> cart_data;
 	std::vector <u8> nds7_bios;
 	std::vector <u8> nds9_bios;
@@ -275,6 +325,9 @@ class NTR_MMU
 
 	//Determines whether memory access comes from NDS9/NDS7
 	u8 access_mode;
+
+	//Set when a CPU touches state shared with the other CPU, ends its run early when not in lockstep
+	bool sync_request;
 	u8 wram_mode;
 	u8 rumble_state;
 
@@ -382,6 +435,13 @@ class NTR_MMU
 	bool bg_vram_bank_enable_a;
 	bool bg_vram_bank_enable_b;
 
+	//Per-CPU page tables for plain memory, NULL pages go through the full read/write handlers
+	//Rebuilt whenever VRAMCNT, WRAMCNT, or the CP15 TCM settings change
+	u8* nds9_read_pages[0x4000];
+	u8* nds9_write_pages[0x4000];
+	u8* nds9_fetch_pages[0x4000];
+	u8* nds7_pages[0x4000];
+
 	//Advanced debugging
 	#ifdef GBE_DEBUG
 	bool debug_write;
@@ -400,12 +460,19 @@ class NTR_MMU
 	void start_gxfifo_dma();
 	void start_dma(u8 dma_bits);
 
+	void schedule_event(u8 event_type, u64 event_cycle);
+	void sync_timer(u8 timer_id);
+	void schedule_timer(u8 timer_id);
+
 	u8 read_u8(u32 address);
 	u16 read_u16(u32 address);
 	u32 read_u32(u32 address);
 
-	u16 read_u16_fast(u32 address) const;
-	u32 read_u32_fast(u32 address) const;
+	template<typename T> T read(u32 address);
+	template<typename T> void write(u32 address, T value);
+
+	u16 read_u16_fast(u32 address);
+	u32 read_u32_fast(u32 address);
 
 	void write_u8(u32 address, u8 value);
 	void write_u16(u32 address, u16 value);
@@ -418,6 +485,22 @@ class NTR_MMU
 	u16 read_cart_u16(u32 address) const;
 	u32 read_cart_u32(u32 address) const;
 
+	bool is_idle_poll_address(u32 address) const;
+
+	void update_vram_map();
+	void update_page_tables();
+	u8* get_read_page(u32 address);
+	u8* get_write_page(u32 address);
+	void mark_lcd_write(u32 address);
+
+	void dma_transfer(u8 index);
+	u32 dma_block(u32 dest_addr, u32 src_addr, u32 count, u8 unit, bool fixed_src);
+
+	u8* get_host_read(u32 address, u32 &length);
+	u8* get_host_write(u32 address, u32 &length);
+	void mark_host_write(u32 address, u32 length);
+	u8* get_host_run(u8** pages, u32 address, u32 &length);
+
 	bool read_file(std::string filename);
 	bool read_slot2_file(std::string filename);
 	bool read_bios_nds7(std::string filename);
@@ -445,9 +528,11 @@ class NTR_MMU
 	u32 key1_read_u32(u32 index);
 	u32 key_code_read_u32(u32 index);
 
+	void process_gx_fifo();
+	void write_gx_fifo(u32 value);
 	void get_gx_fifo_param_length();
+	u8 get_gx_command_length(u8 command);
 	void copy_capture_buffer(u32 capture_addr);
-	void deallocate_vram(u8 bank_id, u8 mst);
 
 	void set_lcd_data(ntr_lcd_data* ex_lcd_stat);
 	void set_lcd_3D_data(ntr_lcd_3D_data* ex_lcd_3D_stat);
@@ -469,6 +554,7 @@ class NTR_MMU
 	NTR_GamePad* g_pad;
 	std::vector<nds_timer>* nds7_timer;
 	std::vector<nds_timer>* nds9_timer;
+	ntr_scheduler* scheduler;
 
 	//Serialize data for save state loading/saving
 	bool mmu_read(u32 offset, std::string filename);
@@ -0,0 +1,199 @@
+// GB Enhanced+ Copyright Daniel Baxter 2015
+// Licensed under the GPLv2
+// See LICENSE.txt for full license text
+
+// File : scheduler.cpp
+// Date : October 16, 2026
+// Description : NDS event scheduler
+//
+// Runs the LCD, GX, timers, and DMAs only on cycles where they have work to do
+// Both CPUs advance their clocks in bulk and process events as they come due
+
+#include "core.h"
+
+/****** Resets the scheduler and queues up initial events ******/
+void NTR_core::reset_scheduler()
+{
+	core_scheduler.nds9_cycle = 0;
+	core_scheduler.nds7_cycle = 0;
+	core_scheduler.lcd_sync = 0;
+
+	for(u32 x = 0; x < 8; x++) { core_scheduler.timer_sync[x] = 0; }
+	for(u32 x = 0; x < NTR_MAX_EVENT; x++) { core_scheduler.event_time[x] = NTR_NO_EVENT; }
+
+	//LCD state is unknown at this point, so let it step on the very next cycle
+	core_scheduler.event_time[NTR_LCD_EVENT] = 1;
+	core_scheduler.nds9_next_event = 1;
+	core_scheduler.nds7_next_event = NTR_NO_EVENT;
+}
+
+/****** Returns how many cycles an idle CPU should wait before checking for interrupts again ******/
+u32 NTR_core::get_idle_cycles(u32 min_cycles)
+{
+	//Only skip ahead if both CPUs are halted, waiting for interrupts, or parked in polling loops
+	//WaitByLoop counts down each time it is checked, so it has to run in small steps
+	if((core_cpu_nds9.idle_state != 1) && (core_cpu_nds9.idle_state != 3) && (core_cpu_nds9.idle_state != 4)) { return min_cycles; }
+	if((core_cpu_nds7.idle_state != 1) && (core_cpu_nds7.idle_state != 3) && (core_cpu_nds7.idle_state != 4)) { return min_cycles; }
+
+	//Nothing can wake either CPU until the next event
+	u64 nds9_wait = (core_scheduler.nds9_next_event > core_scheduler.nds9_cycle) ? (core_scheduler.nds9_next_event - core_scheduler.nds9_cycle) : 0;
+	u64 nds7_wait = (core_scheduler.nds7_next_event > core_scheduler.nds7_cycle) ? (core_scheduler.nds7_next_event - core_scheduler.nds7_cycle) : 0;
+	u64 idle_cycles = (nds9_wait < nds7_wait) ? nds9_wait : nds7_wait;
+
+	//Stay within range of the CPU sync counters
+	if(idle_cycles > 0x2000) { idle_cycles = 0x2000; }
+
+	return (idle_cycles > min_cycles) ? idle_cycles : min_cycles;
+}
+
+/****** Returns how many cycles a CPU parked in a polling loop can skip ahead ******/
+u32 NTR_core::get_poll_cycles(u32 min_cycles, u64 current_cycle, u64 next_event)
+{
+	//When both CPUs are idle, only events can change anything
+	u32 idle_cycles = get_idle_cycles(min_cycles);
+	if(idle_cycles > min_cycles) { return idle_cycles; }
+
+	//Otherwise, wait for this CPU's next event, but hand control back once the other CPU is due to run
+	//The other CPU only gets to change what the loop reads once it has a turn
+	u64 poll_cycles = (next_event > current_cycle) ? (next_event - current_cycle) : 0;
+	double quantum_left = cpu_sync_quantum + cpu_sync_cycles;
+
+	if(quantum_left <= 0) { return min_cycles; }
+	if(poll_cycles > quantum_left) { poll_cycles = quantum_left; }
+
+	//Stay within range of the CPU sync counters
+	if(poll_cycles > 0x2000) { poll_cycles = 0x2000; }
+
+	return (poll_cycles > min_cycles) ? poll_cycles : min_cycles;
+}
+
+/****** Processes all NDS9 events due on or before its current cycle ******/
+void NTR_ARM9::process_events()
+{
+	u64 target_cycle = scheduler->nds9_cycle;
+
+	while(true)
+	{
+		//Find the earliest event. On ties, the lowest event type goes first
+		u8 event_type = NTR_GX_EVENT;
+		u64 event_cycle = scheduler->event_time[NTR_GX_EVENT];
+
+		for(u32 x = (NTR_GX_EVENT + 1); x <= NTR_NDS9_DMA_EVENT; x++)
+		{
+			if(scheduler->event_time[x] < event_cycle)
+			{
+				event_type = x;
+				event_cycle = scheduler->event_time[x];
+			}
+		}
+
+		scheduler->nds9_next_event = event_cycle;
+		if(event_cycle > target_cycle) { break; }
+
+		//Rewind the clock to the event so anything scheduled from here on is relative to it
+		scheduler->nds9_cycle = event_cycle;
+		scheduler->event_time[event_type] = NTR_NO_EVENT;
+
+		switch(event_type)
+		{
+			case NTR_GX_EVENT:
+				if(controllers.video.lcd_3D_stat.process_command) { controllers.video.process_gx_command(); }
+				if(controllers.video.lcd_3D_stat.render_polygon) { controllers.video.store_polygon(); }
+				break;
+
+			case NTR_LCD_EVENT:
+				//Catch up on cycles where the LCD was idle, then step
+				controllers.video.lcd_stat.lcd_clock += (scheduler->nds9_cycle - scheduler->lcd_sync - 1);
+				controllers.video.step();
+				scheduler->lcd_sync = scheduler->nds9_cycle;
+
+				mem->schedule_event(NTR_LCD_EVENT, scheduler->nds9_cycle + controllers.video.cycles_to_next_event());
+
+				//Start any DMAs waiting on HBlank, VBlank, Display Sync, or GXFIFO
+				for(u32 x = 0; x < 4; x++)
+				{
+					if(mem->dma[x].enable)
+					{
+						mem->schedule_event(NTR_NDS9_DMA_EVENT, scheduler->nds9_cycle);
+						break;
+					}
+				}
+
+				for(u32 x = 4; x < 8; x++)
+				{
+					if(mem->dma[x].enable)
+					{
+						mem->schedule_event(NTR_NDS7_DMA_EVENT, scheduler->nds7_cycle);
+						break;
+					}
+				}
+
+				break;
+
+			case NTR_NDS9_TIMER0_EVENT:
+			case NTR_NDS9_TIMER1_EVENT:
+			case NTR_NDS9_TIMER2_EVENT:
+			case NTR_NDS9_TIMER3_EVENT:
+				timer_overflow(event_type - NTR_NDS9_TIMER0_EVENT);
+				break;
+
+			case NTR_NDS9_DMA_EVENT:
+				clock_dma();
+
+				//DMAs to GX ports can leave commands for the geometry engine
+				if((controllers.video.lcd_3D_stat.process_command) || (controllers.video.lcd_3D_stat.render_polygon))
+				{
+					mem->schedule_event(NTR_GX_EVENT, scheduler->nds9_cycle + 1);
+				}
+
+				break;
+		}
+	}
+
+	scheduler->nds9_cycle = target_cycle;
+}
+
+/****** Processes all NDS7 events due on or before its current cycle ******/
+void NTR_ARM7::process_events()
+{
+	u64 target_cycle = scheduler->nds7_cycle;
+
+	while(true)
+	{
+		//Find the earliest event. On ties, the lowest event type goes first
+		u8 event_type = NTR_NDS7_TIMER0_EVENT;
+		u64 event_cycle = scheduler->event_time[NTR_NDS7_TIMER0_EVENT];
+
+		for(u32 x = (NTR_NDS7_TIMER0_EVENT + 1); x <= NTR_NDS7_DMA_EVENT; x++)
+		{
+			if(scheduler->event_time[x] < event_cycle)
+			{
+				event_type = x;
+				event_cycle = scheduler->event_time[x];
+			}
+		}
+
+		scheduler->nds7_next_event = event_cycle;
+		if(event_cycle > target_cycle) { break; }
+
+		//Rewind the clock to the event so anything scheduled from here on is relative to it
+		scheduler->nds7_cycle = event_cycle;
+		scheduler->event_time[event_type] = NTR_NO_EVENT;
+
+		switch(event_type)
+		{
+			case NTR_NDS7_TIMER0_EVENT:
+			case NTR_NDS7_TIMER1_EVENT:
+			case NTR_NDS7_TIMER2_EVENT:
+			case NTR_NDS7_TIMER3_EVENT:
+				timer_overflow(event_type - NTR_NDS7_TIMER0_EVENT);
+				break;
+
+			case NTR_NDS7_DMA_EVENT:
+				clock_dma();
+				break;
+		}
+	}
+
+	scheduler->nds7_cycle = target_cycle;
+}
@@ -0,0 +1,59 @@
+// GB Enhanced+ Copyright Daniel Baxter 2015
+// Licensed under the GPLv2
+// See LICENSE.txt for full license text
+
+// File : scheduler.h
+// Date : October 16, 2026
+// Description : NDS event scheduler
+//
+// Defines the data structure used to keep track of upcoming hardware events (LCD, GX, timers, DMA)
+// Each event is stamped with the absolute 33MHz cycle it is due on
+// Events belong to either the NDS9 or NDS7 and are due according to that CPU's clock
+// Used as a header file here because multiple components (Core, CPUs, MMU) need access to it
+
+#ifndef NDS_SCHEDULER
+#define NDS_SCHEDULER
+
+#include "common.h"
+
+//Events are listed in the order they resolve when several fall on the same cycle
+enum ntr_event_types
+{
+	//NDS9 events
+	NTR_GX_EVENT,
+	NTR_LCD_EVENT,
+	NTR_NDS9_TIMER0_EVENT,
+	NTR_NDS9_TIMER1_EVENT,
+	NTR_NDS9_TIMER2_EVENT,
+	NTR_NDS9_TIMER3_EVENT,
+	NTR_NDS9_DMA_EVENT,
+
+	//NDS7 events
+	NTR_NDS7_TIMER0_EVENT,
+	NTR_NDS7_TIMER1_EVENT,
+	NTR_NDS7_TIMER2_EVENT,
+	NTR_NDS7_TIMER3_EVENT,
+	NTR_NDS7_DMA_EVENT,
+
+	NTR_MAX_EVENT,
+};
+
+const u64 NTR_NO_EVENT = 0xFFFFFFFFFFFFFFFFULL;
+
+struct ntr_scheduler
+{
+	//Current clock for each CPU
+	u64 nds9_cycle;
+	u64 nds7_cycle;
+
+	u64 nds9_next_event;
+	u64 nds7_next_event;
+	u64 event_time[NTR_MAX_EVENT];
+
+	//Last cycle each lazily updated component was brought up to date
+	//Timers 0-3 belong to the NDS9, Timers 4-7 belong to the NDS7
+	u64 lcd_sync;
+	u64 timer_sync[8];
+};
+
+#endif // NDS_SCHEDULER
@@ -9,6 +9,7 @@
 // Emulates the NDS's Software Interrupts via High Level Emulation
 
 #include <cmath>
+#include <algorithm>
 
 #include "arm9.h"
 #include "arm7.h"
@@ -93,25 +94,25 @@ void NTR_ARM9::process_swi(u32 comment)
 		//LZ77UnCompWram
 		case 0x11:
 			std::cout<<"ARM9::SWI::LZ77UnCompWram \n";
-			swi_lz77uncompvram();
+			swi_lz77uncompvram(false);
 			break;
 
 		//LZ77UnCompReadByCallback
 		case 0x12:
 			std::cout<<"ARM9::SWI::LZ77UnCompReadByCallback \n";
-			swi_lz77uncompvram();
+			swi_lz77uncompvram(true);
 			break;
 
 		//RLUnCompReadNormalWrite8Bit
 		case 0x14:
 			std::cout<<"ARM9::SWI::LUnCompReadNormalWrite8Bit \n";
-			swi_rluncompvram();
+			swi_rluncompvram(false);
 			break;
 
 		//RLUnCompReadByCallback
 		case 0x15:
 			std::cout<<"ARM9::SWI::RLUnCompReadByCallback \n";
-			swi_rluncompvram();
+			swi_rluncompvram(true);
 			break;
 
 		//CustomPost
@@ -283,64 +284,30 @@ void NTR_ARM9::swi_cpuset()
 
 	//Determine if the transfer operation is 16 or 32-bit - Bit 26 of R2
 	u8 transfer_type = (transfer_control & 0x4000000) ? 1 : 0;
+	u8 unit = (transfer_type == 0) ? 2 : 4;
 
 	src_addr &= (transfer_type == 0) ? ~0x1 : ~0x3;
 	dest_addr &= (transfer_type == 0) ? ~0x1 : ~0x3; 
 
-	u32 temp_32 = 0;
-	u16 temp_16 = 0;
-
 	while(transfer_size != 0)
 	{
-		//Copy from source to destination
-		if(copy_fill == 0)
-		{
-			//16-bit transfer
-			if(transfer_type == 0)
-			{
-				temp_16 = mem->read_u16(src_addr);
-				mem->write_u16(dest_addr, temp_16);
-			
-				src_addr += 2;
-				dest_addr += 2;
-			}
+		//Copy or fill runs of plain memory directly
+		u32 count = mem->dma_block(dest_addr, src_addr, transfer_size, unit, (copy_fill == 1));
 
-			//32-bit transfer
-			else
-			{
-				temp_32 = mem->read_u32(src_addr);
-				mem->write_u32(dest_addr, temp_32);
-			
-				src_addr += 4;
-				dest_addr += 4;
-			}
+		//Everything else moves one unit at a time
+		if(count == 0)
+		{
+			if(transfer_type == 0) { mem->write_u16(dest_addr, mem->read_u16(src_addr)); }
+			else { mem->write_u32(dest_addr, mem->read_u32(src_addr)); }
 
-			transfer_size--;
+			count = 1;
 		}
 
-		//Fill first entry from source with destination
-		else
-		{
-			//16-bit transfer
-			if(transfer_type == 0)
-			{
-				temp_16 = mem->read_u16(src_addr);
-				mem->write_u16(dest_addr, temp_16);
-			
-				dest_addr += 2;
-			}
+		//Fills keep reading the first entry from source
+		if(copy_fill == 0) { src_addr += (count * unit); }
 
-			//32-bit transfer
-			else
-			{
-				temp_32 = mem->read_u32(src_addr);
-				mem->write_u32(dest_addr, temp_32);
-			
-				dest_addr += 4;
-			}
-			
-			transfer_size--;
-		}
+		dest_addr += (count * unit);
+		transfer_size -= count;
 	}
 
 	//Write-back R0, R1
@@ -369,32 +336,23 @@ void NTR_ARM9::swi_cpufastset()
 	//Determine if the transfer operation is copy or fill - Bit 24 of R2
 	u8 copy_fill = (transfer_control & 0x1000000) ? 1 : 0;
 
-	u32 temp = 0;
-
 	while(transfer_size != 0)
 	{
-		//Copy from source to destination
-		if(copy_fill == 0)
-		{
-			temp = mem->read_u32(src_addr);
-			mem->write_u32(dest_addr, temp);
-			
-			src_addr += 4;
-			dest_addr += 4;
+		//Copy or fill runs of plain memory directly
+		u32 count = mem->dma_block(dest_addr, src_addr, transfer_size, 4, (copy_fill == 1));
 
-			transfer_size--;
-		}
-
-		//Fill first entry from source with destination
-		else
+		//Everything else moves one word at a time
+		if(count == 0)
 		{
-			temp = mem->read_u32(src_addr);
-			mem->write_u32(dest_addr, temp);
-			
-			dest_addr += 4;
-			
-			transfer_size--;
+			mem->write_u32(dest_addr, mem->read_u32(src_addr));
+			count = 1;
 		}
+
+		//Fills keep reading the first entry from source
+		if(copy_fill == 0) { src_addr += (count * 4); }
+
+		dest_addr += (count * 4);
+		transfer_size -= count;
 	}
 
 	//Write-back R0, R1
@@ -504,6 +462,19 @@ void NTR_ARM9::swi_bitunpack()
 	u8 zero_flag = (data_offset & 0x80000000) ? 1 : 0;
 	data_offset &= ~0x80000000;
 
+	//32-bit writes are always aligned
+	dest_addr &= ~0x3;
+
+	//Resolve source and destination to host memory once, anything past either goes through the MMU
+	//At worst, every bit of the source becomes a whole 32-bit value
+	u32 src_room = length;
+	u32 dest_room = (length * 32);
+	u8* src = mem->get_host_read(src_addr, src_room);
+	u8* dest = mem->get_host_write(dest_addr, dest_room);
+
+	u32 src_pos = 0;
+	u32 dest_pos = 0;
+
 	u8 src_byte = 0;
 	u8 src_count = 0;
 	u32 result = 0;
@@ -519,7 +490,8 @@ void NTR_ARM9::swi_bitunpack()
 			//Grab new source byte
 			if((src_count % 8) == 0) 
 			{
-				src_byte = mem->read_u8(src_addr++);
+				src_byte = (src_pos < src_room) ? src[src_pos] : mem->read_u8(src_addr + src_pos);
+				src_pos++;
 				length--;
 			}
 
@@ -536,13 +508,24 @@ void NTR_ARM9::swi_bitunpack()
 		}
 
 		//Write result to the destination address
-		mem->write_u32(dest_addr, result);
-		dest_addr += 4;
+		if((dest_pos + 4) <= dest_room)
+		{
+			dest[dest_pos] = (result & 0xFF);
+			dest[dest_pos + 1] = ((result >> 8) & 0xFF);
+			dest[dest_pos + 2] = ((result >> 16) & 0xFF);
+			dest[dest_pos + 3] = ((result >> 24) & 0xFF);
+		}
+
+		else { mem->write_u32(dest_addr + dest_pos, result); }
+
+		dest_pos += 4;
 	}
+
+	mem->mark_host_write(dest_addr, std::min(dest_pos, dest_room));
 }	
 
 /****** HLE implementation of LZ77UnCompReadByCallback - NDS9 ******/
-void NTR_ARM9::swi_lz77uncompvram()
+void NTR_ARM9::swi_lz77uncompvram(bool vram)
 {
 	//Grab source address - R0
 	u32 src_addr = get_reg(0);
@@ -556,62 +539,111 @@ void NTR_ARM9::swi_lz77uncompvram()
 	//Grab compressed data size in bytes
 	u32 data_size = (data_header >> 8);
 
-	//Pointer to current address of compressed data that needs to be processed
-	//When uncompression starts, move 5 bytes from source address (header + flag)
+	//Pointer to compressed data that needs to be processed, right after the header
 	u32 data_ptr = (src_addr + 4);
 
-	u8 temp = 0;
+	//Resolve source and destination to host memory once, anything past either goes through the MMU
+	//At worst, every block is one uncompressed byte, with a flag byte for every 8 blocks
+	u32 src_room = data_size + (data_size >> 3) + 2;
+	u32 dest_room = data_size;
+	u8* src = mem->get_host_read(data_ptr, src_room);
+	u8* dest = mem->get_host_write(dest_addr, dest_room);
+
+	u32 src_pos = 0;
+	u32 dest_pos = 0;
+	u16 half_data = 0;
 
 	//Uncompress data
-	while(data_size > 0)
+	while(dest_pos < data_size)
 	{
 		//Grab flag data
-		u8 flag_data = mem->read_u8(data_ptr++);
+		u8 flag_data = (src_pos < src_room) ? src[src_pos] : mem->read_u8(data_ptr + src_pos);
+		src_pos++;
 
 		//Process 8 blocks
-		for(int x = 7; x >= 0; x--)
+		for(int x = 7; (x >= 0) && (dest_pos < data_size); x--)
 		{
-			u8 block_type = (flag_data & (1 << x)) ? 1 : 0;
-
 			//Block Type 0 - Uncompressed
-			if(block_type == 0)
+			if((flag_data & (1 << x)) == 0)
 			{
-				temp = mem->read_u8(data_ptr++);
-				mem->write_u8(dest_addr++, temp);
-				
-				data_size--;
-				if(data_size == 0) { return; }
-			}
+				u8 temp = (src_pos < src_room) ? src[src_pos] : mem->read_u8(data_ptr + src_pos);
+				src_pos++;
+
+				if(!vram)
+				{
+					if(dest_pos < dest_room) { dest[dest_pos] = temp; }
+					else { mem->write_u8(dest_addr + dest_pos, temp); }
+				}
+
+				//VRAM only takes halfwords, hold even bytes until the odd byte completes one
+				else if((dest_pos & 1) == 0) { half_data = temp; }
+
+				else
+				{
+					half_data |= (temp << 8);
+
+					if(dest_pos < dest_room)
+					{
+						dest[dest_pos - 1] = (half_data & 0xFF);
+						dest[dest_pos] = (half_data >> 8);
+					}
 
+					else { mem->write_u16(dest_addr + dest_pos - 1, half_data); }
+				}
+
+				dest_pos++;
+			}
 
 			//Block Type 1 - Compressed
+			//Read as separate bytes, blocks are not halfword aligned
 			else
 			{
-				u16 compressed_block = mem->read_u16(data_ptr);
-				data_ptr += 2;
+				u8 block_hi = (src_pos < src_room) ? src[src_pos] : mem->read_u8(data_ptr + src_pos);
+				u8 block_lo = ((src_pos + 1) < src_room) ? src[src_pos + 1] : mem->read_u8(data_ptr + src_pos + 1);
+				src_pos += 2;
 
-				u16 distance = ((compressed_block & 0xF) << 8);
-				distance |= (compressed_block >> 8);
+				u32 distance = (((block_hi & 0xF) << 8) | block_lo) + 1;
+				u8 length = (block_hi >> 4) + 3;
 
-				u8 length = ((compressed_block >> 4) & 0xF) + 3;
-
-				//Copy length+3 Bytes from dest_addr-length-1 to dest_addr
-				for(int y = 0; y < length; y++)
+				//Copy length+3 Bytes from dest_addr-distance-1 to dest_addr
+				for(u32 y = 0; (y < length) && (dest_pos < data_size); y++)
 				{
-					temp = mem->read_u8(dest_addr - distance - 1);
-					mem->write_u8(dest_addr, temp);
-					
-					dest_addr++;
-					data_size--;
-					if(data_size == 0) { return; }
+					u32 back_pos = dest_pos - distance;
+					u8 temp = (back_pos < dest_room) ? dest[back_pos] : mem->read_u8(dest_addr + back_pos);
+
+					if(!vram)
+					{
+						if(dest_pos < dest_room) { dest[dest_pos] = temp; }
+						else { mem->write_u8(dest_addr + dest_pos, temp); }
+					}
+
+					else if((dest_pos & 1) == 0) { half_data = temp; }
+
+					else
+					{
+						half_data |= (temp << 8);
+
+						if(dest_pos < dest_room)
+						{
+							dest[dest_pos - 1] = (half_data & 0xFF);
+							dest[dest_pos] = (half_data >> 8);
+						}
+
+						else { mem->write_u16(dest_addr + dest_pos - 1, half_data); }
+					}
+
+					dest_pos++;
 				}
 			}
 		}
 	}
+
+	//A trailing odd byte never completes a halfword, so VRAM never sees it
+	mem->mark_host_write(dest_addr, std::min(dest_pos, dest_room));
 }
 
 /****** HLE implementation of RLUnCompVram - NDS9 ******/
-void NTR_ARM9::swi_rluncompvram()
+void NTR_ARM9::swi_rluncompvram(bool vram)
 {
 	//Grab source address - R0
 	u32 src_addr = get_reg(0);
@@ -627,10 +659,22 @@ void NTR_ARM9::swi_rluncompvram()
 	//Data pointer to compressed data. Points to first flag.
 	u32 data_ptr = (src_addr + 4);
 
+	//Resolve source and destination to host memory once, anything past either goes through the MMU
+	//At worst, every byte is a run of one uncompressed byte
+	u32 src_room = (data_size * 2);
+	u32 dest_room = data_size;
+	u8* src = mem->get_host_read(data_ptr, src_room);
+	u8* dest = mem->get_host_write(dest_addr, dest_room);
+
+	u32 src_pos = 0;
+	u32 dest_pos = 0;
+	u16 half_data = 0;
+
 	//Uncompress data
-	while(data_size > 0)
+	while(dest_pos < data_size)
 	{
-		u8 flag = mem->read_u8(data_ptr++);
+		u8 flag = (src_pos < src_room) ? src[src_pos] : mem->read_u8(data_ptr + src_pos);
+		src_pos++;
 
 		u8 data_length = (flag & 0x7F);
 
@@ -639,25 +683,44 @@ void NTR_ARM9::swi_rluncompvram()
 		else { data_length += 1; }
 
 		//Output the specified byte the amount of times in data_length
-		for(int x = 0; x < data_length; x++)
+		for(u32 x = 0; (x < data_length) && (dest_pos < data_size); x++)
 		{
-			u8 data_byte = 0;
+			u8 data_byte = (src_pos < src_room) ? src[src_pos] : mem->read_u8(data_ptr + src_pos);
+
+			//Uncompressed data moves on every byte
+			if((flag & 0x80) == 0) { src_pos++; }
+
+			if(!vram)
+			{
+				if(dest_pos < dest_room) { dest[dest_pos] = data_byte; }
+				else { mem->write_u8(dest_addr + dest_pos, data_byte); }
+			}
 
-			//Compressed
-			if(flag & 0x80) { data_byte = mem->read_u8(data_ptr); }
+			//VRAM only takes halfwords, hold even bytes until the odd byte completes one
+			else if((dest_pos & 1) == 0) { half_data = data_byte; }
 
-			//Uncompressed
-			else { data_byte = mem->read_u8(data_ptr++); }
-				
-			mem->write_u8(dest_addr++, data_byte);
-			data_size--;
+			else
+			{
+				half_data |= (data_byte << 8);
 
-			if(data_size == 0) { return; }
+				if(dest_pos < dest_room)
+				{
+					dest[dest_pos - 1] = (half_data & 0xFF);
+					dest[dest_pos] = (half_data >> 8);
+				}
+
+				else { mem->write_u16(dest_addr + dest_pos - 1, half_data); }
+			}
+
+			dest_pos++;
 		}
 
 		//Manually adjust data pointer for compressed data to point to next flag
-		if(flag & 0x80) { data_ptr++; }
+		if(flag & 0x80) { src_pos++; }
 	}
+
+	//A trailing odd byte never completes a halfword, so VRAM never sees it
+	mem->mark_host_write(dest_addr, std::min(dest_pos, dest_room));
 }
 
 /****** HLE implementation of CustomPost - NDS9 ******/
@@ -752,19 +815,19 @@ void NTR_ARM7::process_swi(u32 comment)
 		//LZ77UnCompReadByCallback
 		case 0x12:
 			std::cout<<"ARM7::SWI::LZ77UnCompReadByCallback \n";
-			swi_lz77uncompvram();
+			swi_lz77uncompvram(true);
 			break;
 
 		//RLUnCompReadNormalWrite8Bit
 		case 0x14:
 			std::cout<<"ARM7::SWI::LUnCompReadNormalWrite8Bit \n";
-			swi_rluncompvram();
+			swi_rluncompvram(false);
 			break;
 
 		//RLUnCompReadByCallback
 		case 0x15:
 			std::cout<<"ARM7::SWI::RLUnCompReadByCallback \n";
-			swi_rluncompvram();
+			swi_rluncompvram(true);
 			break;
 
 		//GetSineTable
@@ -998,64 +1061,30 @@ void NTR_ARM7::swi_cpuset()
 
 	//Determine if the transfer operation is 16 or 32-bit - Bit 26 of R2
 	u8 transfer_type = (transfer_control & 0x4000000) ? 1 : 0;
+	u8 unit = (transfer_type == 0) ? 2 : 4;
 
 	src_addr &= (transfer_type == 0) ? ~0x1 : ~0x3;
 	dest_addr &= (transfer_type == 0) ? ~0x1 : ~0x3; 
 
-	u32 temp_32 = 0;
-	u16 temp_16 = 0;
-
 	while(transfer_size != 0)
 	{
-		//Copy from source to destination
-		if(copy_fill == 0)
-		{
-			//16-bit transfer
-			if(transfer_type == 0)
-			{
-				temp_16 = mem->read_u16(src_addr);
-				mem->write_u16(dest_addr, temp_16);
-			
-				src_addr += 2;
-				dest_addr += 2;
-			}
+		//Copy or fill runs of plain memory directly
+		u32 count = mem->dma_block(dest_addr, src_addr, transfer_size, unit, (copy_fill == 1));
 
-			//32-bit transfer
-			else
-			{
-				temp_32 = mem->read_u32(src_addr);
-				mem->write_u32(dest_addr, temp_32);
-			
-				src_addr += 4;
-				dest_addr += 4;
-			}
+		//Everything else moves one unit at a time
+		if(count == 0)
+		{
+			if(transfer_type == 0) { mem->write_u16(dest_addr, mem->read_u16(src_addr)); }
+			else { mem->write_u32(dest_addr, mem->read_u32(src_addr)); }
 
-			transfer_size--;
+			count = 1;
 		}
 
-		//Fill first entry from source with destination
-		else
-		{
-			//16-bit transfer
-			if(transfer_type == 0)
-			{
-				temp_16 = mem->read_u16(src_addr);
-				mem->write_u16(dest_addr, temp_16);
-			
-				dest_addr += 2;
-			}
+		//Fills keep reading the first entry from source
+		if(copy_fill == 0) { src_addr += (count * unit); }
 
-			//32-bit transfer
-			else
-			{
-				temp_32 = mem->read_u32(src_addr);
-				mem->write_u32(dest_addr, temp_32);
-			
-				dest_addr += 4;
-			}
-			
-			transfer_size--;
-		}
+		dest_addr += (count * unit);
+		transfer_size -= count;
 	}
 
 	//Write-back R0, R1
@@ -1088,32 +1117,23 @@ void NTR_ARM7::swi_cpufastset()
 	//Determine if the transfer operation is copy or fill - Bit 24 of R2
 	u8 copy_fill = (transfer_control & 0x1000000) ? 1 : 0;
 
-	u32 temp = 0;
-
 	while(transfer_size != 0)
 	{
-		//Copy from source to destination
-		if(copy_fill == 0)
-		{
-			temp = mem->read_u32(src_addr);
-			mem->write_u32(dest_addr, temp);
-			
-			src_addr += 4;
-			dest_addr += 4;
+		//Copy or fill runs of plain memory directly
+		u32 count = mem->dma_block(dest_addr, src_addr, transfer_size, 4, (copy_fill == 1));
 
-			transfer_size--;
-		}
-
-		//Fill first entry from source with destination
-		else
+		//Everything else moves one word at a time
+		if(count == 0)
 		{
-			temp = mem->read_u32(src_addr);
-			mem->write_u32(dest_addr, temp);
-			
-			dest_addr += 4;
-			
-			transfer_size--;
+			mem->write_u32(dest_addr, mem->read_u32(src_addr));
+			count = 1;
 		}
+
+		//Fills keep reading the first entry from source
+		if(copy_fill == 0) { src_addr += (count * 4); }
+
+		dest_addr += (count * 4);
+		transfer_size -= count;
 	}
 
 	//Write-back R0, R1
@@ -1189,6 +1209,19 @@ void NTR_ARM7::swi_bitunpack()
 	u8 zero_flag = (data_offset & 0x80000000) ? 1 : 0;
 	data_offset &= ~0x80000000;
 
+	//32-bit writes are always aligned
+	dest_addr &= ~0x3;
+
+	//Resolve source and destination to host memory once, anything past either goes through the MMU
+	//At worst, every bit of the source becomes a whole 32-bit value
+	u32 src_room = length;
+	u32 dest_room = (length * 32);
+	u8* src = mem->get_host_read(src_addr, src_room);
+	u8* dest = mem->get_host_write(dest_addr, dest_room);
+
+	u32 src_pos = 0;
+	u32 dest_pos = 0;
+
 	u8 src_byte = 0;
 	u8 src_count = 0;
 	u32 result = 0;
@@ -1204,7 +1237,8 @@ void NTR_ARM7::swi_bitunpack()
 			//Grab new source byte
 			if((src_count % 8) == 0) 
 			{
-				src_byte = mem->read_u8(src_addr++);
+				src_byte = (src_pos < src_room) ? src[src_pos] : mem->read_u8(src_addr + src_pos);
+				src_pos++;
 				length--;
 			}
 
@@ -1221,13 +1255,24 @@ void NTR_ARM7::swi_bitunpack()
 		}
 
 		//Write result to the destination address
-		mem->write_u32(dest_addr, result);
-		dest_addr += 4;
+		if((dest_pos + 4) <= dest_room)
+		{
+			dest[dest_pos] = (result & 0xFF);
+			dest[dest_pos + 1] = ((result >> 8) & 0xFF);
+			dest[dest_pos + 2] = ((result >> 16) & 0xFF);
+			dest[dest_pos + 3] = ((result >> 24) & 0xFF);
+		}
+
+		else { mem->write_u32(dest_addr + dest_pos, result); }
+
+		dest_pos += 4;
 	}
+
+	mem->mark_host_write(dest_addr, std::min(dest_pos, dest_room));
 }	
 
 /****** HLE implementation of LZ77UnCompReadByCallback - NDS7 ******/
-void NTR_ARM7::swi_lz77uncompvram()
+void NTR_ARM7::swi_lz77uncompvram(bool vram)
 {
 	//Grab source address - R0
 	u32 src_addr = get_reg(0);
@@ -1241,62 +1286,111 @@ void NTR_ARM7::swi_lz77uncompvram()
 	//Grab compressed data size in bytes
 	u32 data_size = (data_header >> 8);
 
-	//Pointer to current address of compressed data that needs to be processed
-	//When uncompression starts, move 5 bytes from source address (header + flag)
+	//Pointer to compressed data that needs to be processed, right after the header
 	u32 data_ptr = (src_addr + 4);
 
-	u8 temp = 0;
+	//Resolve source and destination to host memory once, anything past either goes through the MMU
+	//At worst, every block is one uncompressed byte, with a flag byte for every 8 blocks
+	u32 src_room = data_size + (data_size >> 3) + 2;
+	u32 dest_room = data_size;
+	u8* src = mem->get_host_read(data_ptr, src_room);
+	u8* dest = mem->get_host_write(dest_addr, dest_room);
+
+	u32 src_pos = 0;
+	u32 dest_pos = 0;
+	u16 half_data = 0;
 
 	//Uncompress data
-	while(data_size > 0)
+	while(dest_pos < data_size)
 	{
 		//Grab flag data
-		u8 flag_data = mem->read_u8(data_ptr++);
+		u8 flag_data = (src_pos < src_room) ? src[src_pos] : mem->read_u8(data_ptr + src_pos);
+		src_pos++;
 
 		//Process 8 blocks
-		for(int x = 7; x >= 0; x--)
+		for(int x = 7; (x >= 0) && (dest_pos < data_size); x--)
 		{
-			u8 block_type = (flag_data & (1 << x)) ? 1 : 0;
-
 			//Block Type 0 - Uncompressed
-			if(block_type == 0)
+			if((flag_data & (1 << x)) == 0)
 			{
-				temp = mem->read_u8(data_ptr++);
-				mem->write_u8(dest_addr++, temp);
-				
-				data_size--;
-				if(data_size == 0) { return; }
-			}
+				u8 temp = (src_pos < src_room) ? src[src_pos] : mem->read_u8(data_ptr + src_pos);
+				src_pos++;
+
+				if(!vram)
+				{
+					if(dest_pos < dest_room) { dest[dest_pos] = temp; }
+					else { mem->write_u8(dest_addr + dest_pos, temp); }
+				}
+
+				//VRAM only takes halfwords, hold even bytes until the odd byte completes one
+				else if((dest_pos & 1) == 0) { half_data = temp; }
+
+				else
+				{
+					half_data |= (temp << 8);
+
+					if(dest_pos < dest_room)
+					{
+						dest[dest_pos - 1] = (half_data & 0xFF);
+						dest[dest_pos] = (half_data >> 8);
+					}
 
+					else { mem->write_u16(dest_addr + dest_pos - 1, half_data); }
+				}
+
+				dest_pos++;
+			}
 
 			//Block Type 1 - Compressed
+			//Read as separate bytes, blocks are not halfword aligned
 			else
 			{
-				u16 compressed_block = mem->read_u16(data_ptr);
-				data_ptr += 2;
+				u8 block_hi = (src_pos < src_room) ? src[src_pos] : mem->read_u8(data_ptr + src_pos);
+				u8 block_lo = ((src_pos + 1) < src_room) ? src[src_pos + 1] : mem->read_u8(data_ptr + src_pos + 1);
+				src_pos += 2;
 
-				u16 distance = ((compressed_block & 0xF) << 8);
-				distance |= (compressed_block >> 8);
+				u32 distance = (((block_hi & 0xF) << 8) | block_lo) + 1;
+				u8 length = (block_hi >> 4) + 3;
 
-				u8 length = ((compressed_block >> 4) & 0xF) + 3;
-
-				//Copy length+3 Bytes from dest_addr-length-1 to dest_addr
-				for(int y = 0; y < length; y++)
+				//Copy length+3 Bytes from dest_addr-distance-1 to dest_addr
+				for(u32 y = 0; (y < length) && (dest_pos < data_size); y++)
 				{
-					temp = mem->read_u8(dest_addr - distance - 1);
-					mem->write_u8(dest_addr, temp);
-					
-					dest_addr++;
-					data_size--;
-					if(data_size == 0) { return; }
+					u32 back_pos = dest_pos - distance;
+					u8 temp = (back_pos < dest_room) ? dest[back_pos] : mem->read_u8(dest_addr + back_pos);
+
+					if(!vram)
+					{
+						if(dest_pos < dest_room) { dest[dest_pos] = temp; }
+						else { mem->write_u8(dest_addr + dest_pos, temp); }
+					}
+
+					else if((dest_pos & 1) == 0) { half_data = temp; }
+
+					else
+					{
+						half_data |= (temp << 8);
+
+						if(dest_pos < dest_room)
+						{
+							dest[dest_pos - 1] = (half_data & 0xFF);
+							dest[dest_pos] = (half_data >> 8);
+						}
+
+						else { mem->write_u16(dest_addr + dest_pos - 1, half_data); }
+					}
+
+					dest_pos++;
 				}
 			}
 		}
 	}
+
+	//A trailing odd byte never completes a halfword, so VRAM never sees it
+	mem->mark_host_write(dest_addr, std::min(dest_pos, dest_room));
 }
 
 /****** HLE implementation of RLUnCompVram - NDS7 ******/
-void NTR_ARM7::swi_rluncompvram()
+void NTR_ARM7::swi_rluncompvram(bool vram)
 {
 	//Grab source address - R0
 	u32 src_addr = get_reg(0);
@@ -1312,10 +1406,22 @@ void NTR_ARM7::swi_rluncompvram()
 	//Data pointer to compressed data. Points to first flag.
 	u32 data_ptr = (src_addr + 4);
 
+	//Resolve source and destination to host memory once, anything past either goes through the MMU
+	//At worst, every byte is a run of one uncompressed byte
+	u32 src_room = (data_size * 2);
+	u32 dest_room = data_size;
+	u8* src = mem->get_host_read(data_ptr, src_room);
+	u8* dest = mem->get_host_write(dest_addr, dest_room);
+
+	u32 src_pos = 0;
+	u32 dest_pos = 0;
+	u16 half_data = 0;
+
 	//Uncompress data
-	while(data_size > 0)
+	while(dest_pos < data_size)
 	{
-		u8 flag = mem->read_u8(data_ptr++);
+		u8 flag = (src_pos < src_room) ? src[src_pos] : mem->read_u8(data_ptr + src_pos);
+		src_pos++;
 
 		u8 data_length = (flag & 0x7F);
 
@@ -1324,25 +1430,44 @@ void NTR_ARM7::swi_rluncompvram()
 		else { data_length += 1; }
 
 		//Output the specified byte the amount of times in data_length
-		for(int x = 0; x < data_length; x++)
+		for(u32 x = 0; (x < data_length) && (dest_pos < data_size); x++)
 		{
-			u8 data_byte = 0;
+			u8 data_byte = (src_pos < src_room) ? src[src_pos] : mem->read_u8(data_ptr + src_pos);
+
+			//Uncompressed data moves on every byte
+			if((flag & 0x80) == 0) { src_pos++; }
+
+			if(!vram)
+			{
+				if(dest_pos < dest_room) { dest[dest_pos] = data_byte; }
+				else { mem->write_u8(dest_addr + dest_pos, data_byte); }
+			}
 
-			//Compressed
-			if(flag & 0x80) { data_byte = mem->read_u8(data_ptr); }
+			//VRAM only takes halfwords, hold even bytes until the odd byte completes one
+			else if((dest_pos & 1) == 0) { half_data = data_byte; }
 
-			//Uncompressed
-			else { data_byte = mem->read_u8(data_ptr++); }
-				
-			mem->write_u8(dest_addr++, data_byte);
-			data_size--;
+			else
+			{
+				half_data |= (data_byte << 8);
 
-			if(data_size == 0) { return; }
+				if(dest_pos < dest_room)
+				{
+					dest[dest_pos - 1] = (half_data & 0xFF);
+					dest[dest_pos] = (half_data >> 8);
+				}
+
+				else { mem->write_u16(dest_addr + dest_pos - 1, half_data); }
+			}
+
+			dest_pos++;
 		}
 
 		//Manually adjust data pointer for compressed data to point to next flag
-		if(flag & 0x80) { data_ptr++; }
+		if(flag & 0x80) { src_pos++; }
 	}
+
+	//A trailing odd byte never completes a halfword, so VRAM never sees it
+	mem->mark_host_write(dest_addr, std::min(dest_pos, dest_room));
 }	
 
 /****** HLE implementation of GetSineTable - NDS7 ******/
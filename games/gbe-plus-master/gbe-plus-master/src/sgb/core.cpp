@@ -291,7 +291,7 @@ void SGB_core::run_core()
 					core_cpu.skip_instruction = false;
 
 					//Execute next opcode, but do not increment PC
-					core_cpu.opcode = core_mmu.read_u8(core_cpu.reg.pc);
+					core_cpu.opcode = core_mmu.fetch_u8(core_cpu.reg.pc);
 					core_cpu.exec_op(core_cpu.opcode);
 				}
 			}
@@ -299,7 +299,7 @@ void SGB_core::run_core()
 			//Process Opcodes
 			else 
 			{
-				core_cpu.opcode = core_mmu.read_u8(core_cpu.reg.pc++);
+				core_cpu.opcode = core_mmu.fetch_u8(core_cpu.reg.pc++);
 				core_cpu.exec_op(core_cpu.opcode);
 			}
 
@@ -478,7 +478,7 @@ void SGB_core::step()
 				core_cpu.skip_instruction = false;
 
 				//Execute next opcode, but do not increment PC
-				core_cpu.opcode = core_mmu.read_u8(core_cpu.reg.pc);
+				core_cpu.opcode = core_mmu.fetch_u8(core_cpu.reg.pc);
 				core_cpu.exec_op(core_cpu.opcode);
 			}
 		}
@@ -486,7 +486,7 @@ void SGB_core::step()
 		//Process Opcodes
 		else 
 		{
-			core_cpu.opcode = core_mmu.read_u8(core_cpu.reg.pc++);
+			core_cpu.opcode = core_mmu.fetch_u8(core_cpu.reg.pc++);
 			core_cpu.exec_op(core_cpu.opcode);
 		}
 
@@ -744,7 +744,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//LD BC, nn
 		case 0x01 :
-			reg.bc = mem->read_u16(reg.pc);
+			reg.bc = mem->fetch_u16(reg.pc);
 			reg.pc += 2;
 			cycles += 12;
 			break;
@@ -775,7 +775,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//LD B, n
 		case 0x06 :
-			reg.b = mem->read_u8(reg.pc++);
+			reg.b = mem->fetch_u8(reg.pc++);
 			cycles += 8;
 			break;
 
@@ -788,7 +788,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//LD nn, SP
 		case 0x08 :
-			mem->write_u16(mem->read_u16(reg.pc), reg.sp);
+			mem->write_u16(mem->fetch_u16(reg.pc), reg.sp);
 			reg.pc += 2;
 			cycles += 20;
 			break;
@@ -825,7 +825,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//LD C, n
 		case 0x0E :
-			reg.c = mem->read_u8(reg.pc++);
+			reg.c = mem->fetch_u8(reg.pc++);
 			cycles += 8;
 			break;
 
@@ -842,7 +842,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//LD DE, nn
 		case 0x11 :
-			reg.de = mem->read_u16(reg.pc);
+			reg.de = mem->fetch_u16(reg.pc);
 			reg.pc += 2;
 			cycles += 12;
 			break;
@@ -873,7 +873,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//LD D, n
 		case 0x16 :
-			reg.d = mem->read_u8(reg.pc++);
+			reg.d = mem->fetch_u8(reg.pc++);
 			cycles += 8;
 			break;
 
@@ -886,7 +886,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//JR, n
 		case 0x18 :
-			jr(mem->read_u8(reg.pc++));
+			jr(mem->fetch_u8(reg.pc++));
 			cycles += 8;
 			break;
 
@@ -922,7 +922,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//LD E, n
 		case 0x1E :
-			reg.e = mem->read_u8(reg.pc++);
+			reg.e = mem->fetch_u8(reg.pc++);
 			cycles += 8;
 			break;
 
@@ -937,7 +937,7 @@ void SGB_Z80::exec_op(u8 opcode)
 		case 0x20 :	
 			{
 				u8 zero_flag = (reg.f & 0x80) ? 1 : 0;
-				if(zero_flag == 0) { jr(mem->read_u8(reg.pc));}
+				if(zero_flag == 0) { jr(mem->fetch_u8(reg.pc));}
 				cycles += 8;
 				reg.pc++;
 			}
@@ -945,7 +945,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//LD HL, nn
 		case 0x21 :
-			reg.hl = mem->read_u16(reg.pc);
+			reg.hl = mem->fetch_u16(reg.pc);
 			reg.pc+=2;
 			cycles += 12;
 			break;
@@ -977,7 +977,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//LD H, n
 		case 0x26 : 
-			reg.h = mem->read_u8(reg.pc++);
+			reg.h = mem->fetch_u8(reg.pc++);
 			cycles += 8;
 			break;
 
@@ -991,7 +991,7 @@ void SGB_Z80::exec_op(u8 opcode)
 		case 0x28 :
 			{
 				u8 zero_flag = (reg.f & 0x80) ? 1 : 0;
-				if(zero_flag == 1) { jr(mem->read_u8(reg.pc));}
+				if(zero_flag == 1) { jr(mem->fetch_u8(reg.pc));}
 				cycles += 8;
 				reg.pc++;
 			}
@@ -1030,7 +1030,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//LD L, n
 		case 0x2E :
-			reg.l = mem->read_u8(reg.pc++);
+			reg.l = mem->fetch_u8(reg.pc++);
 			cycles += 8;
 			break;
 
@@ -1045,7 +1045,7 @@ void SGB_Z80::exec_op(u8 opcode)
 		case 0x30 :	
 			{
 				u8 carry_flag = (reg.f & 0x10) ? 1 : 0;
-				if(carry_flag == 0) { jr(mem->read_u8(reg.pc));}
+				if(carry_flag == 0) { jr(mem->fetch_u8(reg.pc));}
 				cycles += 8;
 				reg.pc++;
 			}
@@ -1053,7 +1053,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//LD SP, nn
 		case 0x31 : 
-			reg.sp = mem->read_u16(reg.pc);
+			reg.sp = mem->fetch_u16(reg.pc);
 			reg.pc += 2;
 			cycles += 12;
 			break;
@@ -1088,7 +1088,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//LD HL, n
 		case 0x36 :
-			mem->write_u8(reg.hl, mem->read_u8(reg.pc++));
+			mem->write_u8(reg.hl, mem->fetch_u8(reg.pc++));
 			cycles += 12;
 			break;
 
@@ -1107,7 +1107,7 @@ void SGB_Z80::exec_op(u8 opcode)
 		case 0x38 :
 			{
 				u8 carry_flag = (reg.f & 0x10) ? 1 : 0;
-				if(carry_flag == 1) { jr(mem->read_u8(reg.pc));}
+				if(carry_flag == 1) { jr(mem->fetch_u8(reg.pc));}
 				cycles += 8;
 				reg.pc++;
 			}
@@ -1146,7 +1146,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//LD A, n
 		case 0x3E :
-			reg.a = mem->read_u8(reg.pc++);
+			reg.a = mem->fetch_u8(reg.pc++);
 			cycles += 8;
 			break;
 
@@ -1955,7 +1955,7 @@ void SGB_Z80::exec_op(u8 opcode)
 		case 0xC2 :
 			{
 				u8 zero_flag = (reg.f & 0x80) ? 1 : 0;
-				if(zero_flag == 0) { reg.pc = mem->read_u16(reg.pc); }
+				if(zero_flag == 0) { reg.pc = mem->fetch_u16(reg.pc); }
 				else { reg.pc += 2; }
 				cycles += 12; 
 			}
@@ -1963,7 +1963,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//JP nn
 		case 0xC3 :
-			reg.pc = mem->read_u16(reg.pc);
+			reg.pc = mem->fetch_u16(reg.pc);
 			cycles += 12;
 			break;
 
@@ -1976,7 +1976,7 @@ void SGB_Z80::exec_op(u8 opcode)
 				{
 					reg.sp -= 2;
 					mem->write_u16(reg.sp, reg.pc+2);
-					reg.pc = mem->read_u16(reg.pc);
+					reg.pc = mem->fetch_u16(reg.pc);
 				}
 				
 				else { reg.pc += 2; }
@@ -1993,7 +1993,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//ADD A, n
 		case 0xC6 :
-			reg.a = add_byte(reg.a, mem->read_u8(reg.pc++));
+			reg.a = add_byte(reg.a, mem->fetch_u8(reg.pc++));
 			cycles += 8;
 			break;
 
@@ -2025,7 +2025,7 @@ void SGB_Z80::exec_op(u8 opcode)
 		case 0xCA :
 			{
 				u8 zero_flag = (reg.f & 0x80) ? 1 : 0;
-				if(zero_flag == 1) { reg.pc = mem->read_u16(reg.pc); }
+				if(zero_flag == 1) { reg.pc = mem->fetch_u16(reg.pc); }
 				else { reg.pc += 2; }
 				cycles += 12;
 			}
@@ -2034,7 +2034,7 @@ void SGB_Z80::exec_op(u8 opcode)
 		//EXT OPS
 		case 0xCB :
 			temp_word = 0xCB00;
-			temp_word |= mem->read_u8(reg.pc++);
+			temp_word |= mem->fetch_u8(reg.pc++);
 			exec_op(temp_word);
 			break;
 
@@ -2047,7 +2047,7 @@ void SGB_Z80::exec_op(u8 opcode)
 				{
 					reg.sp -= 2;
 					mem->write_u16(reg.sp, reg.pc+2);
-					reg.pc = mem->read_u16(reg.pc);
+					reg.pc = mem->fetch_u16(reg.pc);
 				}
 				
 				else { reg.pc += 2; }
@@ -2059,13 +2059,13 @@ void SGB_Z80::exec_op(u8 opcode)
 		case 0xCD :
 			reg.sp -= 2;
 			mem->write_u16(reg.sp, reg.pc+2);
-			reg.pc = mem->read_u16(reg.pc);
+			reg.pc = mem->fetch_u16(reg.pc);
 			cycles += 12;
 			break;
 
 		//ADC A, n
 		case 0xCE :
-			reg.a = add_carry(reg.a, mem->read_u8(reg.pc++));
+			reg.a = add_carry(reg.a, mem->fetch_u8(reg.pc++));
 			cycles += 8;
 			break;
 
@@ -2097,7 +2097,7 @@ void SGB_Z80::exec_op(u8 opcode)
 		case 0xD2 :
 			{
 				u8 carry_flag = (reg.f & 0x10) ? 1 : 0;
-				if(carry_flag == 0) { reg.pc = mem->read_u16(reg.pc); }
+				if(carry_flag == 0) { reg.pc = mem->fetch_u16(reg.pc); }
 				else { reg.pc += 2; }
 				cycles += 12; 
 			}
@@ -2112,7 +2112,7 @@ void SGB_Z80::exec_op(u8 opcode)
 				{
 					reg.sp -= 2;
 					mem->write_u16(reg.sp, reg.pc+2);
-					reg.pc = mem->read_u16(reg.pc);
+					reg.pc = mem->fetch_u16(reg.pc);
 				}
 				
 				else { reg.pc += 2; }
@@ -2129,7 +2129,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//SUB A, n
 		case 0xD6 :
-			reg.a = sub_byte(reg.a, mem->read_u8(reg.pc++));
+			reg.a = sub_byte(reg.a, mem->fetch_u8(reg.pc++));
 			cycles += 8;
 			break;
 
@@ -2162,7 +2162,7 @@ void SGB_Z80::exec_op(u8 opcode)
 		case 0xDA :
 			{
 				u8 carry_flag = (reg.f & 0x10) ? 1 : 0;
-				if(carry_flag == 1) { reg.pc = mem->read_u16(reg.pc); }
+				if(carry_flag == 1) { reg.pc = mem->fetch_u16(reg.pc); }
 				else { reg.pc += 2; }
 				cycles += 12;
 			}
@@ -2177,7 +2177,7 @@ void SGB_Z80::exec_op(u8 opcode)
 				{
 					reg.sp -= 2;
 					mem->write_u16(reg.sp, reg.pc+2);
-					reg.pc = mem->read_u16(reg.pc);
+					reg.pc = mem->fetch_u16(reg.pc);
 				}
 				
 				else { reg.pc += 2; }
@@ -2187,7 +2187,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//SBC A, n
 		case 0xDE :
-			reg.a = sub_carry(reg.a, mem->read_u8(reg.pc++));
+			reg.a = sub_carry(reg.a, mem->fetch_u8(reg.pc++));
 			cycles += 8;
 			break;
 
@@ -2201,7 +2201,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//LDH n, A
 		case 0xE0 :
-			temp_word = (mem->read_u8(reg.pc++) | 0xFF00);
+			temp_word = (mem->fetch_u8(reg.pc++) | 0xFF00);
 			mem->write_u8(temp_word, reg.a);
 			cycles += 12;
 			break;
@@ -2229,7 +2229,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//AND n
 		case 0xE6 :
-			reg.a = and_byte(reg.a, mem->read_u8(reg.pc++));
+			reg.a = and_byte(reg.a, mem->fetch_u8(reg.pc++));
 			cycles += 8;
 			break;
 
@@ -2243,7 +2243,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//ADD SP, n
 		case 0xE8 :
-			reg.sp = add_signed_byte(reg.sp, mem->read_s8(reg.pc++));
+			reg.sp = add_signed_byte(reg.sp, mem->fetch_u8(reg.pc++));
 			cycles += 16;
 			break;
 
@@ -2255,14 +2255,14 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//LD nn, A
 		case 0xEA :
-			mem->write_u8(mem->read_u16(reg.pc), reg.a);
+			mem->write_u8(mem->fetch_u16(reg.pc), reg.a);
 			reg.pc += 2;
 			cycles += 16;
 			break;
 
 		//XOR n
 		case 0xEE :
-			reg.a = xor_byte(reg.a, mem->read_u8(reg.pc++));
+			reg.a = xor_byte(reg.a, mem->fetch_u8(reg.pc++));
 			cycles += 8;
 			break;
 
@@ -2276,7 +2276,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//LDH A, n
 		case 0xF0 :
-			temp_word = (mem->read_u8(reg.pc++) | 0xFF00);
+			temp_word = (mem->fetch_u8(reg.pc++) | 0xFF00);
 			reg.a = mem->read_u8(temp_word);
 			cycles += 12;
 			break;
@@ -2309,7 +2309,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//OR n
 		case 0xF6 :
-			reg.a = or_byte(reg.a, mem->read_u8(reg.pc++));
+			reg.a = or_byte(reg.a, mem->fetch_u8(reg.pc++));
 			cycles += 8;
 			break;
 
@@ -2323,7 +2323,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//LDHL SP, n
 		case 0xF8 :
-			reg.hl = add_signed_byte(reg.sp, mem->read_s8(reg.pc++)); 
+			reg.hl = add_signed_byte(reg.sp, mem->fetch_u8(reg.pc++)); 
 			cycles += 12;
 			break;
 
@@ -2335,7 +2335,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//LD A, nn
 		case 0xFA :
-			reg.a = mem->read_u8(mem->read_u16(reg.pc));
+			reg.a = mem->read_u8(mem->fetch_u16(reg.pc));
 			reg.pc+=2;
 			cycles += 16;
 			break;
@@ -2348,7 +2348,7 @@ void SGB_Z80::exec_op(u8 opcode)
 
 		//CP n
 		case 0xFE : 
-			sub_byte(reg.a, mem->read_u8(reg.pc++));
+			sub_byte(reg.a, mem->fetch_u8(reg.pc++));
 			cycles += 8;
 			break;
 
@@ -0,0 +1,142 @@
+// GB Enhanced+ Copyright Daniel Baxter 2014
+// Licensed under the GPLv2
+// See LICENSE.txt for full license text
+
+// File : sfx_util_test.cpp
+// Date : October 17, 2026
+// Description : Checks the SIMD color effect kernels against the scalar versions
+//
+// Every kernel set the host can run is forced in turn and swept over each effect, every EVA/EVB/EVY value and every master brightness factor
+// Line lengths are picked so the SIMD loops always leave leftover pixels, and pixels past the end must stay untouched
+
+#include <iostream>
+#include <vector>
+
+#include "common/sfx_util.h"
+
+//Line lengths that are not multiples of 8 or 16, plus full GBA and NDS lines
+const u32 test_counts[] = { 1, 3, 7, 9, 15, 17, 23, 31, 33, 47, 239, 240, 255, 256, 257 };
+
+//Extra words after each line that no kernel should write to
+const u32 guard_words = 8;
+
+u32 rng_state = 0x12345678;
+u32 failures = 0;
+
+/****** Simple xorshift so every run tests the same data ******/
+u32 next_random()
+{
+	rng_state ^= (rng_state << 13);
+	rng_state ^= (rng_state >> 17);
+	rng_state ^= (rng_state << 5);
+	return rng_state;
+}
+
+/****** Reports the first differing pixel between two lines ******/
+bool compare_lines(const std::vector<u32> &expected, const std::vector<u32> &result, const char* test, u32 count, u32 arg_1, u32 arg_2, u32 arg_3)
+{
+	for(u32 x = 0; x < expected.size(); x++)
+	{
+		if(expected[x] != result[x])
+		{
+			if(failures < 16)
+			{
+				std::cout<<"SFX_TEST::Error - " << sfx_util::kernel_name() << " " << test << " mismatch @ pixel " << std::dec << x << " of " << count;
+				std::cout<<" (" << arg_1 << ", " << arg_2 << ", " << arg_3 << ") : expected 0x" << std::hex << expected[x] << " got 0x" << result[x] << std::dec << "\n";
+			}
+
+			failures++;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/****** Sweeps apply_line() over every op and every EVA, EVB, and EVY ******/
+void test_apply_line()
+{
+	std::vector<u8> ops(512);
+	std::vector<u16> color_1(512);
+	std::vector<u16> color_2(512);
+
+	//Op patterns - Every pixel uses the same op, or a random mix of all of them
+	for(u32 pattern = 0; pattern < 5; pattern++)
+	{
+		for(u32 eva = 0; eva < 32; eva++)
+		{
+			for(u32 evb = 0; evb < 32; evb++)
+			{
+				u8 evy = ((eva * 7) + evb) & 0x1F;
+
+				for(u32 count : test_counts)
+				{
+					//Start a pixel in sometimes so the kernels see unaligned lines too
+					u32 offset = (next_random() & 0x1);
+
+					for(u32 x = 0; x < (count + offset); x++)
+					{
+						ops[x] = (pattern < 4) ? pattern : (next_random() & 0x3);
+						color_1[x] = next_random() & 0x7FFF;
+						color_2[x] = next_random() & 0x7FFF;
+					}
+
+					std::vector<u32> expected(count + guard_words);
+					for(u32 x = 0; x < expected.size(); x++) { expected[x] = next_random(); }
+					std::vector<u32> result = expected;
+
+					sfx_util::apply_line_scalar(&ops[offset], &color_1[offset], &color_2[offset], &expected[0], count, eva, evb, evy);
+					sfx_util::apply_line(&ops[offset], &color_1[offset], &color_2[offset], &result[0], count, eva, evb, evy);
+
+					compare_lines(expected, result, "apply_line", count, eva, evb, evy);
+				}
+			}
+		}
+	}
+}
+
+/****** Sweeps master_brightness_line() over every factor in both directions ******/
+void test_master_brightness_line()
+{
+	for(u32 factor = 0; factor < 32; factor++)
+	{
+		for(u32 increase = 0; increase < 2; increase++)
+		{
+			for(u32 count : test_counts)
+			{
+				std::vector<u32> expected(count + guard_words);
+				for(u32 x = 0; x < expected.size(); x++) { expected[x] = next_random(); }
+				std::vector<u32> result = expected;
+
+				sfx_util::master_brightness_line_scalar(&expected[0], count, increase, factor);
+				sfx_util::master_brightness_line(&result[0], count, increase, factor);
+
+				compare_lines(expected, result, "master_brightness_line", count, factor, increase, 0);
+			}
+		}
+	}
+}
+
+int main()
+{
+	const sfx_util::kernel_type kernels[] = { sfx_util::SFX_KERNEL_SCALAR, sfx_util::SFX_KERNEL_SSE2, sfx_util::SFX_KERNEL_AVX2 };
+	const char* kernel_names[] = { "Scalar", "SSE2", "AVX2" };
+
+	for(u32 x = 0; x < 3; x++)
+	{
+		if(!sfx_util::force_kernel(kernels[x]))
+		{
+			std::cout<<"SFX_TEST::" << kernel_names[x] << " kernels not available on this host, skipping\n";
+			continue;
+		}
+
+		u32 last_failures = failures;
+
+		test_apply_line();
+		test_master_brightness_line();
+
+		std::cout<<"SFX_TEST::" << sfx_util::kernel_name() << " kernels " << ((failures == last_failures) ? "passed" : "FAILED") << "\n";
+	}
+
+	return (failures == 0) ? 0 : 1;
+}